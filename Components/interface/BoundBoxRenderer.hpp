@@ -90,6 +90,9 @@ public:
         bool ConvertOutputToSRGB = false;
 
         bool ComputeMotionVectors = false;
+
+        /// Whether the depth buffer uses reversed depth (near plane at 1, far plane at 0).
+        bool ReversedDepth = false;
     };
     void Prepare(IDeviceContext* pContext, const RenderAttribs& Attribs);
     void Render(IDeviceContext* pContext);
@@ -99,24 +102,28 @@ public:
     {
         const bool ConvertOutputToSRGB;
         const bool ComputeMotionVectors;
+        const bool ReversedDepth;
 
         PSOKey(bool _ConvertOutputToSRGB,
-               bool _ComputeMotionVectors) :
+               bool _ComputeMotionVectors,
+               bool _ReversedDepth = false) :
             ConvertOutputToSRGB{_ConvertOutputToSRGB},
-            ComputeMotionVectors{_ComputeMotionVectors}
+            ComputeMotionVectors{_ComputeMotionVectors},
+            ReversedDepth{_ReversedDepth}
         {}
 
         constexpr bool operator==(const PSOKey& rhs) const
         {
             return (ConvertOutputToSRGB == rhs.ConvertOutputToSRGB &&
-                    ComputeMotionVectors == rhs.ComputeMotionVectors);
+                    ComputeMotionVectors == rhs.ComputeMotionVectors &&
+                    ReversedDepth == rhs.ReversedDepth);
         }
 
         struct Hasher
         {
             size_t operator()(const PSOKey& Key) const
             {
-                return ComputeHash(Key.ConvertOutputToSRGB);
+                return ComputeHash(Key.ConvertOutputToSRGB, Key.ComputeMotionVectors, Key.ReversedDepth);
             }
         };
     };
@@ -83,6 +83,9 @@ public:
         bool ConvertOutputToSRGB = false;
 
         bool ComputeMotionVectors = false;
+
+        /// Whether the depth buffer uses reversed depth (near plane at 1, far plane at 0).
+        bool ReversedDepth = false;
     };
     void Prepare(IDeviceContext*                 pContext,
                  const RenderAttribs&            Attribs,
@@ -102,12 +105,14 @@ public:
         const bool         ConvertOutputToSRGB;
         const bool         ComputeMotionVectors;
         const ENV_MAP_TYPE EnvMapType;
+        const bool         ReversedDepth;
 
-        PSOKey(int _ToneMappingMode, bool _ConvertOutputToSRGB, bool _ComputeMotionVectors, ENV_MAP_TYPE _EnvMapType) :
+        PSOKey(int _ToneMappingMode, bool _ConvertOutputToSRGB, bool _ComputeMotionVectors, ENV_MAP_TYPE _EnvMapType, bool _ReversedDepth = false) :
             ToneMappingMode{_ToneMappingMode},
             ConvertOutputToSRGB{_ConvertOutputToSRGB},
             ComputeMotionVectors{_ComputeMotionVectors},
-            EnvMapType{_EnvMapType}
+            EnvMapType{_EnvMapType},
+            ReversedDepth{_ReversedDepth}
         {}
 
         constexpr bool operator==(const PSOKey& rhs) const
@@ -115,14 +120,15 @@ public:
             return (ToneMappingMode == rhs.ToneMappingMode &&
                     ConvertOutputToSRGB == rhs.ConvertOutputToSRGB &&
                     ComputeMotionVectors == rhs.ComputeMotionVectors &&
-                    EnvMapType == rhs.EnvMapType);
+                    EnvMapType == rhs.EnvMapType &&
+                    ReversedDepth == rhs.ReversedDepth);
         }
 
         struct Hasher
         {
             size_t operator()(const PSOKey& Key) const
             {
-                return ComputeHash(Key.ToneMappingMode, Key.ConvertOutputToSRGB, Key.ComputeMotionVectors, Key.EnvMapType);
+                return ComputeHash(Key.ToneMappingMode, Key.ConvertOutputToSRGB, Key.ComputeMotionVectors, Key.EnvMapType, Key.ReversedDepth);
             }
         };
     };
@@ -148,6 +148,45 @@ public:
     void DistributeCascades(const DistributeCascadeInfo& Info,
                             ShadowMapAttribs&            shadowMapAttribs);
 
+    /// Shadow map properties that affect cascade distribution.
+    struct ShadowMapInfo
+    {
+        /// Shadow map width.
+        Uint32 Width = 0;
+
+        /// Shadow map height.
+        Uint32 Height = 0;
+
+        /// Number of shadow cascades.
+        Uint32 NumCascades = 0;
+
+        /// Shadow mode (see SHADOW_MODE_* defines in BasicStructures.fxh).
+        int ShadowMode = 0;
+
+        /// Whether the filterable shadow map uses 32-bit format.
+        bool Is32BitFilterableFmt = false;
+
+        /// Whether the device uses OpenGL-style [-1, 1] NDC depth range.
+        bool IsGL = false;
+
+        /// Normalized device coordinates attributes.
+        NDCAttribs NDC = {0.0f, 1.0f, -0.5f};
+    };
+
+    /// Distributes shadow cascades for a shadow map with the given properties.
+    ///
+    /// \param [in]  Info               - Cascade distribution info.
+    /// \param [in]  SMInfo             - Shadow map properties.
+    /// \param [out] ShadowAttribs      - Shadow map attributes.
+    /// \param [out] pCascadeTransforms - Pointer to the array of SMInfo.NumCascades cascade transforms.
+    ///
+    /// \remarks    This method does not use any device objects and can be called without
+    ///             an initialized shadow map manager.
+    static void DistributeCascades(const DistributeCascadeInfo& Info,
+                                   const ShadowMapInfo&         SMInfo,
+                                   ShadowMapAttribs&            ShadowAttribs,
+                                   CascadeTransforms*           pCascadeTransforms);
+
     void ConvertToFilterable(IDeviceContext* pCtx, const ShadowMapAttribs& ShadowAttribs);
 
     const CascadeTransforms& GetCascadeTranform(Uint32 Cascade) const { return m_CascadeTransforms[Cascade]; }
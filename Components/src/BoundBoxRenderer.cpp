@@ -157,7 +157,7 @@ IPipelineState* BoundBoxRenderer::GetPSO(const PSOKey& Key)
 
     PsoCI.PSODesc.ResourceLayout.DefaultVariableMergeStages  = SHADER_TYPE_VS_PS;
     PsoCI.PSODesc.ResourceLayout.DefaultVariableType         = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
-    PsoCI.GraphicsPipeline.DepthStencilDesc.DepthFunc        = COMPARISON_FUNC_LESS_EQUAL;
+    PsoCI.GraphicsPipeline.DepthStencilDesc.DepthFunc        = Key.ReversedDepth ? COMPARISON_FUNC_GREATER_EQUAL : COMPARISON_FUNC_LESS_EQUAL;
     PsoCI.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = false;
     if (m_AsyncShaders)
         PsoCI.Flags |= PSO_CREATE_FLAG_ASYNCHRONOUS;
@@ -175,7 +175,7 @@ IPipelineState* BoundBoxRenderer::GetPSO(const PSOKey& Key)
 
 void BoundBoxRenderer::Prepare(IDeviceContext* pContext, const RenderAttribs& Attribs)
 {
-    m_pCurrentPSO = GetPSO({Attribs.ConvertOutputToSRGB, Attribs.ComputeMotionVectors});
+    m_pCurrentPSO = GetPSO({Attribs.ConvertOutputToSRGB, Attribs.ComputeMotionVectors, Attribs.ReversedDepth});
     if (m_pCurrentPSO == nullptr)
     {
         UNEXPECTED("Failed to get PSO");
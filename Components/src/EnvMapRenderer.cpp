@@ -125,7 +125,8 @@ IPipelineState* EnvMapRenderer::GetPSO(const PSOKey& Key)
         .Add("COMPUTE_MOTION_VECTORS", Key.ComputeMotionVectors)
         .Add("ENV_MAP_TYPE_CUBE", static_cast<int>(PSOKey::ENV_MAP_TYPE_CUBE))
         .Add("ENV_MAP_TYPE_SPHERE", static_cast<int>(PSOKey::ENV_MAP_TYPE_SPHERE))
-        .Add("ENV_MAP_TYPE", static_cast<int>(Key.EnvMapType));
+        .Add("ENV_MAP_TYPE", static_cast<int>(Key.EnvMapType))
+        .Add("ENV_MAP_INVERTED_DEPTH", Key.ReversedDepth);
     ShaderCI.Macros = Macros;
 
     RefCntAutoPtr<IShader> pVS;
@@ -172,7 +173,7 @@ IPipelineState* EnvMapRenderer::GetPSO(const PSOKey& Key)
     for (auto RTVFormat : m_RTVFormats)
         PsoCI.AddRenderTarget(RTVFormat);
 
-    PsoCI.GraphicsPipeline.DepthStencilDesc.DepthFunc        = COMPARISON_FUNC_LESS_EQUAL;
+    PsoCI.GraphicsPipeline.DepthStencilDesc.DepthFunc        = Key.ReversedDepth ? COMPARISON_FUNC_GREATER_EQUAL : COMPARISON_FUNC_LESS_EQUAL;
     PsoCI.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = false;
 
     auto PSO = Device.CreateGraphicsPipelineState(PsoCI);
@@ -209,7 +210,7 @@ void EnvMapRenderer::Prepare(IDeviceContext*                 pContext,
         PSOKey::ENV_MAP_TYPE_CUBE :
         PSOKey::ENV_MAP_TYPE_SPHERE;
 
-    m_pCurrentPSO = GetPSO({ToneMapping.iToneMappingMode, Attribs.ConvertOutputToSRGB, Attribs.ComputeMotionVectors, EnvMapType});
+    m_pCurrentPSO = GetPSO({ToneMapping.iToneMappingMode, Attribs.ConvertOutputToSRGB, Attribs.ComputeMotionVectors, EnvMapType, Attribs.ReversedDepth});
     if (m_pCurrentPSO == nullptr)
     {
         UNEXPECTED("Failed to get PSO");
@@ -134,27 +134,53 @@ void ShadowMapManager::Initialize(IRenderDevice* pDevice, IRenderStateCache* pSt
 void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
                                           ShadowMapAttribs&            ShadowAttribs)
 {
-    VERIFY(Info.pCameraView, "Camera view matrix must not be null");
-    VERIFY(Info.pCameraProj, "Camera projection matrix must not be null");
-    VERIFY(Info.pLightDir, "Light direction must not be null");
     VERIFY(m_pDevice, "Shadow map manager is not initialized");
 
     const auto& DevInfo = m_pDevice->GetDeviceInfo();
-    const auto  IsGL    = DevInfo.IsGLDevice();
     const auto& SMDesc  = m_pShadowMapSRV->GetTexture()->GetDesc();
 
-    float2 f2ShadowMapSize = float2(static_cast<float>(SMDesc.Width), static_cast<float>(SMDesc.Height));
+    ShadowMapInfo SMInfo;
+    SMInfo.Width       = SMDesc.Width;
+    SMInfo.Height      = SMDesc.Height;
+    SMInfo.NumCascades = SMDesc.ArraySize;
+    SMInfo.ShadowMode  = m_ShadowMode;
+    SMInfo.IsGL        = DevInfo.IsGLDevice();
+    SMInfo.NDC         = DevInfo.GetNDCAttribs();
+    if (m_ShadowMode == SHADOW_MODE_VSM || m_ShadowMode == SHADOW_MODE_EVSM2 || m_ShadowMode == SHADOW_MODE_EVSM4)
+    {
+        VERIFY_EXPR(m_pFilterableShadowMapSRV);
+        const auto& FilterableSMDesc = m_pFilterableShadowMapSRV->GetTexture()->GetDesc();
+        SMInfo.Is32BitFilterableFmt  = FilterableSMDesc.Format == TEX_FORMAT_RGBA32_FLOAT || FilterableSMDesc.Format == TEX_FORMAT_RG32_FLOAT;
+    }
+
+    m_CascadeTransforms.resize(SMInfo.NumCascades);
+    DistributeCascades(Info, SMInfo, ShadowAttribs, m_CascadeTransforms.data());
+}
+
+void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
+                                          const ShadowMapInfo&         SMInfo,
+                                          ShadowMapAttribs&            ShadowAttribs,
+                                          CascadeTransforms*           pCascadeTransforms)
+{
+    VERIFY(Info.pCameraView, "Camera view matrix must not be null");
+    VERIFY(Info.pCameraProj, "Camera projection matrix must not be null");
+    VERIFY(Info.pLightDir, "Light direction must not be null");
+    VERIFY(pCascadeTransforms != nullptr, "Cascade transforms must not be null");
+    VERIFY(SMInfo.NumCascades <= MAX_CASCADES, "The number of cascades exceeds the maximum");
+
+    const auto IsGL       = SMInfo.IsGL;
+    const int  ShadowMode = SMInfo.ShadowMode;
+
+    float2 f2ShadowMapSize = float2(static_cast<float>(SMInfo.Width), static_cast<float>(SMInfo.Height));
 
     ShadowAttribs.f4ShadowMapDim.x = f2ShadowMapSize.x;
     ShadowAttribs.f4ShadowMapDim.y = f2ShadowMapSize.y;
     ShadowAttribs.f4ShadowMapDim.z = 1.f / f2ShadowMapSize.x;
     ShadowAttribs.f4ShadowMapDim.w = 1.f / f2ShadowMapSize.y;
 
-    if (m_ShadowMode == SHADOW_MODE_VSM || m_ShadowMode == SHADOW_MODE_EVSM2 || m_ShadowMode == SHADOW_MODE_EVSM4)
+    if (ShadowMode == SHADOW_MODE_VSM || ShadowMode == SHADOW_MODE_EVSM2 || ShadowMode == SHADOW_MODE_EVSM4)
     {
-        VERIFY_EXPR(m_pFilterableShadowMapSRV);
-        const auto& FilterableSMDesc = m_pFilterableShadowMapSRV->GetTexture()->GetDesc();
-        ShadowAttribs.bIs32BitEVSM   = FilterableSMDesc.Format == TEX_FORMAT_RGBA32_FLOAT || FilterableSMDesc.Format == TEX_FORMAT_RG32_FLOAT;
+        ShadowAttribs.bIs32BitEVSM = SMInfo.Is32BitFilterableFmt;
     }
 
     float3 LightSpaceX, LightSpaceY, LightSpaceZ;
@@ -171,6 +197,11 @@ void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
 
     float fMainCamNearPlane, fMainCamFarPlane;
     Info.pCameraProj->GetNearFarClipPlanes(fMainCamNearPlane, fMainCamFarPlane, IsGL);
+    if (fMainCamNearPlane > fMainCamFarPlane)
+    {
+        // Reversed depth projection
+        std::swap(fMainCamNearPlane, fMainCamFarPlane);
+    }
     if (Info.AdjustCascadeRange)
     {
         Info.AdjustCascadeRange(-1, fMainCamNearPlane, fMainCamFarPlane);
@@ -179,11 +210,10 @@ void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
     for (int i = 0; i < MAX_CASCADES; ++i)
         ShadowAttribs.fCascadeCamSpaceZEnd[i] = +FLT_MAX;
 
-    int iNumCascades           = SMDesc.ArraySize;
+    int iNumCascades           = static_cast<int>(SMInfo.NumCascades);
     ShadowAttribs.iNumCascades = iNumCascades;
     ShadowAttribs.fNumCascades = static_cast<float>(iNumCascades);
 
-    m_CascadeTransforms.resize(iNumCascades);
     for (int iCascade = 0; iCascade < iNumCascades; ++iCascade)
     {
         auto&  CurrCascade   = ShadowAttribs.Cascades[iCascade];
@@ -258,7 +288,7 @@ void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
         }
 
         float2 f2FixedMargin = (Info.SnapCascades ? float2(0.5f, 0.5f) : float2(0, 0));
-        if (m_ShadowMode == SHADOW_MODE_VSM || m_ShadowMode == SHADOW_MODE_EVSM2 || m_ShadowMode == SHADOW_MODE_EVSM4)
+        if (ShadowMode == SHADOW_MODE_VSM || ShadowMode == SHADOW_MODE_EVSM2 || ShadowMode == SHADOW_MODE_EVSM4)
         {
             f2FixedMargin.x += static_cast<float>(ShadowAttribs.iMaxAnisotropy) / 2.f;
             f2FixedMargin.y += static_cast<float>(ShadowAttribs.iMaxAnisotropy) / 2.f;
@@ -376,14 +406,14 @@ void ShadowMapManager::DistributeCascades(const DistributeCascadeInfo& Info,
         float4x4 ScaledBiasMatrix = float4x4::Translation(CurrCascade.f4LightSpaceScaledBias.x, CurrCascade.f4LightSpaceScaledBias.y, CurrCascade.f4LightSpaceScaledBias.z);
 
         // Note: bias is applied after scaling!
-        float4x4& CascadeProjMatr = m_CascadeTransforms[iCascade].Proj;
+        float4x4& CascadeProjMatr = pCascadeTransforms[iCascade].Proj;
         CascadeProjMatr           = ScaleMatrix * ScaledBiasMatrix;
 
         // Adjust the world to light space transformation matrix
-        float4x4& WorldToLightProjSpaceMatr = m_CascadeTransforms[iCascade].WorldToLightProjSpace;
+        float4x4& WorldToLightProjSpaceMatr = pCascadeTransforms[iCascade].WorldToLightProjSpace;
         WorldToLightProjSpaceMatr           = WorldToLightViewSpaceMatr * CascadeProjMatr;
 
-        const auto& NDCAttribs    = DevInfo.GetNDCAttribs();
+        const auto& NDCAttribs    = SMInfo.NDC;
         float4x4    ProjToUVScale = float4x4::Scale(0.5f, NDCAttribs.YtoVScale, NDCAttribs.ZtoDepthScale);
         float4x4    ProjToUVBias  = float4x4::Translation(0.5f, 0.5f, NDCAttribs.GetZtoDepthBias());
 
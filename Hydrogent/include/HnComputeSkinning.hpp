@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "PipelineState.h"
+#include "Buffer.h"
+#include "RefCntAutoPtr.hpp"
+#include "BasicMath.hpp"
+
+#include "entt/entity/entity.hpp"
+
+namespace Diligent
+{
+
+namespace USD
+{
+
+class HnRenderDelegate;
+
+/// Compute shader pre-skinning of the skinned meshes.
+///
+/// Skinned positions and normals are written once per frame into vertex buffers
+/// that are consumed by all render passes (main, shadow, selection, etc.) as static
+/// geometry. Meshes whose joint transforms have not changed since the last update
+/// are skipped. Previous-frame skinned positions are written into a separate buffer
+/// to compute exact motion vectors.
+class HnComputeSkinning final
+{
+public:
+    struct CreateInfo
+    {
+        /// Compute shader thread group size.
+        Uint32 ThreadGroupSize = 64;
+    };
+    HnComputeSkinning(const CreateInfo& CI);
+    ~HnComputeSkinning();
+
+    // clang-format off
+    HnComputeSkinning           (const HnComputeSkinning&)  = delete;
+    HnComputeSkinning           (      HnComputeSkinning&&) = delete;
+    HnComputeSkinning& operator=(const HnComputeSkinning&)  = delete;
+    HnComputeSkinning& operator=(      HnComputeSkinning&&) = delete;
+    // clang-format on
+
+    /// Skins all visible meshes whose joint transforms have changed.
+    ///
+    /// \remarks    This method must be called once per frame after all mesh
+    ///             GPU resources have been committed.
+    void Execute(HnRenderDelegate& RenderDelegate);
+
+private:
+    bool PreparePSO(HnRenderDelegate& RenderDelegate);
+    void PrepareJointMatricesBuffer(IRenderDevice* pDevice, IDeviceContext* pCtx);
+
+private:
+    const Uint32 m_ThreadGroupSize;
+
+    RefCntAutoPtr<IPipelineState> m_PSO;
+    RefCntAutoPtr<IBuffer>        m_AttribsCB;
+    RefCntAutoPtr<IBuffer>        m_JointMatricesBuffer;
+
+    // Rows of the joint matrices of all meshes that need to be skinned this frame
+    std::vector<float4> m_JointMatrices;
+
+    struct PendingDispatch
+    {
+        entt::entity Entity;
+        // Offsets of the first joint matrix row in m_JointMatrices
+        Uint32       JointsOffset;
+        Uint32       PrevJointsOffset;
+        Uint32       JointCount;
+    };
+    std::vector<PendingDispatch>     m_PendingDispatches;
+    std::vector<StateTransitionDesc> m_Barriers;
+};
+
+} // namespace USD
+
+} // namespace Diligent
@@ -66,6 +66,9 @@ public:
         RefCntAutoPtr<IBuffer> VertexColors;
         RefCntAutoPtr<IBuffer> Joints;
 
+        // Previous-frame positions of the pre-skinned geometry.
+        RefCntAutoPtr<IBuffer> PrevPositions;
+
         std::array<RefCntAutoPtr<IBuffer>, 2> TexCoords;
 
         operator bool() const { return Positions; }
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "entt/entity/entity.hpp"
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+namespace USD
+{
+
+/// Draw list item sort key.
+struct HnDrawListSortKey
+{
+    const void*  pPSO   = nullptr;
+    const void*  pSRB   = nullptr;
+    entt::entity Entity = entt::null;
+
+    bool operator<(const HnDrawListSortKey& rhs) const noexcept
+    {
+        // Sort by PSO first, then by material SRB, then by entity ID
+        if (pPSO != rhs.pPSO)
+            return pPSO < rhs.pPSO;
+        if (pSRB != rhs.pSRB)
+            return pSRB < rhs.pSRB;
+        return Entity < rhs.Entity;
+    }
+};
+
+/// Computes the order in which draw list items should be rendered to minimize render state changes.
+///
+/// \param [out] RenderOrder - Indices of the draw list items in the render order.
+/// \param [in]  NumItems    - The number of items in the draw list.
+/// \param [in]  GetSortKey  - Function that returns the sort key (HnDrawListSortKey) of the item with the given index.
+/// \return     true if the render order is different from the original order of the items.
+template <typename GetSortKeyType>
+bool SortDrawList(std::vector<Uint32>& RenderOrder, size_t NumItems, GetSortKeyType&& GetSortKey)
+{
+    RenderOrder.resize(NumItems);
+    for (Uint32 i = 0; i < RenderOrder.size(); ++i)
+        RenderOrder[i] = i;
+
+    bool DrawOrderDirty = false;
+
+    std::sort(RenderOrder.begin(), RenderOrder.end(),
+              [&GetSortKey, &DrawOrderDirty](Uint32 i0, Uint32 i1) {
+                  const bool Item0PrecedesItem1 = GetSortKey(i0) < GetSortKey(i1);
+                  if ((i0 < i1) != Item0PrecedesItem1)
+                      DrawOrderDirty = true;
+
+                  return Item0PrecedesItem1;
+              });
+
+    return DrawOrderDirty;
+}
+
+} // namespace USD
+
+} // namespace Diligent
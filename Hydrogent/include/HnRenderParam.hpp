@@ -28,11 +28,14 @@
 
 #include <atomic>
 #include <array>
+#include <mutex>
+#include <vector>
 
 #include "HnTypes.hpp"
 
 #include "pxr/imaging/hd/renderDelegate.h"
 #include "../../PBR/interface/PBR_Renderer.hpp"
+#include "../../../DiligentCore/Common/interface/AdvancedMath.hpp"
 
 namespace Diligent
 {
@@ -48,7 +51,11 @@ public:
                   bool                              UseIndexPool,
                   bool                              AsyncShaderCompilation,
                   HN_MATERIAL_TEXTURES_BINDING_MODE TextureBindingMode,
-                  float                             MetersPerUnit) noexcept;
+                  float                             MetersPerUnit,
+                  bool                              ReversedDepth,
+                  bool                              PackedNormals,
+                  bool                              PackMaterialWithNormals,
+                  TEXTURE_FORMAT                    MeshIdFormat) noexcept;
     ~HnRenderParam();
 
     bool                              GetUseVertexPool() const { return m_UseVertexPool; }
@@ -56,6 +63,10 @@ public:
     bool                              GetAsyncShaderCompilation() const { return m_AsyncShaderCompilation; }
     HN_MATERIAL_TEXTURES_BINDING_MODE GetTextureBindingMode() const { return m_TextureBindingMode; }
     float                             GetMetersPerUnit() const { return m_MetersPerUnit; }
+    bool                              GetReversedDepth() const { return m_ReversedDepth; }
+    bool                              GetPackedNormals() const { return m_PackedNormals; }
+    bool                              GetPackMaterialWithNormals() const { return m_PackMaterialWithNormals; }
+    TEXTURE_FORMAT                    GetMeshIdFormat() const { return m_MeshIdFormat; }
 
     HN_RENDER_MODE GetRenderMode() const { return m_RenderMode; }
     void           SetRenderMode(HN_RENDER_MODE Mode) { m_RenderMode = Mode; }
@@ -118,6 +129,16 @@ public:
     Uint32 GetFrameNumber() const { return m_FrameNumber; }
     void   SetFrameNumber(Uint32 FrameNumber) { m_FrameNumber = FrameNumber; }
 
+    /// Notifies that shadow-casting geometry in the given world-space region has changed.
+    /// If the bounding box is invalid, all shadow maps are considered affected.
+    ///
+    /// \remarks    This method is thread-safe and may be called from parallel rprim sync.
+    void AddDirtyShadowCasterBounds(const BoundBox& Bounds);
+
+    /// Moves all dirty shadow caster regions accumulated since the last call to DirtyBounds.
+    /// Returns false if the affected region is unknown and all shadow maps must be updated.
+    bool ExtractDirtyShadowCasterBounds(std::vector<BoundBox>& DirtyBounds);
+
 private:
     const bool m_UseVertexPool;
     const bool m_UseIndexPool;
@@ -127,6 +148,12 @@ private:
 
     const float m_MetersPerUnit;
 
+    const bool m_ReversedDepth;
+    const bool m_PackedNormals;
+    const bool m_PackMaterialWithNormals;
+
+    const TEXTURE_FORMAT m_MeshIdFormat;
+
     HN_RENDER_MODE m_RenderMode = HN_RENDER_MODE_SOLID;
 
     pxr::SdfPath m_SelectedPrimId;
@@ -140,6 +167,10 @@ private:
     double   m_FrameTime   = 0.0;
     float    m_ElapsedTime = 0.0;
     uint32_t m_FrameNumber = 0;
+
+    std::mutex            m_DirtyShadowCasterBoundsMtx;
+    std::vector<BoundBox> m_DirtyShadowCasterBounds;
+    bool                  m_AllShadowCastersDirty = false;
 };
 
 } // namespace USD
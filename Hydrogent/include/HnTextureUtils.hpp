@@ -35,8 +35,23 @@ namespace Diligent
 namespace USD
 {
 
+/// Creates a texture loader for the asset at the specified SDF path.
+///
+/// \param [in] SdfPath        - Asset path.
+/// \param [in] LoadInfo       - Texture load info.
+/// \param [in] CacheDirectory - Optional directory of the processed texture cache.
+///
+/// \remarks   If CacheDirectory is not null, fully processed textures (decoded, swizzled,
+///            flipped, premultiplied, with the complete mip chain and optionally
+///            block-compressed) are stored in the cache directory as DDS files.
+///            The file name is derived from the hash of the asset contents and
+///            all texture load parameters that affect the result, so that stale
+///            entries are never used. On subsequent loads, the texture is read
+///            from the cache without decoding the source image.
+///            Assets that are already DDS or KTX files are never cached.
 RefCntAutoPtr<ITextureLoader> CreateTextureLoaderFromSdfPath(const char*            SdfPath,
-                                                             const TextureLoadInfo& LoadInfo);
+                                                             const TextureLoadInfo& LoadInfo,
+                                                             const char*            CacheDirectory = nullptr);
 
 } // namespace USD
 
@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <vector>
+#include <memory>
+
 #include "pxr/imaging/hd/light.h"
 
 #include "../../../DiligentCore/Common/interface/BasicMath.hpp"
@@ -46,6 +49,7 @@ namespace USD
 {
 
 class HnRenderDelegate;
+class HnShadowMapManager;
 
 /// Light implementation in Hydrogent.
 class HnLight final : public pxr::HdLight
@@ -72,29 +76,93 @@ public:
     const float4x4&     GetViewMatrix() const { return m_ViewMatrix; }
     const float4x4&     GetProjMatrix() const { return m_ProjMatrix; }
     const float4x4&     GetViewProjMatrix() const { return m_ViewProjMatrix; }
-    bool                ShadowsEnabled() const { return m_ShadowMapSuballocation != nullptr && m_SceneBounds.IsValid(); }
+    bool                ShadowsEnabled() const { return !m_ShadowCascades.empty() && m_SceneBounds.IsValid(); }
+
+    /// Maximum number of shadow cascades a directional light can use.
+    static constexpr Uint32 MaxShadowCascades = 4;
+
+    /// Returns the number of shadow cascades allocated for the light.
+    /// Every cascade occupies its own region in the shadow map atlas as well as
+    /// its own shadow pass frame attributes slot.
+    Uint32 GetNumShadowCascades() const { return static_cast<Uint32>(m_ShadowCascades.size()); }
 
     /// Sets the index of the light's frame attributes data in the frame attribs buffer.
     /// This index is passed to the HnRenderDelegate::GetShadowPassFrameAttribsSRB
     /// method to set the offset in the frame attribs buffer.
+    ///
+    /// \remarks    Cascade i of the light uses the frame attributes slot Index + i.
     void SetFrameAttribsIndex(Int32 Index) { m_FrameAttribsIndex = Index; }
 
     /// Returns the index of the light's frame attributes data in the frame attribs buffer.
     Int32 GetFrameAttribsIndex() const { return m_FrameAttribsIndex; }
 
-    ITextureAtlasSuballocation*   GetShadowMapSuballocation() const { return m_ShadowMapSuballocation; }
-    const HLSL::PBRShadowMapInfo* GetShadowMapShaderInfo() const { return m_ShadowMapShaderInfo.get(); }
+    ITextureAtlasSuballocation*   GetShadowMapSuballocation(Uint32 Cascade = 0) const;
+    const HLSL::PBRShadowMapInfo* GetShadowMapShaderInfo(Uint32 Cascade = 0) const;
+    const float4x4&               GetCascadeProjMatrix(Uint32 Cascade) const;
+    const float4x4&               GetCascadeViewProjMatrix(Uint32 Cascade) const;
+
+    /// Returns true if the shadow map of any cascade needs to be re-rendered.
+    bool IsShadowMapDirty() const;
+
+    /// Sets the dirty flag for all shadow cascades.
+    void SetShadowMapDirty(bool IsDirty);
+
+    bool IsShadowCascadeDirty(Uint32 Cascade) const;
+    void SetShadowCascadeDirty(Uint32 Cascade, bool IsDirty);
+
+    /// Shadow cascade update parameters.
+    struct ShadowCascadeUpdateInfo
+    {
+        /// Camera view matrix.
+        const float4x4* pCameraView = nullptr;
 
-    bool IsShadowMapDirty() const { return m_IsShadowMapDirty; }
-    void SetShadowMapDirty(bool IsDirty) { m_IsShadowMapDirty = IsDirty; }
+        /// Camera projection matrix.
+        const float4x4* pCameraProj = nullptr;
+
+        /// Current frame number.
+        Uint32 FrameNumber = 0;
+
+        /// Distant cascades (all cascades except the first one) are re-fit to the
+        /// camera at most once every DistantCascadeUpdateInterval frames, unless
+        /// the camera moves far enough (see DistantCascadeMaxCameraOffset).
+        Uint32 DistantCascadeUpdateInterval = 4;
+
+        /// Distant cascades are extended by this fraction of the cascade radius.
+        /// A cascade is re-fit immediately when the camera frustum slice it covers
+        /// moves by more than this distance since the last update.
+        float DistantCascadeMaxCameraOffset = 0.1f;
+
+        /// Ratio between uniform (0.0) and logarithmic (1.0) cascade partitioning.
+        float PartitioningFactor = 0.95f;
+
+        /// Whether the device uses the OpenGL-style NDC.
+        bool IsGL = false;
+    };
+
+    /// Fits shadow cascades to the camera frustum.
+    ///
+    /// \remarks    The method does nothing if the light uses a single shadow map,
+    ///             which always covers the entire scene.
+    ///             Cascades whose projection changes are marked dirty.
+    void UpdateShadowCascades(const ShadowCascadeUpdateInfo& UpdateInfo);
 
     void PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate);
 
+    /// Allocates or releases shadow map cascades and updates their transforms.
+    ///
+    /// \remarks    Sync() only records the changes since it may run in parallel
+    ///             with other lights, while the shadow map atlas is shared by all of them.
+    ///             This method must be called from the render thread before
+    ///             the shadow map manager is committed.
+    void CommitGPUResources(HnRenderDelegate& RenderDelegate);
+
 private:
     HnLight(const pxr::SdfPath& Id, const pxr::TfToken& TypeId);
 
     bool ApproximateAreaLight(pxr::HdSceneDelegate& SceneDelegate, float MetersPerUnit);
-    void ComputeDirectLightProjMatrix(pxr::HdSceneDelegate& SceneDelegate);
+    void ComputeDirectLightProjMatrix(const HnRenderDelegate& RenderDelegate);
+    void ReleaseShadowCascades();
+    bool AllocateShadowCascades(HnShadowMapManager& ShadowMapMgr);
 
 private:
     const pxr::TfToken m_TypeId;
@@ -102,21 +170,44 @@ private:
     float3      m_Position;
     float3      m_Direction;
     GLTF::Light m_Params;
-    bool        m_IsVisible        = true;
-    bool        m_IsShadowMapDirty = true;
-    bool        m_IsTextureDirty   = true;
+    bool        m_IsVisible      = true;
+    bool        m_IsTextureDirty = true;
 
     float4x4 m_ViewMatrix;
     float4x4 m_ProjMatrix;
     float4x4 m_ViewProjMatrix;
     BoundBox m_SceneBounds;
+    // Scene bounds in light view space
+    BoundBox m_LightSpaceSceneBounds;
+    // Version of the render delegate scene bounds used to compute the projection
+    Uint32 m_SceneBoundsVersion = ~0u;
 
     std::string m_TexturePath;
 
-    Int32                                     m_FrameAttribsIndex   = 0;
-    Uint32                                    m_ShadowMapResolution = 1024;
-    RefCntAutoPtr<ITextureAtlasSuballocation> m_ShadowMapSuballocation;
-    std::unique_ptr<HLSL::PBRShadowMapInfo>   m_ShadowMapShaderInfo;
+    struct ShadowCascade
+    {
+        RefCntAutoPtr<ITextureAtlasSuballocation> Suballocation;
+        std::unique_ptr<HLSL::PBRShadowMapInfo>   ShaderInfo;
+
+        float4x4 ProjMatrix;
+        float4x4 ViewProjMatrix;
+
+        // Light-space center and radius of the camera frustum slice the cascade was fit to
+        float3 Center;
+        float  Radius = 0;
+
+        Uint32 LastUpdateFrame = 0;
+        bool   IsDirty         = true;
+    };
+
+    Int32                      m_FrameAttribsIndex     = 0;
+    Uint32                     m_ShadowMapResolution   = 1024;
+    Uint32                     m_NumShadowCascades     = 1;
+    bool                       m_ShadowCascadesInvalid = true;
+    bool                       m_CastShadows           = false;
+    bool                       m_ShadowCascadesDirty   = false;
+    bool                       m_ShadowTransformDirty  = false;
+    std::vector<ShadowCascade> m_ShadowCascades;
 };
 
 } // namespace USD
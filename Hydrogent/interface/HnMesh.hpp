@@ -37,9 +37,11 @@
 
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h"
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/ShaderResourceBinding.h"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/GraphicsTypesX.hpp"
 #include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../DiligentCore/Common/interface/BasicMath.hpp"
+#include "../../../DiligentCore/Common/interface/AdvancedMath.hpp"
 #include "../../../DiligentCore/Common/interface/STDAllocator.hpp"
 
 #include "entt/entity/entity.hpp"
@@ -114,6 +116,28 @@ public:
 
             explicit operator bool() const { return Xforms != nullptr; }
         };
+
+        // Compute pre-skinning data. Only present if compute skinning is
+        // enabled in the render delegate and the mesh uses it.
+        struct ComputeSkinning
+        {
+            RefCntAutoPtr<IBuffer> Points;
+            RefCntAutoPtr<IBuffer> Normals;
+            RefCntAutoPtr<IBuffer> Joints;
+            RefCntAutoPtr<IBuffer> SkinnedPoints;
+            RefCntAutoPtr<IBuffer> SkinnedNormals;
+            RefCntAutoPtr<IBuffer> PrevSkinnedPoints;
+
+            Uint32 StartVertex = 0;
+            Uint32 NumVertices = 0;
+
+            // The members below are maintained by HnComputeSkinning
+            RefCntAutoPtr<IShaderResourceBinding> SRB;
+            const pxr::VtMatrix4fArray*           PrevXforms = nullptr;
+            size_t                                XformsHash = 0;
+            // Whether previous-frame skinned points are the same as the current ones
+            bool PrevMatchesCurr = false;
+        };
     };
 
     CULL_MODE GetCullMode() const { return m_CullMode != CULL_MODE_UNDEFINED ? m_CullMode : CULL_MODE_BACK; }
@@ -125,6 +149,10 @@ public:
 
     entt::entity GetEntity() const { return m_Entity; }
 
+    /// Returns the world-space bounds of the geometry that the mesh renders into shadow maps.
+    /// If the mesh is not visible, the bounds are invalid.
+    const BoundBox& GetShadowCasterBounds() const { return m_ShadowCasterBounds; }
+
 protected:
     // This callback from Rprim gives the prim an opportunity to set
     // additional dirty bits based on those already set.
@@ -204,6 +232,9 @@ private:
 
     void GenerateSmoothNormals();
 
+    bool CanUseComputeSkinning(const HnRenderDelegate& RenderDelegate) const;
+    void UpdateComputeSkinningComponent(HnRenderDelegate& RenderDelegate);
+
     struct GeometrySubsetRange
     {
         Uint32 StartIndex = 0;
@@ -231,6 +262,10 @@ private:
 
     void Invalidate();
 
+    void UpdateShadowCasterBounds(pxr::HdSceneDelegate& SceneDelegate,
+                                  pxr::HdRenderParam*   RenderParam,
+                                  bool                  ForceUpdate);
+
 private:
     const Uint32       m_UID;
     const entt::entity m_Entity;
@@ -289,13 +324,21 @@ private:
 
     bool      m_HasFaceVaryingPrimvars = false;
     bool      m_IsDoubleSided          = false;
+    bool      m_UseComputeSkinning     = false;
     CULL_MODE m_CullMode               = CULL_MODE_UNDEFINED;
 
     std::atomic<Uint32> m_GeometryVersion{0};
     std::atomic<Uint32> m_MaterialVersion{0};
     std::atomic<Uint32> m_SkinningPrimvarsVersion{0};
 
+    // Incremented when geometry subsets or skinning transforms change.
+    // Such changes affect shadow maps even if the mesh bounds remain the same.
+    Uint32 m_ShadowCasterVersion = 0;
+    size_t m_SkinningXformsHash  = 0;
+
     float4x4 m_SkelLocalToPrimLocal = float4x4::Identity();
+
+    BoundBox m_ShadowCasterBounds = BoundBox::Invalid();
 };
 
 } // namespace USD
@@ -38,6 +38,7 @@
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "../../../DiligentCore/Graphics/GraphicsTools/interface/RenderStateCache.h"
 #include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
+#include "../../../DiligentCore/Common/interface/AdvancedMath.hpp"
 #include "../../PBR/interface/USD_Renderer.hpp"
 
 #include "entt/entity/registry.hpp"
@@ -61,6 +62,8 @@ class HnMesh;
 class HnLight;
 class HnRenderParam;
 class HnShadowMapManager;
+class HnComputeSkinning;
+class HnTaskProfiler;
 
 /// Memory usage statistics of the render delegate.
 struct HnRenderDelegateMemoryStats
@@ -168,6 +171,34 @@ public:
         /// If zero, the renderer will automatically determine the array size.
         Uint32 TexturesArraySize = 0;
 
+        /// Texture compression mode for material textures loaded from uncompressed
+        /// image files (PNG, JPEG, etc.).
+        ///
+        /// \remarks    Textures that are already block-compressed (e.g. BC-compressed
+        ///             DDS or KTX files) are always used as is.
+        ///             Compression is performed by the texture loader when the material
+        ///             is synced, which may happen in parallel worker threads.
+        ///             In atlas mode, each compressed format gets its own atlas.
+        TEXTURE_LOAD_COMPRESS_MODE TextureCompressMode = TEXTURE_LOAD_COMPRESS_MODE_NONE;
+
+        /// Optional directory where fully processed material textures are cached.
+        ///
+        /// \remarks    When set, decoded textures with their complete mip chains
+        ///             (compressed if TextureCompressMode is not NONE) are stored in
+        ///             this directory and reused on subsequent loads, so that source
+        ///             images do not need to be decoded again. Cache entries are keyed by
+        ///             the hash of the source file contents and the texture load parameters.
+        ///             The directory may be shared by several processes: entries are written
+        ///             to temporary files with process-unique names and then renamed.
+        const char* TextureCacheDirectory = nullptr;
+
+        /// Optional directory where precomputed IBL textures are cached.
+        ///
+        /// \remarks    See PBR_Renderer::CreateInfo::IBLCacheDirectory.
+        ///             Dome light cube maps are keyed by the content hash of the
+        ///             environment map texture.
+        const char* IBLCacheDirectory = nullptr;
+
         /// The size of the multi-draw batch. If zero, multi-draw batching is disabled.
         ///
         /// \remarks    Multi-draw batching requires the NativeMultiDraw device feature.
@@ -184,15 +215,89 @@ public:
         Uint32 MaxLightCount = 16;
 
         /// The maximum number of shadow-casting lights that can be used by the render delegate.
+        ///
+        /// \remarks    Every shadow cascade of a directional light counts as a separate
+        ///             shadow-casting light.
         Uint32 MaxShadowCastingLightCount = 8;
 
+        /// Whether to enable clustered light culling.
+        ///
+        /// \remarks    When enabled, point and spot lights that do not cast shadows
+        ///             are binned into a clustered light grid and are not limited by
+        ///             MaxLightCount. The light range is derived from the intensity
+        ///             and HnBeginFrameTaskParams::RendererParams::LightIntensityCutoff.
+        bool EnableClusteredLighting = false;
+
         /// Meters per logical unit.
         float MetersPerUnit = 1.0f;
 
+        /// Whether to use reversed depth (near plane at 1, far plane at 0).
+        ///
+        /// \remarks    Reversed depth combined with a floating-point depth buffer
+        ///             provides nearly uniform precision over the entire depth range.
+        ///             When enabled, camera projection matrices map the near plane to 1
+        ///             and the far plane to 0. HnBeginFrameTaskParams::ClearDepth and
+        ///             HnBeginFrameTaskParams::RenderState::DepthFunc are still specified
+        ///             for the conventional depth and are reversed automatically.
+        ///             Shadow maps always use conventional depth.
+        bool ReversedDepth = false;
+
+        /// Whether to store octahedron-encoded normals in the G-buffer.
+        ///
+        /// \remarks    When enabled, the normal target uses the RG16_UNORM format
+        ///             regardless of HnBeginFrameTaskParams::RenderTargetFormats::GBuffer,
+        ///             which halves the normal target bandwidth compared to the default
+        ///             RGBA16_FLOAT format. Post-processing effects that read the normals
+        ///             are configured to decode them automatically.
+        bool PackedNormals = false;
+
+        /// Whether to store the roughness and metallic in the blue and alpha channels
+        /// of the normal target.
+        ///
+        /// \remarks    This option implies PackedNormals. The normal target uses the RGBA16_UNORM
+        ///             format, and the material target is not allocated, which saves one render
+        ///             target compared to the default layout. Occlusion is not stored. The normal
+        ///             target is not blended, so for transparent surfaces it contains the normal
+        ///             and the material of the last rendered layer.
+        bool PackMaterialWithNormals = false;
+
+        /// Mesh ID target format.
+        ///
+        /// \remarks    Supported formats are TEX_FORMAT_R32_FLOAT, TEX_FORMAT_R32_UINT and
+        ///             TEX_FORMAT_R16_UINT. The R16_UINT format halves the target size, but only
+        ///             supports up to 65535 meshes, and a warning is logged when this limit is exceeded.
+        ///             The mesh ID in HnBeginFrameTaskParams::RenderTargetFormats is overridden with
+        ///             this format.
+        TEXTURE_FORMAT MeshIdFormat = TEX_FORMAT_R32_FLOAT;
+
         /// The maximum number of joints.
         ///
         /// If set to 0, skinning will be disabled.
         Uint32 MaxJointCount = 128;
+
+        /// Joint transform format, see PBR_Renderer::JOINTS_FORMAT.
+        ///
+        /// \remarks    Compact formats reduce the size of the joint transforms
+        ///             buffer and allow more joints per mesh.
+        PBR_Renderer::JOINTS_FORMAT JointsFormat = PBR_Renderer::JOINTS_FORMAT_MATRIX4X4;
+
+        /// Whether to skin meshes in a compute shader.
+        ///
+        /// \remarks    When enabled, skinned positions and normals are computed once per frame
+        ///             and are shared by all render passes. Meshes whose joint transforms have
+        ///             not changed are not re-skinned. Previous-frame skinned positions are also
+        ///             computed to produce exact motion vectors.
+        bool EnableComputeSkinning = false;
+
+        /// Optional immediate context of an async compute queue.
+        ///
+        /// \remarks    When set, the ambient occlusion pass of the post-processing task
+        ///             runs on this context and overlaps with the screen-space reflections
+        ///             that are rendered on the main context, see
+        ///             ScreenSpaceAmbientOcclusion::CreateInfo::pAsyncComputeContext.
+        ///             The G-buffer normal target and the post-processing resources read by
+        ///             the pass are created for both contexts.
+        IDeviceContext* pAsyncComputeContext = nullptr;
     };
     static std::unique_ptr<HnRenderDelegate> Create(const CreateInfo& CI);
 
@@ -324,9 +429,14 @@ public:
 
     HnTextureRegistry&  GetTextureRegistry() { return m_TextureRegistry; }
     HnShadowMapManager* GetShadowMapManager() const { return m_ShadowMapManager.get(); }
+    HnComputeSkinning*  GetComputeSkinning() const { return m_ComputeSkinning.get(); }
+    HnTaskProfiler&     GetTaskProfiler() const { return *m_TaskProfiler; }
 
     const pxr::SdfPath* GetRPrimId(Uint32 UID) const;
 
+    /// Returns the value that is greater than all RPrim UIDs allocated so far.
+    Uint32 GetRPrimUIDBound() const { return m_RPrimNextUID.load(); }
+
     std::shared_ptr<USD_Renderer> GetUSDRenderer() const { return m_USDRenderer; }
 
     entt::registry& GetEcsRegistry() { return m_EcsRegistry; }
@@ -335,16 +445,35 @@ public:
 
     IRenderDevice*     GetDevice() const { return m_pDevice; }
     IDeviceContext*    GetDeviceContext() const { return m_pContext; }
+    IDeviceContext*    GetAsyncComputeContext() const { return m_pAsyncComputeContext; }
     IRenderStateCache* GetRenderStateCache() const { return m_pRenderStateCache; }
     IBuffer*           GetFrameAttribsCB() const { return m_FrameAttribsCB; }
     IBuffer*           GetPrimitiveAttribsCB() const { return m_PrimitiveAttribsCB; }
 
+    /// Returns the mask of the main immediate context.
+    Uint64 GetMainContextMask() const { return m_MainContextMask; }
+
+    /// Returns the mask of the immediate contexts that the resources
+    /// shared with the async compute context must be created for.
+    ///
+    /// \remarks    If async compute is not used, the mask only contains the main context.
+    Uint64 GetAsyncComputeContextMask() const { return m_AsyncComputeContextMask; }
+
     IShaderResourceBinding* GetMainPassFrameAttribsSRB() const { return m_MainPassFrameAttribsSRB; }
     IShaderResourceBinding* GetShadowPassFrameAttribsSRB(Uint32 LightId) const;
     Uint32                  GetShadowPassFrameAttribsOffset(Uint32 LightId) const;
 
     const auto& GetLights() const { return m_Lights; }
 
+    /// Returns conservative world-space bounds of all visible meshes.
+    ///
+    /// \remarks    The bounds are updated once per frame by CommitResources().
+    ///             They are padded and only refit when the meshes leave them or occupy a much
+    ///             smaller volume, so that animated scenes do not invalidate shadow maps every frame.
+    ///             The version is incremented every time the bounds are refit.
+    const BoundBox& GetSceneBounds() const { return m_SceneBounds; }
+    Uint32          GetSceneBoundsVersion() const { return m_SceneBoundsVersion; }
+
     HnRenderDelegateMemoryStats GetMemoryStats() const;
 
     void SetDebugView(PBR_Renderer::DebugViewType DebugView);
@@ -354,6 +483,9 @@ public:
 
     IObject* GetMaterialSRBCache() const { return m_MaterialSRBCache; }
 
+private:
+    void UpdateSceneBounds();
+
 private:
     static const pxr::TfTokenVector SupportedRPrimTypes;
     static const pxr::TfTokenVector SupportedSPrimTypes;
@@ -361,8 +493,12 @@ private:
 
     RefCntAutoPtr<IRenderDevice>     m_pDevice;
     RefCntAutoPtr<IDeviceContext>    m_pContext;
+    RefCntAutoPtr<IDeviceContext>    m_pAsyncComputeContext;
     RefCntAutoPtr<IRenderStateCache> m_pRenderStateCache;
 
+    Uint64 m_MainContextMask         = 1;
+    Uint64 m_AsyncComputeContextMask = 1;
+
     RefCntAutoPtr<GLTF::ResourceManager> m_ResourceMgr;
     RefCntAutoPtr<IBuffer>               m_PrimitiveAttribsCB;
     RefCntAutoPtr<IObject>               m_MaterialSRBCache;
@@ -392,6 +528,8 @@ private:
     HnTextureRegistry                   m_TextureRegistry;
     std::unique_ptr<HnRenderParam>      m_RenderParam;
     std::unique_ptr<HnShadowMapManager> m_ShadowMapManager;
+    std::unique_ptr<HnComputeSkinning>  m_ComputeSkinning;
+    std::unique_ptr<HnTaskProfiler>     m_TaskProfiler;
 
     std::atomic<Uint32>                      m_RPrimNextUID{1};
     mutable std::mutex                       m_RPrimUIDToSdfPathMtx;
@@ -410,6 +548,9 @@ private:
     Uint32 m_MaterialResourcesVersion = ~0u;
     Uint32 m_ShadowAtlasVersion       = ~0u;
     Uint32 m_LightResourcesVersion    = ~0u;
+
+    BoundBox m_SceneBounds        = BoundBox::Invalid();
+    Uint32   m_SceneBoundsVersion = 0;
 };
 
 } // namespace USD
@@ -122,6 +122,7 @@ public:
         VERTEX_BUFFER_SLOT_TEX_COORDS1,
         VERTEX_BUFFER_SLOT_VERTEX_COLORS,
         VERTEX_BUFFER_SLOT_VERTEX_JOINTS,
+        VERTEX_BUFFER_SLOT_PREV_POSITIONS,
         VERTEX_BUFFER_SLOT_COUNT
     };
 
@@ -198,6 +199,10 @@ private:
 private:
     HnRenderPassParams m_Params;
 
+    // Output flags of m_Params.UsdPsoFlags that correspond to the
+    // render targets present in the current render pass state.
+    USD_Renderer::USD_PSO_FLAGS m_UsdPsoFlags = USD_Renderer::USD_PSO_FLAG_NONE;
+
     HN_RENDER_MODE              m_RenderMode     = HN_RENDER_MODE_SOLID;
     PBR_Renderer::DebugViewType m_DebugView      = PBR_Renderer::DebugViewType::None;
     bool                        m_UseShadows     = false;
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <unordered_map>
 #include <atomic>
+#include <string>
 
 #include "pxr/pxr.h"
 #include "pxr/base/tf/token.h"
@@ -59,8 +60,10 @@ struct HnTextureIdentifier;
 class HnTextureRegistry final
 {
 public:
-    HnTextureRegistry(IRenderDevice*         pDevice,
-                      GLTF::ResourceManager* pResourceManager);
+    HnTextureRegistry(IRenderDevice*             pDevice,
+                      GLTF::ResourceManager*     pResourceManager,
+                      TEXTURE_LOAD_COMPRESS_MODE CompressMode   = TEXTURE_LOAD_COMPRESS_MODE_NONE,
+                      const char*                CacheDirectory = nullptr);
     ~HnTextureRegistry();
 
     void Commit(IDeviceContext* pContext);
@@ -100,6 +103,8 @@ public:
 
     Uint32 GetAtlasVersion() const;
 
+    TEXTURE_LOAD_COMPRESS_MODE GetCompressMode() const { return m_CompressMode; }
+
     template <typename HandlerType>
     void ProcessTextures(HandlerType&& Handler)
     {
@@ -118,6 +123,13 @@ private:
 
     GLTF::ResourceManager* const m_pResourceManager;
 
+    // Compression mode for textures loaded from uncompressed image files (PNG, JPEG, etc.).
+    // DDS and KTX textures that are already block-compressed are always used as is.
+    const TEXTURE_LOAD_COMPRESS_MODE m_CompressMode;
+
+    // Directory of the processed texture cache. If empty, the cache is disabled.
+    const std::string m_CacheDirectory;
+
     ObjectsRegistry<pxr::TfToken, TextureHandleSharedPtr, pxr::TfToken::HashFunctor> m_Cache;
 
     struct PendingTextureInfo
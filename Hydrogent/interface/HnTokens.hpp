@@ -130,12 +130,14 @@ namespace USD
 	(taaReset)							 \
 	(suspendSuperSampling)				 \
     (cameraTransformDirty)               \
+    (camera)                             \
     (renderPass_OpaqueSelected)		     \
     (renderPass_TransparentSelected)	 \
     (renderPass_OpaqueUnselected_TransparentAll) \
     (renderPass_Shadow) \
     (backgroundDepth)   \
-	(fallBackPsoInUse)
+	(fallBackPsoInUse)  \
+    (renderPassSkipped)
 
 
 // clang-format on
@@ -44,6 +44,11 @@ namespace Diligent
 
 struct ITextureView;
 
+namespace HLSL
+{
+struct PBRLightAttribs;
+} // namespace HLSL
+
 namespace USD
 {
 
@@ -53,6 +58,17 @@ struct HnBeginFrameTaskParams
 {
     struct RenderTargetFormats
     {
+        /// G-buffer target formats.
+        ///
+        /// \remarks    Setting the format of any target other than the scene color to
+        ///             TEX_FORMAT_UNKNOWN skips that target. The renderer then does not write it,
+        ///             and post-processing effects that require it are disabled. The R11G11B10_FLOAT
+        ///             format may be used for the scene color and IBL targets to save bandwidth.
+        ///             Since the scene color alpha masks out the background from SSR and SSAO,
+        ///             both effects are disabled when the scene color format has no alpha channel.
+        ///             The normal and mesh ID formats may be overridden by the render delegate
+        ///             (see HnRenderDelegate::CreateInfo::PackedNormals, PackMaterialWithNormals
+        ///             and MeshIdFormat).
         std::array<TEXTURE_FORMAT, HnFrameRenderTargets::GBUFFER_TARGET_COUNT> GBuffer = {};
 
         TEXTURE_FORMAT Depth                   = TEX_FORMAT_D32_FLOAT;
@@ -123,6 +139,15 @@ struct HnBeginFrameTaskParams
     pxr::SdfPath FinalColorTargetId;
     pxr::SdfPath CameraId;
 
+    /// Internal render resolution relative to the final color target, in (0, 1] range.
+    ///
+    /// \remarks    When the scale is less than one, the G-buffer, depth, selection and jittered
+    ///             color targets are created at the reduced resolution, and HnPostProcessTask
+    ///             reconstructs the full-resolution image with the temporal upscaler
+    ///             (see SuperResolution::FEATURE_FLAG_TEMPORAL_UPSCALING).
+    ///             Typical values are 0.5 - 0.67.
+    float RenderScale = 1;
+
     struct RendererParams
     {
         float OcclusionStrength = 1;
@@ -132,6 +157,10 @@ struct HnBeginFrameTaskParams
         float4 UnshadedColor = {1, 1, 1, 1};
         float  PointSize     = 1;
 
+        /// When clustered lighting is enabled, point and spot lights without shadows are
+        /// culled at the distance where their intensity falls below this value.
+        float LightIntensityCutoff = 0.01f;
+
         float4 LoadingAnimationColor0     = {0.1f, 0.100f, 0.10f, 1.0f};
         float4 LoadingAnimationColor1     = {1.0f, 0.675f, 0.25f, 1.0f};
         float  LoadingAnimationWorldScale = 1.0f;
@@ -145,6 +174,7 @@ struct HnBeginFrameTaskParams
                    IBLScale                   == rhs.IBLScale &&
                    UnshadedColor              == rhs.UnshadedColor &&
                    PointSize                  == rhs.PointSize &&
+                   LightIntensityCutoff       == rhs.LightIntensityCutoff &&
                    LoadingAnimationColor0     == rhs.LoadingAnimationColor0 &&
                    LoadingAnimationColor1     == rhs.LoadingAnimationColor1 &&
                    LoadingAnimationWorldScale == rhs.LoadingAnimationWorldScale &&
@@ -163,6 +193,7 @@ struct HnBeginFrameTaskParams
                State                == rhs.State &&
                FinalColorTargetId   == rhs.FinalColorTargetId &&
                CameraId             == rhs.CameraId &&
+               RenderScale          == rhs.RenderScale &&
                Renderer             == rhs.Renderer;
         // clang-format on
     }
@@ -229,9 +260,16 @@ private:
 
     std::vector<Uint8> m_FrameAttribsData;
 
+    // Lights that are binned into the clustered light grid
+    std::vector<HLSL::PBRLightAttribs> m_ClusteredLights;
+
     Uint32 m_FrameBufferWidth  = 0;
     Uint32 m_FrameBufferHeight = 0;
 
+    // The number of shadow casting lights that did not fit into the shadow cascade budget
+    // when it was last reported
+    Uint32 m_NumShadowBudgetSkippedLights = 0;
+
     Timer m_FrameTimer;
 
     double m_CurrFrameTime           = 0;
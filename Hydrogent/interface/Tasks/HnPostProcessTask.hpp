@@ -45,6 +45,7 @@
 #include "../../PostProcess/TemporalAntiAliasing/interface/TemporalAntiAliasing.hpp"
 #include "../../PostProcess/Bloom/interface/Bloom.hpp"
 #include "../../PostProcess/DepthOfField/interface/DepthOfField.hpp"
+#include "../../PostProcess/SuperResolution/interface/SuperResolution.hpp"
 #include "../../Components/interface/CoordinateGridRenderer.hpp"
 
 namespace Diligent
@@ -62,6 +63,7 @@ namespace HLSL
 #include "../../../Shaders/PostProcess/ScreenSpaceAmbientOcclusion/public/ScreenSpaceAmbientOcclusionStructures.fxh"
 #include "../../../Shaders/PostProcess/Bloom/public/BloomStructures.fxh"
 #include "../../../Shaders/PostProcess/DepthOfField/public/DepthOfFieldStructures.fxh"
+#include "../../../Shaders/PostProcess/SuperResolution/public/SuperResolutionStructures.fxh"
 #include "../../../Shaders/PostProcess/ToneMapping/public/ToneMappingStructures.fxh"
 } // namespace HLSL
 
@@ -123,6 +125,10 @@ struct HnPostProcessTaskParams
     HLSL::CoordinateGridAttribs              Grid;
     HLSL::ToneMappingAttribs                 ToneMapping;
 
+    // Temporal upscaling settings. Used when the frame is rendered at a reduced
+    // internal resolution (see HnBeginFrameTaskParams::RenderScale).
+    HLSL::SuperResolutionAttribs SuperResolution;
+
     constexpr HnPostProcessTaskParams() noexcept
     {
         SSR.MaxTraversalIntersections = 64;
@@ -160,7 +166,8 @@ struct HnPostProcessTaskParams
                memcmp(&DOF,  &rhs.DOF,    sizeof(DOF))                     == 0 &&
                memcmp(&Bloom, &rhs.Bloom, sizeof(Bloom))                   == 0 &&
                memcmp(&Grid,  &rhs.Grid,  sizeof(Grid))                    == 0 &&
-               memcmp(&ToneMapping, &rhs.ToneMapping, sizeof(ToneMapping)) == 0;
+               memcmp(&ToneMapping, &rhs.ToneMapping, sizeof(ToneMapping)) == 0 &&
+               memcmp(&SuperResolution, &rhs.SuperResolution, sizeof(SuperResolution)) == 0;
         // clang-format on
     }
 
@@ -171,6 +178,7 @@ struct HnPostProcessTaskParams
 };
 
 /// Performs post processing:
+/// - Temporal upscaling when the frame is rendered at a reduced resolution
 /// - Tone mapping
 /// - Selection outline
 /// - Converts output to sRGB, if needed
@@ -212,6 +220,7 @@ private:
     std::unique_ptr<TemporalAntiAliasing>        m_TAA;
     std::unique_ptr<DepthOfField>                m_DOF;
     std::unique_ptr<Bloom>                       m_Bloom;
+    std::unique_ptr<SuperResolution>             m_SuperResolution;
 
     ITextureView*               m_FinalColorRTV   = nullptr; // Set in Prepare()
     const HnFrameRenderTargets* m_FrameTargets    = nullptr; // Set in Prepare()
@@ -223,6 +232,9 @@ private:
     bool                        m_UseSSAO         = false;   // Set in Prepare()
     bool                        m_UseDOF          = false;   // Set in Prepare()
     bool                        m_UseBloom        = false;   // Set in Prepare()
+    bool                        m_UseUpscaling    = false;   // Set in Prepare()
+    bool                        m_UseCopyFrame    = false;   // Set in Prepare()
+    bool                        m_ReversedDepth   = false;   // Set in Prepare()
 
     bool m_ResetTAA       = true;
     bool m_AttribsCBDirty = true;
@@ -334,6 +346,7 @@ private:
     private:
         bool ConvertOutputToSRGB = false;
         int  ToneMappingMode     = 0;
+        bool UpsampleFrame       = false;
 
         CoordinateGridRenderer::FEATURE_FLAGS GridFeatureFlags = CoordinateGridRenderer::FEATURE_FLAG_NONE;
     } m_CopyFrameTech;
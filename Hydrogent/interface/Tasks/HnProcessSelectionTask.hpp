@@ -27,22 +27,32 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "HnTask.hpp"
 
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/ShaderResourceBinding.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h"
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Texture.h"
 #include "../../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../../DiligentCore/Common/interface/BasicMath.hpp"
+#include "../../../../DiligentCore/Common/interface/AdvancedMath.hpp"
 
 namespace Diligent
 {
 
+namespace HLSL
+{
+struct CameraAttribs;
+}
+
 namespace USD
 {
 
 struct HnFrameRenderTargets;
+class HnRenderParam;
+class HnMesh;
 
 struct HnProcessSelectionTaskParams
 {
@@ -55,6 +65,11 @@ struct HnProcessSelectionTaskParams
 };
 
 /// Processes selection depth buffer with the jump-flood algorithm.
+///
+/// \remarks    The jump-flood passes are restricted to the screen-space bounds of the selected
+///             meshes extended by the maximum outline distance. If the selection, the camera and
+///             the selected geometry have not changed since the last frame, the passes are skipped
+///             and the closest selected location targets from the previous frame are reused.
 // https://blog.demofox.org/2016/02/29/fast-voronoi-diagrams-and-distance-dield-textures-on-the-gpu-with-the-jump-flooding-algorithm/
 // https://bgolus.medium.com/the-quest-for-very-wide-outlines-ba82ed442cd9
 class HnProcessSelectionTask final : public HnTask
@@ -77,6 +92,13 @@ private:
     void PrepareTechniques(TEXTURE_FORMAT RTVFormat);
     void PrepareSRBs(const HnFrameRenderTargets& FrameTargets);
 
+    // Updates world-space bounds of the selected meshes.
+    void UpdateSelectionBounds(const HnRenderParam& RenderParam);
+
+    // Computes the screen-space region affected by the selection outline.
+    // Returns false if the region is empty.
+    bool GetSelectionRegion(const HLSL::CameraAttribs& Camera, Uint32 Width, Uint32 Height, Rect& Region) const;
+
 private:
     Uint32 m_NumJFIterations = 3;
 
@@ -138,6 +160,53 @@ private:
     } m_UpdateTech;
 
     pxr::SdfPath m_SelectedPrimId;
+
+    // World-space bounds of the selected meshes
+    struct SelectionBounds
+    {
+        pxr::SdfPath SelectedPrimId;
+
+        // Mesh geometry, transform and visibility versions, and RPrim UID bound
+        std::array<Uint32, 4> Versions{};
+
+        BoundBox WorldBounds = BoundBox::Invalid();
+
+        // If false, the selection may cover any part of the screen.
+        bool IsKnown = false;
+
+        // Skinned meshes are animated on the GPU, so their bounds are unknown.
+        std::vector<const HnMesh*> SkinnedMeshes;
+    } m_SelectionBounds;
+
+    // The state that was used to compute the closest selected location last time.
+    struct ProcessedState
+    {
+        pxr::SdfPath          SelectedPrimId;
+        float4x4              ViewProj;
+        float                 ClearDepth      = 0;
+        Uint32                NumJFIterations = 0;
+        std::array<Uint32, 6> Versions{};
+        size_t                SkinningHash = 0;
+
+        std::array<const ITexture*, 3> Targets{};
+        uint2                          TargetSize;
+
+        bool operator==(const ProcessedState& rhs) const
+        {
+            // clang-format off
+            return SelectedPrimId  == rhs.SelectedPrimId  &&
+                   ViewProj        == rhs.ViewProj        &&
+                   ClearDepth      == rhs.ClearDepth      &&
+                   NumJFIterations == rhs.NumJFIterations &&
+                   Versions        == rhs.Versions        &&
+                   SkinningHash    == rhs.SkinningHash    &&
+                   Targets         == rhs.Targets         &&
+                   TargetSize      == rhs.TargetSize;
+            // clang-format on
+        }
+    };
+    ProcessedState m_ProcessedState;
+    bool           m_ProcessedStateValid = false;
 };
 
 } // namespace USD
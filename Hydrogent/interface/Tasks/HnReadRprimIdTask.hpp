@@ -29,8 +29,12 @@
 #include "HnTask.hpp"
 
 #include <memory>
+#include <vector>
 
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h"
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/ShaderResourceBinding.h"
 #include "../../../../DiligentCore/Graphics/GraphicsTools/interface/GPUCompletionAwaitQueue.hpp"
+#include "../../../../DiligentCore/Common/interface/BasicMath.hpp"
 
 namespace Diligent
 {
@@ -38,28 +42,63 @@ namespace Diligent
 namespace USD
 {
 
+/// Region of the mesh id target that is read by the HnReadRprimIdTask.
+enum HN_READ_RPRIM_ID_REGION : Uint8
+{
+    /// A single texel at (LocationX, LocationY) is read.
+    HN_READ_RPRIM_ID_REGION_POINT = 0,
+
+    /// Unique ids of all meshes in the rectangle are collected.
+    HN_READ_RPRIM_ID_REGION_RECT,
+
+    /// Unique ids of all meshes inside the polygon are collected.
+    HN_READ_RPRIM_ID_REGION_POLYGON
+};
+
+/// \remarks    All coordinates are given in pixels of the final color target.
+///             When the frame is rendered at a reduced resolution (see HnBeginFrameTaskParams::RenderScale),
+///             they are scaled to the resolution of the mesh id target.
 struct HnReadRprimIdTaskParams
 {
     bool   IsEnabled = false;
     Uint32 LocationX = 0;
     Uint32 LocationY = 0;
 
-    constexpr bool operator==(const HnReadRprimIdTaskParams& rhs) const
+    HN_READ_RPRIM_ID_REGION Region = HN_READ_RPRIM_ID_REGION_POINT;
+
+    /// Selection rectangle in pixels (left, top, right, bottom) when Region is HN_READ_RPRIM_ID_REGION_RECT.
+    /// Right and bottom bounds are exclusive.
+    uint4 Rect = {};
+
+    /// Vertices of the selection polygon (lasso) in pixels when Region is HN_READ_RPRIM_ID_REGION_POLYGON.
+    /// The polygon is implicitly closed and may be self-intersecting (the even-odd rule is used).
+    std::vector<float2> Polygon;
+
+    bool operator==(const HnReadRprimIdTaskParams& rhs) const
     {
         // clang-format off
         return IsEnabled == rhs.IsEnabled &&
                LocationX == rhs.LocationX &&
-               LocationY == rhs.LocationY;
+               LocationY == rhs.LocationY &&
+               Region    == rhs.Region    &&
+               Rect      == rhs.Rect      &&
+               Polygon   == rhs.Polygon;
         // clang-format on
     }
 
-    constexpr bool operator!=(const HnReadRprimIdTaskParams& rhs) const
+    bool operator!=(const HnReadRprimIdTaskParams& rhs) const
     {
         return !(*this == rhs);
     }
 };
 
 /// Reads the RPrim index from the mesh id target.
+///
+/// \remarks    In the point mode, a single texel is copied to a staging texture.
+///             In the rectangle and polygon modes, a compute pass collects the unique mesh ids
+///             inside the region into a compact list using a bit set to remove duplicates.
+///             In both cases, the data is read back asynchronously and becomes available
+///             a few frames later.
 class HnReadRprimIdTask final : public HnTask
 {
 public:
@@ -82,15 +121,43 @@ public:
     /// If Mesh Id is not available, returns InvalidMeshIndex (~0u).
     Uint32 GetMeshIndex() const { return m_MeshIndex; }
 
+    /// Returns the unique mesh indices collected in the rectangle or polygon region.
+    /// If the data is not available, returns nullptr.
+    const std::vector<Uint32>* GetRegionMeshIndices() const { return m_RegionMeshIndicesAvailable ? &m_RegionMeshIndices : nullptr; }
+
+private:
+    void ReadPoint(ITexture* pMeshIdTexture, const float2& Scale);
+    void ReadRegion(ITexture* pMeshIdTexture, const float2& Scale);
+
+    bool PrepareRegionPSO();
+    void PrepareRegionBuffers(Uint32 MeshIdBound, size_t NumPolygonVerts);
+
 private:
     pxr::HdRenderIndex* m_RenderIndex = nullptr;
 
     using MeshIdReadBackQueueType = GPUCompletionAwaitQueue<RefCntAutoPtr<ITexture>>;
     std::unique_ptr<MeshIdReadBackQueueType> m_MeshIdReadBackQueue;
 
+    using RegionReadBackQueueType = GPUCompletionAwaitQueue<RefCntAutoPtr<IBuffer>>;
+    std::unique_ptr<RegionReadBackQueueType> m_RegionReadBackQueue;
+
     HnReadRprimIdTaskParams m_Params;
 
     Uint32 m_MeshIndex = InvalidMeshIndex;
+
+    RefCntAutoPtr<IPipelineState>         m_RegionPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_RegionSRB;
+    RefCntAutoPtr<IBuffer>                m_RegionAttribsCB;
+    // One bit per mesh id
+    RefCntAutoPtr<IBuffer> m_MeshIdBitsBuffer;
+    // The first element is the number of ids in the list
+    RefCntAutoPtr<IBuffer> m_MeshIdListBuffer;
+    RefCntAutoPtr<IBuffer> m_PolygonBuffer;
+    std::vector<float2>    m_ScaledPolygon;
+    std::vector<Uint32>    m_ZeroData;
+
+    std::vector<Uint32> m_RegionMeshIndices;
+    bool                m_RegionMeshIndicesAvailable = false;
 };
 
 } // namespace USD
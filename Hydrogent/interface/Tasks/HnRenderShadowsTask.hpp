@@ -29,6 +29,7 @@
 #include "HnTask.hpp"
 
 #include <map>
+#include <vector>
 
 #include "../interface/HnRenderPassState.hpp"
 
@@ -36,6 +37,7 @@
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h"
 #include "../../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
+#include "../../../../DiligentCore/Common/interface/AdvancedMath.hpp"
 
 namespace Diligent
 {
@@ -80,9 +82,27 @@ struct HnRenderShadowsTaskParams
 
     float ClearDepth = 1.f;
 
+    /// Distant shadow cascades (all cascades except the first one) are re-fit
+    /// to the camera at most once every DistantCascadeUpdateInterval frames,
+    /// unless the camera moves by more than DistantCascadeMaxCameraOffset.
+    Uint32 DistantCascadeUpdateInterval = 4;
+
+    /// The maximum camera offset, relative to the cascade radius, that distant
+    /// cascades tolerate before they are re-fit.
+    float DistantCascadeMaxCameraOffset = 0.1f;
+
+    /// Ratio between uniform (0.0) and logarithmic (1.0) cascade partitioning.
+    float CascadePartitioningFactor = 0.95f;
+
     constexpr bool operator==(const HnRenderShadowsTaskParams& rhs) const
     {
-        return State == rhs.State && ClearDepth == rhs.ClearDepth;
+        // clang-format off
+        return State                         == rhs.State &&
+               ClearDepth                    == rhs.ClearDepth &&
+               DistantCascadeUpdateInterval  == rhs.DistantCascadeUpdateInterval &&
+               DistantCascadeMaxCameraOffset == rhs.DistantCascadeMaxCameraOffset &&
+               CascadePartitioningFactor     == rhs.CascadePartitioningFactor;
+        // clang-format on
     }
     constexpr bool operator!=(const HnRenderShadowsTaskParams& rhs) const
     {
@@ -110,6 +130,9 @@ private:
     void PrepareClearDepthPSO(const HnRenderDelegate& RenderDelegate);
     void PrepareClearDepthVB(const HnRenderDelegate& RenderDelegate);
 
+    // Returns true if any of the dirty shadow caster regions intersects the shadow frustum of the light's cascade.
+    bool IsShadowFrustumAffected(const HnLight& Light, Uint32 Cascade, bool IsGL) const;
+
 private:
     pxr::HdRenderIndex* m_RenderIndex = nullptr;
 
@@ -122,10 +145,17 @@ private:
     RefCntAutoPtr<IBuffer>        m_ClearDepthVB;
     float                         m_ClearDepthValue = 0.f;
 
-    // Combined geometry version (transform, visibility, etc.) last time we rendered shadows
-    Uint32 m_LastGeometryVersion = ~0u;
+    // World-space regions where shadow-casting geometry has changed since the last frame
+    std::vector<BoundBox> m_DirtyShadowCasterBounds;
 
-    std::multimap<Uint32, HnLight*> m_LightsByShadowSlice;
+    HnRenderShadowsTaskParams m_Params;
+
+    struct ShadowCascadeInfo
+    {
+        HnLight* Light;
+        Uint32   Cascade;
+    };
+    std::multimap<Uint32, ShadowCascadeInfo> m_CascadesByShadowSlice;
 };
 
 } // namespace USD
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "Tasks/HnTask.hpp"
+#include "Tasks/HnTaskProfiler.hpp"
 
 #include "../../../../DiligentCore/Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -136,6 +137,7 @@ public:
     /// \return The list of tasks that can be passed to pxr::HdEngine::Execute.
     ///
     /// \remarks Only enabled tasks are returned.
+    ///          If profiling is enabled, the tasks are wrapped into proxies that measure their timings.
     const pxr::HdTaskSharedPtrVector GetTasks(const std::vector<TaskUID>* TaskOrder = nullptr) const;
 
     /// Sets new collection for the render tasks.
@@ -206,6 +208,16 @@ public:
     /// - if an Rprim is selected, returns the Sdf Path of the selected Rprim.
     const pxr::SdfPath* GetSelectedRPrimId() const;
 
+    /// Collects the Ids of all Rprims in the selection region when the read Rprim id task
+    /// is configured for the rectangle or polygon region (see HnReadRprimIdTaskParams::Region).
+    ///
+    /// \param [out] RPrimIds - Sdf Paths of the Rprims in the region.
+    /// \return     true if the data is available, and false otherwise.
+    ///
+    /// \remarks    The data is read back asynchronously and becomes available a few frames
+    ///             after the region has been set.
+    bool GetSelectedRPrimIds(pxr::SdfPathSet& RPrimIds) const;
+
     /// Enables or disables the tasks associated with the specified material tag.
     void EnableMaterial(const pxr::TfToken& MaterialTag, bool Enable);
 
@@ -230,6 +242,25 @@ public:
     /// Suspends temporal super-sampling.
     void SuspendSuperSampling();
 
+    /// Enables or disables task profiling.
+    ///
+    /// \param [in] Enable             - Whether to enable profiling.
+    /// \param [in] NumFramesToAverage - The number of frames to average the results over.
+    ///
+    /// \remarks    When profiling is enabled, GetTasks() returns proxy tasks that measure the CPU time
+    ///             of every task's Prepare() and Execute() methods as well as the GPU time of Execute().
+    ///             The task list must be requested from GetTasks() again after profiling is toggled.
+    void EnableProfiling(bool Enable, Uint32 NumFramesToAverage = 16);
+
+    /// Returns true if task profiling is enabled.
+    bool IsProfilingEnabled() const;
+
+    /// Returns the per-task breakdown of the frame in the order of execution.
+    ///
+    /// \remarks    The results are averaged over the number of frames specified by EnableProfiling()
+    ///             and are updated once that many frames have been rendered.
+    const std::vector<HnTaskProfile>& GetTaskProfile() const;
+
 private:
     pxr::SdfPath GetTaskId(const pxr::TfToken& TaskName) const;
     pxr::SdfPath GetRenderRprimsTaskId(const pxr::TfToken& MaterialTag, const HnRenderPassParams& RenderPassParams) const;
@@ -245,6 +276,8 @@ private:
     void CreateProcessSelectionTask();
     void CreatePostProcessTask();
 
+    HnTaskProfiler& GetTaskProfiler() const;
+
 private:
     pxr::HdRenderIndex& m_RenderIndex;
     const pxr::SdfPath  m_ManagerId;
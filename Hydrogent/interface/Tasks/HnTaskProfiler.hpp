@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+
+#include "pxr/usd/sdf/path.h"
+
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "../../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
+#include "../../../../DiligentCore/Common/interface/Timer.hpp"
+
+namespace Diligent
+{
+
+class DurationQueryHelper;
+
+namespace USD
+{
+
+/// Render pass statistics.
+struct HnRenderPassStats
+{
+    /// The number of draw commands, including multi-draw commands.
+    Uint32 NumDrawCalls = 0;
+
+    /// The number of pipeline state changes.
+    Uint32 NumPSOChanges = 0;
+
+    /// The number of shader resource binding commits.
+    Uint32 NumSRBCommits = 0;
+
+    /// The number of bytes written to the primitive attributes and joint transforms buffers.
+    Uint64 NumBytesMapped = 0;
+
+    HnRenderPassStats& operator+=(const HnRenderPassStats& Stats)
+    {
+        NumDrawCalls += Stats.NumDrawCalls;
+        NumPSOChanges += Stats.NumPSOChanges;
+        NumSRBCommits += Stats.NumSRBCommits;
+        NumBytesMapped += Stats.NumBytesMapped;
+        return *this;
+    }
+};
+
+/// Task performance profile.
+struct HnTaskProfile
+{
+    /// Task Id.
+    pxr::SdfPath TaskId;
+
+    /// Average CPU time of the task's Prepare() method, in milliseconds.
+    double PrepareCPUTime = 0;
+
+    /// Average CPU time of the task's Execute() method, in milliseconds.
+    double ExecuteCPUTime = 0;
+
+    /// Average GPU time of the commands recorded by the task's Execute() method, in milliseconds.
+    ///
+    /// \remarks    The time is zero if the device does not support timestamp queries.
+    double ExecuteGPUTime = 0;
+
+    /// Average per-frame statistics of all render passes executed by the task.
+    HnRenderPassStats RenderPassStats;
+};
+
+/// Task profiler.
+///
+/// The profiler measures the CPU time of the Prepare() and Execute() methods of every task
+/// as well as the GPU time of the commands recorded by Execute() using timestamp queries.
+/// Query results are read back with a delay of several frames, so the profiler never stalls the GPU.
+/// The results are averaged over a number of frames.
+class HnTaskProfiler
+{
+public:
+    explicit HnTaskProfiler(IRenderDevice* pDevice);
+    ~HnTaskProfiler();
+
+    // clang-format off
+    HnTaskProfiler           (const HnTaskProfiler&)  = delete;
+    HnTaskProfiler           (      HnTaskProfiler&&) = delete;
+    HnTaskProfiler& operator=(const HnTaskProfiler&)  = delete;
+    HnTaskProfiler& operator=(      HnTaskProfiler&&) = delete;
+    // clang-format on
+
+    void SetEnabled(bool Enabled);
+    bool IsEnabled() const { return m_Enabled; }
+
+    /// Sets the number of frames to average the results over.
+    void   SetNumFramesToAverage(Uint32 NumFrames) { m_NumFramesToAverage = std::max(NumFrames, 1u); }
+    Uint32 GetNumFramesToAverage() const { return m_NumFramesToAverage; }
+
+    /// Starts a new frame. Must be called before the Prepare() method of the first task.
+    void BeginFrame();
+
+    void BeginPrepare(const pxr::SdfPath& TaskId);
+    void EndPrepare();
+
+    void BeginExecute(const pxr::SdfPath& TaskId, IDeviceContext* pCtx);
+    void EndExecute(IDeviceContext* pCtx);
+
+    /// Adds render pass statistics to the task that is currently being executed.
+    void AddRenderPassStats(const HnRenderPassStats& Stats);
+
+    /// Returns the profile of every task executed in the last frame, in the order of execution.
+    /// The results are updated every NumFramesToAverage frames.
+    const std::vector<HnTaskProfile>& GetProfile() const { return m_Profile; }
+
+private:
+    struct TaskData
+    {
+        std::unique_ptr<DurationQueryHelper> GPUTimer;
+
+        // Totals accumulated since the last profile update
+        HnTaskProfile Totals;
+        Uint32        NumPrepareSamples = 0;
+        Uint32        NumExecuteSamples = 0;
+        Uint32        NumGPUSamples     = 0;
+
+        TaskData();
+        ~TaskData();
+    };
+    TaskData& GetTaskData(const pxr::SdfPath& TaskId);
+
+    void UpdateProfile();
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const bool m_TimestampQueriesSupported;
+
+    bool   m_Enabled            = false;
+    Uint32 m_NumFramesToAverage = 16;
+    Uint32 m_NumFramesAveraged  = 0;
+
+    Timer m_Timer;
+
+    std::unordered_map<pxr::SdfPath, TaskData, pxr::SdfPath::Hash> m_Tasks;
+
+    // Tasks in the order of execution in the current frame
+    std::vector<pxr::SdfPath> m_FrameTaskOrder;
+
+    TaskData* m_CurrentTask = nullptr;
+    double    m_StartTime   = 0;
+
+    std::vector<HnTaskProfile> m_Profile;
+};
+
+} // namespace USD
+
+} // namespace Diligent
@@ -69,6 +69,7 @@ void HnCamera::Sync(pxr::HdSceneDelegate* SceneDelegate,
     if (OrigDirtyBits & pxr::HdCamera::DirtyParams)
     {
         const float          MetersPerUnit = RenderParam ? static_cast<const HnRenderParam*>(RenderParam)->GetMetersPerUnit() : 0.01f;
+        const bool           ReversedDepth = RenderParam ? static_cast<const HnRenderParam*>(RenderParam)->GetReversedDepth() : false;
         const float          HorzAperture  = GetHorizontalAperture();
         const float          VertAperture  = GetVerticalAperture();
         const float          FocalLength   = GetFocalLength();
@@ -81,7 +82,10 @@ void HnCamera::Sync(pxr::HdSceneDelegate* SceneDelegate,
         const IRenderDevice*    pDevice         = pRenderDelegate->GetDevice();
         const RenderDeviceInfo& DeviceInfo      = pDevice->GetDeviceInfo();
         // USD camera attributes are in scene units, while Diligent expects them in world units
-        m_ProjectionMatrix.SetNearFarClipPlanes(ClippingRange.GetMin() * MetersPerUnit, ClippingRange.GetMax() * MetersPerUnit, DeviceInfo.GetNDCAttribs().MinZ == -1);
+        const float NearZ = ClippingRange.GetMin() * MetersPerUnit;
+        const float FarZ  = ClippingRange.GetMax() * MetersPerUnit;
+        // Swapping the near and far planes produces reversed depth projection
+        m_ProjectionMatrix.SetNearFarClipPlanes(ReversedDepth ? FarZ : NearZ, ReversedDepth ? NearZ : FarZ, DeviceInfo.GetNDCAttribs().MinZ == -1);
     }
 }
 
@@ -0,0 +1,294 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HnComputeSkinning.hpp"
+
+#include <algorithm>
+
+#include "HnRenderDelegate.hpp"
+#include "HnRenderParam.hpp"
+#include "HnMesh.hpp"
+#include "HnShaderSourceFactory.hpp"
+
+#include "DebugUtilities.hpp"
+#include "GraphicsUtilities.h"
+#include "GraphicsTypesX.hpp"
+#include "RenderStateCache.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
+#include "ScopedDebugGroup.hpp"
+
+#include "pxr/base/vt/types.h"
+
+namespace Diligent
+{
+
+namespace HLSL
+{
+
+#include "../shaders/HnComputeSkinningStructures.fxh"
+
+} // namespace HLSL
+
+namespace USD
+{
+
+HnComputeSkinning::HnComputeSkinning(const CreateInfo& CI) :
+    m_ThreadGroupSize{std::max(CI.ThreadGroupSize, 1u)}
+{
+}
+
+HnComputeSkinning::~HnComputeSkinning()
+{
+}
+
+bool HnComputeSkinning::PreparePSO(HnRenderDelegate& RenderDelegate)
+{
+    if (m_PSO)
+        return true;
+
+    try
+    {
+        // RenderDeviceWithCache_E throws exceptions in case of errors
+        RenderDeviceWithCache_E Device{RenderDelegate.GetDevice(), RenderDelegate.GetRenderStateCache()};
+
+        ShaderMacroHelper Macros;
+        Macros.Add("COMPUTE_SKINNING_GROUP_SIZE", static_cast<int>(m_ThreadGroupSize));
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.CompileFlags   = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+        ShaderCI.Macros         = Macros;
+
+        auto pHnFxCompoundSourceFactory     = HnShaderSourceFactory::CreateHnFxCompoundFactory();
+        ShaderCI.pShaderSourceStreamFactory = pHnFxCompoundSourceFactory;
+
+        RefCntAutoPtr<IShader> pCS;
+        {
+            ShaderCI.Desc       = {"Compute Skinning CS", SHADER_TYPE_COMPUTE, true};
+            ShaderCI.EntryPoint = "main";
+            ShaderCI.FilePath   = "HnComputeSkinning.csh";
+
+            pCS = Device.CreateShader(ShaderCI); // Throws an exception in case of error
+        }
+
+        PipelineResourceLayoutDescX ResourceLauout;
+        ResourceLauout
+            .SetDefaultVariableType(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            .AddVariable(SHADER_TYPE_COMPUTE, "cbSkinningAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            .AddVariable(SHADER_TYPE_COMPUTE, "g_JointMatrices", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+        ComputePipelineStateCreateInfoX PsoCI{"Compute Skinning"};
+        PsoCI
+            .AddShader(pCS)
+            .SetResourceLayout(ResourceLauout);
+
+        m_PSO = Device.CreateComputePipelineState(PsoCI); // Throws an exception in case of error
+    }
+    catch (const std::runtime_error& err)
+    {
+        LOG_ERROR_MESSAGE("Failed to create compute skinning PSO: ", err.what());
+        return false;
+    }
+
+    CreateUniformBuffer(RenderDelegate.GetDevice(), sizeof(HLSL::ComputeSkinningAttribs), "Compute skinning attribs CB", &m_AttribsCB);
+    VERIFY_EXPR(m_AttribsCB);
+    ShaderResourceVariableX{m_PSO, SHADER_TYPE_COMPUTE, "cbSkinningAttribs"}.Set(m_AttribsCB);
+
+    return true;
+}
+
+void HnComputeSkinning::PrepareJointMatricesBuffer(IRenderDevice* pDevice, IDeviceContext* pCtx)
+{
+    const Uint64 DataSize = sizeof(float4) * m_JointMatrices.size();
+    const Uint64 CurrSize = m_JointMatricesBuffer ? m_JointMatricesBuffer->GetDesc().Size : 0;
+    if (CurrSize < DataSize)
+    {
+        m_JointMatricesBuffer.Release();
+
+        BufferDesc Desc;
+        Desc.Name              = "Compute skinning joint matrices";
+        Desc.Size              = std::max({DataSize, CurrSize * 2, Uint64{sizeof(float4x4) * 256}});
+        Desc.BindFlags         = BIND_SHADER_RESOURCE;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_STRUCTURED;
+        Desc.ElementByteStride = sizeof(float4);
+        pDevice->CreateBuffer(Desc, nullptr, &m_JointMatricesBuffer);
+        if (!m_JointMatricesBuffer)
+        {
+            UNEXPECTED("Failed to create joint matrices buffer");
+            return;
+        }
+    }
+
+    pCtx->UpdateBuffer(m_JointMatricesBuffer, 0, DataSize, m_JointMatrices.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void HnComputeSkinning::Execute(HnRenderDelegate& RenderDelegate)
+{
+    entt::registry& Registry = RenderDelegate.GetEcsRegistry();
+
+    m_JointMatrices.clear();
+    m_PendingDispatches.clear();
+
+    auto WriteJointMatrices = [this](const pxr::VtMatrix4fArray& Xforms, const float4x4& GeomBindXform) {
+        const Uint32 Offset = static_cast<Uint32>(m_JointMatrices.size());
+        for (const pxr::GfMatrix4f& Xform : Xforms)
+        {
+            // Apply the skin pre-transform on the CPU
+            const float4x4 JointMatrix = GeomBindXform * reinterpret_cast<const float4x4&>(Xform);
+            for (Uint32 row = 0; row < 4; ++row)
+                m_JointMatrices.emplace_back(JointMatrix.m[row][0], JointMatrix.m[row][1], JointMatrix.m[row][2], JointMatrix.m[row][3]);
+        }
+        return Offset;
+    };
+
+    auto MeshView = Registry.view<const HnMesh::Components::Skinning, HnMesh::Components::ComputeSkinning, const HnMesh::Components::Visibility>();
+    MeshView.each([&](entt::entity Entity, const HnMesh::Components::Skinning& Skinning, HnMesh::Components::ComputeSkinning& ComputeSkinning, const HnMesh::Components::Visibility& Visibility) {
+        if (!Skinning || Skinning.Xforms->empty() || !Visibility.Val || ComputeSkinning.NumVertices == 0)
+            return;
+
+        const pxr::VtMatrix4fArray* PrevXforms = nullptr;
+        if (ComputeSkinning.XformsHash != Skinning.XformsHash)
+        {
+            PrevXforms = ComputeSkinning.PrevXforms != nullptr && ComputeSkinning.PrevXforms->size() == Skinning.Xforms->size() ?
+                ComputeSkinning.PrevXforms :
+                Skinning.Xforms;
+        }
+        else if (!ComputeSkinning.PrevMatchesCurr)
+        {
+            // Joint transforms have not changed since the last frame, but previous-frame
+            // positions still contain the positions from two frames ago.
+            PrevXforms = Skinning.Xforms;
+        }
+        else
+        {
+            // Nothing to update
+            return;
+        }
+
+        PendingDispatch Dispatch;
+        Dispatch.Entity           = Entity;
+        Dispatch.JointCount       = static_cast<Uint32>(Skinning.Xforms->size());
+        Dispatch.JointsOffset     = WriteJointMatrices(*Skinning.Xforms, Skinning.GeomBindXform);
+        Dispatch.PrevJointsOffset = PrevXforms != Skinning.Xforms ?
+            WriteJointMatrices(*PrevXforms, Skinning.GeomBindXform) :
+            Dispatch.JointsOffset;
+        m_PendingDispatches.push_back(Dispatch);
+
+        ComputeSkinning.XformsHash      = Skinning.XformsHash;
+        ComputeSkinning.PrevXforms      = Skinning.Xforms;
+        ComputeSkinning.PrevMatchesCurr = PrevXforms == Skinning.Xforms;
+    });
+
+    if (m_PendingDispatches.empty())
+        return;
+
+    IDeviceContext* pCtx = RenderDelegate.GetDeviceContext();
+    if (!PreparePSO(RenderDelegate))
+        return;
+
+    PrepareJointMatricesBuffer(RenderDelegate.GetDevice(), pCtx);
+    if (!m_JointMatricesBuffer)
+        return;
+
+    IBufferView* pJointMatricesSRV = m_JointMatricesBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+
+    // Vertex pool buffers are shared by multiple meshes, so transition every buffer only once
+    auto AddBarrier = [this](IBuffer* pBuffer, RESOURCE_STATE NewState) {
+        auto it = std::find_if(m_Barriers.begin(), m_Barriers.end(), [pBuffer](const StateTransitionDesc& Barrier) { return Barrier.pResource == pBuffer; });
+        if (it == m_Barriers.end())
+            m_Barriers.emplace_back(pBuffer, RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    };
+
+    m_Barriers.clear();
+    AddBarrier(m_JointMatricesBuffer, RESOURCE_STATE_SHADER_RESOURCE);
+    for (const PendingDispatch& Dispatch : m_PendingDispatches)
+    {
+        const HnMesh::Components::ComputeSkinning& ComputeSkinning = Registry.get<const HnMesh::Components::ComputeSkinning>(Dispatch.Entity);
+        AddBarrier(ComputeSkinning.Points, RESOURCE_STATE_SHADER_RESOURCE);
+        AddBarrier(ComputeSkinning.Normals, RESOURCE_STATE_SHADER_RESOURCE);
+        AddBarrier(ComputeSkinning.Joints, RESOURCE_STATE_SHADER_RESOURCE);
+        AddBarrier(ComputeSkinning.SkinnedPoints, RESOURCE_STATE_UNORDERED_ACCESS);
+        AddBarrier(ComputeSkinning.SkinnedNormals, RESOURCE_STATE_UNORDERED_ACCESS);
+        AddBarrier(ComputeSkinning.PrevSkinnedPoints, RESOURCE_STATE_UNORDERED_ACCESS);
+    }
+    pCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    ScopedDebugGroup DebugGroup{pCtx, "Compute Skinning"};
+
+    pCtx->SetPipelineState(m_PSO);
+    for (const PendingDispatch& Dispatch : m_PendingDispatches)
+    {
+        HnMesh::Components::ComputeSkinning& ComputeSkinning = Registry.get<HnMesh::Components::ComputeSkinning>(Dispatch.Entity);
+        if (!ComputeSkinning.SRB)
+        {
+            m_PSO->CreateShaderResourceBinding(&ComputeSkinning.SRB, true);
+            if (!ComputeSkinning.SRB)
+            {
+                UNEXPECTED("Failed to create compute skinning SRB");
+                continue;
+            }
+
+            auto SetBufferView = [&ComputeSkinning](const char* Name, IBuffer* pBuffer, BUFFER_VIEW_TYPE ViewType) {
+                ShaderResourceVariableX{ComputeSkinning.SRB, SHADER_TYPE_COMPUTE, Name}.Set(pBuffer->GetDefaultView(ViewType));
+            };
+            SetBufferView("g_Points", ComputeSkinning.Points, BUFFER_VIEW_SHADER_RESOURCE);
+            SetBufferView("g_Normals", ComputeSkinning.Normals, BUFFER_VIEW_SHADER_RESOURCE);
+            SetBufferView("g_Joints", ComputeSkinning.Joints, BUFFER_VIEW_SHADER_RESOURCE);
+            SetBufferView("g_SkinnedPoints", ComputeSkinning.SkinnedPoints, BUFFER_VIEW_UNORDERED_ACCESS);
+            SetBufferView("g_SkinnedNormals", ComputeSkinning.SkinnedNormals, BUFFER_VIEW_UNORDERED_ACCESS);
+            SetBufferView("g_PrevSkinnedPoints", ComputeSkinning.PrevSkinnedPoints, BUFFER_VIEW_UNORDERED_ACCESS);
+        }
+        ShaderResourceVariableX{ComputeSkinning.SRB, SHADER_TYPE_COMPUTE, "g_JointMatrices"}.Set(pJointMatricesSRV);
+
+        {
+            MapHelper<HLSL::ComputeSkinningAttribs> Attribs{pCtx, m_AttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+            Attribs->StartVertex      = ComputeSkinning.StartVertex;
+            Attribs->NumVertices      = ComputeSkinning.NumVertices;
+            Attribs->JointsOffset     = Dispatch.JointsOffset;
+            Attribs->PrevJointsOffset = Dispatch.PrevJointsOffset;
+            Attribs->JointCount       = Dispatch.JointCount;
+        }
+
+        pCtx->CommitShaderResources(ComputeSkinning.SRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pCtx->DispatchCompute({(ComputeSkinning.NumVertices + m_ThreadGroupSize - 1) / m_ThreadGroupSize, 1, 1});
+    }
+
+    // Skinned geometry is consumed by all render passes as vertex buffers
+    for (StateTransitionDesc& Barrier : m_Barriers)
+    {
+        if (Barrier.NewState == RESOURCE_STATE_UNORDERED_ACCESS)
+            Barrier.NewState = RESOURCE_STATE_VERTEX_BUFFER;
+    }
+    m_Barriers.erase(std::remove_if(m_Barriers.begin(), m_Barriers.end(), [](const StateTransitionDesc& Barrier) { return Barrier.NewState != RESOURCE_STATE_VERTEX_BUFFER; }), m_Barriers.end());
+    pCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+}
+
+} // namespace USD
+
+} // namespace Diligent
@@ -38,6 +38,7 @@
 
 #include "GfTypeConversions.hpp"
 #include "BasicMath.hpp"
+#include "Utilities/interface/TextureCacheUtils.hpp"
 
 namespace Diligent
 {
@@ -57,6 +58,7 @@ namespace USD
 TF_DEFINE_PRIVATE_TOKENS(
     HnLightPrivateTokens,
     ((shadowResolution, "inputs:shadow:resolution"))
+    ((shadowNumCascades, "inputs:shadow:numCascades"))
 );
 // clang-format on
 
@@ -68,7 +70,8 @@ HnLight* HnLight::Create(const pxr::SdfPath& Id, const pxr::TfToken& TypeId)
 HnLight::HnLight(const pxr::SdfPath& Id, const pxr::TfToken& TypeId) :
     pxr::HdLight{Id},
     m_TypeId{TypeId},
-    m_SceneBounds{BoundBox::Invalid()}
+    m_SceneBounds{BoundBox::Invalid()},
+    m_LightSpaceSceneBounds{BoundBox::Invalid()}
 {
 }
 
@@ -368,60 +371,35 @@ static pxr::SdfAssetPath GetTextureFile(pxr::HdSceneDelegate& SceneDelegate, con
     return FilePath;
 }
 
-void HnLight::ComputeDirectLightProjMatrix(pxr::HdSceneDelegate& SceneDelegate)
+void HnLight::ComputeDirectLightProjMatrix(const HnRenderDelegate& RenderDelegate)
 {
-    pxr::HdRenderIndex& RenderIndex = SceneDelegate.GetRenderIndex();
-
-    BoundBox LightSpaceBounds{BoundBox::Invalid()};
+    // Scene bounds are computed once per frame by the render delegate
+    // rather than by every light from the bounds of all rprims.
+    m_SceneBounds        = RenderDelegate.GetSceneBounds();
+    m_SceneBoundsVersion = RenderDelegate.GetSceneBoundsVersion();
     if (!m_SceneBounds.IsValid())
     {
-        // First time compute accurate scene bounds in light space by projecting
-        // each primitive's bounding box into light space.
-        // Also, compute the scnene bounds in world space.
-
-        const pxr::SdfPathVector& RPrimIds = RenderIndex.GetRprimIds();
-        for (const pxr::SdfPath& RPrimId : RPrimIds)
-        {
-            if (RPrimId.IsEmpty())
-                continue;
-
-            const pxr::GfRange3d PrimExtent = SceneDelegate.GetExtent(RPrimId);
-            if (PrimExtent.IsEmpty())
-                continue;
-
-            const BoundBox PrimBB        = ToBoundBox(PrimExtent);
-            const float4x4 PrimTransform = ToMatrix4x4<float>(SceneDelegate.GetTransform(RPrimId));
-            for (Uint32 i = 0; i < 8; ++i)
-            {
-                float4 Corner = {PrimBB.GetCorner(i), 1.0};
-
-                Corner        = Corner * PrimTransform;
-                m_SceneBounds = m_SceneBounds.Enclose(Corner);
-
-                Corner           = Corner * m_ViewMatrix;
-                LightSpaceBounds = LightSpaceBounds.Enclose(Corner);
-            }
-        }
+        m_LightSpaceSceneBounds = BoundBox::Invalid();
+        return;
     }
-    else
+
+    BoundBox LightSpaceBounds{BoundBox::Invalid()};
+    for (Uint32 i = 0; i < 8; ++i)
     {
-        // Use precomputed scene bounds in world space. This is less accurate, but
-        // much faster.
-        for (Uint32 i = 0; i < 8; ++i)
-        {
-            float4 Corner    = {m_SceneBounds.GetCorner(i), 1.0};
-            Corner           = Corner * m_ViewMatrix;
-            LightSpaceBounds = LightSpaceBounds.Enclose(Corner);
-        }
+        float4 Corner    = {m_SceneBounds.GetCorner(i), 1.0};
+        Corner           = Corner * m_ViewMatrix;
+        LightSpaceBounds = LightSpaceBounds.Enclose(Corner);
     }
 
-    IRenderDevice*          pDevice    = static_cast<const HnRenderDelegate*>(RenderIndex.GetRenderDelegate())->GetDevice();
-    const RenderDeviceInfo& DeviceInfo = pDevice->GetDeviceInfo();
+    const RenderDeviceInfo& DeviceInfo = RenderDelegate.GetDevice()->GetDeviceInfo();
+
+    m_LightSpaceSceneBounds = LightSpaceBounds;
 
     m_ProjMatrix = float4x4::OrthoOffCenter(LightSpaceBounds.Min.x, LightSpaceBounds.Max.x,
                                             LightSpaceBounds.Min.y, LightSpaceBounds.Max.y,
                                             LightSpaceBounds.Min.z, LightSpaceBounds.Max.z,
                                             DeviceInfo.NDC.MinZ == -1);
+    m_ViewProjMatrix = m_ViewMatrix * m_ProjMatrix;
 }
 
 void HnLight::Sync(pxr::HdSceneDelegate* SceneDelegate,
@@ -439,9 +417,9 @@ void HnLight::Sync(pxr::HdSceneDelegate* SceneDelegate,
         bool IsVisible = SceneDelegate->GetVisible(Id);
         if (IsVisible != m_IsVisible)
         {
-            m_IsVisible        = IsVisible;
-            LightDirty         = true;
-            m_IsShadowMapDirty = true;
+            m_IsVisible = IsVisible;
+            LightDirty  = true;
+            SetShadowMapDirty(true);
         }
     }
 
@@ -559,12 +537,19 @@ void HnLight::Sync(pxr::HdSceneDelegate* SceneDelegate,
                 m_ShadowMapResolution = std::min(ShadowMapDesc.Width, ShadowMapDesc.Height);
             }
 
-            if (m_ShadowMapSuballocation &&
-                m_ShadowMapSuballocation->GetSize() != uint2{m_ShadowMapResolution, m_ShadowMapResolution})
+            const pxr::VtValue NumCascadesVal = SceneDelegate->GetLightParamValue(Id, HnLightPrivateTokens->shadowNumCascades);
+            if (NumCascadesVal.IsHolding<int>())
             {
-                m_ShadowMapSuballocation.Release();
-                m_ShadowMapShaderInfo.reset();
-                LightDirty = true;
+                m_NumShadowCascades = static_cast<Uint32>(clamp(NumCascadesVal.Get<int>(), 1, static_cast<int>(MaxShadowCascades)));
+            }
+
+            if (!m_ShadowCascades.empty() &&
+                (m_ShadowCascades.size() != m_NumShadowCascades ||
+                 m_ShadowCascades[0].Suballocation->GetSize() != uint2{m_ShadowMapResolution, m_ShadowMapResolution}))
+            {
+                // Shadow cascades will be reallocated by CommitGPUResources()
+                m_ShadowCascadesDirty = true;
+                ShadowTransformDirty  = true;
             }
         }
 
@@ -573,65 +558,286 @@ void HnLight::Sync(pxr::HdSceneDelegate* SceneDelegate,
 
     if (ShadowMapMgr != nullptr)
     {
-        const bool ShadowsEnabled =
+        const bool CastShadows =
             SceneDelegate->GetLightParamValue(Id, pxr::HdLightTokens->shadowEnable).GetWithDefault<bool>(false) &&
             m_Params.Type == GLTF::Light::TYPE::DIRECTIONAL;
-        if (!ShadowsEnabled && m_ShadowMapSuballocation)
+        if (CastShadows != m_CastShadows)
         {
-            m_ShadowMapSuballocation.Release();
-            m_ShadowMapShaderInfo.reset();
-            LightDirty = true;
+            // Shadow map atlas is shared by all lights, so cascades are not allocated
+            // or released here to keep Sync thread-safe.
+            m_CastShadows         = CastShadows;
+            m_ShadowCascadesDirty = true;
+            ShadowTransformDirty  = true;
+        }
+
+        if (m_CastShadows && ShadowTransformDirty)
+        {
+            VERIFY(m_TypeId == pxr::HdPrimTypeTokens->distantLight, "Only distant light is supported for shadow map");
+            // The projection is fit to the scene bounds by CommitGPUResources()
+            m_ShadowTransformDirty = true;
         }
+    }
+
+    if (RenderParam != nullptr)
+    {
+        if (LightDirty)
+            static_cast<HnRenderParam*>(RenderParam)->MakeAttribDirty(HnRenderParam::GlobalAttrib::Light);
+
+        if (m_IsTextureDirty || m_ShadowCascadesDirty || m_ShadowTransformDirty)
+            static_cast<HnRenderParam*>(RenderParam)->MakeAttribDirty(HnRenderParam::GlobalAttrib::LightResources);
+    }
+
+    *DirtyBits = HdLight::Clean;
+}
+
+void HnLight::CommitGPUResources(HnRenderDelegate& RenderDelegate)
+{
+    if (m_CastShadows && m_SceneBoundsVersion != RenderDelegate.GetSceneBoundsVersion())
+        m_ShadowTransformDirty = true;
+
+    if (!m_ShadowCascadesDirty && !m_ShadowTransformDirty)
+        return;
 
-        if (ShadowsEnabled && !m_ShadowMapSuballocation)
+    HnShadowMapManager* ShadowMapMgr = RenderDelegate.GetShadowMapManager();
+    if (ShadowMapMgr == nullptr)
+    {
+        m_ShadowCascadesDirty  = false;
+        m_ShadowTransformDirty = false;
+        return;
+    }
+
+    if (m_ShadowCascadesDirty)
+    {
+        ReleaseShadowCascades();
+        if (m_CastShadows)
         {
-            m_ShadowMapSuballocation = ShadowMapMgr->Allocate(m_ShadowMapResolution, m_ShadowMapResolution);
-            if (!m_ShadowMapSuballocation)
+            if (!AllocateShadowCascades(*ShadowMapMgr))
             {
-                LOG_ERROR_MESSAGE("Failed to allocate shadow map for light ", Id);
+                LOG_ERROR_MESSAGE("Failed to allocate shadow map for light ", GetId());
             }
-            m_ShadowMapShaderInfo = std::make_unique<HLSL::PBRShadowMapInfo>();
+        }
+        m_ShadowCascadesDirty = false;
+    }
 
-            const float4& UVScaleBias      = m_ShadowMapSuballocation->GetUVScaleBias();
-            m_ShadowMapShaderInfo->UVScale = {UVScaleBias.x, UVScaleBias.y};
-            m_ShadowMapShaderInfo->UVBias  = {UVScaleBias.z, UVScaleBias.w};
+    if (m_CastShadows && m_ShadowTransformDirty)
+    {
+        ComputeDirectLightProjMatrix(RenderDelegate);
+    }
 
-            m_ShadowMapShaderInfo->ShadowMapSlice = static_cast<float>(m_ShadowMapSuballocation->GetSlice());
+    if (!m_ShadowCascades.empty())
+    {
+        // Until the cascades are fit to the camera by UpdateShadowCascades(),
+        // every cascade covers the entire scene.
+        for (ShadowCascade& Cascade : m_ShadowCascades)
+        {
+            Cascade.ProjMatrix     = m_ProjMatrix;
+            Cascade.ViewProjMatrix = m_ViewProjMatrix;
+            Cascade.Radius         = 0;
 
-            ShadowTransformDirty = true;
+            Cascade.ShaderInfo->WorldToLightProjSpace = m_ViewProjMatrix;
+        }
+        m_ShadowCascadesInvalid = true;
+        SetShadowMapDirty(true);
+    }
+    m_ShadowTransformDirty = false;
 
-            LightDirty = true;
+    static_cast<HnRenderParam*>(RenderDelegate.GetRenderParam())->MakeAttribDirty(HnRenderParam::GlobalAttrib::Light);
+}
+
+void HnLight::ReleaseShadowCascades()
+{
+    m_ShadowCascades.clear();
+}
+
+bool HnLight::AllocateShadowCascades(HnShadowMapManager& ShadowMapMgr)
+{
+    VERIFY_EXPR(m_ShadowCascades.empty());
+    m_ShadowCascades.resize(m_NumShadowCascades);
+    for (ShadowCascade& Cascade : m_ShadowCascades)
+    {
+        Cascade.Suballocation = ShadowMapMgr.Allocate(m_ShadowMapResolution, m_ShadowMapResolution);
+        if (!Cascade.Suballocation)
+        {
+            ReleaseShadowCascades();
+            return false;
+        }
+
+        Cascade.ShaderInfo = std::make_unique<HLSL::PBRShadowMapInfo>();
+
+        const float4& UVScaleBias   = Cascade.Suballocation->GetUVScaleBias();
+        Cascade.ShaderInfo->UVScale = {UVScaleBias.x, UVScaleBias.y};
+        Cascade.ShaderInfo->UVBias  = {UVScaleBias.z, UVScaleBias.w};
+
+        Cascade.ShaderInfo->ShadowMapSlice = static_cast<float>(Cascade.Suballocation->GetSlice());
+    }
+
+    return true;
+}
+
+ITextureAtlasSuballocation* HnLight::GetShadowMapSuballocation(Uint32 Cascade) const
+{
+    return Cascade < m_ShadowCascades.size() ? m_ShadowCascades[Cascade].Suballocation.RawPtr() : nullptr;
+}
+
+const HLSL::PBRShadowMapInfo* HnLight::GetShadowMapShaderInfo(Uint32 Cascade) const
+{
+    return Cascade < m_ShadowCascades.size() ? m_ShadowCascades[Cascade].ShaderInfo.get() : nullptr;
+}
+
+const float4x4& HnLight::GetCascadeProjMatrix(Uint32 Cascade) const
+{
+    VERIFY_EXPR(Cascade < m_ShadowCascades.size());
+    return m_ShadowCascades[Cascade].ProjMatrix;
+}
+
+const float4x4& HnLight::GetCascadeViewProjMatrix(Uint32 Cascade) const
+{
+    VERIFY_EXPR(Cascade < m_ShadowCascades.size());
+    return m_ShadowCascades[Cascade].ViewProjMatrix;
+}
+
+bool HnLight::IsShadowMapDirty() const
+{
+    for (const ShadowCascade& Cascade : m_ShadowCascades)
+    {
+        if (Cascade.IsDirty)
+            return true;
+    }
+    return false;
+}
+
+void HnLight::SetShadowMapDirty(bool IsDirty)
+{
+    for (ShadowCascade& Cascade : m_ShadowCascades)
+        Cascade.IsDirty = IsDirty;
+}
+
+bool HnLight::IsShadowCascadeDirty(Uint32 Cascade) const
+{
+    VERIFY_EXPR(Cascade < m_ShadowCascades.size());
+    return m_ShadowCascades[Cascade].IsDirty;
+}
+
+void HnLight::SetShadowCascadeDirty(Uint32 Cascade, bool IsDirty)
+{
+    VERIFY_EXPR(Cascade < m_ShadowCascades.size());
+    m_ShadowCascades[Cascade].IsDirty = IsDirty;
+}
+
+void HnLight::UpdateShadowCascades(const ShadowCascadeUpdateInfo& UpdateInfo)
+{
+    // A single shadow map always covers the entire scene
+    if (m_ShadowCascades.size() <= 1 || !m_LightSpaceSceneBounds.IsValid())
+        return;
+
+    if (UpdateInfo.pCameraView == nullptr || UpdateInfo.pCameraProj == nullptr)
+    {
+        UNEXPECTED("Camera matrices must not be null");
+        return;
+    }
+
+    const float4x4& CameraView  = *UpdateInfo.pCameraView;
+    const float4x4& CameraProj  = *UpdateInfo.pCameraProj;
+    const float4x4  CameraWorld = CameraView.Inverse();
+
+    float CameraNearZ = 0;
+    float CameraFarZ  = 0;
+    CameraProj.GetNearFarClipPlanes(CameraNearZ, CameraFarZ, UpdateInfo.IsGL);
+    if (CameraNearZ > CameraFarZ)
+    {
+        // Reversed depth projection
+        std::swap(CameraNearZ, CameraFarZ);
+    }
+    if (CameraNearZ <= 0)
+        return;
+
+    {
+        // Do not waste shadow map resolution on the empty space beyond the scene
+        float SceneFarZ = 0;
+        for (Uint32 i = 0; i < 8; ++i)
+        {
+            const float3 Corner = m_SceneBounds.GetCorner(i) * CameraView;
+            SceneFarZ           = std::max(SceneFarZ, Corner.z);
         }
+        CameraFarZ = std::min(CameraFarZ, std::max(SceneFarZ, CameraNearZ * 2.f));
+    }
+
+    const Uint32 NumCascades = static_cast<Uint32>(m_ShadowCascades.size());
+    const float  Resolution  = static_cast<float>(m_ShadowMapResolution);
 
-        if (m_ShadowMapShaderInfo && ShadowTransformDirty)
+    float CascadeNearZ = CameraNearZ;
+    for (Uint32 i = 0; i < NumCascades; ++i)
+    {
+        float CascadeFarZ = CameraFarZ;
+        if (i + 1 < NumCascades)
+        {
+            const float Power    = static_cast<float>(i + 1) / static_cast<float>(NumCascades);
+            const float LogZ     = CameraNearZ * std::pow(CameraFarZ / CameraNearZ, Power);
+            const float UniformZ = CameraNearZ + (CameraFarZ - CameraNearZ) * Power;
+            CascadeFarZ          = UniformZ + (LogZ - UniformZ) * UpdateInfo.PartitioningFactor;
+        }
+
+        // The minimum bounding sphere of the frustum slice does not depend on the camera
+        // orientation, which keeps the cascade extent stable when the camera rotates.
+        float3 SliceCenter;
+        float  SliceRadius = 0;
+        GetFrustumMinimumBoundingSphere(CameraProj._11, CameraProj._22, CascadeNearZ, CascadeFarZ, SliceCenter, SliceRadius);
+        SliceCenter  = SliceCenter * CameraWorld * m_ViewMatrix;
+        CascadeNearZ = CascadeFarZ;
+
+        ShadowCascade& Cascade   = m_ShadowCascades[i];
+        const bool     IsDistant = i > 0;
+
+        // Distant cascades are extended so that they keep covering the frustum slice
+        // while the camera moves between updates.
+        const float Radius = IsDistant ? SliceRadius * (1.f + UpdateInfo.DistantCascadeMaxCameraOffset) : SliceRadius;
+
+        // Snap the cascade center to the shadow map texels to avoid shimmering
+        const float  TexelSize = 2.f * Radius / Resolution;
+        const float3 Center{
+            std::round(SliceCenter.x / TexelSize) * TexelSize,
+            std::round(SliceCenter.y / TexelSize) * TexelSize,
+            SliceCenter.z,
+        };
+
+        bool NeedsUpdate = m_ShadowCascadesInvalid || Cascade.Radius == 0;
+        if (!NeedsUpdate)
         {
-            if (m_TypeId == pxr::HdPrimTypeTokens->distantLight)
+            const bool Changed = Center.x != Cascade.Center.x || Center.y != Cascade.Center.y || Radius != Cascade.Radius;
+            if (IsDistant)
             {
-                ComputeDirectLightProjMatrix(*SceneDelegate);
+                const float Offset    = std::max(std::abs(SliceCenter.x - Cascade.Center.x), std::abs(SliceCenter.y - Cascade.Center.y));
+                const bool  IsCovered = Offset + SliceRadius <= Cascade.Radius;
+
+                const bool IntervalExpired = UpdateInfo.FrameNumber - Cascade.LastUpdateFrame >= UpdateInfo.DistantCascadeUpdateInterval;
+
+                NeedsUpdate = !IsCovered || (IntervalExpired && Changed);
             }
             else
             {
-                UNEXPECTED("Only distant light is supported for shadow map");
+                NeedsUpdate = Changed;
             }
-            m_ViewProjMatrix = m_ViewMatrix * m_ProjMatrix;
+        }
 
-            m_ShadowMapShaderInfo->WorldToLightProjSpace = m_ViewProjMatrix;
+        if (!NeedsUpdate)
+            continue;
 
-            LightDirty         = true;
-            m_IsShadowMapDirty = true;
-        }
-    }
+        Cascade.Center = Center;
+        Cascade.Radius = Radius;
 
-    if (RenderParam != nullptr)
-    {
-        if (LightDirty)
-            static_cast<HnRenderParam*>(RenderParam)->MakeAttribDirty(HnRenderParam::GlobalAttrib::Light);
+        Cascade.ProjMatrix = float4x4::OrthoOffCenter(Center.x - Radius, Center.x + Radius,
+                                                      Center.y - Radius, Center.y + Radius,
+                                                      m_LightSpaceSceneBounds.Min.z, m_LightSpaceSceneBounds.Max.z,
+                                                      UpdateInfo.IsGL);
+        Cascade.ViewProjMatrix = m_ViewMatrix * Cascade.ProjMatrix;
 
-        if (m_IsTextureDirty)
-            static_cast<HnRenderParam*>(RenderParam)->MakeAttribDirty(HnRenderParam::GlobalAttrib::LightResources);
+        Cascade.ShaderInfo->WorldToLightProjSpace = Cascade.ViewProjMatrix;
+
+        Cascade.LastUpdateFrame = UpdateInfo.FrameNumber;
+        Cascade.IsDirty         = true;
     }
 
-    *DirtyBits = HdLight::Clean;
+    m_ShadowCascadesInvalid = false;
 }
 
 void HnLight::PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate)
@@ -644,6 +850,8 @@ void HnLight::PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate)
     IDeviceContext* pCtx    = RenderDelegate.GetDeviceContext();
 
     RefCntAutoPtr<ITexture> pEnvMap;
+    // Content hash of the environment map that is used to look up the precomputed cube maps in the IBL cache
+    size_t EnvMapHash = 0;
     if (!m_TexturePath.empty())
     {
         TextureLoadInfo LoadInfo;
@@ -651,6 +859,8 @@ void HnLight::PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate)
         if (RefCntAutoPtr<ITextureLoader> pLoader = CreateTextureLoaderFromSdfPath(m_TexturePath.c_str(), LoadInfo))
         {
             pLoader->CreateTexture(pDevice, &pEnvMap);
+            if (!RenderDelegate.GetUSDRenderer()->GetIBLCacheDirectory().empty())
+                EnvMapHash = ComputeTextureContentHash(pLoader->GetTextureDesc(), pLoader->GetTextureData());
         }
     }
 
@@ -672,6 +882,7 @@ void HnLight::PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate)
         TextureData         InitData = {&Mip0Data, 1};
 
         pDevice->CreateTexture(EnvMapDesc, &InitData, &pEnvMap);
+        EnvMapHash = ComputeTextureContentHash(EnvMapDesc, InitData);
     }
 
     StateTransitionDesc Barriers[] = {
@@ -679,7 +890,7 @@ void HnLight::PrecomputeIBLCubemaps(HnRenderDelegate& RenderDelegate)
     };
     pCtx->TransitionResourceStates(_countof(Barriers), Barriers);
 
-    RenderDelegate.GetUSDRenderer()->PrecomputeCubemaps(pCtx, pEnvMap->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    RenderDelegate.GetUSDRenderer()->PrecomputeCubemaps(pCtx, pEnvMap->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), 0, 0, true, EnvMapHash);
 
     m_IsTextureDirty = false;
 }
@@ -63,6 +63,13 @@ TF_DEFINE_PRIVATE_TOKENS(
     (influences)
     (geomBindXform)
 );
+
+TF_DEFINE_PRIVATE_TOKENS(
+    HnComputeSkinningPrivateTokens,
+    (preSkinnedPoints)
+    (preSkinnedNormals)
+    (prevPreSkinnedPoints)
+);
 // clang-format on
 
 HnMesh* HnMesh::Create(pxr::TfToken const& typeId,
@@ -196,6 +203,11 @@ void HnMesh::Sync(pxr::HdSceneDelegate* Delegate,
     }
     bool UpdateCullMode = pxr::HdChangeTracker::IsTransformDirty(*DirtyBits, Id) || m_CullMode == CULL_MODE_UNDEFINED;
 
+    const bool   ShadowBoundsDirty   = (*DirtyBits & (pxr::HdChangeTracker::DirtyPoints | pxr::HdChangeTracker::DirtyExtent | pxr::HdChangeTracker::DirtyTransform | pxr::HdChangeTracker::DirtyVisibility)) != 0;
+    const Uint32 PrevGeometryVersion = m_GeometryVersion;
+    const Uint32 PrevMaterialVersion = m_MaterialVersion;
+    const Uint32 PrevShadowVersion   = m_ShadowCasterVersion;
+
     if (Delegate != nullptr && DirtyBits != nullptr)
     {
         UpdateRepr(*Delegate, RenderParam, *DirtyBits, ReprToken);
@@ -238,6 +250,16 @@ void HnMesh::Sync(pxr::HdSceneDelegate* Delegate,
         ++m_MaterialVersion;
     }
 
+    // Geometry, geometry subset, skinning or material changes affect the shadow maps even if the bounds are the same.
+    const bool ForceShadowUpdate =
+        PrevGeometryVersion != m_GeometryVersion ||
+        PrevMaterialVersion != m_MaterialVersion ||
+        PrevShadowVersion != m_ShadowCasterVersion;
+    if (Delegate != nullptr && (ShadowBoundsDirty || ForceShadowUpdate))
+    {
+        UpdateShadowCasterBounds(*Delegate, RenderParam, ForceShadowUpdate);
+    }
+
     *DirtyBits &= ~pxr::HdChangeTracker::AllSceneDirtyBits;
 }
 
@@ -424,6 +446,54 @@ void HnMesh::UpdateRepr(pxr::HdSceneDelegate& SceneDelegate,
     DirtyBits &= ~pxr::HdChangeTracker::NewRepr;
 }
 
+void HnMesh::UpdateShadowCasterBounds(pxr::HdSceneDelegate& SceneDelegate,
+                                      pxr::HdRenderParam*   RenderParam,
+                                      bool                  ForceUpdate)
+{
+    const pxr::SdfPath& Id = GetId();
+
+    BoundBox NewBounds      = BoundBox::Invalid();
+    bool     BoundsAreKnown = true;
+    if (_sharedData.visible)
+    {
+        const pxr::GfRange3d Extent = SceneDelegate.GetExtent(Id);
+        if (!Extent.IsEmpty())
+        {
+            entt::registry& Registry  = static_cast<HnRenderDelegate*>(SceneDelegate.GetRenderIndex().GetRenderDelegate())->GetEcsRegistry();
+            const float4x4& Transform = Registry.get<Components::Transform>(m_Entity).Val;
+
+            NewBounds = ToBoundBox(Extent).Transform(Transform);
+        }
+        else
+        {
+            // The mesh may still be rendered into shadow maps, but we don't know where.
+            BoundsAreKnown = false;
+        }
+    }
+
+    if (!ForceUpdate && BoundsAreKnown &&
+        NewBounds.Min == m_ShadowCasterBounds.Min &&
+        NewBounds.Max == m_ShadowCasterBounds.Max)
+        return;
+
+    if (RenderParam != nullptr)
+    {
+        HnRenderParam* pRenderParam = static_cast<HnRenderParam*>(RenderParam);
+        if (m_ShadowCasterBounds.IsValid())
+        {
+            // Shadows cast at the old location must be removed
+            pRenderParam->AddDirtyShadowCasterBounds(m_ShadowCasterBounds);
+        }
+        if (NewBounds.IsValid() || !BoundsAreKnown)
+        {
+            // Invalid bounds mark all shadow maps dirty
+            pRenderParam->AddDirtyShadowCasterBounds(NewBounds);
+        }
+    }
+
+    m_ShadowCasterBounds = NewBounds;
+}
+
 void HnMesh::UpdateDrawItemsForGeometrySubsets(pxr::HdSceneDelegate& SceneDelegate,
                                                pxr::HdRenderParam*   RenderParam)
 {
@@ -462,6 +532,7 @@ void HnMesh::UpdateTopology(pxr::HdSceneDelegate& SceneDelegate,
         {
             static_cast<HnRenderParam*>(RenderParam)->MakeAttribDirty(HnRenderParam::GlobalAttrib::GeometrySubsetDrawItems);
         }
+        ++m_ShadowCasterVersion;
     }
 
     DirtyBits &= ~pxr::HdChangeTracker::DirtyTopology;
@@ -784,6 +855,12 @@ void HnMesh::UpdateSkinningPrimvars(pxr::HdSceneDelegate&
     {
         SkinningData.Xforms     = &SkinningCompImpl->GetXforms();
         SkinningData.XformsHash = SkinningCompImpl->GetXformsHash();
+        if (SkinningData.XformsHash != m_SkinningXformsHash)
+        {
+            // Joint transforms have changed - skinned geometry must be re-rendered into shadow maps
+            m_SkinningXformsHash = SkinningData.XformsHash;
+            ++m_ShadowCasterVersion;
+        }
 
         const float4x4& SkelLocalToPrimLocal = SkinningCompImpl->GetSkelLocalToPrimLocal();
         if (SkelLocalToPrimLocal != m_SkelLocalToPrimLocal)
@@ -965,19 +1042,32 @@ void HnMesh::AllocatePooledResources(pxr::HdSceneDelegate& SceneDelegate,
     HnRenderDelegate*      RenderDelegate = static_cast<HnRenderDelegate*>(SceneDelegate.GetRenderIndex().GetRenderDelegate());
     GLTF::ResourceManager& ResMgr         = RenderDelegate->GetResourceManager();
 
-    if (m_StagingVertexData && !m_StagingVertexData->Sources.empty() && static_cast<const HnRenderParam*>(RenderParam)->GetUseVertexPool())
+    bool UseVertexPool = m_StagingVertexData && !m_StagingVertexData->Sources.empty() && static_cast<const HnRenderParam*>(RenderParam)->GetUseVertexPool();
+    if (UseVertexPool && m_StagingIndexData)
     {
-        if (m_StagingIndexData)
-        {
-            // The topology has changed: release the existing allocation
-            m_VertexData.PoolAllocation.Release();
-            m_VertexData.NameToPoolIndex.clear();
-        }
+        // The topology has changed: release the existing allocation
+        m_VertexData.PoolAllocation.Release();
+        m_VertexData.NameToPoolIndex.clear();
+    }
+
+    if (UseVertexPool && !m_VertexData.PoolAllocation)
+    {
+        // The skinning compute shader accesses vertex buffers as structured buffers, while the
+        // vertex pool buffers are not structured. Skinned meshes are thus kept out of the pool.
+        // A mesh that already has its own buffers also stays out of the pool until the topology
+        // changes, since its indices are not offset by the pool start vertex.
+        if (CanUseComputeSkinning(*RenderDelegate) || (!m_StagingIndexData && !m_VertexData.Buffers.empty()))
+            UseVertexPool = false;
+    }
 
+    if (UseVertexPool)
+    {
         // Allocate vertex buffers for face data
         const size_t NumVerts = m_StagingVertexData->Sources.begin()->second->GetNumElements();
         if (!m_VertexData.PoolAllocation)
         {
+            m_UseComputeSkinning = false;
+
             GLTF::ResourceManager::VertexLayoutKey VtxKey;
             VtxKey.Elements.reserve(m_StagingVertexData->Sources.size());
             for (const auto& source_it : m_StagingVertexData->Sources)
@@ -1080,6 +1170,12 @@ void HnMesh::UpdateVertexBuffers(HnRenderDelegate& RenderDelegate)
         return;
     }
 
+    if (!m_VertexData.PoolAllocation && m_StagingVertexData->Sources.find(HnTokens->joints) != m_StagingVertexData->Sources.end())
+    {
+        // When vertex pool is used, the flag is reset when the pool allocation is created
+        m_UseComputeSkinning = CanUseComputeSkinning(RenderDelegate);
+    }
+
     for (auto source_it : m_StagingVertexData->Sources)
     {
         const pxr::HdBufferSource* pSource = source_it.second.get();
@@ -1109,6 +1205,13 @@ void HnMesh::UpdateVertexBuffers(HnRenderDelegate& RenderDelegate)
                 BIND_VERTEX_BUFFER,
                 USAGE_IMMUTABLE,
             };
+            if (m_UseComputeSkinning && (PrimName == pxr::HdTokens->points || PrimName == pxr::HdTokens->normals || PrimName == HnTokens->joints))
+            {
+                // The buffer is also read by the skinning compute shader
+                Desc.BindFlags         = BIND_VERTEX_BUFFER | BIND_SHADER_RESOURCE;
+                Desc.Mode              = BUFFER_MODE_STRUCTURED;
+                Desc.ElementByteStride = static_cast<Uint32>(ElementSize);
+            }
 
             BufferData InitData{pSource->GetData(), Desc.Size};
             pBuffer = Device.CreateBuffer(Desc, &InitData);
@@ -1136,6 +1239,41 @@ void HnMesh::UpdateVertexBuffers(HnRenderDelegate& RenderDelegate)
         m_VertexData.Buffers[source_it.first] = pBuffer;
     }
 
+    for (const pxr::TfToken& Name : {HnComputeSkinningPrivateTokens->preSkinnedPoints,
+                                     HnComputeSkinningPrivateTokens->preSkinnedNormals,
+                                     HnComputeSkinningPrivateTokens->prevPreSkinnedPoints})
+    {
+        if (!m_UseComputeSkinning)
+        {
+            m_VertexData.Buffers.erase(Name);
+        }
+        else
+        {
+            // Skinned meshes never use the vertex pool (see AllocatePooledResources)
+            VERIFY_EXPR(!m_VertexData.PoolAllocation);
+
+            IBuffer* pPoints = GetVertexBuffer(pxr::HdTokens->points);
+            VERIFY_EXPR(pPoints != nullptr);
+            const Uint64 BufferSize = pPoints->GetDesc().Size;
+
+            RefCntAutoPtr<IBuffer>& pBuffer = m_VertexData.Buffers[Name];
+            if (!pBuffer || pBuffer->GetDesc().Size != BufferSize)
+            {
+                const auto BufferName = GetId().GetString() + " - " + Name.GetString();
+                BufferDesc Desc{
+                    BufferName.c_str(),
+                    BufferSize,
+                    BIND_VERTEX_BUFFER | BIND_UNORDERED_ACCESS,
+                    USAGE_DEFAULT,
+                };
+                Desc.Mode              = BUFFER_MODE_STRUCTURED;
+                Desc.ElementByteStride = sizeof(float3);
+
+                pBuffer = Device.CreateBuffer(Desc);
+            }
+        }
+    }
+
     m_StagingVertexData.reset();
 }
 
@@ -1219,10 +1357,20 @@ void HnMesh::UpdateDrawItemGpuGeometry(HnRenderDelegate& RenderDelegate)
             HnDrawItem& DrawItem = *static_cast<HnDrawItem*>(Repr.GetDrawItem(item));
 
             HnDrawItem::GeometryData Geo;
-            Geo.Positions    = GetVertexBuffer(pxr::HdTokens->points);
-            Geo.Normals      = GetVertexBuffer(pxr::HdTokens->normals);
+            if (m_UseComputeSkinning)
+            {
+                // All passes render the geometry pre-skinned by HnComputeSkinning
+                Geo.Positions     = GetVertexBuffer(HnComputeSkinningPrivateTokens->preSkinnedPoints);
+                Geo.Normals       = GetVertexBuffer(HnComputeSkinningPrivateTokens->preSkinnedNormals);
+                Geo.PrevPositions = GetVertexBuffer(HnComputeSkinningPrivateTokens->prevPreSkinnedPoints);
+            }
+            else
+            {
+                Geo.Positions = GetVertexBuffer(pxr::HdTokens->points);
+                Geo.Normals   = GetVertexBuffer(pxr::HdTokens->normals);
+                Geo.Joints    = GetVertexBuffer(HnTokens->joints);
+            }
             Geo.VertexColors = GetVertexBuffer(pxr::HdTokens->displayColor);
-            Geo.Joints       = GetVertexBuffer(HnTokens->joints);
 
             // Our shader currently supports two texture coordinate sets.
             // Gather vertex buffers for both sets.
@@ -1246,6 +1394,51 @@ void HnMesh::UpdateDrawItemGpuGeometry(HnRenderDelegate& RenderDelegate)
             DrawItem.SetGeometryData(std::move(Geo));
         }
     }
+
+    UpdateComputeSkinningComponent(RenderDelegate);
+}
+
+bool HnMesh::CanUseComputeSkinning(const HnRenderDelegate& RenderDelegate) const
+{
+    if (RenderDelegate.GetComputeSkinning() == nullptr || !m_StagingVertexData)
+        return false;
+
+    auto HasPrimvar = [this](const pxr::TfToken& Name) {
+        return m_StagingVertexData->Sources.find(Name) != m_StagingVertexData->Sources.end() || GetVertexBuffer(Name) != nullptr;
+    };
+    // The compute shader requires rest points, normals and joint influences
+    return HasPrimvar(pxr::HdTokens->points) && HasPrimvar(pxr::HdTokens->normals) && HasPrimvar(HnTokens->joints);
+}
+
+void HnMesh::UpdateComputeSkinningComponent(HnRenderDelegate& RenderDelegate)
+{
+    entt::registry& Registry = RenderDelegate.GetEcsRegistry();
+    if (!m_UseComputeSkinning)
+    {
+        Registry.remove<Components::ComputeSkinning>(m_Entity);
+        return;
+    }
+
+    Components::ComputeSkinning SkinningData;
+    SkinningData.Points            = GetVertexBuffer(pxr::HdTokens->points);
+    SkinningData.Normals           = GetVertexBuffer(pxr::HdTokens->normals);
+    SkinningData.Joints            = GetVertexBuffer(HnTokens->joints);
+    SkinningData.SkinnedPoints     = GetVertexBuffer(HnComputeSkinningPrivateTokens->preSkinnedPoints);
+    SkinningData.SkinnedNormals    = GetVertexBuffer(HnComputeSkinningPrivateTokens->preSkinnedNormals);
+    SkinningData.PrevSkinnedPoints = GetVertexBuffer(HnComputeSkinningPrivateTokens->prevPreSkinnedPoints);
+    if (!SkinningData.Points || !SkinningData.Normals || !SkinningData.Joints ||
+        !SkinningData.SkinnedPoints || !SkinningData.SkinnedNormals || !SkinningData.PrevSkinnedPoints)
+    {
+        UNEXPECTED("Compute skinning buffers are not initialized");
+        Registry.remove<Components::ComputeSkinning>(m_Entity);
+        return;
+    }
+
+    VERIFY_EXPR(!m_VertexData.PoolAllocation);
+    SkinningData.NumVertices = static_cast<Uint32>(SkinningData.Points->GetDesc().Size / sizeof(float3));
+
+    // Replacing the component resets the skinning state, so that the mesh is re-skinned on the next update
+    Registry.emplace_or_replace<Components::ComputeSkinning>(m_Entity, std::move(SkinningData));
 }
 
 void HnMesh::UpdateDrawItemGpuTopology()
@@ -34,9 +34,12 @@
 #include "HnRenderParam.hpp"
 #include "HnFrameRenderTargets.hpp"
 #include "HnShadowMapManager.hpp"
+#include "HnComputeSkinning.hpp"
+#include "Tasks/HnTaskProfiler.hpp"
 
 #include "DebugUtilities.hpp"
 #include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
 #include "HnRenderBuffer.hpp"
 #include "Align.hpp"
 #include "PlatformMisc.hpp"
@@ -119,6 +122,21 @@ static RefCntAutoPtr<IBuffer> CreateJointsCB(IRenderDevice* pDevice)
     return JointsCB;
 }
 
+static TEXTURE_FORMAT GetMeshIdFormat(const HnRenderDelegate::CreateInfo& CI)
+{
+    switch (CI.MeshIdFormat)
+    {
+        case TEX_FORMAT_R32_FLOAT:
+        case TEX_FORMAT_R32_UINT:
+        case TEX_FORMAT_R16_UINT:
+            return CI.MeshIdFormat;
+
+        default:
+            LOG_ERROR_MESSAGE("Unsupported mesh ID format: ", GetTextureFormatAttribs(CI.MeshIdFormat).Name, ". Using R32_FLOAT");
+            return TEX_FORMAT_R32_FLOAT;
+    }
+}
+
 static std::shared_ptr<USD_Renderer> CreateUSDRenderer(const HnRenderDelegate::CreateInfo& RenderDelegateCI,
                                                        IBuffer*                            pPrimitiveAttribsCB,
                                                        IObject*                            MaterialSRBCache)
@@ -142,8 +160,11 @@ static std::shared_ptr<USD_Renderer> CreateUSDRenderer(const HnRenderDelegate::C
     USDRendererCI.EnableShadows              = RenderDelegateCI.EnableShadows;
     USDRendererCI.PCFKernelSize              = RenderDelegateCI.PCFKernelSize;
     USDRendererCI.MaxShadowCastingLightCount = RenderDelegateCI.MaxShadowCastingLightCount;
+    USDRendererCI.EnableClusteredLighting    = RenderDelegateCI.EnableClusteredLighting;
     USDRendererCI.MaxJointCount              = RenderDelegateCI.MaxJointCount;
+    USDRendererCI.JointsFormat               = RenderDelegateCI.JointsFormat;
     USDRendererCI.UseSkinPreTransform        = true;
+    USDRendererCI.IBLCacheDirectory          = RenderDelegateCI.IBLCacheDirectory;
 
     USDRendererCI.ColorTargetIndex        = HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR;
     USDRendererCI.MeshIdTargetIndex       = HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID;
@@ -154,6 +175,10 @@ static std::shared_ptr<USD_Renderer> CreateUSDRenderer(const HnRenderDelegate::C
     USDRendererCI.IBLTargetIndex          = HnFrameRenderTargets::GBUFFER_TARGET_IBL;
     static_assert(HnFrameRenderTargets::GBUFFER_TARGET_COUNT == 7, "Unexpected number of G-buffer targets");
 
+    USDRendererCI.PackedNormalOutput   = RenderDelegateCI.PackedNormals;
+    USDRendererCI.PackedMaterialOutput = RenderDelegateCI.PackMaterialWithNormals;
+    USDRendererCI.UintMeshIdOutput     = GetTextureFormatAttribs(GetMeshIdFormat(RenderDelegateCI)).ComponentType == COMPONENT_TYPE_UINT;
+
     HN_MATERIAL_TEXTURES_BINDING_MODE TextureBindingMode = RenderDelegateCI.TextureBindingMode;
     Uint32                            TexturesArraySize  = RenderDelegateCI.TexturesArraySize;
     if (TextureBindingMode == HN_MATERIAL_TEXTURES_BINDING_MODE_DYNAMIC &&
@@ -199,13 +224,14 @@ static std::shared_ptr<USD_Renderer> CreateUSDRenderer(const HnRenderDelegate::C
     static constexpr LayoutElement Inputs[] =
         {
             // clang-format off
-            {USD_Renderer::VERTEX_ATTRIB_ID_POSITION,  HnRenderPass::VERTEX_BUFFER_SLOT_POSITIONS,     3, VT_FLOAT32}, // float3 Pos     : ATTRIB0;
-            {USD_Renderer::VERTEX_ATTRIB_ID_NORMAL,    HnRenderPass::VERTEX_BUFFER_SLOT_NORMALS,       3, VT_FLOAT32}, // float3 Normal  : ATTRIB1;
-            {USD_Renderer::VERTEX_ATTRIB_ID_TEXCOORD0, HnRenderPass::VERTEX_BUFFER_SLOT_TEX_COORDS0,   2, VT_FLOAT32}, // float2 UV0     : ATTRIB2;
-            {USD_Renderer::VERTEX_ATTRIB_ID_TEXCOORD1, HnRenderPass::VERTEX_BUFFER_SLOT_TEX_COORDS1,   2, VT_FLOAT32}, // float2 UV1     : ATTRIB3;
-            {USD_Renderer::VERTEX_ATTRIB_ID_COLOR,     HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_COLORS, 3, VT_FLOAT32}, // float3 Color   : ATTRIB6;
-            {USD_Renderer::VERTEX_ATTRIB_ID_JOINTS,    HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_JOINTS, 4, VT_FLOAT32}, // float4 Joint0  : ATTRIB4;
-            {USD_Renderer::VERTEX_ATTRIB_ID_WEIGHTS,   HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_JOINTS, 4, VT_FLOAT32}, // float4 Weight0 : ATTRIB5;
+            {USD_Renderer::VERTEX_ATTRIB_ID_POSITION,      HnRenderPass::VERTEX_BUFFER_SLOT_POSITIONS,      3, VT_FLOAT32}, // float3 Pos     : ATTRIB0;
+            {USD_Renderer::VERTEX_ATTRIB_ID_NORMAL,        HnRenderPass::VERTEX_BUFFER_SLOT_NORMALS,        3, VT_FLOAT32}, // float3 Normal  : ATTRIB1;
+            {USD_Renderer::VERTEX_ATTRIB_ID_TEXCOORD0,     HnRenderPass::VERTEX_BUFFER_SLOT_TEX_COORDS0,    2, VT_FLOAT32}, // float2 UV0     : ATTRIB2;
+            {USD_Renderer::VERTEX_ATTRIB_ID_TEXCOORD1,     HnRenderPass::VERTEX_BUFFER_SLOT_TEX_COORDS1,    2, VT_FLOAT32}, // float2 UV1     : ATTRIB3;
+            {USD_Renderer::VERTEX_ATTRIB_ID_COLOR,         HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_COLORS,  3, VT_FLOAT32}, // float3 Color   : ATTRIB6;
+            {USD_Renderer::VERTEX_ATTRIB_ID_JOINTS,        HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_JOINTS,  4, VT_FLOAT32}, // float4 Joint0  : ATTRIB4;
+            {USD_Renderer::VERTEX_ATTRIB_ID_WEIGHTS,       HnRenderPass::VERTEX_BUFFER_SLOT_VERTEX_JOINTS,  4, VT_FLOAT32}, // float4 Weight0 : ATTRIB5;
+            {USD_Renderer::VERTEX_ATTRIB_ID_PREV_POSITION, HnRenderPass::VERTEX_BUFFER_SLOT_PREV_POSITIONS, 3, VT_FLOAT32}, // float3 PrevPos : ATTRIB8;
             // clang-format on
         };
 
@@ -302,6 +328,21 @@ static std::unique_ptr<HnShadowMapManager> CreateShadowMapManager(const HnRender
     return std::make_unique<HnShadowMapManager>(ShadowMgrCI);
 }
 
+static std::unique_ptr<HnComputeSkinning> CreateComputeSkinning(const HnRenderDelegate::CreateInfo& CI)
+{
+    if (!CI.EnableComputeSkinning || CI.MaxJointCount == 0)
+        return {};
+
+    if (!CI.pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        LOG_WARNING_MESSAGE("Compute skinning is disabled because the device does not support compute shaders");
+        return {};
+    }
+
+    HnComputeSkinning::CreateInfo ComputeSkinningCI;
+    return std::make_unique<HnComputeSkinning>(ComputeSkinningCI);
+}
+
 HnRenderDelegate::HnRenderDelegate(const CreateInfo& CI) :
     m_pDevice{CI.pDevice},
     m_pContext{CI.pContext},
@@ -310,9 +351,12 @@ HnRenderDelegate::HnRenderDelegate(const CreateInfo& CI) :
     m_PrimitiveAttribsCB{CreatePrimitiveAttribsCB(CI.pDevice)},
     m_MaterialSRBCache{HnMaterial::CreateSRBCache()},
     m_USDRenderer{CreateUSDRenderer(CI, m_PrimitiveAttribsCB, m_MaterialSRBCache)},
-    m_TextureRegistry{CI.pDevice, CI.TextureAtlasDim != 0 ? m_ResourceMgr : RefCntAutoPtr<GLTF::ResourceManager>{}},
-    m_RenderParam{std::make_unique<HnRenderParam>(CI.UseVertexPool, CI.UseIndexPool, CI.AsyncShaderCompilation, CI.TextureBindingMode, CI.MetersPerUnit)},
-    m_ShadowMapManager{CreateShadowMapManager(CI)}
+    m_TextureRegistry{CI.pDevice, CI.TextureAtlasDim != 0 ? m_ResourceMgr : RefCntAutoPtr<GLTF::ResourceManager>{}, CI.TextureCompressMode, CI.TextureCacheDirectory},
+    m_RenderParam{std::make_unique<HnRenderParam>(CI.UseVertexPool, CI.UseIndexPool, CI.AsyncShaderCompilation, CI.TextureBindingMode, CI.MetersPerUnit, CI.ReversedDepth,
+                                                  CI.PackedNormals || CI.PackMaterialWithNormals, CI.PackMaterialWithNormals, GetMeshIdFormat(CI))},
+    m_ShadowMapManager{CreateShadowMapManager(CI)},
+    m_ComputeSkinning{CreateComputeSkinning(CI)},
+    m_TaskProfiler{std::make_unique<HnTaskProfiler>(CI.pDevice)}
 {
     const Uint32 ConstantBufferOffsetAlignment = m_pDevice->GetAdapterInfo().Buffer.ConstantBufferOffsetAlignment;
 
@@ -328,6 +372,23 @@ HnRenderDelegate::HnRenderDelegate(const CreateInfo& CI) :
         USAGE_DEFAULT);
 
     m_RenderParam->SetUseShadows(CI.EnableShadows);
+
+    m_MainContextMask         = Uint64{1} << m_pContext->GetDesc().ContextId;
+    m_AsyncComputeContextMask = m_MainContextMask;
+    if (CI.pAsyncComputeContext != nullptr)
+    {
+        const DeviceContextDesc& MainCtxDesc  = m_pContext->GetDesc();
+        const DeviceContextDesc& AsyncCtxDesc = CI.pAsyncComputeContext->GetDesc();
+        if (!AsyncCtxDesc.IsDeferred && AsyncCtxDesc.ContextId != MainCtxDesc.ContextId)
+        {
+            m_pAsyncComputeContext    = CI.pAsyncComputeContext;
+            m_AsyncComputeContextMask = m_MainContextMask | (Uint64{1} << AsyncCtxDesc.ContextId);
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Async compute context must be an immediate context that is different from the main context. Async compute will not be used.");
+        }
+    }
 }
 
 HnRenderDelegate::~HnRenderDelegate()
@@ -384,6 +445,11 @@ pxr::HdRprim* HnRenderDelegate::CreateRprim(const pxr::TfToken& TypeId,
     const Uint32  RPrimUID = m_RPrimNextUID.fetch_add(1);
     if (TypeId == pxr::HdPrimTypeTokens->mesh)
     {
+        if (RPrimUID > 0xFFFFu && m_RenderParam->GetMeshIdFormat() == TEX_FORMAT_R16_UINT)
+        {
+            LOG_WARNING_MESSAGE_ONCE("The number of meshes exceeds the range of the R16_UINT mesh ID format. Picking and selection of mesh '",
+                                     RPrimId.GetText(), "' and the following meshes will be incorrect. Use R32_UINT mesh ID format instead.");
+        }
         HnMesh* Mesh = HnMesh::Create(TypeId, RPrimId, *this, RPrimUID, m_EcsRegistry.create());
         {
             std::lock_guard<std::mutex> Guard{m_RPrimUIDToSdfPathMtx};
@@ -407,6 +473,16 @@ void HnRenderDelegate::DestroyRprim(pxr::HdRprim* rPrim)
 {
     if (HnMesh* pMesh = dynamic_cast<HnMesh*>(rPrim))
     {
+        const BoundBox& ShadowCasterBounds = pMesh->GetShadowCasterBounds();
+        if (ShadowCasterBounds.IsValid())
+        {
+            // Remove shadows cast by the mesh
+            m_RenderParam->AddDirtyShadowCasterBounds(ShadowCasterBounds);
+        }
+
+        // The mesh is no longer rendered
+        m_RenderParam->MakeAttribDirty(HnRenderParam::GlobalAttrib::MeshVisibility);
+
         std::lock_guard<std::mutex> Guard{m_MeshesMtx};
         m_EcsRegistry.destroy(pMesh->GetEntity());
         m_Meshes.erase(pMesh);
@@ -529,12 +605,101 @@ void HnRenderDelegate::DestroyBprim(pxr::HdBprim* BPrim)
     delete BPrim;
 }
 
+void HnRenderDelegate::UpdateSceneBounds()
+{
+    BoundBox SceneBounds = BoundBox::Invalid();
+    {
+        std::lock_guard<std::mutex> Guard{m_MeshesMtx};
+        for (HnMesh* pMesh : m_Meshes)
+        {
+            const BoundBox& MeshBounds = pMesh->GetShadowCasterBounds();
+            if (MeshBounds.IsValid())
+                SceneBounds = SceneBounds.Enclose(MeshBounds.Min).Enclose(MeshBounds.Max);
+        }
+    }
+
+    // Shadow projections are fit to the scene bounds, and every refit invalidates all shadow maps.
+    // To keep shadow maps cached while the scene is animated, the bounds are padded and only
+    // refit when the actual bounds leave the padded volume or become much smaller than it.
+    static constexpr float BoundsPadding  = 0.125f;
+    static constexpr float ShrinkFraction = 0.5f;
+
+    auto GetPadding = [](const BoundBox& Bounds) {
+        const float3 Size    = Bounds.Max - Bounds.Min;
+        const float  MaxSize = std::max(Size.x, std::max(Size.y, Size.z));
+        // Pad flat bounds by a fraction of the largest dimension
+        return std::max(Size, float3{MaxSize, MaxSize, MaxSize} * 0.01f) * BoundsPadding;
+    };
+
+    bool NeedRefit = SceneBounds.IsValid() != m_SceneBounds.IsValid();
+    if (!NeedRefit && SceneBounds.IsValid())
+    {
+        const float3 FitSize  = SceneBounds.Max - SceneBounds.Min + GetPadding(SceneBounds) * 2.f;
+        const float3 CurrSize = m_SceneBounds.Max - m_SceneBounds.Min;
+        for (int i = 0; i < 3 && !NeedRefit; ++i)
+        {
+            // The bounds have left the current volume
+            NeedRefit = SceneBounds.Min[i] < m_SceneBounds.Min[i] || SceneBounds.Max[i] > m_SceneBounds.Max[i];
+            // The current volume is much larger than a refit one, which wastes shadow map resolution
+            NeedRefit = NeedRefit || FitSize[i] < CurrSize[i] * ShrinkFraction;
+        }
+    }
+
+    if (NeedRefit)
+    {
+        if (SceneBounds.IsValid())
+        {
+            const float3 Padding = GetPadding(SceneBounds);
+            SceneBounds.Min -= Padding;
+            SceneBounds.Max += Padding;
+        }
+
+        m_SceneBounds = SceneBounds;
+        ++m_SceneBoundsVersion;
+        // Lights that cast shadows will update their projections in CommitGPUResources()
+        m_RenderParam->MakeAttribDirty(HnRenderParam::GlobalAttrib::LightResources);
+    }
+}
+
 void HnRenderDelegate::CommitResources(pxr::HdChangeTracker* tracker)
 {
     m_ResourceMgr->UpdateVertexBuffers(m_pDevice, m_pContext);
     m_ResourceMgr->UpdateIndexBuffer(m_pDevice, m_pContext);
 
     m_TextureRegistry.Commit(m_pContext);
+
+    // Shadow projections of directional lights are fit to the scene bounds
+    UpdateSceneBounds();
+
+    {
+        const auto LightResourcesVersion = m_RenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::LightResources);
+        if (m_LightResourcesVersion != LightResourcesVersion)
+        {
+            std::lock_guard<std::mutex> Guard{m_LightsMtx};
+
+            HnLight* DomeLight = nullptr;
+            for (HnLight* pLight : m_Lights)
+            {
+                // Shadow map suballocations must be created before the shadow atlas is committed
+                pLight->CommitGPUResources(*this);
+
+                if (pLight->GetTypeId() == pxr::HdPrimTypeTokens->domeLight)
+                {
+                    if (DomeLight == nullptr)
+                    {
+                        pLight->PrecomputeIBLCubemaps(*this);
+                        DomeLight = pLight;
+                    }
+                    else
+                    {
+                        LOG_WARNING_MESSAGE("Only one dome light is supported. ", pLight->GetId(), " will be ignored");
+                    }
+                }
+            }
+            m_LightResourcesVersion = LightResourcesVersion;
+        }
+    }
+
     if (m_ShadowMapManager)
     {
         m_ShadowMapManager->Commit(m_pDevice, m_pContext);
@@ -642,32 +807,6 @@ void HnRenderDelegate::CommitResources(pxr::HdChangeTracker* tracker)
         }
     }
 
-    {
-        const auto LightResourcesVersion = m_RenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::LightResources);
-        if (m_LightResourcesVersion != LightResourcesVersion)
-        {
-            std::lock_guard<std::mutex> Guard{m_LightsMtx};
-
-            HnLight* DomeLight = nullptr;
-            for (HnLight* pLight : m_Lights)
-            {
-                if (pLight->GetTypeId() == pxr::HdPrimTypeTokens->domeLight)
-                {
-                    if (DomeLight == nullptr)
-                    {
-                        pLight->PrecomputeIBLCubemaps(*this);
-                        DomeLight = pLight;
-                    }
-                    else
-                    {
-                        LOG_WARNING_MESSAGE("Only one dome light is supported. ", pLight->GetId(), " will be ignored");
-                    }
-                }
-            }
-            m_LightResourcesVersion = LightResourcesVersion;
-        }
-    }
-
     {
         GLTF::ResourceManager::TransitionResourceStatesInfo TRSInfo;
         TRSInfo.VertexBuffers.NewState  = RESOURCE_STATE_VERTEX_BUFFER;
@@ -675,6 +814,11 @@ void HnRenderDelegate::CommitResources(pxr::HdChangeTracker* tracker)
         TRSInfo.TextureAtlases.NewState = RESOURCE_STATE_SHADER_RESOURCE;
         m_ResourceMgr->TransitionResourceStates(m_pDevice, m_pContext, TRSInfo);
     }
+
+    if (m_ComputeSkinning)
+    {
+        m_ComputeSkinning->Execute(*this);
+    }
 }
 
 bool HnRenderDelegate::IsParallelSyncEnabled(pxr::TfToken primType) const
@@ -682,7 +826,8 @@ bool HnRenderDelegate::IsParallelSyncEnabled(pxr::TfToken primType) const
     return (primType == pxr::HdPrimTypeTokens->mesh ||
             primType == pxr::HdPrimTypeTokens->material ||
             primType == pxr::HdPrimTypeTokens->camera ||
-            primType == pxr::HdPrimTypeTokens->extComputation);
+            primType == pxr::HdPrimTypeTokens->extComputation ||
+            pxr::HdPrimTypeIsLight(primType));
 }
 
 const pxr::SdfPath* HnRenderDelegate::GetRPrimId(Uint32 UID) const
@@ -36,12 +36,20 @@ HnRenderParam::HnRenderParam(bool                              UseVertexPool,
                              bool                              UseIndexPool,
                              bool                              AsyncShaderCompilation,
                              HN_MATERIAL_TEXTURES_BINDING_MODE TextureBindingMode,
-                             float                             MetersPerUnit) noexcept :
+                             float                             MetersPerUnit,
+                             bool                              ReversedDepth,
+                             bool                              PackedNormals,
+                             bool                              PackMaterialWithNormals,
+                             TEXTURE_FORMAT                    MeshIdFormat) noexcept :
     m_UseVertexPool{UseVertexPool},
     m_UseIndexPool{UseIndexPool},
     m_AsyncShaderCompilation{AsyncShaderCompilation},
     m_TextureBindingMode{TextureBindingMode},
-    m_MetersPerUnit{MetersPerUnit}
+    m_MetersPerUnit{MetersPerUnit},
+    m_ReversedDepth{ReversedDepth},
+    m_PackedNormals{PackedNormals},
+    m_PackMaterialWithNormals{PackMaterialWithNormals},
+    m_MeshIdFormat{MeshIdFormat}
 {
     for (auto& Version : m_GlobalAttribVersions)
         Version.store(0);
@@ -51,6 +59,49 @@ HnRenderParam::~HnRenderParam()
 {
 }
 
+void HnRenderParam::AddDirtyShadowCasterBounds(const BoundBox& Bounds)
+{
+    // When many prims change at once (e.g. on the first sync), testing each region
+    // against every light is not worth it, so regions are merged into one.
+    static constexpr size_t MaxDirtyRegions = 256;
+
+    std::lock_guard<std::mutex> Lock{m_DirtyShadowCasterBoundsMtx};
+    if (m_AllShadowCastersDirty)
+        return;
+
+    if (!Bounds.IsValid())
+    {
+        m_AllShadowCastersDirty = true;
+        m_DirtyShadowCasterBounds.clear();
+        return;
+    }
+
+    if (m_DirtyShadowCasterBounds.size() < MaxDirtyRegions)
+    {
+        m_DirtyShadowCasterBounds.push_back(Bounds);
+    }
+    else
+    {
+        BoundBox& Union = m_DirtyShadowCasterBounds.front();
+        for (size_t i = 1; i < m_DirtyShadowCasterBounds.size(); ++i)
+            Union = Union.Combine(m_DirtyShadowCasterBounds[i]);
+        Union = Union.Combine(Bounds);
+        m_DirtyShadowCasterBounds.resize(1);
+    }
+}
+
+bool HnRenderParam::ExtractDirtyShadowCasterBounds(std::vector<BoundBox>& DirtyBounds)
+{
+    std::lock_guard<std::mutex> Lock{m_DirtyShadowCasterBoundsMtx};
+
+    DirtyBounds.clear();
+    std::swap(DirtyBounds, m_DirtyShadowCasterBounds);
+
+    const bool AllDirty     = m_AllShadowCastersDirty;
+    m_AllShadowCastersDirty = false;
+    return !AllDirty;
+}
+
 } // namespace USD
 
 } // namespace Diligent
@@ -30,8 +30,11 @@
 #include "HnMesh.hpp"
 #include "HnMaterial.hpp"
 #include "HnDrawItem.hpp"
+#include "HnDrawListSort.hpp"
 #include "HnTypeConversions.hpp"
 #include "HnRenderParam.hpp"
+#include "HnFrameRenderTargets.hpp"
+#include "Tasks/HnTaskProfiler.hpp"
 
 #include <array>
 #include <unordered_map>
@@ -115,6 +118,8 @@ struct HnRenderPass::RenderState
     const Uint32 ConstantBufferOffsetAlignment;
     const bool   NativeMultiDrawSupported;
 
+    HnRenderPassStats Stats;
+
     RenderState(const HnRenderPass&      _RenderPass,
                 const HnRenderPassState& _RPState) :
         RenderPass{_RenderPass},
@@ -138,6 +143,7 @@ struct HnRenderPass::RenderState
 
         pCtx->SetPipelineState(pNewPSO);
         pPSO = pNewPSO;
+        ++Stats.NumPSOChanges;
     }
 
     void CommitShaderResources(IShaderResourceBinding* pNewSRB)
@@ -151,10 +157,12 @@ struct HnRenderPass::RenderState
             pFrameSRB = RPState.GetFrameAttribsSRB();
             VERIFY_EXPR(pFrameSRB != nullptr);
             pCtx->CommitShaderResources(pFrameSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            ++Stats.NumSRBCommits;
         }
 
         pCtx->CommitShaderResources(pNewSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
         pMaterialSRB = pNewSRB;
+        ++Stats.NumSRBCommits;
     }
 
     void SetIndexBuffer(IBuffer* pNewIndexBuffer)
@@ -219,7 +227,7 @@ private:
 GraphicsPipelineDesc HnRenderPass::GetGraphicsDesc(const HnRenderPassState& RPState) const
 {
     GraphicsPipelineDesc GraphicsDesc = RPState.GetGraphicsPipelineDesc();
-    if ((m_Params.UsdPsoFlags & USD_Renderer::USD_PSO_FLAG_ENABLE_ALL_OUTPUTS) == 0)
+    if ((m_UsdPsoFlags & USD_Renderer::USD_PSO_FLAG_ENABLE_ALL_OUTPUTS) == 0)
     {
         for (Uint32 i = 0; i < GraphicsDesc.NumRenderTargets; ++i)
             GraphicsDesc.RTVFormats[i] = TEX_FORMAT_UNKNOWN;
@@ -295,6 +303,37 @@ HnRenderPass::EXECUTE_RESULT HnRenderPass::Execute(HnRenderPassState& RPState, c
         }
     }
 
+    {
+        // Disable the outputs whose targets are skipped in the current G-buffer layout
+        USD_Renderer::USD_PSO_FLAGS UsdPsoFlags = m_Params.UsdPsoFlags;
+        if (RPState.GetNumRenderTargets() == HnFrameRenderTargets::GBUFFER_TARGET_COUNT)
+        {
+            static constexpr std::array<USD_Renderer::USD_PSO_FLAGS, HnFrameRenderTargets::GBUFFER_TARGET_COUNT> TargetOutputFlags = {
+                USD_Renderer::USD_PSO_FLAG_ENABLE_COLOR_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_MESH_ID_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_MOTION_VECTORS_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_NORMAL_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_BASE_COLOR_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT,
+                USD_Renderer::USD_PSO_FLAG_ENABLE_IBL_OUTPUT,
+            };
+            static_assert(HnFrameRenderTargets::GBUFFER_TARGET_COUNT == 7, "Please update the output flags array above");
+            for (Uint32 rt = 0; rt < HnFrameRenderTargets::GBUFFER_TARGET_COUNT; ++rt)
+            {
+                if (RPState.GetRenderTargetFormat(rt) == TEX_FORMAT_UNKNOWN)
+                    UsdPsoFlags &= ~TargetOutputFlags[rt];
+            }
+        }
+
+        if (m_UsdPsoFlags != UsdPsoFlags)
+        {
+            m_UsdPsoFlags = UsdPsoFlags;
+            m_DrawListItemsDirtyFlags |= DRAW_LIST_ITEM_DIRTY_FLAG_PSO;
+            // Reset fallback PSO so that it is updated in UpdateDrawListGPUResources
+            m_FallbackPSO = nullptr;
+        }
+    }
+
     {
         bool UseShadows = State.RenderParam.GetUseShadows();
         if (m_UseShadows != UseShadows)
@@ -435,6 +474,7 @@ HnRenderPass::EXECUTE_RESULT HnRenderPass::Execute(HnRenderPassState& RPState, c
 
         VERIFY_EXPR(AttribsBufferOffset > 0);
         VERIFY_EXPR(AttribsBuffDesc.Usage == USAGE_DYNAMIC || AttribsBufferOffset <= m_PrimitiveAttribsData.size());
+        State.Stats.NumBytesMapped += AttribsBufferOffset + CurrJointsDataSize;
         UnmapOrUpdateBuffer(pPrimitiveAttribsCB, AttribsBuffDesc, pMappedPrimitiveData,
                             m_PrimitiveAttribsData.data(), AttribsBufferOffset);
         AttribsBufferOffset = 0;
@@ -657,6 +697,8 @@ HnRenderPass::EXECUTE_RESULT HnRenderPass::Execute(HnRenderPassState& RPState, c
         FlushPendingDraws();
     }
 
+    State.RenderDelegate.GetTaskProfiler().AddRenderPassStats(State.Stats);
+
     return m_UseFallbackPSO ? EXECUTE_RESULT_FALLBACK : EXECUTE_RESULT_OK;
 }
 
@@ -790,7 +832,7 @@ void HnRenderPass::UpdateDrawListGPUResources(RenderState& State)
             (m_RenderMode == HN_RENDER_MODE_SOLID ?
                  PBR_Renderer::PSO_FLAG_COMPUTE_MOTION_VECTORS :
                  PBR_Renderer::PSO_FLAG_UNSHADED) |
-            static_cast<PBR_Renderer::PSO_FLAGS>(m_Params.UsdPsoFlags);
+            static_cast<PBR_Renderer::PSO_FLAGS>(m_UsdPsoFlags);
 
         const PBR_Renderer::PSOKey FallbackPSOKey{
             FallbackPSOFlags,
@@ -881,35 +923,10 @@ void HnRenderPass::UpdateDrawListGPUResources(RenderState& State)
 
     if (DrawListDirty)
     {
-        m_RenderOrder.resize(m_DrawList.size());
-        for (Uint32 i = 0; i < m_RenderOrder.size(); ++i)
-            m_RenderOrder[i] = i;
-
-        bool DrawOrderDirty = false;
-
-        std::sort(m_RenderOrder.begin(), m_RenderOrder.end(),
-                  [this, &DrawOrderDirty](Uint32 i0, Uint32 i1) {
-                      const DrawListItem& Item0 = m_DrawList[i0];
-                      const DrawListItem& Item1 = m_DrawList[i1];
-
-                      bool Item0PrecedesItem1;
-                      // Sort by PSO first, then by material SRB, then by entity ID
-                      if (Item0.pPSO < Item1.pPSO)
-                          Item0PrecedesItem1 = true;
-                      else if (Item0.pPSO > Item1.pPSO)
-                          Item0PrecedesItem1 = false;
-                      else if (Item0.Material.GetSRB() < Item1.Material.GetSRB())
-                          Item0PrecedesItem1 = true;
-                      else if (Item0.Material.GetSRB() > Item1.Material.GetSRB())
-                          Item0PrecedesItem1 = false;
-                      else
-                          Item0PrecedesItem1 = Item0.MeshEntity < Item1.MeshEntity;
-
-                      if ((i0 < i1) != Item0PrecedesItem1)
-                          DrawOrderDirty = true;
-
-                      return Item0PrecedesItem1;
-                  });
+        const bool DrawOrderDirty = SortDrawList(m_RenderOrder, m_DrawList.size(), [this](Uint32 i) {
+            const DrawListItem& Item = m_DrawList[i];
+            return HnDrawListSortKey{Item.pPSO, Item.Material.GetSRB(), Item.MeshEntity};
+        });
 
         if (DrawOrderDirty)
         {
@@ -997,7 +1014,7 @@ void HnRenderPass::UpdateDrawListItemGPUResources(DrawListItem& ListItem, Render
         VERIFY_EXPR(PsoCache);
 
         auto& PSOFlags = ListItem.PSOFlags;
-        PSOFlags       = static_cast<PBR_Renderer::PSO_FLAGS>(m_Params.UsdPsoFlags);
+        PSOFlags       = static_cast<PBR_Renderer::PSO_FLAGS>(m_UsdPsoFlags);
 
         const HnDrawItem::GeometryData& Geo       = DrawItem.GetGeometryData();
         const HnMaterial*               pMaterial = DrawItem.GetMaterial();
@@ -1051,6 +1068,10 @@ void HnRenderPass::UpdateDrawListItemGPUResources(DrawListItem& ListItem, Render
             if (State.RenderParam.GetTextureBindingMode() == HN_MATERIAL_TEXTURES_BINDING_MODE_ATLAS)
                 PSOFlags |= PBR_Renderer::PSO_FLAG_USE_TEXTURE_ATLAS;
 
+            // Pre-skinned geometry provides exact previous-frame positions for motion vectors
+            if (Geo.PrevPositions != nullptr && (PSOFlags & PBR_Renderer::PSO_FLAG_COMPUTE_MOTION_VECTORS) != 0)
+                PSOFlags |= PBR_Renderer::PSO_FLAG_USE_PREV_POSITIONS;
+
             if (State.USDRenderer.GetSettings().EnableShadows &&
                 (m_Params.UsdPsoFlags & USD_Renderer::USD_PSO_FLAG_ENABLE_COLOR_OUTPUT) != 0 &&
                 State.RenderParam.GetUseShadows())
@@ -1094,10 +1115,11 @@ void HnRenderPass::UpdateDrawListItemGPUResources(DrawListItem& ListItem, Render
         ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_VERTEX_JOINTS] = Geo.Joints;
         if (m_RenderMode == HN_RENDER_MODE_SOLID)
         {
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_NORMALS]       = Geo.Normals;
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS0]   = Geo.TexCoords[0];
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS1]   = Geo.TexCoords[1];
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_VERTEX_COLORS] = Geo.VertexColors;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_NORMALS]        = Geo.Normals;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS0]    = Geo.TexCoords[0];
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS1]    = Geo.TexCoords[1];
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_VERTEX_COLORS]  = Geo.VertexColors;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_PREV_POSITIONS] = Geo.PrevPositions;
 
             // It is OK if some buffers are null
             ListItem.NumVertexBuffers = VERTEX_BUFFER_SLOT_COUNT;
@@ -1106,10 +1128,11 @@ void HnRenderPass::UpdateDrawListItemGPUResources(DrawListItem& ListItem, Render
                  m_RenderMode == HN_RENDER_MODE_POINTS)
         {
             // Only positions and joints are used
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_NORMALS]       = nullptr;
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS0]   = nullptr;
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS1]   = nullptr;
-            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_VERTEX_COLORS] = nullptr;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_NORMALS]        = nullptr;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS0]    = nullptr;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_TEX_COORDS1]    = nullptr;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_VERTEX_COLORS]  = nullptr;
+            ListItem.VertexBuffers[VERTEX_BUFFER_SLOT_PREV_POSITIONS] = nullptr;
 
             ListItem.NumVertexBuffers = (Geo.Joints ? VERTEX_BUFFER_SLOT_VERTEX_JOINTS : VERTEX_BUFFER_SLOT_POSITIONS) + 1;
         }
@@ -1207,6 +1230,7 @@ void HnRenderPass::RenderPendingDrawItems(RenderState& State)
                         pMultiDrawItems[i]            = {BatchItem.NumVertices, BatchItem.StartIndex, 0};
                     }
                     State.pCtx->MultiDrawIndexed({PendingItem.DrawCount, pMultiDrawItems, VT_UINT32, DRAW_FLAG_VERIFY_ALL});
+                    ++State.Stats.NumDrawCalls;
                 }
                 else
                 {
@@ -1222,6 +1246,7 @@ void HnRenderPass::RenderPendingDrawItems(RenderState& State)
                         Attribs.FirstIndexLocation    = BatchItem.StartIndex;
                         Attribs.FirstInstanceLocation = i;
                         State.pCtx->DrawIndexed(Attribs);
+                        ++State.Stats.NumDrawCalls;
                     }
                 }
             }
@@ -1236,6 +1261,7 @@ void HnRenderPass::RenderPendingDrawItems(RenderState& State)
                         pMultiDrawItems[i]            = {BatchItem.NumVertices, 0};
                     }
                     State.pCtx->MultiDraw({PendingItem.DrawCount, pMultiDrawItems, DRAW_FLAG_VERIFY_ALL});
+                    ++State.Stats.NumDrawCalls;
                 }
                 else
                 {
@@ -1250,6 +1276,7 @@ void HnRenderPass::RenderPendingDrawItems(RenderState& State)
                         }
                         Attribs.FirstInstanceLocation = i;
                         State.pCtx->Draw(Attribs);
+                        ++State.Stats.NumDrawCalls;
                     }
                 }
             }
@@ -1260,10 +1287,12 @@ void HnRenderPass::RenderPendingDrawItems(RenderState& State)
             {
                 constexpr Uint32 NumInstances = 1;
                 State.pCtx->DrawIndexed({ListItem.NumVertices, VT_UINT32, DRAW_FLAG_VERIFY_ALL, NumInstances, ListItem.StartIndex});
+                ++State.Stats.NumDrawCalls;
             }
             else
             {
                 State.pCtx->Draw({ListItem.NumVertices, DRAW_FLAG_VERIFY_ALL});
+                ++State.Stats.NumDrawCalls;
             }
         }
 
@@ -69,7 +69,7 @@ void HnRenderPassState::Commit(IDeviceContext* pContext)
     pContext->SetRenderTargets(m_NumRenderTargets, m_RTVs.data(), m_DSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     for (Uint32 rt = 0; rt < m_NumRenderTargets; ++rt)
     {
-        if ((m_ClearMask & (1u << rt)) != 0)
+        if ((m_ClearMask & (1u << rt)) != 0 && m_RTVs[rt] != nullptr)
         {
             pContext->ClearRenderTarget(m_RTVs[rt], m_ClearColors[rt].Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         }
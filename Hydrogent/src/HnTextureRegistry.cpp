@@ -40,10 +40,14 @@ namespace Diligent
 namespace USD
 {
 
-HnTextureRegistry::HnTextureRegistry(IRenderDevice*         pDevice,
-                                     GLTF::ResourceManager* pResourceManager) :
+HnTextureRegistry::HnTextureRegistry(IRenderDevice*             pDevice,
+                                     GLTF::ResourceManager*     pResourceManager,
+                                     TEXTURE_LOAD_COMPRESS_MODE CompressMode,
+                                     const char*                CacheDirectory) :
     m_pDevice{pDevice},
-    m_pResourceManager{pResourceManager}
+    m_pResourceManager{pResourceManager},
+    m_CompressMode{CompressMode},
+    m_CacheDirectory{CacheDirectory != nullptr ? CacheDirectory : ""}
 {
 }
 
@@ -51,6 +55,18 @@ HnTextureRegistry::~HnTextureRegistry()
 {
 }
 
+// Every mip level of a block-compressed atlas region must start at a block boundary and
+// cover whole blocks. Otherwise, updating the smallest mip levels of the region would
+// overwrite the neighboring regions that share the same blocks.
+static Uint32 GetCompressedAtlasRegionAlignment(const TextureDesc& AtlasDesc)
+{
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(AtlasDesc.Format);
+    VERIFY_EXPR(FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED);
+
+    const Uint32 MipLevels = AtlasDesc.MipLevels != 0 ? AtlasDesc.MipLevels : ComputeMipLevelsCount(AtlasDesc.Width, AtlasDesc.Height);
+    return std::max<Uint32>(FmtAttribs.BlockWidth, FmtAttribs.BlockHeight) << (MipLevels - 1);
+}
+
 void HnTextureRegistry::InitializeHandle(IRenderDevice*     pDevice,
                                          IDeviceContext*    pContext,
                                          ITextureLoader*    pLoader,
@@ -70,6 +86,16 @@ void HnTextureRegistry::InitializeHandle(IRenderDevice*     pDevice,
         const Uint32          Slice       = Handle.pAtlasSuballocation->GetSlice();
 
         const Uint32 MipsToUpload = std::min(UploadData.NumSubresources, AtlasDesc.MipLevels);
+#ifdef DILIGENT_DEVELOPMENT
+        if (GetTextureFormatAttribs(AtlasDesc.Format).ComponentType == COMPONENT_TYPE_COMPRESSED)
+        {
+            const Uint32 Alignment = GetCompressedAtlasRegionAlignment(AtlasDesc);
+            DEV_CHECK_ERR((Origin.x % Alignment) == 0 && (Origin.y % Alignment) == 0 &&
+                              (SrcDataDesc.Width % Alignment) == 0 && (SrcDataDesc.Height % Alignment) == 0,
+                          "Atlas regions of block-compressed textures must be aligned to ", Alignment);
+        }
+#endif
+
         for (Uint32 mip = 0; mip < MipsToUpload; ++mip)
         {
             const TextureSubResData& LevelData = UploadData.pSubResources[mip];
@@ -159,17 +185,31 @@ HnTextureRegistry::TextureHandleSharedPtr HnTextureRegistry::Allocate(const pxr:
             {
                 const auto& TexDesc   = pLoader->GetTextureDesc();
                 const auto& AtlasDesc = m_pResourceManager->GetAtlasDesc(TexDesc.Format);
-                if (TexDesc.Width <= AtlasDesc.Width && TexDesc.Height <= AtlasDesc.Height)
+
+                // Block-compressed textures whose dimensions are not multiples of the region alignment
+                // are created as standalone textures.
+                const bool   IsCompressed = GetTextureFormatAttribs(TexDesc.Format).ComponentType == COMPONENT_TYPE_COMPRESSED;
+                const Uint32 Alignment    = IsCompressed ? GetCompressedAtlasRegionAlignment(AtlasDesc) : 1;
+                if (TexDesc.Width > AtlasDesc.Width || TexDesc.Height > AtlasDesc.Height)
+                {
+                    LOG_WARNING_MESSAGE("Texture ", FilePath, " is too large to fit into atlas (", TexDesc.Width, "x", TexDesc.Height, " vs ", AtlasDesc.Width, "x", AtlasDesc.Height, ")");
+                }
+                else if ((TexDesc.Width % Alignment) == 0 && (TexDesc.Height % Alignment) == 0)
                 {
                     TexHandle->pAtlasSuballocation = m_pResourceManager->AllocateTextureSpace(TexDesc.Format, TexDesc.Width, TexDesc.Height);
                     if (!TexHandle->pAtlasSuballocation)
                     {
                         LOG_ERROR_MESSAGE("Failed to allocate atlas region for texture ", FilePath);
                     }
-                }
-                else
-                {
-                    LOG_WARNING_MESSAGE("Texture ", FilePath, " is too large to fit into atlas (", TexDesc.Width, "x", TexDesc.Height, " vs ", AtlasDesc.Width, "x", AtlasDesc.Height, ")");
+                    else if (IsCompressed)
+                    {
+                        const uint2& Origin = TexHandle->pAtlasSuballocation->GetOrigin();
+                        if ((Origin.x % Alignment) != 0 || (Origin.y % Alignment) != 0)
+                        {
+                            // Not all mip levels can be uploaded to this region - use a standalone texture
+                            TexHandle->pAtlasSuballocation.Release();
+                        }
+                    }
                 }
             }
 
@@ -206,7 +246,7 @@ HnTextureRegistry::TextureHandleSharedPtr HnTextureRegistry::Allocate(const HnTe
     }
 
     return Allocate(TexId.FilePath, TexId.SubtextureId.Swizzle, SamplerParams,
-                    [&TexId, Format]() {
+                    [&TexId, Format, CompressMode = m_CompressMode, CacheDirectory = m_CacheDirectory.c_str()]() {
                         TextureLoadInfo LoadInfo;
                         LoadInfo.Name   = TexId.FilePath.GetText();
                         LoadInfo.Format = Format;
@@ -216,8 +256,12 @@ HnTextureRegistry::TextureHandleSharedPtr HnTextureRegistry::Allocate(const HnTe
                         LoadInfo.IsSRGB           = TexId.SubtextureId.IsSRGB;
                         LoadInfo.PermultiplyAlpha = TexId.SubtextureId.PremultiplyAlpha;
                         LoadInfo.Swizzle          = TexId.SubtextureId.Swizzle;
+                        // Block-compressed DDS and KTX payloads are passed through unchanged.
+                        // Uncompressed images are compressed by the loader on the calling thread,
+                        // which is one of the parallel material sync threads.
+                        LoadInfo.CompressMode = CompressMode;
 
-                        return CreateTextureLoaderFromSdfPath(TexId.FilePath.GetText(), LoadInfo);
+                        return CreateTextureLoaderFromSdfPath(TexId.FilePath.GetText(), LoadInfo, CacheDirectory);
                     });
 }
 
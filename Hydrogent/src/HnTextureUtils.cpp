@@ -29,14 +29,82 @@
 #include "pxr/usd/ar/asset.h"
 #include "pxr/usd/ar/resolver.h"
 
+#include "Image.h"
+#include "FileSystem.hpp"
+#include "HashUtils.hpp"
+#include "Utilities/interface/TextureCacheUtils.hpp"
+
 namespace Diligent
 {
 
 namespace USD
 {
 
+namespace
+{
+
+// Bump this value whenever the texture processing in the texture loader changes
+// in a way that makes previously cached textures invalid.
+constexpr Uint32 TextureCacheVersion = 1;
+
+std::string GetSourceTextureCacheFilePath(const char*            CacheDirectory,
+                                          const void*            pData,
+                                          size_t                 DataSize,
+                                          const TextureLoadInfo& LoadInfo)
+{
+    const TextureComponentMapping& Swizzle = LoadInfo.Swizzle;
+
+    // Content hash makes the cache independent of the asset location and modification time
+    const size_t Hash = ComputeHash(ComputeHashRaw(pData, DataSize),
+                                    TextureCacheVersion,
+                                    DataSize,
+                                    LoadInfo.Format,
+                                    LoadInfo.IsSRGB,
+                                    LoadInfo.GenerateMips,
+                                    LoadInfo.MipLevels,
+                                    LoadInfo.FlipVertically,
+                                    LoadInfo.PermultiplyAlpha,
+                                    LoadInfo.AlphaCutoff,
+                                    LoadInfo.MipFilter,
+                                    LoadInfo.CompressMode,
+                                    Swizzle.R, Swizzle.G, Swizzle.B, Swizzle.A);
+
+    return GetTextureCacheFilePath(CacheDirectory, "Texture", Hash);
+}
+
+RefCntAutoPtr<ITextureLoader> LoadCachedTexture(const std::string& CacheFilePath, const TextureLoadInfo& LoadInfo)
+{
+    if (!FileSystem::FileExists(CacheFilePath.c_str()))
+        return {};
+
+    // All processing has already been applied to the cached texture, so
+    // only the parameters that define the texture resource are kept.
+    TextureLoadInfo CacheLoadInfo;
+    CacheLoadInfo.Name           = LoadInfo.Name;
+    CacheLoadInfo.Usage          = LoadInfo.Usage;
+    CacheLoadInfo.BindFlags      = LoadInfo.BindFlags;
+    CacheLoadInfo.CPUAccessFlags = LoadInfo.CPUAccessFlags;
+
+    RefCntAutoPtr<ITextureLoader> pLoader;
+    CreateTextureLoaderFromFile(CacheFilePath.c_str(), IMAGE_FILE_FORMAT_DDS, CacheLoadInfo, &pLoader);
+    if (!pLoader)
+    {
+        LOG_WARNING_MESSAGE("Failed to load cached texture ", CacheFilePath, ". The texture will be reloaded from the source.");
+    }
+    return pLoader;
+}
+
+void StoreCachedTexture(const std::string& CacheFilePath, ITextureLoader* pLoader)
+{
+    const TextureData TexData = pLoader->GetTextureData();
+    WriteTextureCacheFile(CacheFilePath.c_str(), pLoader->GetTextureDesc(), TexData);
+}
+
+} // namespace
+
 RefCntAutoPtr<ITextureLoader> CreateTextureLoaderFromSdfPath(const char*            SdfPath,
-                                                             const TextureLoadInfo& LoadInfo)
+                                                             const TextureLoadInfo& LoadInfo,
+                                                             const char*            CacheDirectory)
 {
     pxr::ArResolvedPath ResolvedPath{SdfPath};
     if (ResolvedPath.empty())
@@ -52,8 +120,28 @@ RefCntAutoPtr<ITextureLoader> CreateTextureLoaderFromSdfPath(const char*
     if (!Buffer)
         return {};
 
+    const size_t DataSize = Asset->GetSize();
+
+    std::string CacheFilePath;
+    if (CacheDirectory != nullptr && *CacheDirectory != '\0')
+    {
+        const IMAGE_FILE_FORMAT FileFormat = Image::GetFileFormat(reinterpret_cast<const Uint8*>(Buffer.get()), DataSize, SdfPath);
+        // DDS and KTX files contain ready-to-use data and do not benefit from caching
+        if (FileFormat != IMAGE_FILE_FORMAT_DDS && FileFormat != IMAGE_FILE_FORMAT_KTX)
+        {
+            CacheFilePath = GetSourceTextureCacheFilePath(CacheDirectory, Buffer.get(), DataSize, LoadInfo);
+            if (RefCntAutoPtr<ITextureLoader> pCachedLoader = LoadCachedTexture(CacheFilePath, LoadInfo))
+                return pCachedLoader;
+        }
+    }
+
     RefCntAutoPtr<ITextureLoader> pLoader;
-    CreateTextureLoaderFromMemory(Buffer.get(), Asset->GetSize(), true, LoadInfo, &pLoader);
+    CreateTextureLoaderFromMemory(Buffer.get(), DataSize, true, LoadInfo, &pLoader);
+
+    if (pLoader && !CacheFilePath.empty())
+    {
+        StoreCachedTexture(CacheFilePath, pLoader);
+    }
 
     return pLoader;
 }
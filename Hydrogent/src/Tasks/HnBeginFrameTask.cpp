@@ -25,6 +25,9 @@
  */
 
 #include "Tasks/HnBeginFrameTask.hpp"
+
+#include <sstream>
+
 #include "HnRenderDelegate.hpp"
 #include "HnRenderPassState.hpp"
 #include "HnFrameRenderTargets.hpp"
@@ -134,6 +137,20 @@ static void UpdateRenderPassState(const HnBeginFrameTaskParams& Params,
     RPState.SetFrontFaceCCW(Params.State.FrontFaceCCW);
 }
 
+static pxr::HdCompareFunction GetReversedDepthFunc(pxr::HdCompareFunction DepthFunc)
+{
+    switch (DepthFunc)
+    {
+        // clang-format off
+        case pxr::HdCmpFuncLess:    return pxr::HdCmpFuncGreater;
+        case pxr::HdCmpFuncLEqual:  return pxr::HdCmpFuncGEqual;
+        case pxr::HdCmpFuncGreater: return pxr::HdCmpFuncLess;
+        case pxr::HdCmpFuncGEqual:  return pxr::HdCmpFuncLEqual;
+        // clang-format on
+        default: return DepthFunc;
+    }
+}
+
 static TEXTURE_FORMAT GetFallbackTextureFormat(TEXTURE_FORMAT Format)
 {
     switch (Format)
@@ -153,6 +170,55 @@ void HnBeginFrameTask::Sync(pxr::HdSceneDelegate* Delegate,
     {
         if (GetTaskParams(Delegate, m_Params))
         {
+            const HnRenderParam* pRenderParam = static_cast<const HnRenderParam*>(Delegate->GetRenderIndex().GetRenderDelegate()->GetRenderParam());
+            if (pRenderParam != nullptr && pRenderParam->GetReversedDepth())
+            {
+                // Depth parameters are specified for the conventional depth
+                m_Params.ClearDepth      = 1.f - m_Params.ClearDepth;
+                m_Params.State.DepthFunc = GetReversedDepthFunc(m_Params.State.DepthFunc);
+                if (m_Params.Formats.Depth != TEX_FORMAT_D32_FLOAT && m_Params.Formats.Depth != TEX_FORMAT_D32_FLOAT_S8X24_UINT)
+                {
+                    LOG_WARNING_MESSAGE_ONCE("Reversed depth requires a floating-point depth buffer to improve precision. Current format: ",
+                                             GetTextureFormatAttribs(m_Params.Formats.Depth).Name);
+                }
+            }
+
+            if (!(m_Params.RenderScale > 0 && m_Params.RenderScale <= 1))
+            {
+                LOG_WARNING_MESSAGE("Render scale must be in (0, 1] range. Current value: ", m_Params.RenderScale, ". Using 1.0");
+                m_Params.RenderScale = 1;
+            }
+
+            if (pRenderParam != nullptr)
+            {
+                std::array<TEXTURE_FORMAT, HnFrameRenderTargets::GBUFFER_TARGET_COUNT>& GBufferFormats = m_Params.Formats.GBuffer;
+                if (GBufferFormats[HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR] == TEX_FORMAT_UNKNOWN)
+                {
+                    LOG_ERROR_MESSAGE("Scene color target format must not be unknown");
+                    GBufferFormats[HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR] = TEX_FORMAT_RGBA16_FLOAT;
+                }
+
+                // Skipped targets (TEX_FORMAT_UNKNOWN) remain skipped
+                TEXTURE_FORMAT& NormalFormat = GBufferFormats[HnFrameRenderTargets::GBUFFER_TARGET_NORMAL];
+                if (pRenderParam->GetPackMaterialWithNormals())
+                {
+                    // Octahedron-encoded normal in xy, material data in zw
+                    if (NormalFormat != TEX_FORMAT_UNKNOWN)
+                        NormalFormat = TEX_FORMAT_RGBA16_UNORM;
+                    GBufferFormats[HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL] = TEX_FORMAT_UNKNOWN;
+                }
+                else if (pRenderParam->GetPackedNormals())
+                {
+                    // Octahedron-encoded normals only need two 16-bit channels
+                    if (NormalFormat != TEX_FORMAT_UNKNOWN)
+                        NormalFormat = TEX_FORMAT_RG16_UNORM;
+                }
+
+                TEXTURE_FORMAT& MeshIdFormat = GBufferFormats[HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID];
+                if (MeshIdFormat != TEX_FORMAT_UNKNOWN)
+                    MeshIdFormat = pRenderParam->GetMeshIdFormat();
+            }
+
             UpdateRenderPassState(m_Params,
                                   m_Params.Formats.GBuffer.data(),
                                   m_Params.Formats.GBuffer.size(),
@@ -189,14 +255,27 @@ void HnBeginFrameTask::PrepareRenderTargets(pxr::HdRenderIndex* RenderIndex,
     }
     const auto& FinalTargetDesc = pFinalColorRTV->GetTexture()->GetDesc();
 
-    m_FrameBufferWidth  = FinalTargetDesc.Width;
-    m_FrameBufferHeight = FinalTargetDesc.Height;
+    // All intermediate targets are rendered at the internal resolution and are
+    // upscaled to the final color target by the post-processing task.
+    m_FrameBufferWidth  = std::max(static_cast<Uint32>(static_cast<float>(FinalTargetDesc.Width) * m_Params.RenderScale + 0.5f), 1u);
+    m_FrameBufferHeight = std::max(static_cast<Uint32>(static_cast<float>(FinalTargetDesc.Height) * m_Params.RenderScale + 0.5f), 1u);
 
-    auto UpdateBrim = [&](const pxr::SdfPath& Id, TEXTURE_FORMAT Format, const std::string& Name) -> ITextureView* {
+    HnRenderDelegate* RenderDelegate  = static_cast<HnRenderDelegate*>(RenderIndex->GetRenderDelegate());
+    const Uint64      MainContextMask = RenderDelegate->GetMainContextMask();
+
+    auto UpdateBrim = [&](const pxr::SdfPath& Id, TEXTURE_FORMAT Format, const std::string& Name, Uint64 ImmediateContextMask) -> ITextureView* {
         if (Format == TEX_FORMAT_UNKNOWN)
+        {
+            // The target is skipped - release the texture that may have been created for the previous layout
+            if (!Id.IsEmpty())
+            {
+                if (HnRenderBuffer* Renderbuffer = static_cast<HnRenderBuffer*>(RenderIndex->GetBprim(pxr::HdPrimTypeTokens->renderBuffer, Id)))
+                    Renderbuffer->ReleaseTarget();
+            }
             return nullptr;
+        }
 
-        IRenderDevice* const pDevice = static_cast<HnRenderDelegate*>(RenderIndex->GetRenderDelegate())->GetDevice();
+        IRenderDevice* const pDevice = RenderDelegate->GetDevice();
         if (!pDevice->GetTextureFormatInfo(Format).Supported)
         {
             Format = GetFallbackTextureFormat(Format);
@@ -215,8 +294,9 @@ void HnBeginFrameTask::PrepareRenderTargets(pxr::HdRenderIndex* RenderIndex,
         {
             const auto& ViewDesc   = pView->GetDesc();
             const auto& TargetDesc = pView->GetTexture()->GetDesc();
-            if (TargetDesc.GetWidth() == FinalTargetDesc.GetWidth() &&
-                TargetDesc.GetHeight() == FinalTargetDesc.GetHeight() &&
+            if (TargetDesc.GetWidth() == m_FrameBufferWidth &&
+                TargetDesc.GetHeight() == m_FrameBufferHeight &&
+                TargetDesc.ImmediateContextMask == ImmediateContextMask &&
                 ViewDesc.Format == Format)
                 return pView;
         }
@@ -225,9 +305,13 @@ void HnBeginFrameTask::PrepareRenderTargets(pxr::HdRenderIndex* RenderIndex,
 
         auto TargetDesc      = FinalTargetDesc;
         TargetDesc.Name      = Name.c_str();
+        TargetDesc.Width     = m_FrameBufferWidth;
+        TargetDesc.Height    = m_FrameBufferHeight;
         TargetDesc.Format    = Format;
         TargetDesc.BindFlags = (IsDepth ? BIND_DEPTH_STENCIL : BIND_RENDER_TARGET) | BIND_SHADER_RESOURCE;
 
+        TargetDesc.ImmediateContextMask = ImmediateContextMask;
+
         RefCntAutoPtr<ITexture> pTarget;
         pDevice->CreateTexture(TargetDesc, nullptr, &pTarget);
         if (!pTarget)
@@ -249,8 +333,10 @@ void HnBeginFrameTask::PrepareRenderTargets(pxr::HdRenderIndex* RenderIndex,
 
     for (Uint32 i = 0; i < HnFrameRenderTargets::GBUFFER_TARGET_COUNT; ++i)
     {
-        const char* Name                    = HnFrameRenderTargets::GetGBufferTargetName(static_cast<HnFrameRenderTargets::GBUFFER_TARGET>(i));
-        m_FrameRenderTargets.GBufferRTVs[i] = UpdateBrim(m_GBufferTargetIds[i], m_Params.Formats.GBuffer[i], Name);
+        const char* Name = HnFrameRenderTargets::GetGBufferTargetName(static_cast<HnFrameRenderTargets::GBUFFER_TARGET>(i));
+        // Normals are read by the ambient occlusion pass that may run on the async compute context
+        const Uint64 ImmediateContextMask   = i == HnFrameRenderTargets::GBUFFER_TARGET_NORMAL ? RenderDelegate->GetAsyncComputeContextMask() : MainContextMask;
+        m_FrameRenderTargets.GBufferRTVs[i] = UpdateBrim(m_GBufferTargetIds[i], m_Params.Formats.GBuffer[i], Name, ImmediateContextMask);
         if (m_FrameRenderTargets.GBufferRTVs[i])
         {
             m_FrameRenderTargets.GBufferSRVs[i] = m_FrameRenderTargets.GBufferRTVs[i]->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
@@ -258,16 +344,18 @@ void HnBeginFrameTask::PrepareRenderTargets(pxr::HdRenderIndex* RenderIndex,
         }
         else
         {
-            UNEXPECTED("Unable to get GBuffer target from Bprim ", m_GBufferTargetIds[i]);
+            m_FrameRenderTargets.GBufferSRVs[i] = nullptr;
+            if (m_Params.Formats.GBuffer[i] != TEX_FORMAT_UNKNOWN)
+                UNEXPECTED("Unable to get GBuffer target from Bprim ", m_GBufferTargetIds[i]);
         }
     }
 
-    m_FrameRenderTargets.SelectionDepthDSV             = UpdateBrim(m_SelectionDepthBufferId, m_Params.Formats.Depth, "Selection depth buffer");
-    m_FrameRenderTargets.DepthDSV                      = UpdateBrim(m_DepthBufferId[0], m_Params.Formats.Depth, "Depth buffer 0");
-    m_FrameRenderTargets.PrevDepthDSV                  = UpdateBrim(m_DepthBufferId[1], m_Params.Formats.Depth, "Depth buffer 1");
-    m_FrameRenderTargets.ClosestSelectedLocationRTV[0] = UpdateBrim(m_ClosestSelLocnTargetId[0], m_Params.Formats.ClosestSelectedLocation, "Closest selected location 0");
-    m_FrameRenderTargets.ClosestSelectedLocationRTV[1] = UpdateBrim(m_ClosestSelLocnTargetId[1], m_Params.Formats.ClosestSelectedLocation, "Closest selected location 1");
-    m_FrameRenderTargets.JitteredFinalColorRTV         = UpdateBrim(m_JitteredFinalColorTargetId, m_Params.Formats.JitteredColor, "Jittered final color");
+    m_FrameRenderTargets.SelectionDepthDSV             = UpdateBrim(m_SelectionDepthBufferId, m_Params.Formats.Depth, "Selection depth buffer", MainContextMask);
+    m_FrameRenderTargets.DepthDSV                      = UpdateBrim(m_DepthBufferId[0], m_Params.Formats.Depth, "Depth buffer 0", MainContextMask);
+    m_FrameRenderTargets.PrevDepthDSV                  = UpdateBrim(m_DepthBufferId[1], m_Params.Formats.Depth, "Depth buffer 1", MainContextMask);
+    m_FrameRenderTargets.ClosestSelectedLocationRTV[0] = UpdateBrim(m_ClosestSelLocnTargetId[0], m_Params.Formats.ClosestSelectedLocation, "Closest selected location 0", MainContextMask);
+    m_FrameRenderTargets.ClosestSelectedLocationRTV[1] = UpdateBrim(m_ClosestSelLocnTargetId[1], m_Params.Formats.ClosestSelectedLocation, "Closest selected location 1", MainContextMask);
+    m_FrameRenderTargets.JitteredFinalColorRTV         = UpdateBrim(m_JitteredFinalColorTargetId, m_Params.Formats.JitteredColor, "Jittered final color", MainContextMask);
 
     (*TaskCtx)[HnRenderResourceTokens->frameRenderTargets] = pxr::VtValue{&m_FrameRenderTargets};
 
@@ -365,6 +453,8 @@ void HnBeginFrameTask::Prepare(pxr::HdTaskContext* TaskCtx,
     }
 
     (*TaskCtx)[HnRenderResourceTokens->taaReset] = pxr::VtValue{ResetTAA};
+    // Used by HnRenderShadowsTask::Prepare() to fit shadow cascades to the camera frustum
+    (*TaskCtx)[HnRenderResourceTokens->camera] = pxr::VtValue{m_pCamera};
 
     if (ITextureView* pFinalColorRTV = GetRenderBufferTarget(*RenderIndex, m_Params.FinalColorTargetId))
     {
@@ -377,23 +467,43 @@ void HnBeginFrameTask::Prepare(pxr::HdTaskContext* TaskCtx,
 
     if (const HnShadowMapManager* ShadowMapMgr = RenderDelegate->GetShadowMapManager())
     {
-        // Assign indices to shadow casting lights
+        // Assign indices to shadow casting lights.
+        // Every shadow cascade uses its own index.
 
         const Uint32 NumShadowCastingLights = Renderer.GetSettings().EnableShadows ? Renderer.GetSettings().MaxShadowCastingLightCount : 0;
         const auto&  Lights                 = RenderDelegate->GetLights();
 
-        Uint32 ShadowCastingLightIdx = 0;
+        Uint32            ShadowCastingLightIdx = 0;
+        std::stringstream SkippedLightsSS;
+        Uint32            NumSkippedLights = 0;
         for (HnLight* Light : Lights)
         {
-            if (Light->ShadowsEnabled() && Light->IsVisible() && ShadowCastingLightIdx < NumShadowCastingLights)
+            if (Light->ShadowsEnabled() && Light->IsVisible() && ShadowCastingLightIdx + Light->GetNumShadowCascades() <= NumShadowCastingLights)
             {
-                Light->SetFrameAttribsIndex(ShadowCastingLightIdx++);
+                Light->SetFrameAttribsIndex(ShadowCastingLightIdx);
+                ShadowCastingLightIdx += Light->GetNumShadowCascades();
             }
             else
             {
+                if (Light->ShadowsEnabled() && Light->IsVisible() && NumShadowCastingLights > 0)
+                {
+                    SkippedLightsSS << (NumSkippedLights > 0 ? ", " : "") << Light->GetId();
+                    ++NumSkippedLights;
+                }
                 Light->SetFrameAttribsIndex(-1);
             }
         }
+
+        // Only report when the number of lights that exceed the budget changes to not flood the log every frame
+        if (NumSkippedLights != m_NumShadowBudgetSkippedLights)
+        {
+            if (NumSkippedLights > 0)
+            {
+                LOG_WARNING_MESSAGE("Shadow cascade budget (", NumShadowCastingLights, ") is exceeded. The following lights are rendered without shadows: ",
+                                    SkippedLightsSS.str(), ". Increase HnRenderDelegate::CreateInfo::MaxShadowCastingLightCount.");
+            }
+            m_NumShadowBudgetSkippedLights = NumSkippedLights;
+        }
     }
 }
 
@@ -428,36 +538,40 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
         for (const HnLight* Light : Lights)
         {
             const Int32 ShadowCastingLightIdx = Light->GetFrameAttribsIndex();
-            VERIFY_EXPR((ShadowCastingLightIdx < 0) == (!Light->ShadowsEnabled() || !Light->IsVisible() || ShadowCastingLightIdx >= static_cast<Int32>(NumShadowCastingLights)));
             if (ShadowCastingLightIdx < 0)
                 continue;
 
-            HLSL::PBRFrameAttribs* ShadowAttribs = reinterpret_cast<HLSL::PBRFrameAttribs*>(&m_FrameAttribsData[RenderDelegate->GetShadowPassFrameAttribsOffset(ShadowCastingLightIdx)]);
-            HLSL::CameraAttribs&   CamAttribs    = ShadowAttribs->Camera;
-
-            const float4x4& ProjMatrix = Light->GetViewProjMatrix();
-            const float4x4& ViewMatrix = Light->GetViewMatrix();
-            const float4x4  ViewProj   = Light->GetViewProjMatrix();
-
-            VERIFY_EXPR(ShadowAtlasDesc.Width > 0 && ShadowAtlasDesc.Height > 0);
-            CamAttribs.f4ViewportSize = float4{
-                static_cast<float>(ShadowAtlasDesc.Width),
-                static_cast<float>(ShadowAtlasDesc.Height),
-                1.f / static_cast<float>(ShadowAtlasDesc.Width),
-                1.f / static_cast<float>(ShadowAtlasDesc.Height),
-            };
-            CamAttribs.fHandness = 1.f;
-
-            CamAttribs.mView        = ViewMatrix;
-            CamAttribs.mProj        = ProjMatrix;
-            CamAttribs.mViewProj    = ViewProj;
-            CamAttribs.mViewInv     = ViewMatrix.Inverse();
-            CamAttribs.mProjInv     = ProjMatrix.Inverse();
-            CamAttribs.mViewProjInv = ViewProj.Inverse();
-            CamAttribs.f4Position   = float4{0, 0, 0, 1};
-            CamAttribs.f2Jitter     = float2{0, 0};
-
-            memset(&ShadowAttribs->Renderer, 0, sizeof(HLSL::PBRRendererShaderParameters));
+            const Uint32 NumCascades = Light->GetNumShadowCascades();
+            VERIFY_EXPR(Light->ShadowsEnabled() && Light->IsVisible() && ShadowCastingLightIdx + NumCascades <= NumShadowCastingLights);
+            for (Uint32 Cascade = 0; Cascade < NumCascades; ++Cascade)
+            {
+                HLSL::PBRFrameAttribs* ShadowAttribs = reinterpret_cast<HLSL::PBRFrameAttribs*>(&m_FrameAttribsData[RenderDelegate->GetShadowPassFrameAttribsOffset(ShadowCastingLightIdx + Cascade)]);
+                HLSL::CameraAttribs&   CamAttribs    = ShadowAttribs->Camera;
+
+                const float4x4& ProjMatrix = Light->GetCascadeProjMatrix(Cascade);
+                const float4x4& ViewMatrix = Light->GetViewMatrix();
+                const float4x4& ViewProj   = Light->GetCascadeViewProjMatrix(Cascade);
+
+                VERIFY_EXPR(ShadowAtlasDesc.Width > 0 && ShadowAtlasDesc.Height > 0);
+                CamAttribs.f4ViewportSize = float4{
+                    static_cast<float>(ShadowAtlasDesc.Width),
+                    static_cast<float>(ShadowAtlasDesc.Height),
+                    1.f / static_cast<float>(ShadowAtlasDesc.Width),
+                    1.f / static_cast<float>(ShadowAtlasDesc.Height),
+                };
+                CamAttribs.fHandness = 1.f;
+
+                CamAttribs.mView        = ViewMatrix;
+                CamAttribs.mProj        = ProjMatrix;
+                CamAttribs.mViewProj    = ViewProj;
+                CamAttribs.mViewInv     = ViewMatrix.Inverse();
+                CamAttribs.mProjInv     = ProjMatrix.Inverse();
+                CamAttribs.mViewProjInv = ViewProj.Inverse();
+                CamAttribs.f4Position   = float4{0, 0, 0, 1};
+                CamAttribs.f2Jitter     = float2{0, 0};
+
+                memset(&ShadowAttribs->Renderer, 0, sizeof(HLSL::PBRRendererShaderParameters));
+            }
         }
     }
 
@@ -530,6 +644,11 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
             CamAttribs.fExposure     = m_pCamera->GetExposure();
 
             ProjMatrix.GetNearFarClipPlanes(CamAttribs.fNearPlaneZ, CamAttribs.fFarPlaneZ, pDevice->GetDeviceInfo().NDC.MinZ == -1);
+            if (CamAttribs.fNearPlaneZ > CamAttribs.fFarPlaneZ)
+            {
+                // Reversed depth projection
+                std::swap(CamAttribs.fNearPlaneZ, CamAttribs.fFarPlaneZ);
+            }
 
             if (CamAttribs.mView != PrevCamera.mView)
             {
@@ -558,6 +677,9 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
             UNEXPECTED("Camera is null. It should've been set in Prepare()");
         }
 
+        ClusteredLightGrid* LightClusters = Renderer.GetLightClusters();
+        m_ClusteredLights.clear();
+
         int LightCount = 0;
         for (HnLight* Light : RenderDelegate->GetLights())
         {
@@ -583,17 +705,41 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
             };
 
             const int ShadowMapIndex = Light->GetFrameAttribsIndex();
-            if (Light->ShadowsEnabled() && ShadowMapIndex >= 0)
+            if (LightClusters != nullptr &&
+                Light->GetParams().Type != GLTF::Light::TYPE::DIRECTIONAL &&
+                !(Light->ShadowsEnabled() && ShadowMapIndex >= 0))
             {
-                if (const HLSL::PBRShadowMapInfo* pShadowMapInfo = Light->GetShadowMapShaderInfo())
+                // USD lights have no range, so compute the distance at which
+                // the light intensity falls below the cutoff.
+                const GLTF::Light& Params       = Light->GetParams();
+                const float        MaxIntensity = std::max(std::max(Params.Color.r, Params.Color.g), Params.Color.b) * Params.Intensity;
+                const float        Range        = std::sqrt(MaxIntensity / std::max(m_Params.Renderer.LightIntensityCutoff, 1e-6f));
+                if (Range > 0 && m_ClusteredLights.size() < LightClusters->GetMaxLightCount())
                 {
-                    ShadowMaps[ShadowMapIndex] = *pShadowMapInfo;
+                    m_ClusteredLights.emplace_back();
+                    GLTF_PBR_Renderer::WritePBRLightShaderAttribs(LightAttribs, &m_ClusteredLights.back());
+                    if (Params.Range <= 0 || Params.Range > Range)
+                        m_ClusteredLights.back().Range4 = (Range * Range) * (Range * Range);
                 }
-                else
+                continue;
+            }
+
+            if (Light->ShadowsEnabled() && ShadowMapIndex >= 0)
+            {
+                const Uint32 NumCascades = Light->GetNumShadowCascades();
+                for (Uint32 Cascade = 0; Cascade < NumCascades; ++Cascade)
                 {
-                    UNEXPECTED("Shadow map info is null");
+                    if (const HLSL::PBRShadowMapInfo* pShadowMapInfo = Light->GetShadowMapShaderInfo(Cascade))
+                    {
+                        ShadowMaps[ShadowMapIndex + Cascade] = *pShadowMapInfo;
+                    }
+                    else
+                    {
+                        UNEXPECTED("Shadow map info is null");
+                    }
                 }
-                LightAttribs.ShadowMapIndex = ShadowMapIndex;
+                LightAttribs.ShadowMapIndex    = ShadowMapIndex;
+                LightAttribs.NumShadowCascades = static_cast<int>(NumCascades);
             }
 
             GLTF_PBR_Renderer::WritePBRLightShaderAttribs(LightAttribs, Lights + LightCount);
@@ -605,11 +751,18 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
             }
         }
 
+        // Write the environment map cubemaps precomputed in previous frames to the IBL cache
+        RenderDelegate->GetUSDRenderer()->UpdateIBLCache(pCtx);
+
         {
             HLSL::PBRRendererShaderParameters& RendererParams = FrameAttribs->Renderer;
             RenderDelegate->GetUSDRenderer()->SetInternalShaderParameters(RendererParams);
 
             RendererParams.LightCount = LightCount;
+            if (LightClusters != nullptr)
+            {
+                LightClusters->Update(pCtx, CamAttribs, m_ClusteredLights.data(), static_cast<Uint32>(m_ClusteredLights.size()), RendererParams);
+            }
 
             RendererParams.OcclusionStrength = m_Params.Renderer.OcclusionStrength;
             RendererParams.EmissionScale     = m_Params.Renderer.EmissionScale;
@@ -622,7 +775,8 @@ void HnBeginFrameTask::UpdateFrameConstants(IDeviceContext* pCtx,
             RendererParams.HighlightColor = float4{0, 0, 0, 0};
             RendererParams.PointSize      = m_Params.Renderer.PointSize;
 
-            RendererParams.MipBias = UseTAA ? -0.5 : 0.0;
+            // Sample textures at the output resolution when the frame is temporally upscaled
+            RendererParams.MipBias = UseTAA ? -0.5f + std::log2(m_Params.RenderScale) : 0.0f;
 
             // Tone mapping is performed in the post-processing pass
             RendererParams.AverageLogLum = 0.3f;
@@ -713,6 +867,8 @@ void HnBeginFrameTask::Execute(pxr::HdTaskContext* TaskCtx)
         // Reset the fallBackPsoInUse flag.
         // HnRenderRprimsTask::Execute sets it to true if the fallback PSO was used.
         (*TaskCtx)[HnRenderResourceTokens->fallBackPsoInUse] = pxr::VtValue{false};
+        // HnRenderRprimsTask::Execute sets renderPassSkipped to true if any render pass was skipped.
+        (*TaskCtx)[HnRenderResourceTokens->renderPassSkipped] = pxr::VtValue{false};
 
         bool CameraTransformDirty   = false;
         bool LoadingAnimationActive = false;
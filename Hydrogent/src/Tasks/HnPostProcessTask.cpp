@@ -38,6 +38,7 @@
 #include "ShaderMacroHelper.hpp"
 #include "CommonlyUsedStates.h"
 #include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
 #include "VectorFieldRenderer.hpp"
 #include "ToneMapping.hpp"
 #include "ScopedDebugGroup.hpp"
@@ -158,7 +159,7 @@ void HnPostProcessTask::PostProcessingTechnique::PreparePSO(TEXTURE_FORMAT RTVFo
     bool IsDirty = PSO && PSO->GetGraphicsPipelineDesc().RTVFormats[0] != RTVFormat;
 
     {
-        const bool _ConvertOutputToSRGB = !PPTask.m_UseTAA && PPTask.m_Params.ConvertOutputToSRGB;
+        const bool _ConvertOutputToSRGB = !PPTask.m_UseCopyFrame && PPTask.m_Params.ConvertOutputToSRGB;
         if (ConvertOutputToSRGB != _ConvertOutputToSRGB)
         {
             ConvertOutputToSRGB = _ConvertOutputToSRGB;
@@ -167,7 +168,7 @@ void HnPostProcessTask::PostProcessingTechnique::PreparePSO(TEXTURE_FORMAT RTVFo
     }
 
     {
-        const int _ToneMappingMode = !PPTask.m_UseTAA ? PPTask.m_Params.ToneMapping.iToneMappingMode : 0;
+        const int _ToneMappingMode = !PPTask.m_UseCopyFrame ? PPTask.m_Params.ToneMapping.iToneMappingMode : 0;
         if (ToneMappingMode != _ToneMappingMode)
         {
             ToneMappingMode = _ToneMappingMode;
@@ -176,7 +177,9 @@ void HnPostProcessTask::PostProcessingTechnique::PreparePSO(TEXTURE_FORMAT RTVFo
     }
 
     {
-        const CoordinateGridRenderer::FEATURE_FLAGS _GridFeatureFlags = !PPTask.m_UseTAA ? PPTask.m_Params.GridFeatureFlags : CoordinateGridRenderer::FEATURE_FLAG_NONE;
+        CoordinateGridRenderer::FEATURE_FLAGS _GridFeatureFlags = !PPTask.m_UseCopyFrame ? PPTask.m_Params.GridFeatureFlags : CoordinateGridRenderer::FEATURE_FLAG_NONE;
+        if (_GridFeatureFlags != CoordinateGridRenderer::FEATURE_FLAG_NONE && PPTask.m_ReversedDepth)
+            _GridFeatureFlags |= CoordinateGridRenderer::FEATURE_FLAG_REVERSED_DEPTH;
         if (GridFeatureFlags != _GridFeatureFlags)
         {
             GridFeatureFlags = _GridFeatureFlags;
@@ -197,9 +200,13 @@ void HnPostProcessTask::PostProcessingTechnique::PreparePSO(TEXTURE_FORMAT RTVFo
         // RenderDeviceWithCache_E throws exceptions in case of errors
         RenderDeviceWithCache_E Device{RenderDelegate->GetDevice(), RenderDelegate->GetRenderStateCache()};
 
+        const HnRenderParam* pRenderParam = static_cast<const HnRenderParam*>(RenderDelegate->GetRenderParam());
+
         ShaderMacroHelper Macros;
         Macros.Add("CONVERT_OUTPUT_TO_SRGB", ConvertOutputToSRGB);
         Macros.Add("TONE_MAPPING_MODE", ToneMappingMode);
+        Macros.Add("PACKED_NORMAL", pRenderParam->GetPackedNormals());
+        Macros.Add("PACKED_MATERIAL", pRenderParam->GetPackMaterialWithNormals());
         if (GridFeatureFlags != CoordinateGridRenderer::FEATURE_FLAG_NONE)
         {
             Macros.Add("ENABLE_GRID", 1);
@@ -232,13 +239,10 @@ void HnPostProcessTask::PostProcessingTechnique::PrepareSRB(ITextureView* pClose
 {
     const auto* FrameTargets = PPTask.m_FrameTargets;
 
-    for (Uint32 i = 0; i < HnFrameRenderTargets::GBUFFER_TARGET_COUNT; ++i)
+    if (FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR] == nullptr)
     {
-        if (FrameTargets->GBufferSRVs[i] == nullptr)
-        {
-            UNEXPECTED("G-buffer SRV ", i, " is null");
-            return;
-        }
+        UNEXPECTED("Scene color SRV is null");
+        return;
     }
 
     ITextureView* pDepthSRV = FrameTargets->DepthDSV->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
@@ -266,10 +270,18 @@ void HnPostProcessTask::PostProcessingTechnique::PrepareSRB(ITextureView* pClose
     auto&  ShaderVars = Resources[ResIdx].Vars;
 
     ITextureView* pOffscreenColorSRV = FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR];
-    ITextureView* pSpecularIblSRV    = FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_IBL];
-    ITextureView* pNormalSRV         = FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_NORMAL];
-    ITextureView* pMaterialSRV       = FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL];
-    ITextureView* pBaseColorSRV      = FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_BASE_COLOR];
+
+    // Targets skipped in the current G-buffer layout are only read by the shader when SSR is enabled,
+    // which is never the case if any of them is missing. Bind the scene color in their place to keep
+    // all variables initialized.
+    auto GetGBufferSRV = [&](HnFrameRenderTargets::GBUFFER_TARGET Target) {
+        ITextureView* pSRV = FrameTargets->GBufferSRVs[Target];
+        return pSRV != nullptr ? pSRV : pOffscreenColorSRV;
+    };
+    ITextureView* pSpecularIblSRV = GetGBufferSRV(HnFrameRenderTargets::GBUFFER_TARGET_IBL);
+    ITextureView* pNormalSRV      = GetGBufferSRV(HnFrameRenderTargets::GBUFFER_TARGET_NORMAL);
+    ITextureView* pMaterialSRV    = GetGBufferSRV(HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL);
+    ITextureView* pBaseColorSRV   = GetGBufferSRV(HnFrameRenderTargets::GBUFFER_TARGET_BASE_COLOR);
     if (SRB)
     {
         auto VarValueChanged = [](const ShaderResourceVariableX& Var, IDeviceObject* pValue) {
@@ -338,7 +350,8 @@ void HnPostProcessTask::CopyFrameTechnique::PreparePRS()
         .AddResource(SHADER_TYPE_PIXEL, "cbPostProcessAttribs", SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         .AddResource(SHADER_TYPE_PIXEL, "cbFrameAttribs", SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         .AddResource(SHADER_TYPE_PIXEL, "g_ColorBuffer", SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
-        .AddResource(SHADER_TYPE_PIXEL, "g_Depth", SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_NONE, kWGPUDepthMapAttribs);
+        .AddResource(SHADER_TYPE_PIXEL, "g_Depth", SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_NONE, kWGPUDepthMapAttribs)
+        .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_ColorBuffer", Sam_LinearClamp);
 
     PRS = RenderDeviceWithCache_N{pDevice, pStateCache}.CreatePipelineResourceSignature(PRSDesc);
     VERIFY_EXPR(PRS);
@@ -366,8 +379,16 @@ void HnPostProcessTask::CopyFrameTechnique::PreparePSO(TEXTURE_FORMAT RTVFormat)
         IsDirty         = true;
     }
 
+    if (UpsampleFrame != PPTask.m_UseUpscaling)
+    {
+        UpsampleFrame = PPTask.m_UseUpscaling;
+        IsDirty       = true;
+    }
+
     {
-        const CoordinateGridRenderer::FEATURE_FLAGS _GridFeatureFlags = PPTask.m_UseTAA ? PPTask.m_Params.GridFeatureFlags : CoordinateGridRenderer::FEATURE_FLAG_NONE;
+        CoordinateGridRenderer::FEATURE_FLAGS _GridFeatureFlags = PPTask.m_UseCopyFrame ? PPTask.m_Params.GridFeatureFlags : CoordinateGridRenderer::FEATURE_FLAG_NONE;
+        if (_GridFeatureFlags != CoordinateGridRenderer::FEATURE_FLAG_NONE && PPTask.m_ReversedDepth)
+            _GridFeatureFlags |= CoordinateGridRenderer::FEATURE_FLAG_REVERSED_DEPTH;
         if (GridFeatureFlags != _GridFeatureFlags)
         {
             GridFeatureFlags = _GridFeatureFlags;
@@ -391,6 +412,7 @@ void HnPostProcessTask::CopyFrameTechnique::PreparePSO(TEXTURE_FORMAT RTVFormat)
         ShaderMacroHelper Macros;
         Macros.Add("CONVERT_OUTPUT_TO_SRGB", ConvertOutputToSRGB);
         Macros.Add("TONE_MAPPING_MODE", ToneMappingMode);
+        Macros.Add("UPSAMPLE_FRAME", UpsampleFrame);
         if (GridFeatureFlags != CoordinateGridRenderer::FEATURE_FLAG_NONE)
         {
             Macros.Add("ENABLE_GRID", 1);
@@ -421,14 +443,18 @@ void HnPostProcessTask::CopyFrameTechnique::PreparePSO(TEXTURE_FORMAT RTVFormat)
 
 void HnPostProcessTask::CopyFrameTechnique::PrepareSRB(Uint32 FrameIdx)
 {
-    VERIFY_EXPR(PPTask.m_TAA);
+    VERIFY_EXPR(PPTask.m_TAA && PPTask.m_SuperResolution);
     ITexture* pAccumulatedFrame = nullptr;
-    if (PPTask.m_UseBloom)
+    if (PPTask.m_UseTAA && PPTask.m_UseUpscaling)
+        pAccumulatedFrame = PPTask.m_SuperResolution->GetUpsampledTextureSRV()->GetTexture();
+    else if (PPTask.m_UseBloom)
         pAccumulatedFrame = PPTask.m_Bloom->GetBloomTextureSRV()->GetTexture();
     else if (PPTask.m_UseDOF)
         pAccumulatedFrame = PPTask.m_DOF->GetDepthOfFieldTextureSRV()->GetTexture();
-    else
+    else if (PPTask.m_UseTAA)
         pAccumulatedFrame = PPTask.m_TAA->GetAccumulatedFrameSRV()->GetTexture();
+    else
+        pAccumulatedFrame = PPTask.m_FrameTargets->JitteredFinalColorRTV->GetTexture(); // Upscaling without TAA
     if (pAccumulatedFrame == nullptr)
     {
         UNEXPECTED("Accumulated frame is null");
@@ -563,8 +589,9 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
     if (!m_PostFXContext)
     {
         PostFXContext::CreateInfo PostFXCI;
-        PostFXCI.EnableAsyncCreation = AsyncShaderCompilation;
-        PostFXCI.PackMatrixRowMajor  = true;
+        PostFXCI.EnableAsyncCreation  = AsyncShaderCompilation;
+        PostFXCI.PackMatrixRowMajor   = true;
+        PostFXCI.ImmediateContextMask = RenderDelegate->GetAsyncComputeContextMask();
 
         m_PostFXContext = std::make_unique<PostFXContext>(pDevice, PostFXCI);
     }
@@ -576,7 +603,11 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
 
     if (!m_SSAO)
     {
-        m_SSAO = std::make_unique<ScreenSpaceAmbientOcclusion>(pDevice, ScreenSpaceAmbientOcclusion::CreateInfo{AsyncShaderCompilation});
+        ScreenSpaceAmbientOcclusion::CreateInfo SSAOCI;
+        SSAOCI.EnableAsyncCreation  = AsyncShaderCompilation;
+        SSAOCI.pAsyncComputeContext = RenderDelegate->GetAsyncComputeContext();
+
+        m_SSAO = std::make_unique<ScreenSpaceAmbientOcclusion>(pDevice, SSAOCI);
     }
 
     if (!m_TAA)
@@ -594,18 +625,52 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
         m_Bloom = std::make_unique<Bloom>(pDevice, Bloom::CreateInfo{AsyncShaderCompilation});
     }
 
+    if (!m_SuperResolution)
+    {
+        m_SuperResolution = std::make_unique<SuperResolution>(pDevice, SuperResolution::CreateInfo{AsyncShaderCompilation});
+    }
+
     const PBR_Renderer::DebugViewType DebugView = pRenderParam->GetDebugView();
 
     const bool EnablePostProcessing =
         (DebugView == PBR_Renderer::DebugViewType::None || DebugView == PBR_Renderer::DebugViewType::WhiteBaseColor) &&
         (pRenderParam->GetRenderMode() == HN_RENDER_MODE_SOLID);
 
+    // Effects that require G-buffer targets skipped in the current layout are disabled
+    const auto& GBufferSRVs        = m_FrameTargets->GBufferSRVs;
+    const bool  HasMotionVectors   = GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MOTION_VECTOR] != nullptr;
+    const bool  HasNormals         = GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_NORMAL] != nullptr;
+    const bool  HasMaterial        = pRenderParam->GetPackMaterialWithNormals() ? HasNormals : GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL] != nullptr;
+    const bool  SSRTargetsPresent  = (HasMotionVectors && HasNormals && HasMaterial &&
+                                     GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_BASE_COLOR] != nullptr &&
+                                     GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_IBL] != nullptr);
+    const bool  SSAOTargetsPresent = HasMotionVectors && HasNormals;
+    // The environment map and bound boxes opt out of SSR and SSAO by writing zero scene color alpha.
+    // Formats without alpha (e.g. R11G11B10_FLOAT) lose this mask, so both effects are disabled.
+    const bool SceneColorHasAlpha = GetTextureFormatAttribs(GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_SCENE_COLOR]->GetTexture()->GetDesc().Format).NumComponents == 4;
+
     float SSRScale  = 0;
     float SSAOScale = 0;
     if (EnablePostProcessing)
     {
         SSRScale  = m_Params.SSRScale;
         SSAOScale = m_Params.SSAOScale;
+        if (SSRScale > 0 && !SSRTargetsPresent)
+        {
+            LOG_WARNING_MESSAGE_ONCE("SSR is disabled because the G-buffer layout does not contain normal, material, base color, IBL or motion vector targets");
+            SSRScale = 0;
+        }
+        if (SSAOScale > 0 && !SSAOTargetsPresent)
+        {
+            LOG_WARNING_MESSAGE_ONCE("SSAO is disabled because the G-buffer layout does not contain normal or motion vector targets");
+            SSAOScale = 0;
+        }
+        if ((SSRScale > 0 || SSAOScale > 0) && !SceneColorHasAlpha)
+        {
+            LOG_WARNING_MESSAGE_ONCE("SSR and SSAO are disabled because the scene color format has no alpha channel to mask out the background");
+            SSRScale  = 0;
+            SSAOScale = 0;
+        }
     }
     if (SSRScale != m_SSRScale)
     {
@@ -621,23 +686,63 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
     }
     m_UseSSAO  = m_SSAOScale > 0;
     m_UseTAA   = m_Params.EnableTAA && EnablePostProcessing;
+    if (m_UseTAA && !HasMotionVectors)
+    {
+        LOG_WARNING_MESSAGE_ONCE("TAA is disabled because the G-buffer layout does not contain the motion vector target");
+        m_UseTAA = false;
+    }
     m_UseBloom = m_Params.EnableBloom && EnablePostProcessing && m_UseTAA;
     m_UseDOF   = m_Params.EnableDOF && EnablePostProcessing && m_UseTAA;
 
+    // The frame is rendered at a reduced resolution (see HnBeginFrameTaskParams::RenderScale).
+    // With TAA enabled, the frame is upscaled temporally by the super resolution effect,
+    // otherwise the copy frame pass performs a bilinear upsampling.
+    const TextureDesc& FinalColorDesc   = m_FinalColorRTV->GetTexture()->GetDesc();
+    const TextureDesc& RenderTargetDesc = m_FrameTargets->DepthDSV->GetTexture()->GetDesc();
+
+    m_UseUpscaling = RenderTargetDesc.Width != FinalColorDesc.Width || RenderTargetDesc.Height != FinalColorDesc.Height;
+    m_UseCopyFrame = m_UseTAA || m_UseUpscaling;
+
+    m_ReversedDepth = pRenderParam->GetReversedDepth();
+
     // Initialize post-processing and copy frame techniques first as they
     // don't use async shader compilation.
     m_PostProcessTech.PreparePRS();
-    m_PostProcessTech.PreparePSO((m_UseTAA ? m_FrameTargets->JitteredFinalColorRTV : m_FinalColorRTV)->GetDesc().Format);
+    m_PostProcessTech.PreparePSO((m_UseCopyFrame ? m_FrameTargets->JitteredFinalColorRTV : m_FinalColorRTV)->GetDesc().Format);
 
     m_CopyFrameTech.PreparePRS();
     m_CopyFrameTech.PreparePSO(m_FinalColorRTV->GetDesc().Format);
 
-    const TextureDesc& FinalColorDesc = m_FinalColorRTV->GetTexture()->GetDesc();
+    PostFXContext::FEATURE_FLAGS               PostFXFeatureFlags = PostFXContext::FEATURE_FLAG_NONE;
+    ScreenSpaceAmbientOcclusion::FEATURE_FLAGS SSAOFeatureFlags   = m_Params.SSAOFeatureFlags;
+    ScreenSpaceReflection::FEATURE_FLAGS       SSRFeatureFlags    = m_Params.SSRFeatureFlags;
+    TemporalAntiAliasing::FEATURE_FLAGS        TAAFeatureFlags    = m_Params.TAAFeatureFlags;
+    if (m_ReversedDepth)
+    {
+        PostFXFeatureFlags |= PostFXContext::FEATURE_FLAG_REVERSED_DEPTH;
+        SSAOFeatureFlags |= ScreenSpaceAmbientOcclusion::FEATURE_FLAG_REVERSED_DEPTH;
+        SSRFeatureFlags |= ScreenSpaceReflection::FEATURE_FLAG_REVERSED_DEPTH;
+        TAAFeatureFlags |= TemporalAntiAliasing::FEATURE_FLAG_REVERSED_DEPTH;
+    }
+    if (pRenderParam->GetPackedNormals())
+    {
+        SSAOFeatureFlags |= ScreenSpaceAmbientOcclusion::FEATURE_FLAG_PACKED_NORMAL;
+        SSRFeatureFlags |= ScreenSpaceReflection::FEATURE_FLAG_PACKED_NORMAL;
+    }
 
-    m_PostFXContext->PrepareResources(pDevice, {pRenderParam->GetFrameNumber(), FinalColorDesc.Width, FinalColorDesc.Height}, PostFXContext::FEATURE_FLAG_NONE);
-    m_SSAO->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), m_Params.SSAOFeatureFlags);
-    m_SSR->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), m_Params.SSRFeatureFlags);
-    m_TAA->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), m_Params.TAAFeatureFlags);
+    // The depth hierarchy is requested by SSR when it is prepared below and is also reused by SSAO
+    m_PostFXContext->PrepareResources(pDevice,
+                                      {
+                                          pRenderParam->GetFrameNumber(),
+                                          RenderTargetDesc.Width,
+                                          RenderTargetDesc.Height,
+                                          FinalColorDesc.Width,
+                                          FinalColorDesc.Height,
+                                      },
+                                      PostFXFeatureFlags);
+    m_SSAO->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), SSAOFeatureFlags);
+    m_SSR->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), SSRFeatureFlags);
+    m_TAA->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), TAAFeatureFlags);
     if (m_UseBloom)
     {
         m_Bloom->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), m_Params.BloomFeatureFlags);
@@ -648,12 +753,20 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
         m_DOF->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), m_Params.DOFFeatureFlags);
     }
 
+    if (m_UseTAA && m_UseUpscaling)
+    {
+        m_SuperResolution->PrepareResources(pDevice, pCtx, m_PostFXContext.get(), SuperResolution::FEATURE_FLAG_TEMPORAL_UPSCALING);
+    }
+
     m_PostProcessTech.PrepareSRB(ClosestSelectedLocationSRV, pRenderParam->GetFrameNumber());
 
-    if (m_UseTAA)
+    if (m_UseCopyFrame)
     {
         m_CopyFrameTech.PrepareSRB(pRenderParam->GetFrameNumber());
+    }
 
+    if (m_UseTAA)
+    {
         {
             auto it = TaskCtx->find(HnRenderResourceTokens->suspendSuperSampling);
             if (it != TaskCtx->end())
@@ -701,8 +814,11 @@ void HnPostProcessTask::Prepare(pxr::HdTaskContext* TaskCtx,
 
     // These parameters will be used by HnBeginFrameTask::Execute() to set
     // projection matrix and mip bias.
+    float2 JitterOffsets{0, 0};
+    if (m_UseTAA && !m_ResetTAA)
+        JitterOffsets = m_UseUpscaling ? m_SuperResolution->GetJitterOffset() : m_TAA->GetJitterOffset();
     (*TaskCtx)[HnRenderResourceTokens->useTaa]           = pxr::VtValue{m_UseTAA};
-    (*TaskCtx)[HnRenderResourceTokens->taaJitterOffsets] = pxr::VtValue{m_UseTAA && !m_ResetTAA ? m_TAA->GetJitterOffset() : float2{0, 0}};
+    (*TaskCtx)[HnRenderResourceTokens->taaJitterOffsets] = pxr::VtValue{JitterOffsets};
 }
 
 void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
@@ -740,12 +856,16 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
 
     {
         std::array<StateTransitionDesc, HnFrameRenderTargets::GBUFFER_TARGET_COUNT> Barriers{};
+
+        Uint32 NumBarriers = 0;
         for (Uint32 i = 0; i < HnFrameRenderTargets::GBUFFER_TARGET_COUNT; ++i)
         {
-            Barriers[i] = {m_FrameTargets->GBufferSRVs[i]->GetTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+            // Skip targets that are not present in the current G-buffer layout
+            if (ITextureView* pSRV = m_FrameTargets->GBufferSRVs[i])
+                Barriers[NumBarriers++] = {pSRV->GetTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
         }
         pCtx->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-        pCtx->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+        pCtx->TransitionResourceStates(NumBarriers, Barriers.data());
     }
 
     const TextureDesc& FinalColorDesc = m_FinalColorRTV->GetTexture()->GetDesc();
@@ -773,6 +893,19 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
         m_PostFXContext->Execute(PostFXAttribs);
     }
 
+    ScreenSpaceAmbientOcclusion::RenderAttributes SSAORenderAttribs{pDevice, pStateCache, pCtx};
+    if (m_UseSSAO)
+    {
+        SSAORenderAttribs.pPostFXContext   = m_PostFXContext.get();
+        SSAORenderAttribs.pDepthBufferSRV  = m_FrameTargets->DepthDSV->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+        SSAORenderAttribs.pNormalBufferSRV = m_FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_NORMAL];
+        SSAORenderAttribs.pSSAOAttribs     = &m_Params.SSAO;
+
+        // When the async compute context is used, the ambient occlusion is
+        // computed on the async queue while SSR is rendered on the main context.
+        m_SSAO->BeginExecute(SSAORenderAttribs);
+    }
+
     if (m_UseSSR)
     {
         ScreenSpaceReflection::RenderAttributes SSRRenderAttribs{pDevice, pStateCache, pCtx};
@@ -783,28 +916,34 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
         SSRRenderAttribs.pMaterialBufferSRV = m_FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL];
         SSRRenderAttribs.pMotionVectorsSRV  = m_FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MOTION_VECTOR];
         SSRRenderAttribs.pSSRAttribs        = &m_Params.SSR;
+
+        HLSL::ScreenSpaceReflectionAttribs PackedMaterialSSRAttribs;
+        if (pRenderParam->GetPackMaterialWithNormals())
+        {
+            // Roughness is stored in the blue channel of the normal target
+            PackedMaterialSSRAttribs                  = m_Params.SSR;
+            PackedMaterialSSRAttribs.RoughnessChannel = 2;
+
+            SSRRenderAttribs.pMaterialBufferSRV = SSRRenderAttribs.pNormalBufferSRV;
+            SSRRenderAttribs.pSSRAttribs        = &PackedMaterialSSRAttribs;
+        }
         m_SSR->Execute(SSRRenderAttribs);
     }
 
     if (m_UseSSAO)
     {
-        ScreenSpaceAmbientOcclusion::RenderAttributes SSAORenderAttribs{pDevice, pStateCache, pCtx};
-        SSAORenderAttribs.pPostFXContext   = m_PostFXContext.get();
-        SSAORenderAttribs.pDepthBufferSRV  = m_FrameTargets->DepthDSV->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-        SSAORenderAttribs.pNormalBufferSRV = m_FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_NORMAL];
-        SSAORenderAttribs.pSSAOAttribs     = &m_Params.SSAO;
-        m_SSAO->Execute(SSAORenderAttribs);
+        m_SSAO->EndExecute(SSAORenderAttribs);
     }
 
     {
         ScopedDebugGroup DebugGroup{pCtx, "Post Processing"};
 
-        ITextureView* pRTVs[] = {m_UseTAA ? m_FrameTargets->JitteredFinalColorRTV : m_FinalColorRTV};
+        ITextureView* pRTVs[] = {m_UseCopyFrame ? m_FrameTargets->JitteredFinalColorRTV : m_FinalColorRTV};
         pCtx->SetRenderTargets(_countof(pRTVs), pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
         if (m_AttribsCBDirty)
         {
-            const bool ReverseToneMapSelectionColors = m_UseTAA && m_Params.ToneMapping.iToneMappingMode != 0;
+            const bool ReverseToneMapSelectionColors = m_UseCopyFrame && m_Params.ToneMapping.iToneMappingMode != 0;
 
             const float3 SelectionColorHDR = ReverseToneMapSelectionColors ?
                 ReverseExpToneMap(m_Params.SelectionColor, m_Params.ToneMapping.fMiddleGray, m_Params.AverageLogLum) :
@@ -833,34 +972,41 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
         pCtx->Draw({3, DRAW_FLAG_VERIFY_ALL});
     }
 
-    if (m_UseTAA)
+    if (m_UseCopyFrame)
     {
-        HLSL::TemporalAntiAliasingAttribs TAASettings = m_Params.TAA;
+        ITextureView* pFrameSRV = m_FrameTargets->JitteredFinalColorRTV->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
 
-        if (m_ResetTAA)
+        // When the frame is upscaled, the super resolution effect replaces TAA
+        if (m_UseTAA && !m_UseUpscaling)
         {
-            TAASettings.ResetAccumulation = m_ResetTAA;
-            m_ResetTAA                    = false;
-        }
+            HLSL::TemporalAntiAliasingAttribs TAASettings = m_Params.TAA;
+
+            if (m_ResetTAA)
+            {
+                TAASettings.ResetAccumulation = m_ResetTAA;
+                m_ResetTAA                    = false;
+            }
 
-        // cameraTransformDirty is set by HnBeginFrameTask::Execute().
-        bool CameraTransformDirty = false;
-        GetTaskContextData(TaskCtx, HnRenderResourceTokens->cameraTransformDirty, CameraTransformDirty);
+            // cameraTransformDirty is set by HnBeginFrameTask::Execute().
+            bool CameraTransformDirty = false;
+            GetTaskContextData(TaskCtx, HnRenderResourceTokens->cameraTransformDirty, CameraTransformDirty);
 
-        // Skip rejection if no geometry has changed and the camera transform is not dirty.
-        // This will effectively result in full temporal supersampling for static scenes.
-        TAASettings.SkipRejection = (m_SuperSamplingSuspensionFrame == 0) && !CameraTransformDirty;
-        if (m_SuperSamplingSuspensionFrame > 0)
-            --m_SuperSamplingSuspensionFrame;
+            // Skip rejection if no geometry has changed and the camera transform is not dirty.
+            // This will effectively result in full temporal supersampling for static scenes.
+            TAASettings.SkipRejection = (m_SuperSamplingSuspensionFrame == 0) && !CameraTransformDirty;
+            if (m_SuperSamplingSuspensionFrame > 0)
+                --m_SuperSamplingSuspensionFrame;
 
-        TemporalAntiAliasing::RenderAttributes TAARenderAttribs{pDevice, pStateCache, pCtx};
-        TAARenderAttribs.pPostFXContext  = m_PostFXContext.get();
-        TAARenderAttribs.pColorBufferSRV = m_FrameTargets->JitteredFinalColorRTV->GetTexture()->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-        TAARenderAttribs.pTAAAttribs     = &TAASettings;
-        m_TAA->Execute(TAARenderAttribs);
+            TemporalAntiAliasing::RenderAttributes TAARenderAttribs{pDevice, pStateCache, pCtx};
+            TAARenderAttribs.pPostFXContext  = m_PostFXContext.get();
+            TAARenderAttribs.pColorBufferSRV = pFrameSRV;
+            TAARenderAttribs.pTAAAttribs     = &TAASettings;
+            m_TAA->Execute(TAARenderAttribs);
 
-        ITextureView* pFrameSRV = m_TAA->GetAccumulatedFrameSRV();
+            pFrameSRV = m_TAA->GetAccumulatedFrameSRV();
+        }
 
+        // Depth of field and bloom run at the render resolution
         if (m_UseDOF)
         {
             DepthOfField::RenderAttributes DOFRenderAttribs{pDevice, pStateCache, pCtx};
@@ -880,6 +1026,25 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
             BloomRenderAttribs.pColorBufferSRV = pFrameSRV;
             BloomRenderAttribs.pBloomAttribs   = &m_Params.Bloom;
             m_Bloom->Execute(BloomRenderAttribs);
+
+            pFrameSRV = m_Bloom->GetBloomTextureSRV();
+        }
+
+        if (m_UseTAA && m_UseUpscaling)
+        {
+            HLSL::SuperResolutionAttribs SRSettings = m_Params.SuperResolution;
+
+            if (m_ResetTAA)
+            {
+                SRSettings.ResetAccumulation = m_ResetTAA;
+                m_ResetTAA                   = false;
+            }
+
+            SuperResolution::RenderAttributes SRRenderAttribs{pDevice, pStateCache, pCtx};
+            SRRenderAttribs.pPostFXContext  = m_PostFXContext.get();
+            SRRenderAttribs.pColorBufferSRV = pFrameSRV;
+            SRRenderAttribs.pFSRAttribs     = &SRSettings;
+            m_SuperResolution->Execute(SRRenderAttribs);
         }
 
         ScopedDebugGroup DebugGroup{pCtx, "Copy frame"};
@@ -890,7 +1055,8 @@ void HnPostProcessTask::Execute(pxr::HdTaskContext* TaskCtx)
         pCtx->Draw({3, DRAW_FLAG_VERIFY_ALL});
     }
 
-    if (m_VectorFieldRenderer && pRenderParam->GetDebugView() == PBR_Renderer::DebugViewType::MotionVectors)
+    if (m_VectorFieldRenderer && pRenderParam->GetDebugView() == PBR_Renderer::DebugViewType::MotionVectors &&
+        m_FrameTargets->GBufferSRVs[HnFrameRenderTargets::GBUFFER_TARGET_MOTION_VECTOR] != nullptr)
     {
         ScopedDebugGroup DebugGroup{pCtx, "Motion Vector Field"};
 
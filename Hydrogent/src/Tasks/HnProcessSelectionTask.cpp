@@ -25,7 +25,12 @@
  */
 
 #include "Tasks/HnProcessSelectionTask.hpp"
+
+#include <cfloat>
+#include <cmath>
+
 #include "HnRenderDelegate.hpp"
+#include "HnMesh.hpp"
 #include "HnFrameRenderTargets.hpp"
 #include "HnTokens.hpp"
 #include "HnRenderParam.hpp"
@@ -36,6 +41,7 @@
 #include "GraphicsUtilities.h"
 #include "MapHelper.hpp"
 #include "ScopedDebugGroup.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -43,6 +49,8 @@ namespace Diligent
 namespace HLSL
 {
 
+#include "Shaders/Common/public/BasicStructures.fxh"
+#include "Shaders/PBR/public/PBR_Structures.fxh"
 #include "../shaders/HnClosestSelectedLocation.fxh"
 
 } // namespace HLSL
@@ -119,13 +127,17 @@ void HnProcessSelectionTask::PrepareTechniques(TEXTURE_FORMAT RTVFormat)
             .AddVariable(SHADER_TYPE_PIXEL, "g_SelectionDepth", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU)
             .AddVariable(SHADER_TYPE_PIXEL, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
 
+        // Passes are restricted to the selection region
+        RasterizerStateDesc RasterizerDesc = RS_SolidFillNoCull;
+        RasterizerDesc.ScissorEnable       = True;
+
         GraphicsPipelineStateCreateInfoX PsoCI;
         PsoCI
             .AddRenderTarget(RTVFormat)
             .AddShader(pVS)
             .SetResourceLayout(ResourceLauout)
             .SetDepthStencilDesc(DSS_DisableDepth)
-            .SetRasterizerDesc(RS_SolidFillNoCull)
+            .SetRasterizerDesc(RasterizerDesc)
             .SetPrimitiveTopology(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 
         if (RenderParam->GetAsyncShaderCompilation())
@@ -261,6 +273,115 @@ void HnProcessSelectionTask::PrepareSRBs(const HnFrameRenderTargets& Targets)
     }
 }
 
+void HnProcessSelectionTask::UpdateSelectionBounds(const HnRenderParam& RenderParam)
+{
+    const std::array<Uint32, 4> Versions = {
+        RenderParam.GetAttribVersion(HnRenderParam::GlobalAttrib::MeshGeometry),
+        RenderParam.GetAttribVersion(HnRenderParam::GlobalAttrib::MeshTransform),
+        RenderParam.GetAttribVersion(HnRenderParam::GlobalAttrib::MeshVisibility),
+        static_cast<const HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate())->GetRPrimUIDBound(),
+    };
+    if (m_SelectionBounds.SelectedPrimId == m_SelectedPrimId && m_SelectionBounds.Versions == Versions)
+        return;
+
+    m_SelectionBounds.SelectedPrimId = m_SelectedPrimId;
+    m_SelectionBounds.Versions       = Versions;
+    m_SelectionBounds.WorldBounds    = BoundBox::Invalid();
+    m_SelectionBounds.IsKnown        = true;
+    m_SelectionBounds.SkinnedMeshes.clear();
+    if (m_SelectedPrimId.IsEmpty())
+        return;
+
+    HnRenderDelegate*     pRenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
+    const entt::registry& Registry        = pRenderDelegate->GetEcsRegistry();
+    for (const pxr::SdfPath& RPrimId : m_RenderIndex->GetRprimSubtree(m_SelectedPrimId))
+    {
+        const HnMesh* pMesh = dynamic_cast<const HnMesh*>(m_RenderIndex->GetRprim(RPrimId));
+        if (pMesh == nullptr || !pMesh->IsVisible())
+            continue;
+
+        if (Registry.get<const HnMesh::Components::Skinning>(pMesh->GetEntity()))
+        {
+            m_SelectionBounds.SkinnedMeshes.push_back(pMesh);
+            m_SelectionBounds.IsKnown = false;
+            continue;
+        }
+
+        // Shadow caster bounds are the world-space bounds of the visible mesh
+        const BoundBox& MeshBounds = pMesh->GetShadowCasterBounds();
+        if (!MeshBounds.IsValid())
+        {
+            // The mesh extent is not known
+            m_SelectionBounds.IsKnown = false;
+            continue;
+        }
+
+        m_SelectionBounds.WorldBounds = m_SelectionBounds.WorldBounds.Combine(MeshBounds);
+    }
+}
+
+bool HnProcessSelectionTask::GetSelectionRegion(const HLSL::CameraAttribs& Camera, Uint32 Width, Uint32 Height, Rect& Region) const
+{
+    Region = Rect{0, 0, static_cast<Int32>(Width), static_cast<Int32>(Height)};
+    if (!m_SelectionBounds.IsKnown)
+        return true;
+
+    if (!m_SelectionBounds.WorldBounds.IsValid())
+        return false; // Nothing is visible
+
+    float2 MinNDC{+FLT_MAX, +FLT_MAX};
+    float2 MaxNDC{-FLT_MAX, -FLT_MAX};
+    for (Uint32 Corner = 0; Corner < 8; ++Corner)
+    {
+        const float3& Min = m_SelectionBounds.WorldBounds.Min;
+        const float3& Max = m_SelectionBounds.WorldBounds.Max;
+        const float4  ClipPos =
+            float4{
+                (Corner & 0x01) ? Max.x : Min.x,
+                (Corner & 0x02) ? Max.y : Min.y,
+                (Corner & 0x04) ? Max.z : Min.z,
+                1,
+            } *
+            Camera.mViewProj;
+        if (ClipPos.w <= 0)
+        {
+            // The box crosses the camera plane
+            return true;
+        }
+        const float2 NDC{ClipPos.x / ClipPos.w, ClipPos.y / ClipPos.w};
+        MinNDC = std::min(MinNDC, NDC);
+        MaxNDC = std::max(MaxNDC, NDC);
+    }
+
+    const bool IsGL = static_cast<const HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate())->GetDevice()->GetDeviceInfo().IsGLDevice();
+    if (IsGL)
+    {
+        // Screen-space Y axis may point either way depending on the render target,
+        // so take the union of both orientations.
+        const float MaxAbsY = std::max(std::abs(MinNDC.y), std::abs(MaxNDC.y));
+        MinNDC.y            = -MaxAbsY;
+        MaxNDC.y            = +MaxAbsY;
+    }
+
+    // Extend the region by the maximum outline distance plus one pixel to account for rasterization rules
+    const float Margin = static_cast<float>(1u << (m_NumJFIterations - 1)) + 1.f;
+
+    const float fWidth  = static_cast<float>(Width);
+    const float fHeight = static_cast<float>(Height);
+
+    const float Left   = (MinNDC.x * 0.5f + 0.5f) * fWidth - Margin;
+    const float Right  = (MaxNDC.x * 0.5f + 0.5f) * fWidth + Margin;
+    const float Top    = (0.5f - MaxNDC.y * 0.5f) * fHeight - Margin;
+    const float Bottom = (0.5f - MinNDC.y * 0.5f) * fHeight + Margin;
+
+    Region.left   = static_cast<Int32>(clamp(std::floor(Left), 0.f, fWidth));
+    Region.right  = static_cast<Int32>(clamp(std::ceil(Right), 0.f, fWidth));
+    Region.top    = static_cast<Int32>(clamp(std::floor(Top), 0.f, fHeight));
+    Region.bottom = static_cast<Int32>(clamp(std::ceil(Bottom), 0.f, fHeight));
+
+    return Region.IsValid();
+}
+
 void HnProcessSelectionTask::Prepare(pxr::HdTaskContext* TaskCtx,
                                      pxr::HdRenderIndex* RenderIndex)
 {
@@ -321,12 +442,68 @@ void HnProcessSelectionTask::Execute(pxr::HdTaskContext* TaskCtx)
         return;
     }
 
-    HnRenderDelegate* pRenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
-    IDeviceContext*   pCtx            = pRenderDelegate->GetDeviceContext();
+    HnRenderDelegate*    pRenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
+    IDeviceContext*      pCtx            = pRenderDelegate->GetDeviceContext();
+    const HnRenderParam* pRenderParam    = static_cast<const HnRenderParam*>(pRenderDelegate->GetRenderParam());
+
+    float BackgroundDepth = 1.f;
+    if (!GetTaskContextData(TaskCtx, HnRenderResourceTokens->backgroundDepth, BackgroundDepth))
+    {
+        UNEXPECTED("Background depth is not set in the task context");
+    }
+
+    HLSL::PBRFrameAttribs* pFrameAttribs = nullptr;
+    GetTaskContextData(TaskCtx, HnRenderResourceTokens->frameShaderAttribs, pFrameAttribs);
+
+    const bool IsReady = !m_SelectedPrimId.IsEmpty() && m_InitTech.IsReady() && m_UpdateTech.IsReady();
+
+    ITexture* pLocation0 = Targets->ClosestSelectedLocationRTV[0]->GetTexture();
+    ITexture* pLocation1 = Targets->ClosestSelectedLocationRTV[1]->GetTexture();
+
+    ProcessedState CurrState;
+    CurrState.SelectedPrimId  = IsReady ? m_SelectedPrimId : pxr::SdfPath{};
+    CurrState.NumJFIterations = m_NumJFIterations;
+    CurrState.Targets         = {Targets->SelectionDepthDSV->GetTexture(), pLocation0, pLocation1};
+    CurrState.TargetSize      = {pLocation0->GetDesc().Width, pLocation0->GetDesc().Height};
+    if (IsReady && pRenderParam != nullptr && pFrameAttribs != nullptr)
+    {
+        UpdateSelectionBounds(*pRenderParam);
+
+        CurrState.ViewProj   = pFrameAttribs->Camera.mViewProj;
+        CurrState.ClearDepth = BackgroundDepth;
+        CurrState.Versions   = {
+            m_SelectionBounds.Versions[0],
+            m_SelectionBounds.Versions[1],
+            m_SelectionBounds.Versions[2],
+            m_SelectionBounds.Versions[3],
+            pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::MeshMaterial),
+            pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::Material),
+        };
+        const entt::registry& Registry = pRenderDelegate->GetEcsRegistry();
+        for (const HnMesh* pMesh : m_SelectionBounds.SkinnedMeshes)
+            HashCombine(CurrState.SkinningHash, Registry.get<const HnMesh::Components::Skinning>(pMesh->GetEntity()).XformsHash);
+    }
+
+    // Selection depth may be incomplete while shaders are being compiled
+    bool RenderPassSkipped = false;
+    GetTaskContextData(TaskCtx, HnRenderResourceTokens->renderPassSkipped, RenderPassSkipped, /*Required = */ false);
+
+    bool FallBackPsoInUse = false;
+    GetTaskContextData(TaskCtx, HnRenderResourceTokens->fallBackPsoInUse, FallBackPsoInUse, /*Required = */ false);
+
+    if (m_ProcessedStateValid && CurrState == m_ProcessedState)
+    {
+        // The closest selected location from the previous frame is still valid
+        return;
+    }
+    m_ProcessedState      = CurrState;
+    m_ProcessedStateValid = (!IsReady || (pFrameAttribs != nullptr && !RenderPassSkipped && !FallBackPsoInUse));
 
     ScopedDebugGroup DebugGroup{pCtx, "Process Selection"};
 
-    if (m_SelectedPrimId.IsEmpty() || !m_InitTech.IsReady() || !m_UpdateTech.IsReady())
+    Rect Region;
+    if (!IsReady || pFrameAttribs == nullptr ||
+        !GetSelectionRegion(pFrameAttribs->Camera, CurrState.TargetSize.x, CurrState.TargetSize.y, Region))
     {
         ITextureView* pFinalRTV = Targets->ClosestSelectedLocationRTV[m_NumJFIterations % 2];
         pCtx->SetRenderTargets(1, &pFinalRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -335,18 +512,21 @@ void HnProcessSelectionTask::Execute(pxr::HdTaskContext* TaskCtx)
     }
 
     {
-        float BackgroundDepth = 1.f;
-        if (!GetTaskContextData(TaskCtx, HnRenderResourceTokens->backgroundDepth, BackgroundDepth))
-        {
-            UNEXPECTED("Background depth is not set in the task context");
-        }
-
         MapHelper<HLSL::ClosestSelectedLocationConstants> Constants{pCtx, m_ConstantsCB, MAP_WRITE, MAP_FLAG_DISCARD};
         Constants->ClearDepth = BackgroundDepth;
     }
 
     ITextureView* ClosestSelectedLocationRTVs[] = {Targets->ClosestSelectedLocationRTV[0], Targets->ClosestSelectedLocationRTV[1]};
+
+    // Pixels outside of the region must contain invalid locations
+    for (ITextureView* pRTV : ClosestSelectedLocationRTVs)
+    {
+        pCtx->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pCtx->ClearRenderTarget(pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
     pCtx->SetRenderTargets(1, ClosestSelectedLocationRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->SetScissorRects(1, &Region, CurrState.TargetSize.x, CurrState.TargetSize.y);
     pCtx->SetPipelineState(m_InitTech.PSO);
     pCtx->CommitShaderResources(m_InitTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     pCtx->Draw({3, DRAW_FLAG_VERIFY_ALL});
@@ -359,6 +539,8 @@ void HnProcessSelectionTask::Execute(pxr::HdTaskContext* TaskCtx)
         }
 
         pCtx->SetRenderTargets(1, ClosestSelectedLocationRTVs + (i + 1) % 2, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        // Setting render targets resets the scissor rects
+        pCtx->SetScissorRects(1, &Region, CurrState.TargetSize.x, CurrState.TargetSize.y);
         pCtx->SetPipelineState(m_UpdateTech.PSO);
         pCtx->CommitShaderResources(m_UpdateTech.Res[i % 2].SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         pCtx->Draw({3, DRAW_FLAG_VERIFY_ALL});
@@ -26,18 +26,38 @@
 
 #include "Tasks/HnReadRprimIdTask.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "HnRenderDelegate.hpp"
 #include "HnTokens.hpp"
+#include "HnRenderParam.hpp"
+#include "HnShaderSourceFactory.hpp"
 
 #include "DebugUtilities.hpp"
 #include "ScopedDebugGroup.hpp"
+#include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
+#include "GraphicsTypesX.hpp"
+#include "RenderStateCache.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
 
 namespace Diligent
 {
 
+namespace HLSL
+{
+
+#include "../shaders/HnCollectMeshIdsStructures.fxh"
+
+} // namespace HLSL
+
 namespace USD
 {
 
+static constexpr Uint32 CollectMeshIdsGroupSize = 8;
+
 HnReadRprimIdTask::HnReadRprimIdTask(pxr::HdSceneDelegate* ParamsDelegate, const pxr::SdfPath& Id) :
     HnTask{Id}
 {
@@ -68,12 +88,14 @@ void HnReadRprimIdTask::Prepare(pxr::HdTaskContext* TaskCtx,
     {
         HnRenderDelegate* RenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
         m_MeshIdReadBackQueue            = std::make_unique<MeshIdReadBackQueueType>(RenderDelegate->GetDevice());
+        m_RegionReadBackQueue            = std::make_unique<RegionReadBackQueueType>(RenderDelegate->GetDevice());
     }
 }
 
 void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
 {
-    m_MeshIndex = InvalidMeshIndex;
+    m_MeshIndex                  = InvalidMeshIndex;
+    m_RegionMeshIndicesAvailable = false;
 
     if (!m_Params.IsEnabled)
         return;
@@ -83,7 +105,7 @@ void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
         UNEXPECTED("Render index is null. This likely indicates that Prepare() has not been called.");
         return;
     }
-    if (m_MeshIdReadBackQueue == nullptr)
+    if (m_MeshIdReadBackQueue == nullptr || m_RegionReadBackQueue == nullptr)
     {
         UNEXPECTED("Mesh ID readback queue is null.");
         return;
@@ -94,14 +116,44 @@ void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
     ITextureView* pMeshIdRTV = GetRenderBufferTarget(*m_RenderIndex, TaskCtx, HnRenderResourceTokens->meshIdTarget);
     if (pMeshIdRTV == nullptr)
     {
-        UNEXPECTED("Mesh Id RTV is not set in the task context");
+        LOG_WARNING_MESSAGE_ONCE("Mesh Id target is not available. Make sure that the mesh ID target is not skipped in the G-buffer layout.");
         return;
     }
 
-    auto* const pMeshIdTexture = pMeshIdRTV->GetTexture();
-    const auto& MeshIdRTVDesc  = pMeshIdTexture->GetDesc();
-    if (m_Params.LocationX >= MeshIdRTVDesc.GetWidth() ||
-        m_Params.LocationY >= MeshIdRTVDesc.GetHeight())
+    // The mesh id target is smaller than the final color target when the frame is rendered at a reduced resolution
+    float2 Scale{1, 1};
+    if (ITextureView* pFinalColorRTV = GetRenderBufferTarget(*m_RenderIndex, TaskCtx, HnRenderResourceTokens->finalColorTarget))
+    {
+        const TextureDesc& MeshIdDesc     = pMeshIdRTV->GetTexture()->GetDesc();
+        const TextureDesc& FinalColorDesc = pFinalColorRTV->GetTexture()->GetDesc();
+
+        Scale.x = static_cast<float>(MeshIdDesc.GetWidth()) / static_cast<float>(FinalColorDesc.GetWidth());
+        Scale.y = static_cast<float>(MeshIdDesc.GetHeight()) / static_cast<float>(FinalColorDesc.GetHeight());
+    }
+
+    if (m_Params.Region == HN_READ_RPRIM_ID_REGION_POINT)
+        ReadPoint(pMeshIdRTV->GetTexture(), Scale);
+    else
+        ReadRegion(pMeshIdRTV->GetTexture(), Scale);
+}
+
+static MAP_FLAGS GetReadBackMapFlags(IRenderDevice* pDevice)
+{
+    // We waited for the fence, so the data should be available.
+    // However, mapping the texture on AMD with the MAP_FLAG_DO_NOT_WAIT flag
+    // still returns null.
+    return pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D11 ?
+        MAP_FLAG_NONE :
+        MAP_FLAG_DO_NOT_WAIT;
+}
+
+void HnReadRprimIdTask::ReadPoint(ITexture* pMeshIdTexture, const float2& Scale)
+{
+    const auto&  MeshIdRTVDesc = pMeshIdTexture->GetDesc();
+    const Uint32 LocationX     = static_cast<Uint32>(static_cast<float>(m_Params.LocationX) * Scale.x);
+    const Uint32 LocationY     = static_cast<Uint32>(static_cast<float>(m_Params.LocationY) * Scale.y);
+    if (LocationX >= MeshIdRTVDesc.GetWidth() ||
+        LocationY >= MeshIdRTVDesc.GetHeight())
     {
         return;
     }
@@ -115,19 +167,31 @@ void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
     while (auto pStagingTex = m_MeshIdReadBackQueue->GetFirstCompleted())
     {
         {
-            // We waited for the fence, so the texture data should be available.
-            // However, mapping the texture on AMD with the MAP_FLAG_DO_NOT_WAIT flag
-            // still returns null.
-            MAP_FLAGS MapFlags = pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D11 ?
-                MAP_FLAG_NONE :
-                MAP_FLAG_DO_NOT_WAIT;
-
             MappedTextureSubresource MappedData;
-            pCtx->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MapFlags, nullptr, MappedData);
+            pCtx->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, GetReadBackMapFlags(pDevice), nullptr, MappedData);
             if (MappedData.pData != nullptr)
             {
-                float fMeshIndex = *static_cast<const float*>(MappedData.pData);
-                m_MeshIndex      = fMeshIndex >= 0.f ? static_cast<Uint32>(fMeshIndex) : 0u;
+                switch (pStagingTex->GetDesc().Format)
+                {
+                    case TEX_FORMAT_R32_FLOAT:
+                    {
+                        float fMeshIndex = *static_cast<const float*>(MappedData.pData);
+                        m_MeshIndex      = fMeshIndex >= 0.f ? static_cast<Uint32>(fMeshIndex) : 0u;
+                        break;
+                    }
+
+                    case TEX_FORMAT_R32_UINT:
+                        m_MeshIndex = *static_cast<const Uint32*>(MappedData.pData);
+                        break;
+
+                    case TEX_FORMAT_R16_UINT:
+                        m_MeshIndex = *static_cast<const Uint16*>(MappedData.pData);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected mesh ID format");
+                        m_MeshIndex = 0;
+                }
                 pCtx->UnmapTextureSubresource(pStagingTex, 0, 0);
             }
             else
@@ -163,7 +227,7 @@ void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
     CopyTextureAttribs CopyAttribs;
     CopyAttribs.pSrcTexture = pMeshIdTexture;
     CopyAttribs.pDstTexture = pStagingTex;
-    Box SrcBox{m_Params.LocationX, m_Params.LocationX + 1, m_Params.LocationY, m_Params.LocationY + 1};
+    Box SrcBox{LocationX, LocationX + 1, LocationY, LocationY + 1};
     CopyAttribs.pSrcBox                  = &SrcBox;
     CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
     CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
@@ -171,6 +235,240 @@ void HnReadRprimIdTask::Execute(pxr::HdTaskContext* TaskCtx)
     m_MeshIdReadBackQueue->Enqueue(pCtx, std::move(pStagingTex));
 }
 
+bool HnReadRprimIdTask::PrepareRegionPSO()
+{
+    if (m_RegionPSO)
+        return true;
+
+    HnRenderDelegate* RenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
+    try
+    {
+        // RenderDeviceWithCache_E throws exceptions in case of errors
+        RenderDeviceWithCache_E Device{RenderDelegate->GetDevice(), RenderDelegate->GetRenderStateCache()};
+
+        const HnRenderParam* pRenderParam = static_cast<const HnRenderParam*>(RenderDelegate->GetRenderParam());
+        const TEXTURE_FORMAT MeshIdFormat = pRenderParam->GetMeshIdFormat();
+
+        ShaderMacroHelper Macros;
+        Macros.Add("COLLECT_MESH_IDS_GROUP_SIZE", static_cast<int>(CollectMeshIdsGroupSize));
+        Macros.Add("MESH_ID_UINT", GetTextureFormatAttribs(MeshIdFormat).ComponentType == COMPONENT_TYPE_UINT);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Macros         = Macros;
+
+        auto pHnFxCompoundSourceFactory     = HnShaderSourceFactory::CreateHnFxCompoundFactory();
+        ShaderCI.pShaderSourceStreamFactory = pHnFxCompoundSourceFactory;
+
+        RefCntAutoPtr<IShader> pCS;
+        {
+            ShaderCI.Desc       = {"Collect Mesh Ids CS", SHADER_TYPE_COMPUTE, true};
+            ShaderCI.EntryPoint = "main";
+            ShaderCI.FilePath   = "HnCollectMeshIds.csh";
+
+            pCS = Device.CreateShader(ShaderCI); // Throws an exception in case of error
+        }
+
+        PipelineResourceLayoutDescX ResourceLauout;
+        ResourceLauout
+            .SetDefaultVariableType(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+            .AddVariable(SHADER_TYPE_COMPUTE, "cbCollectMeshIdsAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+
+        ComputePipelineStateCreateInfoX PsoCI{"Collect Mesh Ids"};
+        PsoCI
+            .AddShader(pCS)
+            .SetResourceLayout(ResourceLauout);
+
+        m_RegionPSO = Device.CreateComputePipelineState(PsoCI); // Throws an exception in case of error
+    }
+    catch (const std::runtime_error& err)
+    {
+        LOG_ERROR_MESSAGE("Failed to create collect mesh ids PSO: ", err.what());
+        return false;
+    }
+
+    CreateUniformBuffer(RenderDelegate->GetDevice(), sizeof(HLSL::CollectMeshIdsAttribs), "Collect mesh ids attribs CB", &m_RegionAttribsCB);
+    VERIFY_EXPR(m_RegionAttribsCB);
+    ShaderResourceVariableX{m_RegionPSO, SHADER_TYPE_COMPUTE, "cbCollectMeshIdsAttribs"}.Set(m_RegionAttribsCB);
+
+    m_RegionPSO->CreateShaderResourceBinding(&m_RegionSRB, true);
+    VERIFY_EXPR(m_RegionSRB);
+
+    return m_RegionSRB != nullptr;
+}
+
+void HnReadRprimIdTask::PrepareRegionBuffers(Uint32 MeshIdBound, size_t NumPolygonVerts)
+{
+    IRenderDevice* pDevice = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate())->GetDevice();
+
+    auto PrepareBuffer = [pDevice](RefCntAutoPtr<IBuffer>& pBuffer, const char* Name, BUFFER_MODE Mode, BIND_FLAGS BindFlags, Uint32 ElementSize, Uint64 NumElements) {
+        const Uint64 CurrSize = pBuffer ? pBuffer->GetDesc().Size : 0;
+        if (CurrSize >= ElementSize * NumElements)
+            return;
+
+        pBuffer.Release();
+
+        BufferDesc Desc;
+        Desc.Name              = Name;
+        Desc.Size              = std::max({ElementSize * NumElements, CurrSize * 2, Uint64{ElementSize} * 64});
+        Desc.BindFlags         = BindFlags;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = Mode;
+        Desc.ElementByteStride = ElementSize;
+        pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+        VERIFY(pBuffer, "Failed to create ", Name);
+    };
+
+    PrepareBuffer(m_MeshIdBitsBuffer, "Mesh id bits", BUFFER_MODE_RAW, BIND_UNORDERED_ACCESS, sizeof(Uint32), (MeshIdBound + 31) / 32);
+    // The list can't contain more ids than MeshIdBound - 1 plus the counter
+    PrepareBuffer(m_MeshIdListBuffer, "Mesh id list", BUFFER_MODE_RAW, BIND_UNORDERED_ACCESS, sizeof(Uint32), MeshIdBound);
+    PrepareBuffer(m_PolygonBuffer, "Mesh id polygon", BUFFER_MODE_STRUCTURED, BIND_SHADER_RESOURCE, sizeof(float2), NumPolygonVerts);
+
+    if (m_MeshIdBitsBuffer)
+        m_ZeroData.resize(static_cast<size_t>(m_MeshIdBitsBuffer->GetDesc().Size / sizeof(Uint32)));
+}
+
+void HnReadRprimIdTask::ReadRegion(ITexture* pMeshIdTexture, const float2& Scale)
+{
+    HnRenderDelegate* RenderDelegate = static_cast<HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
+    IRenderDevice*    pDevice        = RenderDelegate->GetDevice();
+    IDeviceContext*   pCtx           = RenderDelegate->GetDeviceContext();
+
+    ScopedDebugGroup DebugGroup{pCtx, "Read RPrim Ids in Region"};
+
+    while (auto pStagingBuff = m_RegionReadBackQueue->GetFirstCompleted())
+    {
+        {
+            void* pData = nullptr;
+            pCtx->MapBuffer(pStagingBuff, MAP_READ, GetReadBackMapFlags(pDevice), pData);
+            if (pData != nullptr)
+            {
+                const Uint32* pIds     = static_cast<const Uint32*>(pData);
+                const Uint32  MaxCount = static_cast<Uint32>(pStagingBuff->GetDesc().Size / sizeof(Uint32)) - 1;
+                m_RegionMeshIndices.assign(pIds + 1, pIds + 1 + std::min(pIds[0], MaxCount));
+                m_RegionMeshIndicesAvailable = true;
+                pCtx->UnmapBuffer(pStagingBuff, MAP_READ);
+            }
+            else
+            {
+                UNEXPECTED("Mapped data pointer is null");
+            }
+        }
+        m_RegionReadBackQueue->Recycle(std::move(pStagingBuff));
+    }
+
+    // Compute the region bounds
+    const auto& MeshIdDesc  = pMeshIdTexture->GetDesc();
+    uint4       Rect        = m_Params.Rect;
+    Uint32      NumPolyVert = 0;
+    if (m_Params.Region == HN_READ_RPRIM_ID_REGION_POLYGON)
+    {
+        if (m_Params.Polygon.size() < 3)
+            return;
+
+        m_ScaledPolygon.resize(m_Params.Polygon.size());
+        for (size_t i = 0; i < m_Params.Polygon.size(); ++i)
+            m_ScaledPolygon[i] = m_Params.Polygon[i] * Scale;
+
+        float2 MinPos = m_ScaledPolygon[0];
+        float2 MaxPos = m_ScaledPolygon[0];
+        for (const float2& Vert : m_ScaledPolygon)
+        {
+            MinPos = std::min(MinPos, Vert);
+            MaxPos = std::max(MaxPos, Vert);
+        }
+        MinPos = std::max(MinPos, float2{0, 0});
+        MaxPos = std::max(MaxPos, float2{0, 0});
+        Rect   = uint4{
+            static_cast<Uint32>(MinPos.x),
+            static_cast<Uint32>(MinPos.y),
+            static_cast<Uint32>(std::ceil(MaxPos.x)),
+            static_cast<Uint32>(std::ceil(MaxPos.y)),
+        };
+        NumPolyVert = static_cast<Uint32>(m_ScaledPolygon.size());
+    }
+    else
+    {
+        Rect = uint4{
+            static_cast<Uint32>(static_cast<float>(Rect.x) * Scale.x),
+            static_cast<Uint32>(static_cast<float>(Rect.y) * Scale.y),
+            static_cast<Uint32>(std::ceil(static_cast<float>(Rect.z) * Scale.x)),
+            static_cast<Uint32>(std::ceil(static_cast<float>(Rect.w) * Scale.y)),
+        };
+    }
+    Rect.z = std::min(Rect.z, MeshIdDesc.GetWidth());
+    Rect.w = std::min(Rect.w, MeshIdDesc.GetHeight());
+    if (Rect.x >= Rect.z || Rect.y >= Rect.w)
+        return;
+
+    if (!PrepareRegionPSO())
+        return;
+
+    const Uint32 MeshIdBound = std::max(RenderDelegate->GetRPrimUIDBound(), 1u);
+    PrepareRegionBuffers(MeshIdBound, NumPolyVert);
+    if (!m_MeshIdBitsBuffer || !m_MeshIdListBuffer || !m_PolygonBuffer)
+        return;
+
+    const Uint64 ListSize = m_MeshIdListBuffer->GetDesc().Size;
+
+    RefCntAutoPtr<IBuffer> pStagingBuff = m_RegionReadBackQueue->GetRecycled();
+    if (pStagingBuff && pStagingBuff->GetDesc().Size != ListSize)
+    {
+        // The list buffer has been resized
+        pStagingBuff.Release();
+    }
+    if (!pStagingBuff)
+    {
+        BufferDesc StagingBuffDesc;
+        StagingBuffDesc.Name           = "Mesh ID list staging buffer";
+        StagingBuffDesc.Size           = ListSize;
+        StagingBuffDesc.Usage          = USAGE_STAGING;
+        StagingBuffDesc.BindFlags      = BIND_NONE;
+        StagingBuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        pDevice->CreateBuffer(StagingBuffDesc, nullptr, &pStagingBuff);
+        if (!pStagingBuff)
+        {
+            UNEXPECTED("Failed to create mesh ID list staging buffer");
+            return;
+        }
+    }
+
+    // Reset the bit set and the id counter
+    pCtx->UpdateBuffer(m_MeshIdBitsBuffer, 0, m_ZeroData.size() * sizeof(Uint32), m_ZeroData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->UpdateBuffer(m_MeshIdListBuffer, 0, sizeof(Uint32), m_ZeroData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (NumPolyVert > 0)
+        pCtx->UpdateBuffer(m_PolygonBuffer, 0, sizeof(float2) * NumPolyVert, m_ScaledPolygon.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    {
+        MapHelper<HLSL::CollectMeshIdsAttribs> Attribs{pCtx, m_RegionAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
+        Attribs->Rect            = Rect;
+        Attribs->NumPolygonVerts = NumPolyVert;
+        Attribs->MeshIdBound     = MeshIdBound;
+        Attribs->MaxListSize     = static_cast<Uint32>(ListSize / sizeof(Uint32)) - 1;
+    }
+
+    // Unbind render targets since the mesh id target is used as shader resource.
+    pCtx->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    ShaderResourceVariableX{m_RegionSRB, SHADER_TYPE_COMPUTE, "g_MeshId"}.Set(pMeshIdTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    ShaderResourceVariableX{m_RegionSRB, SHADER_TYPE_COMPUTE, "g_Polygon"}.Set(m_PolygonBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    ShaderResourceVariableX{m_RegionSRB, SHADER_TYPE_COMPUTE, "g_MeshIdBits"}.Set(m_MeshIdBitsBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    ShaderResourceVariableX{m_RegionSRB, SHADER_TYPE_COMPUTE, "g_MeshIdList"}.Set(m_MeshIdListBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pCtx->SetPipelineState(m_RegionPSO);
+    pCtx->CommitShaderResources(m_RegionSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->DispatchCompute({
+        (Rect.z - Rect.x + CollectMeshIdsGroupSize - 1) / CollectMeshIdsGroupSize,
+        (Rect.w - Rect.y + CollectMeshIdsGroupSize - 1) / CollectMeshIdsGroupSize,
+        1,
+    });
+
+    pCtx->CopyBuffer(m_MeshIdListBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                     pStagingBuff, 0, ListSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    m_RegionReadBackQueue->Enqueue(pCtx, std::move(pStagingBuff));
+}
+
 } // namespace USD
 
 } // namespace Diligent
@@ -36,6 +36,7 @@
 #include "BoundBoxRenderer.hpp"
 #include "DebugUtilities.hpp"
 #include "ScopedDebugGroup.hpp"
+#include "GraphicsAccessories.hpp"
 
 namespace Diligent
 {
@@ -72,7 +73,7 @@ void HnRenderBoundBoxTask::Sync(pxr::HdSceneDelegate* Delegate,
     *DirtyBits = pxr::HdChangeTracker::Clean;
 }
 
-static std::string GetBoundBoxPSMain(bool IsGL)
+static std::string GetBoundBoxPSMain(bool IsGL, bool UintMeshId)
 {
     static_assert(HnFrameRenderTargets::GBUFFER_TARGET_COUNT == 7, "Did you change the number of G-buffer targets? You may need to update the code below.");
 
@@ -91,7 +92,7 @@ void main(in BoundBoxVSOutput VSOut,
         // written to the MeshID target. To work around this issue, we use a
         // custom shader that writes 0.
         ss << ',' << std::endl
-           << "          out float4 MeshId    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID << ',' << std::endl
+           << "          out " << (UintMeshId ? "uint4 " : "float4") << " MeshId    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID << ',' << std::endl
            << "          out float4 Normal    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_NORMAL << ',' << std::endl
            << "          out float4 BaseColor : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_BASE_COLOR << ',' << std::endl
            << "          out float4 Material  : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL << ',' << std::endl
@@ -111,9 +112,9 @@ void main(in BoundBoxVSOutput VSOut,
 
     if (IsGL)
     {
-        ss << R"(
-    MeshId    = float4(0.0, 0.0, 0.0, 1.0);
-    Normal    = float4(0.0, 0.0, 1.0, 1.0);
+        ss << std::endl
+           << (UintMeshId ? "    MeshId    = uint4(0u, 0u, 0u, 1u);" : "    MeshId    = float4(0.0, 0.0, 0.0, 1.0);") << std::endl
+           << R"(    Normal    = float4(0.0, 0.0, 1.0, 1.0);
     BaseColor = float4(0.0, 0.0, 0.0, 0.0);
     Material  = float4(0.0, 0.0, 0.0, 0.0);
     IBL       = float4(0.0, 0.0, 0.0, 0.0);
@@ -180,8 +181,10 @@ void HnRenderBoundBoxTask::Prepare(pxr::HdTaskContext* TaskCtx,
                 BoundBoxRndrCI.RTVFormats[rt] = RenderPassState->GetRenderTargetFormat(rt);
             BoundBoxRndrCI.DSVFormat = RenderPassState->GetDepthStencilFormat();
 
-            const std::string PSMain = GetBoundBoxPSMain(BoundBoxRndrCI.pDevice->GetDeviceInfo().IsGLDevice() ||
-                                                         BoundBoxRndrCI.pDevice->GetDeviceInfo().IsWebGPUDevice());
+            const bool        UintMeshId = GetTextureFormatAttribs(pRenderParam->GetMeshIdFormat()).ComponentType == COMPONENT_TYPE_UINT;
+            const std::string PSMain     = GetBoundBoxPSMain(BoundBoxRndrCI.pDevice->GetDeviceInfo().IsGLDevice() ||
+                                                             BoundBoxRndrCI.pDevice->GetDeviceInfo().IsWebGPUDevice(),
+                                                         UintMeshId);
 
             BoundBoxRndrCI.PSMainSource = PSMain.c_str();
 
@@ -199,6 +202,7 @@ void HnRenderBoundBoxTask::Prepare(pxr::HdTaskContext* TaskCtx,
     Attribs.PatternLength        = m_Params.PatternLength;
     Attribs.PatternMask          = m_Params.PatternMask;
     Attribs.ComputeMotionVectors = true;
+    Attribs.ReversedDepth        = pRenderParam->GetReversedDepth();
     m_BoundBoxRenderer->Prepare(pRenderDelegate->GetDeviceContext(), Attribs);
 
     m_RenderBoundBox = true;
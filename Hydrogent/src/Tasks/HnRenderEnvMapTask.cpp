@@ -27,6 +27,7 @@
 #include "Tasks/HnRenderEnvMapTask.hpp"
 #include "HnRenderDelegate.hpp"
 #include "HnRenderPassState.hpp"
+#include "HnRenderParam.hpp"
 #include "HnFrameRenderTargets.hpp"
 #include "HnTokens.hpp"
 
@@ -35,6 +36,7 @@
 
 #include "DebugUtilities.hpp"
 #include "ScopedDebugGroup.hpp"
+#include "GraphicsAccessories.hpp"
 
 namespace Diligent
 {
@@ -80,7 +82,7 @@ void HnRenderEnvMapTask::Sync(pxr::HdSceneDelegate* Delegate,
     *DirtyBits = pxr::HdChangeTracker::Clean;
 }
 
-static std::string GetEnvMapPSMain(bool WriteAllTargets)
+static std::string GetEnvMapPSMain(bool WriteAllTargets, bool UintMeshId)
 {
     static_assert(HnFrameRenderTargets::GBUFFER_TARGET_COUNT == 7, "Did you change the number of G-buffer targets? You may need to update the code below.");
 
@@ -95,7 +97,7 @@ void main(in  float4 Pos       : SV_Position,
     if (WriteAllTargets)
     {
         ss << ',' << std::endl
-           << "          out float4 MeshId    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID << ',' << std::endl
+           << "          out " << (UintMeshId ? "uint4 " : "float4") << " MeshId    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MESH_ID << ',' << std::endl
            << "          out float4 Normal    : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_NORMAL << ',' << std::endl
            << "          out float4 BaseColor : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_BASE_COLOR << ',' << std::endl
            << "          out float4 Material  : SV_Target" << HnFrameRenderTargets::GBUFFER_TARGET_MATERIAL << ',' << std::endl
@@ -112,9 +114,9 @@ void main(in  float4 Pos       : SV_Position,
 
     if (WriteAllTargets)
     {
-        ss << R"(
-    MeshId    = float4(0.0, 0.0, 0.0, 1.0);
-    Normal    = float4(0.0, 0.0, 0.0, 0.0);
+        ss << std::endl
+           << (UintMeshId ? "    MeshId    = uint4(0u, 0u, 0u, 1u);" : "    MeshId    = float4(0.0, 0.0, 0.0, 1.0);") << std::endl
+           << R"(    Normal    = float4(0.0, 0.0, 0.0, 0.0);
     BaseColor = float4(0.0, 0.0, 0.0, 0.0);
     Material  = float4(0.0, 0.0, 0.0, 0.0);
     IBL       = float4(0.0, 0.0, 0.0, 0.0);
@@ -146,9 +148,13 @@ void HnRenderEnvMapTask::Prepare(pxr::HdTaskContext* TaskCtx,
                 EnvMapRndrCI.RTVFormats[rt] = RenderPassState->GetRenderTargetFormat(rt);
             EnvMapRndrCI.DSVFormat = RenderPassState->GetDepthStencilFormat();
 
+            const HnRenderParam* pRenderParam = static_cast<const HnRenderParam*>(pRenderDelegate->GetRenderParam());
+            const bool           UintMeshId   = pRenderParam != nullptr && GetTextureFormatAttribs(pRenderParam->GetMeshIdFormat()).ComponentType == COMPONENT_TYPE_UINT;
+
             const std::string PSMain = GetEnvMapPSMain(EnvMapRndrCI.pDevice->GetDeviceInfo().IsGLDevice() ||
-                                                       EnvMapRndrCI.pDevice->GetDeviceInfo().IsVulkanDevice() ||
-                                                       EnvMapRndrCI.pDevice->GetDeviceInfo().IsWebGPUDevice());
+                                                           EnvMapRndrCI.pDevice->GetDeviceInfo().IsVulkanDevice() ||
+                                                           EnvMapRndrCI.pDevice->GetDeviceInfo().IsWebGPUDevice(),
+                                                       UintMeshId);
 
             EnvMapRndrCI.PSMainSource = PSMain.c_str();
 
@@ -187,6 +193,10 @@ void HnRenderEnvMapTask::Prepare(pxr::HdTaskContext* TaskCtx,
     // We should write zero alpha to get correct alpha in the final image
     EnvMapAttribs.Alpha                = 0;
     EnvMapAttribs.ComputeMotionVectors = true;
+    if (const HnRenderParam* pRenderParam = static_cast<const HnRenderParam*>(pRenderDelegate->GetRenderParam()))
+    {
+        EnvMapAttribs.ReversedDepth = pRenderParam->GetReversedDepth();
+    }
 
     m_EnvMapRenderer->Prepare(pRenderDelegate->GetDeviceContext(), EnvMapAttribs, TMAttribs);
 }
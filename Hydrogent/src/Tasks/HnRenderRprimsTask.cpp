@@ -133,6 +133,8 @@ void HnRenderRprimsTask::Execute(pxr::HdTaskContext* TaskCtx)
             HnRenderPass::EXECUTE_RESULT Result = m_RenderPass->Execute(*RenderPassState, GetRenderTags());
             if (Result == HnRenderPass::EXECUTE_RESULT_FALLBACK)
                 (*TaskCtx)[HnRenderResourceTokens->fallBackPsoInUse] = pxr::VtValue{true};
+            else if (Result == HnRenderPass::EXECUTE_RESULT_SKIPPED)
+                (*TaskCtx)[HnRenderResourceTokens->renderPassSkipped] = pxr::VtValue{true};
         }
         else
         {
@@ -31,6 +31,7 @@
 #include "HnRenderPass.hpp"
 #include "HnRenderParam.hpp"
 #include "HnLight.hpp"
+#include "HnCamera.hpp"
 #include "HnShadowMapManager.hpp"
 #include "CommonlyUsedStates.h"
 #include "GraphicsUtilities.h"
@@ -100,6 +101,8 @@ void HnRenderShadowsTask::Sync(pxr::HdSceneDelegate* Delegate,
         HnRenderShadowsTaskParams Params;
         if (GetTaskParams(Delegate, Params))
         {
+            m_Params = Params;
+
             m_RPState.SetDepthBias(Params.State.DepthBias, Params.State.SlopeScaledDepthBias);
             m_RPState.SetDepthFunc(Params.State.DepthFunc);
             m_RPState.SetDepthBiasEnabled(Params.State.DepthBiasEnabled);
@@ -220,12 +223,25 @@ void HnRenderShadowsTask::PrepareClearDepthVB(const HnRenderDelegate& RenderDele
     RenderDelegate.GetDeviceContext()->TransitionResourceStates(1, &Barrier);
 }
 
+bool HnRenderShadowsTask::IsShadowFrustumAffected(const HnLight& Light, Uint32 Cascade, bool IsGL) const
+{
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(Light.GetCascadeViewProjMatrix(Cascade), Frustum, IsGL);
+    for (const BoundBox& Bounds : m_DirtyShadowCasterBounds)
+    {
+        // Geometry in front of the near plane may still cast shadows when depth clamping is enabled
+        if (GetBoxVisibility(Frustum, Bounds, FRUSTUM_PLANE_FLAG_OPEN_NEAR) != BoxVisibility::Invisible)
+            return true;
+    }
+    return false;
+}
+
 void HnRenderShadowsTask::Prepare(pxr::HdTaskContext* TaskCtx,
                                   pxr::HdRenderIndex* RenderIndex)
 {
     m_RenderIndex = RenderIndex;
 
-    m_LightsByShadowSlice.clear();
+    m_CascadesByShadowSlice.clear();
 
     const HnRenderDelegate* RenderDelegate = static_cast<const HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
     const HnRenderParam*    pRenderParam   = static_cast<const HnRenderParam*>(RenderDelegate->GetRenderParam());
@@ -241,43 +257,61 @@ void HnRenderShadowsTask::Prepare(pxr::HdTaskContext* TaskCtx,
     PrepareClearDepthPSO(*RenderDelegate);
     PrepareClearDepthVB(*RenderDelegate);
 
-    const Uint32 GeometryVersion =
-        (pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::GeometrySubsetDrawItems) +
-         pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::MeshGeometry) +
-         pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::MeshTransform) +
-         pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::MeshVisibility) +
-         pRenderParam->GetAttribVersion(HnRenderParam::GlobalAttrib::MeshMaterial));
-    static_assert(static_cast<int>(HnRenderParam::GlobalAttrib::Count) == 9, "Please update the code above to handle the new attribute, if necessary.");
+    // Regions of the scene where shadow-casting geometry has changed since the last frame
+    const bool AffectedRegionKnown = pRenderParam->ExtractDirtyShadowCasterBounds(m_DirtyShadowCasterBounds);
+    const bool GeometryChanged     = !AffectedRegionKnown || !m_DirtyShadowCasterBounds.empty();
+
+    const bool IsGL = RenderDelegate->GetDevice()->GetDeviceInfo().NDC.MinZ == -1;
 
-    bool GeometryChanged  = m_LastGeometryVersion != GeometryVersion;
-    m_LastGeometryVersion = GeometryVersion;
+    const HnCamera* pCamera = nullptr;
+    GetTaskContextData(TaskCtx, HnRenderResourceTokens->camera, pCamera);
+
+    HnLight::ShadowCascadeUpdateInfo CascadeUpdateInfo;
+    if (pCamera != nullptr)
+    {
+        CascadeUpdateInfo.pCameraView = &pCamera->GetViewMatrix();
+        CascadeUpdateInfo.pCameraProj = &pCamera->GetProjectionMatrix();
+    }
+    CascadeUpdateInfo.FrameNumber                   = pRenderParam->GetFrameNumber();
+    CascadeUpdateInfo.DistantCascadeUpdateInterval  = m_Params.DistantCascadeUpdateInterval;
+    CascadeUpdateInfo.DistantCascadeMaxCameraOffset = m_Params.DistantCascadeMaxCameraOffset;
+    CascadeUpdateInfo.PartitioningFactor            = m_Params.CascadePartitioningFactor;
+    CascadeUpdateInfo.IsGL                          = IsGL;
 
     const auto& Lights = RenderDelegate->GetLights();
 
-    // Sort all shadow lights with dirty shadow maps by shadow map slice
+    // Sort all dirty shadow cascades by shadow map slice
     for (HnLight* Light : Lights)
     {
         if (!Light->ShadowsEnabled())
             continue;
 
-        if (GeometryChanged)
+        if (pCamera != nullptr && Light->IsVisible())
         {
-            // Make shadow map dirty even if the light is disabled so that
-            // when it is enabled, the shadow map will be updated.
-            Light->SetShadowMapDirty(true);
+            // Cascades whose projection has changed are marked dirty
+            Light->UpdateShadowCascades(CascadeUpdateInfo);
         }
 
-        if (!Light->IsShadowMapDirty())
-            continue;
+        const Int32 ShadowCatingLightId = Light->GetFrameAttribsIndex();
+        for (Uint32 Cascade = 0; Cascade < Light->GetNumShadowCascades(); ++Cascade)
+        {
+            if (GeometryChanged && !Light->IsShadowCascadeDirty(Cascade))
+            {
+                // Only update the shadow map if the changed geometry intersects the cascade's shadow frustum.
+                // Make shadow map dirty even if the light is disabled so that
+                // when it is enabled, the shadow map will be updated.
+                if (!AffectedRegionKnown || IsShadowFrustumAffected(*Light, Cascade, IsGL))
+                    Light->SetShadowCascadeDirty(Cascade, true);
+            }
 
-        Int32 ShadowCatingLightId = Light->GetFrameAttribsIndex();
-        if (ShadowCatingLightId < 0)
-            continue;
+            if (!Light->IsShadowCascadeDirty(Cascade) || ShadowCatingLightId < 0)
+                continue;
 
-        VERIFY(Light->IsVisible(), "Invisible lights should not be assigned shadow casting light index");
+            VERIFY(Light->IsVisible(), "Invisible lights should not be assigned shadow casting light index");
 
-        ITextureAtlasSuballocation* pAtlasRegion = Light->GetShadowMapSuballocation();
-        m_LightsByShadowSlice.emplace(pAtlasRegion->GetSlice(), Light);
+            ITextureAtlasSuballocation* pAtlasRegion = Light->GetShadowMapSuballocation(Cascade);
+            m_CascadesByShadowSlice.emplace(pAtlasRegion->GetSlice(), ShadowCascadeInfo{Light, Cascade});
+        }
     }
 }
 
@@ -289,7 +323,7 @@ void HnRenderShadowsTask::Execute(pxr::HdTaskContext* TaskCtx)
         return;
     }
 
-    if (m_LightsByShadowSlice.empty())
+    if (m_CascadesByShadowSlice.empty())
         return;
 
     const HnRenderDelegate*   RenderDelegate = static_cast<const HnRenderDelegate*>(m_RenderIndex->GetRenderDelegate());
@@ -307,17 +341,18 @@ void HnRenderShadowsTask::Execute(pxr::HdTaskContext* TaskCtx)
     const RenderDeviceInfo& DeviceInfo = pDevice->GetDeviceInfo();
 
     int LastSlice = -1;
-    for (const auto it : m_LightsByShadowSlice)
+    for (const auto it : m_CascadesByShadowSlice)
     {
-        Uint32   Slice = it.first;
-        HnLight* Light = it.second;
-        VERIFY_EXPR(Light->ShadowsEnabled() && Light->IsShadowMapDirty());
+        Uint32       Slice   = it.first;
+        HnLight*     Light   = it.second.Light;
+        const Uint32 Cascade = it.second.Cascade;
+        VERIFY_EXPR(Light->ShadowsEnabled() && Light->IsShadowCascadeDirty(Cascade));
 
         Int32 ShadowCatingLightId = Light->GetFrameAttribsIndex();
         VERIFY_EXPR(ShadowCatingLightId >= 0);
-        m_RPState.SetFrameAttribsSRB(RenderDelegate->GetShadowPassFrameAttribsSRB(ShadowCatingLightId));
+        m_RPState.SetFrameAttribsSRB(RenderDelegate->GetShadowPassFrameAttribsSRB(ShadowCatingLightId + Cascade));
 
-        ITextureAtlasSuballocation* pAtlasRegion = Light->GetShadowMapSuballocation();
+        ITextureAtlasSuballocation* pAtlasRegion = Light->GetShadowMapSuballocation(Cascade);
         VERIFY_EXPR(pAtlasRegion->GetSlice() == Slice);
         VERIFY(static_cast<int>(Slice) >= LastSlice, "Shadow map slices must be sorted in ascending order");
 
@@ -351,7 +386,7 @@ void HnRenderShadowsTask::Execute(pxr::HdTaskContext* TaskCtx)
 
         if (m_RenderPass->Execute(m_RPState, GetRenderTags()) == HnRenderPass::EXECUTE_RESULT_OK)
         {
-            Light->SetShadowMapDirty(false);
+            Light->SetShadowCascadeDirty(Cascade, false);
         }
     }
 }
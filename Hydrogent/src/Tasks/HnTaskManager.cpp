@@ -72,6 +72,59 @@ TF_DEFINE_PRIVATE_TOKENS(
 );
 // clang-format on
 
+// Forwards all calls to the wrapped task and measures the time of its Prepare() and Execute() methods.
+class HnProfiledTask final : public pxr::HdTask
+{
+public:
+    HnProfiledTask(pxr::HdTaskSharedPtr Task,
+                   HnTaskProfiler&      Profiler,
+                   IDeviceContext*      pCtx,
+                   bool                 IsFirstTask) :
+        pxr::HdTask{Task->GetId()},
+        m_Task{std::move(Task)},
+        m_Profiler{Profiler},
+        m_pCtx{pCtx},
+        m_IsFirstTask{IsFirstTask}
+    {
+    }
+
+    virtual void Sync(pxr::HdSceneDelegate* Delegate,
+                      pxr::HdTaskContext*   TaskCtx,
+                      pxr::HdDirtyBits*     DirtyBits) override final
+    {
+        m_Task->Sync(Delegate, TaskCtx, DirtyBits);
+    }
+
+    virtual void Prepare(pxr::HdTaskContext* TaskCtx,
+                         pxr::HdRenderIndex* RenderIndex) override final
+    {
+        if (m_IsFirstTask)
+            m_Profiler.BeginFrame();
+
+        m_Profiler.BeginPrepare(GetId());
+        m_Task->Prepare(TaskCtx, RenderIndex);
+        m_Profiler.EndPrepare();
+    }
+
+    virtual void Execute(pxr::HdTaskContext* TaskCtx) override final
+    {
+        m_Profiler.BeginExecute(GetId(), m_pCtx);
+        m_Task->Execute(TaskCtx);
+        m_Profiler.EndExecute(m_pCtx);
+    }
+
+    virtual const pxr::TfTokenVector& GetRenderTags() const override final
+    {
+        return m_Task->GetRenderTags();
+    }
+
+private:
+    const pxr::HdTaskSharedPtr m_Task;
+    HnTaskProfiler&            m_Profiler;
+    IDeviceContext* const      m_pCtx;
+    const bool                 m_IsFirstTask;
+};
+
 } // namespace
 
 
@@ -428,6 +481,16 @@ const pxr::HdTaskSharedPtrVector HnTaskManager::GetTasks(const std::vector<TaskU
         Tasks.push_back(m_RenderIndex.GetTask(it->second.Id));
     }
 
+    HnTaskProfiler& Profiler = GetTaskProfiler();
+    if (Profiler.IsEnabled())
+    {
+        IDeviceContext* pCtx = static_cast<HnRenderDelegate*>(m_RenderIndex.GetRenderDelegate())->GetDeviceContext();
+        for (size_t i = 0; i < Tasks.size(); ++i)
+        {
+            Tasks[i] = std::make_shared<HnProfiledTask>(std::move(Tasks[i]), Profiler, pCtx, i == 0);
+        }
+    }
+
     return Tasks;
 }
 
@@ -485,6 +548,32 @@ const pxr::SdfPath* HnTaskManager::GetSelectedRPrimId() const
     }
 }
 
+bool HnTaskManager::GetSelectedRPrimIds(pxr::SdfPathSet& RPrimIds) const
+{
+    RPrimIds.clear();
+
+    pxr::HdTaskSharedPtr pReadRprimIdTask = GetTask(TaskUID_ReadRprimId);
+    if (!pReadRprimIdTask)
+        return false;
+
+    const HnReadRprimIdTask&   ReadRprimIdTask = static_cast<const HnReadRprimIdTask&>(*pReadRprimIdTask);
+    const std::vector<Uint32>* pMeshIndices    = ReadRprimIdTask.GetRegionMeshIndices();
+    if (pMeshIndices == nullptr)
+    {
+        // Data is not yet available
+        return false;
+    }
+
+    const HnRenderDelegate* pRenderDelegate = static_cast<const HnRenderDelegate*>(GetRenderIndex().GetRenderDelegate());
+    for (Uint32 MeshIdx : *pMeshIndices)
+    {
+        if (const pxr::SdfPath* rPRimId = pRenderDelegate->GetRPrimId(MeshIdx))
+            RPrimIds.insert(*rPRimId);
+    }
+
+    return true;
+}
+
 void HnTaskManager::EnableTask(TaskUID UID, bool Enable)
 {
     auto it = m_TaskInfo.find(UID);
@@ -619,6 +708,28 @@ void HnTaskManager::SuspendSuperSampling()
     }
 }
 
+HnTaskProfiler& HnTaskManager::GetTaskProfiler() const
+{
+    return static_cast<HnRenderDelegate*>(m_RenderIndex.GetRenderDelegate())->GetTaskProfiler();
+}
+
+void HnTaskManager::EnableProfiling(bool Enable, Uint32 NumFramesToAverage)
+{
+    HnTaskProfiler& Profiler = GetTaskProfiler();
+    Profiler.SetNumFramesToAverage(NumFramesToAverage);
+    Profiler.SetEnabled(Enable);
+}
+
+bool HnTaskManager::IsProfilingEnabled() const
+{
+    return GetTaskProfiler().IsEnabled();
+}
+
+const std::vector<HnTaskProfile>& HnTaskManager::GetTaskProfile() const
+{
+    return GetTaskProfiler().GetProfile();
+}
+
 } // namespace USD
 
 } // namespace Diligent
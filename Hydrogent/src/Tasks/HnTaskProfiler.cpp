@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "Tasks/HnTaskProfiler.hpp"
+
+#include "DurationQueryHelper.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace USD
+{
+
+// Query results are typically available after two or three frames
+static constexpr Uint32 NumGPUQueriesToBuffer = 4;
+
+HnTaskProfiler::TaskData::TaskData()
+{
+}
+
+HnTaskProfiler::TaskData::~TaskData()
+{
+}
+
+HnTaskProfiler::HnTaskProfiler(IRenderDevice* pDevice) :
+    m_pDevice{pDevice},
+    m_TimestampQueriesSupported{pDevice->GetDeviceInfo().Features.TimestampQueries == DEVICE_FEATURE_STATE_ENABLED}
+{
+}
+
+HnTaskProfiler::~HnTaskProfiler()
+{
+}
+
+void HnTaskProfiler::SetEnabled(bool Enabled)
+{
+    if (m_Enabled == Enabled)
+        return;
+
+    m_Enabled = Enabled;
+
+    // Discard the results collected in the previous profiling session
+    m_Tasks.clear();
+    m_FrameTaskOrder.clear();
+    m_Profile.clear();
+    m_NumFramesAveraged = 0;
+    m_CurrentTask       = nullptr;
+}
+
+HnTaskProfiler::TaskData& HnTaskProfiler::GetTaskData(const pxr::SdfPath& TaskId)
+{
+    TaskData& Data = m_Tasks[TaskId];
+    if (Data.Totals.TaskId.IsEmpty())
+    {
+        Data.Totals.TaskId = TaskId;
+        if (m_TimestampQueriesSupported)
+        {
+            Data.GPUTimer = std::make_unique<DurationQueryHelper>(m_pDevice, NumGPUQueriesToBuffer);
+        }
+    }
+    return Data;
+}
+
+void HnTaskProfiler::BeginFrame()
+{
+    if (!m_Enabled)
+        return;
+
+    VERIFY(m_CurrentTask == nullptr, "Task ", m_CurrentTask->Totals.TaskId, " has not been ended");
+    if (!m_FrameTaskOrder.empty())
+    {
+        ++m_NumFramesAveraged;
+        if (m_NumFramesAveraged >= m_NumFramesToAverage)
+        {
+            UpdateProfile();
+        }
+    }
+    m_FrameTaskOrder.clear();
+}
+
+void HnTaskProfiler::UpdateProfile()
+{
+    m_Profile.clear();
+    m_Profile.reserve(m_FrameTaskOrder.size());
+    for (const pxr::SdfPath& TaskId : m_FrameTaskOrder)
+    {
+        auto it = m_Tasks.find(TaskId);
+        if (it == m_Tasks.end())
+        {
+            UNEXPECTED("Task ", TaskId, " is not found");
+            continue;
+        }
+
+        const TaskData& Data = it->second;
+
+        HnTaskProfile Profile;
+        Profile.TaskId = TaskId;
+        if (Data.NumPrepareSamples > 0)
+        {
+            Profile.PrepareCPUTime = Data.Totals.PrepareCPUTime / Data.NumPrepareSamples;
+        }
+        if (Data.NumExecuteSamples > 0)
+        {
+            Profile.ExecuteCPUTime = Data.Totals.ExecuteCPUTime / Data.NumExecuteSamples;
+
+            const HnRenderPassStats& Totals = Data.Totals.RenderPassStats;
+            Profile.RenderPassStats.NumDrawCalls   = Totals.NumDrawCalls / Data.NumExecuteSamples;
+            Profile.RenderPassStats.NumPSOChanges  = Totals.NumPSOChanges / Data.NumExecuteSamples;
+            Profile.RenderPassStats.NumSRBCommits  = Totals.NumSRBCommits / Data.NumExecuteSamples;
+            Profile.RenderPassStats.NumBytesMapped = Totals.NumBytesMapped / Data.NumExecuteSamples;
+        }
+        if (Data.NumGPUSamples > 0)
+        {
+            Profile.ExecuteGPUTime = Data.Totals.ExecuteGPUTime / Data.NumGPUSamples;
+        }
+        m_Profile.emplace_back(std::move(Profile));
+    }
+
+    for (auto& it : m_Tasks)
+    {
+        TaskData& Data = it.second;
+
+        const pxr::SdfPath TaskId = Data.Totals.TaskId;
+        Data.Totals               = {};
+        Data.Totals.TaskId        = TaskId;
+        Data.NumPrepareSamples    = 0;
+        Data.NumExecuteSamples    = 0;
+        Data.NumGPUSamples        = 0;
+    }
+    m_NumFramesAveraged = 0;
+}
+
+void HnTaskProfiler::BeginPrepare(const pxr::SdfPath& TaskId)
+{
+    if (!m_Enabled)
+        return;
+
+    m_CurrentTask = &GetTaskData(TaskId);
+    m_FrameTaskOrder.push_back(TaskId);
+    m_StartTime = m_Timer.GetElapsedTime();
+}
+
+void HnTaskProfiler::EndPrepare()
+{
+    if (m_CurrentTask == nullptr)
+        return;
+
+    m_CurrentTask->Totals.PrepareCPUTime += (m_Timer.GetElapsedTime() - m_StartTime) * 1000.0;
+    ++m_CurrentTask->NumPrepareSamples;
+    m_CurrentTask = nullptr;
+}
+
+void HnTaskProfiler::BeginExecute(const pxr::SdfPath& TaskId, IDeviceContext* pCtx)
+{
+    if (!m_Enabled)
+        return;
+
+    m_CurrentTask = &GetTaskData(TaskId);
+    if (m_CurrentTask->GPUTimer)
+    {
+        m_CurrentTask->GPUTimer->Begin(pCtx);
+    }
+    m_StartTime = m_Timer.GetElapsedTime();
+}
+
+void HnTaskProfiler::EndExecute(IDeviceContext* pCtx)
+{
+    if (m_CurrentTask == nullptr)
+        return;
+
+    m_CurrentTask->Totals.ExecuteCPUTime += (m_Timer.GetElapsedTime() - m_StartTime) * 1000.0;
+    ++m_CurrentTask->NumExecuteSamples;
+
+    if (m_CurrentTask->GPUTimer)
+    {
+        // The helper returns the duration of one of the previous queries that has completed,
+        // or false if no results are available yet.
+        double Duration = 0;
+        if (m_CurrentTask->GPUTimer->End(pCtx, Duration))
+        {
+            m_CurrentTask->Totals.ExecuteGPUTime += Duration * 1000.0;
+            ++m_CurrentTask->NumGPUSamples;
+        }
+    }
+
+    m_CurrentTask = nullptr;
+}
+
+void HnTaskProfiler::AddRenderPassStats(const HnRenderPassStats& Stats)
+{
+    if (m_CurrentTask == nullptr)
+        return;
+
+    m_CurrentTask->Totals.RenderPassStats += Stats;
+}
+
+} // namespace USD
+
+} // namespace Diligent
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
+#include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
+#include "../../../DiligentCore/Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+namespace HLSL
+{
+struct CameraAttribs;
+struct PBRLightAttribs;
+struct PBRRendererShaderParameters;
+} // namespace HLSL
+
+/// Clustered light culling grid.
+///
+/// The grid splits the camera frustum into GridSize.x * GridSize.y screen-space tiles and
+/// GridSize.z depth slices distributed logarithmically between the near and far planes.
+/// Point and spot lights are binned into the clusters on the CPU, and the results are
+/// uploaded into the following structured buffers:
+///   - g_ClusteredLights     - attributes of all clustered lights (PBRLightAttribs)
+///   - g_LightClusters       - light list of every cluster (uint2: offset, count)
+///   - g_ClusterLightIndices - indices of the lights in every cluster
+///
+/// The pixel shader only iterates over the lights in its cluster.
+class ClusteredLightGrid
+{
+public:
+    struct CreateInfo
+    {
+        /// Number of clusters along the X, Y and Z axes.
+        uint3 GridSize = {16, 8, 24};
+
+        /// The maximum number of lights.
+        Uint32 MaxLightCount = 1024;
+
+        /// The maximum total number of light indices in all clusters.
+        /// If zero, 32 indices per cluster will be reserved.
+        Uint32 MaxLightIndexCount = 0;
+    };
+    /// Creates the grid.
+    ///
+    /// \param [in] pDevice - Render device used to create the GPU buffers.
+    ///                       If null, no buffers are created and the grid can only be used
+    ///                       to bin the lights on the CPU (see BinLights()).
+    /// \param [in] CI      - Grid create info.
+    ClusteredLightGrid(IRenderDevice* pDevice, const CreateInfo& CI);
+    ~ClusteredLightGrid();
+
+    // clang-format off
+    ClusteredLightGrid           (const ClusteredLightGrid&)  = delete;
+    ClusteredLightGrid           (      ClusteredLightGrid&&) = delete;
+    ClusteredLightGrid& operator=(const ClusteredLightGrid&)  = delete;
+    ClusteredLightGrid& operator=(      ClusteredLightGrid&&) = delete;
+    // clang-format on
+
+    /// Bins the lights into the clusters and uploads the data to the GPU.
+    ///
+    /// \param [in]  pCtx      - Device context.
+    /// \param [in]  Camera    - Camera attributes. The view-projection matrix as well as the
+    ///                          near and far planes must be the same as those used for rendering.
+    ///                          The matrices must not be transposed.
+    /// \param [in]  pLights   - Point and spot light attributes. Every light must have finite range.
+    /// \param [in]  NumLights - Number of lights.
+    /// \param [out] Renderer  - Renderer shader parameters where the cluster depth slice
+    ///                          parameters will be written.
+    ///
+    /// \remarks    Lights that exceed the MaxLightCount limit are ignored, as well as the lights that
+    ///             don't fit into the MaxLightIndexCount limit. A warning is logged the first time this happens,
+    ///             and the number of ignored lights and indices in the last update is returned by
+    ///             GetNumDroppedLights() and GetNumDroppedLightIndices().
+    void Update(IDeviceContext*                    pCtx,
+                const HLSL::CameraAttribs&         Camera,
+                const HLSL::PBRLightAttribs*       pLights,
+                Uint32                             NumLights,
+                HLSL::PBRRendererShaderParameters& Renderer);
+
+    /// Bins the lights into the clusters on the CPU without uploading the data to the GPU.
+    ///
+    /// \remarks    The parameters are the same as in Update().
+    ///             The results can be accessed with GetClusters() and GetLightIndices().
+    void BinLights(const HLSL::CameraAttribs&         Camera,
+                   const HLSL::PBRLightAttribs*       pLights,
+                   Uint32                             NumLights,
+                   HLSL::PBRRendererShaderParameters& Renderer);
+
+    /// Returns the index of the cluster that contains the given world-space position.
+    ///
+    /// \remarks    This is the CPU counterpart of GetLightClusterIndex() in the PBR pixel shader.
+    ///             The camera must be the same as the one used to bin the lights.
+    Uint32 GetClusterIndex(const float3& WorldPos, const HLSL::CameraAttribs& Camera) const;
+
+    // clang-format off
+    const uint3& GetGridSize()          const { return m_GridSize; }
+    Uint32       GetMaxLightCount()     const { return m_MaxLightCount; }
+    IBufferView* GetLightsSRV()         const { return m_LightsSRV; }
+    IBufferView* GetClustersSRV()       const { return m_ClustersSRV; }
+    IBufferView* GetLightIndicesSRV()   const { return m_LightIndicesSRV; }
+
+    // The number of lights that exceeded MaxLightCount and the number of cluster light
+    // indices that did not fit into MaxLightIndexCount in the last update.
+    Uint32 GetNumDroppedLights()       const { return m_NumDroppedLights; }
+    Uint32 GetNumDroppedLightIndices() const { return m_NumDroppedLightIndices; }
+
+    const std::vector<uint2>&  GetClusters()     const { return m_Clusters; }
+    const std::vector<Uint32>& GetLightIndices() const { return m_LightIndices; }
+    // clang-format on
+
+private:
+    const uint3  m_GridSize;
+    const Uint32 m_MaxLightCount;
+    const Uint32 m_MaxLightIndexCount;
+
+    RefCntAutoPtr<IBufferView> m_LightsSRV;
+    RefCntAutoPtr<IBufferView> m_ClustersSRV;
+    RefCntAutoPtr<IBufferView> m_LightIndicesSRV;
+
+    Uint32 m_NumLights              = 0;
+    Uint32 m_NumDroppedLights       = 0;
+    Uint32 m_NumDroppedLightIndices = 0;
+    float  m_ZScale                 = 0;
+    float  m_ZBias                  = 0;
+
+    // Cluster ranges covered by each light: min.xyz, max.xyz
+    std::vector<std::pair<uint3, uint3>> m_LightClusterRanges;
+    // x - offset in the light index list, y - light count
+    std::vector<uint2>  m_Clusters;
+    std::vector<Uint32> m_LightIndices;
+};
+
+} // namespace Diligent
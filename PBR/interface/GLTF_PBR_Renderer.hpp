@@ -274,6 +274,8 @@ public:
         // This value is used to scale the point and spot light's range (by s) and intensity (by s^2).
         float DistanceScale  = 1.f;
         int   ShadowMapIndex = -1;
+        // Number of shadow cascades starting at ShadowMapIndex.
+        int NumShadowCascades = 1;
     };
     static void WritePBRLightShaderAttribs(const PBRLightShaderAttribsData& AttribsData,
                                            HLSL::PBRLightAttribs*           pShaderAttribs);
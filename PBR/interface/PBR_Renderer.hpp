@@ -30,6 +30,8 @@
 #include <unordered_set>
 #include <functional>
 #include <array>
+#include <memory>
+#include <string>
 
 #include "../../../DiligentCore/Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
@@ -39,6 +41,7 @@
 #include "../../../DiligentCore/Graphics/GraphicsTools/interface/ShaderMacroHelper.hpp"
 #include "../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../DiligentCore/Common/interface/HashUtils.hpp"
+#include "ClusteredLightGrid.hpp"
 
 namespace Diligent
 {
@@ -48,6 +51,8 @@ namespace HLSL
 struct PBRRendererShaderParameters;
 } // namespace HLSL
 
+class TextureCacheWriter;
+
 class PBR_Renderer
 {
 public:
@@ -63,6 +68,7 @@ public:
         VERTEX_ATTRIB_ID_WEIGHTS,
         VERTEX_ATTRIB_ID_COLOR,
         VERTEX_ATTRIB_ID_TANGENT,
+        VERTEX_ATTRIB_ID_PREV_POSITION,
         VERTEX_ATTRIB_ID_COUNT
     };
 
@@ -118,6 +124,24 @@ public:
         SHADER_TEXTURE_ARRAY_MODE_DYNAMIC
     };
 
+    /// Joint transform format in the cbJointTransforms buffer.
+    enum JOINTS_FORMAT : Uint8
+    {
+        /// Every joint transform is a full 4x4 matrix (64 bytes).
+        JOINTS_FORMAT_MATRIX4X4 = 0,
+
+        /// Every joint transform is a 3x4 affine matrix (48 bytes).
+        JOINTS_FORMAT_MATRIX3X4,
+
+        /// Every joint transform is a dual quaternion (32 bytes).
+        ///
+        /// \remarks    Dual quaternions only represent rotation and translation,
+        ///             so the scale of the joint transforms is ignored.
+        JOINTS_FORMAT_DUAL_QUATERNION,
+
+        JOINTS_FORMAT_COUNT
+    };
+
     /// Renderer create info
     struct CreateInfo
     {
@@ -192,6 +216,13 @@ public:
         /// Whether to use skin pre-transform before applying joint transformations.
         bool UseSkinPreTransform = false;
 
+        /// Joint transform format, see JOINTS_FORMAT.
+        ///
+        /// \remarks    Compact formats reduce the amount of joint data uploaded
+        ///             for every skinned draw call and allow more joints to fit
+        ///             into the constant buffer.
+        JOINTS_FORMAT JointsFormat = JOINTS_FORMAT_MATRIX4X4;
+
         /// PCF shadow kernel size.
         /// Allowed values are 2, 3, 5, 7.
         Uint32 PCFKernelSize = 3;
@@ -217,6 +248,20 @@ public:
         /// The maximum number of shadow-casting lights.
         Uint32 MaxShadowCastingLightCount = 8;
 
+        /// Whether to enable clustered light culling.
+        ///
+        /// \remarks    When clustered lighting is enabled, the renderer creates a ClusteredLightGrid
+        ///             object (see GetLightClusters()). Point and spot lights that are added to the
+        ///             grid are only evaluated for the pixels in the clusters they affect, and are
+        ///             not limited by MaxLightCount. Lights in the frame attributes buffer are
+        ///             processed as usual.
+        bool EnableClusteredLighting = false;
+
+        /// Clustered light grid parameters.
+        ///
+        /// \remarks    This parameter is ignored if EnableClusteredLighting is false.
+        ClusteredLightGrid::CreateInfo LightClusters;
+
         static const SamplerDesc DefaultSampler;
 
         /// Immutable sampler for color map texture.
@@ -267,6 +312,24 @@ public:
         /// preintegrated Charlie BRDF look-up table.
         const char* PreintegratedCharlieBRDFPath = nullptr;
 
+        /// If IBL is enabled, this parameter optionally specifies the path to the
+        /// preintegrated GGX BRDF look-up table in DDS format.
+        ///
+        /// \remarks    When set, the look-up table is loaded from the file instead of
+        ///             being computed at start-up. The file can be shipped with the application
+        ///             as an asset. A compatible file is generated in IBLCacheDirectory
+        ///             under the name PreintegratedGGX_<hash>.dds.
+        const char* PreintegratedGGXPath = nullptr;
+
+        /// Optional directory where precomputed IBL textures are cached.
+        ///
+        /// \remarks    When set, the BRDF look-up table as well as the irradiance cube and
+        ///             the prefiltered environment map are stored in this directory and
+        ///             reused instead of being recomputed. Cube map entries are keyed by the
+        ///             content hash of the environment map passed to PrecomputeCubemaps()
+        ///             and all filtering parameters.
+        const char* IBLCacheDirectory = nullptr;
+
         /// Input layout description.
         ///
         /// \remarks    The renderer uses the following input layout:
@@ -281,6 +344,7 @@ public:
         ///                     float4 Weight0 : ATTRIB5; // If PSO_FLAG_USE_JOINTS is set
         ///                     float4 Color   : ATTRIB6; // If PSO_FLAG_USE_VERTEX_COLORS is set
         ///                     float3 Tangent : ATTRIB7; // If PSO_FLAG_USE_VERTEX_TANGENTS is set
+        ///                     float3 PrevPos : ATTRIB8; // If PSO_FLAG_USE_PREV_POSITIONS is set
         ///                 };
         InputLayoutDesc InputLayout;
 
@@ -316,6 +380,13 @@ public:
         /// will use the default implementation.
         std::function<PSMainSourceInfo(PSO_FLAGS PsoFlags)> GetPSMainSource = nullptr;
 
+        /// Bit mask of the render targets that are not blended with the background
+        /// when the alpha mode is ALPHA_MODE_BLEND. The output of the top layer is
+        /// written to these targets as is.
+        ///
+        /// \remarks    Render targets with integer formats are never blended.
+        Uint32 UnblendedRenderTargetsMask = 0;
+
         /// An optional user-provided callback function that returns static material texture indices
         /// for the specified PSO key. If null, the renderer will assign the indices automatically.
         ///
@@ -435,15 +506,34 @@ public:
     IBuffer*      GetJointsBuffer() const          {return m_JointsBuffer;}
     // clang-format on
 
+    /// Returns the clustered light grid, or null if clustered lighting is disabled.
+    ClusteredLightGrid* GetLightClusters() const { return m_LightClusters.get(); }
+
+    /// Returns the directory of the IBL cache, or an empty string if the cache is disabled.
+    const std::string& GetIBLCacheDirectory() const { return m_IBLCacheDirectory; }
+
     /// Precompute cubemaps used by IBL.
     ///
     /// \remarks If NumDiffuseSamples or NumSpecularSamples is 0,
     ///          the renderer will choose the optimal number of samples.
+    ///
+    ///          If EnvMapContentHash is not 0 and IBLCacheDirectory was specified
+    ///          at creation, the cubemaps are loaded from the cache if possible and
+    ///          stored in the cache otherwise. The hash must uniquely identify the
+    ///          contents of the environment map (see ComputeTextureContentHash()).
     void PrecomputeCubemaps(IDeviceContext* pCtx,
                             ITextureView*   pEnvironmentMap,
                             Uint32          NumDiffuseSamples  = 0,
                             Uint32          NumSpecularSamples = 0,
-                            bool            OptimizeSamples    = true);
+                            bool            OptimizeSamples    = true,
+                            size_t          EnvMapContentHash  = 0);
+
+    /// Writes the cubemaps precomputed by PrecomputeCubemaps() to the IBL cache.
+    ///
+    /// \remarks PrecomputeCubemaps() does not wait for the GPU to store the cubemaps in the cache.
+    ///          Instead, the cubemaps are written by this method once the GPU has completed
+    ///          their copies. The method never waits for the GPU and should be called once per frame.
+    void UpdateIBLCache(IDeviceContext* pCtx);
 
     void CreateResourceBinding(IShaderResourceBinding** ppSRB, Uint32 Idx = 0) const;
 
@@ -497,7 +587,11 @@ public:
         PSO_FLAG_COMPUTE_MOTION_VECTORS    = PSO_FLAG_BIT(37),
         PSO_FLAG_ENABLE_SHADOWS            = PSO_FLAG_BIT(38),
 
-        PSO_FLAG_LAST = PSO_FLAG_ENABLE_SHADOWS,
+        // Use previous-frame vertex positions from the PrevPos attribute
+        // to compute motion vectors (e.g. for pre-skinned geometry).
+        PSO_FLAG_USE_PREV_POSITIONS = PSO_FLAG_BIT(39),
+
+        PSO_FLAG_LAST = PSO_FLAG_USE_PREV_POSITIONS,
 
         PSO_FLAG_FIRST_USER_DEFINED = PSO_FLAG_LAST << 1ull,
 
@@ -700,10 +794,18 @@ public:
         const float4x4* PrevJointMatrices = nullptr; // If PSO_FLAG_COMPUTE_MOTION_VECTORS
     };
     /// Writes skinning data to the cbJointTransforms buffer as expected by the shader.
-    static void* WriteSkinningData(void* pDst, const WriteSkinningDataAttribs& Attribs, bool PackMatrixRowMajor, Uint32 MaxJointCount, bool UseSkinPreTransform);
+    static void* WriteSkinningData(void*                           pDst,
+                                   const WriteSkinningDataAttribs& Attribs,
+                                   bool                            PackMatrixRowMajor,
+                                   Uint32                          MaxJointCount,
+                                   bool                            UseSkinPreTransform,
+                                   JOINTS_FORMAT                   JointsFormat = JOINTS_FORMAT_MATRIX4X4);
     void*        WriteSkinningData(void* pDst, const WriteSkinningDataAttribs& Attribs);
 
-    static Uint32 GetJointsDataSize(Uint32 MaxJointCount, bool UseSkinPreTransform, bool UsePrevFrameTransforms);
+    /// Returns the size of a single joint transform in the given format.
+    static Uint32 GetJointDataSize(JOINTS_FORMAT JointsFormat);
+
+    static Uint32 GetJointsDataSize(Uint32 MaxJointCount, bool UseSkinPreTransform, bool UsePrevFrameTransforms, JOINTS_FORMAT JointsFormat = JOINTS_FORMAT_MATRIX4X4);
     Uint32        GetJointsDataSize(Uint32 JointCount, PSO_FLAGS PSOFlags) const;
     Uint32        GetJointsBufferSize() const;
 
@@ -725,7 +827,8 @@ protected:
 
 private:
     void PrecomputeBRDF(IDeviceContext* pCtx,
-                        Uint32          NumBRDFSamples = 512);
+                        Uint32          NumBRDFSamples = 512,
+                        const char*     LUTPath        = nullptr);
 
     void CreatePSO(PsoHashMapType&             PsoHashMap,
                    const GraphicsPipelineDesc& GraphicsDesc,
@@ -805,6 +908,10 @@ protected:
 
     RenderDeviceWithCache_N m_Device;
 
+    const std::string m_IBLCacheDirectory;
+
+    std::unique_ptr<TextureCacheWriter> m_IBLCacheWriter;
+
     static constexpr Uint32     BRDF_LUT_Dim = 512;
     RefCntAutoPtr<ITextureView> m_pPreintegratedGGX_SRV;
     RefCntAutoPtr<ITextureView> m_pPreintegratedCharlie_SRV;
@@ -829,6 +936,8 @@ protected:
     RefCntAutoPtr<IBuffer> m_PrecomputeEnvMapAttribsCB;
     RefCntAutoPtr<IBuffer> m_JointsBuffer;
 
+    std::unique_ptr<ClusteredLightGrid> m_LightClusters;
+
     std::unordered_set<std::string> m_GeneratedIncludes;
 
     std::vector<RefCntAutoPtr<IPipelineResourceSignature>> m_ResourceSignatures;
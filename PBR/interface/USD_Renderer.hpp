@@ -44,12 +44,39 @@ public:
         Uint32 BaseColorTargetIndex    = 4;
         Uint32 MaterialDataTargetIndex = 5;
         Uint32 IBLTargetIndex          = 6;
+
+        /// Whether to write octahedron-encoded normals to the first two components
+        /// of the normal target instead of the full float3 vector.
+        ///
+        /// \remarks    Packed normals may be stored in a two-channel target such as RG16_UNORM,
+        ///             which halves the bandwidth compared to RGBA16_FLOAT.
+        ///             Effects that read the normals must be configured accordingly
+        ///             (see ScreenSpaceReflection::FEATURE_FLAG_PACKED_NORMAL and
+        ///             ScreenSpaceAmbientOcclusion::FEATURE_FLAG_PACKED_NORMAL).
+        bool PackedNormalOutput = false;
+
+        /// Whether to write the material data (perceptual roughness and metallic) to the
+        /// z and w components of the normal target instead of the material data target.
+        ///
+        /// \remarks    This option requires PackedNormalOutput. The normal target is not
+        ///             blended, so the normal and material of the top layer are stored.
+        ///             The USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT flag is ignored.
+        bool PackedMaterialOutput = false;
+
+        /// Whether the mesh ID target has an unsigned integer format (e.g. R32_UINT or R16_UINT).
+        /// If false, the mesh ID is written as a float value.
+        bool UintMeshIdOutput = false;
     };
     /// Initializes the renderer
     USD_Renderer(IRenderDevice*     pDevice,
                  IRenderStateCache* pStateCache,
                  IDeviceContext*    pCtx,
                  const CreateInfo&  CI);
+
+    bool IsPackedNormalOutput() const { return m_PackedNormalOutput; }
+    bool IsPackedMaterialOutput() const { return m_PackedMaterialOutput; }
+    bool IsUintMeshIdOutput() const { return m_UintMeshIdOutput; }
+
     enum USD_PSO_FLAGS : Uint64
     {
         USD_PSO_FLAG_NONE                         = 0,
@@ -88,6 +115,9 @@ private:
     const Uint32 m_BaseColorTargetIndex;
     const Uint32 m_MaterialDataTargetIndex;
     const Uint32 m_IBLTargetIndex;
+    const bool   m_PackedNormalOutput;
+    const bool   m_PackedMaterialOutput;
+    const bool   m_UintMeshIdOutput;
 };
 DEFINE_FLAG_ENUM_OPERATORS(USD_Renderer::USD_PSO_FLAGS)
 
@@ -0,0 +1,299 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ClusteredLightGrid.hpp"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace HLSL
+{
+
+#include "Shaders/Common/public/BasicStructures.fxh"
+#include "Shaders/PBR/public/PBR_Structures.fxh"
+
+} // namespace HLSL
+
+static RefCntAutoPtr<IBufferView> CreateStructuredBufferSRV(IRenderDevice* pDevice, const char* Name, Uint32 ElementSize, Uint32 NumElements)
+{
+    BufferDesc Desc;
+    Desc.Name              = Name;
+    Desc.Size              = ElementSize * NumElements;
+    Desc.BindFlags         = BIND_SHADER_RESOURCE;
+    Desc.Usage             = USAGE_DEFAULT;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = ElementSize;
+
+    // Zero-initialize the buffer so that all clusters are empty until the grid is updated
+    std::vector<Uint8> ZeroData(static_cast<size_t>(Desc.Size));
+    BufferData         InitData{ZeroData.data(), Desc.Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+    if (!pBuffer)
+    {
+        UNEXPECTED("Failed to create ", Name);
+        return {};
+    }
+
+    return RefCntAutoPtr<IBufferView>{pBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE)};
+}
+
+ClusteredLightGrid::ClusteredLightGrid(IRenderDevice* pDevice, const CreateInfo& CI) :
+    m_GridSize{std::max(CI.GridSize.x, 1u), std::max(CI.GridSize.y, 1u), std::max(CI.GridSize.z, 1u)},
+    m_MaxLightCount{std::max(CI.MaxLightCount, 1u)},
+    m_MaxLightIndexCount{CI.MaxLightIndexCount != 0 ? CI.MaxLightIndexCount : m_GridSize.x * m_GridSize.y * m_GridSize.z * 32}
+{
+    const Uint32 NumClusters = m_GridSize.x * m_GridSize.y * m_GridSize.z;
+
+    if (pDevice != nullptr)
+    {
+        m_LightsSRV       = CreateStructuredBufferSRV(pDevice, "Clustered lights", sizeof(HLSL::PBRLightAttribs), m_MaxLightCount);
+        m_ClustersSRV     = CreateStructuredBufferSRV(pDevice, "Light clusters", sizeof(uint2), NumClusters);
+        m_LightIndicesSRV = CreateStructuredBufferSRV(pDevice, "Cluster light indices", sizeof(Uint32), m_MaxLightIndexCount);
+    }
+
+    m_Clusters.resize(NumClusters);
+    m_LightIndices.reserve(m_MaxLightIndexCount);
+}
+
+ClusteredLightGrid::~ClusteredLightGrid()
+{
+}
+
+void ClusteredLightGrid::BinLights(const HLSL::CameraAttribs&         Camera,
+                                   const HLSL::PBRLightAttribs*       pLights,
+                                   Uint32                             NumLights,
+                                   HLSL::PBRRendererShaderParameters& Renderer)
+{
+    m_NumDroppedLights = NumLights > m_MaxLightCount ? NumLights - m_MaxLightCount : 0;
+    if (m_NumDroppedLights > 0)
+    {
+        LOG_WARNING_MESSAGE_ONCE("The number of clustered lights (", NumLights, ") exceeds the limit (", m_MaxLightCount,
+                                 "). Some lights will be ignored. Increase MaxLightCount.");
+    }
+    NumLights   = std::min(NumLights, m_MaxLightCount);
+    m_NumLights = NumLights;
+
+    // Depth slices are distributed logarithmically:
+    //   Slice = log(Z) * ZScale + ZBias
+    const float NearZ  = std::max(Camera.fNearPlaneZ, 1e-6f);
+    const float FarZ   = std::max(std::min(Camera.fFarPlaneZ, NearZ * 1e+6f), NearZ * 2.f);
+    const float ZScale = static_cast<float>(m_GridSize.z) / std::log(FarZ / NearZ);
+    const float ZBias  = -std::log(NearZ) * ZScale;
+
+    Renderer.ClusterZScale = ZScale;
+    Renderer.ClusterZBias  = ZBias;
+    m_ZScale               = ZScale;
+    m_ZBias                = ZBias;
+
+    const float4x4& View     = Camera.mView;
+    const float4x4& ViewProj = Camera.mViewProj;
+
+    auto GetSlice = [&](float Z) {
+        const float Slice = std::log(std::max(Z, NearZ)) * ZScale + ZBias;
+        return static_cast<Uint32>(clamp(Slice, 0.f, static_cast<float>(m_GridSize.z - 1)));
+    };
+
+    auto GetTile = [](float NDC, Uint32 NumTiles) {
+        const float Tile = (NDC * 0.5f + 0.5f) * static_cast<float>(NumTiles);
+        return static_cast<Uint32>(clamp(Tile, 0.f, static_cast<float>(NumTiles - 1)));
+    };
+
+    // Find the range of clusters covered by every light
+    m_LightClusterRanges.clear();
+    std::fill(m_Clusters.begin(), m_Clusters.end(), uint2{0, 0});
+    for (Uint32 i = 0; i < NumLights; ++i)
+    {
+        const HLSL::PBRLightAttribs& Light = pLights[i];
+        VERIFY(Light.Range4 > 0, "Only point and spot lights with finite range can be clustered");
+
+        const float  Range = std::sqrt(std::sqrt(Light.Range4));
+        const float3 Pos{Light.PosX, Light.PosY, Light.PosZ};
+
+        // The same view-space depth convention as in the shader.
+        // Lights entirely behind the near plane can't affect any visible pixel.
+        const float ViewZ = (Pos * View).z;
+        if (ViewZ + Range < NearZ || ViewZ - Range > FarZ)
+        {
+            m_LightClusterRanges.emplace_back(uint3{1, 1, 1}, uint3{0, 0, 0}); // Empty range
+            continue;
+        }
+
+        uint3 MinCluster{0, 0, GetSlice(ViewZ - Range)};
+        uint3 MaxCluster{m_GridSize.x - 1, m_GridSize.y - 1, GetSlice(ViewZ + Range)};
+        if (ViewZ - Range > NearZ)
+        {
+            // The light sphere is entirely in front of the camera: project its bounding box
+            float2 MinNDC{+FLT_MAX, +FLT_MAX};
+            float2 MaxNDC{-FLT_MAX, -FLT_MAX};
+            for (Uint32 Corner = 0; Corner < 8; ++Corner)
+            {
+                const float4 WorldPos{
+                    Pos.x + ((Corner & 0x01) ? Range : -Range),
+                    Pos.y + ((Corner & 0x02) ? Range : -Range),
+                    Pos.z + ((Corner & 0x04) ? Range : -Range),
+                    1,
+                };
+                const float4 ClipPos = WorldPos * ViewProj;
+                if (ClipPos.w <= 0)
+                {
+                    // The corner is behind the camera; fall back to the full screen
+                    MinNDC = float2{-1, -1};
+                    MaxNDC = float2{+1, +1};
+                    break;
+                }
+                const float2 NDC{ClipPos.x / ClipPos.w, ClipPos.y / ClipPos.w};
+                MinNDC = std::min(MinNDC, NDC);
+                MaxNDC = std::max(MaxNDC, NDC);
+            }
+            if (MinNDC.x > 1 || MinNDC.y > 1 || MaxNDC.x < -1 || MaxNDC.y < -1)
+            {
+                m_LightClusterRanges.emplace_back(uint3{1, 1, 1}, uint3{0, 0, 0}); // Off screen
+                continue;
+            }
+            MinCluster.x = GetTile(MinNDC.x, m_GridSize.x);
+            MinCluster.y = GetTile(MinNDC.y, m_GridSize.y);
+            MaxCluster.x = GetTile(MaxNDC.x, m_GridSize.x);
+            MaxCluster.y = GetTile(MaxNDC.y, m_GridSize.y);
+        }
+
+        for (Uint32 z = MinCluster.z; z <= MaxCluster.z; ++z)
+        {
+            for (Uint32 y = MinCluster.y; y <= MaxCluster.y; ++y)
+            {
+                for (Uint32 x = MinCluster.x; x <= MaxCluster.x; ++x)
+                    ++m_Clusters[(z * m_GridSize.y + y) * m_GridSize.x + x].y;
+            }
+        }
+        m_LightClusterRanges.emplace_back(MinCluster, MaxCluster);
+    }
+
+    // Compute the offsets of the cluster light lists
+    Uint32 TotalIndexCount   = 0;
+    m_NumDroppedLightIndices = 0;
+    for (uint2& Cluster : m_Clusters)
+    {
+        const Uint32 Count = std::min(Cluster.y, m_MaxLightIndexCount - TotalIndexCount);
+        m_NumDroppedLightIndices += Cluster.y - Count;
+
+        Cluster.y = Count;
+        Cluster.x = TotalIndexCount;
+        TotalIndexCount += Cluster.y;
+    }
+    if (m_NumDroppedLightIndices > 0)
+    {
+        LOG_WARNING_MESSAGE_ONCE("Cluster light index list is full (", m_MaxLightIndexCount, " indices, ", m_NumDroppedLightIndices,
+                                 " more requested). Some lights will be ignored. Increase MaxLightIndexCount.");
+    }
+
+    // Fill the cluster light lists. The count is used as the running write position,
+    // and the capacity of every list is given by the offset of the next one.
+    for (uint2& Cluster : m_Clusters)
+        Cluster.y = 0;
+    m_LightIndices.resize(TotalIndexCount);
+    for (Uint32 i = 0; i < NumLights; ++i)
+    {
+        const uint3& MinCluster = m_LightClusterRanges[i].first;
+        const uint3& MaxCluster = m_LightClusterRanges[i].second;
+        for (Uint32 z = MinCluster.z; z <= MaxCluster.z; ++z)
+        {
+            for (Uint32 y = MinCluster.y; y <= MaxCluster.y; ++y)
+            {
+                for (Uint32 x = MinCluster.x; x <= MaxCluster.x; ++x)
+                {
+                    const size_t ClusterIdx = (z * m_GridSize.y + y) * m_GridSize.x + x;
+                    const Uint32 ListEnd    = ClusterIdx + 1 < m_Clusters.size() ? m_Clusters[ClusterIdx + 1].x : TotalIndexCount;
+
+                    uint2& Cluster = m_Clusters[ClusterIdx];
+                    if (Cluster.x + Cluster.y < ListEnd)
+                    {
+                        m_LightIndices[Cluster.x + Cluster.y] = i;
+                        ++Cluster.y;
+                    }
+                }
+            }
+        }
+    }
+}
+
+Uint32 ClusteredLightGrid::GetClusterIndex(const float3& WorldPos, const HLSL::CameraAttribs& Camera) const
+{
+    // Must be consistent with GetLightClusterIndex() in RenderPBR.psh
+    const float4 ClipPos = float4{WorldPos, 1} * Camera.mViewProj;
+    const float2 NDC     = float2{ClipPos.x, ClipPos.y} / std::max(ClipPos.w, 1e-6f);
+    const float  ViewZ   = (WorldPos * Camera.mView).z;
+
+    const float3 Cluster{
+        (NDC.x * 0.5f + 0.5f) * static_cast<float>(m_GridSize.x),
+        (NDC.y * 0.5f + 0.5f) * static_cast<float>(m_GridSize.y),
+        std::log(std::max(ViewZ, 1e-6f)) * m_ZScale + m_ZBias,
+    };
+    const uint3 iCluster{
+        static_cast<Uint32>(clamp(Cluster.x, 0.f, static_cast<float>(m_GridSize.x - 1))),
+        static_cast<Uint32>(clamp(Cluster.y, 0.f, static_cast<float>(m_GridSize.y - 1))),
+        static_cast<Uint32>(clamp(Cluster.z, 0.f, static_cast<float>(m_GridSize.z - 1))),
+    };
+    return (iCluster.z * m_GridSize.y + iCluster.y) * m_GridSize.x + iCluster.x;
+}
+
+void ClusteredLightGrid::Update(IDeviceContext*                    pCtx,
+                                const HLSL::CameraAttribs&         Camera,
+                                const HLSL::PBRLightAttribs*       pLights,
+                                Uint32                             NumLights,
+                                HLSL::PBRRendererShaderParameters& Renderer)
+{
+    if (!m_LightsSRV || !m_ClustersSRV || !m_LightIndicesSRV)
+    {
+        UNEXPECTED("GPU buffers are not initialized. The grid must be created with a non-null device to be updated.");
+        return;
+    }
+
+    BinLights(Camera, pLights, NumLights, Renderer);
+
+    const Uint32 TotalIndexCount = static_cast<Uint32>(m_LightIndices.size());
+    if (m_NumLights > 0)
+        pCtx->UpdateBuffer(m_LightsSRV->GetBuffer(), 0, sizeof(HLSL::PBRLightAttribs) * m_NumLights, pLights, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->UpdateBuffer(m_ClustersSRV->GetBuffer(), 0, static_cast<Uint64>(sizeof(uint2) * m_Clusters.size()), m_Clusters.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (TotalIndexCount > 0)
+        pCtx->UpdateBuffer(m_LightIndicesSRV->GetBuffer(), 0, sizeof(Uint32) * TotalIndexCount, m_LightIndices.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    StateTransitionDesc Barriers[] = {
+        {m_LightsSRV->GetBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {m_ClustersSRV->GetBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {m_LightIndicesSRV->GetBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+    };
+    pCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+}
+
+} // namespace Diligent
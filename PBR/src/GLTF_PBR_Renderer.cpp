@@ -852,7 +852,8 @@ void GLTF_PBR_Renderer::WritePBRLightShaderAttribs(const PBRLightShaderAttribsDa
         pShaderAttribs->DirectionZ = AttribsData.Direction->z;
     }
 
-    pShaderAttribs->ShadowMapIndex = AttribsData.ShadowMapIndex;
+    pShaderAttribs->ShadowMapIndex    = AttribsData.ShadowMapIndex;
+    pShaderAttribs->NumShadowCascades = AttribsData.NumShadowCascades;
 
     auto Intensity = Light.Intensity;
     if (pShaderAttribs->Type != LIGHT_TYPE_DIRECTIONAL)
@@ -27,6 +27,7 @@
 #include "PBR_Renderer.hpp"
 
 #include <array>
+#include <cmath>
 #include <vector>
 
 #include "RenderStateCache.hpp"
@@ -38,6 +39,7 @@
 #include "PlatformMisc.hpp"
 #include "TextureUtilities.h"
 #include "Utilities/interface/DiligentFXShaderSourceStreamFactory.hpp"
+#include "Utilities/interface/TextureCacheUtils.hpp"
 #include "ShaderSourceFactoryUtils.hpp"
 
 #if HLSL2GLSL_CONVERTER_SUPPORTED
@@ -49,6 +51,10 @@ namespace Diligent
 
 const SamplerDesc PBR_Renderer::CreateInfo::DefaultSampler = Sam_LinearWrap;
 
+// Bump this value whenever the BRDF or the environment map filtering shaders change
+// in a way that makes previously cached IBL textures invalid.
+static constexpr Uint32 IBLCacheVersion = 1;
+
 #if PLATFORM_EMSCRIPTEN
 static constexpr char MultiDrawGLSLExtension[] = "#extension GL_ANGLE_multi_draw : enable";
 #else
@@ -184,13 +190,14 @@ std::string PBR_Renderer::GetPSOFlagsString(PSO_FLAGS Flags)
             case PSO_FLAG_UNSHADED:                  FlagsStr += "UNSHADED"; break;
             case PSO_FLAG_COMPUTE_MOTION_VECTORS:    FlagsStr += "MOTION_VECTORS"; break;
             case PSO_FLAG_ENABLE_SHADOWS:            FlagsStr += "SHADOWS"; break;
+            case PSO_FLAG_USE_PREV_POSITIONS:        FlagsStr += "PREV_POSITIONS"; break;
                 // clang-format on
 
             default:
                 FlagsStr += std::to_string(PlatformMisc::GetLSB(Flag));
         }
     }
-    static_assert(PSO_FLAG_LAST == 1ull << 38ull, "Please update the switch above to handle the new flag");
+    static_assert(PSO_FLAG_LAST == 1ull << 39ull, "Please update the switch above to handle the new flag");
 
     return FlagsStr;
 }
@@ -238,20 +245,37 @@ static void ClearCubemap(IDeviceContext* pCtx, ITexture* pCubemap)
     });
 }
 
-Uint32 PBR_Renderer::GetJointsDataSize(Uint32 MaxJointCount, bool UseSkinPreTransform, bool UsePrevFrameTransforms)
+Uint32 PBR_Renderer::GetJointDataSize(JOINTS_FORMAT JointsFormat)
+{
+    static_assert(JOINTS_FORMAT_COUNT == 3, "Please handle the new joints format here");
+    switch (JointsFormat)
+    {
+        // clang-format off
+        case JOINTS_FORMAT_MATRIX4X4:       return sizeof(float4x4);
+        case JOINTS_FORMAT_MATRIX3X4:       return sizeof(float4) * 3;
+        case JOINTS_FORMAT_DUAL_QUATERNION: return sizeof(float4) * 2;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected joints format");
+            return sizeof(float4x4);
+    }
+}
+
+Uint32 PBR_Renderer::GetJointsDataSize(Uint32 MaxJointCount, bool UseSkinPreTransform, bool UsePrevFrameTransforms, JOINTS_FORMAT JointsFormat)
 {
-    return sizeof(float4x4) * (MaxJointCount + (UseSkinPreTransform ? 1 : 0)) * (UsePrevFrameTransforms ? 2 : 1);
+    // Skin pre-transform is always a full 4x4 matrix
+    return (sizeof(float4x4) * (UseSkinPreTransform ? 1 : 0) + GetJointDataSize(JointsFormat) * MaxJointCount) * (UsePrevFrameTransforms ? 2 : 1);
 }
 
 Uint32 PBR_Renderer::GetJointsDataSize(Uint32 JointCount, PSO_FLAGS PSOFlags) const
 {
-    return GetJointsDataSize(JointCount, m_Settings.UseSkinPreTransform, (PSOFlags & PSO_FLAG_COMPUTE_MOTION_VECTORS) != 0);
+    return GetJointsDataSize(JointCount, m_Settings.UseSkinPreTransform, (PSOFlags & PSO_FLAG_COMPUTE_MOTION_VECTORS) != 0, m_Settings.JointsFormat);
 }
 
 Uint32 PBR_Renderer::GetJointsBufferSize() const
 {
     return m_Settings.MaxJointCount > 0 ?
-        GetJointsDataSize(m_Settings.MaxJointCount, m_Settings.UseSkinPreTransform, true) :
+        GetJointsDataSize(m_Settings.MaxJointCount, m_Settings.UseSkinPreTransform, true, m_Settings.JointsFormat) :
         0;
 }
 
@@ -265,15 +289,21 @@ PBR_Renderer::PBR_Renderer(IRenderDevice*     pDevice,
         [this](CreateInfo CI) {
             CI.InputLayout               = m_InputLayout;
             CI.SheenAlbedoScalingLUTPath = nullptr;
+            CI.PreintegratedGGXPath      = nullptr;
+            CI.IBLCacheDirectory         = nullptr;
             return CI;
         }(CI)},
     m_Device{pDevice, pStateCache},
+    m_IBLCacheDirectory{CI.IBLCacheDirectory != nullptr ? CI.IBLCacheDirectory : ""},
     m_PBRPrimitiveAttribsCB{CI.pPrimitiveAttribsCB},
     m_JointsBuffer{CI.pJointsBuffer}
 {
     if (m_Settings.EnableIBL)
     {
-        PrecomputeBRDF(pCtx, m_Settings.NumBRDFSamples);
+        PrecomputeBRDF(pCtx, m_Settings.NumBRDFSamples, CI.PreintegratedGGXPath);
+
+        if (!m_IBLCacheDirectory.empty())
+            m_IBLCacheWriter = std::make_unique<TextureCacheWriter>(pDevice);
 
         TextureDesc TexDesc;
         TexDesc.Type      = RESOURCE_DIM_TEX_CUBE;
@@ -424,7 +454,7 @@ PBR_Renderer::PBR_Renderer(IRenderDevice*     pDevice,
         }
         if (m_Settings.MaxJointCount > 0)
         {
-            const Uint32 MaxJointCount = 65536 / (2 * sizeof(float4x4)) - (m_Settings.UseSkinPreTransform ? 1 : 0);
+            const Uint32 MaxJointCount = (65536 / 2 - (m_Settings.UseSkinPreTransform ? sizeof(float4x4) : 0)) / GetJointDataSize(m_Settings.JointsFormat);
             if (m_Settings.MaxJointCount > MaxJointCount)
             {
                 LOG_ERROR_MESSAGE("PBR_Renderer settings specify ", m_Settings.MaxJointCount, " joints, but the maximum allowed number of joints is ", MaxJointCount);
@@ -448,6 +478,11 @@ PBR_Renderer::PBR_Renderer(IRenderDevice*     pDevice,
         pCtx->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
     }
 
+    if (m_Settings.EnableClusteredLighting)
+    {
+        m_LightClusters = std::make_unique<ClusteredLightGrid>(pDevice, m_Settings.LightClusters);
+    }
+
     if (InitSignature)
     {
         CreateSignature();
@@ -469,8 +504,24 @@ PBR_Renderer::~PBR_Renderer()
 }
 
 void PBR_Renderer::PrecomputeBRDF(IDeviceContext* pCtx,
-                                  Uint32          NumBRDFSamples)
+                                  Uint32          NumBRDFSamples,
+                                  const char*     LUTPath)
 {
+    if (LUTPath != nullptr)
+    {
+        TextureLoadInfo         LoadInfo{"Preintegrated GGX"};
+        RefCntAutoPtr<ITexture> pPreintegratedGGX;
+        CreateTextureFromFile(LUTPath, LoadInfo, m_Device, &pPreintegratedGGX);
+        if (pPreintegratedGGX)
+        {
+            m_pPreintegratedGGX_SRV = pPreintegratedGGX->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+            StateTransitionDesc Barrier{pPreintegratedGGX, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+            pCtx->TransitionResourceStates(1, &Barrier);
+            return;
+        }
+        LOG_ERROR_MESSAGE("Failed to load preintegrated GGX BRDF look-up table from file ", LUTPath, ". The table will be computed.");
+    }
+
     TextureDesc TexDesc;
     TexDesc.Name            = "Preintegrated GGX";
     TexDesc.Type            = RESOURCE_DIM_TEX_2D;
@@ -483,6 +534,20 @@ void PBR_Renderer::PrecomputeBRDF(IDeviceContext* pCtx,
     auto pPreintegratedGGX  = m_Device.CreateTexture(TexDesc);
     m_pPreintegratedGGX_SRV = pPreintegratedGGX->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
 
+    std::string CacheFilePath;
+    if (!m_IBLCacheDirectory.empty())
+    {
+        const size_t Hash = ComputeHash(IBLCacheVersion, NumBRDFSamples, TexDesc.Width, TexDesc.Height, TexDesc.Format);
+        CacheFilePath     = GetTextureCacheFilePath(m_IBLCacheDirectory.c_str(), "PreintegratedGGX", Hash);
+    }
+
+    if (!CacheFilePath.empty() && LoadTextureFromCache(pCtx, CacheFilePath.c_str(), pPreintegratedGGX))
+    {
+        StateTransitionDesc Barrier{pPreintegratedGGX, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pCtx->TransitionResourceStates(1, &Barrier);
+        return;
+    }
+
     RefCntAutoPtr<IPipelineState> PrecomputeBRDF_PSO;
     {
         GraphicsPipelineStateCreateInfo PSOCreateInfo;
@@ -537,6 +602,9 @@ void PBR_Renderer::PrecomputeBRDF(IDeviceContext* pCtx,
     DrawAttribs attrs(3, DRAW_FLAG_VERIFY_ALL);
     pCtx->Draw(attrs);
 
+    if (!CacheFilePath.empty())
+        StoreTextureInCache(m_Device, pCtx, pPreintegratedGGX, CacheFilePath.c_str());
+
     // clang-format off
     StateTransitionDesc Barriers[] =
     {
@@ -592,7 +660,8 @@ void PBR_Renderer::PrecomputeCubemaps(IDeviceContext* pCtx,
                                       ITextureView*   pEnvironmentMap,
                                       Uint32          NumDiffuseSamples,
                                       Uint32          NumSpecularSamples,
-                                      bool            OptimizeSamples)
+                                      bool            OptimizeSamples,
+                                      size_t          EnvMapContentHash)
 {
     if (!m_Settings.EnableIBL)
     {
@@ -638,6 +707,36 @@ void PBR_Renderer::PrecomputeCubemaps(IDeviceContext* pCtx,
         IBL_PSOKey::ENV_MAP_TYPE_CUBE :
         IBL_PSOKey::ENV_MAP_TYPE_SPHERE;
 
+    ITexture* pIrradianceCube    = m_pIrradianceCubeSRV->GetTexture();
+    ITexture* pPrefilteredEnvMap = m_pPrefilteredEnvMapSRV->GetTexture();
+
+    auto TransitionCubemapsToShaderResource = [&]() {
+        // clang-format off
+        StateTransitionDesc Barriers[] = 
+        {
+            {pPrefilteredEnvMap, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pIrradianceCube,    RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE}
+        };
+        // clang-format on
+        pCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+    };
+
+    std::string IrradianceCubeCachePath;
+    std::string PrefilteredEnvMapCachePath;
+    if (EnvMapContentHash != 0 && !m_IBLCacheDirectory.empty())
+    {
+        const size_t Hash = ComputeHash(IBLCacheVersion, EnvMapContentHash, EnvMapType, FeatureFlags, NumDiffuseSamples, NumSpecularSamples);
+
+        IrradianceCubeCachePath    = GetTextureCacheFilePath(m_IBLCacheDirectory.c_str(), "IrradianceCube", Hash);
+        PrefilteredEnvMapCachePath = GetTextureCacheFilePath(m_IBLCacheDirectory.c_str(), "PrefilteredEnvMap", Hash);
+        if (LoadTextureFromCache(pCtx, IrradianceCubeCachePath.c_str(), pIrradianceCube) &&
+            LoadTextureFromCache(pCtx, PrefilteredEnvMapCachePath.c_str(), pPrefilteredEnvMap))
+        {
+            TransitionCubemapsToShaderResource();
+            return;
+        }
+    }
+
     ShaderMacroHelper Macros;
     Macros
         .Add("OPTIMIZE_SAMPLES", (FeatureFlags & IBL_FEATURE_FLAG_OPTIMIZE_SAMPLES) != 0)
@@ -775,7 +874,6 @@ void PBR_Renderer::PrecomputeCubemaps(IDeviceContext* pCtx,
     pCtx->SetPipelineState(PrecomputeIrradianceCubeTech.PSO);
     PrecomputeIrradianceCubeTech.SRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_EnvironmentMap")->Set(pEnvironmentMap);
     pCtx->CommitShaderResources(PrecomputeIrradianceCubeTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    auto* pIrradianceCube = m_pIrradianceCubeSRV->GetTexture();
     ProcessCubemapFaces(pCtx, pIrradianceCube, [&](ITextureView* pRTV, Uint32 mip, Uint32 face) {
         VERIFY_EXPR(mip == 0);
         {
@@ -796,7 +894,6 @@ void PBR_Renderer::PrecomputeCubemaps(IDeviceContext* pCtx,
     pCtx->SetPipelineState(PrefilterEnvMapTech.PSO);
     PrefilterEnvMapTech.SRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_EnvironmentMap")->Set(pEnvironmentMap);
     pCtx->CommitShaderResources(PrefilterEnvMapTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    auto* pPrefilteredEnvMap = m_pPrefilteredEnvMapSRV->GetTexture();
     ProcessCubemapFaces(pCtx, pPrefilteredEnvMap, [&](ITextureView* pRTV, Uint32 mip, Uint32 face) {
         {
             MapHelper<PrecomputeEnvMapAttribs> Attribs{pCtx, m_PrecomputeEnvMapAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD};
@@ -815,17 +912,22 @@ void PBR_Renderer::PrecomputeCubemaps(IDeviceContext* pCtx,
     // Release reference to the environment map
     PrefilterEnvMapTech.SRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_EnvironmentMap")->Set(nullptr);
 
-
-    // clang-format off
-    StateTransitionDesc Barriers[] = 
+    if (!IrradianceCubeCachePath.empty() && m_IBLCacheWriter)
     {
-        {m_pPrefilteredEnvMapSRV->GetTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
-        {m_pIrradianceCubeSRV->GetTexture(),    RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE}
-    };
-    // clang-format on
-    pCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+        // The cubemaps are usually precomputed inside the frame, so they are read back
+        // and written to the cache by UpdateIBLCache() once the GPU has completed them.
+        m_IBLCacheWriter->Enqueue(pCtx, pIrradianceCube, IrradianceCubeCachePath.c_str());
+        m_IBLCacheWriter->Enqueue(pCtx, pPrefilteredEnvMap, PrefilteredEnvMapCachePath.c_str());
+    }
+
+    TransitionCubemapsToShaderResource();
 }
 
+void PBR_Renderer::UpdateIBLCache(IDeviceContext* pCtx)
+{
+    if (m_IBLCacheWriter)
+        m_IBLCacheWriter->Update(pCtx);
+}
 
 void PBR_Renderer::InitCommonSRBVars(IShaderResourceBinding* pSRB,
                                      IBuffer*                pFrameAttribs,
@@ -879,6 +981,18 @@ void PBR_Renderer::InitCommonSRBVars(IShaderResourceBinding* pSRB,
         if (auto* pShadowMapVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_ShadowMap"))
             pShadowMapVar->Set(pShadowMap);
     }
+
+    if (m_LightClusters)
+    {
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_ClusteredLights"))
+            pVar->Set(m_LightClusters->GetLightsSRV());
+
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_LightClusters"))
+            pVar->Set(m_LightClusters->GetClustersSRV());
+
+        if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_ClusterLightIndices"))
+            pVar->Set(m_LightClusters->GetLightIndicesSRV());
+    }
 }
 
 void PBR_Renderer::SetMaterialTexture(IShaderResourceBinding* pSRB, ITextureView* pTexSRV, TEXTURE_ATTRIB_ID TextureId) const
@@ -1095,6 +1209,14 @@ void PBR_Renderer::CreateSignature()
         AddTextureAndSampler("g_ShadowMap", Sam_ComparisonLinearClamp, "g_ShadowMap_sampler", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, WGPUShadowMap);
     }
 
+    if (m_Settings.EnableClusteredLighting)
+    {
+        SignatureDesc
+            .AddResource(SHADER_TYPE_PIXEL, "g_ClusteredLights", SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            .AddResource(SHADER_TYPE_PIXEL, "g_LightClusters", SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            .AddResource(SHADER_TYPE_PIXEL, "g_ClusterLightIndices", SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    }
+
     CreateCustomSignature(std::move(SignatureDesc));
 }
 
@@ -1126,6 +1248,10 @@ ShaderMacroHelper PBR_Renderer::DefineMacros(const PSOKey& Key) const
     ShaderMacroHelper Macros;
     Macros.Add("MAX_JOINT_COUNT", static_cast<int>(m_Settings.MaxJointCount));
     Macros.Add("USE_SKIN_PRE_TRANSFORM", m_Settings.UseSkinPreTransform);
+    Macros.Add("JOINTS_FORMAT_MATRIX4X4", static_cast<int>(JOINTS_FORMAT_MATRIX4X4));
+    Macros.Add("JOINTS_FORMAT_MATRIX3X4", static_cast<int>(JOINTS_FORMAT_MATRIX3X4));
+    Macros.Add("JOINTS_FORMAT_DUAL_QUATERNION", static_cast<int>(JOINTS_FORMAT_DUAL_QUATERNION));
+    Macros.Add("JOINTS_FORMAT", static_cast<int>(m_Settings.JointsFormat));
     Macros.Add("TONE_MAPPING_MODE", "TONE_MAPPING_MODE_UNCHARTED2");
 
     Macros.Add("PRIMITIVE_ARRAY_SIZE", static_cast<int>(m_Settings.PrimitiveArraySize));
@@ -1179,6 +1305,14 @@ ShaderMacroHelper PBR_Renderer::DefineMacros(const PSOKey& Key) const
     Macros.Add("PBR_LIGHT_TYPE_POINT", static_cast<int>(LIGHT_TYPE_POINT));
     Macros.Add("PBR_LIGHT_TYPE_SPOT", static_cast<int>(LIGHT_TYPE_SPOT));
     Macros.Add("PBR_MAX_SHADOW_MAPS", (PSOFlags & PSO_FLAG_USE_LIGHTS) != 0 ? static_cast<int>(m_Settings.MaxShadowCastingLightCount) : 0);
+    if (m_LightClusters)
+    {
+        const uint3& GridSize = m_LightClusters->GetGridSize();
+        Macros.Add("PBR_CLUSTERED_LIGHTING", (PSOFlags & PSO_FLAG_USE_LIGHTS) != 0);
+        Macros.Add("PBR_LIGHT_CLUSTER_GRID_SIZE_X", static_cast<int>(GridSize.x));
+        Macros.Add("PBR_LIGHT_CLUSTER_GRID_SIZE_Y", static_cast<int>(GridSize.y));
+        Macros.Add("PBR_LIGHT_CLUSTER_GRID_SIZE_Z", static_cast<int>(GridSize.z));
+    }
 
     Macros.Add("USE_IBL_ENV_MAP_LOD", true);
     Macros.Add("USE_HDR_IBL_CUBEMAPS", true);
@@ -1242,7 +1376,7 @@ ShaderMacroHelper PBR_Renderer::DefineMacros(const PSOKey& Key) const
     Macros.Add("LOADING_ANIMATION_TRANSITIONING", static_cast<int>(LoadingAnimationMode::Transitioning));
     // clang-format on
 
-    static_assert(PSO_FLAG_LAST == PSO_FLAG_BIT(38), "Did you add new PSO Flag? You may need to handle it here.");
+    static_assert(PSO_FLAG_LAST == PSO_FLAG_BIT(39), "Did you add new PSO Flag? You may need to handle it here.");
 #define ADD_PSO_FLAG_MACRO(Flag) Macros.Add(#Flag, (PSOFlags & PSO_FLAG_##Flag) != PSO_FLAG_NONE)
     ADD_PSO_FLAG_MACRO(USE_COLOR_MAP);
     ADD_PSO_FLAG_MACRO(USE_NORMAL_MAP);
@@ -1286,6 +1420,7 @@ ShaderMacroHelper PBR_Renderer::DefineMacros(const PSOKey& Key) const
     ADD_PSO_FLAG_MACRO(UNSHADED);
     ADD_PSO_FLAG_MACRO(COMPUTE_MOTION_VECTORS);
     ADD_PSO_FLAG_MACRO(ENABLE_SHADOWS);
+    ADD_PSO_FLAG_MACRO(USE_PREV_POSITIONS);
 #undef ADD_PSO_FLAG_MACRO
 
     Macros.Add("TEX_COLOR_CONVERSION_MODE_NONE", CreateInfo::TEX_COLOR_CONVERSION_MODE_NONE);
@@ -1370,6 +1505,7 @@ void PBR_Renderer::GetVSInputStructAndLayout(PSO_FLAGS         PSOFlags,
     //    float4 Weight0 : ATTRIB5;
     //    float4 Color   : ATTRIB6; // May be float3
     //    float3 Tangent : ATTRIB7;
+    //    float3 PrevPos : ATTRIB8;
     //};
     struct VSAttribInfo
     {
@@ -1398,17 +1534,18 @@ void PBR_Renderer::GetVSInputStructAndLayout(PSO_FLAGS         PSOFlags,
         }
     }
 
-    const std::array<VSAttribInfo, 8> VSAttribs = //
+    const std::array<VSAttribInfo, 9> VSAttribs = //
         {
             // clang-format off
-            VSAttribInfo{VERTEX_ATTRIB_ID_POSITION,  "Pos",     VT_FLOAT32, 3,            PSO_FLAG_NONE},
-            VSAttribInfo{VERTEX_ATTRIB_ID_NORMAL,    "Normal",  VT_FLOAT32, 3,            PSO_FLAG_USE_VERTEX_NORMALS},
-            VSAttribInfo{VERTEX_ATTRIB_ID_TEXCOORD0, "UV0",     VT_FLOAT32, 2,            PSO_FLAG_USE_TEXCOORD0},
-            VSAttribInfo{VERTEX_ATTRIB_ID_TEXCOORD1, "UV1",     VT_FLOAT32, 2,            PSO_FLAG_USE_TEXCOORD1},
-            VSAttribInfo{VERTEX_ATTRIB_ID_JOINTS,    "Joint0",  VT_FLOAT32, 4,            PSO_FLAG_USE_JOINTS},
-            VSAttribInfo{VERTEX_ATTRIB_ID_WEIGHTS,   "Weight0", VT_FLOAT32, 4,            PSO_FLAG_USE_JOINTS},
-            VSAttribInfo{VERTEX_ATTRIB_ID_COLOR,     "Color",   VT_FLOAT32, NumColorComp, PSO_FLAG_USE_VERTEX_COLORS},
-            VSAttribInfo{VERTEX_ATTRIB_ID_TANGENT,   "Tangent", VT_FLOAT32, 3,            PSO_FLAG_USE_VERTEX_TANGENTS}
+            VSAttribInfo{VERTEX_ATTRIB_ID_POSITION,      "Pos",     VT_FLOAT32, 3,            PSO_FLAG_NONE},
+            VSAttribInfo{VERTEX_ATTRIB_ID_NORMAL,        "Normal",  VT_FLOAT32, 3,            PSO_FLAG_USE_VERTEX_NORMALS},
+            VSAttribInfo{VERTEX_ATTRIB_ID_TEXCOORD0,     "UV0",     VT_FLOAT32, 2,            PSO_FLAG_USE_TEXCOORD0},
+            VSAttribInfo{VERTEX_ATTRIB_ID_TEXCOORD1,     "UV1",     VT_FLOAT32, 2,            PSO_FLAG_USE_TEXCOORD1},
+            VSAttribInfo{VERTEX_ATTRIB_ID_JOINTS,        "Joint0",  VT_FLOAT32, 4,            PSO_FLAG_USE_JOINTS},
+            VSAttribInfo{VERTEX_ATTRIB_ID_WEIGHTS,       "Weight0", VT_FLOAT32, 4,            PSO_FLAG_USE_JOINTS},
+            VSAttribInfo{VERTEX_ATTRIB_ID_COLOR,         "Color",   VT_FLOAT32, NumColorComp, PSO_FLAG_USE_VERTEX_COLORS},
+            VSAttribInfo{VERTEX_ATTRIB_ID_TANGENT,       "Tangent", VT_FLOAT32, 3,            PSO_FLAG_USE_VERTEX_TANGENTS},
+            VSAttribInfo{VERTEX_ATTRIB_ID_PREV_POSITION, "PrevPos", VT_FLOAT32, 3,            PSO_FLAG_USE_PREV_POSITIONS}
             // clang-format on
         };
 
@@ -1767,6 +1904,29 @@ void PBR_Renderer::CreatePSO(PsoHashMapType&             PsoHashMap,
         RT0.SrcBlendAlpha  = BLEND_FACTOR_ONE;
         RT0.DestBlendAlpha = BLEND_FACTOR_INV_SRC_ALPHA;
         RT0.BlendOpAlpha   = BLEND_OPERATION_ADD;
+
+        Uint32 UnblendedRTMask = m_Settings.UnblendedRenderTargetsMask;
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+        {
+            // Blending is not supported for integer formats
+            const COMPONENT_TYPE CompType = GetTextureFormatAttribs(GraphicsPipeline.RTVFormats[rt]).ComponentType;
+            if (CompType == COMPONENT_TYPE_UINT || CompType == COMPONENT_TYPE_SINT)
+                UnblendedRTMask |= 1u << rt;
+        }
+
+        if (UnblendedRTMask != 0)
+        {
+            GraphicsPipeline.BlendDesc.IndependentBlendEnable = true;
+
+            const RenderTargetBlendDesc BlendRTDesc = RT0;
+            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            {
+                auto& RT = GraphicsPipeline.BlendDesc.RenderTargets[rt];
+                RT       = BlendRTDesc;
+                if (UnblendedRTMask & (1u << rt))
+                    RT.BlendEnable = false;
+            }
+        }
     }
     else
     {
@@ -1968,11 +2128,111 @@ Uint32 PBR_Renderer::GetPRBFrameAttribsSize() const
     return GetPRBFrameAttribsSize(m_Settings.MaxLightCount, m_Settings.MaxShadowCastingLightCount);
 }
 
+// Converts the rotation and translation of the joint matrix to a unit dual quaternion.
+// The matrix is expected to transform row vectors (v' = v * M).
+static void JointMatrixToDualQuaternion(const float4x4& M, float4& Real, float4& Dual)
+{
+    // Remove scale from the rotation part
+    const float3 Row0 = normalize(float3{M._11, M._12, M._13});
+    const float3 Row1 = normalize(float3{M._21, M._22, M._23});
+    const float3 Row2 = normalize(float3{M._31, M._32, M._33});
+
+    // R[i][j] is the element of the row-vector rotation matrix
+    const float R[3][3] = {
+        {Row0.x, Row0.y, Row0.z},
+        {Row1.x, Row1.y, Row1.z},
+        {Row2.x, Row2.y, Row2.z},
+    };
+
+    const float Trace = R[0][0] + R[1][1] + R[2][2];
+    if (Trace > 0)
+    {
+        const float S = std::sqrt(Trace + 1.f) * 2.f; // S = 4 * w
+        Real.w        = 0.25f * S;
+        Real.x        = (R[1][2] - R[2][1]) / S;
+        Real.y        = (R[2][0] - R[0][2]) / S;
+        Real.z        = (R[0][1] - R[1][0]) / S;
+    }
+    else if (R[0][0] > R[1][1] && R[0][0] > R[2][2])
+    {
+        const float S = std::sqrt(1.f + R[0][0] - R[1][1] - R[2][2]) * 2.f; // S = 4 * x
+        Real.w        = (R[1][2] - R[2][1]) / S;
+        Real.x        = 0.25f * S;
+        Real.y        = (R[1][0] + R[0][1]) / S;
+        Real.z        = (R[2][0] + R[0][2]) / S;
+    }
+    else if (R[1][1] > R[2][2])
+    {
+        const float S = std::sqrt(1.f + R[1][1] - R[0][0] - R[2][2]) * 2.f; // S = 4 * y
+        Real.w        = (R[2][0] - R[0][2]) / S;
+        Real.x        = (R[1][0] + R[0][1]) / S;
+        Real.y        = 0.25f * S;
+        Real.z        = (R[2][1] + R[1][2]) / S;
+    }
+    else
+    {
+        const float S = std::sqrt(1.f + R[2][2] - R[0][0] - R[1][1]) * 2.f; // S = 4 * z
+        Real.w        = (R[0][1] - R[1][0]) / S;
+        Real.x        = (R[2][0] + R[0][2]) / S;
+        Real.y        = (R[2][1] + R[1][2]) / S;
+        Real.z        = 0.25f * S;
+    }
+    Real = normalize(Real);
+
+    // Dual = 0.5 * T * Real, where T = (Translation, 0)
+    const float3 T{M._41, M._42, M._43};
+    const float3 Q{Real.x, Real.y, Real.z};
+    const float3 D = (T * Real.w + cross(T, Q)) * 0.5f;
+    Dual           = float4{D.x, D.y, D.z, -dot(T, Q) * 0.5f};
+}
+
+// Writes joint transforms in the given format and returns the pointer past the last written element.
+static float4* WriteJointTransforms(float4*                     pDst,
+                                    const float4x4*             pMatrices,
+                                    Uint32                      Count,
+                                    PBR_Renderer::JOINTS_FORMAT JointsFormat,
+                                    bool                        PackMatrixRowMajor)
+{
+    static_assert(PBR_Renderer::JOINTS_FORMAT_COUNT == 3, "Please handle the new joints format here");
+    switch (JointsFormat)
+    {
+        case PBR_Renderer::JOINTS_FORMAT_MATRIX4X4:
+            WriteShaderMatrices(reinterpret_cast<float4x4*>(pDst), pMatrices, Count, !PackMatrixRowMajor);
+            return pDst + Count * 4;
+
+        case PBR_Renderer::JOINTS_FORMAT_MATRIX3X4:
+            for (Uint32 i = 0; i < Count; ++i)
+            {
+                // Write the first three columns of the matrix. The last column of an affine
+                // transform is always (0, 0, 0, 1).
+                const float4x4& M = pMatrices[i];
+
+                *pDst++ = float4{M._11, M._21, M._31, M._41};
+                *pDst++ = float4{M._12, M._22, M._32, M._42};
+                *pDst++ = float4{M._13, M._23, M._33, M._43};
+            }
+            return pDst;
+
+        case PBR_Renderer::JOINTS_FORMAT_DUAL_QUATERNION:
+            for (Uint32 i = 0; i < Count; ++i)
+            {
+                JointMatrixToDualQuaternion(pMatrices[i], pDst[0], pDst[1]);
+                pDst += 2;
+            }
+            return pDst;
+
+        default:
+            UNEXPECTED("Unexpected joints format");
+            return pDst;
+    }
+}
+
 void* PBR_Renderer::WriteSkinningData(void*                           _pDst,
                                       const WriteSkinningDataAttribs& Attribs,
                                       bool                            PackMatrixRowMajor,
                                       Uint32                          MaxJointCount,
-                                      bool                            UseSkinPreTransform)
+                                      bool                            UseSkinPreTransform,
+                                      JOINTS_FORMAT                   JointsFormat)
 {
     Uint32 JointCount = Attribs.JointCount;
     if (JointCount > MaxJointCount)
@@ -1981,7 +2241,7 @@ void* PBR_Renderer::WriteSkinningData(void*                           _pDst,
         JointCount = MaxJointCount;
     }
 
-    float4x4* pDst = static_cast<float4x4*>(_pDst);
+    float4* pDst = static_cast<float4*>(_pDst);
 
     const bool UsePrevFrameTransforms = (Attribs.PSOFlags & PBR_Renderer::PSO_FLAG_COMPUTE_MOTION_VECTORS) != 0;
     if (UseSkinPreTransform)
@@ -1990,49 +2250,52 @@ void* PBR_Renderer::WriteSkinningData(void*                           _pDst,
 
         // g_Skin.PreTransform
         const float4x4& PreTransform = Attribs.PreTransform != nullptr ? *Attribs.PreTransform : Identity;
-        WriteShaderMatrix(pDst++, PreTransform, !PackMatrixRowMajor);
+        WriteShaderMatrix(reinterpret_cast<float4x4*>(pDst), PreTransform, !PackMatrixRowMajor);
+        pDst += 4;
 
         if (UsePrevFrameTransforms)
         {
             // g_Skin.PrevPreTransform
             const float4x4& PrevPreTransform = Attribs.PrevPreTransform != nullptr ? *Attribs.PrevPreTransform : Identity;
-            WriteShaderMatrix(pDst++, PrevPreTransform, !PackMatrixRowMajor);
+            WriteShaderMatrix(reinterpret_cast<float4x4*>(pDst), PrevPreTransform, !PackMatrixRowMajor);
+            pDst += 4;
         }
     }
 
+    const Uint32 JointDataSize = GetJointDataSize(JointsFormat);
     if (Attribs.JointMatrices != nullptr)
     {
         // g_Skin.Joints
-        WriteShaderMatrices(pDst, Attribs.JointMatrices, JointCount, !PackMatrixRowMajor);
+        WriteJointTransforms(pDst, Attribs.JointMatrices, JointCount, JointsFormat, PackMatrixRowMajor);
     }
     else
     {
         DEV_ERROR("Joint matrices are not provided");
     }
-    pDst += JointCount;
+    pDst += JointCount * JointDataSize / sizeof(float4);
 
     if (UsePrevFrameTransforms)
     {
         if (Attribs.PrevJointMatrices != nullptr)
         {
             // g_Skin.Joints
-            WriteShaderMatrices(pDst, Attribs.PrevJointMatrices, JointCount, !PackMatrixRowMajor);
+            WriteJointTransforms(pDst, Attribs.PrevJointMatrices, JointCount, JointsFormat, PackMatrixRowMajor);
         }
         else
         {
             DEV_ERROR("Previous joint matrices are not provided");
         }
-        pDst += JointCount;
+        pDst += JointCount * JointDataSize / sizeof(float4);
     }
 
-    VERIFY_EXPR(static_cast<Uint32>(pDst - static_cast<float4x4*>(_pDst)) * sizeof(float4x4) == GetJointsDataSize(JointCount, UseSkinPreTransform, UsePrevFrameTransforms));
+    VERIFY_EXPR(static_cast<Uint32>(pDst - static_cast<float4*>(_pDst)) * sizeof(float4) == GetJointsDataSize(JointCount, UseSkinPreTransform, UsePrevFrameTransforms, JointsFormat));
 
     return pDst;
 }
 
 void* PBR_Renderer::WriteSkinningData(void* pDst, const WriteSkinningDataAttribs& Attribs)
 {
-    return WriteSkinningData(pDst, Attribs, m_Settings.PackMatrixRowMajor, m_Settings.MaxJointCount, m_Settings.UseSkinPreTransform);
+    return WriteSkinningData(pDst, Attribs, m_Settings.PackMatrixRowMajor, m_Settings.MaxJointCount, m_Settings.UseSkinPreTransform, m_Settings.JointsFormat);
 }
 
 } // namespace Diligent
@@ -51,7 +51,7 @@ USD_Renderer::CreateInfo::PSMainSourceInfo USD_Renderer::GetUsdPbrPSMainSource(U
             ss << "    float4 Color      : SV_Target" << m_ColorTargetIndex << ';' << std::endl;
 
         if (PSOFlags & USD_PSO_FLAG_ENABLE_MESH_ID_OUTPUT)
-            ss << "    float4 MeshID     : SV_Target" << m_MeshIdTargetIndex << ';' << std::endl;
+            ss << (m_UintMeshIdOutput ? "    uint4  MeshID     : SV_Target" : "    float4 MeshID     : SV_Target") << m_MeshIdTargetIndex << ';' << std::endl;
 
         if (PSOFlags & USD_PSO_FLAG_ENABLE_MOTION_VECTORS_OUTPUT)
             ss << "    float4 MotionVec  : SV_Target" << m_MotionVectorTargetIndex << ';' << std::endl;
@@ -62,7 +62,7 @@ USD_Renderer::CreateInfo::PSMainSourceInfo USD_Renderer::GetUsdPbrPSMainSource(U
         if (PSOFlags & USD_PSO_FLAG_ENABLE_BASE_COLOR_OUTPUT)
             ss << "    float4 BaseColor  : SV_Target" << m_BaseColorTargetIndex << ';' << std::endl;
 
-        if (PSOFlags & USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT)
+        if ((PSOFlags & USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT) && !m_PackedMaterialOutput)
             ss << "    float4 Material   : SV_Target" << m_MaterialDataTargetIndex << ';' << std::endl;
 
         if (PSOFlags & USD_PSO_FLAG_ENABLE_IBL_OUTPUT)
@@ -132,7 +132,10 @@ USD_Renderer::CreateInfo::PSMainSourceInfo USD_Renderer::GetUsdPbrPSMainSource(U
         // It is important to set alpha to 1.0 as all targets are rendered with the same blend mode
         if (PSOFlags & USD_PSO_FLAG_ENABLE_MESH_ID_OUTPUT)
         {
-            ss << "    PSOut.MeshID = float4(MeshId, 0.0, 0.0, 1.0);" << std::endl;
+            if (m_UintMeshIdOutput)
+                ss << "    PSOut.MeshID = uint4(uint(max(MeshId, 0.0)), 0u, 0u, 1u);" << std::endl;
+            else
+                ss << "    PSOut.MeshID = float4(MeshId, 0.0, 0.0, 1.0);" << std::endl;
         }
 
         if (PSOFlags & USD_PSO_FLAG_ENABLE_MOTION_VECTORS_OUTPUT)
@@ -144,7 +147,12 @@ USD_Renderer::CreateInfo::PSMainSourceInfo USD_Renderer::GetUsdPbrPSMainSource(U
         if (PSOFlags & USD_PSO_FLAG_ENABLE_NORMAL_OUTPUT)
         {
             // Do not blend normal - we want normal of the top layer
-            ss << "    PSOut.Normal = float4(Normal, 1.0);" << std::endl;
+            if (m_PackedMaterialOutput)
+                ss << "    PSOut.Normal = float4(EncodeNormalOctahedron(Normal), MaterialData);" << std::endl;
+            else if (m_PackedNormalOutput)
+                ss << "    PSOut.Normal = float4(EncodeNormalOctahedron(Normal), 0.0, 1.0);" << std::endl;
+            else
+                ss << "    PSOut.Normal = float4(Normal, 1.0);" << std::endl;
         }
 
         // Blend base color, material data and IBL with background
@@ -154,7 +162,7 @@ USD_Renderer::CreateInfo::PSMainSourceInfo USD_Renderer::GetUsdPbrPSMainSource(U
             ss << "    PSOut.BaseColor = float4(BaseColor.rgb * BaseColor.a, BaseColor.a);" << std::endl;
         }
 
-        if (PSOFlags & USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT)
+        if ((PSOFlags & USD_PSO_FLAG_ENABLE_MATERIAL_DATA_OUTPUT) && !m_PackedMaterialOutput)
         {
             ss << "    PSOut.Material = float4(MaterialData * BaseColor.a, 0.0, BaseColor.a);" << std::endl;
         }
@@ -189,6 +197,12 @@ struct USD_Renderer::USDRendererCreateInfoWrapper
         {
             CI.GetPSMainSource = std::bind(&USD_Renderer::GetUsdPbrPSMainSource, &Renderer, std::placeholders::_1);
         }
+
+        if (CI.PackedMaterialOutput && CI.NormalTargetIndex != ~0u)
+        {
+            // Packed normal and material data must not be blended
+            CI.UnblendedRenderTargetsMask |= 1u << CI.NormalTargetIndex;
+        }
     }
 
     operator const PBR_Renderer::CreateInfo &() const
@@ -216,7 +230,10 @@ USD_Renderer::USD_Renderer(IRenderDevice*     pDevice,
     m_NormalTargetIndex{CI.NormalTargetIndex},
     m_BaseColorTargetIndex{CI.BaseColorTargetIndex},
     m_MaterialDataTargetIndex{CI.MaterialDataTargetIndex},
-    m_IBLTargetIndex{CI.IBLTargetIndex}
+    m_IBLTargetIndex{CI.IBLTargetIndex},
+    m_PackedNormalOutput{CI.PackedNormalOutput || CI.PackedMaterialOutput},
+    m_PackedMaterialOutput{CI.PackedMaterialOutput},
+    m_UintMeshIdOutput{CI.UintMeshIdOutput}
 {
 #ifdef DILIGENT_DEVELOPMENT
     {
@@ -253,6 +270,9 @@ void USD_Renderer::CreateCustomSignature(PipelineResourceSignatureDescX&& Signat
     FrameResources.emplace("g_SheenAlbedoScalingLUT");
     FrameResources.emplace("g_ShadowMap");
     FrameResources.emplace("g_ShadowMap_sampler");
+    FrameResources.emplace("g_ClusteredLights");
+    FrameResources.emplace("g_LightClusters");
+    FrameResources.emplace("g_ClusterLightIndices");
     // Only move separate samplers to the frame signature.
     // Combined GL samplers should stay in the resource signature.
     FrameResources.emplace("g_LinearClampSampler");
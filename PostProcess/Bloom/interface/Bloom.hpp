@@ -52,7 +52,11 @@ class Bloom
 public:
     enum FEATURE_FLAGS : Uint32
     {
-        FEATURE_FLAG_NONE = 0u
+        FEATURE_FLAG_NONE = 0u,
+
+        // When this flag is used, the mip chain starts at quarter resolution instead of half resolution.
+        // The flag does not affect the shaders, so it can be toggled at run time without creating new PSOs.
+        FEATURE_FLAG_HALF_RESOLUTION = 1u << 0u
     };
 
     struct RenderAttributes
@@ -128,6 +132,10 @@ private:
 
     void ComputePlaceholderTexture(const RenderAttributes& RenderAttribs);
 
+    bool AcquireMipChain(const RenderAttributes& RenderAttribs);
+
+    void ReleaseMipChain(const RenderAttributes& RenderAttribs);
+
     Int32 ComputeMipCount(Uint32 Width, Uint32 Height, float Radius);
 
     RenderTechnique& GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags);
@@ -153,7 +161,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -164,6 +172,9 @@ private:
 
     std::unique_ptr<HLSL::BloomAttribs> m_BloomAttribs;
 
+    // The mip chain is only needed during Execute() and is acquired
+    // from the transient texture pool of the PostFXContext.
+    std::vector<TextureDesc>             m_MipChainDescs;
     std::vector<RefCntAutoPtr<ITexture>> m_DownsampledTextures;
     std::vector<RefCntAutoPtr<ITexture>> m_UpsampledTextures;
 
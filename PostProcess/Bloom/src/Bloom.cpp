@@ -90,38 +90,24 @@ void Bloom::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDeviceCont
     m_BackBufferHeight = FrameDesc.Height;
     m_FeatureFlags     = FeatureFlags;
 
-    Uint32 HalfWidth    = m_BackBufferWidth / 2u;
-    Uint32 HalfHeight   = m_BackBufferHeight / 2u;
-    Uint32 TextureCount = ComputeMipLevelsCount(HalfWidth, HalfHeight);
+    const Uint32 BaseLevel    = (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) ? 2u : 1u;
+    const Uint32 BaseWidth    = std::max(m_BackBufferWidth >> BaseLevel, 1u);
+    const Uint32 BaseHeight   = std::max(m_BackBufferHeight >> BaseLevel, 1u);
+    const Uint32 TextureCount = ComputeMipLevelsCount(BaseWidth, BaseHeight);
 
     RenderDeviceWithCache_N Device{pDevice};
 
-    m_UpsampledTextures.clear();
+    m_MipChainDescs.clear();
     for (Uint32 TextureIdx = 0; TextureIdx < TextureCount; TextureIdx++)
     {
         TextureDesc Desc;
-        Desc.Name      = "Bloom::UpsampledTexture";
         Desc.Type      = RESOURCE_DIM_TEX_2D;
-        Desc.Width     = std::max(HalfWidth >> TextureIdx, 1u);
-        Desc.Height    = std::max(HalfHeight >> TextureIdx, 1u);
+        Desc.Width     = std::max(BaseWidth >> TextureIdx, 1u);
+        Desc.Height    = std::max(BaseHeight >> TextureIdx, 1u);
         Desc.Format    = TEX_FORMAT_R11G11B10_FLOAT;
         Desc.MipLevels = 1;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_UpsampledTextures.push_back(Device.CreateTexture(Desc));
-    }
-
-    m_DownsampledTextures.clear();
-    for (Uint32 TextureIdx = 0; TextureIdx < TextureCount; TextureIdx++)
-    {
-        TextureDesc Desc;
-        Desc.Name      = "Bloom::DownsampledTexture";
-        Desc.Type      = RESOURCE_DIM_TEX_2D;
-        Desc.Width     = std::max(HalfWidth >> TextureIdx, 1u);
-        Desc.Height    = std::max(HalfHeight >> TextureIdx, 1u);
-        Desc.Format    = TEX_FORMAT_R11G11B10_FLOAT;
-        Desc.MipLevels = 1;
-        Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_DownsampledTextures.push_back(Device.CreateTexture(Desc));
+        m_MipChainDescs.push_back(Desc);
     }
 
     {
@@ -147,8 +133,12 @@ void Bloom::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDeviceCont
 
 Int32 Bloom::ComputeMipCount(Uint32 Width, Uint32 Height, float Radius)
 {
-    Uint32 MaxMipCount = ComputeMipLevelsCount(Width, Height);
-    return static_cast<Int32>(Radius * static_cast<float>(MaxMipCount));
+    // In half-resolution mode, the chain does not have the half-resolution level.
+    // Count the levels as if it had one, so that the bloom covers the same screen area.
+    const Int32 SkippedLevels = (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) ? 1 : 0;
+
+    Uint32 MaxMipCount = ComputeMipLevelsCount(Width << SkippedLevels, Height << SkippedLevels);
+    return static_cast<Int32>(Radius * static_cast<float>(MaxMipCount)) - SkippedLevels;
 }
 
 bool Bloom::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags)
@@ -379,6 +369,51 @@ void Bloom::ComputePlaceholderTexture(const RenderAttributes& RenderAttribs)
     RenderAttribs.pPostFXContext->CopyTextureColor(CopyTextureAttribs, m_Resources[RESOURCE_IDENTIFIER_INPUT_COLOR].GetTextureSRV(), m_Resources[RESOURCE_IDENTIFIER_OUTPUT_COLOR].GetTextureRTV());
 }
 
+bool Bloom::AcquireMipChain(const RenderAttributes& RenderAttribs)
+{
+    VERIFY(m_DownsampledTextures.empty() && m_UpsampledTextures.empty(), "Mip chain has not been released");
+
+    if (m_MipChainDescs.empty())
+        return false;
+
+    // Only acquire the levels that are used with the current radius. The upsampling
+    // pass does not write the last level, so the upsampled chain is one level shorter.
+    const Int32  MipCount            = ComputeMipCount(m_MipChainDescs[0].Width, m_MipChainDescs[0].Height, RenderAttribs.pBloomAttribs->Radius);
+    const size_t DownsampledMipCount = std::min(static_cast<size_t>(std::max(MipCount, 2)), m_MipChainDescs.size());
+    const size_t UpsampledMipCount   = std::max(DownsampledMipCount - 1, size_t{1});
+
+    for (size_t TextureIdx = 0; TextureIdx < DownsampledMipCount; ++TextureIdx)
+    {
+        TextureDesc Desc = m_MipChainDescs[TextureIdx];
+
+        Desc.Name = "Bloom::DownsampledTexture";
+        m_DownsampledTextures.emplace_back(RenderAttribs.pPostFXContext->AcquireTransientTexture(RenderAttribs.pDevice, Desc));
+        if (!m_DownsampledTextures.back())
+            return false;
+
+        if (TextureIdx < UpsampledMipCount)
+        {
+            Desc.Name = "Bloom::UpsampledTexture";
+            m_UpsampledTextures.emplace_back(RenderAttribs.pPostFXContext->AcquireTransientTexture(RenderAttribs.pDevice, Desc));
+            if (!m_UpsampledTextures.back())
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void Bloom::ReleaseMipChain(const RenderAttributes& RenderAttribs)
+{
+    for (ITexture* pTexture : m_DownsampledTextures)
+        RenderAttribs.pPostFXContext->ReleaseTransientTexture(pTexture);
+    for (ITexture* pTexture : m_UpsampledTextures)
+        RenderAttribs.pPostFXContext->ReleaseTransientTexture(pTexture);
+
+    m_DownsampledTextures.clear();
+    m_UpsampledTextures.clear();
+}
+
 void Bloom::Execute(const RenderAttributes& RenderAttribs)
 {
     DEV_CHECK_ERR(RenderAttribs.pDevice != nullptr, "RenderAttribs.pDevice must not be null");
@@ -392,7 +427,8 @@ void Bloom::Execute(const RenderAttributes& RenderAttribs)
 
     ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "Bloom"};
 
-    bool AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
+    const bool MipChainReady = AcquireMipChain(RenderAttribs);
+    const bool AllPSOsReady  = MipChainReady && PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
     UpdateConstantBuffer(RenderAttribs, !AllPSOsReady);
     if (AllPSOsReady)
     {
@@ -405,6 +441,9 @@ void Bloom::Execute(const RenderAttributes& RenderAttribs)
         ComputePlaceholderTexture(RenderAttribs);
     }
 
+    // Return the mip chain to the pool so that it can be reused by other effects
+    ReleaseMipChain(RenderAttribs);
+
     // Release references to input resources
     for (Uint32 ResourceIdx = 0; ResourceIdx <= RESOURCE_IDENTIFIER_INPUT_LAST; ++ResourceIdx)
         m_Resources[ResourceIdx].Release();
@@ -412,6 +451,9 @@ void Bloom::Execute(const RenderAttributes& RenderAttribs)
 
 Bloom::RenderTechnique& Bloom::GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags)
 {
+    // The resolution of the mip chain does not affect the shaders, so all modes share the same PSOs
+    FeatureFlags &= ~FEATURE_FLAG_HALF_RESOLUTION;
+
     auto Iter = m_RenderTech.find({RenderTech, FeatureFlags});
     if (Iter != m_RenderTech.end())
         return Iter->second;
@@ -427,6 +469,8 @@ ITextureView* Bloom::GetBloomTextureSRV() const
 
 bool Bloom::UpdateUI(HLSL::BloomAttribs& Attribs, FEATURE_FLAGS& FeatureFlags)
 {
+    bool ActiveHalfResolution = (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0;
+
     bool AttribsChanged = false;
 
     if (ImGui::SliderFloat("Intensity", &Attribs.Intensity, 0.0f, 1.0f))
@@ -445,6 +489,15 @@ bool Bloom::UpdateUI(HLSL::BloomAttribs& Attribs, FEATURE_FLAGS& FeatureFlags)
         AttribsChanged = true;
     ImGui::HelpMarker("This value determines the softness of the threshold. A higher value will result in a softer threshold.");
 
+    if (ImGui::Checkbox("Half Resolution", &ActiveHalfResolution))
+        AttribsChanged = true;
+    ImGui::HelpMarker("Compute the bloom starting at quarter resolution. This reduces the cost of the effect at the expense of slightly less stable highlights.");
+
+    if (ActiveHalfResolution)
+        FeatureFlags |= FEATURE_FLAG_HALF_RESOLUTION;
+    else
+        FeatureFlags &= ~FEATURE_FLAG_HALF_RESOLUTION;
+
     return AttribsChanged;
 }
 
@@ -28,6 +28,7 @@
 
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "../../../../DiligentCore/Graphics/GraphicsTools/interface/RenderStateCache.h"
@@ -51,8 +52,11 @@ public:
     enum FEATURE_FLAGS : Uint32
     {
         FEATURE_FLAG_NONE                 = 0u,
-        FEATURE_FLAG_REVERSED_DEPTH       = 1u << 0u, // Not implemented
-        FEATURE_FLAG_HALF_PRECISION_DEPTH = 1u << 1u
+        FEATURE_FLAG_REVERSED_DEPTH       = 1u << 0u,
+        FEATURE_FLAG_HALF_PRECISION_DEPTH = 1u << 1u,
+
+        /// Compute the closest/farthest depth hierarchy of the current depth buffer (see GetDepthHierarchy()).
+        FEATURE_FLAG_DEPTH_HIERARCHY      = 1u << 2u
     };
 
     struct FrameDesc
@@ -103,6 +107,22 @@ public:
         IDeviceContext* pDeviceContext = nullptr;
     };
 
+    /// Describes a transient texture of an effect, see AcquireTransientTextures().
+    struct TransientTextureAttribs
+    {
+        /// Index of the texture in the resource registry of the effect.
+        Uint32 ResourceId = 0;
+
+        /// Texture description. The name is only used when a new texture is created.
+        TextureDesc Desc;
+
+        /// Index of the first pass of the effect that reads or writes the texture.
+        Uint32 FirstPass = 0;
+
+        /// Index of the last pass of the effect that reads or writes the texture.
+        Uint32 LastPass = 0;
+    };
+
     enum BLUE_NOISE_DIMENSION : Uint32
     {
         BLUE_NOISE_DIMENSION_XY = 0,
@@ -116,12 +136,22 @@ public:
         bool TextureSubresourceViews = false;
         bool CopyDepthToColor        = false;
         bool ShaderBaseVertexOffset  = false; /// Indicates whether the Base Vertex is added to the VertexID in the vertex shader.
+        bool SinglePassDownsampling  = false; /// Indicates whether the depth hierarchy can be computed by the single-pass compute downsampler.
     };
 
     struct CreateInfo
     {
         bool EnableAsyncCreation = false;
         bool PackMatrixRowMajor  = false;
+
+        /// Immediate contexts that the camera attributes buffer and the blue noise textures are created for.
+        ///
+        /// \remarks    Effects that record passes on an async compute context (see
+        ///             ScreenSpaceAmbientOcclusion::CreateInfo::pAsyncComputeContext) read these resources,
+        ///             so the mask must include both the main and the async compute contexts.
+        ///             When the mask contains more than one context, the camera attributes buffer
+        ///             is created with USAGE_DEFAULT, as dynamic buffers can't be shared between contexts.
+        Uint64 ImmediateContextMask = 1;
     };
 
 public:
@@ -147,6 +177,35 @@ public:
 
     ITextureView* GetClosestMotionVectors() const;
 
+    /// Returns the shader resource view of the depth hierarchy of the current frame, or null
+    /// if the context was not prepared with FEATURE_FLAG_DEPTH_HIERARCHY and no effect
+    /// requested the hierarchy with RequestDepthHierarchy().
+    ///
+    /// The hierarchy contains the full mip chain of the depth buffer. The x component of every texel
+    /// contains the closest depth, and the y component contains the farthest depth of the
+    /// corresponding region of the depth buffer. The hierarchy is built once per frame and is shared
+    /// by all effects (e.g. SSR, SSAO), and may also be used for GPU occlusion culling.
+    ///
+    /// \remarks    Mip 0 is a full-resolution copy of the depth buffer with both components set to the same
+    ///             depth, so effects can sample the hierarchy at any level with the same view. In the full
+    ///             precision RG32F format, it takes twice as much memory as a 32-bit depth buffer, and the
+    ///             whole chain takes about 2.7 times as much. Use FEATURE_FLAG_HALF_PRECISION_DEPTH to store
+    ///             the hierarchy in RG16 instead.
+    ///
+    ///             When SupportedDeviceFeatures::SinglePassDownsampling is true and the hierarchy uses the full
+    ///             precision format, five mip levels are computed by every compute dispatch instead of
+    ///             rendering one mip level per pass.
+    ITextureView* GetDepthHierarchy() const;
+
+    /// Makes the context compute the depth hierarchy (see GetDepthHierarchy()) even if
+    /// PrepareResources() was called without FEATURE_FLAG_DEPTH_HIERARCHY.
+    ///
+    /// \remarks    Effects that read the hierarchy call this method from their PrepareResources(),
+    ///             which must be called after PostFXContext::PrepareResources() and before
+    ///             PostFXContext::Execute(). The request lasts until the next frame, so the hierarchy
+    ///             is released when no effect requests it anymore.
+    void RequestDepthHierarchy(IRenderDevice* pDevice);
+
     IBuffer* GetCameraAttribsCB() const;
 
     const SupportedDeviceFeatures& GetSupportedFeatures() const
@@ -165,7 +224,75 @@ public:
 
     void CopyTextureColor(const TextureOperationAttribs& attribs, ITextureView* pSRV, ITextureView* pRTV);
 
+    /// Creates the pipeline state used by BilateralUpsample() to render into the target of the given format.
+    ///
+    /// \return     true if the pipeline state is ready, and false otherwise.
+    ///
+    /// \remarks    Effects with reduced-resolution modes call this method in every mode, so that
+    ///             switching between the modes at run time does not create pipeline states.
+    bool PrepareBilateralUpsampling(const TextureOperationAttribs& Attribs, TEXTURE_FORMAT RTVFormat);
+
+    /// Upsamples a reduced-resolution texture to the full resolution with the depth-aware bilateral filter.
+    ///
+    /// \param [in] Attribs    - Texture operation attributes.
+    /// \param [in] pSourceSRV - Shader resource view of the reduced-resolution texture.
+    /// \param [in] pDepthSRV  - Shader resource view of the full-resolution depth that guides the upsampling.
+    /// \param [in] pRTV       - Render target view of the full-resolution texture.
+    ///
+    /// \remarks    Every texel of the source texture must contain the value of the full-resolution pixel
+    ///             given by GetBilateralUpsamplingSourcePixel() in BilateralUpsampling.fxh.
+    ///             PrepareBilateralUpsampling() must have returned true for the format of the render target.
+    void BilateralUpsample(const TextureOperationAttribs& Attribs, ITextureView* pSourceSRV, ITextureView* pDepthSRV, ITextureView* pRTV);
+
+    /// Returns a transient texture from the pool shared by all effects that use this context.
+    ///
+    /// \param [in] pDevice - Render device that is used to create a new texture if the pool
+    ///                       does not contain a free compatible texture.
+    /// \param [in] Desc    - Texture description. The texture must use USAGE_DEFAULT.
+    ///
+    /// \remarks    Transient textures hold intermediate data that is only needed while an effect is
+    ///             executed (e.g. the bloom mip chain). Their contents are undefined when they are acquired,
+    ///             and they must be returned to the pool with ReleaseTransientTexture() as soon as they
+    ///             are no longer needed, so that the effects executed next can reuse them.
+    ///             A free texture is compatible if it only differs from the description in the name
+    ///             and has all of the requested bind flags.
+    ///             Free textures that have not been used for several frames, as well as all free textures
+    ///             when the frame size changes, are released in PrepareResources().
+    RefCntAutoPtr<ITexture> AcquireTransientTexture(IRenderDevice* pDevice, const TextureDesc& Desc);
+
+    /// Returns the transient texture to the pool.
+    void ReleaseTransientTexture(ITexture* pTexture);
+
+    /// Acquires the transient textures of an effect and inserts them into the resource registry of the effect.
+    ///
+    /// \param [in] pDevice     - Render device that is used to create new textures.
+    /// \param [in] pTextures   - Transient textures of the effect.
+    /// \param [in] NumTextures - Number of elements in pTextures.
+    /// \param [in] Resources   - Resource registry of the effect.
+    ///
+    /// \return     true if all textures have been acquired, and false otherwise.
+    ///
+    /// \remarks    Compatible textures whose lifetimes, given by [FirstPass, LastPass], don't overlap
+    ///             share the same texture, so the passes of the effect must only access the texture
+    ///             during its lifetime. The contents of the textures are undefined, so a pass that only
+    ///             writes a part of a texture (e.g. using a stencil mask) must clear it if other passes
+    ///             read the rest of it. The textures must be released with ReleaseTransientTextures().
+    bool AcquireTransientTextures(IRenderDevice* pDevice, const TransientTextureAttribs* pTextures, Uint32 NumTextures, ResourceRegistry& Resources);
+
+    /// Returns the transient textures acquired by AcquireTransientTextures() to the pool
+    /// and removes them from the resource registry of the effect.
+    void ReleaseTransientTextures(const TransientTextureAttribs* pTextures, Uint32 NumTextures, ResourceRegistry& Resources);
+
+    /// Returns the total number of textures owned by the transient texture pool, including the textures in use.
+    Uint32 GetTransientTextureCount() const
+    {
+        return m_TransientTextureCount;
+    }
+
 private:
+    // Measures the render technique cache key hashing and lookup without a render device
+    friend class PostFXContextBenchmark;
+
     using RenderTechnique  = PostFXRenderTechnique;
     using ResourceInternal = RefCntAutoPtr<IDeviceObject>;
 
@@ -175,9 +302,12 @@ private:
         RENDER_TECH_COMPUTE_REPROJECTED_DEPTH,
         RENDER_TECH_COMPUTE_CLOSEST_MOTION,
         RENDER_TECH_COMPUTE_PREVIOUS_DEPTH,
-        RENDER_TECH_INTERNAL_LAST = RENDER_TECH_COMPUTE_PREVIOUS_DEPTH,
+        RENDER_TECH_COMPUTE_DEPTH_HIERARCHY_FIRST_MIP,
+        RENDER_TECH_COMPUTE_DEPTH_HIERARCHY,
+        RENDER_TECH_INTERNAL_LAST = RENDER_TECH_COMPUTE_DEPTH_HIERARCHY,
         RENDER_TECH_COPY_DEPTH,
         RENDER_TECH_COPY_COLOR,
+        RENDER_TECH_BILATERAL_UPSAMPLING,
         RENDER_TECH_COUNT
     };
 
@@ -196,6 +326,9 @@ private:
         RESOURCE_IDENTIFIER_REPROJECTED_DEPTH,
         RESOURCE_IDENTIFIER_PREVIOUS_DEPTH,
         RESOURCE_IDENTIFIER_CLOSEST_MOTION,
+        RESOURCE_IDENTIFIER_DEPTH_HIERARCHY,
+        RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE,
+        RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_CONSTANT_BUFFER,
         RESOURCE_IDENTIFIER_COUNT
     };
 
@@ -209,6 +342,14 @@ private:
 
     void ComputePreviousDepth(const RenderAttributes& RenderAttribs);
 
+    void ComputeDepthHierarchy(const RenderAttributes& RenderAttribs);
+
+    void ComputeDepthHierarchySinglePass(const RenderAttributes& RenderAttribs);
+
+    bool UseSinglePassDepthHierarchy(FEATURE_FLAGS FeatureFlags) const;
+
+    void CreateDepthHierarchy(IRenderDevice* pDevice);
+
     RenderTechnique& GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags, TEXTURE_FORMAT TextureFormat);
 
 private:
@@ -235,7 +376,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags, Key.TextureFormat);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags, Key.TextureFormat);
             }
         };
     };
@@ -244,6 +385,68 @@ private:
 
     ResourceRegistry m_Resources{RESOURCE_IDENTIFIER_COUNT};
 
+    std::vector<RefCntAutoPtr<ITextureView>> m_DepthHierarchyMipMapRTV;
+    std::vector<RefCntAutoPtr<ITextureView>> m_DepthHierarchyMipMapSRV;
+    std::vector<RefCntAutoPtr<ITextureView>> m_DepthHierarchyMipMapUAV;
+
+    /// Transient textures are interchangeable if they only differ in the name and bind flags.
+    struct TransientTextureKey
+    {
+        const RESOURCE_DIMENSION Type;
+        const Uint32             Width;
+        const Uint32             Height;
+        const Uint32             ArraySizeOrDepth;
+        const TEXTURE_FORMAT     Format;
+        const Uint32             MipLevels;
+        const Uint32             SampleCount;
+        const MISC_TEXTURE_FLAGS MiscFlags;
+        const Uint64             ImmediateContextMask;
+
+        explicit TransientTextureKey(const TextureDesc& Desc) :
+            Type{Desc.Type},
+            Width{Desc.Width},
+            Height{Desc.Height},
+            ArraySizeOrDepth{Desc.ArraySizeOrDepth},
+            Format{Desc.Format},
+            MipLevels{Desc.MipLevels},
+            SampleCount{Desc.SampleCount},
+            MiscFlags{Desc.MiscFlags},
+            ImmediateContextMask{Desc.ImmediateContextMask}
+        {}
+
+        constexpr bool operator==(const TransientTextureKey& RHS) const
+        {
+            return Type == RHS.Type &&
+                Width == RHS.Width &&
+                Height == RHS.Height &&
+                ArraySizeOrDepth == RHS.ArraySizeOrDepth &&
+                Format == RHS.Format &&
+                MipLevels == RHS.MipLevels &&
+                SampleCount == RHS.SampleCount &&
+                MiscFlags == RHS.MiscFlags &&
+                ImmediateContextMask == RHS.ImmediateContextMask;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const TransientTextureKey& Key) const
+            {
+                return ComputeHash(Key.Type, Key.Width, Key.Height, Key.ArraySizeOrDepth, Key.Format, Key.MipLevels, Key.SampleCount, Key.MiscFlags, Key.ImmediateContextMask);
+            }
+        };
+    };
+
+    struct FreeTransientTexture
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        Uint32                  IdleFrameCount = 0;
+    };
+
+    /// Free textures of the transient pool grouped by compatible descriptions.
+    std::unordered_map<TransientTextureKey, std::vector<FreeTransientTexture>, TransientTextureKey::Hasher> m_FreeTransientTextures;
+
+    Uint32 m_TransientTextureCount = 0;
+
     FrameDesc               m_FrameDesc               = {};
     SupportedDeviceFeatures m_SupportedFeatures       = {};
     bool                    m_PSOsReady               = false;
@@ -253,6 +456,8 @@ private:
     RefCntAutoPtr<IShader> m_pPSCopyTexture;
 
     FEATURE_FLAGS m_FeatureFlags = FEATURE_FLAG_NONE;
+    // Features requested by effects since the last call to PrepareResources()
+    FEATURE_FLAGS m_RequestedFeatureFlags = FEATURE_FLAG_NONE;
     CreateInfo    m_Settings;
 };
 
@@ -59,6 +59,14 @@ struct PostFXRenderTechnique
                        bool                               IsDSVReadOnly,
                        PSO_CREATE_FLAGS                   PSOFlags = PSO_CREATE_FLAG_NONE);
 
+    void InitializePSO(IRenderDevice*                    pDevice,
+                       IRenderStateCache*                pStateCache,
+                       const char*                       PSOName,
+                       IShader*                          ComputeShader,
+                       const PipelineResourceLayoutDesc& ResourceLayout,
+                       PSO_CREATE_FLAGS                  PSOFlags             = PSO_CREATE_FLAG_NONE,
+                       Uint64                            ImmediateContextMask = 1);
+
     void InitializeSRB(bool InitStaticResources);
 
     bool IsInitializedPSO() const
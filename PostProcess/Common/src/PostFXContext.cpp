@@ -26,6 +26,8 @@
 
 #include "PostFXContext.hpp"
 
+#include <algorithm>
+
 #include "CommonlyUsedStates.h"
 #include "GraphicsTypesX.hpp"
 #include "GraphicsUtilities.h"
@@ -147,6 +149,13 @@ PostFXContext::PostFXContext(IRenderDevice* pDevice, const CreateInfo& CI) :
     m_SupportedFeatures.CopyDepthToColor        = DeviceInfo.IsD3DDevice();
     m_SupportedFeatures.ShaderBaseVertexOffset  = !DeviceInfo.IsD3DDevice();
 
+    // The single-pass downsampler reads the last mip level of the previous dispatch while writing the next
+    // mip levels of the same texture, which requires explicit subresource transitions.
+    m_SupportedFeatures.SinglePassDownsampling = (DeviceInfo.Features.ComputeShaders &&
+                                                  m_SupportedFeatures.TransitionSubresources &&
+                                                  m_SupportedFeatures.TextureSubresourceViews &&
+                                                  (pDevice->GetTextureFormatInfoExt(TEX_FORMAT_RG32_FLOAT).BindFlags & BIND_UNORDERED_ACCESS) != 0);
+
     RenderDeviceWithCache_N Device{pDevice};
     {
         TextureDesc Desc;
@@ -201,9 +210,18 @@ PostFXContext::PostFXContext(IRenderDevice* pDevice, const CreateInfo& CI) :
         Desc.MipLevels = 1;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
 
+        Desc.ImmediateContextMask = CI.ImmediateContextMask;
+
         m_Resources.Insert(TextureIdx, Device.CreateTexture(Desc, nullptr));
     }
 
+    if (m_SupportedFeatures.SinglePassDownsampling)
+    {
+        RefCntAutoPtr<IBuffer> pBuffer;
+        CreateUniformBuffer(pDevice, sizeof(uint4), "PostFXContext::DepthHierarchyConstantBuffer", &pBuffer);
+        m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_CONSTANT_BUFFER, pBuffer);
+    }
+
     if (!m_SupportedFeatures.ShaderBaseVertexOffset)
     {
         BufferDesc Desc;
@@ -240,13 +258,52 @@ PostFXContext::~PostFXContext() = default;
 
 void PostFXContext::PrepareResources(IRenderDevice* pDevice, const FrameDesc& Desc, FEATURE_FLAGS FeatureFlags)
 {
-    m_FrameDesc.Index = Desc.Index;
-    m_FeatureFlags    = FeatureFlags;
+    // Only the render resolution affects the resources of the context
+    m_FrameDesc.Index        = Desc.Index;
+    m_FrameDesc.OutputWidth  = Desc.OutputWidth;
+    m_FrameDesc.OutputHeight = Desc.OutputHeight;
+
+    // Release free transient textures that have not been used for a while, e.g. because the effect
+    // that used them was disabled. Idle frames are counted here rather than derived from the frame
+    // index, which is provided by the application and is not guaranteed to advance.
+    constexpr Uint32 MaxTransientTextureIdleFrames = 4;
+    for (auto Iter = m_FreeTransientTextures.begin(); Iter != m_FreeTransientTextures.end();)
+    {
+        std::vector<FreeTransientTexture>& Textures = Iter->second;
+        for (FreeTransientTexture& Texture : Textures)
+            ++Texture.IdleFrameCount;
+
+        const size_t NumTextures = Textures.size();
+        Textures.erase(std::remove_if(Textures.begin(), Textures.end(),
+                                      [&](const FreeTransientTexture& Texture) {
+                                          return Texture.IdleFrameCount > MaxTransientTextureIdleFrames;
+                                      }),
+                       Textures.end());
+        m_TransientTextureCount -= static_cast<Uint32>(NumTextures - Textures.size());
+
+        if (Textures.empty())
+            Iter = m_FreeTransientTextures.erase(Iter);
+        else
+            ++Iter;
+    }
+
+    // Keep the features that effects requested during the previous frame
+    FeatureFlags |= m_RequestedFeatureFlags;
+    m_RequestedFeatureFlags = FEATURE_FLAG_NONE;
 
-    if (m_FrameDesc.Width == Desc.Width && m_FrameDesc.Height == Desc.Height)
+    if (m_FrameDesc.Width == Desc.Width && m_FrameDesc.Height == Desc.Height && m_FeatureFlags == FeatureFlags)
         return;
 
-    m_FrameDesc = Desc;
+    // Textures of the previous frame size will not be requested anymore
+    if (m_FrameDesc.Width != Desc.Width || m_FrameDesc.Height != Desc.Height)
+    {
+        for (const auto& Iter : m_FreeTransientTextures)
+            m_TransientTextureCount -= static_cast<Uint32>(Iter.second.size());
+        m_FreeTransientTextures.clear();
+    }
+
+    m_FrameDesc    = Desc;
+    m_FeatureFlags = FeatureFlags;
 
     RenderDeviceWithCache_N Device{pDevice};
 
@@ -282,6 +339,82 @@ void PostFXContext::PrepareResources(IRenderDevice* pDevice, const FrameDesc& De
         ResourceDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
         m_Resources.Insert(RESOURCE_IDENTIFIER_CLOSEST_MOTION, Device.CreateTexture(ResourceDesc));
     }
+
+    CreateDepthHierarchy(pDevice);
+}
+
+void PostFXContext::RequestDepthHierarchy(IRenderDevice* pDevice)
+{
+    m_RequestedFeatureFlags |= FEATURE_FLAG_DEPTH_HIERARCHY;
+    if (m_FeatureFlags & FEATURE_FLAG_DEPTH_HIERARCHY)
+        return;
+
+    m_FeatureFlags |= FEATURE_FLAG_DEPTH_HIERARCHY;
+    CreateDepthHierarchy(pDevice);
+}
+
+void PostFXContext::CreateDepthHierarchy(IRenderDevice* pDevice)
+{
+    RenderDeviceWithCache_N Device{pDevice};
+
+    m_DepthHierarchyMipMapRTV.clear();
+    m_DepthHierarchyMipMapSRV.clear();
+    m_DepthHierarchyMipMapUAV.clear();
+    m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].Release();
+    m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE].Release();
+    if (m_FeatureFlags & FEATURE_FLAG_DEPTH_HIERARCHY)
+    {
+        const bool SinglePass = UseSinglePassDepthHierarchy(m_FeatureFlags);
+
+        TextureDesc ResourceDesc;
+        ResourceDesc.Name      = "PostFXContext::DepthHierarchy";
+        ResourceDesc.Type      = RESOURCE_DIM_TEX_2D;
+        ResourceDesc.Width     = m_FrameDesc.Width;
+        ResourceDesc.Height    = m_FrameDesc.Height;
+        ResourceDesc.Format    = (m_FeatureFlags & FEATURE_FLAG_HALF_PRECISION_DEPTH) ? TEX_FORMAT_RG16_UNORM : TEX_FORMAT_RG32_FLOAT;
+        ResourceDesc.MipLevels = ComputeMipLevelsCount(ResourceDesc.Width, ResourceDesc.Height);
+        ResourceDesc.BindFlags = BIND_SHADER_RESOURCE | (SinglePass ? BIND_UNORDERED_ACCESS : BIND_RENDER_TARGET);
+        m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_HIERARCHY, Device.CreateTexture(ResourceDesc));
+
+        ITexture* pDepthHierarchy = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture();
+
+        (SinglePass ? m_DepthHierarchyMipMapUAV : m_DepthHierarchyMipMapRTV).resize(ResourceDesc.MipLevels);
+        m_DepthHierarchyMipMapSRV.resize(ResourceDesc.MipLevels);
+        for (Uint32 MipLevel = 0; MipLevel < ResourceDesc.MipLevels; MipLevel++)
+        {
+            if (SinglePass)
+            {
+                TextureViewDesc ViewDesc;
+                ViewDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+                ViewDesc.MostDetailedMip = MipLevel;
+                ViewDesc.NumMipLevels    = 1;
+                pDepthHierarchy->CreateView(ViewDesc, &m_DepthHierarchyMipMapUAV[MipLevel]);
+            }
+            else
+            {
+                TextureViewDesc ViewDesc;
+                ViewDesc.ViewType        = TEXTURE_VIEW_RENDER_TARGET;
+                ViewDesc.MostDetailedMip = MipLevel;
+                ViewDesc.NumMipLevels    = 1;
+                pDepthHierarchy->CreateView(ViewDesc, &m_DepthHierarchyMipMapRTV[MipLevel]);
+            }
+
+            if (m_SupportedFeatures.TextureSubresourceViews)
+            {
+                TextureViewDesc ViewDesc;
+                ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+                ViewDesc.MostDetailedMip = MipLevel;
+                ViewDesc.NumMipLevels    = 1;
+                pDepthHierarchy->CreateView(ViewDesc, &m_DepthHierarchyMipMapSRV[MipLevel]);
+            }
+        }
+
+        if (!m_SupportedFeatures.TextureSubresourceViews)
+        {
+            ResourceDesc.Name = "PostFXContext::DepthHierarchyIntermediate";
+            m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE, Device.CreateTexture(ResourceDesc));
+        }
+    }
 }
 
 void PostFXContext::Execute(const RenderAttributes& RenderAttribs)
@@ -304,16 +437,35 @@ void PostFXContext::Execute(const RenderAttributes& RenderAttribs)
         DEV_CHECK_ERR(RenderAttribs.pCurrCamera != nullptr, "RenderAttribs.pCurrCamera must not be null");
         DEV_CHECK_ERR(RenderAttribs.pPrevCamera != nullptr, "RenderAttribs.pPrevCamera must not be null");
 
+        // Dynamic buffers can only be used by a single immediate context
+        const bool IsSharedBuffer = (m_Settings.ImmediateContextMask & (m_Settings.ImmediateContextMask - 1)) != 0;
+
         if (!m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER])
         {
+            BufferDesc Desc;
+            Desc.Name                 = "PostFXContext::CameraAttibsConstantBuffer";
+            Desc.Usage                = IsSharedBuffer ? USAGE_DEFAULT : USAGE_DYNAMIC;
+            Desc.BindFlags            = BIND_UNIFORM_BUFFER;
+            Desc.CPUAccessFlags       = IsSharedBuffer ? CPU_ACCESS_NONE : CPU_ACCESS_WRITE;
+            Desc.Size                 = 2 * sizeof(HLSL::CameraAttribs);
+            Desc.ImmediateContextMask = m_Settings.ImmediateContextMask;
+
             RefCntAutoPtr<IBuffer> pBuffer;
-            CreateUniformBuffer(RenderAttribs.pDevice, 2 * sizeof(HLSL::CameraAttribs), "PostFXContext::CameraAttibsConstantBuffer", &pBuffer);
+            RenderAttribs.pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
             m_Resources.Insert(RESOURCE_IDENTIFIER_CONSTANT_BUFFER, pBuffer);
         }
 
-        MapHelper<HLSL::CameraAttribs> CameraAttibs{RenderAttribs.pDeviceContext, m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER], MAP_WRITE, MAP_FLAG_DISCARD};
-        CameraAttibs[0] = *RenderAttribs.pCurrCamera;
-        CameraAttibs[1] = *RenderAttribs.pPrevCamera;
+        if (IsSharedBuffer)
+        {
+            const HLSL::CameraAttribs CameraAttibs[] = {*RenderAttribs.pCurrCamera, *RenderAttribs.pPrevCamera};
+            RenderAttribs.pDeviceContext->UpdateBuffer(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER].AsBuffer(), 0, sizeof(CameraAttibs), CameraAttibs, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        else
+        {
+            MapHelper<HLSL::CameraAttribs> CameraAttibs{RenderAttribs.pDeviceContext, m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER], MAP_WRITE, MAP_FLAG_DISCARD};
+            CameraAttibs[0] = *RenderAttribs.pCurrCamera;
+            CameraAttibs[1] = *RenderAttribs.pPrevCamera;
+        }
     }
     else
     {
@@ -328,6 +480,8 @@ void PostFXContext::Execute(const RenderAttributes& RenderAttribs)
         ComputeReprojectedDepth(RenderAttribs);
         ComputeClosestMotion(RenderAttribs);
         ComputePreviousDepth(RenderAttribs);
+        if (m_FeatureFlags & FEATURE_FLAG_DEPTH_HIERARCHY)
+            ComputeDepthHierarchy(RenderAttribs);
     }
 
     // Release references to input resources
@@ -435,6 +589,182 @@ void PostFXContext::CopyTextureColor(const TextureOperationAttribs& Attribs, ITe
     Attribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+bool PostFXContext::PrepareBilateralUpsampling(const TextureOperationAttribs& Attribs, TEXTURE_FORMAT RTVFormat)
+{
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_BILATERAL_UPSAMPLING, FEATURE_FLAG_NONE, RTVFormat);
+    if (!RenderTech.IsInitializedPSO())
+    {
+        const SHADER_COMPILE_FLAGS ShaderFlags = GetShaderCompileFlags(m_Settings.EnableAsyncCreation);
+        const PSO_CREATE_FLAGS     PSOFlags    = m_Settings.EnableAsyncCreation ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
+
+        PipelineResourceLayoutDescX ResourceLayout;
+        ResourceLayout
+            .AddVariable(SHADER_TYPE_PIXEL, "cbCameraAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            .AddVariable(SHADER_TYPE_PIXEL, "g_TextureSource", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+            .AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
+
+        const auto VS = PostFXRenderTechnique::CreateShader(Attribs.pDevice, Attribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
+        const auto PS = PostFXRenderTechnique::CreateShader(Attribs.pDevice, Attribs.pStateCache, "ComputeBilateralUpsampling.fx", "ComputeBilateralUpsamplingPS", SHADER_TYPE_PIXEL, {}, ShaderFlags);
+
+        RenderTech.InitializePSO(Attribs.pDevice,
+                                 Attribs.pStateCache, "PostFXContext::BilateralUpsampling",
+                                 VS, PS, ResourceLayout,
+                                 {RTVFormat},
+                                 TEX_FORMAT_UNKNOWN,
+                                 DSS_DisableDepth, BS_Default, false, PSOFlags);
+    }
+    return RenderTech.IsReady();
+}
+
+void PostFXContext::BilateralUpsample(const TextureOperationAttribs& Attribs, ITextureView* pSourceSRV, ITextureView* pDepthSRV, ITextureView* pRTV)
+{
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_BILATERAL_UPSAMPLING, FEATURE_FLAG_NONE, pRTV->GetDesc().Format);
+    if (!RenderTech.IsReady())
+    {
+        UNEXPECTED("The bilateral upsampling PSO is not ready. Call PrepareBilateralUpsampling() and check the returned value.");
+        return;
+    }
+
+    if (!RenderTech.IsInitializedSRB())
+    {
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "cbCameraAttribs"}.Set(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER]);
+        RenderTech.InitializeSRB(true);
+    }
+
+    ScopedDebugGroup DebugGroup{Attribs.pDeviceContext, "BilateralUpsampling"};
+
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureSource"}.Set(pSourceSRV);
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepth"}.Set(pDepthSRV);
+
+    Attribs.pDeviceContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    Attribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+    Attribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    Attribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+    Attribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
+static bool HasRequiredBindFlags(const TextureDesc& TexDesc, const TextureDesc& Desc)
+{
+    // A texture with additional bind flags can be used in place of the requested one
+    return (TexDesc.BindFlags & Desc.BindFlags) == Desc.BindFlags;
+}
+
+RefCntAutoPtr<ITexture> PostFXContext::AcquireTransientTexture(IRenderDevice* pDevice, const TextureDesc& Desc)
+{
+    DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT, "Transient textures must use USAGE_DEFAULT");
+
+    auto Bucket = m_FreeTransientTextures.find(TransientTextureKey{Desc});
+    if (Bucket != m_FreeTransientTextures.end())
+    {
+        std::vector<FreeTransientTexture>& Textures = Bucket->second;
+        for (auto Iter = Textures.begin(); Iter != Textures.end(); ++Iter)
+        {
+            if (HasRequiredBindFlags(Iter->pTexture->GetDesc(), Desc))
+            {
+                RefCntAutoPtr<ITexture> pTexture = std::move(Iter->pTexture);
+                Textures.erase(Iter);
+                return pTexture;
+            }
+        }
+    }
+
+    DEV_CHECK_ERR(pDevice != nullptr, "pDevice must not be null");
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(Desc, nullptr, &pTexture);
+    if (!pTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to create transient texture '", (Desc.Name != nullptr ? Desc.Name : ""), "'");
+        return {};
+    }
+
+    ++m_TransientTextureCount;
+    return pTexture;
+}
+
+void PostFXContext::ReleaseTransientTexture(ITexture* pTexture)
+{
+    if (pTexture == nullptr)
+        return;
+
+    std::vector<FreeTransientTexture>& Textures = m_FreeTransientTextures[TransientTextureKey{pTexture->GetDesc()}];
+    VERIFY(std::none_of(Textures.begin(), Textures.end(), [pTexture](const FreeTransientTexture& Texture) { return Texture.pTexture.RawPtr() == pTexture; }),
+           "Transient texture '", pTexture->GetDesc().Name, "' has already been released");
+    Textures.push_back({RefCntAutoPtr<ITexture>{pTexture}, 0});
+}
+
+bool PostFXContext::AcquireTransientTextures(IRenderDevice* pDevice, const TransientTextureAttribs* pTextures, Uint32 NumTextures, ResourceRegistry& Resources)
+{
+    // Assign the textures in the order of their first pass, so that every texture
+    // can reuse a texture whose lifetime has already ended.
+    std::vector<Uint32> Order(NumTextures);
+    for (Uint32 TextureIdx = 0; TextureIdx < NumTextures; ++TextureIdx)
+        Order[TextureIdx] = TextureIdx;
+    std::stable_sort(Order.begin(), Order.end(), [pTextures](Uint32 LHS, Uint32 RHS) {
+        return pTextures[LHS].FirstPass < pTextures[RHS].FirstPass;
+    });
+
+    struct AcquiredTexture
+    {
+        ITexture* pTexture;
+        Uint32    LastPass;
+    };
+    std::vector<AcquiredTexture> AcquiredTextures;
+
+    bool AllTexturesReady = true;
+    for (Uint32 TextureIdx : Order)
+    {
+        const TransientTextureAttribs& Attribs = pTextures[TextureIdx];
+        DEV_CHECK_ERR(Attribs.FirstPass <= Attribs.LastPass, "The first pass of transient texture '", Attribs.Desc.Name, "' must not be greater than the last pass");
+        VERIFY(Resources[Attribs.ResourceId].AsTexture() == nullptr, "Transient texture '", Attribs.Desc.Name, "' has not been released");
+
+        auto Acquired = std::find_if(AcquiredTextures.begin(), AcquiredTextures.end(), [&Attribs](const AcquiredTexture& Texture) {
+            const TextureDesc& TexDesc = Texture.pTexture->GetDesc();
+            return Texture.LastPass < Attribs.FirstPass &&
+                TransientTextureKey{TexDesc} == TransientTextureKey{Attribs.Desc} &&
+                HasRequiredBindFlags(TexDesc, Attribs.Desc);
+        });
+
+        if (Acquired != AcquiredTextures.end())
+        {
+            Acquired->LastPass = Attribs.LastPass;
+            Resources.Insert(Attribs.ResourceId, Acquired->pTexture);
+            continue;
+        }
+
+        RefCntAutoPtr<ITexture> pTexture = AcquireTransientTexture(pDevice, Attribs.Desc);
+        if (!pTexture)
+        {
+            AllTexturesReady = false;
+            continue;
+        }
+
+        Resources.Insert(Attribs.ResourceId, pTexture);
+        AcquiredTextures.push_back({pTexture, Attribs.LastPass});
+    }
+
+    return AllTexturesReady;
+}
+
+void PostFXContext::ReleaseTransientTextures(const TransientTextureAttribs* pTextures, Uint32 NumTextures, ResourceRegistry& Resources)
+{
+    for (Uint32 TextureIdx = 0; TextureIdx < NumTextures; ++TextureIdx)
+    {
+        RefCntAutoPtr<ITexture> pTexture{Resources[pTextures[TextureIdx].ResourceId].AsTexture()};
+        if (!pTexture)
+            continue;
+
+        // A texture shared by several resources is returned to the pool once
+        for (Uint32 ResourceIdx = TextureIdx; ResourceIdx < NumTextures; ++ResourceIdx)
+        {
+            if (Resources[pTextures[ResourceIdx].ResourceId].AsTexture() == pTexture.RawPtr())
+                Resources[pTextures[ResourceIdx].ResourceId].Release();
+        }
+
+        ReleaseTransientTexture(pTexture);
+    }
+}
+
 bool PostFXContext::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags)
 {
     bool AllPSOsReady = true;
@@ -472,13 +802,16 @@ bool PostFXContext::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs,
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_REPROJECTED_DEPTH, FeatureFlags, TEX_FORMAT_UNKNOWN);
         if (!RenderTech.IsInitializedPSO())
         {
+            ShaderMacroHelper Macros;
+            Macros.Add("POSTFX_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+
             PipelineResourceLayoutDescX ResourceLayout;
             ResourceLayout
                 .AddVariable(SHADER_TYPE_PIXEL, "cbCameraAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
 
             const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
-            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "ComputeReprojectedDepth.fx", "ComputeReprojectedDepthPS", SHADER_TYPE_PIXEL, {}, ShaderFlags);
+            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "ComputeReprojectedDepth.fx", "ComputeReprojectedDepthPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
 
             RenderTech.InitializePSO(RenderAttribs.pDevice,
                                      RenderAttribs.pStateCache, "PreparePostFX::ComputeReprojectedDepth",
@@ -538,6 +871,101 @@ bool PostFXContext::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs,
             AllPSOsReady = false;
     }
 
+    if ((FeatureFlags & FEATURE_FLAG_DEPTH_HIERARCHY) && UseSinglePassDepthHierarchy(FeatureFlags))
+    {
+        for (const bool FirstMip : {true, false})
+        {
+            auto& RenderTech = GetRenderTechnique(FirstMip ? RENDER_TECH_COMPUTE_DEPTH_HIERARCHY_FIRST_MIP : RENDER_TECH_COMPUTE_DEPTH_HIERARCHY, FeatureFlags, TEX_FORMAT_UNKNOWN);
+            if (!RenderTech.IsInitializedPSO())
+            {
+                ShaderMacroHelper Macros;
+                Macros.Add("DEPTH_HIERARCHY_COMPUTE", true);
+                Macros.Add("DEPTH_HIERARCHY_FIRST_MIP", FirstMip);
+                Macros.Add("POSTFX_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+
+                PipelineResourceLayoutDescX ResourceLayout;
+                ResourceLayout
+                    .SetDefaultVariableType(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                    .AddVariable(SHADER_TYPE_COMPUTE, "cbDepthHierarchyAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+                if (FirstMip)
+                    ResourceLayout.AddVariable(SHADER_TYPE_COMPUTE, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
+
+                const auto CS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "ComputeDepthHierarchy.fx", "ComputeDepthHierarchyCS", SHADER_TYPE_COMPUTE, Macros, ShaderFlags);
+
+                RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                         RenderAttribs.pStateCache,
+                                         FirstMip ? "PreparePostFX::ComputeDepthHierarchyFirstMipCS" : "PreparePostFX::ComputeDepthHierarchyCS",
+                                         CS, ResourceLayout, PSOFlags);
+            }
+            if (AllPSOsReady && !RenderTech.IsReady())
+                AllPSOsReady = false;
+        }
+    }
+    else if (FeatureFlags & FEATURE_FLAG_DEPTH_HIERARCHY)
+    {
+        const TEXTURE_FORMAT DepthHierarchyFormat = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture()->GetDesc().Format;
+
+        {
+            auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DEPTH_HIERARCHY_FIRST_MIP, FeatureFlags, TEX_FORMAT_UNKNOWN);
+            if (!RenderTech.IsInitializedPSO())
+            {
+                ShaderMacroHelper Macros;
+                Macros.Add("DEPTH_HIERARCHY_FIRST_MIP", true);
+                Macros.Add("POSTFX_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+
+                PipelineResourceLayoutDescX ResourceLayout;
+                ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
+
+                const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
+                const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "ComputeDepthHierarchy.fx", "ComputeDepthHierarchyPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
+
+                RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                         RenderAttribs.pStateCache, "PreparePostFX::ComputeDepthHierarchyFirstMip",
+                                         VS, PS, ResourceLayout,
+                                         {DepthHierarchyFormat},
+                                         TEX_FORMAT_UNKNOWN,
+                                         DSS_DisableDepth, BS_Default, false, PSOFlags);
+            }
+            if (AllPSOsReady && !RenderTech.IsReady())
+                AllPSOsReady = false;
+        }
+
+        {
+            auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DEPTH_HIERARCHY, FeatureFlags, TEX_FORMAT_UNKNOWN);
+            if (!RenderTech.IsInitializedPSO())
+            {
+                ShaderMacroHelper Macros;
+                Macros.Add("DEPTH_HIERARCHY_FIRST_MIP", false);
+                Macros.Add("SUPPORTED_SHADER_SRV", m_SupportedFeatures.TextureSubresourceViews);
+                Macros.Add("POSTFX_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+
+                PipelineResourceLayoutDescX ResourceLayout;
+                if (m_SupportedFeatures.TextureSubresourceViews)
+                {
+                    ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureLastMip", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+                }
+                else
+                {
+                    ResourceLayout
+                        .AddVariable(SHADER_TYPE_PIXEL, "g_TextureMips", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                        .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureMips", Sam_PointWrap); // Immutable samplers are required for WebGL to work properly
+                }
+
+                const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
+                const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "ComputeDepthHierarchy.fx", "ComputeDepthHierarchyPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
+
+                RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                         RenderAttribs.pStateCache, "PreparePostFX::ComputeDepthHierarchy",
+                                         VS, PS, ResourceLayout,
+                                         {DepthHierarchyFormat},
+                                         TEX_FORMAT_UNKNOWN,
+                                         DSS_DisableDepth, BS_Default, false, PSOFlags);
+            }
+            if (AllPSOsReady && !RenderTech.IsReady())
+                AllPSOsReady = false;
+        }
+    }
+
     return AllPSOsReady;
 }
 
@@ -652,6 +1080,214 @@ void PostFXContext::ComputePreviousDepth(const RenderAttributes& RenderAttribs)
     RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+void PostFXContext::ComputeDepthHierarchy(const RenderAttributes& RenderAttribs)
+{
+    ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeDepthHierarchy"};
+
+    if (UseSinglePassDepthHierarchy(m_FeatureFlags))
+    {
+        ComputeDepthHierarchySinglePass(RenderAttribs);
+        return;
+    }
+
+    ITexture*    pDepthHierarchy = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture();
+    const Uint32 MipLevelCount   = static_cast<Uint32>(m_DepthHierarchyMipMapRTV.size());
+
+    {
+        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DEPTH_HIERARCHY_FIRST_MIP, m_FeatureFlags, TEX_FORMAT_UNKNOWN);
+        if (!RenderTech.IsInitializedSRB())
+            RenderTech.InitializeSRB(false);
+
+        ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_CURR_DEPTH].GetTextureSRV());
+
+        RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_DepthHierarchyMipMapRTV[0], nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+        RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+        RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    }
+
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DEPTH_HIERARCHY, m_FeatureFlags, TEX_FORMAT_UNKNOWN);
+    if (!RenderTech.IsInitializedSRB())
+        RenderTech.InitializeSRB(false);
+
+    if (!m_SupportedFeatures.TextureSubresourceViews)
+    {
+        CopyTextureAttribs CopyMipAttribs;
+        CopyMipAttribs.pSrcTexture              = pDepthHierarchy;
+        CopyMipAttribs.pDstTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE];
+        CopyMipAttribs.SrcMipLevel              = 0;
+        CopyMipAttribs.DstMipLevel              = 0;
+        CopyMipAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        CopyMipAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        RenderAttribs.pDeviceContext->CopyTexture(CopyMipAttribs);
+    }
+
+    if (m_SupportedFeatures.TransitionSubresources)
+    {
+        StateTransitionDesc TransitionDescW2W[] = {
+            StateTransitionDesc{pDepthHierarchy,
+                                RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET,
+                                STATE_TRANSITION_FLAG_UPDATE_STATE},
+        };
+        RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TransitionDescW2W), TransitionDescW2W);
+
+        ShaderResourceVariableX TextureLastMipSV{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureLastMip"};
+        for (Uint32 MipLevel = 1; MipLevel < MipLevelCount; MipLevel++)
+        {
+            StateTransitionDesc TranslationW2R[] = {
+                StateTransitionDesc{pDepthHierarchy,
+                                    RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_SHADER_RESOURCE,
+                                    MipLevel - 1, 1, 0, REMAINING_ARRAY_SLICES,
+                                    STATE_TRANSITION_TYPE_IMMEDIATE, STATE_TRANSITION_FLAG_NONE},
+            };
+
+            TextureLastMipSV.Set(m_DepthHierarchyMipMapSRV[MipLevel - 1]);
+            RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TranslationW2R), TranslationW2R);
+            RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_DepthHierarchyMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+            RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+        }
+
+        StateTransitionDesc TransitionDescW2R[] = {
+            StateTransitionDesc{pDepthHierarchy,
+                                RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_SHADER_RESOURCE,
+                                MipLevelCount - 1, 1, 0, REMAINING_ARRAY_SLICES,
+                                STATE_TRANSITION_TYPE_IMMEDIATE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        };
+        RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TransitionDescW2R), TransitionDescW2R);
+    }
+    else if (m_SupportedFeatures.TextureSubresourceViews)
+    {
+        ShaderResourceVariableX TextureLastMipSV{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureLastMip"};
+        for (Uint32 MipLevel = 1; MipLevel < MipLevelCount; MipLevel++)
+        {
+            TextureLastMipSV.Set(m_DepthHierarchyMipMapSRV[MipLevel - 1]);
+            RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_DepthHierarchyMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+            RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+            RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+        }
+    }
+    else
+    {
+        ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureMips"}.Set(m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE].GetTextureSRV());
+
+        for (Uint32 MipLevel = 1; MipLevel < MipLevelCount; MipLevel++)
+        {
+            // We use StartVertexLocation to pass the mipmap level of the depth texture for convolution
+            VERIFY_EXPR(m_SupportedFeatures.ShaderBaseVertexOffset);
+            const Uint32 VertexOffset = 3u * (MipLevel - 1);
+            RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_DepthHierarchyMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+            RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1, VertexOffset});
+            RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            CopyTextureAttribs CopyMipAttribs;
+            CopyMipAttribs.pSrcTexture              = pDepthHierarchy;
+            CopyMipAttribs.pDstTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE];
+            CopyMipAttribs.SrcMipLevel              = MipLevel;
+            CopyMipAttribs.DstMipLevel              = MipLevel;
+            CopyMipAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            CopyMipAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            RenderAttribs.pDeviceContext->CopyTexture(CopyMipAttribs);
+        }
+    }
+
+    RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
+void PostFXContext::ComputeDepthHierarchySinglePass(const RenderAttributes& RenderAttribs)
+{
+    // Must match SPD_MAX_LEVELS and SPD_TILE_SIZE in SinglePassDownsampler.fxh
+    constexpr Uint32 LevelsPerDispatch = 5;
+    constexpr Uint32 TileSize          = 32;
+
+    static constexpr const char* HierarchyMipNames[] = {
+        "g_HierarchyMip0",
+        "g_HierarchyMip1",
+        "g_HierarchyMip2",
+        "g_HierarchyMip3",
+        "g_HierarchyMip4",
+        "g_HierarchyMip5",
+    };
+    static_assert(_countof(HierarchyMipNames) == LevelsPerDispatch + 1, "Unexpected number of mip level names");
+
+    ITexture*    pDepthHierarchy = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture();
+    const Uint32 MipLevelCount   = static_cast<Uint32>(m_DepthHierarchyMipMapUAV.size());
+
+    StateTransitionDesc TransitionDescs[] = {
+        StateTransitionDesc{m_Resources[RESOURCE_IDENTIFIER_INPUT_CURR_DEPTH].AsTexture(),
+                            RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE,
+                            STATE_TRANSITION_FLAG_UPDATE_STATE},
+        StateTransitionDesc{pDepthHierarchy,
+                            RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS,
+                            STATE_TRANSITION_FLAG_UPDATE_STATE},
+    };
+    RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TransitionDescs), TransitionDescs);
+
+    // The first dispatch copies the depth buffer to the first mip level and computes the next mip levels.
+    // Every next dispatch reads the last mip level computed by the previous one.
+    for (Uint32 SrcMip = 0; SrcMip == 0 || SrcMip + 1 < MipLevelCount; SrcMip += LevelsPerDispatch)
+    {
+        const bool   IsFirstDispatch = SrcMip == 0;
+        const Uint32 NumLevels       = std::min(LevelsPerDispatch, MipLevelCount - 1 - SrcMip);
+
+        auto& RenderTech = GetRenderTechnique(IsFirstDispatch ? RENDER_TECH_COMPUTE_DEPTH_HIERARCHY_FIRST_MIP : RENDER_TECH_COMPUTE_DEPTH_HIERARCHY, m_FeatureFlags, TEX_FORMAT_UNKNOWN);
+        if (!RenderTech.IsInitializedSRB())
+        {
+            ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_COMPUTE, "cbDepthHierarchyAttribs"}.Set(m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_CONSTANT_BUFFER].AsBuffer());
+            RenderTech.InitializeSRB(true);
+        }
+
+        {
+            MapHelper<uint4> DepthHierarchyAttribs{RenderAttribs.pDeviceContext, m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_CONSTANT_BUFFER], MAP_WRITE, MAP_FLAG_DISCARD};
+            *DepthHierarchyAttribs = uint4{NumLevels, 0, 0, 0};
+        }
+
+        if (IsFirstDispatch)
+        {
+            ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_TextureDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_CURR_DEPTH].GetTextureSRV());
+            ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, HierarchyMipNames[0]}.Set(m_DepthHierarchyMipMapUAV[0]);
+        }
+        else
+        {
+            ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_TextureLastMip"}.Set(m_DepthHierarchyMipMapSRV[SrcMip]);
+        }
+
+        for (Uint32 Level = 1; Level <= LevelsPerDispatch; ++Level)
+        {
+            // Levels that are not computed by this dispatch are bound to the last computed level and are not written by the shader
+            const Uint32 MipLevel = SrcMip + std::min(Level, NumLevels);
+            ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, HierarchyMipNames[Level]}.Set(m_DepthHierarchyMipMapUAV[MipLevel]);
+        }
+
+        const Uint32 SrcWidth  = std::max(m_FrameDesc.Width >> SrcMip, 1u);
+        const Uint32 SrcHeight = std::max(m_FrameDesc.Height >> SrcMip, 1u);
+
+        RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+        RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+        RenderAttribs.pDeviceContext->DispatchCompute({std::max(SrcWidth / TileSize, 1u), std::max(SrcHeight / TileSize, 1u), 1});
+
+        // Make the computed mip levels available for reading by the next dispatch and by the effects
+        const Uint32        FirstWrittenMip = IsFirstDispatch ? 0 : SrcMip + 1;
+        const bool          IsLastDispatch  = SrcMip + NumLevels + 1 >= MipLevelCount;
+        StateTransitionDesc TransitionW2R{pDepthHierarchy,
+                                          RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE,
+                                          FirstWrittenMip, SrcMip + NumLevels + 1 - FirstWrittenMip, 0, REMAINING_ARRAY_SLICES,
+                                          STATE_TRANSITION_TYPE_IMMEDIATE, IsLastDispatch ? STATE_TRANSITION_FLAG_UPDATE_STATE : STATE_TRANSITION_FLAG_NONE};
+        RenderAttribs.pDeviceContext->TransitionResourceStates(1, &TransitionW2R);
+    }
+}
+
+bool PostFXContext::UseSinglePassDepthHierarchy(FEATURE_FLAGS FeatureFlags) const
+{
+    // The compute shader writes the full precision depth hierarchy format
+    return m_SupportedFeatures.SinglePassDownsampling && (FeatureFlags & FEATURE_FLAG_HALF_PRECISION_DEPTH) == 0;
+}
+
 PostFXContext::RenderTechnique& PostFXContext::GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags, TEXTURE_FORMAT TextureFormat)
 {
     auto Iter = m_RenderTech.find({RenderTech, FeatureFlags, TextureFormat});
@@ -677,4 +1313,12 @@ ITextureView* PostFXContext::GetPreviousDepth() const
     return m_Resources[RESOURCE_IDENTIFIER_PREVIOUS_DEPTH].GetTextureSRV();
 }
 
+ITextureView* PostFXContext::GetDepthHierarchy() const
+{
+    const auto& DepthHierarchy = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY];
+    if (!DepthHierarchy)
+        return nullptr;
+    return DepthHierarchy.GetTextureSRV();
+}
+
 } // namespace Diligent
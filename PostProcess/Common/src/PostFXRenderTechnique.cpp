@@ -93,6 +93,28 @@ void PostFXRenderTechnique::InitializePSO(IRenderDevice*                     pDe
     PSO = RenderDeviceWithCache<false>{pDevice, pStateCache}.CreateGraphicsPipelineState(PSOCreateInfo);
 }
 
+void PostFXRenderTechnique::InitializePSO(IRenderDevice*                    pDevice,
+                                          IRenderStateCache*                pStateCache,
+                                          const char*                       PSOName,
+                                          IShader*                          ComputeShader,
+                                          const PipelineResourceLayoutDesc& ResourceLayout,
+                                          PSO_CREATE_FLAGS                  PSOFlags,
+                                          Uint64                            ImmediateContextMask)
+{
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
+
+    PSODesc.Name                 = PSOName;
+    PSODesc.ResourceLayout       = ResourceLayout;
+    PSODesc.PipelineType         = PIPELINE_TYPE_COMPUTE;
+    PSODesc.ImmediateContextMask = ImmediateContextMask;
+    PSOCreateInfo.pCS            = ComputeShader;
+    PSOCreateInfo.Flags          = PSOFlags;
+
+    PSO.Release();
+    PSO = RenderDeviceWithCache<false>{pDevice, pStateCache}.CreateComputePipelineState(PSOCreateInfo);
+}
+
 void PostFXRenderTechnique::InitializeSRB(bool InitStaticResources)
 {
     SRB.Release();
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
 
 #include "../../../../DiligentCore/Common/interface/Timer.hpp"
@@ -111,6 +112,7 @@ private:
         RENDER_TECH_COMPUTE_CIRCLE_OF_CONFUSION_BLUR_X,
         RENDER_TECH_COMPUTE_CIRCLE_OF_CONFUSION_BLUR_Y,
         RENDER_TECH_COMPUTE_PREFILTERED_TEXTURE,
+        RENDER_TECH_COMPUTE_CIRCLE_OF_CONFUSION_TILES,
         RENDER_TECH_COMPUTE_BOKEH_FIRST_PASS,
         RENDER_TECH_COMPUTE_BOKEH_SECOND_PASS,
         RENDER_TECH_COMPUTE_POST_FILTERED_TEXTURE,
@@ -137,6 +139,7 @@ private:
         RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TEMPORAL_TEXTURE1,
         RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE0, // Reuse texture for bokeh second pass
         RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE1, // Reuse texture for bokeh second pass
+        RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE,
         RESOURCE_IDENTIFIER_BOKEH_TEXTURE0,       // Reuse texture for post-filtered texture
         RESOURCE_IDENTIFIER_BOKEH_TEXTURE1,       // Reuse texture for post-filtered texture
         RESOURCE_IDENTIFIER_COMBINED_TEXTURE,
@@ -144,6 +147,23 @@ private:
         RESOURCE_IDENTIFIER_COUNT
     };
 
+    // Passes of Execute() in the order of execution. They define the lifetimes of the transient textures.
+    enum PASS : Uint32
+    {
+        PASS_CIRCLE_OF_CONFUSION = 0,
+        PASS_TEMPORAL_CIRCLE_OF_CONFUSION,
+        PASS_SEPARATED_CIRCLE_OF_CONFUSION,
+        PASS_DILATION_CIRCLE_OF_CONFUSION,
+        PASS_CIRCLE_OF_CONFUSION_BLUR_X,
+        PASS_CIRCLE_OF_CONFUSION_BLUR_Y,
+        PASS_PREFILTERED_TEXTURE,
+        PASS_TILE_CIRCLE_OF_CONFUSION,
+        PASS_BOKEH_FIRST_PASS,
+        PASS_BOKEH_SECOND_PASS,
+        PASS_POST_FILTERED_TEXTURE,
+        PASS_COMBINED_TEXTURE
+    };
+
     bool PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags);
 
     void UpdateConstantBuffers(const RenderAttributes& RenderAttribs, bool ResetTimer);
@@ -162,6 +182,8 @@ private:
 
     void ComputePrefilteredTexture(const RenderAttributes& RenderAttribs);
 
+    void ComputeTileCircleOfConfusion(const RenderAttributes& RenderAttribs);
+
     void ComputeBokehFirstPass(const RenderAttributes& RenderAttribs);
 
     void ComputeBokehSecondPass(const RenderAttributes& RenderAttribs);
@@ -172,6 +194,10 @@ private:
 
     void ComputePlaceholderTexture(const RenderAttributes& RenderAttribs);
 
+    bool AcquireTransientTextures(const RenderAttributes& RenderAttribs);
+
+    void ReleaseTransientTextures(const RenderAttributes& RenderAttribs);
+
     RenderTechnique& GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags);
 
 private:
@@ -195,7 +221,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -204,6 +230,10 @@ private:
 
     ResourceRegistry m_Resources{RESOURCE_IDENTIFIER_COUNT};
 
+    // Intermediate textures that are only used within Execute() are acquired from
+    // the PostFXContext transient texture pool and released at the end of Execute().
+    std::vector<PostFXContext::TransientTextureAttribs> m_TransientTextures;
+
     std::unique_ptr<HLSL::DepthOfFieldAttribs> m_pDOFAttribs;
 
     Uint32 m_BackBufferWidth  = 0;
@@ -193,6 +193,17 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
 
     RenderDeviceWithCache_N Device{pDevice};
 
+    m_TransientTextures.clear();
+
+    auto AddTransientTexture = [&](Uint32 ResourceId, const TextureDesc& Desc, PASS FirstPass, PASS LastPass) {
+        PostFXContext::TransientTextureAttribs Attribs;
+        Attribs.ResourceId = ResourceId;
+        Attribs.Desc       = Desc;
+        Attribs.FirstPass  = FirstPass;
+        Attribs.LastPass   = LastPass;
+        m_TransientTextures.push_back(Attribs);
+    };
+
     {
         TextureDesc Desc;
         Desc.Name      = "DepthOfField::CircleOfConfusion";
@@ -201,7 +212,10 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_R16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TEXTURE, Device.CreateTexture(Desc));
+
+        // With temporal smoothing, the passes after the temporal pass read the temporal CoC instead
+        const PASS LastPass = (FeatureFlags & FEATURE_FLAG_ENABLE_TEMPORAL_SMOOTHING) ? PASS_TEMPORAL_CIRCLE_OF_CONFUSION : PASS_COMBINED_TEXTURE;
+        AddTransientTexture(RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TEXTURE, Desc, PASS_CIRCLE_OF_CONFUSION, LastPass);
     }
 
     if (FeatureFlags & FEATURE_FLAG_ENABLE_TEMPORAL_SMOOTHING)
@@ -235,7 +249,11 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
         Desc.Height    = m_BackBufferHeight >> (TextureIdx - RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_MIP0);
         Desc.Format    = TextureCoCFormat;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(TextureIdx, Device.CreateTexture(Desc));
+
+        // The first mip is written by the separation pass, the last mip is blurred and read by the prefiltering pass
+        const PASS FirstPass = TextureIdx == RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_MIP0 ? PASS_SEPARATED_CIRCLE_OF_CONFUSION : PASS_DILATION_CIRCLE_OF_CONFUSION;
+        const PASS LastPass  = TextureIdx == RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_LAST_MIP ? PASS_PREFILTERED_TEXTURE : PASS_DILATION_CIRCLE_OF_CONFUSION;
+        AddTransientTexture(TextureIdx, Desc, FirstPass, LastPass);
     }
 
     // We use this texture like intermediate texture for blurring dilation CoC texture
@@ -247,7 +265,7 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
         Desc.Height    = m_BackBufferHeight >> (RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_LAST_MIP - RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_MIP0);
         Desc.Format    = TextureCoCFormat;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_INTERMEDIATE, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_DILATION_TEXTURE_INTERMEDIATE, Desc, PASS_CIRCLE_OF_CONFUSION_BLUR_X, PASS_CIRCLE_OF_CONFUSION_BLUR_Y);
     }
 
 
@@ -260,7 +278,19 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
         Desc.Height    = m_BackBufferHeight / 2;
         Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(TextureIdx, Device.CreateTexture(Desc));
+        AddTransientTexture(TextureIdx, Desc, PASS_PREFILTERED_TEXTURE, PASS_POST_FILTERED_TEXTURE);
+    }
+
+    // Maximum near and far CoC of every DOF_TILE_SIZE x DOF_TILE_SIZE tile of the prefiltered textures
+    {
+        TextureDesc Desc;
+        Desc.Name      = "DepthOfField::TileCircleOfConfusion";
+        Desc.Type      = RESOURCE_DIM_TEX_2D;
+        Desc.Width     = (m_BackBufferWidth / 2 + DOF_TILE_SIZE - 1) / DOF_TILE_SIZE;
+        Desc.Height    = (m_BackBufferHeight / 2 + DOF_TILE_SIZE - 1) / DOF_TILE_SIZE;
+        Desc.Format    = TEX_FORMAT_RG16_FLOAT;
+        Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+        AddTransientTexture(RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE, Desc, PASS_TILE_CIRCLE_OF_CONFUSION, PASS_BOKEH_SECOND_PASS);
     }
 
     for (Uint32 TextureIdx = RESOURCE_IDENTIFIER_BOKEH_TEXTURE0; TextureIdx <= RESOURCE_IDENTIFIER_BOKEH_TEXTURE1; ++TextureIdx)
@@ -272,7 +302,7 @@ void DepthOfField::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDev
         Desc.Height    = m_BackBufferHeight / 2;
         Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(TextureIdx, Device.CreateTexture(Desc));
+        AddTransientTexture(TextureIdx, Desc, PASS_BOKEH_FIRST_PASS, PASS_COMBINED_TEXTURE);
     }
 
     {
@@ -302,7 +332,8 @@ void DepthOfField::Execute(const RenderAttributes& RenderAttribs)
 
     ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "DepthOfField"};
 
-    bool AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
+    const bool TransientTexturesReady = AcquireTransientTextures(RenderAttribs);
+    const bool AllPSOsReady           = TransientTexturesReady && PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
     UpdateConstantBuffers(RenderAttribs, !AllPSOsReady);
     if (AllPSOsReady)
     {
@@ -313,6 +344,7 @@ void DepthOfField::Execute(const RenderAttributes& RenderAttribs)
         ComputeCircleOfConfusionBlurX(RenderAttribs);
         ComputeCircleOfConfusionBlurY(RenderAttribs);
         ComputePrefilteredTexture(RenderAttribs);
+        ComputeTileCircleOfConfusion(RenderAttribs);
         ComputeBokehFirstPass(RenderAttribs);
         ComputeBokehSecondPass(RenderAttribs);
         ComputePostFilteredTexture(RenderAttribs);
@@ -323,11 +355,26 @@ void DepthOfField::Execute(const RenderAttributes& RenderAttribs)
         ComputePlaceholderTexture(RenderAttribs);
     }
 
+    ReleaseTransientTextures(RenderAttribs);
+
     // Release references to input resources
     for (Uint32 ResourceIdx = 0; ResourceIdx <= RESOURCE_IDENTIFIER_INPUT_LAST; ++ResourceIdx)
         m_Resources[ResourceIdx].Release();
 }
 
+bool DepthOfField::AcquireTransientTextures(const RenderAttributes& RenderAttribs)
+{
+    if (m_TransientTextures.empty())
+        return false;
+
+    return RenderAttribs.pPostFXContext->AcquireTransientTextures(RenderAttribs.pDevice, m_TransientTextures.data(), static_cast<Uint32>(m_TransientTextures.size()), m_Resources);
+}
+
+void DepthOfField::ReleaseTransientTextures(const RenderAttributes& RenderAttribs)
+{
+    RenderAttribs.pPostFXContext->ReleaseTransientTextures(m_TransientTextures.data(), static_cast<Uint32>(m_TransientTextures.size()), m_Resources);
+}
+
 bool DepthOfField::UpdateUI(HLSL::DepthOfFieldAttribs& Attribs, FEATURE_FLAGS& FeatureFlags)
 {
     bool ActiveTemporalSmoothing = (FeatureFlags & FEATURE_FLAG_ENABLE_TEMPORAL_SMOOTHING) != 0;
@@ -576,6 +623,31 @@ bool DepthOfField::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, F
             AllPSOsReady = false;
     }
 
+    {
+        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_CIRCLE_OF_CONFUSION_TILES, FeatureFlags);
+        if (!RenderTech.IsInitializedPSO())
+        {
+            const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
+            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "DOF_ComputeTileCircleOfConfusion.fx", "ComputeTileCoCPS", SHADER_TYPE_PIXEL, {}, ShaderFlags);
+
+            PipelineResourceLayoutDescX ResourceLayout;
+            ResourceLayout
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCNear", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCFar", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+            RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                     RenderAttribs.pStateCache, "DepthOfField::ComputeTileCircleOfConfusion",
+                                     VS, PS, ResourceLayout,
+                                     {
+                                         m_Resources[RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE].AsTexture()->GetDesc().Format,
+                                     },
+                                     TEX_FORMAT_UNKNOWN,
+                                     DSS_DisableDepth, BS_Default, false, PSOFlags);
+        }
+        if (AllPSOsReady && !RenderTech.IsReady())
+            AllPSOsReady = false;
+    }
+
     {
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_BOKEH_FIRST_PASS, FeatureFlags);
         if (!RenderTech.IsInitializedPSO())
@@ -591,8 +663,10 @@ bool DepthOfField::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, F
                 .AddVariable(SHADER_TYPE_PIXEL, "cbCameraAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "cbDepthOfFieldAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureBokehKernel", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureBokehSmallKernel", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCNear", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCFar", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureTileCoC", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
                 .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureColorCoCNear", Sam_LinearClamp)
                 .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureColorCoCFar", Sam_LinearClamp);
 
@@ -631,6 +705,7 @@ bool DepthOfField::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, F
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureBokehKernel", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCNear", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureColorCoCFar", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureTileCoC", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
                 .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureColorCoCNear", Sam_LinearClamp)
                 .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureColorCoCFar", Sam_LinearClamp);
 
@@ -925,6 +1000,27 @@ void DepthOfField::ComputePrefilteredTexture(const RenderAttributes& RenderAttri
     RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+void DepthOfField::ComputeTileCircleOfConfusion(const RenderAttributes& RenderAttribs)
+{
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_CIRCLE_OF_CONFUSION_TILES, m_FeatureFlags);
+    if (!RenderTech.IsInitializedSRB())
+        RenderTech.InitializeSRB(false);
+
+    ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeTileCircleOfConfusion"};
+
+    ITextureView* pRTVs[] = {
+        m_Resources[RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE].GetTextureRTV()};
+
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCNear"}.Set(m_Resources[RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE0].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCFar"}.Set(m_Resources[RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE1].GetTextureSRV());
+
+    RenderAttribs.pDeviceContext->SetRenderTargets(_countof(pRTVs), pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+    RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+    RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
 void DepthOfField::ComputeBokehFirstPass(const RenderAttributes& RenderAttribs)
 {
     auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_BOKEH_FIRST_PASS, m_FeatureFlags);
@@ -933,6 +1029,7 @@ void DepthOfField::ComputeBokehFirstPass(const RenderAttributes& RenderAttribs)
         ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "cbCameraAttribs"}.Set(RenderAttribs.pPostFXContext->GetCameraAttribsCB());
         ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "cbDepthOfFieldAttribs"}.Set(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER]);
         ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "g_TextureBokehKernel"}.Set(m_Resources[RESOURCE_IDENTIFIER_BOKEH_LARGE_KERNEL_TEXTURE].GetTextureSRV());
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "g_TextureBokehSmallKernel"}.Set(m_Resources[RESOURCE_IDENTIFIER_BOKEH_SMALL_KERNEL_TEXTURE].GetTextureSRV());
         RenderTech.InitializeSRB(true);
     }
 
@@ -944,6 +1041,7 @@ void DepthOfField::ComputeBokehFirstPass(const RenderAttributes& RenderAttribs)
 
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCNear"}.Set(m_Resources[RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE0].GetTextureSRV());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCFar"}.Set(m_Resources[RESOURCE_IDENTIFIER_PREFILTERED_TEXTURE1].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureTileCoC"}.Set(m_Resources[RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE].GetTextureSRV());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureRadiance"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_COLOR].GetTextureSRV());
 
     RenderAttribs.pDeviceContext->SetRenderTargets(_countof(pRTVs), pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -972,6 +1070,7 @@ void DepthOfField::ComputeBokehSecondPass(const RenderAttributes& RenderAttribs)
 
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCNear"}.Set(m_Resources[RESOURCE_IDENTIFIER_BOKEH_TEXTURE0].GetTextureSRV());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureColorCoCFar"}.Set(m_Resources[RESOURCE_IDENTIFIER_BOKEH_TEXTURE1].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureTileCoC"}.Set(m_Resources[RESOURCE_IDENTIFIER_CIRCLE_OF_CONFUSION_TILE_TEXTURE].GetTextureSRV());
 
     RenderAttribs.pDeviceContext->SetRenderTargets(_countof(pRTVs), pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
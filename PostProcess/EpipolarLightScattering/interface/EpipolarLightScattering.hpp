@@ -26,12 +26,18 @@
  */
 #pragma once
 
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/RenderDevice.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Texture.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/BufferView.h"
 #include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/TextureView.h"
+#include "../../../../DiligentCore/Graphics/GraphicsEngine/interface/Fence.h"
 #include "../../../../DiligentCore/Graphics/GraphicsTools/interface/RenderStateCache.h"
 #include "../../../../DiligentCore/Common/interface/RefCntAutoPtr.hpp"
 #include "../../../../DiligentCore/Common/interface/BasicMath.hpp"
@@ -45,6 +51,7 @@ using uint = uint32_t;
 #include "Shaders/PostProcess/ToneMapping/public/ToneMappingStructures.fxh"
 #include "Shaders/PostProcess/EpipolarLightScattering/public/EpipolarLightScatteringStructures.fxh"
 
+class TextureCacheWriter;
 
 class EpipolarLightScattering
 {
@@ -95,6 +102,35 @@ public:
         TEXTURE_FORMAT       OffscreenBackBuffer = TEX_FORMAT_R11G11B10_FLOAT;
         bool                 PackMatrixRowMajor  = false;
         AirScatteringAttribs ScatteringAttibs    = {};
+
+        /// Optional directory where the precomputed look-up tables are cached.
+        ///
+        /// \remarks    When set, the look-up tables that are computed synchronously are stored
+        ///             in this directory and loaded on subsequent runs instead of being recomputed.
+        ///             Cache entries are keyed by the atmosphere parameters and the table dimensions.
+        const char* LUTCacheDirectory = nullptr;
+
+        /// The number of look-up table precomputation steps executed per frame when
+        /// the atmosphere parameters change.
+        ///
+        /// \remarks    Every step is a single draw or dispatch call. The new tables are computed
+        ///             in a separate set of textures by PerformPostProcessing, while the current
+        ///             tables are used for rendering until all steps are complete.
+        ///             If the parameters change while an update is in progress, the update is
+        ///             completed first, and then a new one is started with the latest parameters.
+        ///             If zero, the tables are recomputed in the first frame after the change.
+        Uint32 LUTUpdateStepsPerFrame = 1;
+
+        /// Optional immediate context of an async compute queue.
+        ///
+        /// \remarks    When set, the compute steps of the time-sliced look-up table update
+        ///             (see LUTUpdateStepsPerFrame) are recorded on this context and overlap with
+        ///             the rendering on the main queue. The queues are synchronized with a fence, and
+        ///             the new tables are published once the async work is complete.
+        ///             The context must be an immediate context of the same device that supports compute,
+        ///             and the device must support native fences. Otherwise, all steps are recorded on
+        ///             the context passed to PrepareForNewFrame.
+        IDeviceContext* pAsyncComputeContext = nullptr;
     };
 
     EpipolarLightScattering(const CreateInfo& CI);
@@ -122,9 +158,13 @@ public:
 
 
     IBuffer*      GetMediaAttribsCB() { return m_pcbMediaAttribs; }
-    ITextureView* GetPrecomputedNetDensitySRV() { return m_ptex2DOccludedNetDensityToAtmTopSRV; }
+    ITextureView* GetPrecomputedNetDensitySRV() { return m_LUTs.OpticalDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE); }
     ITextureView* GetAmbientSkyLightSRV(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
 
+    /// Returns true if the look-up tables are being recomputed after the atmosphere parameters have changed.
+    /// Until the update is complete, the previous tables are used for rendering.
+    bool IsLUTUpdatePending() const { return m_PendingLUTUpdate.ResourceFlags != 0; }
+
 private:
     void ReconstructCameraSpaceZ();
     void RenderSliceEndpoints();
@@ -147,18 +187,28 @@ private:
     void FixInscatteringAtDepthBreaks(Uint32 uiMaxStepsAlongRay, EFixInscatteringMode Mode);
     void RenderSampleLocations();
 
-    void PrecomputeOpticalDepthTexture(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
-    void PrecomputeScatteringLUT(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
-    void CreateRandomSphereSamplingTexture(IRenderDevice* pDevice);
-    void ComputeAmbientSkyLightTexture(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
-    void ComputeScatteringCoefficients(IDeviceContext* pDeviceCtx = nullptr);
+    struct PrecomputedLUTs;
+
+    void   PrecomputeLUTs(Uint32 ResourceFlags, IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
+    void   CreatePrecomputedLUTs(IRenderDevice* pDevice, PrecomputedLUTs& LUTs, Uint32 ResourceFlags, bool CreateIntermediateTextures);
+    Uint32 GetNumLUTPrecomputeSteps() const;
+    Uint32 GetLUTPrecomputeStepResource(Uint32 Step) const;
+    bool   IsLUTPrecomputeComputeStep(Uint32 Step) const;
+    void   RunLUTPrecomputeStep(Uint32 Step, PrecomputedLUTs& LUTs, IBuffer* pMediaAttribsCB, IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
+    void   UpdatePendingLUTs(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext);
+    void   BeginAsyncLUTUpdate(IRenderDevice* pDevice, IDeviceContext* pContext);
+    size_t ComputeLUTCacheHash(const AirScatteringAttribs& MediaParams) const;
+    bool   LoadLUTsFromCache(Uint32 ResourceFlags, PrecomputedLUTs& LUTs, const AirScatteringAttribs& MediaParams, IDeviceContext* pContext);
+    void   StoreLUTsInCache(Uint32 ResourceFlags, PrecomputedLUTs& LUTs, const AirScatteringAttribs& MediaParams, IDeviceContext* pContext);
+    void   CreateRandomSphereSamplingTexture(IRenderDevice* pDevice);
+    void   ComputeScatteringCoefficients(AirScatteringAttribs& MediaParams) const;
     void CreateEpipolarTextures(IRenderDevice* pDevice);
     void CreateSliceEndPointsTexture(IRenderDevice* pDevice);
     void CreateExtinctionTexture(IRenderDevice* pDevice);
-    void CreateAmbientSkyLightTexture(IRenderDevice* pDevice);
     void CreateLowResLuminanceTexture(IRenderDevice* pDevice, IDeviceContext* pDeviceCtx);
     void CreateSliceUVDirAndOriginTexture(IRenderDevice* pDevice);
     void CreateCamSpaceZTexture(IRenderDevice* pDevice);
+    void CreateHalfResInscatteringTextures(IRenderDevice* pDevice);
     void CreateMinMaxShadowMap(IRenderDevice* pDevice);
 
     void DefineMacros(class ShaderMacroHelper& Macros);
@@ -207,9 +257,8 @@ private:
     int m_iPrecomputedSctrWDim = 64;
     int m_iPrecomputedSctrQDim = 16;
 
-    RefCntAutoPtr<ITextureView> m_ptex3DSingleScatteringSRV;
-    RefCntAutoPtr<ITextureView> m_ptex3DHighOrderScatteringSRV;
-    RefCntAutoPtr<ITextureView> m_ptex3DMultipleScatteringSRV;
+    int m_iNumScatteringOrders       = 4;
+    int m_iPrecomputeThreadGroupSize = 16;
 
     Uint32                      m_uiNumRandomSamplesOnSphere = 128;
     RefCntAutoPtr<ITextureView> m_ptex2DSphereRandomSamplingSRV;
@@ -219,11 +268,64 @@ private:
     RefCntAutoPtr<ITextureView> m_ptex2DLowResLuminanceSRV;
     RefCntAutoPtr<ITextureView> m_ptex2DAverageLuminanceRTV; // 1  X  1 R16F
 
-    static const int            sm_iAmbientSkyLightTexDim = 1024;
-    RefCntAutoPtr<ITextureView> m_ptex2DAmbientSkyLightSRV; // 1024 x 1 RGBA16F
-    RefCntAutoPtr<ITextureView> m_ptex2DAmbientSkyLightRTV;
-    RefCntAutoPtr<ITextureView> m_ptex2DOccludedNetDensityToAtmTopSRV; // 1024 x 1024 RG32F
-    RefCntAutoPtr<ITextureView> m_ptex2DOccludedNetDensityToAtmTopRTV;
+    static const int sm_iAmbientSkyLightTexDim = 1024;
+
+    struct PrecomputedLUTs
+    {
+        RefCntAutoPtr<ITexture> OpticalDepth;    // 1024 x 1024     RG32F
+        RefCntAutoPtr<ITexture> SingleSctr;      // U x V x W*Q     RGBA16F
+        RefCntAutoPtr<ITexture> HighOrderSctr;   // U x V x W*Q     RGBA16F
+        RefCntAutoPtr<ITexture> MultipleSctr;    // U x V x W*Q     RGBA16F
+        RefCntAutoPtr<ITexture> AmbientSkyLight; // 1024 x 1        RGBA16F
+
+        // Intermediate textures that are only used while the tables are computed.
+        // We have to bother with two high-order scattering textures, because HLSL only
+        // allows read-write operations on single component textures.
+        RefCntAutoPtr<ITexture> HighOrderSctrTmp; // U x V x W*Q     RGBA16F
+        RefCntAutoPtr<ITexture> SctrRadiance;     // U x V x W*Q     RGBA32F
+        RefCntAutoPtr<ITexture> InsctrOrder;      // U x V x W*Q     RGBA32F
+
+        // Returns the look-up table textures that hold the resources in ResourceFlags
+        // along with their names in the cache.
+        std::vector<std::pair<const char*, ITexture*>> GetTextures(Uint32 ResourceFlags);
+    };
+    // The look-up tables used for rendering. The textures are bound to the pipeline states
+    // as static resources, so they are never recreated.
+    PrecomputedLUTs m_LUTs;
+
+    // The look-up tables for the new atmosphere parameters that are computed over several frames
+    struct PendingLUTUpdate
+    {
+        PrecomputedLUTs      LUTs;
+        AirScatteringAttribs MediaParams   = {};
+        Uint32               ResourceFlags = 0;
+        Uint32               Step          = 0;
+
+        // The fence value that the async compute queue signals when it completes
+        // the last batch of steps, or zero if there is no outstanding async work.
+        Uint64 AsyncFenceValue = 0;
+
+        // The latest parameters set while the update was in progress.
+        // The next update is started with them once the current tables are published.
+        AirScatteringAttribs NextMediaParams = {};
+        bool                 HasNextUpdate   = false;
+    };
+    PendingLUTUpdate m_PendingLUTUpdate;
+
+    // Async compute queue that runs the compute steps of the pending update
+    RefCntAutoPtr<IDeviceContext> m_pAsyncComputeCtx;
+    RefCntAutoPtr<IFence>         m_pAsyncComputeFence;
+    Uint64                        m_LastAsyncComputeFenceValue = 0;
+    // Atmosphere parameters of the pending update read by the async compute queue
+    RefCntAutoPtr<IBuffer> m_pcbPendingMediaAttribs;
+    // Immediate contexts that access the look-up tables
+    Uint64 m_LUTImmediateContextMask = 1;
+
+    const std::string m_LUTCacheDirectory;
+    const Uint32      m_LUTUpdateStepsPerFrame;
+
+    // Writes the look-up tables to the cache once the GPU has computed them
+    std::unique_ptr<TextureCacheWriter> m_LUTCacheWriter;
 
     RefCntAutoPtr<IShader> m_pFullScreenTriangleVS;
 
@@ -238,6 +340,8 @@ private:
     RefCntAutoPtr<ITextureView> m_ptex2DInitialScatteredLightRTV; // Max Samples X Num Slices   RGBA16F
     RefCntAutoPtr<ITextureView> m_ptex2DSliceUVDirAndOriginRTV;   // Num Slices  X Num Cascaes  RGBA32F
     RefCntAutoPtr<ITextureView> m_ptex2DCamSpaceZRTV;             // BckBfrWdth  x BckBfrHght   R32F
+    RefCntAutoPtr<ITextureView> m_ptex2DHalfResInscatteringRTV;   // BckBfrWdth/2 x BckBfrHght/2 RGBA16F
+    RefCntAutoPtr<ITextureView> m_ptex2DHalfResExtinctionRTV;     // BckBfrWdth/2 x BckBfrHght/2 RGBA8_UNORM
     RefCntAutoPtr<ITextureView> m_ptex2DMinMaxShadowMapSRV[2];    // MinMaxSMRes x Num Slices   RG32F or RG16UNORM
     RefCntAutoPtr<ITextureView> m_ptex2DMinMaxShadowMapRTV[2];
 
@@ -277,7 +381,8 @@ private:
                                         IRenderStateCache*                pStateCache,
                                         const char*                       PSOName,
                                         IShader*                          ComputeShader,
-                                        const PipelineResourceLayoutDesc& ResourceLayout);
+                                        const PipelineResourceLayoutDesc& ResourceLayout,
+                                        Uint64                            ImmediateContextMask = 1);
 
         void PrepareSRB(IRenderDevice* pDevice, IResourceMapping* pResMapping, BIND_SHADER_RESOURCES_FLAGS Flags);
 
@@ -304,6 +409,8 @@ private:
         RENDER_TECH_INTERPOLATE_IRRADIANCE,
         RENDER_TECH_UNWARP_EPIPOLAR_SCATTERING,
         RENDER_TECH_UNWARP_AND_RENDER_LUMINANCE,
+        RENDER_TECH_UNWARP_HALF_RES_INSCATTERING,
+        RENDER_TECH_APPLY_HALF_RES_INSCATTERING,
         RENDER_TECH_UPDATE_AVERAGE_LUMINANCE,
         RENDER_TECH_FIX_INSCATTERING_LUM_ONLY,
         RENDER_TECH_FIX_INSCATTERING,
@@ -365,13 +472,12 @@ private:
         SRB_DEPENDENCY_INITIAL_SCTR_LIGHT_TEX   = 0x02000,
         SRB_DEPENDENCY_AVERAGE_LUMINANCE_TEX    = 0x04000,
         SRB_DEPENDENCY_SLICE_UV_DIR_TEX         = 0x08000,
-        SRB_DEPENDENCY_CAM_SPACE_Z_TEX          = 0x10000
+        SRB_DEPENDENCY_CAM_SPACE_Z_TEX          = 0x10000,
+        SRB_DEPENDENCY_HALF_RES_INSCTR_TEX      = 0x20000
     };
 
     RefCntAutoPtr<IShaderResourceBinding> m_pComputeMinMaxSMLevelSRB[2];
 
-    RefCntAutoPtr<ITexture> m_ptex3DHighOrderSctr, m_ptex3DHighOrderSctr2;
-
     RefCntAutoPtr<IBuffer> m_pcbPostProcessingAttribs;
     RefCntAutoPtr<IBuffer> m_pcbMediaAttribs;
     RefCntAutoPtr<IBuffer> m_pcbMiscParams;
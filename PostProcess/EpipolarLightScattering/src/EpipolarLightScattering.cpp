@@ -39,6 +39,9 @@
 #include "CommonlyUsedStates.h"
 #include "Align.hpp"
 #include "RenderStateCache.hpp"
+#include "FileSystem.hpp"
+#include "HashUtils.hpp"
+#include "Utilities/interface/TextureCacheUtils.hpp"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -218,15 +221,17 @@ void EpipolarLightScattering::RenderTechnique::InitializeComputeTechnique(IRende
                                                                           IRenderStateCache*                pStateCache,
                                                                           const char*                       PSOName,
                                                                           IShader*                          ComputeShader,
-                                                                          const PipelineResourceLayoutDesc& ResourceLayout)
+                                                                          const PipelineResourceLayoutDesc& ResourceLayout,
+                                                                          Uint64                            ImmediateContextMask)
 {
     ComputePipelineStateCreateInfo PSOCreateInfo;
     PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
 
-    PSODesc.Name           = PSOName;
-    PSODesc.ResourceLayout = ResourceLayout;
-    PSODesc.PipelineType   = PIPELINE_TYPE_COMPUTE;
-    PSOCreateInfo.pCS      = ComputeShader;
+    PSODesc.Name                 = PSOName;
+    PSODesc.ResourceLayout       = ResourceLayout;
+    PSODesc.PipelineType         = PIPELINE_TYPE_COMPUTE;
+    PSODesc.ImmediateContextMask = ImmediateContextMask;
+    PSOCreateInfo.pCS            = ComputeShader;
     PSO.Release();
     SRB.Release();
     PSO = RenderDeviceWithCache<false>{pDevice, pStateCache}.CreateComputePipelineState(PSOCreateInfo);
@@ -296,6 +301,8 @@ EpipolarLightScattering::EpipolarLightScattering(const CreateInfo& CI) :
     m_uiSampleRefinementCSThreadGroupSize(0),
     // Using small group size is inefficient because a lot of SIMD lanes become idle
     m_uiSampleRefinementCSMinimumThreadGroupSize(128), // Must be greater than 32
+    m_LUTCacheDirectory(CI.LUTCacheDirectory != nullptr ? CI.LUTCacheDirectory : ""),
+    m_LUTUpdateStepsPerFrame(CI.LUTUpdateStepsPerFrame),
     m_MediaParams(CI.ScatteringAttibs),
     m_uiUpToDateResourceFlags(0)
 {
@@ -305,6 +312,35 @@ EpipolarLightScattering::EpipolarLightScattering(const CreateInfo& CI) :
     m_MediaParams.fAtmAltitudeRangeInv = 1.f / (m_MediaParams.fAtmTopAltitude - m_MediaParams.fAtmBottomAltitude);
 
     CI.pDevice->CreateResourceMapping(ResourceMappingCreateInfo{}, &m_pResMapping);
+
+    m_LUTImmediateContextMask = Uint64{1} << CI.pContext->GetDesc().ContextId;
+    if (CI.pAsyncComputeContext != nullptr)
+    {
+        const DeviceContextDesc& MainCtxDesc  = CI.pContext->GetDesc();
+        const DeviceContextDesc& AsyncCtxDesc = CI.pAsyncComputeContext->GetDesc();
+        if (AsyncCtxDesc.IsDeferred || (AsyncCtxDesc.QueueType & COMMAND_QUEUE_TYPE_COMPUTE) != COMMAND_QUEUE_TYPE_COMPUTE || AsyncCtxDesc.ContextId == MainCtxDesc.ContextId)
+        {
+            LOG_WARNING_MESSAGE("Async compute context must be an immediate context of a compute queue that is different from the main context. "
+                                "Look-up tables will be updated on the main context.");
+        }
+        else if (!CI.pDevice->GetDeviceInfo().Features.NativeFence)
+        {
+            LOG_WARNING_MESSAGE("Native fences are not supported by the device. Look-up tables will be updated on the main context.");
+        }
+        else
+        {
+            FenceDesc Desc;
+            Desc.Name = "Epipolar light scattering async compute fence";
+            Desc.Type = FENCE_TYPE_GENERAL;
+            CI.pDevice->CreateFence(Desc, &m_pAsyncComputeFence);
+            if (m_pAsyncComputeFence)
+            {
+                m_pAsyncComputeCtx        = CI.pAsyncComputeContext;
+                m_LUTImmediateContextMask |= Uint64{1} << AsyncCtxDesc.ContextId;
+            }
+        }
+    }
+
     const auto AdapterType = CI.pDevice->GetAdapterInfo().Type;
     if (AdapterType == ADAPTER_TYPE_SOFTWARE || AdapterType == ADAPTER_TYPE_INTEGRATED)
     {
@@ -313,13 +349,17 @@ EpipolarLightScattering::EpipolarLightScattering(const CreateInfo& CI) :
         m_iPrecomputedSctrVDim /= 2;
         m_iPrecomputedSctrWDim /= 2;
         m_iPrecomputedSctrQDim /= 2;
+        m_iPrecomputeThreadGroupSize = 8;
     }
+    if (CI.pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_GLES)
+        m_iNumScatteringOrders = 3;
 
     // clang-format off
     CreateUniformBuffer(CI.pDevice, sizeof(EpipolarLightScatteringAttribs), "Epipolar Light Scattering Attribs CB", &m_pcbPostProcessingAttribs);
     CreateUniformBuffer(CI.pDevice, sizeof(MiscDynamicParams),              "Misc Dynamic Params CB",               &m_pcbMiscParams);
     // clang-format on
 
+    ComputeScatteringCoefficients(m_MediaParams);
     {
         BufferDesc CBDesc;
         CBDesc.Usage     = USAGE_DEFAULT;
@@ -342,11 +382,15 @@ EpipolarLightScattering::EpipolarLightScattering(const CreateInfo& CI) :
     CI.pDevice->CreateSampler(Sam_PointClamp, &m_pPointClampSampler);
     m_pFullScreenTriangleVS = CreateShader(CI.pDevice, CI.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, m_ShaderFlags);
 
-    ComputeScatteringCoefficients(CI.pContext);
+    if (!m_LUTCacheDirectory.empty())
+        m_LUTCacheWriter = std::make_unique<TextureCacheWriter>(CI.pDevice);
 
-    PrecomputeOpticalDepthTexture(CI.pDevice, CI.pStateCache, CI.pContext);
-
-    CreateAmbientSkyLightTexture(CI.pDevice);
+    PrecomputeLUTs(UpToDateResourceFlags::PrecomputedOpticalDepthTex, CI.pDevice, CI.pStateCache, CI.pContext);
+    if (m_LUTCacheWriter)
+    {
+        // Waiting for the GPU is fine at initialization
+        m_LUTCacheWriter->Flush(CI.pContext);
+    }
 }
 
 EpipolarLightScattering::~EpipolarLightScattering()
@@ -359,6 +403,8 @@ void EpipolarLightScattering::OnWindowResize(IRenderDevice* pDevice, Uint32 uiBa
     m_uiBackBufferWidth  = uiBackBufferWidth;
     m_uiBackBufferHeight = uiBackBufferHeight;
     m_ptex2DCamSpaceZRTV.Release();
+    m_ptex2DHalfResInscatteringRTV.Release();
+    m_ptex2DHalfResExtinctionRTV.Release();
 }
 
 void EpipolarLightScattering::DefineMacros(ShaderMacroHelper& Macros)
@@ -384,15 +430,54 @@ void EpipolarLightScattering::DefineMacros(ShaderMacroHelper& Macros)
     }
 }
 
-void EpipolarLightScattering::PrecomputeOpticalDepthTexture(IRenderDevice*     pDevice,
-                                                            IRenderStateCache* pStateCache,
-                                                            IDeviceContext*    pDeviceContext)
+// Bump this value whenever the look-up table computation changes to invalidate the cache
+static constexpr Uint32 LUTCacheVersion = 1;
+
+std::vector<std::pair<const char*, ITexture*>> EpipolarLightScattering::PrecomputedLUTs::GetTextures(Uint32 ResourceFlags)
+{
+    std::vector<std::pair<const char*, ITexture*>> Textures;
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedOpticalDepthTex)
+    {
+        Textures.emplace_back("EpipolarOpticalDepth", OpticalDepth);
+    }
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex)
+    {
+        Textures.emplace_back("EpipolarSingleSctr", SingleSctr);
+        Textures.emplace_back("EpipolarHighOrderSctr", HighOrderSctr);
+        Textures.emplace_back("EpipolarMultipleSctr", MultipleSctr);
+    }
+    if (ResourceFlags & UpToDateResourceFlags::AmbientSkyLightTex)
+    {
+        Textures.emplace_back("EpipolarAmbientSkyLight", AmbientSkyLight);
+    }
+    return Textures;
+}
+
+static void TransitionLUTsToShaderResource(IDeviceContext* pContext, const std::vector<std::pair<const char*, ITexture*>>& Textures)
 {
-    if (!m_ptex2DOccludedNetDensityToAtmTopSRV)
+    std::vector<StateTransitionDesc> Barriers;
+    Barriers.reserve(Textures.size());
+    for (const auto& Tex : Textures)
+        Barriers.emplace_back(Tex.second, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+}
+
+void EpipolarLightScattering::CreatePrecomputedLUTs(IRenderDevice*   pDevice,
+                                                    PrecomputedLUTs& LUTs,
+                                                    Uint32           ResourceFlags,
+                                                    bool             CreateIntermediateTextures)
+{
+    auto CreateLUTTexture = [&](TextureDesc TexDesc, RefCntAutoPtr<ITexture>& pTexture) {
+        if (pTexture)
+            return;
+
+        TexDesc.ImmediateContextMask = m_LUTImmediateContextMask;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)->SetSampler(m_pLinearClampSampler);
+    };
+
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedOpticalDepthTex)
     {
-        // Create texture if it has not been created yet.
-        // Do not recreate texture if it already exists as this may
-        // break static resource bindings.
         TextureDesc TexDesc;
         TexDesc.Name      = "Occluded Net Density to Atm Top";
         TexDesc.Type      = RESOURCE_DIM_TEX_2D;
@@ -402,36 +487,520 @@ void EpipolarLightScattering::PrecomputeOpticalDepthTexture(IRenderDevice*     p
         TexDesc.MipLevels = 1;
         TexDesc.Usage     = USAGE_DEFAULT;
         TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        RefCntAutoPtr<ITexture> tex2DOccludedNetDensityToAtmTop;
-        pDevice->CreateTexture(TexDesc, nullptr, &tex2DOccludedNetDensityToAtmTop);
-        m_ptex2DOccludedNetDensityToAtmTopSRV = tex2DOccludedNetDensityToAtmTop->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-        m_ptex2DOccludedNetDensityToAtmTopSRV->SetSampler(m_pLinearClampSampler);
-        m_ptex2DOccludedNetDensityToAtmTopRTV = tex2DOccludedNetDensityToAtmTop->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
-        m_pResMapping->AddResource("g_tex2DOccludedNetDensityToAtmTop", m_ptex2DOccludedNetDensityToAtmTopSRV, false);
+        CreateLUTTexture(TexDesc, LUTs.OpticalDepth);
     }
 
-    ITextureView* pRTVs[] = {m_ptex2DOccludedNetDensityToAtmTopRTV};
-    pDeviceContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Type      = RESOURCE_DIM_TEX_3D;
+        TexDesc.Width     = m_iPrecomputedSctrUDim;
+        TexDesc.Height    = m_iPrecomputedSctrVDim;
+        TexDesc.Depth     = m_iPrecomputedSctrWDim * m_iPrecomputedSctrQDim;
+        TexDesc.MipLevels = 1;
+        TexDesc.Format    = TEX_FORMAT_RGBA16_FLOAT;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_UNORDERED_ACCESS | BIND_SHADER_RESOURCE;
+
+        TexDesc.Name = "Single Scattering LUT";
+        CreateLUTTexture(TexDesc, LUTs.SingleSctr);
+        TexDesc.Name = "High Order Scattering LUT";
+        CreateLUTTexture(TexDesc, LUTs.HighOrderSctr);
+        TexDesc.Name = "Multiple Scattering LUT";
+        CreateLUTTexture(TexDesc, LUTs.MultipleSctr);
 
-    auto& PrecomputeNetDensityToAtmTopTech = m_RenderTech[RENDER_TECH_PRECOMPUTE_NET_DENSITY_TO_ATM_TOP];
-    if (!PrecomputeNetDensityToAtmTopTech.PSO)
+        if (CreateIntermediateTextures)
+        {
+            TexDesc.Name = "High Order Scattering Tmp";
+            CreateLUTTexture(TexDesc, LUTs.HighOrderSctrTmp);
+
+            // We need higher precision to store intermediate data
+            TexDesc.Format = TEX_FORMAT_RGBA32_FLOAT;
+            TexDesc.Name   = "Scattering Radiance";
+            CreateLUTTexture(TexDesc, LUTs.SctrRadiance);
+            TexDesc.Name = "Inscattering Order";
+            CreateLUTTexture(TexDesc, LUTs.InsctrOrder);
+        }
+    }
+
+    if (ResourceFlags & UpToDateResourceFlags::AmbientSkyLightTex)
     {
-        RefCntAutoPtr<IShader> pPrecomputeNetDensityToAtmTopPS;
-        pPrecomputeNetDensityToAtmTopPS = CreateShader(pDevice, pStateCache, "PrecomputeNetDensityToAtmTop.fx", "PrecomputeNetDensityToAtmTopPS", SHADER_TYPE_PIXEL, m_ShaderFlags);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
-        PrecomputeNetDensityToAtmTopTech.InitializeFullScreenTriangleTechnique(pDevice, pStateCache, "PrecomputeNetDensityToAtmTopPSO", m_pFullScreenTriangleVS,
-                                                                               pPrecomputeNetDensityToAtmTopPS, ResourceLayout, PrecomputedNetDensityTexFmt);
-        PrecomputeNetDensityToAtmTopTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Ambient Sky Light";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = sm_iAmbientSkyLightTexDim;
+        TexDesc.Height    = 1;
+        TexDesc.Format    = AmbientSkyLightTexFmt;
+        TexDesc.MipLevels = 1;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+        CreateLUTTexture(TexDesc, LUTs.AmbientSkyLight);
     }
+}
+
+// The look-up tables are computed in the following steps:
+//   0                        - optical depth to the top of the atmosphere
+//   1                        - single scattering
+//   2 + 3 * (Order - 1) + 0  - scattering radiance of the previous order
+//   2 + 3 * (Order - 1) + 1  - in-scattering of the current order
+//   2 + 3 * (Order - 1) + 2  - high-order scattering accumulation
+//   NumSteps - 2             - combination of single and high-order scattering
+//   NumSteps - 1             - ambient sky light
+// where Order runs from 1 to NumScatteringOrders - 1.
+Uint32 EpipolarLightScattering::GetNumLUTPrecomputeSteps() const
+{
+    return 4 + 3 * static_cast<Uint32>(m_iNumScatteringOrders - 1);
+}
 
-    PrecomputeNetDensityToAtmTopTech.PrepareSRB(pDevice, m_pResMapping);
-    PrecomputeNetDensityToAtmTopTech.Render(pDeviceContext);
+Uint32 EpipolarLightScattering::GetLUTPrecomputeStepResource(Uint32 Step) const
+{
+    const Uint32 NumSteps = GetNumLUTPrecomputeSteps();
+    VERIFY_EXPR(Step < NumSteps);
 
-    m_uiUpToDateResourceFlags |= UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+    if (Step == 0)
+        return UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+    else if (Step < NumSteps - 1)
+        return UpToDateResourceFlags::PrecomputedIntegralsTex;
+    else
+        return UpToDateResourceFlags::AmbientSkyLightTex;
 }
 
+bool EpipolarLightScattering::IsLUTPrecomputeComputeStep(Uint32 Step) const
+{
+    // Optical depth and ambient sky light are rendered with pixel shaders
+    return Step > 0 && Step < GetNumLUTPrecomputeSteps() - 1;
+}
+
+// pMediaAttribsCB is only used by compute steps. Pixel shader steps always read the
+// atmosphere parameters from m_pcbMediaAttribs that is bound as a static resource.
+void EpipolarLightScattering::RunLUTPrecomputeStep(Uint32             Step,
+                                                   PrecomputedLUTs&   LUTs,
+                                                   IBuffer*           pMediaAttribsCB,
+                                                   IRenderDevice*     pDevice,
+                                                   IRenderStateCache* pStateCache,
+                                                   IDeviceContext*    pContext)
+{
+    const Uint32 NumSteps = GetNumLUTPrecomputeSteps();
+    VERIFY_EXPR(Step < NumSteps);
+
+    auto GetSRV = [](ITexture* pTexture) {
+        return pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    };
+    auto GetUAV = [](ITexture* pTexture) {
+        return pTexture->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS);
+    };
+
+    if (Step == 0)
+    {
+        auto& PrecomputeNetDensityToAtmTopTech = m_RenderTech[RENDER_TECH_PRECOMPUTE_NET_DENSITY_TO_ATM_TOP];
+        if (!PrecomputeNetDensityToAtmTopTech.PSO)
+        {
+            RefCntAutoPtr<IShader> pPrecomputeNetDensityToAtmTopPS;
+            pPrecomputeNetDensityToAtmTopPS = CreateShader(pDevice, pStateCache, "PrecomputeNetDensityToAtmTop.fx", "PrecomputeNetDensityToAtmTopPS", SHADER_TYPE_PIXEL, m_ShaderFlags);
+            PipelineResourceLayoutDesc ResourceLayout;
+            ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+            PrecomputeNetDensityToAtmTopTech.InitializeFullScreenTriangleTechnique(pDevice, pStateCache, "PrecomputeNetDensityToAtmTopPSO", m_pFullScreenTriangleVS,
+                                                                                   pPrecomputeNetDensityToAtmTopPS, ResourceLayout, PrecomputedNetDensityTexFmt);
+            PrecomputeNetDensityToAtmTopTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+        }
+
+        ITextureView* pRTVs[] = {LUTs.OpticalDepth->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        PrecomputeNetDensityToAtmTopTech.PrepareSRB(pDevice, m_pResMapping);
+        PrecomputeNetDensityToAtmTopTech.Render(pContext);
+        return;
+    }
+
+    if (!m_ptex2DSphereRandomSamplingSRV)
+        CreateRandomSphereSamplingTexture(pDevice);
+
+    if (Step == NumSteps - 1)
+    {
+        auto& PrecomputeAmbientSkyLightTech = m_RenderTech[RENDER_TECH_PRECOMPUTE_AMBIENT_SKY_LIGHT];
+        if (!PrecomputeAmbientSkyLightTech.PSO)
+        {
+            ShaderMacroHelper Macros;
+            Macros.AddShaderMacro("NUM_RANDOM_SPHERE_SAMPLES", static_cast<Int32>(m_uiNumRandomSamplesOnSphere));
+
+            auto pPrecomputeAmbientSkyLightPS = CreateShader(pDevice, pStateCache, "PrecomputeAmbientSkyLight.fx", "PrecomputeAmbientSkyLightPS",
+                                                             SHADER_TYPE_PIXEL, m_ShaderFlags, Macros);
+
+            PipelineResourceLayoutDesc ResourceLayout;
+            ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+            // The multiple scattering LUT is set explicitly as the ambient sky light
+            // may be computed from the pending look-up tables.
+            ShaderResourceVariableDesc Vars[] =
+                {
+                    {SHADER_TYPE_PIXEL, "g_tex3DMultipleSctrLUT", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+                };
+            ResourceLayout.Variables    = Vars;
+            ResourceLayout.NumVariables = _countof(Vars);
+            PrecomputeAmbientSkyLightTech.InitializeFullScreenTriangleTechnique(pDevice, pStateCache, "PrecomputeAmbientSkyLight",
+                                                                                m_pFullScreenTriangleVS, pPrecomputeAmbientSkyLightPS,
+                                                                                ResourceLayout, AmbientSkyLightTexFmt);
+            PrecomputeAmbientSkyLightTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+        }
+
+        ITextureView* pRTVs[] = {LUTs.AmbientSkyLight->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        PrecomputeAmbientSkyLightTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
+        PrecomputeAmbientSkyLightTech.SRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_tex3DMultipleSctrLUT")->Set(GetSRV(LUTs.MultipleSctr));
+        PrecomputeAmbientSkyLightTech.Render(pContext);
+        return;
+    }
+
+    // Scattering look-up tables
+    CreatePrecomputedLUTs(pDevice, LUTs, UpToDateResourceFlags::PrecomputedIntegralsTex, true);
+
+    auto GetComputeTechnique = [&](RENDER_TECH TechId, const char* FileName, const char* EntryPoint, const char* PSOName) -> RenderTechnique& {
+        RenderTechnique& Tech = m_RenderTech[TechId];
+        if (!Tech.PSO)
+        {
+            ShaderMacroHelper Macros;
+            DefineMacros(Macros);
+            Macros.AddShaderMacro("THREAD_GROUP_SIZE", m_iPrecomputeThreadGroupSize);
+            if (TechId == RENDER_TECH_COMPUTE_SCATTERING_RADIANCE)
+                Macros.AddShaderMacro("NUM_RANDOM_SPHERE_SAMPLES", static_cast<Int32>(m_uiNumRandomSamplesOnSphere));
+            auto pCS = CreateShader(pDevice, pStateCache, FileName, EntryPoint, SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
+            PipelineResourceLayoutDesc ResourceLayout;
+            ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            Tech.InitializeComputeTechnique(pDevice, pStateCache, PSOName, pCS, ResourceLayout, m_LUTImmediateContextMask);
+        }
+        // Only constant buffers and the random sampling texture are taken from the resource mapping.
+        // Look-up tables are set explicitly as they may be computed into the pending textures.
+        Tech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
+        // The atmosphere parameters of the pending update may be read from a separate buffer on the async compute queue
+        if (IShaderResourceVariable* pVar = Tech.SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbParticipatingMediaScatteringParams"))
+            pVar->Set(pMediaAttribsCB);
+        return Tech;
+    };
+    auto SetVariable = [](RenderTechnique& Tech, const char* Name, ITextureView* pView) {
+        Tech.SRB->GetVariableByName(SHADER_TYPE_COMPUTE, Name)->Set(pView);
+    };
+
+    const TextureDesc&           SctrTexDesc = LUTs.SingleSctr->GetDesc();
+    const DispatchComputeAttribs DispatchAttrs{
+        SctrTexDesc.Width / m_iPrecomputeThreadGroupSize,
+        SctrTexDesc.Height / m_iPrecomputeThreadGroupSize,
+        SctrTexDesc.Depth};
+
+    if (Step == 1)
+    {
+        // Precompute single scattering
+        RenderTechnique& Tech = GetComputeTechnique(RENDER_TECH_PRECOMPUTE_SINGLE_SCATTERING, "PrecomputeSingleScattering.fx", "PrecomputeSingleScatteringCS", "PrecomputeSingleScattering");
+        SetVariable(Tech, "g_tex2DOccludedNetDensityToAtmTop", GetSRV(LUTs.OpticalDepth));
+        SetVariable(Tech, "g_rwtex3DSingleScattering", GetUAV(LUTs.SingleSctr));
+        Tech.DispatchCompute(pContext, DispatchAttrs);
+    }
+    else if (Step < NumSteps - 2)
+    {
+        // Precompute multiple scattering
+        const int iSctrOrder = static_cast<int>(Step - 2) / 3 + 1;
+        switch ((Step - 2) % 3)
+        {
+            case 0:
+            {
+                // Step 1: compute differential in-scattering
+                RenderTechnique& Tech = GetComputeTechnique(RENDER_TECH_COMPUTE_SCATTERING_RADIANCE, "ComputeSctrRadiance.fx", "ComputeSctrRadianceCS", "ComputeSctrRadiance");
+                SetVariable(Tech, "g_tex2DOccludedNetDensityToAtmTop", GetSRV(LUTs.OpticalDepth));
+                SetVariable(Tech, "g_tex3DPreviousSctrOrder", GetSRV(iSctrOrder == 1 ? LUTs.SingleSctr : LUTs.InsctrOrder));
+                SetVariable(Tech, "g_rwtex3DSctrRadiance", GetUAV(LUTs.SctrRadiance));
+                Tech.DispatchCompute(pContext, DispatchAttrs);
+
+                // It seemse like on Intel GPU, the driver accumulates work into big batch.
+                // The resulting batch turns out to be too big for GPU to process it in allowed time
+                // limit, and the system kills the driver. So we have to flush the command buffer to
+                // force execution of compute shaders.
+                pContext->Flush();
+                break;
+            }
+
+            case 1:
+            {
+                // Step 2: integrate differential in-scattering
+                RenderTechnique& Tech = GetComputeTechnique(RENDER_TECH_COMPUTE_SCATTERING_ORDER, "ComputeScatteringOrder.fx", "ComputeScatteringOrderCS", "ComputeScatteringOrder");
+                SetVariable(Tech, "g_tex3DPointwiseSctrRadiance", GetSRV(LUTs.SctrRadiance));
+                SetVariable(Tech, "g_rwtex3DInsctrOrder", GetUAV(LUTs.InsctrOrder));
+                Tech.DispatchCompute(pContext, DispatchAttrs);
+                break;
+            }
 
+            case 2:
+            {
+                // Step 3: accumulate high-order scattering.
+                // The two textures are ping-ponged so that the last order is always
+                // written to the high-order scattering look-up table.
+                const bool WriteToLUT = (m_iNumScatteringOrders - 1 - iSctrOrder) % 2 == 0;
+                ITexture*  pDstTex    = WriteToLUT ? LUTs.HighOrderSctr : LUTs.HighOrderSctrTmp;
+                ITexture*  pPrevTex   = WriteToLUT ? LUTs.HighOrderSctrTmp : LUTs.HighOrderSctr;
+
+                RenderTechnique* pRenderTech = nullptr;
+                if (iSctrOrder == 1)
+                {
+                    pRenderTech = &GetComputeTechnique(RENDER_TECH_INIT_HIGH_ORDER_SCATTERING, "InitHighOrderScattering.fx", "InitHighOrderScatteringCS", "InitHighOrderScattering");
+                }
+                else
+                {
+                    pRenderTech = &GetComputeTechnique(RENDER_TECH_UPDATE_HIGH_ORDER_SCATTERING, "UpdateHighOrderScattering.fx", "UpdateHighOrderScatteringCS", "UpdateHighOrderScattering");
+                    SetVariable(*pRenderTech, "g_tex3DHighOrderOrderScattering", GetSRV(pPrevTex));
+                }
+                SetVariable(*pRenderTech, "g_rwtex3DHighOrderSctr", GetUAV(pDstTex));
+                SetVariable(*pRenderTech, "g_tex3DCurrentOrderScattering", GetSRV(LUTs.InsctrOrder));
+                pRenderTech->DispatchCompute(pContext, DispatchAttrs);
+
+                // Flush the command buffer to force execution of compute shaders and avoid device
+                // reset on low-end Intel GPUs.
+                pContext->Flush();
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Combine single scattering and higher order scattering into single texture
+        RenderTechnique& Tech = GetComputeTechnique(RENDER_TECH_COMBINE_SCATTERING_ORDERS, "CombineScatteringOrders.fx", "CombineScatteringOrdersCS", "CombineScatteringOrders");
+        SetVariable(Tech, "g_tex3DSingleSctrLUT", GetSRV(LUTs.SingleSctr));
+        SetVariable(Tech, "g_tex3DHighOrderSctrLUT", GetSRV(LUTs.HighOrderSctr));
+        SetVariable(Tech, "g_rwtex3DMultipleSctr", GetUAV(LUTs.MultipleSctr));
+        Tech.DispatchCompute(pContext, DispatchAttrs);
+    }
+}
+
+size_t EpipolarLightScattering::ComputeLUTCacheHash(const AirScatteringAttribs& MediaParams) const
+{
+    return ComputeHash(LUTCacheVersion, ComputeHashRaw(&MediaParams, sizeof(MediaParams)),
+                       m_iPrecomputedSctrUDim, m_iPrecomputedSctrVDim, m_iPrecomputedSctrWDim, m_iPrecomputedSctrQDim,
+                       m_iNumScatteringOrders, m_uiNumRandomSamplesOnSphere);
+}
+
+bool EpipolarLightScattering::LoadLUTsFromCache(Uint32                      ResourceFlags,
+                                                PrecomputedLUTs&            LUTs,
+                                                const AirScatteringAttribs& MediaParams,
+                                                IDeviceContext*             pContext)
+{
+    if (m_LUTCacheDirectory.empty())
+        return false;
+
+    const size_t Hash     = ComputeLUTCacheHash(MediaParams);
+    const auto   Textures = LUTs.GetTextures(ResourceFlags);
+    for (const auto& Tex : Textures)
+    {
+        const std::string FilePath = GetTextureCacheFilePath(m_LUTCacheDirectory.c_str(), Tex.first, Hash);
+        if (!LoadTextureFromCache(pContext, FilePath.c_str(), Tex.second))
+            return false;
+    }
+    TransitionLUTsToShaderResource(pContext, Textures);
+
+    return true;
+}
+
+void EpipolarLightScattering::StoreLUTsInCache(Uint32                      ResourceFlags,
+                                               PrecomputedLUTs&            LUTs,
+                                               const AirScatteringAttribs& MediaParams,
+                                               IDeviceContext*             pContext)
+{
+    if (!m_LUTCacheWriter)
+        return;
+
+    // The tables are usually recomputed inside the frame, so they are read back
+    // and written to the cache by the writer once the GPU has completed them.
+    const size_t Hash = ComputeLUTCacheHash(MediaParams);
+    for (const auto& Tex : LUTs.GetTextures(ResourceFlags))
+    {
+        const std::string FilePath = GetTextureCacheFilePath(m_LUTCacheDirectory.c_str(), Tex.first, Hash);
+        if (!FileSystem::FileExists(FilePath.c_str()))
+            m_LUTCacheWriter->Enqueue(pContext, Tex.second, FilePath.c_str());
+    }
+}
+
+void EpipolarLightScattering::PrecomputeLUTs(Uint32             ResourceFlags,
+                                             IRenderDevice*     pDevice,
+                                             IRenderStateCache* pStateCache,
+                                             IDeviceContext*    pContext)
+{
+    // Scattering look-up tables are computed from the optical depth, and the
+    // ambient sky light is computed from the multiple scattering look-up table.
+    if (ResourceFlags & UpToDateResourceFlags::AmbientSkyLightTex)
+        ResourceFlags |= UpToDateResourceFlags::PrecomputedIntegralsTex;
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex)
+        ResourceFlags |= UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+    ResourceFlags &= ~m_uiUpToDateResourceFlags;
+    if (ResourceFlags == 0)
+        return;
+
+    // Textures are only created once. Do not recreate them as this
+    // may break static resource bindings.
+    CreatePrecomputedLUTs(pDevice, m_LUTs, ResourceFlags, false);
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedOpticalDepthTex)
+    {
+        m_pResMapping->AddResource("g_tex2DOccludedNetDensityToAtmTop", m_LUTs.OpticalDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), false);
+    }
+    if (ResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex)
+    {
+        // clang-format off
+        m_pResMapping->AddResource("g_tex3DSingleSctrLUT",    m_LUTs.SingleSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE),    false);
+        m_pResMapping->AddResource("g_tex3DHighOrderSctrLUT", m_LUTs.HighOrderSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), false);
+        m_pResMapping->AddResource("g_tex3DMultipleSctrLUT",  m_LUTs.MultipleSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE),  false);
+        // clang-format on
+    }
+
+    if (!LoadLUTsFromCache(ResourceFlags, m_LUTs, m_MediaParams, pContext))
+    {
+        const Uint32 NumSteps = GetNumLUTPrecomputeSteps();
+        for (Uint32 Step = 0; Step < NumSteps; ++Step)
+        {
+            if (GetLUTPrecomputeStepResource(Step) & ResourceFlags)
+                RunLUTPrecomputeStep(Step, m_LUTs, m_pcbMediaAttribs, pDevice, pStateCache, pContext);
+        }
+        StoreLUTsInCache(ResourceFlags, m_LUTs, m_MediaParams, pContext);
+
+        // Intermediate textures are only needed while the tables are computed
+        m_LUTs.HighOrderSctrTmp.Release();
+        m_LUTs.SctrRadiance.Release();
+        m_LUTs.InsctrOrder.Release();
+    }
+
+    m_uiUpToDateResourceFlags |= ResourceFlags;
+}
+
+void EpipolarLightScattering::BeginAsyncLUTUpdate(IRenderDevice* pDevice, IDeviceContext* pContext)
+{
+    VERIFY_EXPR(m_pAsyncComputeCtx && m_pAsyncComputeFence);
+    PendingLUTUpdate& Update = m_PendingLUTUpdate;
+
+    // Compute queues can't transition resources from graphics-only states, so the optical
+    // depth that was rendered on the main context is handed over in the shader resource state.
+    StateTransitionDesc Barrier{Update.LUTs.OpticalDepth, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+
+    // Make the async queue wait for the commands that have been recorded on the main context
+    pContext->EnqueueSignal(m_pAsyncComputeFence, ++m_LastAsyncComputeFenceValue);
+    pContext->Flush();
+    m_pAsyncComputeCtx->DeviceWaitForFence(m_pAsyncComputeFence, m_LastAsyncComputeFenceValue);
+
+    if (!m_pcbPendingMediaAttribs)
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name                 = "Pending media attribs CB";
+        CBDesc.Usage                = USAGE_DEFAULT;
+        CBDesc.BindFlags            = BIND_UNIFORM_BUFFER;
+        CBDesc.Size                 = sizeof(AirScatteringAttribs);
+        CBDesc.ImmediateContextMask = m_LUTImmediateContextMask;
+        pDevice->CreateBuffer(CBDesc, nullptr, &m_pcbPendingMediaAttribs);
+    }
+    m_pAsyncComputeCtx->UpdateBuffer(m_pcbPendingMediaAttribs, 0, sizeof(Update.MediaParams), &Update.MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void EpipolarLightScattering::UpdatePendingLUTs(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext)
+{
+    PendingLUTUpdate& Update = m_PendingLUTUpdate;
+    VERIFY_EXPR(Update.ResourceFlags != 0);
+
+    if (Update.AsyncFenceValue != 0)
+    {
+        // The pending tables may still be accessed by the async compute queue.
+        // Poll the fence instead of waiting on the GPU to keep the main queue from stalling.
+        if (m_pAsyncComputeFence->GetCompletedValue() < Update.AsyncFenceValue)
+            return;
+
+        pContext->DeviceWaitForFence(m_pAsyncComputeFence, Update.AsyncFenceValue);
+        Update.AsyncFenceValue = 0;
+    }
+
+    const Uint32 NumSteps = GetNumLUTPrecomputeSteps();
+    if (Update.Step == 0)
+    {
+        CreatePrecomputedLUTs(pDevice, Update.LUTs, Update.ResourceFlags, false);
+        if (LoadLUTsFromCache(Update.ResourceFlags, Update.LUTs, Update.MediaParams, pContext))
+            Update.Step = NumSteps;
+    }
+
+    if (Update.Step < NumSteps)
+    {
+        // Precomputation shaders read the atmosphere parameters from the media constant buffer
+        // that must contain the current parameters for rendering.
+        pContext->UpdateBuffer(m_pcbMediaAttribs, 0, sizeof(Update.MediaParams), &Update.MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        bool   AsyncStepsRecorded = false;
+        Uint32 NumExecutedSteps   = 0;
+        for (; Update.Step < NumSteps && NumExecutedSteps < m_LUTUpdateStepsPerFrame; ++Update.Step)
+        {
+            if ((GetLUTPrecomputeStepResource(Update.Step) & Update.ResourceFlags) == 0)
+                continue;
+
+            const bool RunAsync = m_pAsyncComputeCtx && IsLUTPrecomputeComputeStep(Update.Step);
+            if (RunAsync && !AsyncStepsRecorded)
+            {
+                BeginAsyncLUTUpdate(pDevice, pContext);
+                AsyncStepsRecorded = true;
+            }
+            else if (!RunAsync && AsyncStepsRecorded)
+            {
+                // The remaining steps use the results of the async queue and
+                // are recorded on the main context once it has finished.
+                break;
+            }
+
+            if (RunAsync)
+                RunLUTPrecomputeStep(Update.Step, Update.LUTs, m_pcbPendingMediaAttribs, pDevice, pStateCache, m_pAsyncComputeCtx);
+            else
+                RunLUTPrecomputeStep(Update.Step, Update.LUTs, m_pcbMediaAttribs, pDevice, pStateCache, pContext);
+            ++NumExecutedSteps;
+        }
+
+        if (AsyncStepsRecorded)
+        {
+            m_pAsyncComputeCtx->EnqueueSignal(m_pAsyncComputeFence, ++m_LastAsyncComputeFenceValue);
+            m_pAsyncComputeCtx->Flush();
+            Update.AsyncFenceValue = m_LastAsyncComputeFenceValue;
+        }
+
+        if (Update.Step < NumSteps || AsyncStepsRecorded)
+        {
+            pContext->UpdateBuffer(m_pcbMediaAttribs, 0, sizeof(m_MediaParams), &m_MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            return;
+        }
+    }
+
+    // All steps are complete: publish the new look-up tables.
+    // The textures in use are bound to the pipeline states as static resources and
+    // can't be replaced, so the new data is copied into them.
+    const auto SrcTextures = Update.LUTs.GetTextures(Update.ResourceFlags);
+    const auto DstTextures = m_LUTs.GetTextures(Update.ResourceFlags);
+    VERIFY_EXPR(SrcTextures.size() == DstTextures.size());
+    for (size_t i = 0; i < SrcTextures.size(); ++i)
+    {
+        CopyTextureAttribs CopyAttribs{SrcTextures[i].second, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, DstTextures[i].second, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+    }
+    TransitionLUTsToShaderResource(pContext, DstTextures);
+
+    m_MediaParams = Update.MediaParams;
+    pContext->UpdateBuffer(m_pcbMediaAttribs, 0, sizeof(m_MediaParams), &m_MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // Resources that were not part of the update will be recomputed with the new parameters when needed
+    m_uiUpToDateResourceFlags = Update.ResourceFlags;
+
+    if (Update.HasNextUpdate)
+    {
+        // The parameters have changed while the update was in progress.
+        // Start the next update with the latest parameters reusing the pending textures.
+        Update.MediaParams   = Update.NextMediaParams;
+        Update.ResourceFlags = m_uiUpToDateResourceFlags | UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+        Update.Step          = 0;
+        Update.HasNextUpdate = false;
+    }
+    else
+    {
+        m_PendingLUTUpdate = {};
+
+        // Release the pending textures that are still referenced by the precomputation techniques
+        for (int Tech = RENDER_TECH_PRECOMPUTE_SINGLE_SCATTERING; Tech <= RENDER_TECH_PRECOMPUTE_AMBIENT_SKY_LIGHT; ++Tech)
+            m_RenderTech[Tech].SRB.Release();
+    }
+}
 
 void EpipolarLightScattering::CreateRandomSphereSamplingTexture(IRenderDevice* pDevice)
 {
@@ -444,6 +1013,8 @@ void EpipolarLightScattering::CreateRandomSphereSamplingTexture(IRenderDevice* p
     RandomSphereSamplingTexDesc.Usage     = USAGE_IMMUTABLE;
     RandomSphereSamplingTexDesc.BindFlags = BIND_SHADER_RESOURCE;
 
+    RandomSphereSamplingTexDesc.ImmediateContextMask = m_LUTImmediateContextMask;
+
     std::vector<float4> SphereSampling(m_uiNumRandomSamplesOnSphere);
     for (Uint32 iSample = 0; iSample < m_uiNumRandomSamplesOnSphere; ++iSample)
     {
@@ -627,223 +1198,6 @@ void EpipolarLightScattering::CreateSliceEndPointsTexture(IRenderDevice* pDevice
     m_pResMapping->AddResource("g_tex2DSliceEndPoints", tex2DSliceEndpointsSRV, false);
 }
 
-void EpipolarLightScattering::PrecomputeScatteringLUT(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext)
-{
-    const auto AdapterType              = pDevice->GetAdapterInfo().Type;
-    const int  ThreadGroupSize          = AdapterType == ADAPTER_TYPE_INTEGRATED || AdapterType == ADAPTER_TYPE_SOFTWARE ? 8 : 16;
-    auto&      PrecomputeSingleSctrTech = m_RenderTech[RENDER_TECH_PRECOMPUTE_SINGLE_SCATTERING];
-    if (!PrecomputeSingleSctrTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        auto pPrecomputeSingleSctrCS =
-            CreateShader(pDevice, pStateCache, "PrecomputeSingleScattering.fx", "PrecomputeSingleScatteringCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        PrecomputeSingleSctrTech.InitializeComputeTechnique(pDevice, pStateCache, "PrecomputeSingleScattering", pPrecomputeSingleSctrCS, ResourceLayout);
-        PrecomputeSingleSctrTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    auto& ComputeSctrRadianceTech = m_RenderTech[RENDER_TECH_COMPUTE_SCATTERING_RADIANCE];
-    if (!ComputeSctrRadianceTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        Macros.AddShaderMacro("NUM_RANDOM_SPHERE_SAMPLES", static_cast<Int32>(m_uiNumRandomSamplesOnSphere));
-        auto pComputeSctrRadianceCS =
-            CreateShader(pDevice, pStateCache, "ComputeSctrRadiance.fx", "ComputeSctrRadianceCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        ComputeSctrRadianceTech.InitializeComputeTechnique(pDevice, pStateCache, "ComputeSctrRadiance", pComputeSctrRadianceCS, ResourceLayout);
-        ComputeSctrRadianceTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    auto& ComputeScatteringOrderTech = m_RenderTech[RENDER_TECH_COMPUTE_SCATTERING_ORDER];
-    if (!ComputeScatteringOrderTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        auto pComputeScatteringOrderCS =
-            CreateShader(pDevice, pStateCache, "ComputeScatteringOrder.fx", "ComputeScatteringOrderCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        ComputeScatteringOrderTech.InitializeComputeTechnique(pDevice, pStateCache, "ComputeScatteringOrder", pComputeScatteringOrderCS, ResourceLayout);
-        ComputeScatteringOrderTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    auto& InitHighOrderScatteringTech = m_RenderTech[RENDER_TECH_INIT_HIGH_ORDER_SCATTERING];
-    if (!InitHighOrderScatteringTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        auto pInitHighOrderScatteringCS =
-            CreateShader(pDevice, pStateCache, "InitHighOrderScattering.fx", "InitHighOrderScatteringCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        InitHighOrderScatteringTech.InitializeComputeTechnique(pDevice, pStateCache, "InitHighOrderScattering", pInitHighOrderScatteringCS, ResourceLayout);
-        InitHighOrderScatteringTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    auto& UpdateHighOrderScatteringTech = m_RenderTech[RENDER_TECH_UPDATE_HIGH_ORDER_SCATTERING];
-    if (!UpdateHighOrderScatteringTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        auto pUpdateHighOrderScatteringCS =
-            CreateShader(pDevice, pStateCache, "UpdateHighOrderScattering.fx", "UpdateHighOrderScatteringCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        UpdateHighOrderScatteringTech.InitializeComputeTechnique(pDevice, pStateCache, "UpdateHighOrderScattering", pUpdateHighOrderScatteringCS, ResourceLayout);
-        UpdateHighOrderScatteringTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    auto& CombineScatteringOrdersTech = m_RenderTech[RENDER_TECH_COMBINE_SCATTERING_ORDERS];
-    if (!CombineScatteringOrdersTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        DefineMacros(Macros);
-        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
-        auto pCombineScatteringOrdersCS =
-            CreateShader(pDevice, pStateCache, "CombineScatteringOrders.fx", "CombineScatteringOrdersCS",
-                         SHADER_TYPE_COMPUTE, m_ShaderFlags, Macros);
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
-        CombineScatteringOrdersTech.InitializeComputeTechnique(pDevice, pStateCache, "CombineScatteringOrders", pCombineScatteringOrdersCS, ResourceLayout);
-        CombineScatteringOrdersTech.PrepareSRB(pDevice, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    }
-
-    if (!m_ptex2DSphereRandomSamplingSRV)
-        CreateRandomSphereSamplingTexture(pDevice);
-
-    TextureDesc PrecomputedSctrTexDesc;
-    PrecomputedSctrTexDesc.Type      = RESOURCE_DIM_TEX_3D;
-    PrecomputedSctrTexDesc.Width     = m_iPrecomputedSctrUDim;
-    PrecomputedSctrTexDesc.Height    = m_iPrecomputedSctrVDim;
-    PrecomputedSctrTexDesc.Depth     = m_iPrecomputedSctrWDim * m_iPrecomputedSctrQDim;
-    PrecomputedSctrTexDesc.MipLevels = 1;
-    PrecomputedSctrTexDesc.Format    = TEX_FORMAT_RGBA16_FLOAT;
-    PrecomputedSctrTexDesc.Usage     = USAGE_DEFAULT;
-    PrecomputedSctrTexDesc.BindFlags = BIND_UNORDERED_ACCESS | BIND_SHADER_RESOURCE;
-
-    if (!m_ptex3DSingleScatteringSRV)
-    {
-        RefCntAutoPtr<ITexture> ptex3DSingleSctr, ptex3DMultipleSctr;
-        pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &ptex3DSingleSctr);
-        m_ptex3DSingleScatteringSRV = ptex3DSingleSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-        m_ptex3DSingleScatteringSRV->SetSampler(m_pLinearClampSampler);
-        m_pResMapping->AddResource("g_rwtex3DSingleScattering", ptex3DSingleSctr->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS), true);
-
-        // We have to bother with two texture, because HLSL only allows read-write operations on single
-        // component textures
-        pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &m_ptex3DHighOrderSctr);
-        pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &m_ptex3DHighOrderSctr2);
-        m_ptex3DHighOrderSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)->SetSampler(m_pLinearClampSampler);
-        m_ptex3DHighOrderSctr2->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE)->SetSampler(m_pLinearClampSampler);
-
-
-        pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &ptex3DMultipleSctr);
-        m_ptex3DMultipleScatteringSRV = ptex3DMultipleSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-        m_ptex3DMultipleScatteringSRV->SetSampler(m_pLinearClampSampler);
-        m_pResMapping->AddResource("g_rwtex3DMultipleSctr", ptex3DMultipleSctr->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS), true);
-
-        m_pResMapping->AddResource("g_tex3DSingleSctrLUT", m_ptex3DSingleScatteringSRV, true);
-
-        m_pResMapping->AddResource("g_tex3DMultipleSctrLUT", m_ptex3DMultipleScatteringSRV, true);
-    }
-
-    // Precompute single scattering
-    PrecomputeSingleSctrTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
-    DispatchComputeAttribs DispatchAttrs{
-        PrecomputedSctrTexDesc.Width / ThreadGroupSize,
-        PrecomputedSctrTexDesc.Height / ThreadGroupSize,
-        PrecomputedSctrTexDesc.Depth};
-    PrecomputeSingleSctrTech.DispatchCompute(pContext, DispatchAttrs);
-
-    // Precompute multiple scattering
-    // We need higher precision to store intermediate data
-    PrecomputedSctrTexDesc.Format = TEX_FORMAT_RGBA32_FLOAT;
-    RefCntAutoPtr<ITexture>     ptex3DSctrRadiance, ptex3DInsctrOrder;
-    RefCntAutoPtr<ITextureView> ptex3DSctrRadianceSRV, ptex3DInsctrOrderSRV;
-    pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &ptex3DSctrRadiance);
-    pDevice->CreateTexture(PrecomputedSctrTexDesc, nullptr, &ptex3DInsctrOrder);
-    ptex3DSctrRadianceSRV = ptex3DSctrRadiance->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-    ptex3DInsctrOrderSRV  = ptex3DInsctrOrder->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-    ptex3DSctrRadianceSRV->SetSampler(m_pLinearClampSampler);
-    ptex3DInsctrOrderSRV->SetSampler(m_pLinearClampSampler);
-    m_pResMapping->AddResource("g_rwtex3DSctrRadiance", ptex3DSctrRadiance->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS), true);
-    m_pResMapping->AddResource("g_rwtex3DInsctrOrder", ptex3DInsctrOrder->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS), true);
-
-
-    ComputeSctrRadianceTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    ComputeScatteringOrderTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    InitHighOrderScatteringTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-    UpdateHighOrderScatteringTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
-
-    const int iNumScatteringOrders = pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_GLES ? 3 : 4;
-    for (int iSctrOrder = 1; iSctrOrder < iNumScatteringOrders; ++iSctrOrder)
-    {
-        // Step 1: compute differential in-scattering
-        ComputeSctrRadianceTech.SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex3DPreviousSctrOrder")->Set((iSctrOrder == 1) ? m_ptex3DSingleScatteringSRV : ptex3DInsctrOrderSRV);
-        ComputeSctrRadianceTech.DispatchCompute(pContext, DispatchAttrs);
-
-        // It seemse like on Intel GPU, the driver accumulates work into big batch.
-        // The resulting batch turns out to be too big for GPU to process it in allowed time
-        // limit, and the system kills the driver. So we have to flush the command buffer to
-        // force execution of compute shaders.
-        pContext->Flush();
-
-        // Step 2: integrate differential in-scattering
-        ComputeScatteringOrderTech.SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex3DPointwiseSctrRadiance")->Set(ptex3DSctrRadianceSRV);
-        ComputeScatteringOrderTech.DispatchCompute(pContext, DispatchAttrs);
-
-        RenderTechnique* pRenderTech = nullptr;
-        // Step 3: accumulate high-order scattering scattering
-        if (iSctrOrder == 1)
-        {
-            pRenderTech = &m_RenderTech[RENDER_TECH_INIT_HIGH_ORDER_SCATTERING];
-        }
-        else
-        {
-            pRenderTech = &m_RenderTech[RENDER_TECH_UPDATE_HIGH_ORDER_SCATTERING];
-            std::swap(m_ptex3DHighOrderSctr, m_ptex3DHighOrderSctr2);
-            pRenderTech->SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex3DHighOrderOrderScattering")->Set(m_ptex3DHighOrderSctr2->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
-        }
-        pRenderTech->SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_rwtex3DHighOrderSctr")->Set(m_ptex3DHighOrderSctr->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
-        pRenderTech->SRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex3DCurrentOrderScattering")->Set(ptex3DInsctrOrderSRV);
-        pRenderTech->DispatchCompute(pContext, DispatchAttrs);
-
-        // Flush the command buffer to force execution of compute shaders and avoid device
-        // reset on low-end Intel GPUs.
-        pContext->Flush();
-    }
-
-    // Note that m_ptex3DHighOrderSctr and m_ptex3DHighOrderSctr2 are ping-ponged during pre-processing
-    m_ptex3DHighOrderScatteringSRV = m_ptex3DHighOrderSctr->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-    m_ptex3DHighOrderScatteringSRV->SetSampler(m_pLinearClampSampler);
-    m_pResMapping->AddResource("g_tex3DHighOrderSctrLUT", m_ptex3DHighOrderScatteringSRV, false);
-
-
-    // Combine single scattering and higher order scattering into single texture
-    CombineScatteringOrdersTech.SRB->BindResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
-    CombineScatteringOrdersTech.DispatchCompute(pContext, DispatchAttrs);
-
-    // Remove temporary textures from the resource mapping
-    m_pResMapping->RemoveResourceByName("g_rwtex3DSctrRadiance");
-    m_pResMapping->RemoveResourceByName("g_rwtex3DInsctrOrder");
-
-    m_uiUpToDateResourceFlags |= UpToDateResourceFlags::PrecomputedIntegralsTex;
-}
-
 void EpipolarLightScattering::CreateLowResLuminanceTexture(IRenderDevice* pDevice, IDeviceContext* pDeviceCtx)
 {
     // Create low-resolution texture to store image luminance
@@ -933,6 +1287,35 @@ void EpipolarLightScattering::CreateCamSpaceZTexture(IRenderDevice* pDevice)
     m_pResMapping->AddResource("g_tex2DCamSpaceZ", tex2DCamSpaceZSRV, false);
 }
 
+void EpipolarLightScattering::CreateHalfResInscatteringTextures(IRenderDevice* pDevice)
+{
+    TextureDesc TexDesc;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = (m_uiBackBufferWidth + 1) / 2;
+    TexDesc.Height    = (m_uiBackBufferHeight + 1) / 2;
+    TexDesc.MipLevels = 1;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+
+    {
+        TexDesc.Name   = "Half-res inscattering";
+        TexDesc.Format = EpipolarInsctrTexFmt;
+        RefCntAutoPtr<ITexture> ptex2DHalfResInscattering;
+        pDevice->CreateTexture(TexDesc, nullptr, &ptex2DHalfResInscattering);
+        m_ptex2DHalfResInscatteringRTV = ptex2DHalfResInscattering->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        m_pResMapping->AddResource("g_tex2DHalfResInscattering", ptex2DHalfResInscattering->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), false);
+    }
+
+    {
+        TexDesc.Name   = "Half-res extinction";
+        TexDesc.Format = EpipolarExtinctionFmt;
+        RefCntAutoPtr<ITexture> ptex2DHalfResExtinction;
+        pDevice->CreateTexture(TexDesc, nullptr, &ptex2DHalfResExtinction);
+        m_ptex2DHalfResExtinctionRTV = ptex2DHalfResExtinction->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        m_pResMapping->AddResource("g_tex2DHalfResExtinction", ptex2DHalfResExtinction->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), false);
+    }
+}
+
 void EpipolarLightScattering::ReconstructCameraSpaceZ()
 {
     // Depth buffer is non-linear and cannot be interpolated directly
@@ -1753,6 +2136,118 @@ void EpipolarLightScattering::UnwarpEpipolarScattering(bool bRenderLuminance)
         UnwarpAndRenderLuminanceTech.SRBDependencyFlags = SRBDependencies;
     }
 
+    // Half-resolution techniques are created regardless of bHalfResolutionUnwarp,
+    // so that the mode can be toggled without creating new PSOs
+    auto& UnwarpHalfResInsctrTech = m_RenderTech[RENDER_TECH_UNWARP_HALF_RES_INSCATTERING];
+    if (!UnwarpHalfResInsctrTech.PSO)
+    {
+        ShaderMacroHelper Macros;
+        DefineMacros(Macros);
+        Macros.AddShaderMacro("PERFORM_TONE_MAPPING", false);
+        // Pixels that require inscattering correction are marked in the alpha channel and
+        // are handled when the half-resolution image is applied
+        Macros.AddShaderMacro("CORRECT_INSCATTERING_AT_DEPTH_BREAKS", false);
+
+        auto pUnwarpHalfResInsctrPS = CreateShader(
+            m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache,
+            "UnwarpEpipolarScattering.fx", "UnwarpHalfResInscatteringPS",
+            SHADER_TYPE_PIXEL, m_ShaderFlags, Macros);
+
+        PipelineResourceLayoutDesc ResourceLayout;
+        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+        // clang-format off
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_PIXEL, "cbPostProcessingAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}
+        };
+
+        std::vector<ImmutableSamplerDesc> ImtblSamplers =
+        {
+            {SHADER_TYPE_PIXEL, "g_tex2DSliceEndPoints",    Sam_LinearClamp},
+            {SHADER_TYPE_PIXEL, "g_tex2DEpipolarCamSpaceZ", Sam_LinearClamp},
+            {SHADER_TYPE_PIXEL, "g_tex2DScatteredColor",    Sam_LinearClamp}
+        };
+        // clang-format on
+
+        if (m_PostProcessingAttribs.iExtinctionEvalMode == EXTINCTION_EVAL_MODE_EPIPOLAR)
+            ImtblSamplers.emplace_back(SHADER_TYPE_PIXEL, "g_tex2DEpipolarExtinction", Sam_LinearClamp);
+
+        ResourceLayout.Variables            = Vars;
+        ResourceLayout.NumVariables         = _countof(Vars);
+        ResourceLayout.ImmutableSamplers    = ImtblSamplers.data();
+        ResourceLayout.NumImmutableSamplers = static_cast<Uint32>(ImtblSamplers.size());
+
+        TEXTURE_FORMAT RTVFmts[] = {EpipolarInsctrTexFmt, EpipolarExtinctionFmt};
+        UnwarpHalfResInsctrTech.InitializeFullScreenTriangleTechnique(
+            m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, "UnwarpHalfResInscattering",
+            m_pFullScreenTriangleVS, pUnwarpHalfResInsctrPS,
+            ResourceLayout, _countof(RTVFmts), RTVFmts, TEX_FORMAT_UNKNOWN, DSS_DisableDepth, BS_Default);
+        UnwarpHalfResInsctrTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
+
+        UnwarpHalfResInsctrTech.PSODependencyFlags = PSO_DEPENDENCY_EXTINCTION_EVAL_MODE;
+        UnwarpHalfResInsctrTech.SRBDependencyFlags = SRBDependencies | SRB_DEPENDENCY_CAM_SPACE_Z_TEX;
+    }
+
+    auto& ApplyHalfResInsctrTech = m_RenderTech[RENDER_TECH_APPLY_HALF_RES_INSCATTERING];
+    if (!ApplyHalfResInsctrTech.PSO)
+    {
+        ShaderMacroHelper Macros;
+        DefineMacros(Macros);
+        // clang-format off
+        Macros.AddShaderMacro("PERFORM_TONE_MAPPING",                 true);
+        Macros.AddShaderMacro("AUTO_EXPOSURE",                        m_PostProcessingAttribs.ToneMapping.bAutoExposure);
+        Macros.AddShaderMacro("TONE_MAPPING_MODE",                    m_PostProcessingAttribs.ToneMapping.iToneMappingMode);
+        Macros.AddShaderMacro("CORRECT_INSCATTERING_AT_DEPTH_BREAKS", m_PostProcessingAttribs.bCorrectScatteringAtDepthBreaks);
+        // clang-format on
+
+        auto pApplyHalfResInsctrPS = CreateShader(
+            m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache,
+            "UnwarpEpipolarScattering.fx", "ApplyHalfResInscatteredRadiancePS",
+            SHADER_TYPE_PIXEL, m_ShaderFlags, Macros);
+
+        PipelineResourceLayoutDesc ResourceLayout;
+        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+        // clang-format off
+        ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_PIXEL, "cbPostProcessingAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}
+        };
+
+        ImmutableSamplerDesc ImtblSamplers[] =
+        {
+            {SHADER_TYPE_PIXEL, "g_tex2DCamSpaceZ",   Sam_LinearClamp},
+            {SHADER_TYPE_PIXEL, "g_tex2DColorBuffer", Sam_PointClamp}
+        };
+        // clang-format on
+
+        ResourceLayout.Variables            = Vars;
+        ResourceLayout.NumVariables         = _countof(Vars);
+        ResourceLayout.ImmutableSamplers    = ImtblSamplers;
+        ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
+
+        ApplyHalfResInsctrTech.InitializeFullScreenTriangleTechnique(
+            m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, "ApplyHalfResInscattering",
+            m_pFullScreenTriangleVS, pApplyHalfResInsctrPS,
+            ResourceLayout, m_BackBufferFmt, m_DepthBufferFmt, DSS_Default);
+        ApplyHalfResInsctrTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_UPDATE_ALL);
+
+        ApplyHalfResInsctrTech.PSODependencyFlags =
+            PSO_DEPENDENCY_AUTO_EXPOSURE |
+            PSO_DEPENDENCY_TONE_MAPPING_MODE |
+            PSO_DEPENDENCY_CORRECT_SCATTERING |
+            PSO_DEPENDENCY_EXTINCTION_EVAL_MODE;
+
+        ApplyHalfResInsctrTech.SRBDependencyFlags =
+            SRB_DEPENDENCY_CAMERA_ATTRIBS |
+            SRB_DEPENDENCY_LIGHT_ATTRIBS |
+            SRB_DEPENDENCY_SRC_COLOR_BUFFER |
+            SRB_DEPENDENCY_AVERAGE_LUMINANCE_TEX |
+            SRB_DEPENDENCY_CAM_SPACE_Z_TEX |
+            SRB_DEPENDENCY_HALF_RES_INSCTR_TEX;
+    }
+
     // Unwarp inscattering image and apply it to attenuated background
     if (bRenderLuminance)
     {
@@ -1761,6 +2256,22 @@ void EpipolarLightScattering::UnwarpEpipolarScattering(bool bRenderLuminance)
         // Disable depth testing - we need to render the entire image in low resolution
         UnwarpAndRenderLuminanceTech.Render(m_FrameAttribs.pDeviceContext);
     }
+    else if (m_PostProcessingAttribs.bHalfResolutionUnwarp)
+    {
+        UnwarpHalfResInsctrTech.PrepareSRB(m_FrameAttribs.pDevice, m_pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
+        ApplyHalfResInsctrTech.PrepareSRB(m_FrameAttribs.pDevice, m_pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
+
+        ITextureView* ppHalfResRTVs[] = {m_ptex2DHalfResInscatteringRTV, m_ptex2DHalfResExtinctionRTV};
+        m_FrameAttribs.pDeviceContext->SetRenderTargets(_countof(ppHalfResRTVs), ppHalfResRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        UnwarpHalfResInsctrTech.Render(m_FrameAttribs.pDeviceContext);
+
+        // Restore the main back & depth buffers. The depth buffer keeps the values it was cleared with.
+        m_FrameAttribs.pDeviceContext->SetRenderTargets(1, &m_FrameAttribs.ptex2DDstColorBufferRTV, m_FrameAttribs.ptex2DDstDepthBufferDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // Same as below: pixels for which the bilateral upsampling finds no valid
+        // half-resolution texels are discarded and corrected afterwards (if enabled)
+        ApplyHalfResInsctrTech.Render(m_FrameAttribs.pDeviceContext);
+    }
     else
     {
         UnwarpEpipolarSctrImgTech.PrepareSRB(m_FrameAttribs.pDevice, m_pResMapping, BIND_SHADER_RESOURCES_KEEP_EXISTING);
@@ -2060,25 +2571,6 @@ void EpipolarLightScattering::CreateExtinctionTexture(IRenderDevice* pDevice)
     m_ptex2DEpipolarExtinctionRTV = tex2DEpipolarExtinction->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
 }
 
-void EpipolarLightScattering::CreateAmbientSkyLightTexture(IRenderDevice* pDevice)
-{
-    TextureDesc TexDesc;
-    TexDesc.Name      = "Ambient Sky Light";
-    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
-    TexDesc.Width     = sm_iAmbientSkyLightTexDim;
-    TexDesc.Height    = 1;
-    TexDesc.Format    = AmbientSkyLightTexFmt;
-    TexDesc.MipLevels = 1;
-    TexDesc.Usage     = USAGE_DEFAULT;
-    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
-    RefCntAutoPtr<ITexture> tex2DAmbientSkyLight;
-    pDevice->CreateTexture(TexDesc, nullptr, &tex2DAmbientSkyLight);
-
-    m_ptex2DAmbientSkyLightSRV = tex2DAmbientSkyLight->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
-    m_ptex2DAmbientSkyLightRTV = tex2DAmbientSkyLight->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
-    m_ptex2DAmbientSkyLightSRV->SetSampler(m_pLinearClampSampler);
-}
-
 void EpipolarLightScattering::PrepareForNewFrame(FrameAttribs&                   frameAttribs,
                                                  EpipolarLightScatteringAttribs& PPAttribs)
 {
@@ -2229,6 +2721,7 @@ void EpipolarLightScattering::PrepareForNewFrame(FrameAttribs&
     CHECK_SRB_DEPENDENCY(SRB_DEPENDENCY_AVERAGE_LUMINANCE_TEX,    m_ptex2DAverageLuminanceRTV);
     CHECK_SRB_DEPENDENCY(SRB_DEPENDENCY_SLICE_UV_DIR_TEX,         m_ptex2DSliceUVDirAndOriginRTV);
     CHECK_SRB_DEPENDENCY(SRB_DEPENDENCY_CAM_SPACE_Z_TEX,          m_ptex2DCamSpaceZRTV);
+    CHECK_SRB_DEPENDENCY(SRB_DEPENDENCY_HALF_RES_INSCTR_TEX,      m_ptex2DHalfResInscatteringRTV);
     CHECK_SRB_DEPENDENCY(SRB_DEPENDENCY_MIN_MAX_SHADOW_MAP,       m_ptex2DMinMaxShadowMapRTV[0]);
 #undef CHECK_SRB_DEPENDENCY
     // clang-format on
@@ -2331,10 +2824,37 @@ void EpipolarLightScattering::PrepareForNewFrame(FrameAttribs&
 
     if (bRecomputeSctrCoeffs)
     {
-        m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::PrecomputedOpticalDepthTex;
-        m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::AmbientSkyLightTex;
-        m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::PrecomputedIntegralsTex;
-        ComputeScatteringCoefficients(m_FrameAttribs.pDeviceContext);
+        AirScatteringAttribs MediaParams = m_MediaParams;
+        ComputeScatteringCoefficients(MediaParams);
+
+        if (m_LUTUpdateStepsPerFrame > 0 && (m_uiUpToDateResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex))
+        {
+            // Compute the new look-up tables over the next frames while the current ones are used for rendering.
+            if (m_PendingLUTUpdate.ResourceFlags != 0)
+            {
+                // Let the update in progress finish, so that continuously changing parameters still
+                // produce new tables. The latest parameters are used by the next update.
+                m_PendingLUTUpdate.NextMediaParams = MediaParams;
+                m_PendingLUTUpdate.HasNextUpdate   = true;
+            }
+            else
+            {
+                m_PendingLUTUpdate.MediaParams   = MediaParams;
+                m_PendingLUTUpdate.ResourceFlags = m_uiUpToDateResourceFlags | UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+                m_PendingLUTUpdate.Step          = 0;
+            }
+        }
+        else
+        {
+            m_PendingLUTUpdate = {};
+
+            m_MediaParams = MediaParams;
+            m_FrameAttribs.pDeviceContext->UpdateBuffer(m_pcbMediaAttribs, 0, sizeof(m_MediaParams), &m_MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::PrecomputedOpticalDepthTex;
+            m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::AmbientSkyLightTex;
+            m_uiUpToDateResourceFlags &= ~UpToDateResourceFlags::PrecomputedIntegralsTex;
+        }
     }
 
     if (!m_ptex2DCamSpaceZRTV)
@@ -2354,6 +2874,11 @@ void EpipolarLightScattering::PrepareForNewFrame(FrameAttribs&
             CreateSliceEndPointsTexture(m_FrameAttribs.pDevice);
         }
 
+        if (m_PostProcessingAttribs.bHalfResolutionUnwarp && !m_ptex2DHalfResInscatteringRTV)
+        {
+            CreateHalfResInscatteringTextures(m_FrameAttribs.pDevice);
+        }
+
         if (m_PostProcessingAttribs.bEnableLightShafts && m_PostProcessingAttribs.bUse1DMinMaxTree && !m_ptex2DMinMaxShadowMapSRV[0])
         {
             CreateMinMaxShadowMap(m_FrameAttribs.pDevice);
@@ -2377,16 +2902,26 @@ void EpipolarLightScattering::PerformPostProcessing()
     // (CreateLowResLuminanceTexture changes render targets). If they are moved to
     // PrepareForNewFrame, an application must be required to restore states afterwards
 
+    if (m_LUTCacheWriter)
+    {
+        m_LUTCacheWriter->Update(m_FrameAttribs.pDeviceContext);
+    }
+
+    if (m_PendingLUTUpdate.ResourceFlags != 0)
+    {
+        UpdatePendingLUTs(m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, m_FrameAttribs.pDeviceContext);
+    }
+
     if (!(m_uiUpToDateResourceFlags & UpToDateResourceFlags::PrecomputedOpticalDepthTex))
     {
-        PrecomputeOpticalDepthTexture(m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, m_FrameAttribs.pDeviceContext);
+        PrecomputeLUTs(UpToDateResourceFlags::PrecomputedOpticalDepthTex, m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, m_FrameAttribs.pDeviceContext);
     }
 
     if ((m_PostProcessingAttribs.iMultipleScatteringMode > MULTIPLE_SCTR_MODE_NONE ||
          m_PostProcessingAttribs.iSingleScatteringMode == SINGLE_SCTR_MODE_LUT) &&
         !(m_uiUpToDateResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex))
     {
-        PrecomputeScatteringLUT(m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, m_FrameAttribs.pDeviceContext);
+        PrecomputeLUTs(UpToDateResourceFlags::PrecomputedIntegralsTex, m_FrameAttribs.pDevice, m_FrameAttribs.pStateCache, m_FrameAttribs.pDeviceContext);
     }
 
     if (/*m_PostProcessingAttribs.ToneMapping.bAutoExposure &&*/ !m_ptex2DLowResLuminanceRTV)
@@ -2601,7 +3136,7 @@ void EpipolarLightScattering::ComputeSunColor(const float3& vDirectionOnSun,
     (float3&)f4SunColorAtGround    = ((float3&)f4ExtraterrestrialSunColor) * f3TotalExtinction * fEarthReflectance;
 }
 
-void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDeviceCtx)
+void EpipolarLightScattering::ComputeScatteringCoefficients(AirScatteringAttribs& MediaParams) const
 {
     // For details, see "A practical Analytic Model for Daylight" by Preetham & Hoffman, p.23
 
@@ -2617,9 +3152,9 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
 
     // Calculate angular and total scattering coefficients for Rayleigh scattering:
     {
-        float4& f4AngularRayleighSctrCoeff = m_MediaParams.f4AngularRayleighSctrCoeff;
-        float4& f4TotalRayleighSctrCoeff   = m_MediaParams.f4TotalRayleighSctrCoeff;
-        float4& f4RayleighExtinctionCoeff  = m_MediaParams.f4RayleighExtinctionCoeff;
+        float4& f4AngularRayleighSctrCoeff = MediaParams.f4AngularRayleighSctrCoeff;
+        float4& f4TotalRayleighSctrCoeff   = MediaParams.f4TotalRayleighSctrCoeff;
+        float4& f4RayleighExtinctionCoeff  = MediaParams.f4RayleighExtinctionCoeff;
 
         constexpr double n  = 1.0003;    // - Refractive index of air in the visible spectrum
         constexpr double N  = 2.545e+25; // - Number of molecules per unit volume
@@ -2664,7 +3199,7 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
 
         if (m_PostProcessingAttribs.bUseCustomSctrCoeffs)
         {
-            m_MediaParams.f4RayleighExtinctionCoeff += m_PostProcessingAttribs.f4CustomOzoneAbsorption;
+            MediaParams.f4RayleighExtinctionCoeff += m_PostProcessingAttribs.f4CustomOzoneAbsorption;
         }
         else
         {
@@ -2674,15 +3209,15 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
             //     Eurographics Symposium on Rendering 2020
 
             const float4 f4OzoneAbsorption = float4{0.650f, 1.881f, 0.085f, 0.f} * 1e-6f;
-            m_MediaParams.f4RayleighExtinctionCoeff += f4OzoneAbsorption;
+            MediaParams.f4RayleighExtinctionCoeff += f4OzoneAbsorption;
         }
     }
 
     // Calculate angular and total scattering coefficients for Mie scattering:
     {
-        float4& f4AngularMieSctrCoeff = m_MediaParams.f4AngularMieSctrCoeff;
-        float4& f4TotalMieSctrCoeff   = m_MediaParams.f4TotalMieSctrCoeff;
-        float4& f4MieExtinctionCoeff  = m_MediaParams.f4MieExtinctionCoeff;
+        float4& f4AngularMieSctrCoeff = MediaParams.f4AngularMieSctrCoeff;
+        float4& f4TotalMieSctrCoeff   = MediaParams.f4TotalMieSctrCoeff;
+        float4& f4MieExtinctionCoeff  = MediaParams.f4MieExtinctionCoeff;
 
         if (m_PostProcessingAttribs.bUseCustomSctrCoeffs)
         {
@@ -2702,12 +3237,12 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
                         (0.668532 + 0.669765) / 2.0 // (K[470nm]+K[480nm])/2
                     };
 
-                VERIFY_EXPR(m_MediaParams.fTurbidity >= 1.f);
+                VERIFY_EXPR(MediaParams.fTurbidity >= 1.f);
 
                 // Beta is an Angstrom's turbidity coefficient and is approximated by:
                 //float beta = 0.04608365822050f * m_fTurbidity - 0.04586025928522f; ???????
 
-                const double     c = (0.6544 * m_MediaParams.fTurbidity - 0.6510) * 1E-16; // concentration factor
+                const double     c = (0.6544 * MediaParams.fTurbidity - 0.6510) * 1E-16; // concentration factor
                 constexpr double v = 4;                                                    // Junge's exponent
 
                 const double dTotalMieBetaTerm = 0.434 * c * PI * pow(2.0 * PI, v - 2);
@@ -2727,8 +3262,8 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
                 // [BN08] uses the following value (independent of wavelength) for Mie scattering coefficient: 2e-5
                 // For g=0.76 and MieBetha=2e-5 [BN08] was able to reproduce the same luminance as given by the
                 // reference CIE sky light model
-                const float fMieBethaBN08         = 2e-5f * m_PostProcessingAttribs.fAerosolDensityScale;
-                m_MediaParams.f4TotalMieSctrCoeff = float4(fMieBethaBN08, fMieBethaBN08, fMieBethaBN08, 0);
+                const float fMieBethaBN08       = 2e-5f * m_PostProcessingAttribs.fAerosolDensityScale;
+                MediaParams.f4TotalMieSctrCoeff = float4(fMieBethaBN08, fMieBethaBN08, fMieBethaBN08, 0);
             }
         }
 
@@ -2750,20 +3285,15 @@ void EpipolarLightScattering::ComputeScatteringCoefficients(IDeviceContext* pDev
         // Cornette phase function (see Nishita et al. 93):
         // F(theta) = 1/(4*PI) * 3*(1-g^2) / (2*(2+g^2)) * (1+cos^2(theta)) / (1 + g^2 - 2g*cos(theta))^(3/2)
         // 1/(4*PI) is baked into the f4AngularMieSctrCoeff
-        float4& f4CS_g = m_MediaParams.f4CS_g;
-        float   f_g    = m_MediaParams.fAerosolPhaseFuncG;
+        float4& f4CS_g = MediaParams.f4CS_g;
+        float   f_g    = MediaParams.fAerosolPhaseFuncG;
         f4CS_g.x       = 3 * (1.f - f_g * f_g) / (2 * (2.f + f_g * f_g));
         f4CS_g.y       = 1.f + f_g * f_g;
         f4CS_g.z       = -2.f * f_g;
         f4CS_g.w       = 1.f;
     }
 
-    m_MediaParams.f4TotalExtinctionCoeff = m_MediaParams.f4RayleighExtinctionCoeff + m_MediaParams.f4MieExtinctionCoeff;
-
-    if (pDeviceCtx && m_pcbMediaAttribs)
-    {
-        pDeviceCtx->UpdateBuffer(m_pcbMediaAttribs, 0, sizeof(m_MediaParams), &m_MediaParams, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    }
+    MediaParams.f4TotalExtinctionCoeff = MediaParams.f4RayleighExtinctionCoeff + MediaParams.f4MieExtinctionCoeff;
 }
 
 
@@ -2838,53 +3368,14 @@ void EpipolarLightScattering::RenderSun(TEXTURE_FORMAT RTVFormat,
     m_FrameAttribs.pDeviceContext->Draw(DrawAttrs);
 }
 
-void EpipolarLightScattering::ComputeAmbientSkyLightTexture(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext)
-{
-    if (!(m_uiUpToDateResourceFlags & UpToDateResourceFlags::PrecomputedOpticalDepthTex))
-    {
-        PrecomputeOpticalDepthTexture(pDevice, pStateCache, pContext);
-    }
-
-    if (!(m_uiUpToDateResourceFlags & UpToDateResourceFlags::PrecomputedIntegralsTex))
-    {
-        PrecomputeScatteringLUT(pDevice, pStateCache, pContext);
-    }
-
-    auto& PrecomputeAmbientSkyLightTech = m_RenderTech[RENDER_TECH_PRECOMPUTE_AMBIENT_SKY_LIGHT];
-    if (!PrecomputeAmbientSkyLightTech.PSO)
-    {
-        ShaderMacroHelper Macros;
-        Macros.AddShaderMacro("NUM_RANDOM_SPHERE_SAMPLES", static_cast<Int32>(m_uiNumRandomSamplesOnSphere));
-
-        auto pPrecomputeAmbientSkyLightPS = CreateShader(pDevice, pStateCache, "PrecomputeAmbientSkyLight.fx", "PrecomputeAmbientSkyLightPS",
-                                                         SHADER_TYPE_PIXEL, m_ShaderFlags, Macros);
-
-        PipelineResourceLayoutDesc ResourceLayout;
-        ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
-        PrecomputeAmbientSkyLightTech.InitializeFullScreenTriangleTechnique(pDevice, pStateCache, "PrecomputeAmbientSkyLight",
-                                                                            m_pFullScreenTriangleVS, pPrecomputeAmbientSkyLightPS,
-                                                                            ResourceLayout, AmbientSkyLightTexFmt);
-        PrecomputeAmbientSkyLightTech.PSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
-    }
-
-    // Create 2-D texture, shader resource and target view buffers on the device
-    ITextureView* pRTVs[] = {m_ptex2DAmbientSkyLightRTV};
-    pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-
-    PrecomputeAmbientSkyLightTech.PrepareSRB(pDevice, m_pResMapping);
-    PrecomputeAmbientSkyLightTech.Render(pContext);
-    m_uiUpToDateResourceFlags |= UpToDateResourceFlags::AmbientSkyLightTex;
-}
-
-
 ITextureView* EpipolarLightScattering::GetAmbientSkyLightSRV(IRenderDevice* pDevice, IRenderStateCache* pStateCache, IDeviceContext* pContext)
 {
     if (!(m_uiUpToDateResourceFlags & UpToDateResourceFlags::AmbientSkyLightTex))
     {
-        ComputeAmbientSkyLightTexture(pDevice, pStateCache, pContext);
+        PrecomputeLUTs(UpToDateResourceFlags::AmbientSkyLightTex, pDevice, pStateCache, pContext);
     }
 
-    return m_ptex2DAmbientSkyLightSRV;
+    return m_LUTs.AmbientSkyLight->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
 }
 
 } // namespace Diligent
@@ -52,8 +52,12 @@ public:
     enum FEATURE_FLAGS : Uint32
     {
         FEATURE_FLAG_NONE                 = 0u,
-        FEATURE_FLAG_REVERSED_DEPTH       = 1u << 0u, // Not implemented
-        FEATURE_FLAG_PACKED_NORMAL        = 1u << 1u, // Nor implemented
+        FEATURE_FLAG_REVERSED_DEPTH       = 1u << 0u,
+
+        // When this flag is used, the normal buffer contains octahedron-encoded normals in the first
+        // two components (e.g. RG16_UNORM), see EncodeNormalOctahedron() in ShaderUtilities.fxh.
+        FEATURE_FLAG_PACKED_NORMAL        = 1u << 1u,
+
         FEATURE_FLAG_HALF_PRECISION_DEPTH = 1u << 2u,
         FEATURE_FLAG_HALF_RESOLUTION      = 1u << 3u,
         FEATURE_FLAG_UNIFORM_WEIGHTING    = 1u << 4u
@@ -86,6 +90,19 @@ public:
     struct CreateInfo
     {
         bool EnableAsyncCreation = false;
+
+        /// Optional immediate context of an async compute queue.
+        ///
+        /// \remarks    When set, the ambient occlusion pass is computed by a compute shader
+        ///             on this context. The work that the application records on the main context
+        ///             between BeginExecute() and EndExecute() overlaps with this pass.
+        ///             The context must be an immediate context of a compute queue that is
+        ///             different from the main context, and the device must support compute
+        ///             shaders and native fences. The normal buffer, the camera attributes buffer
+        ///             and the blue noise textures of the PostFX context (see
+        ///             PostFXContext::CreateInfo::ImmediateContextMask) must be created for both
+        ///             contexts. Otherwise, the pass is rendered on the main context.
+        IDeviceContext* pAsyncComputeContext = nullptr;
     };
 
 public:
@@ -95,8 +112,21 @@ public:
 
     void PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDeviceContext, PostFXContext* pPostFXContext, FEATURE_FLAGS FeatureFlags);
 
+    /// Records all passes of the effect. This is equivalent to BeginExecute() followed by EndExecute().
     void Execute(const RenderAttributes& RenderAttribs);
 
+    /// Records the passes up to the ambient occlusion pass.
+    ///
+    /// \remarks    When the async compute context is used, the ambient occlusion pass is submitted
+    ///             to the async compute queue, and the main context is flushed. The application may record
+    ///             work that does not depend on the effect output before calling EndExecute().
+    void BeginExecute(const RenderAttributes& RenderAttribs);
+
+    /// Makes the main context wait for the async compute queue and records the remaining passes.
+    ///
+    /// \remarks    The render attributes must be the same as the ones passed to BeginExecute().
+    void EndExecute(const RenderAttributes& RenderAttribs);
+
     static bool UpdateUI(HLSL::ScreenSpaceAmbientOcclusionAttribs& SSRAttribs, FEATURE_FLAGS& FeatureFlags);
 
     ITextureView* GetAmbientOcclusionSRV() const;
@@ -108,6 +138,7 @@ private:
     enum RENDER_TECH : Uint32
     {
         RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_BUFFER = 0,
+        RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_FROM_HIERARCHY,
         RENDER_TECH_COMPUTE_PREFILTERED_DEPTH_BUFFER,
         RENDER_TECH_COMPUTE_AMBIENT_OCCLUSION,
         RENDER_TECH_COMPUTE_TEMPORAL_ACCUMULATION,
@@ -115,6 +146,7 @@ private:
         RENDER_TECH_COMPUTE_RESAMPLED_HISTORY,
         RENDER_TECH_COMPUTE_SPATIAL_RECONSTRUCTION,
         RENDER_TECH_COMPUTE_BILATERAL_UPSAMPLING,
+        RENDER_TECH_COMPUTE_AMBIENT_OCCLUSION_ASYNC,
         RENDER_TECH_COUNT
     };
 
@@ -142,6 +174,19 @@ private:
         RESOURCE_IDENTIFIER_COUNT
     };
 
+    // Passes of BeginExecute() and EndExecute() in the order of execution. They define the lifetimes of the transient textures.
+    enum PASS : Uint32
+    {
+        PASS_DOWNSAMPLED_DEPTH = 0,
+        PASS_PREFILTERED_DEPTH,
+        PASS_AMBIENT_OCCLUSION,
+        PASS_BILATERAL_UPSAMPLING,
+        PASS_TEMPORAL_ACCUMULATION,
+        PASS_CONVOLUTED_DEPTH_HISTORY,
+        PASS_RESAMPLED_HISTORY,
+        PASS_SPATIAL_RECONSTRUCTION
+    };
+
     bool PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags);
 
     void UpdateConstantBuffer(const RenderAttributes& RenderAttribs, bool ResetTimer);
@@ -152,6 +197,10 @@ private:
 
     void ComputeAmbientOcclusion(const RenderAttributes& RenderAttribs);
 
+    void ComputeAmbientOcclusionAsync(const RenderAttributes& RenderAttribs);
+
+    bool CanComputeAmbientOcclusionAsync(const RenderAttributes& RenderAttribs) const;
+
     void ComputeTemporalAccumulation(const RenderAttributes& RenderAttribs);
 
     void ComputeConvolutedDepthHistory(const RenderAttributes& RenderAttribs);
@@ -187,7 +236,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -207,6 +256,12 @@ private:
     std::vector<RefCntAutoPtr<ITextureView>> m_PrefilteredDepthMipMapRTV;
     std::vector<RefCntAutoPtr<ITextureView>> m_PrefilteredDepthMipMapSRV;
 
+    // Intermediate textures that are acquired from the PostFXContext transient texture pool.
+    // BeginExecute() and EndExecute() acquire and release their textures separately, so that
+    // the textures of BeginExecute() can be reused by the effects executed in between.
+    std::vector<PostFXContext::TransientTextureAttribs> m_BeginTransientTextures;
+    std::vector<PostFXContext::TransientTextureAttribs> m_EndTransientTextures;
+
     struct
     {
         TEXTURE_FORMAT PrefileteredDepth = TEX_FORMAT_R32_FLOAT;
@@ -225,6 +280,16 @@ private:
     FEATURE_FLAGS m_FeatureFlags = FEATURE_FLAG_NONE;
     CreateInfo    m_Settings;
 
+    RefCntAutoPtr<IDeviceContext> m_pAsyncComputeCtx;
+    RefCntAutoPtr<IFence>         m_pAsyncComputeFence;
+    Uint64                        m_LastAsyncComputeFenceValue = 0;
+    // The fence value that the main context must wait for in EndExecute(), or 0
+    Uint64 m_PendingAsyncComputeFenceValue = 0;
+    // Immediate contexts that the resources used by the async ambient occlusion pass are created for
+    Uint64 m_ImmediateContextMask = 1;
+    // Whether the passes recorded by BeginExecute() must be followed by the remaining passes in EndExecute()
+    bool m_ExecutePending = false;
+
     Timer m_FrameTimer;
 };
 
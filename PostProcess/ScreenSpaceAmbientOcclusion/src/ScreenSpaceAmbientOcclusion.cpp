@@ -51,9 +51,35 @@ ScreenSpaceAmbientOcclusion::ScreenSpaceAmbientOcclusion(IRenderDevice* pDevice,
 {
     DEV_CHECK_ERR(pDevice != nullptr, "pDevice must not be null");
 
-    RefCntAutoPtr<IBuffer> pBuffer;
-    CreateUniformBuffer(pDevice, sizeof(HLSL::ScreenSpaceAmbientOcclusionAttribs), "ScreenSpaceAmbientOcclusion::ConstantBuffer", &pBuffer, USAGE_DEFAULT, BIND_UNIFORM_BUFFER, CPU_ACCESS_NONE, m_SSAOAttribs.get());
-    m_Resources.Insert(RESOURCE_IDENTIFIER_CONSTANT_BUFFER, pBuffer);
+    if (CI.pAsyncComputeContext != nullptr)
+    {
+        const DeviceContextDesc& AsyncCtxDesc = CI.pAsyncComputeContext->GetDesc();
+        const DeviceFeatures&    Features     = pDevice->GetDeviceInfo().Features;
+        if (AsyncCtxDesc.IsDeferred || (AsyncCtxDesc.QueueType & COMMAND_QUEUE_TYPE_COMPUTE) != COMMAND_QUEUE_TYPE_COMPUTE)
+        {
+            LOG_WARNING_MESSAGE("Async compute context must be an immediate context of a compute queue. "
+                                "Ambient occlusion will be computed on the main context.");
+        }
+        else if (!Features.ComputeShaders || !Features.NativeFence)
+        {
+            LOG_WARNING_MESSAGE("Compute shaders or native fences are not supported by the device. Ambient occlusion will be computed on the main context.");
+        }
+        else if ((pDevice->GetTextureFormatInfoExt(m_BackBufferFormats.Occlusion).BindFlags & BIND_UNORDERED_ACCESS) == 0)
+        {
+            LOG_WARNING_MESSAGE("The occlusion texture format does not support unordered access. Ambient occlusion will be computed on the main context.");
+        }
+        else
+        {
+            FenceDesc Desc;
+            Desc.Name = "ScreenSpaceAmbientOcclusion::AsyncComputeFence";
+            Desc.Type = FENCE_TYPE_GENERAL;
+            pDevice->CreateFence(Desc, &m_pAsyncComputeFence);
+            if (m_pAsyncComputeFence)
+                m_pAsyncComputeCtx = CI.pAsyncComputeContext;
+        }
+    }
+    // The context is kept in m_pAsyncComputeCtx only if it can be used
+    m_Settings.pAsyncComputeContext = nullptr;
 }
 
 ScreenSpaceAmbientOcclusion::~ScreenSpaceAmbientOcclusion() = default;
@@ -68,6 +94,41 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
 
     m_CurrentFrameIdx = FrameDesc.Index;
 
+    if (!m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER])
+    {
+        // The main context is only known here, so the async compute context is validated
+        // and the constant buffer is created when the resources are prepared for the first time.
+        const Uint32 MainCtxId = pDeviceContext->GetDesc().ContextId;
+        m_ImmediateContextMask = Uint64{1} << MainCtxId;
+        if (m_pAsyncComputeCtx)
+        {
+            const Uint32 AsyncCtxId = m_pAsyncComputeCtx->GetDesc().ContextId;
+            if (MainCtxId != AsyncCtxId)
+            {
+                m_ImmediateContextMask |= Uint64{1} << AsyncCtxId;
+            }
+            else
+            {
+                LOG_WARNING_MESSAGE("Async compute context must be different from the main context. Ambient occlusion will be computed on the main context.");
+                m_pAsyncComputeCtx.Release();
+                m_pAsyncComputeFence.Release();
+            }
+        }
+
+        BufferDesc Desc;
+        Desc.Name                 = "ScreenSpaceAmbientOcclusion::ConstantBuffer";
+        Desc.Usage                = USAGE_DEFAULT;
+        Desc.BindFlags            = BIND_UNIFORM_BUFFER;
+        Desc.Size                 = sizeof(HLSL::ScreenSpaceAmbientOcclusionAttribs);
+        Desc.ImmediateContextMask = m_ImmediateContextMask;
+
+        BufferData InitData{m_SSAOAttribs.get(), Desc.Size};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+        m_Resources.Insert(RESOURCE_IDENTIFIER_CONSTANT_BUFFER, pBuffer);
+    }
+
     if (m_BackBufferWidth == FrameDesc.Width && m_BackBufferHeight == FrameDesc.Height && m_FeatureFlags == FeatureFlags)
         return;
 
@@ -98,6 +159,8 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         Desc.MipLevels = std::min(ComputeMipLevelsCount(m_BackBufferWidth, m_BackBufferHeight), DepthPrefilteredMipCount);
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
 
+        Desc.ImmediateContextMask = m_ImmediateContextMask;
+
         m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_PREFILTERED, Device.CreateTexture(Desc, nullptr));
         m_PrefilteredDepthMipMapSRV.resize(Desc.MipLevels);
         m_PrefilteredDepthMipMapRTV.resize(Desc.MipLevels);
@@ -239,7 +302,18 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_CONVOLUTED_INTERMEDIATE, Device.CreateTexture(Desc));
     }
 
-    m_Resources[RESOURCE_IDENTIFIER_DEPTH_CHECKERBOARD_HALF_RES].Release();
+    m_BeginTransientTextures.clear();
+    m_EndTransientTextures.clear();
+
+    auto AddTransientTexture = [](std::vector<PostFXContext::TransientTextureAttribs>& TransientTextures, Uint32 ResourceId, const TextureDesc& Desc, PASS FirstPass, PASS LastPass) {
+        PostFXContext::TransientTextureAttribs Attribs;
+        Attribs.ResourceId = ResourceId;
+        Attribs.Desc       = Desc;
+        Attribs.FirstPass  = FirstPass;
+        Attribs.LastPass   = LastPass;
+        TransientTextures.push_back(Attribs);
+    };
+
     if (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION)
     {
         TextureDesc Desc;
@@ -249,7 +323,7 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         Desc.Height    = m_BackBufferHeight / 2;
         Desc.Format    = m_BackBufferFormats.CheckerBoardDepth;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_CHECKERBOARD_HALF_RES, Device.CreateTexture(Desc));
+        AddTransientTexture(m_BeginTransientTextures, RESOURCE_IDENTIFIER_DEPTH_CHECKERBOARD_HALF_RES, Desc, PASS_DOWNSAMPLED_DEPTH, PASS_PREFILTERED_DEPTH);
     }
 
     {
@@ -260,10 +334,14 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         Desc.Height    = (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) ? m_BackBufferHeight / 2 : m_BackBufferHeight;
         Desc.Format    = m_BackBufferFormats.Occlusion;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+
+        // The occlusion is written by the compute shader on the async compute queue
+        if (m_pAsyncComputeCtx)
+            Desc.BindFlags |= BIND_UNORDERED_ACCESS;
+        Desc.ImmediateContextMask = m_ImmediateContextMask;
         m_Resources.Insert(RESOURCE_IDENTIFIER_OCCLUSION, Device.CreateTexture(Desc));
     }
 
-    m_Resources[RESOURCE_IDENTIFIER_OCCLUSION_UPSAMPLED].Release();
     if (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION)
     {
         TextureDesc Desc;
@@ -273,7 +351,7 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = m_BackBufferFormats.Occlusion;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_OCCLUSION_UPSAMPLED, Device.CreateTexture(Desc));
+        AddTransientTexture(m_EndTransientTextures, RESOURCE_IDENTIFIER_OCCLUSION_UPSAMPLED, Desc, PASS_BILATERAL_UPSAMPLING, PASS_TEMPORAL_ACCUMULATION);
     }
 
     for (Uint32 TextureIdx = RESOURCE_IDENTIFIER_OCCLUSION_HISTORY0; TextureIdx <= RESOURCE_IDENTIFIER_OCCLUSION_HISTORY1; TextureIdx++)
@@ -314,7 +392,7 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = m_BackBufferFormats.Occlusion;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_OCCLUSION_HISTORY_RESAMPLED, Device.CreateTexture(Desc));
+        AddTransientTexture(m_EndTransientTextures, RESOURCE_IDENTIFIER_OCCLUSION_HISTORY_RESAMPLED, Desc, PASS_RESAMPLED_HISTORY, PASS_SPATIAL_RECONSTRUCTION);
     }
 
     {
@@ -330,6 +408,12 @@ void ScreenSpaceAmbientOcclusion::PrepareResources(IRenderDevice* pDevice, IDevi
 }
 
 void ScreenSpaceAmbientOcclusion::Execute(const RenderAttributes& RenderAttribs)
+{
+    BeginExecute(RenderAttribs);
+    EndExecute(RenderAttribs);
+}
+
+void ScreenSpaceAmbientOcclusion::BeginExecute(const RenderAttributes& RenderAttribs)
 {
     DEV_CHECK_ERR(RenderAttribs.pDevice != nullptr, "RenderAttribs.pDevice must not be null");
     DEV_CHECK_ERR(RenderAttribs.pDeviceContext != nullptr, "RenderAttribs.pDeviceContext must not be null");
@@ -338,20 +422,59 @@ void ScreenSpaceAmbientOcclusion::Execute(const RenderAttributes& RenderAttribs)
     DEV_CHECK_ERR(RenderAttribs.pDepthBufferSRV != nullptr, "RenderAttribs.pDepthBufferSRV must not be null");
     DEV_CHECK_ERR(RenderAttribs.pNormalBufferSRV != nullptr, "RenderAttribs.pNormalBufferSRV must not be null");
     DEV_CHECK_ERR(RenderAttribs.pSSAOAttribs != nullptr, "RenderAttribs.pSSAOAttribs must not be null");
+    DEV_CHECK_ERR(!m_ExecutePending, "EndExecute() must be called before the next BeginExecute()");
 
     m_Resources.Insert(RESOURCE_IDENTIFIER_INPUT_DEPTH, RenderAttribs.pDepthBufferSRV->GetTexture());
     m_Resources.Insert(RESOURCE_IDENTIFIER_INPUT_NORMAL, RenderAttribs.pNormalBufferSRV->GetTexture());
 
     ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "ScreenSpaceAmbientOcclusion"};
 
-    bool AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
+    const bool TransientTexturesReady = RenderAttribs.pPostFXContext->AcquireTransientTextures(RenderAttribs.pDevice, m_BeginTransientTextures.data(), static_cast<Uint32>(m_BeginTransientTextures.size()), m_Resources);
+
+    bool AllPSOsReady = TransientTexturesReady && PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
     UpdateConstantBuffer(RenderAttribs, !AllPSOsReady);
 
     if (AllPSOsReady)
     {
         ComputeDepthCheckerboard(RenderAttribs);
         ComputePrefilteredDepth(RenderAttribs);
-        ComputeAmbientOcclusion(RenderAttribs);
+        if (CanComputeAmbientOcclusionAsync(RenderAttribs))
+            ComputeAmbientOcclusionAsync(RenderAttribs);
+        else
+            ComputeAmbientOcclusion(RenderAttribs);
+        m_ExecutePending = true;
+    }
+    else
+    {
+        ComputePlaceholderTexture(RenderAttribs);
+
+        // Release references to input resources
+        for (Uint32 ResourceIdx = 0; ResourceIdx <= RESOURCE_IDENTIFIER_INPUT_LAST; ++ResourceIdx)
+            m_Resources[ResourceIdx].Release();
+    }
+
+    RenderAttribs.pPostFXContext->ReleaseTransientTextures(m_BeginTransientTextures.data(), static_cast<Uint32>(m_BeginTransientTextures.size()), m_Resources);
+}
+
+void ScreenSpaceAmbientOcclusion::EndExecute(const RenderAttributes& RenderAttribs)
+{
+    // Nothing to do if BeginExecute() has written the placeholder texture
+    if (!m_ExecutePending)
+        return;
+    m_ExecutePending = false;
+
+    ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "ScreenSpaceAmbientOcclusion"};
+
+    if (m_PendingAsyncComputeFenceValue != 0)
+    {
+        // The wait is performed by the GPU: the main queue does not start
+        // the passes that read the occlusion until the async queue has finished.
+        RenderAttribs.pDeviceContext->DeviceWaitForFence(m_pAsyncComputeFence, m_PendingAsyncComputeFenceValue);
+        m_PendingAsyncComputeFenceValue = 0;
+    }
+
+    if (RenderAttribs.pPostFXContext->AcquireTransientTextures(RenderAttribs.pDevice, m_EndTransientTextures.data(), static_cast<Uint32>(m_EndTransientTextures.size()), m_Resources))
+    {
         ComputeBilateralUpsampling(RenderAttribs);
         ComputeTemporalAccumulation(RenderAttribs);
         ComputeConvolutedDepthHistory(RenderAttribs);
@@ -363,6 +486,8 @@ void ScreenSpaceAmbientOcclusion::Execute(const RenderAttributes& RenderAttribs)
         ComputePlaceholderTexture(RenderAttribs);
     }
 
+    RenderAttribs.pPostFXContext->ReleaseTransientTextures(m_EndTransientTextures.data(), static_cast<Uint32>(m_EndTransientTextures.size()), m_Resources);
+
     // Release references to input resources
     for (Uint32 ResourceIdx = 0; ResourceIdx <= RESOURCE_IDENTIFIER_INPUT_LAST; ++ResourceIdx)
         m_Resources[ResourceIdx].Release();
@@ -444,18 +569,33 @@ bool ScreenSpaceAmbientOcclusion::PrepareShadersAndPSO(const RenderAttributes& R
     const PSO_CREATE_FLAGS     PSOFlags    = m_Settings.EnableAsyncCreation ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
 
     {
-        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_BUFFER, FeatureFlags);
+        // When the post-processing context computes the depth hierarchy, the checkerboard depth is read from its
+        // first downsampled mip level instead of the full-resolution depth buffer.
+        const bool UseDepthHierarchy = RenderAttribs.pPostFXContext->GetDepthHierarchy() != nullptr;
+
+        auto& RenderTech = GetRenderTechnique(UseDepthHierarchy ? RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_FROM_HIERARCHY : RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_BUFFER, FeatureFlags);
 
         if (!RenderTech.IsInitializedPSO())
         {
             ShaderMacroHelper Macros;
             Macros.Add("SSAO_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+            Macros.Add("SSAO_OPTION_DEPTH_HIERARCHY", UseDepthHierarchy);
 
             const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
             const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "SSAO_ComputeDownsampledDepth.fx", "ComputeDownsampledDepthPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
 
             PipelineResourceLayoutDescX ResourceLayout;
-            ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
+            if (UseDepthHierarchy)
+            {
+                ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+                // Immutable sampler is required for WebGL to work properly
+                if (!SupportedFeatures.TextureSubresourceViews)
+                    ResourceLayout.AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy", Sam_PointClamp);
+            }
+            else
+            {
+                ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU);
+            }
 
             RenderTech.InitializePSO(RenderAttribs.pDevice,
                                      nullptr, "ScreenSpaceAmbientOcclusion::ComputeDownsampledDepth",
@@ -515,6 +655,7 @@ bool ScreenSpaceAmbientOcclusion::PrepareShadersAndPSO(const RenderAttributes& R
         if (!RenderTech.IsInitializedPSO())
         {
             ShaderMacroHelper Macros;
+            Macros.Add("SSAO_OPTION_PACKED_NORMAL", (FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSAO_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
             Macros.Add("SSAO_OPTION_UNIFORM_WEIGHTING", (FeatureFlags & FEATURE_FLAG_UNIFORM_WEIGHTING) != 0);
             Macros.Add("SSAO_OPTION_HALF_RESOLUTION", (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0);
@@ -544,6 +685,41 @@ bool ScreenSpaceAmbientOcclusion::PrepareShadersAndPSO(const RenderAttributes& R
             AllPSOsReady = false;
     }
 
+    if (m_pAsyncComputeCtx)
+    {
+        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_AMBIENT_OCCLUSION_ASYNC, FeatureFlags);
+        if (!RenderTech.IsInitializedPSO())
+        {
+            ShaderMacroHelper Macros;
+            Macros.Add("SSAO_OPTION_PACKED_NORMAL", (FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
+            Macros.Add("SSAO_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
+            Macros.Add("SSAO_OPTION_UNIFORM_WEIGHTING", (FeatureFlags & FEATURE_FLAG_UNIFORM_WEIGHTING) != 0);
+            Macros.Add("SSAO_OPTION_HALF_RESOLUTION", (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0);
+            Macros.Add("SSAO_OPTION_HALF_PRECISION_DEPTH", (FeatureFlags & FEATURE_FLAG_HALF_PRECISION_DEPTH) != 0);
+            Macros.Add("SSAO_OPTION_COMPUTE_SHADER", true);
+
+            const auto CS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "SSAO_ComputeAmbientOcclusion.fx", "ComputeAmbientOcclusionCS", SHADER_TYPE_COMPUTE, Macros, ShaderFlags);
+
+            PipelineResourceLayoutDescX ResourceLayout;
+            ResourceLayout
+                .AddVariable(SHADER_TYPE_COMPUTE, "cbCameraAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                .AddVariable(SHADER_TYPE_COMPUTE, "cbScreenSpaceAmbientOcclusionAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                .AddVariable(SHADER_TYPE_COMPUTE, "g_TexturePrefilteredDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_COMPUTE, "g_TextureNormal", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_COMPUTE, "g_TextureBlueNoise", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_COMPUTE, "g_RWTextureOcclusion", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddImmutableSampler(SHADER_TYPE_COMPUTE, "g_TexturePrefilteredDepth", Sam_PointClamp)
+                .AddImmutableSampler(SHADER_TYPE_COMPUTE, "g_TextureNormal", Sam_PointClamp);
+
+            // The pipeline is used by the async compute context
+            RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                     RenderAttribs.pStateCache, "ScreenSpaceAmbientOcclusion::ComputeAmbientOcclusionAsync",
+                                     CS, ResourceLayout, PSOFlags, m_ImmediateContextMask);
+        }
+        if (AllPSOsReady && !RenderTech.IsReady())
+            AllPSOsReady = false;
+    }
+
     {
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_BILATERAL_UPSAMPLING, FeatureFlags);
         if (!RenderTech.IsInitializedPSO())
@@ -660,6 +836,7 @@ bool ScreenSpaceAmbientOcclusion::PrepareShadersAndPSO(const RenderAttributes& R
         if (!RenderTech.IsInitializedPSO())
         {
             ShaderMacroHelper Macros;
+            Macros.Add("SSAO_OPTION_PACKED_NORMAL", (FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSAO_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
 
             const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
@@ -693,6 +870,7 @@ bool ScreenSpaceAmbientOcclusion::PrepareShadersAndPSO(const RenderAttributes& R
         if (!RenderTech.IsInitializedPSO())
         {
             ShaderMacroHelper Macros;
+            Macros.Add("SSAO_OPTION_PACKED_NORMAL", (FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSAO_OPTION_INVERTED_DEPTH", (FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
             Macros.Add("SSAO_OPTION_HALF_RESOLUTION", (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0);
 
@@ -757,12 +935,17 @@ void ScreenSpaceAmbientOcclusion::ComputeDepthCheckerboard(const RenderAttribute
     if (!(m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION))
         return;
 
-    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_BUFFER, m_FeatureFlags);
+    ITextureView* pDepthHierarchySRV = RenderAttribs.pPostFXContext->GetDepthHierarchy();
+
+    auto& RenderTech = GetRenderTechnique(pDepthHierarchySRV != nullptr ? RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_FROM_HIERARCHY : RENDER_TECH_COMPUTE_DOWNSAMPLED_DEPTH_BUFFER, m_FeatureFlags);
 
     if (!RenderTech.IsInitializedSRB())
         RenderTech.InitializeSRB(false);
 
-    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_DEPTH].GetTextureSRV());
+    if (pDepthHierarchySRV != nullptr)
+        ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy"}.Set(pDepthHierarchySRV);
+    else
+        ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_DEPTH].GetTextureSRV());
 
     ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeDownsampledDepth"};
 
@@ -926,6 +1109,83 @@ void ScreenSpaceAmbientOcclusion::ComputeAmbientOcclusion(const RenderAttributes
     RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+bool ScreenSpaceAmbientOcclusion::CanComputeAmbientOcclusionAsync(const RenderAttributes& RenderAttribs) const
+{
+    if (!m_pAsyncComputeCtx)
+        return false;
+
+    // All resources that are read by the pass must be accessible by the async compute context
+    const Uint64 AsyncCtxBit = Uint64{1} << m_pAsyncComputeCtx->GetDesc().ContextId;
+
+    ITextureView* pBlueNoiseSRV = RenderAttribs.pPostFXContext->Get2DBlueNoiseSRV(PostFXContext::BLUE_NOISE_DIMENSION_ZW);
+
+    const bool InputsShared =
+        (m_Resources[RESOURCE_IDENTIFIER_INPUT_NORMAL].AsTexture()->GetDesc().ImmediateContextMask & AsyncCtxBit) != 0 &&
+        (RenderAttribs.pPostFXContext->GetCameraAttribsCB()->GetDesc().ImmediateContextMask & AsyncCtxBit) != 0 &&
+        (pBlueNoiseSRV->GetTexture()->GetDesc().ImmediateContextMask & AsyncCtxBit) != 0;
+    if (!InputsShared)
+    {
+        LOG_WARNING_MESSAGE_ONCE("The normal buffer or the PostFX context resources are not created for the async compute context. "
+                                 "Ambient occlusion will be computed on the main context.");
+    }
+    return InputsShared;
+}
+
+void ScreenSpaceAmbientOcclusion::ComputeAmbientOcclusionAsync(const RenderAttributes& RenderAttribs)
+{
+    VERIFY_EXPR(m_pAsyncComputeCtx && m_pAsyncComputeFence);
+
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_AMBIENT_OCCLUSION_ASYNC, m_FeatureFlags);
+
+    if (!RenderTech.IsInitializedSRB())
+    {
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_COMPUTE, "cbCameraAttribs"}.Set(RenderAttribs.pPostFXContext->GetCameraAttribsCB());
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_COMPUTE, "cbScreenSpaceAmbientOcclusionAttribs"}.Set(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER]);
+        RenderTech.InitializeSRB(true);
+    }
+
+    ITexture* pOcclusion = m_Resources[RESOURCE_IDENTIFIER_OCCLUSION].AsTexture();
+    ITexture* pBlueNoise = RenderAttribs.pPostFXContext->Get2DBlueNoiseSRV(PostFXContext::BLUE_NOISE_DIMENSION_ZW)->GetTexture();
+
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_TexturePrefilteredDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_DEPTH_PREFILTERED].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_TextureNormal"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_NORMAL].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_TextureBlueNoise"}.Set(RenderAttribs.pPostFXContext->Get2DBlueNoiseSRV(PostFXContext::BLUE_NOISE_DIMENSION_ZW));
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_COMPUTE, "g_RWTextureOcclusion"}.Set(pOcclusion->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    // Compute queues can't transition resources from graphics-only states, so all resources
+    // that are accessed by the pass are transitioned on the main context before it is flushed.
+    StateTransitionDesc Barriers[] = {
+        {m_Resources[RESOURCE_IDENTIFIER_DEPTH_PREFILTERED].AsTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {m_Resources[RESOURCE_IDENTIFIER_INPUT_NORMAL].AsTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {pBlueNoise, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {pOcclusion, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {RenderAttribs.pPostFXContext->GetCameraAttribsCB(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER].AsBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+    };
+    RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    // Make the async queue wait for the passes that have been recorded on the main context
+    RenderAttribs.pDeviceContext->EnqueueSignal(m_pAsyncComputeFence, ++m_LastAsyncComputeFenceValue);
+    RenderAttribs.pDeviceContext->Flush();
+    m_pAsyncComputeCtx->DeviceWaitForFence(m_pAsyncComputeFence, m_LastAsyncComputeFenceValue);
+
+    {
+        ScopedDebugGroup DebugGroup{m_pAsyncComputeCtx, "ComputeAmbientOcclusionAsync"};
+
+        const TextureDesc& OcclusionDesc = pOcclusion->GetDesc();
+
+        m_pAsyncComputeCtx->SetPipelineState(RenderTech.PSO);
+        m_pAsyncComputeCtx->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        m_pAsyncComputeCtx->DispatchCompute({(OcclusionDesc.Width + SSAO_COMPUTE_GROUP_SIZE - 1) / SSAO_COMPUTE_GROUP_SIZE,
+                                             (OcclusionDesc.Height + SSAO_COMPUTE_GROUP_SIZE - 1) / SSAO_COMPUTE_GROUP_SIZE,
+                                             1});
+    }
+
+    m_pAsyncComputeCtx->EnqueueSignal(m_pAsyncComputeFence, ++m_LastAsyncComputeFenceValue);
+    m_pAsyncComputeCtx->Flush();
+    m_PendingAsyncComputeFenceValue = m_LastAsyncComputeFenceValue;
+}
+
 void ScreenSpaceAmbientOcclusion::ComputeBilateralUpsampling(const RenderAttributes& RenderAttribs)
 {
     if (!(m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION))
@@ -57,8 +57,11 @@ public:
     enum FEATURE_FLAGS : Uint32
     {
         FEATURE_FLAG_NONE           = 0u,
-        FEATURE_FLAG_REVERSED_DEPTH = 1u << 0u, // Not implemented
-        FEATURE_FLAG_PACKED_NORMAL  = 1u << 1u, // Nor implemented
+        FEATURE_FLAG_REVERSED_DEPTH = 1u << 0u,
+
+        // When this flag is used, the normal buffer contains octahedron-encoded normals in the first
+        // two components (e.g. RG16_UNORM), see EncodeNormalOctahedron() in ShaderUtilities.fxh.
+        FEATURE_FLAG_PACKED_NORMAL  = 1u << 1u,
 
         // When using this flag, you only need to pass the color buffer of the previous frame.
         // We find the intersection using the depth buffer of the current frame, and when an intersection is found,
@@ -114,6 +117,11 @@ public:
 
     void PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDeviceContext, PostFXContext* pPostFXContext, FEATURE_FLAGS FeatureFlags);
 
+    /// Computes the reflections.
+    ///
+    /// \remarks    PrepareResources() requests the depth hierarchy from the PostFXContext, so the context
+    ///             does not need to be prepared with PostFXContext::FEATURE_FLAG_DEPTH_HIERARCHY.
+    ///             Until the hierarchy is available, the output is filled with the placeholder value.
     void Execute(const RenderAttributes& RenderAttribs);
 
     static bool UpdateUI(HLSL::ScreenSpaceReflectionAttribs& SSRAttribs, FEATURE_FLAGS& FeatureFlags, Uint32& DisplayMode);
@@ -126,8 +134,7 @@ private:
 
     enum RENDER_TECH : Uint32
     {
-        RENDER_TECH_COMPUTE_HIERARCHICAL_DEPTH_BUFFER = 0,
-        RENDER_TECH_COMPUTE_STENCIL_MASK_AND_EXTRACT_ROUGHNESS,
+        RENDER_TECH_COMPUTE_STENCIL_MASK_AND_EXTRACT_ROUGHNESS = 0,
         RENDER_TECH_COMPUTE_DOWNSAMPLED_STENCIL_MASK,
         RENDER_TECH_COMPUTE_INTERSECTION,
         RENDER_TECH_COMPUTE_SPATIAL_RECONSTRUCTION,
@@ -145,8 +152,6 @@ private:
         RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS,
         RESOURCE_IDENTIFIER_INPUT_LAST = RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS,
         RESOURCE_IDENTIFIER_CONSTANT_BUFFER,
-        RESOURCE_IDENTIFIER_DEPTH_HIERARCHY,
-        RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE,
         RESOURCE_IDENTIFIER_DEPTH_STENCIL_MASK,
         RESOURCE_IDENTIFIER_DEPTH_STENCIL_MASK_HALF_RES,
         RESOURCE_IDENTIFIER_ROUGHNESS,
@@ -163,12 +168,21 @@ private:
         RESOURCE_IDENTIFIER_COUNT
     };
 
+    // Passes of Execute() in the order of execution. They define the lifetimes of the transient textures.
+    enum PASS : Uint32
+    {
+        PASS_STENCIL_MASK_AND_EXTRACT_ROUGHNESS = 0,
+        PASS_DOWNSAMPLED_STENCIL_MASK,
+        PASS_INTERSECTION,
+        PASS_SPATIAL_RECONSTRUCTION,
+        PASS_TEMPORAL_ACCUMULATION,
+        PASS_BILATERAL_CLEANUP
+    };
+
     bool PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags);
 
     void UpdateConstantBuffer(const RenderAttributes& RenderAttribs, bool ResetTimer);
 
-    void ComputeHierarchicalDepthBuffer(const RenderAttributes& RenderAttribs);
-
     void ComputeStencilMaskAndExtractRoughness(const RenderAttributes& RenderAttribs);
 
     void ComputeDownsampledStencilMask(const RenderAttributes& RenderAttribs);
@@ -206,7 +220,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -217,10 +231,12 @@ private:
 
     ResourceRegistry m_Resources{RESOURCE_IDENTIFIER_COUNT};
 
-    std::vector<RefCntAutoPtr<ITextureView>> m_HierarchicalDepthMipMapRTV;
-    std::vector<RefCntAutoPtr<ITextureView>> m_HierarchicalDepthMipMapSRV;
-    RefCntAutoPtr<ITextureView>              m_DepthStencilMaskDSVReadOnly;
-    RefCntAutoPtr<ITextureView>              m_DepthStencilMaskDSVReadOnlyHalfRes;
+    // Intermediate textures that are only used within Execute() are acquired from
+    // the PostFXContext transient texture pool and released at the end of Execute().
+    std::vector<PostFXContext::TransientTextureAttribs> m_TransientTextures;
+
+    RefCntAutoPtr<ITextureView> m_DepthStencilMaskDSVReadOnly;
+    RefCntAutoPtr<ITextureView> m_DepthStencilMaskDSVReadOnlyHalfRes;
 
     Uint32 m_BackBufferWidth  = 0;
     Uint32 m_BackBufferHeight = 0;
@@ -90,8 +90,10 @@ ScreenSpaceReflection::~ScreenSpaceReflection() = default;
 
 void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceContext* pDeviceContext, PostFXContext* pPostFXContext, FEATURE_FLAGS FeatureFlags)
 {
-    const auto& FrameDesc         = pPostFXContext->GetFrameDesc();
-    const auto& SupportedFeatures = pPostFXContext->GetSupportedFeatures();
+    // The ray march reads the shared depth hierarchy
+    pPostFXContext->RequestDepthHierarchy(pDevice);
+
+    const auto& FrameDesc = pPostFXContext->GetFrameDesc();
 
     if (m_BackBufferWidth == FrameDesc.Width && m_BackBufferHeight == FrameDesc.Height && m_FeatureFlags == FeatureFlags)
         return;
@@ -105,57 +107,16 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
 
     RenderDeviceWithCache_N Device{pDevice};
 
-    constexpr Uint32 DepthHierarchyMipCount = SSR_DEPTH_HIERARCHY_MAX_MIP + 1;
-    {
-        m_HierarchicalDepthMipMapRTV.clear();
-        m_HierarchicalDepthMipMapSRV.clear();
-
-        TextureDesc Desc;
-        Desc.Name      = "ScreenSpaceReflection::DepthHierarchy";
-        Desc.Type      = RESOURCE_DIM_TEX_2D;
-        Desc.Width     = m_BackBufferWidth;
-        Desc.Height    = m_BackBufferHeight;
-        Desc.Format    = TEX_FORMAT_R32_FLOAT;
-        Desc.MipLevels = std::min(ComputeMipLevelsCount(m_BackBufferWidth, m_BackBufferHeight), DepthHierarchyMipCount);
-        Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_HIERARCHY, Device.CreateTexture(Desc));
-
-        m_HierarchicalDepthMipMapSRV.resize(Desc.MipLevels);
-        m_HierarchicalDepthMipMapRTV.resize(Desc.MipLevels);
-
-        for (Uint32 MipLevel = 0; MipLevel < Desc.MipLevels; MipLevel++)
-        {
-            {
-                TextureViewDesc ViewDesc;
-                ViewDesc.ViewType        = TEXTURE_VIEW_RENDER_TARGET;
-                ViewDesc.MostDetailedMip = MipLevel;
-                ViewDesc.NumMipLevels    = 1;
-                m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture()->CreateView(ViewDesc, &m_HierarchicalDepthMipMapRTV[MipLevel]);
-            }
+    m_TransientTextures.clear();
 
-            if (SupportedFeatures.TextureSubresourceViews)
-            {
-                TextureViewDesc ViewDesc;
-                ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
-                ViewDesc.MostDetailedMip = MipLevel;
-                ViewDesc.NumMipLevels    = 1;
-                m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture()->CreateView(ViewDesc, &m_HierarchicalDepthMipMapSRV[MipLevel]);
-            }
-        }
-    }
-
-    if (!SupportedFeatures.TextureSubresourceViews)
-    {
-        TextureDesc Desc;
-        Desc.Name      = "ScreenSpaceReflection::DepthHierarchyIntermediate";
-        Desc.Type      = RESOURCE_DIM_TEX_2D;
-        Desc.Width     = m_BackBufferWidth;
-        Desc.Height    = m_BackBufferHeight;
-        Desc.Format    = TEX_FORMAT_R32_FLOAT;
-        Desc.MipLevels = std::min(ComputeMipLevelsCount(m_BackBufferWidth, m_BackBufferHeight), DepthHierarchyMipCount);
-        Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE, Device.CreateTexture(Desc));
-    }
+    auto AddTransientTexture = [&](Uint32 ResourceId, const TextureDesc& Desc, PASS FirstPass, PASS LastPass) {
+        PostFXContext::TransientTextureAttribs Attribs;
+        Attribs.ResourceId = ResourceId;
+        Attribs.Desc       = Desc;
+        Attribs.FirstPass  = FirstPass;
+        Attribs.LastPass   = LastPass;
+        m_TransientTextures.push_back(Attribs);
+    };
 
     {
         TextureDesc Desc;
@@ -165,7 +126,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_R8_UNORM;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_ROUGHNESS, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_ROUGHNESS, Desc, PASS_STENCIL_MASK_AND_EXTRACT_ROUGHNESS, PASS_BILATERAL_CLEANUP);
     }
 
     TEXTURE_FORMAT DepthStencilFormat = TEX_FORMAT_D32_FLOAT_S8X24_UINT;
@@ -217,7 +178,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) ? m_BackBufferHeight / 2 : m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_RADIANCE, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_RADIANCE, Desc, PASS_INTERSECTION, PASS_SPATIAL_RECONSTRUCTION);
     }
 
     {
@@ -228,7 +189,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) ? m_BackBufferHeight / 2 : m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_RAY_DIRECTION_PDF, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_RAY_DIRECTION_PDF, Desc, PASS_INTERSECTION, PASS_SPATIAL_RECONSTRUCTION);
     }
 
     {
@@ -239,7 +200,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_RESOLVED_RADIANCE, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_RESOLVED_RADIANCE, Desc, PASS_SPATIAL_RECONSTRUCTION, PASS_TEMPORAL_ACCUMULATION);
     }
 
     {
@@ -250,7 +211,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_R16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_RESOLVED_VARIANCE, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_RESOLVED_VARIANCE, Desc, PASS_SPATIAL_RECONSTRUCTION, PASS_TEMPORAL_ACCUMULATION);
     }
 
     {
@@ -261,7 +222,7 @@ void ScreenSpaceReflection::PrepareResources(IRenderDevice* pDevice, IDeviceCont
         Desc.Height    = m_BackBufferHeight;
         Desc.Format    = TEX_FORMAT_R16_FLOAT;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
-        m_Resources.Insert(RESOURCE_IDENTIFIER_RESOLVED_DEPTH, Device.CreateTexture(Desc));
+        AddTransientTexture(RESOURCE_IDENTIFIER_RESOLVED_DEPTH, Desc, PASS_SPATIAL_RECONSTRUCTION, PASS_TEMPORAL_ACCUMULATION);
     }
 
     for (Uint32 TextureIdx = RESOURCE_IDENTIFIER_RADIANCE_HISTORY0; TextureIdx <= RESOURCE_IDENTIFIER_RADIANCE_HISTORY1; TextureIdx++)
@@ -330,11 +291,20 @@ void ScreenSpaceReflection::Execute(const RenderAttributes& RenderAttribs)
 
     ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "ScreenSpaceReflection"};
 
-    bool AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
+    // The ray march and the half-resolution stencil mask read the shared depth hierarchy.
+    // If it is not available, write the placeholder output instead of binding a null texture.
+    const bool DepthHierarchyReady = RenderAttribs.pPostFXContext->GetDepthHierarchy() != nullptr;
+    if (!DepthHierarchyReady)
+    {
+        LOG_WARNING_MESSAGE_ONCE("ScreenSpaceReflection requires the depth hierarchy. Call ScreenSpaceReflection::PrepareResources() after PostFXContext::PrepareResources() and before PostFXContext::Execute().");
+    }
+
+    const bool TransientTexturesReady = RenderAttribs.pPostFXContext->AcquireTransientTextures(RenderAttribs.pDevice, m_TransientTextures.data(), static_cast<Uint32>(m_TransientTextures.size()), m_Resources);
+
+    bool AllPSOsReady = DepthHierarchyReady && TransientTexturesReady && PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && RenderAttribs.pPostFXContext->IsPSOsReady();
     UpdateConstantBuffer(RenderAttribs, !AllPSOsReady);
     if (AllPSOsReady)
     {
-        ComputeHierarchicalDepthBuffer(RenderAttribs);
         ComputeStencilMaskAndExtractRoughness(RenderAttribs);
         ComputeDownsampledStencilMask(RenderAttribs);
         ComputeIntersection(RenderAttribs);
@@ -347,6 +317,9 @@ void ScreenSpaceReflection::Execute(const RenderAttributes& RenderAttribs)
         ComputePlaceholderTexture(RenderAttribs);
     }
 
+    // Return the intermediate textures to the pool so that they can be reused by other effects
+    RenderAttribs.pPostFXContext->ReleaseTransientTextures(m_TransientTextures.data(), static_cast<Uint32>(m_TransientTextures.size()), m_Resources);
+
     // Release references to input resources
     for (Uint32 ResourceIdx = 0; ResourceIdx <= RESOURCE_IDENTIFIER_INPUT_LAST; ++ResourceIdx)
         m_Resources[ResourceIdx].Release();
@@ -483,43 +456,6 @@ bool ScreenSpaceReflection::PrepareShadersAndPSO(const RenderAttributes& RenderA
     const SHADER_COMPILE_FLAGS ShaderFlags = RenderAttribs.pPostFXContext->GetShaderCompileFlags(m_Settings.EnableAsyncCreation);
     const PSO_CREATE_FLAGS     PSOFlags    = m_Settings.EnableAsyncCreation ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
 
-    {
-        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_HIERARCHICAL_DEPTH_BUFFER, m_FeatureFlags);
-
-        if (!RenderTech.IsInitializedPSO())
-        {
-            ShaderMacroHelper Macros;
-            Macros.Add("SUPPORTED_SHADER_SRV", SupportedFeatures.TextureSubresourceViews);
-            Macros.Add("SSR_OPTION_INVERTED_DEPTH", (m_FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
-
-            const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
-            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "SSR_ComputeHierarchicalDepthBuffer.fx", "ComputeHierarchicalDepthBufferPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
-
-            PipelineResourceLayoutDescX ResourceLayout;
-            if (SupportedFeatures.TextureSubresourceViews)
-            {
-                ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureLastMip", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
-            }
-            else
-            {
-                ResourceLayout
-                    .AddVariable(SHADER_TYPE_PIXEL, "g_TextureMips", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
-                    .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureMips", Sam_PointWrap); // Immutable samplers are required for WebGL to work properly
-            }
-
-            RenderTech.InitializePSO(RenderAttribs.pDevice,
-                                     RenderAttribs.pStateCache, "ScreenSpaceReflection::ComputeHierarchicalDepthBuffer",
-                                     VS, PS, ResourceLayout,
-                                     {
-                                         m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture()->GetDesc().Format,
-                                     },
-                                     TEX_FORMAT_UNKNOWN,
-                                     DSS_DisableDepth, BS_Default, false, PSOFlags);
-        }
-        if (AllPSOsReady && !RenderTech.IsReady())
-            AllPSOsReady = false;
-    }
-
     {
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_STENCIL_MASK_AND_EXTRACT_ROUGHNESS, m_FeatureFlags);
         if (!RenderTech.IsInitializedPSO())
@@ -557,9 +493,13 @@ bool ScreenSpaceReflection::PrepareShadersAndPSO(const RenderAttributes& RenderA
             PipelineResourceLayoutDescX ResourceLayout;
             ResourceLayout
                 .AddVariable(SHADER_TYPE_PIXEL, "cbScreenSpaceReflectionAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
-                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, SHADER_VARIABLE_FLAG_UNFILTERABLE_FLOAT_TEXTURE_WEBGPU)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureRoughness", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
 
+            // Immutable sampler is required for WebGL to work properly
+            if (!SupportedFeatures.TextureSubresourceViews)
+                ResourceLayout.AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy", Sam_PointClamp);
+
             ShaderMacroHelper Macros;
             Macros.Add("SSR_OPTION_INVERTED_DEPTH", (m_FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
 
@@ -599,6 +539,7 @@ bool ScreenSpaceReflection::PrepareShadersAndPSO(const RenderAttributes& RenderA
                 ResourceLayout.AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy", Sam_PointClamp);
 
             ShaderMacroHelper Macros;
+            Macros.Add("SSR_OPTION_PACKED_NORMAL", (m_FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSR_OPTION_PREVIOUS_FRAME", (m_FeatureFlags & FEATURE_FLAG_PREVIOUS_FRAME) != 0);
             Macros.Add("SSR_OPTION_INVERTED_DEPTH", (m_FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
             Macros.Add("SSR_OPTION_HALF_RESOLUTION", (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0);
@@ -636,6 +577,7 @@ bool ScreenSpaceReflection::PrepareShadersAndPSO(const RenderAttributes& RenderA
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureRayLength", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
 
             ShaderMacroHelper Macros;
+            Macros.Add("SSR_OPTION_PACKED_NORMAL", (m_FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSR_OPTION_INVERTED_DEPTH", (m_FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
             Macros.Add("SSR_OPTION_HALF_RESOLUTION", (m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0);
 
@@ -713,6 +655,7 @@ bool ScreenSpaceReflection::PrepareShadersAndPSO(const RenderAttributes& RenderA
                 .AddVariable(SHADER_TYPE_PIXEL, "g_TextureVariance", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
 
             ShaderMacroHelper Macros;
+            Macros.Add("SSR_OPTION_PACKED_NORMAL", (m_FeatureFlags & FEATURE_FLAG_PACKED_NORMAL) != 0);
             Macros.Add("SSR_OPTION_INVERTED_DEPTH", (m_FeatureFlags & FEATURE_FLAG_REVERSED_DEPTH) != 0);
 
             const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
@@ -754,133 +697,6 @@ void ScreenSpaceReflection::UpdateConstantBuffer(const RenderAttributes& RenderA
     }
 }
 
-void ScreenSpaceReflection::ComputeHierarchicalDepthBuffer(const RenderAttributes& RenderAttribs)
-{
-    auto&       RenderTech        = GetRenderTechnique(RENDER_TECH_COMPUTE_HIERARCHICAL_DEPTH_BUFFER, m_FeatureFlags);
-    const auto& SupportedFeatures = RenderAttribs.pPostFXContext->GetSupportedFeatures();
-
-    if (!RenderTech.IsInitializedSRB())
-        RenderTech.InitializeSRB(false);
-
-    ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeHierarchicalDepthBuffer"};
-
-    if (SupportedFeatures.CopyDepthToColor)
-    {
-        CopyTextureAttribs CopyAttribs;
-        CopyAttribs.pSrcTexture              = m_Resources[RESOURCE_IDENTIFIER_INPUT_DEPTH];
-        CopyAttribs.pDstTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY];
-        CopyAttribs.SrcMipLevel              = 0;
-        CopyAttribs.DstMipLevel              = 0;
-        CopyAttribs.SrcSlice                 = 0;
-        CopyAttribs.DstSlice                 = 0;
-        CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-        CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-        RenderAttribs.pDeviceContext->CopyTexture(CopyAttribs);
-    }
-    else
-    {
-        PostFXContext::TextureOperationAttribs CopyAttribs;
-        CopyAttribs.pDevice        = RenderAttribs.pDevice;
-        CopyAttribs.pStateCache    = RenderAttribs.pStateCache;
-        CopyAttribs.pDeviceContext = RenderAttribs.pDeviceContext;
-        RenderAttribs.pPostFXContext->CopyTextureDepth(CopyAttribs, m_Resources[RESOURCE_IDENTIFIER_INPUT_DEPTH].GetTextureSRV(), m_HierarchicalDepthMipMapRTV[0]);
-    }
-
-    if (!SupportedFeatures.TextureSubresourceViews)
-    {
-        CopyTextureAttribs CopyMipAttribs;
-        CopyMipAttribs.pSrcTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY];
-        CopyMipAttribs.pDstTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE];
-        CopyMipAttribs.SrcMipLevel              = 0;
-        CopyMipAttribs.DstMipLevel              = 0;
-        CopyMipAttribs.SrcSlice                 = 0;
-        CopyMipAttribs.DstSlice                 = 0;
-        CopyMipAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-        CopyMipAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-        RenderAttribs.pDeviceContext->CopyTexture(CopyMipAttribs);
-    }
-
-    if (SupportedFeatures.TransitionSubresources)
-    {
-        StateTransitionDesc TransitionDescW2W[] = {
-            StateTransitionDesc{m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture(),
-                                RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET,
-                                STATE_TRANSITION_FLAG_UPDATE_STATE},
-        };
-        RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TransitionDescW2W), TransitionDescW2W);
-
-        ShaderResourceVariableX TextureLastMipSV{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureLastMip"};
-        for (Uint32 MipLevel = 1; MipLevel < m_HierarchicalDepthMipMapRTV.size(); MipLevel++)
-        {
-            StateTransitionDesc TranslationW2R[] = {
-                StateTransitionDesc{m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture(),
-                                    RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_SHADER_RESOURCE,
-                                    MipLevel - 1, 1, 0, REMAINING_ARRAY_SLICES,
-                                    STATE_TRANSITION_TYPE_IMMEDIATE, STATE_TRANSITION_FLAG_NONE},
-            };
-
-            TextureLastMipSV.Set(m_HierarchicalDepthMipMapSRV[MipLevel - 1]);
-            RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TranslationW2R), TranslationW2R);
-            RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_HierarchicalDepthMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
-            RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
-            RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
-            RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
-        }
-
-        StateTransitionDesc TransitionDescW2R[] = {
-            StateTransitionDesc{m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].AsTexture(),
-                                RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_SHADER_RESOURCE,
-                                static_cast<Uint32>(m_HierarchicalDepthMipMapRTV.size() - 1), 1, 0, REMAINING_ARRAY_SLICES,
-                                STATE_TRANSITION_TYPE_IMMEDIATE, STATE_TRANSITION_FLAG_UPDATE_STATE},
-        };
-        RenderAttribs.pDeviceContext->TransitionResourceStates(_countof(TransitionDescW2R), TransitionDescW2R);
-    }
-    else
-    {
-        if (SupportedFeatures.TextureSubresourceViews)
-        {
-            ShaderResourceVariableX TextureLastMipSV{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureLastMip"};
-            for (Uint32 MipLevel = 1; MipLevel < m_HierarchicalDepthMipMapRTV.size(); MipLevel++)
-            {
-                TextureLastMipSV.Set(m_HierarchicalDepthMipMapSRV[MipLevel - 1]);
-                RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_HierarchicalDepthMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
-                RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
-                RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
-                RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
-            }
-        }
-        else
-        {
-            ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureMips"}.Set(m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE].GetTextureSRV());
-
-            for (Uint32 MipLevel = 1; MipLevel < m_HierarchicalDepthMipMapRTV.size(); MipLevel++)
-            {
-                // We use StartVertexLocation to pass the mipmap level of the depth texture for convolution
-                VERIFY_EXPR(SupportedFeatures.ShaderBaseVertexOffset);
-                const Uint32 VertexOffset = 3u * (MipLevel - 1);
-                RenderAttribs.pDeviceContext->SetRenderTargets(1, &m_HierarchicalDepthMipMapRTV[MipLevel], nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-                RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
-                RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-                RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1, VertexOffset});
-                RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-
-                CopyTextureAttribs CopyMipAttribs;
-                CopyMipAttribs.pSrcTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY];
-                CopyMipAttribs.pDstTexture              = m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY_INTERMEDIATE];
-                CopyMipAttribs.SrcMipLevel              = MipLevel;
-                CopyMipAttribs.DstMipLevel              = MipLevel;
-                CopyMipAttribs.SrcSlice                 = 0;
-                CopyMipAttribs.DstSlice                 = 0;
-                CopyMipAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-                CopyMipAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
-                RenderAttribs.pDeviceContext->CopyTexture(CopyMipAttribs);
-            }
-        }
-    }
-
-    RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
-}
-
 void ScreenSpaceReflection::ComputeStencilMaskAndExtractRoughness(const RenderAttributes& RenderAttribs)
 {
     auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_STENCIL_MASK_AND_EXTRACT_ROUGHNESS, m_FeatureFlags);
@@ -925,7 +741,7 @@ void ScreenSpaceReflection::ComputeDownsampledStencilMask(const RenderAttributes
     }
 
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureRoughness"}.Set(m_Resources[RESOURCE_IDENTIFIER_ROUGHNESS].GetTextureSRV());
-    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepth"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_DEPTH].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy"}.Set(RenderAttribs.pPostFXContext->GetDepthHierarchy());
 
     ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeDownsampledStencilMask"};
 
@@ -955,7 +771,7 @@ void ScreenSpaceReflection::ComputeIntersection(const RenderAttributes& RenderAt
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureNormal"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_NORMAL].GetTextureSRV());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureRoughness"}.Set(m_Resources[RESOURCE_IDENTIFIER_ROUGHNESS].GetTextureSRV());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureBlueNoise"}.Set(RenderAttribs.pPostFXContext->Get2DBlueNoiseSRV(PostFXContext::BLUE_NOISE_DIMENSION_XY));
-    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy"}.Set(m_Resources[RESOURCE_IDENTIFIER_DEPTH_HIERARCHY].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureDepthHierarchy"}.Set(RenderAttribs.pPostFXContext->GetDepthHierarchy());
     ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureMotion"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_MOTION_VECTORS].GetTextureSRV());
 
     ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "ComputeIntersection"};
@@ -967,6 +783,8 @@ void ScreenSpaceReflection::ComputeIntersection(const RenderAttributes& RenderAt
 
     ITextureView* pDSV = m_FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION ? m_DepthStencilMaskDSVReadOnlyHalfRes : m_DepthStencilMaskDSVReadOnly;
 
+    // The targets are transient and only written inside the stencil mask, while spatial
+    // reconstruction samples the neighbors outside of it. Clear them to not read data left by other effects.
     constexpr float4 RTVClearColor = float4(0.0, 0.0, 0.0, 0.0);
 
     RenderAttribs.pDeviceContext->SetRenderTargets(_countof(pRTVs), pRTVs, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -1004,7 +822,13 @@ void ScreenSpaceReflection::ComputeSpatialReconstruction(const RenderAttributes&
         m_Resources[RESOURCE_IDENTIFIER_RESOLVED_DEPTH].GetTextureRTV(),
     };
 
+    // The targets are transient and only written inside the stencil mask, while temporal
+    // accumulation also reads the pixels outside of it. Clear them to not read data left by other effects.
+    constexpr float4 RTVClearColor = float4(0.0, 0.0, 0.0, 0.0);
+
     RenderAttribs.pDeviceContext->SetRenderTargets(_countof(pRTVs), pRTVs, m_DepthStencilMaskDSVReadOnly, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    for (ITextureView* pRTV : pRTVs)
+        RenderAttribs.pDeviceContext->ClearRenderTarget(pRTV, RTVClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     RenderAttribs.pDeviceContext->SetStencilRef(0xFF);
     RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
     RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
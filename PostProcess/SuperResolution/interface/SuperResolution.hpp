@@ -52,6 +52,17 @@ public:
     enum FEATURE_FLAGS : Uint32
     {
         FEATURE_FLAG_NONE = 0u,
+
+        /// Reconstruct the output from the jittered history instead of upscaling the current frame only.
+        /// The render resolution is given by PostFXContext::FrameDesc::Width/Height and the output resolution by
+        /// OutputWidth/OutputHeight. The motion vectors and depth are taken from the PostFXContext, so
+        /// PostFXContext::Execute() must be called before SuperResolution::Execute(). The camera projection must
+        /// be jittered with the offsets returned by GetJitterOffset(). The output is in linear HDR color space.
+        FEATURE_FLAG_TEMPORAL_UPSCALING = 1u << 0u,
+
+        /// Use the reactive mask (see RenderAttributes::pReactiveMaskSRV) to reduce the history
+        /// contribution. Only used with FEATURE_FLAG_TEMPORAL_UPSCALING.
+        FEATURE_FLAG_REACTIVE_MASK = 1u << 1u,
     };
 
     struct RenderAttributes
@@ -71,6 +82,11 @@ public:
         /// Shader resource view of the source color.
         ITextureView* pColorBufferSRV = nullptr;
 
+        /// Shader resource view of the single-channel reactive mask at the render resolution.
+        /// Values close to one mark pixels whose history is not reliable, e.g. translucent or
+        /// animated surfaces that do not write motion vectors. Required if FEATURE_FLAG_REACTIVE_MASK is set.
+        ITextureView* pReactiveMaskSRV = nullptr;
+
         /// Super resolution settings
         const HLSL::SuperResolutionAttribs* pFSRAttribs = nullptr;
     };
@@ -93,6 +109,13 @@ public:
 
     ITextureView* GetUpsampledTextureSRV() const;
 
+    /// Returns the projection jitter offset in normalized device coordinates for the current frame.
+    ///
+    /// \remarks    The offset is zero unless FEATURE_FLAG_TEMPORAL_UPSCALING is set. The number of jitter
+    ///             phases grows with the square of the upscaling ratio so that every output pixel
+    ///             receives a few samples per cycle.
+    float2 GetJitterOffset() const;
+
 private:
     using RenderTechnique  = PostFXRenderTechnique;
     using ResourceInternal = RefCntAutoPtr<IDeviceObject>;
@@ -101,16 +124,20 @@ private:
     {
         RENDER_TECH_COMPUTE_EDGE_ADAPTIVE_UPSAMPLING = 0,
         RENDER_TECH_COMPUTE_CONTRAST_ADAPTIVE_SHARPENING,
+        RENDER_TECH_COMPUTE_TEMPORAL_UPSAMPLING,
         RENDER_TECH_COUNT
     };
 
     enum RESOURCE_IDENTIFIER : Uint32
     {
         RESOURCE_IDENTIFIER_INPUT_COLOR = 0,
-        RESOURCE_IDENTIFIER_INPUT_LAST  = RESOURCE_IDENTIFIER_INPUT_COLOR,
+        RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK,
+        RESOURCE_IDENTIFIER_INPUT_LAST = RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK,
         RESOURCE_IDENTIFIER_CONSTANT_BUFFER,
         RESOURCE_IDENTIFIER_EAU,
         RESOURCE_IDENTIFIER_CAS,
+        RESOURCE_IDENTIFIER_HISTORY0,
+        RESOURCE_IDENTIFIER_HISTORY1,
         RESOURCE_IDENTIFIER_COUNT
     };
 
@@ -122,6 +149,8 @@ private:
 
     void ComputeEdgeAdaptiveUpsampling(const RenderAttributes& RenderAttribs);
 
+    void ComputeTemporalUpsampling(const RenderAttributes& RenderAttribs);
+
     void ComputeContrastAdaptiveSharpening(const RenderAttributes& RenderAttribs);
 
     void ComputePlaceholderTexture(const RenderAttributes& RenderAttribs);
@@ -147,7 +176,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -160,7 +189,12 @@ private:
 
     Uint32 m_BackBufferWidth  = 0;
     Uint32 m_BackBufferHeight = 0;
+    Uint32 m_SourceWidth      = 0;
+    Uint32 m_SourceHeight     = 0;
     Uint32 m_CurrentFrameIdx  = 0;
+    Uint32 m_LastFrameIdx     = ~0u;
+
+    bool m_AllPSOsReady = false;
 
     FEATURE_FLAGS m_FeatureFlags = FEATURE_FLAG_NONE;
     CreateInfo    m_Settings;
@@ -27,6 +27,7 @@
 #include "SuperResolution.hpp"
 #include "CommonlyUsedStates.h"
 #include "imgui.h"
+#include "ImGuiUtils.hpp"
 #include "RenderStateCache.hpp"
 #include "ScopedDebugGroup.hpp"
 #include "ShaderMacroHelper.hpp"
@@ -40,6 +41,20 @@ namespace HLSL
 #include "Shaders/PostProcess/SuperResolution/public/SuperResolutionStructures.fxh"
 } // namespace HLSL
 
+// https://en.wikipedia.org/wiki/Halton_sequence#Implementation_in_pseudocode
+static float HaltonSequence(Uint32 Base, Uint32 Index)
+{
+    float Result = 0.0;
+    float F      = 1.0;
+    while (Index > 0)
+    {
+        F      = F / static_cast<float>(Base);
+        Result = Result + F * static_cast<float>(Index % Base);
+        Index  = static_cast<Uint32>(floorf(static_cast<float>(Index) / static_cast<float>(Base)));
+    }
+    return Result;
+}
+
 SuperResolution::SuperResolution(IRenderDevice* pDevice, const CreateInfo& CI) :
     m_SuperResolutionAttribs{std::make_unique<HLSL::SuperResolutionAttribs>()},
     m_Settings{CI}
@@ -61,7 +76,8 @@ void SuperResolution::PrepareResources(IRenderDevice* pDevice, IDeviceContext* p
 
     m_CurrentFrameIdx = FrameDesc.Index;
 
-    if (m_BackBufferWidth == FrameDesc.OutputWidth && m_BackBufferHeight == FrameDesc.OutputHeight && m_FeatureFlags == FeatureFlags)
+    if (m_BackBufferWidth == FrameDesc.OutputWidth && m_BackBufferHeight == FrameDesc.OutputHeight &&
+        m_SourceWidth == FrameDesc.Width && m_SourceHeight == FrameDesc.Height && m_FeatureFlags == FeatureFlags)
         return;
 
     for (auto& Iter : m_RenderTech)
@@ -69,12 +85,35 @@ void SuperResolution::PrepareResources(IRenderDevice* pDevice, IDeviceContext* p
 
     m_BackBufferWidth  = FrameDesc.OutputWidth;
     m_BackBufferHeight = FrameDesc.OutputHeight;
+    m_SourceWidth      = FrameDesc.Width;
+    m_SourceHeight     = FrameDesc.Height;
     m_FeatureFlags     = FeatureFlags;
+    m_LastFrameIdx     = ~0u;
 
     RenderDeviceWithCache_N Device{pDevice};
 
-    // We use sRGB space to reduce color banding artifacts
+    const bool TemporalUpscaling = (m_FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) != 0;
+    if (TemporalUpscaling)
     {
+        // The history is accumulated in linear HDR space
+        for (Uint32 TextureIdx = RESOURCE_IDENTIFIER_HISTORY0; TextureIdx <= RESOURCE_IDENTIFIER_HISTORY1; ++TextureIdx)
+        {
+            TextureDesc Desc;
+            Desc.Name      = "SuperResolution::TextureHistory";
+            Desc.Type      = RESOURCE_DIM_TEX_2D;
+            Desc.Width     = m_BackBufferWidth;
+            Desc.Height    = m_BackBufferHeight;
+            Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
+            Desc.MipLevels = 1;
+            Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+
+            m_Resources.Insert(TextureIdx, Device.CreateTexture(Desc));
+        }
+        m_Resources[RESOURCE_IDENTIFIER_EAU].Release();
+    }
+    else
+    {
+        // We use sRGB space to reduce color banding artifacts
         TextureDesc Desc;
         Desc.Name      = "SuperResolution::TextureEAU";
         Desc.Type      = RESOURCE_DIM_TEX_2D;
@@ -85,6 +124,8 @@ void SuperResolution::PrepareResources(IRenderDevice* pDevice, IDeviceContext* p
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
 
         m_Resources.Insert(RESOURCE_IDENTIFIER_EAU, Device.CreateTexture(Desc));
+        m_Resources[RESOURCE_IDENTIFIER_HISTORY0].Release();
+        m_Resources[RESOURCE_IDENTIFIER_HISTORY1].Release();
     }
 
     {
@@ -93,7 +134,7 @@ void SuperResolution::PrepareResources(IRenderDevice* pDevice, IDeviceContext* p
         Desc.Type      = RESOURCE_DIM_TEX_2D;
         Desc.Width     = m_BackBufferWidth;
         Desc.Height    = m_BackBufferHeight;
-        Desc.Format    = TEX_FORMAT_RGBA8_UNORM_SRGB;
+        Desc.Format    = TemporalUpscaling ? TEX_FORMAT_RGBA16_FLOAT : TEX_FORMAT_RGBA8_UNORM_SRGB;
         Desc.MipLevels = 1;
         Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
 
@@ -109,16 +150,25 @@ void SuperResolution::Execute(const RenderAttributes& RenderAttribs)
 
     DEV_CHECK_ERR(RenderAttribs.pColorBufferSRV != nullptr, "RenderAttribs.pColorBufferSRV must not be null");
     DEV_CHECK_ERR(RenderAttribs.pFSRAttribs != nullptr, "RenderAttribs.pFSRAttribs must not be null");
+    DEV_CHECK_ERR((m_FeatureFlags & FEATURE_FLAG_REACTIVE_MASK) == 0 || RenderAttribs.pReactiveMaskSRV != nullptr,
+                  "RenderAttribs.pReactiveMaskSRV must not be null when FEATURE_FLAG_REACTIVE_MASK is set");
 
     m_Resources.Insert(RESOURCE_IDENTIFIER_INPUT_COLOR, RenderAttribs.pColorBufferSRV->GetTexture());
+    if (RenderAttribs.pReactiveMaskSRV != nullptr)
+        m_Resources.Insert(RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK, RenderAttribs.pReactiveMaskSRV->GetTexture());
 
     ScopedDebugGroup DebugGroupGlobal{RenderAttribs.pDeviceContext, "SuperResolution"};
 
-    bool AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags);
+    const bool TemporalUpscaling = (m_FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) != 0;
+
+    m_AllPSOsReady = PrepareShadersAndPSO(RenderAttribs, m_FeatureFlags) && (!TemporalUpscaling || RenderAttribs.pPostFXContext->IsPSOsReady());
     UpdateConstantBuffer(RenderAttribs);
-    if (AllPSOsReady)
+    if (m_AllPSOsReady)
     {
-        ComputeEdgeAdaptiveUpsampling(RenderAttribs);
+        if (TemporalUpscaling)
+            ComputeTemporalUpsampling(RenderAttribs);
+        else
+            ComputeEdgeAdaptiveUpsampling(RenderAttribs);
         ComputeContrastAdaptiveSharpening(RenderAttribs);
     }
     else
@@ -138,6 +188,22 @@ bool SuperResolution::UpdateUI(HLSL::SuperResolutionAttribs& Attribs, FEATURE_FL
     bAttribsChanged |= ImGui::SliderFloat("Sharpness", &Attribs.Sharpening, 0.0f, 1.0f);
     bAttribsChanged |= ImGui::SliderFloat("Resolution Scale", &Attribs.ResolutionScale, 0.5f, 1.0f);
 
+    bool FeatureTemporalUpscaling = (FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) != 0;
+    if (ImGui::Checkbox("Temporal Upscaling", &FeatureTemporalUpscaling))
+        bAttribsChanged = true;
+    ImGui::HelpMarker("Reconstruct the output from the jittered history instead of upscaling the current frame only");
+
+    if (FeatureTemporalUpscaling)
+    {
+        bAttribsChanged |= ImGui::SliderFloat("Temporal Stability Factor", &Attribs.TemporalStabilityFactor, 0.0f, SUPER_RESOLUTION_MAX_TEMPORAL_STABILITY_FACTOR);
+        ImGui::HelpMarker("Controls how much of the accumulated history is kept every frame. Increasing the value increases temporal stability but may introduce ghosting");
+    }
+
+    if (FeatureTemporalUpscaling)
+        FeatureFlags |= FEATURE_FLAG_TEMPORAL_UPSCALING;
+    else
+        FeatureFlags &= ~FEATURE_FLAG_TEMPORAL_UPSCALING;
+
     return bAttribsChanged;
 }
 
@@ -146,6 +212,19 @@ ITextureView* SuperResolution::GetUpsampledTextureSRV() const
     return m_Resources[RESOURCE_IDENTIFIER_CAS].GetTextureSRV();
 }
 
+float2 SuperResolution::GetJitterOffset() const
+{
+    if ((m_FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) == 0 || m_SourceWidth == 0 || m_SourceHeight == 0 || !m_AllPSOsReady)
+        return float2{0.0f, 0.0f};
+
+    const float  UpscalingRatio = static_cast<float>(m_BackBufferWidth) / static_cast<float>(m_SourceWidth);
+    const Uint32 SampleCount    = static_cast<Uint32>(std::ceil(8.0f * UpscalingRatio * UpscalingRatio));
+    const Uint32 SampleIdx      = (m_CurrentFrameIdx % SampleCount) + 1;
+    const float  JitterX        = (HaltonSequence(2u, SampleIdx) - 0.5f) / (0.5f * static_cast<float>(m_SourceWidth));
+    const float  JitterY        = (HaltonSequence(3u, SampleIdx) - 0.5f) / (0.5f * static_cast<float>(m_SourceHeight));
+    return float2{JitterX, JitterY};
+}
+
 SuperResolution::RenderTechnique& SuperResolution::GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags)
 {
     auto Iter = m_RenderTech.find({RenderTech, FeatureFlags});
@@ -163,6 +242,45 @@ bool SuperResolution::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs
     const SHADER_COMPILE_FLAGS ShaderFlags = RenderAttribs.pPostFXContext->GetShaderCompileFlags(m_Settings.EnableAsyncCreation);
     const PSO_CREATE_FLAGS     PSOFlags    = m_Settings.EnableAsyncCreation ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
 
+    const bool TemporalUpscaling = (FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) != 0;
+    if (TemporalUpscaling)
+    {
+        auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_TEMPORAL_UPSAMPLING, FeatureFlags);
+        if (!RenderTech.IsInitializedPSO())
+        {
+            ShaderMacroHelper Macros;
+            Macros.Add("SUPER_RESOLUTION_OPTION_REACTIVE_MASK", (FeatureFlags & FEATURE_FLAG_REACTIVE_MASK) != 0);
+
+            const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
+            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FSR_TemporalUpsampling.fx", "ComputeTemporalUpsamplingPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
+
+            PipelineResourceLayoutDescX ResourceLayout;
+            ResourceLayout
+                .AddVariable(SHADER_TYPE_PIXEL, "cbCameraAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "cbFSRAttribs", SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureCurrColor", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TexturePrevColor", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureMotion", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TextureCurrDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddVariable(SHADER_TYPE_PIXEL, "g_TexturePrevDepth", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+                .AddImmutableSampler(SHADER_TYPE_PIXEL, "g_TexturePrevColor", Sam_LinearClamp);
+
+            if (FeatureFlags & FEATURE_FLAG_REACTIVE_MASK)
+                ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_TextureReactiveMask", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+            RenderTech.InitializePSO(RenderAttribs.pDevice,
+                                     RenderAttribs.pStateCache, "SuperResolution::ComputeTemporalUpsampling",
+                                     VS, PS, ResourceLayout,
+                                     {
+                                         m_Resources[RESOURCE_IDENTIFIER_HISTORY0].AsTexture()->GetDesc().Format,
+                                     },
+                                     TEX_FORMAT_UNKNOWN,
+                                     DSS_DisableDepth, BS_Default, false, PSOFlags);
+        }
+        if (AllPSOsReady && !RenderTech.IsReady())
+            AllPSOsReady = false;
+    }
+    else
     {
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_EDGE_ADAPTIVE_UPSAMPLING, FeatureFlags);
         if (!RenderTech.IsInitializedPSO())
@@ -193,8 +311,11 @@ bool SuperResolution::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs
         auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_CONTRAST_ADAPTIVE_SHARPENING, FeatureFlags);
         if (!RenderTech.IsInitializedPSO())
         {
+            ShaderMacroHelper Macros;
+            Macros.Add("SUPER_RESOLUTION_OPTION_HDR_SOURCE", TemporalUpscaling);
+
             const auto VS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FullScreenTriangleVS.fx", "FullScreenTriangleVS", SHADER_TYPE_VERTEX, {}, ShaderFlags);
-            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FSR_ContrastAdaptiveSharpening.fx", "ComputeContrastAdaptiveSharpeningPS", SHADER_TYPE_PIXEL, {}, ShaderFlags);
+            const auto PS = PostFXRenderTechnique::CreateShader(RenderAttribs.pDevice, RenderAttribs.pStateCache, "FSR_ContrastAdaptiveSharpening.fx", "ComputeContrastAdaptiveSharpeningPS", SHADER_TYPE_PIXEL, Macros, ShaderFlags);
 
             PipelineResourceLayoutDescX ResourceLayout;
             ResourceLayout
@@ -218,10 +339,28 @@ bool SuperResolution::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs
 
 void SuperResolution::UpdateConstantBuffer(const RenderAttributes& RenderAttribs)
 {
-    if (memcmp(RenderAttribs.pFSRAttribs, m_SuperResolutionAttribs.get(), sizeof(HLSL::SuperResolutionAttribs)) != 0)
+    HLSL::SuperResolutionAttribs ShaderAttribs = *RenderAttribs.pFSRAttribs;
+    if (m_FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING)
+    {
+        const float SourceWidth  = static_cast<float>(m_SourceWidth);
+        const float SourceHeight = static_cast<float>(m_SourceHeight);
+        const float OutputWidth  = static_cast<float>(m_BackBufferWidth);
+        const float OutputHeight = static_cast<float>(m_BackBufferHeight);
+
+        ShaderAttribs.SourceSize      = float4{SourceWidth, SourceHeight, 1.0f / SourceWidth, 1.0f / SourceHeight};
+        ShaderAttribs.OutputSize      = float4{OutputWidth, OutputHeight, 1.0f / OutputWidth, 1.0f / OutputHeight};
+        ShaderAttribs.ResolutionScale = SourceWidth / OutputWidth;
+
+        ShaderAttribs.ResetAccumulation =
+            m_LastFrameIdx == ~0u ||                   // No history on the first frame
+            m_CurrentFrameIdx != m_LastFrameIdx + 1 || // Reset history if frames were skipped
+            ShaderAttribs.ResetAccumulation != 0;      // Reset history if requested
+    }
+
+    if (memcmp(&ShaderAttribs, m_SuperResolutionAttribs.get(), sizeof(HLSL::SuperResolutionAttribs)) != 0)
     {
-        memcpy(m_SuperResolutionAttribs.get(), RenderAttribs.pFSRAttribs, sizeof(HLSL::SuperResolutionAttribs));
-        RenderAttribs.pDeviceContext->UpdateBuffer(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER].AsBuffer(), 0, sizeof(HLSL::SuperResolutionAttribs), RenderAttribs.pFSRAttribs, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        memcpy(m_SuperResolutionAttribs.get(), &ShaderAttribs, sizeof(HLSL::SuperResolutionAttribs));
+        RenderAttribs.pDeviceContext->UpdateBuffer(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER].AsBuffer(), 0, sizeof(HLSL::SuperResolutionAttribs), &ShaderAttribs, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     }
 }
 
@@ -248,6 +387,41 @@ void SuperResolution::ComputeEdgeAdaptiveUpsampling(const RenderAttributes& Rend
     RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+void SuperResolution::ComputeTemporalUpsampling(const RenderAttributes& RenderAttribs)
+{
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_TEMPORAL_UPSAMPLING, m_FeatureFlags);
+    if (!RenderTech.IsInitializedSRB())
+    {
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "cbCameraAttribs"}.Set(RenderAttribs.pPostFXContext->GetCameraAttribsCB());
+        ShaderResourceVariableX{RenderTech.PSO, SHADER_TYPE_PIXEL, "cbFSRAttribs"}.Set(m_Resources[RESOURCE_IDENTIFIER_CONSTANT_BUFFER]);
+        RenderTech.InitializeSRB(true);
+    }
+
+    ScopedDebugGroup DebugGroup{RenderAttribs.pDeviceContext, "TemporalUpsampling"};
+
+    const Uint32 CurrBuffIdx = (m_CurrentFrameIdx + 0) & 0x01;
+    const Uint32 PrevBuffIdx = (m_CurrentFrameIdx + 1) & 0x01;
+
+    ITextureView* pRTVs[] = {
+        m_Resources[RESOURCE_IDENTIFIER_HISTORY0 + CurrBuffIdx].GetTextureRTV()};
+
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureCurrColor"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_COLOR].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TexturePrevColor"}.Set(m_Resources[RESOURCE_IDENTIFIER_HISTORY0 + PrevBuffIdx].GetTextureSRV());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureMotion"}.Set(RenderAttribs.pPostFXContext->GetClosestMotionVectors());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureCurrDepth"}.Set(RenderAttribs.pPostFXContext->GetReprojectedDepth());
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TexturePrevDepth"}.Set(RenderAttribs.pPostFXContext->GetPreviousDepth());
+    if (m_FeatureFlags & FEATURE_FLAG_REACTIVE_MASK)
+        ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureReactiveMask"}.Set(m_Resources[RESOURCE_IDENTIFIER_INPUT_REACTIVE_MASK].GetTextureSRV());
+
+    RenderAttribs.pDeviceContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
+    RenderAttribs.pDeviceContext->CommitShaderResources(RenderTech.SRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    RenderAttribs.pDeviceContext->Draw({3, DRAW_FLAG_VERIFY_ALL, 1});
+    RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    m_LastFrameIdx = m_CurrentFrameIdx;
+}
+
 void SuperResolution::ComputeContrastAdaptiveSharpening(const RenderAttributes& RenderAttribs)
 {
     auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_CONTRAST_ADAPTIVE_SHARPENING, m_FeatureFlags);
@@ -262,7 +436,11 @@ void SuperResolution::ComputeContrastAdaptiveSharpening(const RenderAttributes&
     ITextureView* pRTVs[] = {
         m_Resources[RESOURCE_IDENTIFIER_CAS].GetTextureRTV()};
 
-    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureSource"}.Set(m_Resources[RESOURCE_IDENTIFIER_EAU].GetTextureSRV());
+    // The temporal upsampling writes the current history buffer
+    const Uint32 SourceResourceIdx = (m_FeatureFlags & FEATURE_FLAG_TEMPORAL_UPSCALING) ?
+        RESOURCE_IDENTIFIER_HISTORY0 + (m_CurrentFrameIdx & 0x01) :
+        RESOURCE_IDENTIFIER_EAU;
+    ShaderResourceVariableX{RenderTech.SRB, SHADER_TYPE_PIXEL, "g_TextureSource"}.Set(m_Resources[SourceResourceIdx].GetTextureSRV());
 
     RenderAttribs.pDeviceContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     RenderAttribs.pDeviceContext->SetPipelineState(RenderTech.PSO);
@@ -65,7 +65,13 @@ public:
         FEATURE_FLAG_BICUBIC_FILTER = 1u << 2u,
 
         // Use YCoCg color space for color clipping.
-        FEATURE_FLAG_YCOCG_COLOR_SPACE = 1u << 3u
+        FEATURE_FLAG_YCOCG_COLOR_SPACE = 1u << 3u,
+
+        // Accumulate the history at half resolution and upsample it with the depth-aware bilateral
+        // filter (see PostFXContext::BilateralUpsample()). The jitter covers the half-resolution texel,
+        // so the history converges to the average of the pixels that the texel covers.
+        // The flag does not affect the shaders, so it can be toggled at run time without creating new PSOs.
+        FEATURE_FLAG_HALF_RESOLUTION = 1u << 4u
     };
 
     struct RenderAttributes
@@ -114,6 +120,10 @@ public:
 
     static bool UpdateUI(HLSL::TemporalAntiAliasingAttribs& TAAAttribs, FEATURE_FLAGS& FeatureFlags);
 
+    /// Returns the shader resource view of the accumulated frame.
+    ///
+    /// \remarks    With FEATURE_FLAG_HALF_RESOLUTION, the current frame is the full-resolution upsampled
+    ///             history, while the previous frame is the half-resolution history.
     ITextureView* GetAccumulatedFrameSRV(bool IsPrevFrame = false, Uint32 AccumulationBufferIdx = 0) const;
 
 private:
@@ -131,8 +141,12 @@ private:
 
     void ComputeTemporalAccumulation(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff);
 
+    void ComputeBilateralUpsampling(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff);
+
     void ComputePlaceholderTexture(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff);
 
+    RenderTechnique& GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags);
+
 private:
     struct RenderTechniqueKey
     {
@@ -153,7 +167,7 @@ private:
         {
             size_t operator()(const RenderTechniqueKey& Key) const
             {
-                return ComputeHash(Key.FeatureFlags, Key.FeatureFlags);
+                return ComputeHash(Key.RenderTech, Key.FeatureFlags);
             }
         };
     };
@@ -165,11 +179,13 @@ private:
             RESOURCE_ID_CONSTANT_BUFFER,
             RESOURCE_ID_ACCUMULATED_BUFFER0,
             RESOURCE_ID_ACCUMULATED_BUFFER1,
+            RESOURCE_ID_UPSAMPLED_BUFFER,
             RESOURCE_ID_COUNT
         };
 
         ResourceRegistry Resources{RESOURCE_ID_COUNT};
 
+        // Resolution of the accumulation buffers
         Uint32        Width           = 0;
         Uint32        Height          = 0;
         Uint32        CurrentFrameIdx = 0;
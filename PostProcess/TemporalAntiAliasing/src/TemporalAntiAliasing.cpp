@@ -82,12 +82,16 @@ void TemporalAntiAliasing::AccumulationBufferInfo::Prepare(PostFXContext* pPostF
     FeatureFlags    = _FeatureFlags;
     CurrentFrameIdx = _CurrFrameIdx;
 
-    if (Width == _Width && Height == _Height)
+    const bool   HalfResolution     = (FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION) != 0;
+    const Uint32 AccumulationWidth  = HalfResolution ? (_Width + 1) / 2 : _Width;
+    const Uint32 AccumulationHeight = HalfResolution ? (_Height + 1) / 2 : _Height;
+
+    if (Width == AccumulationWidth && Height == AccumulationHeight && static_cast<bool>(Resources[RESOURCE_ID_UPSAMPLED_BUFFER]) == HalfResolution)
         return;
 
     SRB.Release();
-    Width  = _Width;
-    Height = _Height;
+    Width  = AccumulationWidth;
+    Height = AccumulationHeight;
 
     if (!Resources[RESOURCE_ID_CONSTANT_BUFFER])
     {
@@ -117,6 +121,22 @@ void TemporalAntiAliasing::AccumulationBufferInfo::Prepare(PostFXContext* pPostF
         pPostFXContext->ClearRenderTarget(ClearTextureAttribs, pTexture, ClearColor);
         Resources.Insert(TextureIdx, pTexture);
     }
+
+    if (HalfResolution)
+    {
+        TextureDesc Desc;
+        Desc.Name      = "TemporalAntiAliasing::UpsampledBuffer";
+        Desc.Type      = RESOURCE_DIM_TEX_2D;
+        Desc.Width     = _Width;
+        Desc.Height    = _Height;
+        Desc.Format    = TEX_FORMAT_RGBA16_FLOAT;
+        Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+        Resources.Insert(RESOURCE_ID_UPSAMPLED_BUFFER, Device.CreateTexture(Desc));
+    }
+    else
+    {
+        Resources[RESOURCE_ID_UPSAMPLED_BUFFER].Release();
+    }
 }
 
 void TemporalAntiAliasing::AccumulationBufferInfo::UpdateConstantBuffer(IDeviceContext* pDeviceContext, const HLSL::TemporalAntiAliasingAttribs& Attribs)
@@ -156,7 +176,7 @@ void TemporalAntiAliasing::PrepareResources(IRenderDevice*  pDevice,
     m_AllPSOsReady = true;
     for (Uint32 RenderTechIdx = 0; RenderTechIdx < RENDER_TECH_COUNT; RenderTechIdx++)
     {
-        auto Iter = m_RenderTech.find({static_cast<RENDER_TECH>(RenderTechIdx), FeatureFlags});
+        auto Iter = m_RenderTech.find({static_cast<RENDER_TECH>(RenderTechIdx), FeatureFlags & ~FEATURE_FLAG_HALF_RESOLUTION});
         if (Iter == m_RenderTech.end() || !Iter->second.IsReady())
         {
             m_AllPSOsReady = false;
@@ -192,6 +212,8 @@ void TemporalAntiAliasing::Execute(const RenderAttributes& RenderAttribs)
     if (m_AllPSOsReady && RenderAttribs.pPostFXContext->IsPSOsReady())
     {
         ComputeTemporalAccumulation(RenderAttribs, AccBuffer);
+        if (AccBuffer.FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION)
+            ComputeBilateralUpsampling(RenderAttribs, AccBuffer);
     }
     else
     {
@@ -208,8 +230,12 @@ ITextureView* TemporalAntiAliasing::GetAccumulatedFrameSRV(bool IsPrevFrame, Uin
         return nullptr;
     }
 
-    const Uint32 BuffIdx = (Iter->second.CurrentFrameIdx + (IsPrevFrame ? 1 : 0)) & 0x01u;
-    return Iter->second.Resources[AccumulationBufferInfo::RESOURCE_ID_ACCUMULATED_BUFFER0 + BuffIdx].GetTextureSRV();
+    const auto& AccBuffer = Iter->second;
+    if (!IsPrevFrame && (AccBuffer.FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION))
+        return AccBuffer.Resources[AccumulationBufferInfo::RESOURCE_ID_UPSAMPLED_BUFFER].GetTextureSRV();
+
+    const Uint32 BuffIdx = (AccBuffer.CurrentFrameIdx + (IsPrevFrame ? 1 : 0)) & 0x01u;
+    return AccBuffer.Resources[AccumulationBufferInfo::RESOURCE_ID_ACCUMULATED_BUFFER0 + BuffIdx].GetTextureSRV();
 }
 
 void TemporalAntiAliasing::PrepareShadersAndPSO(const RenderAttributes& RenderAttribs, FEATURE_FLAGS FeatureFlags, TEXTURE_FORMAT TextureFormat)
@@ -218,7 +244,7 @@ void TemporalAntiAliasing::PrepareShadersAndPSO(const RenderAttributes& RenderAt
     const SHADER_COMPILE_FLAGS ShaderFlags = RenderAttribs.pPostFXContext->GetShaderCompileFlags(m_Settings.EnableAsyncCreation);
     const PSO_CREATE_FLAGS     PSOFlags    = m_Settings.EnableAsyncCreation ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
 
-    auto& RenderTech = m_RenderTech[{RENDER_TECH_COMPUTE_TEMPORAL_ACCUMULATION, FeatureFlags}];
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_TEMPORAL_ACCUMULATION, FeatureFlags);
     if (!RenderTech.IsInitializedPSO())
     {
         PipelineResourceLayoutDescX ResourceLayout;
@@ -248,11 +274,19 @@ void TemporalAntiAliasing::PrepareShadersAndPSO(const RenderAttributes& RenderAt
                                  TEX_FORMAT_UNKNOWN,
                                  DSS_DisableDepth, BS_Default, false, PSOFlags);
     }
+
+    // The upsampling PSO is created in all modes, so that toggling FEATURE_FLAG_HALF_RESOLUTION does not create PSOs
+    PostFXContext::TextureOperationAttribs UpsamplingAttribs;
+    UpsamplingAttribs.pDevice        = RenderAttribs.pDevice;
+    UpsamplingAttribs.pStateCache    = RenderAttribs.pStateCache;
+    UpsamplingAttribs.pDeviceContext = RenderAttribs.pDeviceContext;
+    if (!RenderAttribs.pPostFXContext->PrepareBilateralUpsampling(UpsamplingAttribs, TextureFormat))
+        m_AllPSOsReady = false;
 }
 
 void TemporalAntiAliasing::ComputeTemporalAccumulation(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff)
 {
-    auto& RenderTech = m_RenderTech[{RENDER_TECH_COMPUTE_TEMPORAL_ACCUMULATION, AccBuff.FeatureFlags}];
+    auto& RenderTech = GetRenderTechnique(RENDER_TECH_COMPUTE_TEMPORAL_ACCUMULATION, AccBuff.FeatureFlags);
     auto& SRB        = AccBuff.SRB;
     if (!SRB)
     {
@@ -280,6 +314,22 @@ void TemporalAntiAliasing::ComputeTemporalAccumulation(const RenderAttributes& R
     RenderAttribs.pDeviceContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 }
 
+void TemporalAntiAliasing::ComputeBilateralUpsampling(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff)
+{
+    const Uint32 BuffIdx = AccBuff.CurrentFrameIdx & 0x01u;
+
+    PostFXContext::TextureOperationAttribs UpsamplingAttribs;
+    UpsamplingAttribs.pDevice        = RenderAttribs.pDevice;
+    UpsamplingAttribs.pDeviceContext = RenderAttribs.pDeviceContext;
+    UpsamplingAttribs.pStateCache    = RenderAttribs.pStateCache;
+
+    // The reprojected depth is computed for the pixels of the current frame, so it can guide the upsampling
+    RenderAttribs.pPostFXContext->BilateralUpsample(UpsamplingAttribs,
+                                                    AccBuff.Resources[AccumulationBufferInfo::RESOURCE_ID_ACCUMULATED_BUFFER0 + BuffIdx].GetTextureSRV(),
+                                                    RenderAttribs.pPostFXContext->GetReprojectedDepth(),
+                                                    AccBuff.Resources[AccumulationBufferInfo::RESOURCE_ID_UPSAMPLED_BUFFER].GetTextureRTV());
+}
+
 void TemporalAntiAliasing::ComputePlaceholderTexture(const RenderAttributes& RenderAttribs, AccumulationBufferInfo& AccBuff)
 {
     const Uint32 BuffIdx = AccBuff.CurrentFrameIdx & 0x01u;
@@ -289,6 +339,21 @@ void TemporalAntiAliasing::ComputePlaceholderTexture(const RenderAttributes& Ren
     CopyTextureAttribs.pDeviceContext = RenderAttribs.pDeviceContext;
     CopyTextureAttribs.pStateCache    = RenderAttribs.pStateCache;
     RenderAttribs.pPostFXContext->CopyTextureColor(CopyTextureAttribs, RenderAttribs.pColorBufferSRV, AccBuff.Resources[AccumulationBufferInfo::RESOURCE_ID_ACCUMULATED_BUFFER0 + BuffIdx].GetTextureRTV());
+    if (AccBuff.FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION)
+        RenderAttribs.pPostFXContext->CopyTextureColor(CopyTextureAttribs, RenderAttribs.pColorBufferSRV, AccBuff.Resources[AccumulationBufferInfo::RESOURCE_ID_UPSAMPLED_BUFFER].GetTextureRTV());
+}
+
+TemporalAntiAliasing::RenderTechnique& TemporalAntiAliasing::GetRenderTechnique(RENDER_TECH RenderTech, FEATURE_FLAGS FeatureFlags)
+{
+    // The resolution of the accumulation buffers does not affect the shaders, so all modes share the same PSOs
+    FeatureFlags &= ~FEATURE_FLAG_HALF_RESOLUTION;
+
+    auto Iter = m_RenderTech.find({RenderTech, FeatureFlags});
+    if (Iter != m_RenderTech.end())
+        return Iter->second;
+
+    auto Condition = m_RenderTech.emplace(RenderTechniqueKey{RenderTech, FeatureFlags}, RenderTechnique{});
+    return Condition.first->second;
 }
 
 bool TemporalAntiAliasing::UpdateUI(HLSL::TemporalAntiAliasingAttribs& TAAAttribs, FEATURE_FLAGS& FeatureFlags)
@@ -296,6 +361,7 @@ bool TemporalAntiAliasing::UpdateUI(HLSL::TemporalAntiAliasingAttribs& TAAAttrib
     bool FeatureBicubicFiltering = FeatureFlags & FEATURE_FLAG_BICUBIC_FILTER;
     bool FeatureGaussWeighting   = FeatureFlags & FEATURE_FLAG_GAUSSIAN_WEIGHTING;
     bool FeatureYCoCgColorSpace  = FeatureFlags & FEATURE_FLAG_YCOCG_COLOR_SPACE;
+    bool FeatureHalfResolution   = FeatureFlags & FEATURE_FLAG_HALF_RESOLUTION;
 
     bool AttribsChanged = false;
 
@@ -316,6 +382,10 @@ bool TemporalAntiAliasing::UpdateUI(HLSL::TemporalAntiAliasingAttribs& TAAAttrib
 
     ImGui::HelpMarker("Use YCoCg color space for color clipping.");
 
+    if (ImGui::Checkbox("Half Resolution", &FeatureHalfResolution))
+        AttribsChanged = true;
+    ImGui::HelpMarker("Accumulate the history at half resolution and upsample it with the depth-aware bilateral filter");
+
     auto ResetStateFeatureMask = [](FEATURE_FLAGS& FeatureFlags, FEATURE_FLAGS Flag, bool State) {
         if (State)
             FeatureFlags |= Flag;
@@ -326,6 +396,7 @@ bool TemporalAntiAliasing::UpdateUI(HLSL::TemporalAntiAliasingAttribs& TAAAttrib
     ResetStateFeatureMask(FeatureFlags, FEATURE_FLAG_BICUBIC_FILTER, FeatureBicubicFiltering);
     ResetStateFeatureMask(FeatureFlags, FEATURE_FLAG_GAUSSIAN_WEIGHTING, FeatureGaussWeighting);
     ResetStateFeatureMask(FeatureFlags, FEATURE_FLAG_YCOCG_COLOR_SPACE, FeatureYCoCgColorSpace);
+    ResetStateFeatureMask(FeatureFlags, FEATURE_FLAG_HALF_RESOLUTION, FeatureHalfResolution);
 
     return AttribsChanged;
 }
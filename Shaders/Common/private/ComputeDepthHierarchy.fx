@@ -0,0 +1,167 @@
+#include "FullScreenTriangleVSOutput.fxh"
+#include "PostFX_Common.fxh"
+
+// Every mip level of the depth hierarchy stores the closest (x) and
+// the farthest (y) depth of the corresponding region of the depth buffer.
+#if POSTFX_OPTION_INVERTED_DEPTH
+    #define ClosestDepth  max
+    #define FarthestDepth min
+#else
+    #define ClosestDepth  min
+    #define FarthestDepth max
+#endif // POSTFX_OPTION_INVERTED_DEPTH
+
+float2 CombineDepth(float2 Depth0, float2 Depth1)
+{
+    return float2(ClosestDepth(Depth0.x, Depth1.x), FarthestDepth(Depth0.y, Depth1.y));
+}
+
+#if DEPTH_HIERARCHY_COMPUTE
+
+cbuffer cbDepthHierarchyAttribs
+{
+    uint4 g_DepthHierarchyAttribs; // x - the number of mip levels computed by the dispatch
+}
+
+// The first dispatch reads the depth buffer and also writes it to the first mip level.
+// Every next dispatch reads the last mip level computed by the previous one.
+#if DEPTH_HIERARCHY_FIRST_MIP
+Texture2D<float> g_TextureDepth;
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip0;
+#else
+Texture2D<float2> g_TextureLastMip;
+#endif
+
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip1;
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip2;
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip3;
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip4;
+RWTexture2D<float2 /*format = rg32f*/> g_HierarchyMip5;
+
+#define SPD_VALUE_TYPE float2
+
+float2 SPDLoadSource(int2 Location)
+{
+#if DEPTH_HIERARCHY_FIRST_MIP
+    float Depth = g_TextureDepth.Load(int3(Location, 0));
+    return float2(Depth, Depth);
+#else
+    return g_TextureLastMip.Load(int3(Location, 0));
+#endif
+}
+
+float2 SPDReduce(float2 Depth0, float2 Depth1)
+{
+    return CombineDepth(Depth0, Depth1);
+}
+
+void SPDStore(uint Level, int2 Location, float2 Depth)
+{
+#if DEPTH_HIERARCHY_FIRST_MIP
+    if (Level == 0u)
+        g_HierarchyMip0[Location] = Depth;
+#endif
+    if (Level == 1u)
+        g_HierarchyMip1[Location] = Depth;
+    else if (Level == 2u)
+        g_HierarchyMip2[Location] = Depth;
+    else if (Level == 3u)
+        g_HierarchyMip3[Location] = Depth;
+    else if (Level == 4u)
+        g_HierarchyMip4[Location] = Depth;
+    else if (Level == 5u)
+        g_HierarchyMip5[Location] = Depth;
+}
+
+#include "SinglePassDownsampler.fxh"
+
+[numthreads(SPD_GROUP_SIZE, SPD_GROUP_SIZE, 1)]
+void ComputeDepthHierarchyCS(uint3 GroupId : SV_GroupID, uint3 GroupThreadId : SV_GroupThreadID)
+{
+    int2 SourceSize;
+#if DEPTH_HIERARCHY_FIRST_MIP
+    g_TextureDepth.GetDimensions(SourceSize.x, SourceSize.y);
+#else
+    g_TextureLastMip.GetDimensions(SourceSize.x, SourceSize.y);
+#endif
+
+    SPDDownsample(int2(GroupId.xy), int2(GroupThreadId.xy), SourceSize, g_DepthHierarchyAttribs.x, DEPTH_HIERARCHY_FIRST_MIP != 0);
+}
+
+#elif DEPTH_HIERARCHY_FIRST_MIP
+
+Texture2D<float> g_TextureDepth;
+
+float2 ComputeDepthHierarchyPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    float Depth = g_TextureDepth.Load(int3(int2(VSOut.f4PixelPos.xy), 0));
+    return float2(Depth, Depth);
+}
+
+#else
+
+#if SUPPORTED_SHADER_SRV
+Texture2D<float2> g_TextureLastMip;
+#else
+Texture2D<float2> g_TextureMips;
+SamplerState      g_TextureMips_sampler;
+#endif
+
+float2 SampleDepth(int2 Location, int2 Offset, int3 Dimension)
+{
+    int2 Position = ClampScreenCoord(Location + Offset, Dimension.xy);
+#if SUPPORTED_SHADER_SRV
+    return g_TextureLastMip.Load(int3(Position, 0));
+#else
+    return g_TextureMips.Load(int3(Position, Dimension.z));
+#endif
+}
+
+float2 ComputeDepthHierarchyPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    int3 LastMipDimension;
+#if SUPPORTED_SHADER_SRV
+    g_TextureLastMip.GetDimensions(LastMipDimension.x, LastMipDimension.y);
+    LastMipDimension.z = 0;
+#else
+    int Dummy;
+    g_TextureMips.GetDimensions(0, LastMipDimension.x, LastMipDimension.y, Dummy);
+    LastMipDimension.x = int(floor(float(LastMipDimension.x) / exp2(float(VSOut.uInstID))));
+    LastMipDimension.y = int(floor(float(LastMipDimension.y) / exp2(float(VSOut.uInstID))));
+    LastMipDimension.z = int(VSOut.uInstID);
+#endif
+
+    int2 RemappedPosition = int2(2.0 * floor(VSOut.f4PixelPos.xy));
+
+    float2 Depth = CombineDepth(CombineDepth(SampleDepth(RemappedPosition, int2(0, 0), LastMipDimension),
+                                             SampleDepth(RemappedPosition, int2(0, 1), LastMipDimension)),
+                                CombineDepth(SampleDepth(RemappedPosition, int2(1, 0), LastMipDimension),
+                                             SampleDepth(RemappedPosition, int2(1, 1), LastMipDimension)));
+
+    // When the previous mip level has odd dimensions, its last texel in the row or column is not
+    // covered by any 2x2 footprint and is added to the last texel in the row or column of this level.
+    // The remapped position is even, so the conditions below only hold for odd dimensions.
+    bool IsLastColumnOfOddWidth = RemappedPosition.x + 3 == LastMipDimension.x;
+    bool IsLastRowOfOddHeight   = RemappedPosition.y + 3 == LastMipDimension.y;
+
+    if (IsLastColumnOfOddWidth)
+    {
+        Depth = CombineDepth(Depth, SampleDepth(RemappedPosition, int2(2, 0), LastMipDimension));
+        Depth = CombineDepth(Depth, SampleDepth(RemappedPosition, int2(2, 1), LastMipDimension));
+    }
+
+    if (IsLastRowOfOddHeight)
+    {
+        Depth = CombineDepth(Depth, SampleDepth(RemappedPosition, int2(0, 2), LastMipDimension));
+        Depth = CombineDepth(Depth, SampleDepth(RemappedPosition, int2(1, 2), LastMipDimension));
+    }
+
+    if (IsLastColumnOfOddWidth && IsLastRowOfOddHeight)
+    {
+        Depth = CombineDepth(Depth, SampleDepth(RemappedPosition, int2(2, 2), LastMipDimension));
+    }
+
+    return Depth;
+}
+
+#endif // DEPTH_HIERARCHY_COMPUTE
@@ -2,6 +2,12 @@
 #include "FullScreenTriangleVSOutput.fxh"
 #include "PostFX_Common.fxh"
 
+#if POSTFX_OPTION_INVERTED_DEPTH
+    #define DepthFarPlane  0.0
+#else
+    #define DepthFarPlane  1.0
+#endif // POSTFX_OPTION_INVERTED_DEPTH
+
 cbuffer cbCameraAttribs
 {
     CameraAttribs g_CurrCamera;
@@ -20,6 +26,11 @@ float ComputeReprojectedDepthPS(in FullScreenTriangleVSOutput VSOut) : SV_Target
     float4 Position = VSOut.f4PixelPos;
     float Depth = SampleDepth(int2(Position.xy));
 
+    // With reversed depth, the far plane is often at infinity and background pixels
+    // can't be unprojected. They stay at the far plane in the previous frame.
+    if (Depth == DepthFarPlane)
+        return DepthFarPlane;
+
     float3 CurrScreenCoord = float3(Position.xy * g_CurrCamera.f4ViewportSize.zw, Depth);
     CurrScreenCoord.xy += F3NDC_XYZ_TO_UVD_SCALE.xy * g_CurrCamera.f2Jitter;
 
@@ -36,11 +36,12 @@ float3 Prefilter(float3 Color)
 
 float3 ComputePrefilteredTexturePS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
 {
-    float2 TextureResolution;
-    g_TextureInput.GetDimensions(TextureResolution.x, TextureResolution.y);
-
-    float2 TexelSize = rcp(TextureResolution);
     float2 CenterTexcoord = NormalizedDeviceXYToTexUV(VSOut.f2NormalizedXY.xy);
+
+    // The offsets are measured in halves of the output texel. This is one input texel when the output
+    // is at half resolution and two input texels when it is at quarter resolution, so the filter
+    // footprint always covers the output texel regardless of the bloom resolution mode.
+    float2 TexelSize = 0.5 * abs(float2(ddx(CenterTexcoord.x), ddy(CenterTexcoord.y)));
    
     float3 A = SampleColor(CenterTexcoord, TexelSize * float2(-2.0, +2.0));
     float3 B = SampleColor(CenterTexcoord, TexelSize * float2(+0.0, +2.0));
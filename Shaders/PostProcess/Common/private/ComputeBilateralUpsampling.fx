@@ -0,0 +1,58 @@
+#include "BasicStructures.fxh"
+#include "FullScreenTriangleVSOutput.fxh"
+#include "PostFX_Common.fxh"
+#include "BilateralUpsampling.fxh"
+
+cbuffer cbCameraAttribs
+{
+    CameraAttribs g_CurrCamera;
+    CameraAttribs g_PrevCamera;
+}
+
+Texture2D<float4> g_TextureSource;
+Texture2D<float>  g_TextureDepth;
+
+float4 SampleSource(int2 Location)
+{
+    return g_TextureSource.Load(int3(Location, 0));
+}
+
+float SampleLinearDepth(int2 PixelCoord)
+{
+    return DepthToCameraZ(g_TextureDepth.Load(int3(PixelCoord, 0)), g_CurrCamera.mProj);
+}
+
+float4 ComputeBilateralUpsamplingPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    uint2 SourceDimension;
+    g_TextureSource.GetDimensions(SourceDimension.x, SourceDimension.y);
+
+    int2   Dimension       = int2(g_CurrCamera.f4ViewportSize.xy);
+    float2 ResolutionScale = g_CurrCamera.f4ViewportSize.xy / float2(SourceDimension);
+
+    float2 Position    = VSOut.f4PixelPos.xy;
+    float  CenterDepth = SampleLinearDepth(int2(Position));
+
+    int2   Location;
+    float4 BilinearWeights = GetBilateralUpsamplingFootprint(Position, ResolutionScale, Location);
+
+    float4 ResultSum = float4(0.0, 0.0, 0.0, 0.0);
+    float  WeightSum = 0.0;
+    for (int SampleIdx = 0; SampleIdx < 4; SampleIdx++)
+    {
+        int2 SampleLocation = ClampScreenCoord(Location + int2(SampleIdx & 0x01, SampleIdx >> 1), int2(SourceDimension));
+        int2 GuideLocation  = ClampScreenCoord(GetBilateralUpsamplingSourcePixel(SampleLocation, ResolutionScale), Dimension);
+
+        float WeightZ = ComputeBilateralDepthWeight(CenterDepth, SampleLinearDepth(GuideLocation), BILATERAL_UPSAMPLING_DEPTH_SIGMA);
+        float Weight  = BilinearWeights[SampleIdx] * WeightZ;
+
+        ResultSum += Weight * SampleSource(SampleLocation);
+        WeightSum += Weight;
+    }
+
+    // None of the texels belongs to the surface of the pixel (or the pixel is at infinity)
+    if (!(WeightSum > 1e-6))
+        return SampleSource(ClampScreenCoord(int2(Position / ResolutionScale), int2(SourceDimension)));
+
+    return ResultSum / WeightSum;
+}
@@ -18,6 +18,8 @@ Texture2D<float3> g_TextureRadiance;
 Texture2D<float4> g_TextureColorCoCNear;
 Texture2D<float4> g_TextureColorCoCFar;
 Texture2D<float2> g_TextureBokehKernel;
+Texture2D<float2> g_TextureBokehSmallKernel;
+Texture2D<float2> g_TextureTileCoC;
 
 SamplerState g_TextureRadiance_sampler;
 SamplerState g_TextureColorCoCNear_sampler;
@@ -44,24 +46,45 @@ float3 SampleRadiance(float2 Texcoord, float2 Offset)
     return g_TextureRadiance.SampleLevel(g_TextureRadiance_sampler, Texcoord + Offset, 0.0);
 }
 
+float2 LoadKernelSample(int SampleIdx, bool UseSmallKernel)
+{
+    if (UseSmallKernel)
+        return g_TextureBokehSmallKernel.Load(int3(SampleIdx, 0, 0));
+    else
+        return g_TextureBokehKernel.Load(int3(SampleIdx, 0, 0));
+}
+
 PSOutput ComputeBokehPS(in FullScreenTriangleVSOutput VSOut) 
 {
     float2 CenterTexcoord = NormalizedDeviceXYToTexUV(VSOut.f2NormalizedXY.xy);
-    float CoCNear = g_TextureColorCoCNear.SampleLevel(g_TextureColorCoCNear_sampler, CenterTexcoord, 0.0).a;
-    float CoCFar  = g_TextureColorCoCFar.SampleLevel(g_TextureColorCoCFar_sampler, CenterTexcoord, 0.0).a;
+    float4 CenterNear = g_TextureColorCoCNear.SampleLevel(g_TextureColorCoCNear_sampler, CenterTexcoord, 0.0);
+    float4 CenterFar  = g_TextureColorCoCFar.SampleLevel(g_TextureColorCoCFar_sampler, CenterTexcoord, 0.0);
+    float2 TileCoC    = g_TextureTileCoC.Load(int3(int2(VSOut.f4PixelPos.xy) / DOF_TILE_SIZE, 0));
+
+    float CoCNear = CenterNear.a;
+    float CoCFar  = CenterFar.a;
 
     float4 ForegroundColor = float4(0.0, 0.0, 0.0, 0.0);
 	float4 BackgroundColor = float4(0.0, 0.0, 0.0, 0.0);
 
     float AspectRatio = g_Camera.f4ViewportSize.x * g_Camera.f4ViewportSize.w;
-    int SampleCount = ComputeSampleCount(g_DOFAttribs.BokehKernelRingCount, g_DOFAttribs.BokehKernelRingDensity);
+    int LargeSampleCount = ComputeSampleCount(g_DOFAttribs.BokehKernelRingCount, g_DOFAttribs.BokehKernelRingDensity);
+    int SmallSampleCount = ComputeSampleCount(DOF_BOKEH_KERNEL_SMALL_RING_COUNT, DOF_BOKEH_KERNEL_SMALL_RING_DENSITY);
 
+    // The tile CoC is the same for all pixels of the tile, so the branches below are coherent
     [branch]
-    if (CoCNear > 0.0)
+    if (CoCNear > 0.0 && TileCoC.x < DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION)
     {
+        // The tile is not blended with the bokeh in the combine pass
+        ForegroundColor = float4(CenterNear.rgb, 1.0);
+    }
+    else if (CoCNear > 0.0)
+    {
+        bool UseSmallKernel = TileCoC.x < DOF_TILE_SMALL_CIRCLE_OF_CONFUSION;
+        int  SampleCount    = UseSmallKernel ? SmallSampleCount : LargeSampleCount;
         for (int SampleIdx = 0; SampleIdx < SampleCount; SampleIdx++)
         {
-            float2 KernelSample = g_TextureBokehKernel.Load(int3(SampleIdx, 0, 0));
+            float2 KernelSample = LoadKernelSample(SampleIdx, UseSmallKernel);
 
             float2 SamplePosition = 0.5 * KernelSample * CoCNear * g_DOFAttribs.MaxCircleOfConfusion;
             float2 SampleTexcoord = float2(SamplePosition.x, AspectRatio * SamplePosition.y);
@@ -77,11 +100,18 @@ PSOutput ComputeBokehPS(in FullScreenTriangleVSOutput VSOut)
     }
 
     [branch]
-    if (CoCFar > 0.0)
+    if (CoCFar > 0.0 && TileCoC.y < DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION)
+    {
+        // The tile is not blended with the bokeh in the combine pass
+        BackgroundColor = float4(CenterFar.rgb, 1.0);
+    }
+    else if (CoCFar > 0.0)
     {
+        bool UseSmallKernel = TileCoC.y < DOF_TILE_SMALL_CIRCLE_OF_CONFUSION;
+        int  SampleCount    = UseSmallKernel ? SmallSampleCount : LargeSampleCount;
         for (int SampleIdx = 0; SampleIdx < SampleCount; SampleIdx++)
         {
-            float2 KernelSample = g_TextureBokehKernel.Load(int3(SampleIdx, 0, 0));
+            float2 KernelSample = LoadKernelSample(SampleIdx, UseSmallKernel);
 
             float2 SamplePosition = 0.5 * KernelSample * CoCFar * g_DOFAttribs.MaxCircleOfConfusion;
             float2 SampleTexcoord = float2(SamplePosition.x, AspectRatio * SamplePosition.y);
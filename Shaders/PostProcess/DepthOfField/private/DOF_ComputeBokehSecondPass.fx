@@ -17,6 +17,7 @@ cbuffer cbDepthOfFieldAttribs
 Texture2D<float4> g_TextureColorCoCNear;
 Texture2D<float4> g_TextureColorCoCFar;
 Texture2D<float2> g_TextureBokehKernel;
+Texture2D<float2> g_TextureTileCoC;
 
 SamplerState g_TextureColorCoCNear_sampler;
 SamplerState g_TextureColorCoCFar_sampler;
@@ -44,6 +45,8 @@ PSOutput ComputeBokehPS(in FullScreenTriangleVSOutput VSOut)
     float4 ForegroundColor = g_TextureColorCoCNear.SampleLevel(g_TextureColorCoCNear_sampler, CenterTexcoord, 0.0);
     float4 BackgroundColor = g_TextureColorCoCFar.SampleLevel(g_TextureColorCoCFar_sampler, CenterTexcoord, 0.0);
 
+    float2 TileCoC = g_TextureTileCoC.Load(int3(int2(VSOut.f4PixelPos.xy) / DOF_TILE_SIZE, 0));
+
     float CoCNear = ForegroundColor.a;
     float CoCFar = BackgroundColor.a;
 
@@ -51,7 +54,7 @@ PSOutput ComputeBokehPS(in FullScreenTriangleVSOutput VSOut)
     int SampleCount = ComputeSampleCount(DOF_BOKEH_KERNEL_SMALL_RING_COUNT, DOF_BOKEH_KERNEL_SMALL_RING_DENSITY);
 
     [branch]
-    if (CoCNear > 0.0)
+    if (CoCNear > 0.0 && TileCoC.x >= DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION)
     {
         for (int SampleIdx = 0; SampleIdx < SampleCount; SampleIdx++)
         {
@@ -65,7 +68,7 @@ PSOutput ComputeBokehPS(in FullScreenTriangleVSOutput VSOut)
     }
 
     [branch]
-    if (CoCFar > 0.0)
+    if (CoCFar > 0.0 && TileCoC.y >= DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION)
     {
         for (int SampleIdx = 0; SampleIdx < SampleCount; SampleIdx++)
         {
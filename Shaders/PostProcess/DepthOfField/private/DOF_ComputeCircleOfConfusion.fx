@@ -31,8 +31,9 @@ float ComputeCircleOfConfusionPS(in FullScreenTriangleVSOutput VSOut) : SV_Targe
     // Lens Coefficient f * f / (N * (F - f))
     float K = f * f / (g_Camera.fFStop * (g_Camera.fFocusDistance - f));
 
-    // Circle of Confusion K * (x - F) / x in millimeters
-    float CoC = K * (LinearDepth - g_Camera.fFocusDistance) / max(LinearDepth, 1e-4);
+    // Circle of Confusion K * (x - F) / x in millimeters.
+    // Written as K * (1 - F / x) to remain finite when the far plane is at infinity (reversed depth).
+    float CoC = K * (1.0 - g_Camera.fFocusDistance / max(LinearDepth, 1e-4));
 
     // The blur disc size for the pixel at relative texture coordinate. Near Plane: < 0.0; Focus Plane: 0; Far Plane: > 0.0; Range: [-1.0, 1,0]
     return clamp(1000.0 * CoC / (g_Camera.fSensorWidth * g_DOFAttribs.MaxCircleOfConfusion), -1.0, 1.0);
@@ -40,7 +40,7 @@ float3 ComputeCombinedTexturePS(in FullScreenTriangleVSOutput VSOut) : SV_Target
     float4 DoFFar  = SampleDoFFarPlane(Texcoord);
 
     float3 Result = SourceFullRes;
-    Result.rgb = lerp(Result, DoFFar.rgb, smoothstep(0.1, 1.0, DoFFar.a));
-    Result.rgb = lerp(Result.rgb, DoFNear.rgb, smoothstep(0.1, 1.0, DoFNear.a));
+    Result.rgb = lerp(Result, DoFFar.rgb, smoothstep(DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION, 1.0, DoFFar.a));
+    Result.rgb = lerp(Result.rgb, DoFNear.rgb, smoothstep(DOF_MIN_VISIBLE_CIRCLE_OF_CONFUSION, 1.0, DoFNear.a));
     return lerp(SourceFullRes, Result, g_DOFAttribs.AlphaInterpolation);
 }
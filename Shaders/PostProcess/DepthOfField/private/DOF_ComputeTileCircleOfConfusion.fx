@@ -0,0 +1,30 @@
+#include "FullScreenTriangleVSOutput.fxh"
+#include "DepthOfFieldStructures.fxh"
+
+Texture2D<float4> g_TextureColorCoCNear;
+Texture2D<float4> g_TextureColorCoCFar;
+
+// Computes the maximum near and far CoC of the prefiltered pixels in the tile.
+// The bokeh passes use it to skip the gathering in the tiles that are in focus
+// and to use the small kernel in the tiles with a small CoC.
+float2 ComputeTileCoCPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    int2 TextureDimension;
+    g_TextureColorCoCNear.GetDimensions(TextureDimension.x, TextureDimension.y);
+
+    int2 TileOrigin = int2(VSOut.f4PixelPos.xy) * DOF_TILE_SIZE;
+    int2 TileEnd    = min(TileOrigin + int2(DOF_TILE_SIZE, DOF_TILE_SIZE), TextureDimension);
+
+    float2 MaxCoC = float2(0.0, 0.0);
+    for (int y = TileOrigin.y; y < TileEnd.y; y++)
+    {
+        for (int x = TileOrigin.x; x < TileEnd.x; x++)
+        {
+            float CoCNear = g_TextureColorCoCNear.Load(int3(x, y, 0)).a;
+            float CoCFar  = g_TextureColorCoCFar.Load(int3(x, y, 0)).a;
+            MaxCoC = max(MaxCoC, float2(CoCNear, CoCFar));
+        }
+    }
+
+    return MaxCoC;
+}
@@ -4,6 +4,7 @@
 
 #include "BasicStructures.fxh"
 #include "AtmosphereShadersCommon.fxh"
+#include "BilateralUpsampling.fxh"
 
 cbuffer cbParticipatingMediaScatteringParams
 {
@@ -42,6 +43,11 @@ SamplerState      g_tex2DColorBuffer_sampler; // Point clamp
 
 Texture2D<float>  g_tex2DAverageLuminance;
 
+// Inscattering (rgb) and camera-space z (a) unwarped at half resolution.
+// Negative z marks texels for which no interpolation sources were found.
+Texture2D<float4> g_tex2DHalfResInscattering;
+Texture2D<float3> g_tex2DHalfResExtinction;
+
 #if EXTINCTION_EVAL_MODE == EXTINCTION_EVAL_MODE_EPIPOLAR
     Texture2D<float3> g_tex2DEpipolarExtinction;
     SamplerState      g_tex2DEpipolarExtinction_sampler; // Linear clamp
@@ -50,10 +56,11 @@ Texture2D<float>  g_tex2DAverageLuminance;
 #include "Extinction.fxh"
 #include "ToneMapping.fxh"
 
-void UnwarpEpipolarInsctrImage( in float2 f2PosPS, 
-                                in float fCamSpaceZ,
-                                out float3 f3Inscattering,
-                                out float3 f3Extinction )
+// Returns the total weight of the interpolation sources
+float UnwarpEpipolarInsctrImage( in float2 f2PosPS, 
+                                 in float fCamSpaceZ,
+                                 out float3 f3Inscattering,
+                                 out float3 f3Extinction )
 {
     // Compute direction of the ray going from the light through the pixel
     float2 f2RayDir = normalize( f2PosPS - g_PPAttribs.f4LightScreenPos.xy );
@@ -264,24 +271,13 @@ void UnwarpEpipolarInsctrImage( in float2 f2PosPS,
     
     f3Inscattering /= fTotalWeight;
     f3Extinction /= fTotalWeight;
-}
-
 
-void ApplyInscatteredRadiancePS(FullScreenTriangleVSOutput VSOut,
-                                // IMPORTANT: non-system generated pixel shader input
-                                // arguments must have the exact same name as vertex shader 
-                                // outputs and must go in the same order.
-                                // Moreover, even if the shader is not using the argument,
-                                // it still must be declared.
+    return fTotalWeight;
+}
 
-                                out float4 f4Color : SV_Target)
+float4 ApplyInscatteredRadiance(float2 f2PosPS, float2 f2UV, float fCamSpaceZ, float3 f3Inscttering, float3 f3Extinction)
 {
-    float2 f2UV = NormalizedDeviceXYToTexUV(VSOut.f2NormalizedXY);
-    float fCamSpaceZ = g_tex2DCamSpaceZ.SampleLevel(g_tex2DCamSpaceZ_sampler, f2UV, 0);
-    
-    float3 f3Inscttering, f3Extinction;
-    UnwarpEpipolarInsctrImage(VSOut.f2NormalizedXY, fCamSpaceZ, f3Inscttering, f3Extinction);
-
+    float4 f4Color;
     float3 f3BackgroundColor = float3(0.0, 0.0, 0.0);
     [branch]
     if( !g_PPAttribs.bShowLightingOnly )
@@ -291,7 +287,7 @@ void ApplyInscatteredRadiancePS(FullScreenTriangleVSOutput VSOut,
         f3BackgroundColor *= (fCamSpaceZ > g_CameraAttribs.fFarPlaneZ) ? g_LightAttribs.f4Intensity.rgb : float3(1.0, 1.0, 1.0);
 
 #if EXTINCTION_EVAL_MODE == EXTINCTION_EVAL_MODE_PER_PIXEL
-        float3 f3ReconstructedPosWS = ProjSpaceXYZToWorldSpace(float3(VSOut.f2NormalizedXY.xy, fCamSpaceZ), g_CameraAttribs.mProj, g_CameraAttribs.mViewProjInv);
+        float3 f3ReconstructedPosWS = ProjSpaceXYZToWorldSpace(float3(f2PosPS, fCamSpaceZ), g_CameraAttribs.mProj, g_CameraAttribs.mViewProjInv);
         f3Extinction = GetExtinction(g_CameraAttribs.f4Position.xyz, f3ReconstructedPosWS, g_PPAttribs.f4EarthCenter.xyz,
                                      g_MediaParams.fAtmBottomRadius, g_MediaParams.fAtmTopRadius, g_MediaParams.f4ParticleScaleHeight);
 #endif
@@ -307,4 +303,100 @@ void ApplyInscatteredRadiancePS(FullScreenTriangleVSOutput VSOut,
     f4Color.rgb = float3(LogLum_W.x, LogLum_W.y, 0.0);
 #endif
     f4Color.a = 1.0;
+    return f4Color;
+}
+
+void ApplyInscatteredRadiancePS(FullScreenTriangleVSOutput VSOut,
+                                // IMPORTANT: non-system generated pixel shader input
+                                // arguments must have the exact same name as vertex shader 
+                                // outputs and must go in the same order.
+                                // Moreover, even if the shader is not using the argument,
+                                // it still must be declared.
+
+                                out float4 f4Color : SV_Target)
+{
+    float2 f2UV = NormalizedDeviceXYToTexUV(VSOut.f2NormalizedXY);
+    float fCamSpaceZ = g_tex2DCamSpaceZ.SampleLevel(g_tex2DCamSpaceZ_sampler, f2UV, 0);
+    
+    float3 f3Inscttering, f3Extinction;
+    UnwarpEpipolarInsctrImage(VSOut.f2NormalizedXY, fCamSpaceZ, f3Inscttering, f3Extinction);
+
+    f4Color = ApplyInscatteredRadiance(VSOut.f2NormalizedXY, f2UV, fCamSpaceZ, f3Inscttering, f3Extinction);
+}
+
+// Unwarps inscattering into half-resolution targets. Every texel is evaluated at the full-resolution
+// pixel that the bilateral upsampling uses as the guide (see BilateralUpsampling.fxh).
+// Must be compiled with CORRECT_INSCATTERING_AT_DEPTH_BREAKS == 0.
+void UnwarpHalfResInscatteringPS(FullScreenTriangleVSOutput VSOut,
+                                 out float4 f4Inscattering : SV_Target0,
+                                 out float4 f4Extinction   : SV_Target1)
+{
+    float2 f2HalfResDim = floor((g_PPAttribs.f4ScreenResolution.xy + 1.0) * 0.5);
+    float2 f2ResolutionScale = g_PPAttribs.f4ScreenResolution.xy / f2HalfResDim;
+
+    int2 i2SrcPixel = GetBilateralUpsamplingSourcePixel(int2(VSOut.f4PixelPos.xy), f2ResolutionScale);
+    i2SrcPixel = min(i2SrcPixel, int2(g_PPAttribs.f4ScreenResolution.xy) - 1);
+
+    float2 f2UV = (float2(i2SrcPixel) + 0.5) * g_PPAttribs.f4ScreenResolution.zw;
+    float fCamSpaceZ = g_tex2DCamSpaceZ.Load(int3(i2SrcPixel, 0));
+
+    float3 f3Inscttering, f3Extinction;
+    float fTotalWeight = UnwarpEpipolarInsctrImage(TexUVToNormalizedDeviceXY(f2UV), fCamSpaceZ, f3Inscttering, f3Extinction);
+    if (fTotalWeight < 1e-2)
+    {
+        f4Inscattering = float4(0.0, 0.0, 0.0, -1.0);
+        f4Extinction   = float4(1.0, 1.0, 1.0, 0.0);
+    }
+    else
+    {
+        f4Inscattering = float4(f3Inscttering, fCamSpaceZ);
+        f4Extinction   = float4(f3Extinction, 0.0);
+    }
+}
+
+void ApplyHalfResInscatteredRadiancePS(FullScreenTriangleVSOutput VSOut,
+                                       out float4 f4Color : SV_Target)
+{
+    float2 f2UV = NormalizedDeviceXYToTexUV(VSOut.f2NormalizedXY);
+    float fCamSpaceZ = g_tex2DCamSpaceZ.SampleLevel(g_tex2DCamSpaceZ_sampler, f2UV, 0);
+
+    uint2 ui2HalfResDim;
+    g_tex2DHalfResInscattering.GetDimensions(ui2HalfResDim.x, ui2HalfResDim.y);
+    float2 f2ResolutionScale = g_PPAttribs.f4ScreenResolution.xy / float2(ui2HalfResDim);
+
+    int2 i2Location;
+    float4 f4BilinearWeights = GetBilateralUpsamplingFootprint(VSOut.f4PixelPos.xy, f2ResolutionScale, i2Location);
+
+    float3 f3Inscttering = float3(0.0, 0.0, 0.0);
+    float3 f3Extinction  = float3(0.0, 0.0, 0.0);
+    float  fTotalWeight  = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        int2 i2SampleLocation = clamp(i2Location + int2(i & 0x01, i >> 1), int2(0, 0), int2(ui2HalfResDim) - 1);
+        float4 f4Sample = g_tex2DHalfResInscattering.Load(int3(i2SampleLocation, 0));
+        // Texels without interpolation sources do not contribute
+        float fWeight = f4Sample.a >= 0.0 ? f4BilinearWeights[i] * ComputeBilateralDepthWeight(fCamSpaceZ, f4Sample.a, BILATERAL_UPSAMPLING_DEPTH_SIGMA) : 0.0;
+        f3Inscttering += fWeight * f4Sample.rgb;
+        f3Extinction  += fWeight * g_tex2DHalfResExtinction.Load(int3(i2SampleLocation, 0));
+        fTotalWeight  += fWeight;
+    }
+
+    if (!(fTotalWeight > 1e-6))
+    {
+#if CORRECT_INSCATTERING_AT_DEPTH_BREAKS
+        // Discarded pixels will keep 1.0 in the depth buffer and will be later
+        // processed to correct scattering
+        discard;
+#else
+        int2 i2NearestLocation = min(int2(VSOut.f4PixelPos.xy / f2ResolutionScale), int2(ui2HalfResDim) - 1);
+        f3Inscttering = g_tex2DHalfResInscattering.Load(int3(i2NearestLocation, 0)).rgb;
+        f3Extinction  = g_tex2DHalfResExtinction.Load(int3(i2NearestLocation, 0));
+        fTotalWeight  = 1.0;
+#endif
+    }
+
+    f3Inscttering /= fTotalWeight;
+    f3Extinction  /= fTotalWeight;
+
+    f4Color = ApplyInscatteredRadiance(VSOut.f2NormalizedXY, f2UV, fCamSpaceZ, f3Inscttering, f3Extinction);
 }
@@ -15,7 +15,11 @@ cbuffer cbScreenSpaceAmbientOcclusionAttribs
 }
 
 Texture2D<float>  g_TexturePrefilteredDepth;
+#if SSAO_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 Texture2D<float2> g_TextureBlueNoise;
 
 SamplerState g_TexturePrefilteredDepth_sampler;
@@ -28,7 +32,11 @@ float2 SampleRandomVector2D(int2 PixelCoord)
 
 float3 SampleNormalWS(float2 ScreenCoordUV)
 {
+#if SSAO_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.SampleLevel(g_TextureNormal_sampler, ScreenCoordUV, 0.0));
+#else
     return g_TextureNormal.SampleLevel(g_TextureNormal_sampler, ScreenCoordUV, 0.0);
+#endif
 }
 
 float SamplePrefilteredDepth(float2 ScreenCoordUV, float MipLevel)
@@ -72,15 +80,14 @@ float2 GetInvViewportSize()
 #endif
 }
 
-float ComputeAmbientOcclusionPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+// Position is the pixel center in the occlusion texture
+float ComputeAmbientOcclusion(float2 Position)
 {
-    float2 Position = VSOut.f4PixelPos.xy;
-
     float2 ScreenCoordUV = Position * GetInvViewportSize();
     float3 PositionSS = float3(ScreenCoordUV, SamplePrefilteredDepth(ScreenCoordUV, 0.0));
 
     if (IsBackground(PositionSS.z))
-        discard;
+        return 1.0;
 
     // Trying to fix self-occlusion. Maybe there's a better way
 #if SSAO_OPTION_HALF_PRECISION_DEPTH
@@ -168,3 +175,27 @@ float ComputeAmbientOcclusionPS(in FullScreenTriangleVSOutput VSOut) : SV_Target
 
     return Visibility / float(SSAO_SLICE_COUNT);
 }
+
+#if SSAO_OPTION_COMPUTE_SHADER
+
+RWTexture2D<float /*format = r8*/> g_RWTextureOcclusion;
+
+[numthreads(SSAO_COMPUTE_GROUP_SIZE, SSAO_COMPUTE_GROUP_SIZE, 1)]
+void ComputeAmbientOcclusionCS(uint3 ThreadId : SV_DispatchThreadID)
+{
+    uint2 TextureDimension;
+    g_RWTextureOcclusion.GetDimensions(TextureDimension.x, TextureDimension.y);
+    if (ThreadId.x >= TextureDimension.x || ThreadId.y >= TextureDimension.y)
+        return;
+
+    g_RWTextureOcclusion[ThreadId.xy] = ComputeAmbientOcclusion(float2(ThreadId.xy) + float2(0.5, 0.5));
+}
+
+#else
+
+float ComputeAmbientOcclusionPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    return ComputeAmbientOcclusion(VSOut.f4PixelPos.xy);
+}
+
+#endif
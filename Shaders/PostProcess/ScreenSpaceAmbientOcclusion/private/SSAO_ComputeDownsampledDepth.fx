@@ -3,26 +3,41 @@
 #include "BasicStructures.fxh"
 #include "FullScreenTriangleVSOutput.fxh"
 
+#if SSAO_OPTION_DEPTH_HIERARCHY
+Texture2D<float2> g_TextureDepthHierarchy;
+#else
 Texture2D g_TextureDepth;
+#endif
 
 int ComputeCheckerboardPattern(int2 Position)
 {
     return (Position.x + Position.y & 1) & 1;
 }
 
-float ComputeDepthCheckerboard(Texture2D SampledTexture, int2 Position) 
+#if SSAO_OPTION_DEPTH_HIERARCHY
+float ComputeDepthCheckerboard(int2 Position)
 {
-    float Depth0 = SampledTexture.Load(int3(2 * Position + int2(0, 0), 0)).x;
-    float Depth1 = SampledTexture.Load(int3(2 * Position + int2(0, 1), 0)).x;
-    float Depth2 = SampledTexture.Load(int3(2 * Position + int2(1, 0), 0)).x;
-    float Depth3 = SampledTexture.Load(int3(2 * Position + int2(1, 1), 0)).x;
+    // Mip 1 of the depth hierarchy contains the closest and the farthest depth of every 2x2 quad
+    float2 ClosestFarthest = g_TextureDepthHierarchy.Load(int3(Position, 1));
+    float MinDepth = min(ClosestFarthest.x, ClosestFarthest.y);
+    float MaxDepth = max(ClosestFarthest.x, ClosestFarthest.y);
+    return lerp(MinDepth, MaxDepth, float(ComputeCheckerboardPattern(Position)));
+}
+#else
+float ComputeDepthCheckerboard(int2 Position)
+{
+    float Depth0 = g_TextureDepth.Load(int3(2 * Position + int2(0, 0), 0)).x;
+    float Depth1 = g_TextureDepth.Load(int3(2 * Position + int2(0, 1), 0)).x;
+    float Depth2 = g_TextureDepth.Load(int3(2 * Position + int2(1, 0), 0)).x;
+    float Depth3 = g_TextureDepth.Load(int3(2 * Position + int2(1, 1), 0)).x;
     float MinDepth = min(min(Depth0, Depth1), min(Depth2, Depth3));
     float MaxDepth = max(max(Depth0, Depth1), max(Depth2, Depth3));
     return lerp(MinDepth, MaxDepth, float(ComputeCheckerboardPattern(Position)));
 }
+#endif
 
 float ComputeDownsampledDepthPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
 {
     float2 Position = VSOut.f4PixelPos.xy;
-    return ComputeDepthCheckerboard(g_TextureDepth, int2(Position));
+    return ComputeDepthCheckerboard(int2(Position));
 }
@@ -13,7 +13,11 @@ cbuffer cbCameraAttribs
 Texture2D<float>  g_TextureOcclusion;
 Texture2D<float>  g_TextureDepth;
 Texture2D<float>  g_TextureHistory;
+#if SSAO_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 
 SamplerState g_TextureDepth_sampler;
 SamplerState g_TextureOcclusion_sampler;
@@ -50,7 +54,11 @@ float SampleHistory(int2 PixelCoord)
 
 float3 SampleNormalWS(int2 PixelCoord)
 {
+#if SSAO_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.Load(int3(PixelCoord, 0)));
+#else
     return g_TextureNormal.Load(int3(PixelCoord, 0));
+#endif
 }
 
 float ComputeResampledHistoryPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
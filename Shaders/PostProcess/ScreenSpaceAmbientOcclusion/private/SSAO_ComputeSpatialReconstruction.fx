@@ -18,7 +18,11 @@ cbuffer cbScreenSpaceAmbientOcclusionAttribs
 Texture2D<float>  g_TextureOcclusion;
 Texture2D<float>  g_TextureHistory;
 Texture2D<float>  g_TextureDepth;
+#if SSAO_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 
 float SampleOcclusion(int2 PixelCoord)
 {
@@ -37,7 +41,11 @@ float SampleHistory(int2 PixelCoord)
 
 float3 SampleNormalWS(int2 PixelCoord)
 {
+#if SSAO_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.Load(int3(PixelCoord, 0)));
+#else
     return g_TextureNormal.Load(int3(PixelCoord, 0));
+#endif
 }
  
 float4 ComputeBlurKernelRotation(uint2 PixelCoord, uint FrameIndex)
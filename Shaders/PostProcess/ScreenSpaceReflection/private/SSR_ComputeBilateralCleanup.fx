@@ -14,7 +14,11 @@ cbuffer cbScreenSpaceReflectionAttribs
 }
 
 Texture2D<float>  g_TextureDepth;
+#if SSR_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 Texture2D<float>  g_TextureRoughness;
 
 Texture2D<float4> g_TextureRadiance;
@@ -32,7 +36,11 @@ float SampleRoughness(int2 PixelCoord)
 
 float3 SampleNormalWS(int2 PixelCoord)
 {
+#if SSR_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.Load(int3(PixelCoord, 0)));
+#else
     return g_TextureNormal.Load(int3(PixelCoord, 0));
+#endif
 }
 
 float4 SampleRadiance(int2 PixelCoord)
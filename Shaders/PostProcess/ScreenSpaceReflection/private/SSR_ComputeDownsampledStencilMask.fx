@@ -7,8 +7,8 @@ cbuffer cbScreenSpaceReflectionAttribs
     ScreenSpaceReflectionAttribs g_SSRAttribs;
 }
 
-Texture2D<float> g_TextureRoughness;
-Texture2D<float> g_TextureDepth;
+Texture2D<float>  g_TextureRoughness;
+Texture2D<float2> g_TextureDepthHierarchy;
 
 float SampleRoughness(uint2 Location, uint2 Offset, uint2 Dimension)
 {
@@ -23,33 +23,20 @@ float SampleRoughness(uint2 Location, uint2 Offset, uint2 Dimension)
     }
 }
 
-float SampleDepth(uint2 Location, uint2 Offset, uint2 Dimension)
-{
-    uint2 Position = Location + Offset;
-    if (Position.x >= Dimension.x || Position.y >= Dimension.y)
-    {
-        return g_TextureDepth.Load(int3(Location, 0));
-    }
-    else
-    {
-        return g_TextureDepth.Load(int3(Position, 0));
-    } 
-}
-
 void ComputeDownsampledStencilMaskPS(in FullScreenTriangleVSOutput VSOut)
 {
     uint2 RemappedPosition = uint2(2.0 * floor(VSOut.f4PixelPos.xy));
 
     uint2 TextureDimension;
-    g_TextureDepth.GetDimensions(TextureDimension.x, TextureDimension.y);
+    g_TextureRoughness.GetDimensions(TextureDimension.x, TextureDimension.y);
 
-    float MinDepth = DepthFarPlane;
+    // Mip 1 of the depth hierarchy contains the closest depth of the same 2x2 footprint
+    float MinDepth = g_TextureDepthHierarchy.Load(int3(int2(VSOut.f4PixelPos.xy), 1)).x;
     float MaxRoughness = 0.0f;
 
     for (uint SampleIdx = 0u; SampleIdx < 4u; ++SampleIdx)
     {
         uint2 Offset = uint2(SampleIdx & 0x01u, SampleIdx >> 1u);
-        MinDepth = MipConvFunc(MinDepth, SampleDepth(RemappedPosition, Offset, TextureDimension));
         MaxRoughness = max(MaxRoughness, SampleRoughness(RemappedPosition, Offset, TextureDimension));
     }
 
@@ -61,7 +48,6 @@ void ComputeDownsampledStencilMaskPS(in FullScreenTriangleVSOutput VSOut)
         for (uint SampleIdx = 0u; SampleIdx < 2u; ++SampleIdx)
         {
             uint2 Offset = uint2(2u, SampleIdx);
-            MinDepth = MipConvFunc(MinDepth, SampleDepth(RemappedPosition, Offset, TextureDimension));
             MaxRoughness = max(MaxRoughness, SampleRoughness(RemappedPosition, Offset, TextureDimension));
         }
     }
@@ -71,14 +57,12 @@ void ComputeDownsampledStencilMaskPS(in FullScreenTriangleVSOutput VSOut)
         for (uint SampleIdx = 0u; SampleIdx < 2u; ++SampleIdx)
         {
             uint2 Offset = uint2(SampleIdx, 2);
-            MinDepth = MipConvFunc(MinDepth, SampleDepth(RemappedPosition, Offset, TextureDimension));
             MaxRoughness = max(MaxRoughness, SampleRoughness(RemappedPosition, Offset, TextureDimension));
         }
     }
     
     if (IsWidthOdd && IsHeightOdd)
     {
-        MinDepth = MipConvFunc(MinDepth, SampleDepth(RemappedPosition, uint2(2, 2), TextureDimension));
         MaxRoughness = max(MaxRoughness, SampleRoughness(RemappedPosition, uint2(2, 2), TextureDimension));
     }
 
@@ -21,12 +21,16 @@ struct PSOutput
 };
 
 Texture2D<float3> g_TextureRadiance;
+#if SSR_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 Texture2D<float>  g_TextureRoughness;
 Texture2D<float2> g_TextureMotion;
 
 Texture2D<float2> g_TextureBlueNoise;
-Texture2D<float>  g_TextureDepthHierarchy;
+Texture2D<float2> g_TextureDepthHierarchy;
 
 SamplerState g_TextureDepthHierarchy_sampler;
 
@@ -57,12 +61,17 @@ float SampleRoughness(int2 PixelCoord)
 
 float3 SampleNormalWS(int2 PixelCoord)
 {
+#if SSR_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.Load(int3(PixelCoord, 0)));
+#else
     return g_TextureNormal.Load(int3(PixelCoord, 0));
+#endif
 }
 
+// The x component of the depth hierarchy contains the closest depth
 float SampleDepthHierarchy(int2 PixelCoord, int MipLevel)
 {
-    return g_TextureDepthHierarchy.Load(int3(PixelCoord, MipLevel));
+    return g_TextureDepthHierarchy.Load(int3(PixelCoord, MipLevel)).x;
 }
 
 float2 SampleMotion(int2 PixelCoord)
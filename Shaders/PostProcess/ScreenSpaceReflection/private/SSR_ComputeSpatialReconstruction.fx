@@ -23,7 +23,11 @@ struct PSOutput
 };
 
 Texture2D<float>  g_TextureRoughness;
+#if SSR_OPTION_PACKED_NORMAL
+Texture2D<float2> g_TextureNormal;
+#else
 Texture2D<float3> g_TextureNormal;
+#endif
 Texture2D<float>  g_TextureDepth;
 Texture2D<float4> g_TextureRayDirectionPDF;
 Texture2D<float4> g_TextureIntersectSpecular;
@@ -43,7 +47,11 @@ float SampleRoughness(int2 PixelCoord)
 
 float3 SampleNormalWS(int2 PixelCoord)
 {
+#if SSR_OPTION_PACKED_NORMAL
+    return DecodeNormalOctahedron(g_TextureNormal.Load(int3(PixelCoord, 0)));
+#else
     return g_TextureNormal.Load(int3(PixelCoord, 0));
+#endif
 }
 
 float SampleDepth(int2 PixelCoord)
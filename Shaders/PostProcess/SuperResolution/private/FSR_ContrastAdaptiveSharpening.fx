@@ -20,7 +20,12 @@ Texture2D<float4> g_TextureSource;
 
 FfxFloat32x4 FsrRcasLoadF(FfxInt32x2 Position)
 {
-    return g_TextureSource.Load(FfxInt32x3(Position, 0));
+    FfxFloat32x4 Color = g_TextureSource.Load(FfxInt32x3(Position, 0));
+#if SUPER_RESOLUTION_OPTION_HDR_SOURCE
+    // RCAS expects the input in [0, 1] range
+    Color.rgb = Color.rgb * rcp(1.0 + Color.rgb);
+#endif
+    return Color;
 }
 
 void FsrRcasInputF(FFX_PARAMETER_INOUT FfxFloat32 R, FFX_PARAMETER_INOUT FfxFloat32 G, FFX_PARAMETER_INOUT FfxFloat32 B)
@@ -39,5 +44,8 @@ FfxFloat32x4 ComputeContrastAdaptiveSharpeningPS(in FullScreenTriangleVSOutput V
 
     FfxFloat32x3 ResultColor = FfxFloat32x3(0.0, 0.0, 0.0);
     FsrRcasF(ResultColor.r, ResultColor.g, ResultColor.b, Location, Constants);
+#if SUPER_RESOLUTION_OPTION_HDR_SOURCE
+    ResultColor = ResultColor * rcp(1.0 - min(ResultColor, 0.999));
+#endif
     return FfxFloat32x4(ResultColor, 1.0);
 }
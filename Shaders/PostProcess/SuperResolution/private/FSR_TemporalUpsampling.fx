@@ -0,0 +1,176 @@
+#include "BasicStructures.fxh"
+#include "FullScreenTriangleVSOutput.fxh"
+#include "PostFX_Common.fxh"
+#include "SuperResolutionStructures.fxh"
+
+// Controls how fast the history weight and the variance clipping gamma decrease with the pixel velocity.
+#define SUPER_RESOLUTION_MOTION_VECTOR_DIFF_FACTOR 256.0
+
+cbuffer cbCameraAttribs
+{
+    CameraAttribs g_CurrCamera;
+    CameraAttribs g_PrevCamera;
+}
+
+cbuffer cbFSRAttribs
+{
+    SuperResolutionAttribs g_FSRAttribs;
+}
+
+// Current frame resources are at the source (render) resolution,
+// the history is at the output resolution.
+Texture2D<float3> g_TextureCurrColor;
+Texture2D<float4> g_TexturePrevColor;
+Texture2D<float2> g_TextureMotion;
+Texture2D<float>  g_TextureCurrDepth;
+Texture2D<float>  g_TexturePrevDepth;
+
+#if SUPER_RESOLUTION_OPTION_REACTIVE_MASK
+Texture2D<float>  g_TextureReactiveMask;
+#endif
+
+SamplerState g_TexturePrevColor_sampler;
+
+struct PixelStatistic
+{
+    float3 Mean;
+    float3 StdDev;
+};
+
+float3 HDRToSDR(float3 Color)
+{
+    return Color * rcp(1.0 + Color);
+}
+
+float3 SDRToHDR(float3 Color)
+{
+    return Color * rcp(1.0 - Color + FLT_EPS);
+}
+
+float3 SampleCurrColor(int2 PixelCoord)
+{
+    return g_TextureCurrColor.Load(int3(PixelCoord, 0));
+}
+
+float SampleCurrDepth(int2 PixelCoord)
+{
+    return g_TextureCurrDepth.Load(int3(PixelCoord, 0));
+}
+
+float SamplePrevDepth(int2 PixelCoord)
+{
+    return g_TexturePrevDepth.Load(int3(PixelCoord, 0));
+}
+
+float2 SampleMotion(int2 PixelCoord)
+{
+    return g_TextureMotion.Load(int3(PixelCoord, 0)) * F3NDC_XYZ_TO_UVD_SCALE.xy;
+}
+
+float SampleReactiveMask(int2 PixelCoord)
+{
+#if SUPER_RESOLUTION_OPTION_REACTIVE_MASK
+    return saturate(g_TextureReactiveMask.Load(int3(PixelCoord, 0)));
+#else
+    return 0.0;
+#endif
+}
+
+float4 SamplePrevColor(float2 Texcoord)
+{
+    return max(g_TexturePrevColor.SampleLevel(g_TexturePrevColor_sampler, Texcoord, 0.0), 0.0);
+}
+
+// Gaussian approximation of the Blackman-Harris window.
+// The offset is measured in source pixels.
+float ComputeSampleWeight(float2 Offset)
+{
+    return exp(-2.29 * dot(Offset, Offset));
+}
+
+float ComputeDepthDisocclusion(int2 SourceCoord, float2 PrevSourcePos)
+{
+    // The reprojected depth is the current depth projected into the previous frame
+    float LinearDepthCurr = DepthToCameraZ(SampleCurrDepth(SourceCoord), g_PrevCamera.mProj);
+    int2  PrevSourceCoord = int2(PrevSourcePos);
+    float Disocclusion    = 0.0;
+
+    const int SearchRadius = 1;
+    for (int y = -SearchRadius; y <= SearchRadius; y++)
+    {
+        for (int x = -SearchRadius; x <= SearchRadius; x++)
+        {
+            int2  Location        = ClampScreenCoord(PrevSourceCoord + int2(x, y), int2(g_FSRAttribs.SourceSize.xy));
+            float LinearDepthPrev = DepthToCameraZ(SamplePrevDepth(Location), g_PrevCamera.mProj);
+            Disocclusion = max(Disocclusion, exp(-abs(LinearDepthPrev - LinearDepthCurr) / LinearDepthCurr));
+        }
+    }
+
+    return Disocclusion > SUPER_RESOLUTION_DEPTH_DISOCCLUSION_THRESHOLD ? 1.0 : 0.0;
+}
+
+float4 ComputeTemporalUpsamplingPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
+{
+    float2 Texcoord = VSOut.f4PixelPos.xy * g_FSRAttribs.OutputSize.zw;
+
+    // Source pixel P contains the scene sampled at P + 0.5 - JitterOffset
+    float2 JitterOffset = F3NDC_XYZ_TO_UVD_SCALE.xy * g_CurrCamera.f2Jitter * g_FSRAttribs.SourceSize.xy;
+    float2 SourcePos    = Texcoord * g_FSRAttribs.SourceSize.xy;
+    int2   SourceCoord  = ClampScreenCoord(int2(floor(SourcePos + JitterOffset)), int2(g_FSRAttribs.SourceSize.xy));
+
+    // Reconstruct the current frame at the output pixel from the 3x3 source neighborhood
+    // and compute the neighborhood statistics for the history clipping.
+    float3 SDRCurrColor = float3(0.0, 0.0, 0.0);
+    float  WeightSum    = 0.0;
+    float  SampleWeight = 0.0;
+    float3 M1           = float3(0.0, 0.0, 0.0);
+    float3 M2           = float3(0.0, 0.0, 0.0);
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            int2   Location = ClampScreenCoord(SourceCoord + int2(x, y), int2(g_FSRAttribs.SourceSize.xy));
+            float3 SDRColor = HDRToSDR(SampleCurrColor(Location));
+            float  Weight   = ComputeSampleWeight(SourcePos - (float2(SourceCoord + int2(x, y)) + 0.5 - JitterOffset));
+
+            SDRCurrColor += SDRColor * Weight;
+            WeightSum    += Weight;
+            SampleWeight  = max(SampleWeight, Weight);
+
+            M1 += SDRColor;
+            M2 += SDRColor * SDRColor;
+        }
+    }
+    SDRCurrColor /= max(WeightSum, FLT_EPS);
+
+    PixelStatistic PixelStat;
+    PixelStat.Mean   = M1 / 9.0;
+    PixelStat.StdDev = sqrt(max(M2 / 9.0 - PixelStat.Mean * PixelStat.Mean, 0.0));
+
+    float2 Motion       = SampleMotion(SourceCoord);
+    float2 PrevTexcoord = Texcoord - Motion;
+
+    // The alpha channel of the history stores the accumulated sample weight
+    if (g_FSRAttribs.ResetAccumulation || !IsInsideScreen(PrevTexcoord * g_FSRAttribs.OutputSize.xy, g_FSRAttribs.OutputSize.xy))
+        return float4(SDRToHDR(SDRCurrColor), SampleWeight);
+
+    float AspectRatio  = g_FSRAttribs.OutputSize.x * g_FSRAttribs.OutputSize.w;
+    float MotionFactor = saturate(1.0 - length(float2(Motion.x * AspectRatio, Motion.y)) * SUPER_RESOLUTION_MOTION_VECTOR_DIFF_FACTOR);
+    float DepthFactor  = ComputeDepthDisocclusion(SourceCoord, PrevTexcoord * g_FSRAttribs.SourceSize.xy);
+
+    // Reactive pixels (e.g. translucent or animated surfaces without motion vectors) rely on the current frame
+    float ReactiveFactor = 1.0 - SampleReactiveMask(SourceCoord);
+
+    float4 PrevColor     = SamplePrevColor(PrevTexcoord);
+    float  VarianceGamma = lerp(SUPER_RESOLUTION_MIN_VARIANCE_GAMMA, SUPER_RESOLUTION_MAX_VARIANCE_GAMMA, MotionFactor * MotionFactor);
+    float3 SDRPrevColor  = clamp(HDRToSDR(PrevColor.rgb),
+                                 PixelStat.Mean - VarianceGamma * PixelStat.StdDev,
+                                 PixelStat.Mean + VarianceGamma * PixelStat.StdDev);
+
+    float StabilityFactor  = min(g_FSRAttribs.TemporalStabilityFactor, SUPER_RESOLUTION_MAX_TEMPORAL_STABILITY_FACTOR);
+    float MaxHistoryWeight = StabilityFactor / (1.0 - StabilityFactor);
+    float HistoryWeight    = min(PrevColor.a, MaxHistoryWeight) * MotionFactor * DepthFactor * ReactiveFactor;
+
+    float3 SDROutput = (SDRPrevColor * HistoryWeight + SDRCurrColor * SampleWeight) / max(HistoryWeight + SampleWeight, FLT_EPS);
+    return float4(SDRToHDR(SDROutput), HistoryWeight + SampleWeight);
+}
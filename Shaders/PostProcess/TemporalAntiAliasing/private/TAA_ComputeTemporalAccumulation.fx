@@ -1,6 +1,7 @@
 #include "BasicStructures.fxh"
 #include "FullScreenTriangleVSOutput.fxh"
 #include "PostFX_Common.fxh"
+#include "BilateralUpsampling.fxh"
 #include "TemporalAntiAliasingStructures.fxh"
 
 #define FLT_EPS   5.960464478e-8
@@ -145,11 +146,10 @@ float ComputeDepthDisocclusion(float2 Position, float2 PrevPosition)
     return Disocclusion > TAA_DEPTH_DISOCCLUSION_THRESHOLD ? 1.0 : 0.0;
 }
 
-float4 SamplePrevColorCatmullRom(float2 Position)
+float4 SamplePrevColorCatmullRom(float2 Position, float2 TexelSize)
 {
     // Source: https://advances.realtimerendering.com/s2016/Filmic%20SMAA%20v7.pptx Slide 77
     
-    float2 TexelSize = g_CurrCamera.f4ViewportSize.zw;
     float2 CenterPosition = floor(Position - 0.5) + 0.5;
 
     float2 F = Position - CenterPosition;
@@ -182,17 +182,18 @@ float4 SamplePrevColorCatmullRom(float2 Position)
     return max(Result * rcp(P0 + P1 + P2 + P3 + P4), 0.0);
 }
 
-float4 SamplePrevColorBilinear(float2 Position)
+float4 SamplePrevColorBilinear(float2 Position, float2 TexelSize)
 {
-    return max(g_TexturePrevColor.SampleLevel(g_TexturePrevColor_sampler, Position * g_CurrCamera.f4ViewportSize.zw, 0.0), 0.0);
+    return max(g_TexturePrevColor.SampleLevel(g_TexturePrevColor_sampler, Position * TexelSize, 0.0), 0.0);
 }
 
-float4 SamplePrevColor(float2 Position)
+// Position is given in the texels of the accumulation buffer
+float4 SamplePrevColor(float2 Position, float2 TexelSize)
 {
 #if TAA_OPTION_BICUBIC_FILTER
-    return SamplePrevColorCatmullRom(Position);
+    return SamplePrevColorCatmullRom(Position, TexelSize);
 #else
-    return SamplePrevColorBilinear(Position);
+    return SamplePrevColorBilinear(Position, TexelSize);
 #endif
 }
 
@@ -239,7 +240,15 @@ float ComputeCorrectedAlpha(float Alpha)
 
 float4 ComputeTemporalAccumulationPS(in FullScreenTriangleVSOutput VSOut) : SV_Target0
 {
-    float2 Position = VSOut.f4PixelPos.xy;
+    // The accumulation buffer may have a reduced resolution, in which case every texel
+    // accumulates the full-resolution pixel used by the bilateral upsampling as the guide
+    uint2 AccumulationDimension;
+    g_TexturePrevColor.GetDimensions(AccumulationDimension.x, AccumulationDimension.y);
+    float2 ResolutionScale = g_CurrCamera.f4ViewportSize.xy / float2(AccumulationDimension);
+    float2 TexelSize = ResolutionScale * g_CurrCamera.f4ViewportSize.zw;
+
+    int2 PixelCoord = GetBilateralUpsamplingSourcePixel(int2(VSOut.f4PixelPos.xy), ResolutionScale);
+    float2 Position = float2(PixelCoord) + 0.5;
     float2 Motion = SampleMotion(int2(Position.xy));
     float2 PrevPosition = Position.xy - Motion * g_CurrCamera.f4ViewportSize.xy;
 
@@ -251,7 +260,7 @@ float4 ComputeTemporalAccumulationPS(in FullScreenTriangleVSOutput VSOut) : SV_T
     float DepthFactor = ComputeDepthDisocclusion(Position, PrevPosition);
 
     float3 RGBHDRCurrColor = SampleCurrColor(int2(Position));
-    float4 RGBHDRPrevColor = SamplePrevColor(PrevPosition);
+    float4 RGBHDRPrevColor = SamplePrevColor(PrevPosition / ResolutionScale, TexelSize);
 
     float3 YCoCgSDRCurrColor = RGBToYCoCg(HDRToSDR(RGBHDRCurrColor.xyz));
     float3 YCoCgSDRPrevColor = RGBToYCoCg(HDRToSDR(RGBHDRPrevColor.xyz));
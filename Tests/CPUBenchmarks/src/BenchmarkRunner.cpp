@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkRunner.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "Timer.hpp"
+
+namespace Diligent
+{
+
+void BenchmarkRunner::Add(std::string Name, BenchmarkFunc Func)
+{
+    m_Benchmarks.push_back({std::move(Name), std::move(Func)});
+}
+
+size_t BenchmarkRunner::Run(const RunInfo& Info) const
+{
+    if (Info.CSV)
+    {
+        std::cout << "name,iterations,items_per_iteration,min_ns_per_item,median_ns_per_item,items_per_second\n";
+    }
+    else
+    {
+        std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+                  << std::setw(12) << "Iterations" << std::setw(12) << "Items/iter"
+                  << std::setw(14) << "Min ns/item" << std::setw(14) << "Med ns/item"
+                  << std::setw(16) << "Items/s" << "\n";
+    }
+
+    size_t NumRun = 0;
+    for (const Benchmark& Bench : m_Benchmarks)
+    {
+        if (!Info.Filter.empty() && Bench.Name.find(Info.Filter) == std::string::npos)
+            continue;
+
+        Timer Timer;
+
+        // Warm up caches and lazily initialized data
+        const size_t ItemsPerIteration = std::max(Bench.Func(), size_t{1});
+
+        // Calibrate the number of iterations so that a sample takes at least MinSampleTime
+        Uint64 NumIterations = 1;
+        while (true)
+        {
+            const double StartTime = Timer.GetElapsedTime();
+            for (Uint64 i = 0; i < NumIterations; ++i)
+                Bench.Func();
+            const double Elapsed = Timer.GetElapsedTime() - StartTime;
+            if (Elapsed >= Info.MinSampleTime || NumIterations >= (Uint64{1} << 40))
+                break;
+
+            const double Scale = Elapsed > 0 ? Info.MinSampleTime / Elapsed * 1.2 : 10.0;
+            NumIterations      = std::max(NumIterations + 1, static_cast<Uint64>(static_cast<double>(NumIterations) * std::min(Scale, 10.0)));
+        }
+
+        std::vector<double> Samples(std::max(Info.NumSamples, 1u));
+        for (double& Sample : Samples)
+        {
+            const double StartTime = Timer.GetElapsedTime();
+            for (Uint64 i = 0; i < NumIterations; ++i)
+                Bench.Func();
+            Sample = (Timer.GetElapsedTime() - StartTime) * 1e+9 / static_cast<double>(NumIterations * ItemsPerIteration);
+        }
+        std::sort(Samples.begin(), Samples.end());
+
+        const double MinTime        = Samples.front();
+        const double MedianTime     = Samples[Samples.size() / 2];
+        const double ItemsPerSecond = MedianTime > 0 ? 1e+9 / MedianTime : 0;
+
+        if (Info.CSV)
+        {
+            std::cout << Bench.Name << ',' << NumIterations << ',' << ItemsPerIteration << ','
+                      << std::fixed << std::setprecision(3) << MinTime << ',' << MedianTime << ','
+                      << std::setprecision(0) << ItemsPerSecond << "\n";
+        }
+        else
+        {
+            std::cout << std::left << std::setw(48) << Bench.Name << std::right
+                      << std::setw(12) << NumIterations << std::setw(12) << ItemsPerIteration
+                      << std::fixed << std::setprecision(3) << std::setw(14) << MinTime << std::setw(14) << MedianTime
+                      << std::setprecision(0) << std::setw(16) << ItemsPerSecond << "\n";
+        }
+        ++NumRun;
+    }
+
+    return NumRun;
+}
+
+} // namespace Diligent
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Prevents the compiler from optimizing away the computation of the value.
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 : "r,m"(Value)
+                 : "memory");
+#else
+    static volatile const void* Sink;
+    Sink = &Value;
+#endif
+}
+
+/// Simple CPU microbenchmark runner.
+///
+/// Every benchmark function performs one iteration of the measured work and returns
+/// the number of items processed. The runner calibrates the number of iterations so that
+/// every sample takes at least the given time, collects several samples, and reports
+/// the minimum and median time per item.
+class BenchmarkRunner
+{
+public:
+    using BenchmarkFunc = std::function<size_t()>;
+
+    void Add(std::string Name, BenchmarkFunc Func);
+
+    struct RunInfo
+    {
+        /// Only benchmarks whose names contain this string are run.
+        std::string Filter;
+
+        /// Minimum duration of a single sample, in seconds.
+        double MinSampleTime = 0.1;
+
+        /// The number of samples to collect for every benchmark.
+        Uint32 NumSamples = 5;
+
+        /// Print results in CSV format.
+        bool CSV = false;
+    };
+    /// Runs the benchmarks and prints the results to stdout.
+    ///
+    /// \return The number of benchmarks that were run.
+    size_t Run(const RunInfo& Info) const;
+
+private:
+    struct Benchmark
+    {
+        std::string   Name;
+        BenchmarkFunc Func;
+    };
+    std::vector<Benchmark> m_Benchmarks;
+};
+
+void RegisterPBRBenchmarks(BenchmarkRunner& Runner);
+void RegisterShadowMapBenchmarks(BenchmarkRunner& Runner);
+void RegisterPostFXBenchmarks(BenchmarkRunner& Runner);
+#if DILIGENT_FX_CPU_BENCHMARKS_HYDROGENT
+void RegisterHydrogentBenchmarks(BenchmarkRunner& Runner);
+#endif
+
+} // namespace Diligent
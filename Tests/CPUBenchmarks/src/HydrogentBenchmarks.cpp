@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkRunner.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "HnMeshUtils.hpp"
+#include "HnDrawListSort.hpp"
+
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/imaging/hd/tokens.h"
+#include "pxr/imaging/pxOsd/tokens.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using namespace USD;
+
+// Grid mesh with mostly quads, and some triangles and pentagons, which is typical for production assets
+struct TestMesh
+{
+    pxr::SdfPath        Id{"/BenchmarkMesh"};
+    pxr::VtVec3fArray   Points;
+    pxr::VtVec3fArray   Normals;
+    pxr::HdMeshTopology Topology;
+
+    explicit TestMesh(int GridSize)
+    {
+        const int NumVerts = GridSize + 1;
+        Points.reserve(static_cast<size_t>(NumVerts) * NumVerts);
+        for (int y = 0; y < NumVerts; ++y)
+        {
+            for (int x = 0; x < NumVerts; ++x)
+                Points.push_back(pxr::GfVec3f{static_cast<float>(x), static_cast<float>(y), 0});
+        }
+        Normals.assign(Points.size(), pxr::GfVec3f{0, 0, 1});
+
+        pxr::VtIntArray FaceVertexCounts;
+        pxr::VtIntArray FaceVertexIndices;
+        for (int y = 0; y < GridSize; ++y)
+        {
+            for (int x = 0; x < GridSize; ++x)
+            {
+                const int v0 = y * NumVerts + x;
+                const int v1 = v0 + 1;
+                const int v2 = v1 + NumVerts;
+                const int v3 = v0 + NumVerts;
+                if ((x + y) % 8 == 0)
+                {
+                    // Two triangles
+                    FaceVertexCounts.push_back(3);
+                    FaceVertexCounts.push_back(3);
+                    for (int v : {v0, v1, v2, v0, v2, v3})
+                        FaceVertexIndices.push_back(v);
+                }
+                else if ((x + y) % 8 == 1 && x + 1 < GridSize)
+                {
+                    // Pentagon that extends into the next cell
+                    FaceVertexCounts.push_back(5);
+                    for (int v : {v0, v1, v1 + 1, v2, v3})
+                        FaceVertexIndices.push_back(v);
+                }
+                else
+                {
+                    FaceVertexCounts.push_back(4);
+                    for (int v : {v0, v1, v2, v3})
+                        FaceVertexIndices.push_back(v);
+                }
+            }
+        }
+
+        Topology = pxr::HdMeshTopology{pxr::PxOsdOpenSubdivTokens->none, pxr::HdTokens->rightHanded, FaceVertexCounts, FaceVertexIndices};
+    }
+};
+
+void RegisterMeshUtilsBenchmarks(BenchmarkRunner& Runner)
+{
+    auto Mesh = std::make_shared<TestMesh>(256);
+
+    const size_t NumFaces = static_cast<size_t>(Mesh->Topology.GetNumFaces());
+
+    Runner.Add("HnMeshUtils/Triangulate",
+               [Mesh, NumFaces]() {
+                   HnMeshUtils       MeshUtils{Mesh->Topology, Mesh->Id};
+                   pxr::VtValue      Points{Mesh->Points};
+                   pxr::VtVec3iArray TriangleIndices;
+                   pxr::VtIntArray   SubsetStart;
+                   MeshUtils.Triangulate(/*UseFaceVertexIndices = */ false, &Points, TriangleIndices, SubsetStart);
+                   DoNotOptimize(TriangleIndices.cdata());
+                   return NumFaces;
+               });
+
+    Runner.Add("HnMeshUtils/ComputeEdgeIndices",
+               [Mesh, NumFaces]() {
+                   HnMeshUtils             MeshUtils{Mesh->Topology, Mesh->Id};
+                   const pxr::VtVec2iArray EdgeIndices = MeshUtils.ComputeEdgeIndices(/*UseFaceVertexIndices = */ false);
+                   DoNotOptimize(EdgeIndices.cdata());
+                   return NumFaces;
+               });
+
+    Runner.Add("HnMeshUtils/ConvertVertexPrimvarToFaceVarying",
+               [Mesh, NumFaces]() {
+                   HnMeshUtils        MeshUtils{Mesh->Topology, Mesh->Id};
+                   const pxr::VtValue FaceVaryingNormals = MeshUtils.ConvertVertexPrimvarToFaceVarying(pxr::VtValue{Mesh->Normals});
+                   DoNotOptimize(FaceVaryingNormals);
+                   return NumFaces;
+               });
+}
+
+void RegisterDrawListSortBenchmarks(BenchmarkRunner& Runner)
+{
+    constexpr size_t NumItems     = 10000;
+    constexpr size_t NumPSOs      = 64;
+    constexpr size_t NumMaterials = 512;
+
+    struct TestData
+    {
+        std::vector<HnDrawListSortKey> Keys;
+        std::vector<Uint32>            RenderOrder;
+    };
+    auto Data = std::make_shared<TestData>();
+
+    // Draw list items are added in the order of the Hydra draw items, which is
+    // effectively random with respect to the PSO and material
+    std::mt19937 Rng{0};
+    Data->Keys.resize(NumItems);
+    for (size_t i = 0; i < NumItems; ++i)
+    {
+        HnDrawListSortKey& Key = Data->Keys[i];
+
+        const size_t Material = Rng() % NumMaterials;
+        Key.pPSO              = reinterpret_cast<const void*>(static_cast<uintptr_t>((Material % NumPSOs + 1) * 256));
+        Key.pSRB              = reinterpret_cast<const void*>(static_cast<uintptr_t>((Material + 1) * 1024));
+        Key.Entity            = static_cast<entt::entity>(i);
+    }
+
+    Runner.Add("HnRenderPass/SortDrawList",
+               [Data]() {
+                   const bool DrawOrderDirty = SortDrawList(Data->RenderOrder, Data->Keys.size(), [&Data](Uint32 i) -> const HnDrawListSortKey& {
+                       return Data->Keys[i];
+                   });
+                   DoNotOptimize(DrawOrderDirty);
+                   return Data->Keys.size();
+               });
+}
+
+} // namespace
+
+void RegisterHydrogentBenchmarks(BenchmarkRunner& Runner)
+{
+    RegisterMeshUtilsBenchmarks(Runner);
+    RegisterDrawListSortBenchmarks(Runner);
+}
+
+} // namespace Diligent
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkRunner.hpp"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "GLTF_PBR_Renderer.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr size_t NumPSOKeys      = 4096;
+constexpr size_t NumUniquePSOs   = 256;
+constexpr size_t NumPrimitives   = 1024;
+constexpr Uint64 OptionalPSOBits = PBR_Renderer::PSO_FLAG_ALL_TEXTURES |
+    PBR_Renderer::PSO_FLAG_USE_VERTEX_COLORS |
+    PBR_Renderer::PSO_FLAG_USE_VERTEX_TANGENTS |
+    PBR_Renderer::PSO_FLAG_USE_TEXCOORD1 |
+    PBR_Renderer::PSO_FLAG_USE_JOINTS |
+    PBR_Renderer::PSO_FLAG_ENABLE_CLEAR_COAT |
+    PBR_Renderer::PSO_FLAG_ENABLE_SHEEN |
+    PBR_Renderer::PSO_FLAG_ENABLE_TEXCOORD_TRANSFORM |
+    PBR_Renderer::PSO_FLAG_COMPUTE_MOTION_VECTORS |
+    PBR_Renderer::PSO_FLAG_ENABLE_SHADOWS;
+
+// Generates PSO key arguments that resemble the ones used when rendering a typical scene:
+// a common set of flags plus a random subset of material- and mesh-specific flags.
+struct PSOKeyArgs
+{
+    PBR_Renderer::PSO_FLAGS  Flags     = PBR_Renderer::PSO_FLAG_NONE;
+    PBR_Renderer::ALPHA_MODE AlphaMode = PBR_Renderer::ALPHA_MODE_OPAQUE;
+    CULL_MODE                CullMode  = CULL_MODE_BACK;
+};
+
+std::vector<PSOKeyArgs> GeneratePSOKeyArgs(size_t NumUnique, size_t NumKeys)
+{
+    std::mt19937 Rng{0};
+
+    std::vector<PSOKeyArgs> Unique(NumUnique);
+    for (PSOKeyArgs& Args : Unique)
+    {
+        Uint64 Flags = PBR_Renderer::PSO_FLAG_USE_VERTEX_NORMALS |
+            PBR_Renderer::PSO_FLAG_USE_TEXCOORD0 |
+            PBR_Renderer::PSO_FLAG_USE_IBL |
+            PBR_Renderer::PSO_FLAG_USE_LIGHTS |
+            PBR_Renderer::PSO_FLAG_ENABLE_TONE_MAPPING;
+        for (Uint32 bit = 0; bit < 64; ++bit)
+        {
+            const Uint64 Flag = Uint64{1} << bit;
+            if ((OptionalPSOBits & Flag) != 0 && (Rng() & 3) == 0)
+                Flags |= Flag;
+        }
+        Args.Flags     = static_cast<PBR_Renderer::PSO_FLAGS>(Flags);
+        Args.AlphaMode = static_cast<PBR_Renderer::ALPHA_MODE>(Rng() % PBR_Renderer::ALPHA_MODE_NUM_MODES);
+        Args.CullMode  = (Rng() & 7) == 0 ? CULL_MODE_NONE : CULL_MODE_BACK;
+    }
+
+    std::vector<PSOKeyArgs> Keys(NumKeys);
+    for (PSOKeyArgs& Args : Keys)
+        Args = Unique[Rng() % NumUnique];
+
+    return Keys;
+}
+
+void RegisterPSOKeyBenchmarks(BenchmarkRunner& Runner)
+{
+    auto KeyArgs = std::make_shared<std::vector<PSOKeyArgs>>(GeneratePSOKeyArgs(NumUniquePSOs, NumPSOKeys));
+
+    Runner.Add("PBR_Renderer/PSOKey/ConstructAndHash",
+               [KeyArgs]() {
+                   size_t Hash = 0;
+                   for (const PSOKeyArgs& Args : *KeyArgs)
+                   {
+                       PBR_Renderer::PSOKey Key{Args.Flags, Args.AlphaMode, Args.CullMode};
+                       Hash ^= PBR_Renderer::PSOKey::Hasher{}(Key);
+                   }
+                   DoNotOptimize(Hash);
+                   return KeyArgs->size();
+               });
+
+    // PsoCacheAccessor::Get() requires an initialized renderer. After adjusting the flags for
+    // the renderer settings, it looks the key up in the PsoHashMapType, which is what is measured here.
+    auto Keys     = std::make_shared<std::vector<PBR_Renderer::PSOKey>>();
+    auto PsoCache = std::make_shared<PBR_Renderer::PsoHashMapType>();
+    Keys->reserve(KeyArgs->size());
+    for (const PSOKeyArgs& Args : *KeyArgs)
+    {
+        Keys->emplace_back(Args.Flags, Args.AlphaMode, Args.CullMode);
+        PsoCache->emplace(Keys->back(), RefCntAutoPtr<IPipelineState>{});
+    }
+
+    Runner.Add("PBR_Renderer/PsoCache/Lookup",
+               [Keys, PsoCache]() {
+                   size_t NumFound = 0;
+                   for (const PBR_Renderer::PSOKey& Key : *Keys)
+                       NumFound += PsoCache->find(Key) != PsoCache->end() ? 1 : 0;
+                   DoNotOptimize(NumFound);
+                   return Keys->size();
+               });
+}
+
+void RegisterWritePrimitiveAttribsBenchmarks(BenchmarkRunner& Runner)
+{
+    struct TestData
+    {
+        GLTF::Material                                         Material;
+        std::array<int, PBR_Renderer::TEXTURE_ATTRIB_ID_COUNT> TextureAttribIndices{};
+        std::vector<float4x4>                                  NodeMatrices;
+        std::vector<PBR_Renderer::PSO_FLAGS>                   PSOFlags;
+        std::vector<float4>                                    Buffer;
+    };
+    auto Data = std::make_shared<TestData>();
+
+    Data->TextureAttribIndices.fill(-1);
+    Data->TextureAttribIndices[PBR_Renderer::TEXTURE_ATTRIB_ID_BASE_COLOR] = GLTF::DefaultBaseColorTextureAttribId;
+    Data->TextureAttribIndices[PBR_Renderer::TEXTURE_ATTRIB_ID_PHYS_DESC]  = GLTF::DefaultMetallicRoughnessTextureAttribId;
+    Data->TextureAttribIndices[PBR_Renderer::TEXTURE_ATTRIB_ID_NORMAL]     = GLTF::DefaultNormalTextureAttribId;
+    Data->TextureAttribIndices[PBR_Renderer::TEXTURE_ATTRIB_ID_OCCLUSION]  = GLTF::DefaultOcclusionTextureAttribId;
+    Data->TextureAttribIndices[PBR_Renderer::TEXTURE_ATTRIB_ID_EMISSIVE]   = GLTF::DefaultEmissiveTextureAttribId;
+
+    {
+        GLTF::MaterialBuilder MatBuilder{Data->Material};
+        for (int AttribIdx : Data->TextureAttribIndices)
+        {
+            if (AttribIdx >= 0)
+                MatBuilder.GetTextureAttrib(AttribIdx).UVScaleAndRotation = float2x2::Identity();
+        }
+    }
+    Data->Material.Attribs.BaseColorFactor = float4{1, 1, 1, 1};
+
+    std::mt19937 Rng{0};
+    Data->NodeMatrices.resize(NumPrimitives);
+    Data->PSOFlags.resize(NumPrimitives);
+    for (size_t i = 0; i < NumPrimitives; ++i)
+    {
+        Data->NodeMatrices[i] = float4x4::Translation(static_cast<float>(i), 0, 0);
+
+        Uint64 Flags = PBR_Renderer::PSO_FLAG_USE_COLOR_MAP | PBR_Renderer::PSO_FLAG_USE_NORMAL_MAP | PBR_Renderer::PSO_FLAG_USE_PHYS_DESC_MAP;
+        if (Rng() & 1)
+            Flags |= PBR_Renderer::PSO_FLAG_USE_AO_MAP;
+        if (Rng() & 1)
+            Flags |= PBR_Renderer::PSO_FLAG_USE_EMISSIVE_MAP;
+        if (Rng() & 1)
+            Flags |= PBR_Renderer::PSO_FLAG_COMPUTE_MOTION_VECTORS;
+        Data->PSOFlags[i] = static_cast<PBR_Renderer::PSO_FLAGS>(Flags);
+    }
+    // Generously sized destination buffer; every primitive takes less than 1 KB
+    Data->Buffer.resize(NumPrimitives * 1024 / sizeof(float4));
+
+    Runner.Add("GLTF_PBR_Renderer/WritePBRPrimitiveShaderAttribs",
+               [Data]() {
+                   void* pDst = Data->Buffer.data();
+                   for (size_t i = 0; i < NumPrimitives; ++i)
+                   {
+                       GLTF_PBR_Renderer::PBRPrimitiveShaderAttribsData AttribsData{
+                           Data->PSOFlags[i],
+                           &Data->NodeMatrices[i],
+                           &Data->NodeMatrices[i],
+                           0, // JointCount
+                       };
+                       pDst = GLTF_PBR_Renderer::WritePBRPrimitiveShaderAttribs(pDst, AttribsData, Data->TextureAttribIndices, Data->Material, /*TransposeMatrices = */ true);
+                   }
+                   DoNotOptimize(pDst);
+                   return NumPrimitives;
+               });
+}
+
+} // namespace
+
+void RegisterPBRBenchmarks(BenchmarkRunner& Runner)
+{
+    RegisterPSOKeyBenchmarks(Runner);
+    RegisterWritePrimitiveAttribsBenchmarks(Runner);
+}
+
+} // namespace Diligent
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkRunner.hpp"
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "PostFXContext.hpp"
+
+namespace Diligent
+{
+
+// Accesses the private render technique cache key of PostFXContext
+class PostFXContextBenchmark
+{
+public:
+    using RenderTechniqueKey = PostFXContext::RenderTechniqueKey;
+    using RENDER_TECH        = PostFXContext::RENDER_TECH;
+
+    static constexpr Uint32 RenderTechCount = PostFXContext::RENDER_TECH_COUNT;
+};
+
+namespace
+{
+
+using RenderTechniqueKey = PostFXContextBenchmark::RenderTechniqueKey;
+
+std::vector<RenderTechniqueKey> GenerateRenderTechniqueKeys(size_t NumKeys)
+{
+    static constexpr TEXTURE_FORMAT Formats[] = {
+        TEX_FORMAT_RGBA8_UNORM,
+        TEX_FORMAT_RGBA8_UNORM_SRGB,
+        TEX_FORMAT_RGBA16_FLOAT,
+        TEX_FORMAT_R11G11B10_FLOAT,
+        TEX_FORMAT_R32_FLOAT,
+        TEX_FORMAT_D32_FLOAT,
+    };
+
+    std::mt19937 Rng{0};
+
+    std::vector<RenderTechniqueKey> Keys;
+    Keys.reserve(NumKeys);
+    for (size_t i = 0; i < NumKeys; ++i)
+    {
+        Keys.emplace_back(static_cast<PostFXContextBenchmark::RENDER_TECH>(Rng() % PostFXContextBenchmark::RenderTechCount),
+                          static_cast<PostFXContext::FEATURE_FLAGS>(Rng() & 3u),
+                          Formats[Rng() % _countof(Formats)]);
+    }
+    return Keys;
+}
+
+} // namespace
+
+void RegisterPostFXBenchmarks(BenchmarkRunner& Runner)
+{
+    auto Keys = std::make_shared<std::vector<RenderTechniqueKey>>(GenerateRenderTechniqueKeys(4096));
+
+    Runner.Add("PostFXContext/RenderTechniqueKey/Hash",
+               [Keys]() {
+                   size_t Hash = 0;
+                   for (const RenderTechniqueKey& Key : *Keys)
+                       Hash ^= RenderTechniqueKey::Hasher{}(Key);
+                   DoNotOptimize(Hash);
+                   return Keys->size();
+               });
+
+    using RenderTechMapType = std::unordered_map<RenderTechniqueKey, int, RenderTechniqueKey::Hasher>;
+
+    auto RenderTechMap = std::make_shared<RenderTechMapType>();
+    for (const RenderTechniqueKey& Key : *Keys)
+        RenderTechMap->emplace(Key, 0);
+
+    Runner.Add("PostFXContext/RenderTechniqueKey/Lookup",
+               [Keys, RenderTechMap]() {
+                   size_t NumFound = 0;
+                   for (const RenderTechniqueKey& Key : *Keys)
+                       NumFound += RenderTechMap->find(Key) != RenderTechMap->end() ? 1 : 0;
+                   DoNotOptimize(NumFound);
+                   return Keys->size();
+               });
+}
+
+} // namespace Diligent
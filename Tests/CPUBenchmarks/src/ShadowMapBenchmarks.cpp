@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BenchmarkRunner.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ShadowMapManager.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void AddDistributeCascadesBenchmark(BenchmarkRunner& Runner, const char* Name, bool StabilizeExtents)
+{
+    constexpr Uint32 NumViews = 64;
+
+    struct TestData
+    {
+        std::vector<float4x4> CameraViews;
+        float4x4              CameraProj;
+        float3                LightDir;
+
+        ShadowMapManager::ShadowMapInfo     SMInfo;
+        ShadowMapAttribs                    ShadowAttribs;
+        ShadowMapManager::CascadeTransforms CascadeTransforms[MAX_CASCADES];
+    };
+    auto Data = std::make_shared<TestData>();
+
+    // Camera orbiting the origin
+    Data->CameraViews.resize(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        const float  Angle = static_cast<float>(i) / static_cast<float>(NumViews) * 2.f * PI_F;
+        const float3 Pos{std::cos(Angle) * 50.f, 10.f, std::sin(Angle) * 50.f};
+        Data->CameraViews[i] = float4x4::Translation(-Pos) * float4x4::RotationY(Angle + PI_F / 2.f);
+    }
+    Data->CameraProj = float4x4::Projection(PI_F / 4.f, 16.f / 9.f, 0.1f, 1000.f, false);
+    Data->LightDir   = normalize(float3{0.5f, -1.f, 0.3f});
+
+    Data->SMInfo.Width       = 2048;
+    Data->SMInfo.Height      = 2048;
+    Data->SMInfo.NumCascades = 4;
+    Data->SMInfo.ShadowMode  = SHADOW_MODE_PCF;
+
+    Data->ShadowAttribs.fFilterWorldSize = 0.1f;
+
+    Runner.Add(Name,
+               [Data, StabilizeExtents]() {
+                   for (const float4x4& CameraView : Data->CameraViews)
+                   {
+                       ShadowMapManager::DistributeCascadeInfo DistrInfo;
+                       DistrInfo.pCameraView      = &CameraView;
+                       DistrInfo.pCameraProj      = &Data->CameraProj;
+                       DistrInfo.pLightDir        = &Data->LightDir;
+                       DistrInfo.StabilizeExtents = StabilizeExtents;
+
+                       ShadowMapManager::DistributeCascades(DistrInfo, Data->SMInfo, Data->ShadowAttribs, Data->CascadeTransforms);
+                   }
+                   DoNotOptimize(Data->ShadowAttribs);
+                   return Data->CameraViews.size();
+               });
+}
+
+} // namespace
+
+void RegisterShadowMapBenchmarks(BenchmarkRunner& Runner)
+{
+    AddDistributeCascadesBenchmark(Runner, "ShadowMapManager/DistributeCascades/Stabilized", true);
+    AddDistributeCascadesBenchmark(Runner, "ShadowMapManager/DistributeCascades/Tight", false);
+}
+
+} // namespace Diligent
@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2023-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "BenchmarkRunner.hpp"
+
+using namespace Diligent;
+
+static void PrintUsage()
+{
+    std::cout << "Usage: DiligentFX-CPUBenchmarks [options]\n"
+                 "  --filter STR     Only run benchmarks whose names contain STR\n"
+                 "  --min-time SEC   Minimum duration of a single sample in seconds (default: 0.1)\n"
+                 "  --samples N      Number of samples per benchmark (default: 5)\n"
+                 "  --csv            Print results in CSV format\n";
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkRunner::RunInfo RunInfo;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg = argv[i];
+        if (std::strcmp(Arg, "--csv") == 0)
+        {
+            RunInfo.CSV = true;
+        }
+        else if (std::strcmp(Arg, "--filter") == 0 && i + 1 < argc)
+        {
+            RunInfo.Filter = argv[++i];
+        }
+        else if (std::strcmp(Arg, "--min-time") == 0 && i + 1 < argc)
+        {
+            RunInfo.MinSampleTime = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(Arg, "--samples") == 0 && i + 1 < argc)
+        {
+            RunInfo.NumSamples = static_cast<Uint32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            PrintUsage();
+            return std::strcmp(Arg, "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    BenchmarkRunner Runner;
+    RegisterPBRBenchmarks(Runner);
+    RegisterShadowMapBenchmarks(Runner);
+    RegisterPostFXBenchmarks(Runner);
+#if DILIGENT_FX_CPU_BENCHMARKS_HYDROGENT
+    RegisterHydrogentBenchmarks(Runner);
+#endif
+
+    if (Runner.Run(RunInfo) == 0)
+    {
+        std::cerr << "No benchmarks match the filter '" << RunInfo.Filter << "'\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ClusteredLightGrid.hpp"
+
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace Diligent
+{
+
+namespace HLSL
+{
+
+#include "Shaders/Common/public/BasicStructures.fxh"
+#include "Shaders/PBR/public/PBR_Structures.fxh"
+
+} // namespace HLSL
+
+} // namespace Diligent
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr float NearZ = 1;
+constexpr float FarZ  = 100;
+
+HLSL::CameraAttribs GetTestCamera()
+{
+    // The camera is located at the origin and looks along +Z
+    HLSL::CameraAttribs Camera{};
+    Camera.mView       = float4x4::Identity();
+    Camera.mProj       = float4x4::Projection(PI_F / 2.f, 1.f, NearZ, FarZ, false);
+    Camera.mViewProj   = Camera.mView * Camera.mProj;
+    Camera.fNearPlaneZ = NearZ;
+    Camera.fFarPlaneZ  = FarZ;
+    return Camera;
+}
+
+HLSL::PBRLightAttribs MakePointLight(const float3& Pos, float Range)
+{
+    HLSL::PBRLightAttribs Light{};
+    Light.Type           = 2;
+    Light.PosX           = Pos.x;
+    Light.PosY           = Pos.y;
+    Light.PosZ           = Pos.z;
+    Light.ShadowMapIndex = -1;
+    Light.Range4         = Range * Range * Range * Range;
+    return Light;
+}
+
+bool ClusterContainsLight(const ClusteredLightGrid& Grid, Uint32 ClusterIdx, Uint32 LightIdx)
+{
+    const uint2&               Cluster = Grid.GetClusters()[ClusterIdx];
+    const std::vector<Uint32>& Indices = Grid.GetLightIndices();
+    return std::find(Indices.begin() + Cluster.x, Indices.begin() + Cluster.x + Cluster.y, LightIdx) != Indices.begin() + Cluster.x + Cluster.y;
+}
+
+Uint32 GetTotalLightCount(const ClusteredLightGrid& Grid)
+{
+    Uint32 Count = 0;
+    for (const uint2& Cluster : Grid.GetClusters())
+        Count += Cluster.y;
+    return Count;
+}
+
+TEST(ClusteredLightGridTest, LightInFront)
+{
+    ClusteredLightGrid Grid{nullptr, {}};
+
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    const HLSL::PBRLightAttribs       Light  = MakePointLight({0, 0, 10}, 1);
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, &Light, 1, Renderer);
+
+    // The first depth slice starts at the near plane
+    EXPECT_NEAR(Renderer.ClusterZScale * std::log(NearZ) + Renderer.ClusterZBias, 0.f, 1e-5f);
+    EXPECT_TRUE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0, 0, 10}, Camera), 0));
+    EXPECT_TRUE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0.5f, -0.5f, 10.5f}, Camera), 0));
+
+    // Clusters far from the light must be empty
+    EXPECT_FALSE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0, 0, 50}, Camera), 0));
+    EXPECT_FALSE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0, 0, 2}, Camera), 0));
+    EXPECT_FALSE(ClusterContainsLight(Grid, Grid.GetClusterIndex({-9, 9, 10}, Camera), 0));
+}
+
+TEST(ClusteredLightGridTest, LightBehindCamera)
+{
+    ClusteredLightGrid Grid{nullptr, {}};
+
+    // The light must not be mirrored into the clusters in front of the camera
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    const HLSL::PBRLightAttribs       Light  = MakePointLight({0, 0, -10}, 2);
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, &Light, 1, Renderer);
+
+    EXPECT_EQ(GetTotalLightCount(Grid), 0u);
+}
+
+TEST(ClusteredLightGridTest, LightIntersectingNearPlane)
+{
+    ClusteredLightGrid Grid{nullptr, {}};
+
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    const HLSL::PBRLightAttribs       Light  = MakePointLight({0, 0, 0}, 3);
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, &Light, 1, Renderer);
+
+    EXPECT_TRUE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0, 0, NearZ}, Camera), 0));
+    EXPECT_TRUE(ClusterContainsLight(Grid, Grid.GetClusterIndex({-1.5f, 1.5f, 2}, Camera), 0));
+    EXPECT_FALSE(ClusterContainsLight(Grid, Grid.GetClusterIndex({0, 0, 20}, Camera), 0));
+}
+
+TEST(ClusteredLightGridTest, LightOffScreen)
+{
+    ClusteredLightGrid Grid{nullptr, {}};
+
+    const HLSL::PBRLightAttribs Lights[] = {
+        MakePointLight({100, 0, 10}, 1),
+        MakePointLight({0, 0, 200}, 10),
+    };
+
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, Lights, _countof(Lights), Renderer);
+
+    EXPECT_EQ(GetTotalLightCount(Grid), 0u);
+}
+
+TEST(ClusteredLightGridTest, Overflow)
+{
+    ClusteredLightGrid::CreateInfo CI;
+    CI.GridSize           = {1, 1, 1};
+    CI.MaxLightCount      = 4;
+    CI.MaxLightIndexCount = 2;
+    ClusteredLightGrid Grid{nullptr, CI};
+
+    std::vector<HLSL::PBRLightAttribs> Lights(6, MakePointLight({0, 0, 10}, 1));
+
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, Lights.data(), static_cast<Uint32>(Lights.size()), Renderer);
+
+    // Two lights exceed the light count, and two more don't fit into the only cluster
+    EXPECT_EQ(Grid.GetNumDroppedLights(), 2u);
+    EXPECT_EQ(Grid.GetNumDroppedLightIndices(), 2u);
+    EXPECT_EQ(GetTotalLightCount(Grid), 2u);
+
+    Grid.BinLights(Camera, Lights.data(), 1, Renderer);
+    EXPECT_EQ(Grid.GetNumDroppedLights(), 0u);
+    EXPECT_EQ(Grid.GetNumDroppedLightIndices(), 0u);
+}
+
+// Every visible point lit by a light must find the light in its cluster
+TEST(ClusteredLightGridTest, Conservative)
+{
+    ClusteredLightGrid::CreateInfo CI;
+    CI.GridSize      = {8, 4, 16};
+    CI.MaxLightCount = 64;
+    ClusteredLightGrid Grid{nullptr, CI};
+
+    std::mt19937                          Gen{42};
+    std::uniform_real_distribution<float> PosDistr{-40, 40};
+    std::uniform_real_distribution<float> DepthDistr{-10, FarZ + 10};
+    std::uniform_real_distribution<float> RangeDistr{0.5f, 10};
+
+    std::vector<HLSL::PBRLightAttribs> Lights;
+    for (Uint32 i = 0; i < CI.MaxLightCount; ++i)
+        Lights.push_back(MakePointLight({PosDistr(Gen), PosDistr(Gen), DepthDistr(Gen)}, RangeDistr(Gen)));
+
+    const HLSL::CameraAttribs         Camera = GetTestCamera();
+    HLSL::PBRRendererShaderParameters Renderer{};
+    Grid.BinLights(Camera, Lights.data(), static_cast<Uint32>(Lights.size()), Renderer);
+
+    std::uniform_real_distribution<float> NDCDistr{-1, 1};
+    std::uniform_real_distribution<float> ZDistr{NearZ, FarZ};
+    for (Uint32 i = 0; i < 10000; ++i)
+    {
+        // Random point in the view frustum (the field of view is 90 degrees)
+        const float  Z = ZDistr(Gen);
+        const float3 Pos{NDCDistr(Gen) * Z, NDCDistr(Gen) * Z, Z};
+
+        const Uint32 ClusterIdx = Grid.GetClusterIndex(Pos, Camera);
+        for (Uint32 LightIdx = 0; LightIdx < Lights.size(); ++LightIdx)
+        {
+            const HLSL::PBRLightAttribs& Light = Lights[LightIdx];
+            const float                  Range = std::sqrt(std::sqrt(Light.Range4));
+            if (length(Pos - float3{Light.PosX, Light.PosY, Light.PosZ}) < Range)
+            {
+                EXPECT_TRUE(ClusterContainsLight(Grid, ClusterIdx, LightIdx))
+                    << "Light " << LightIdx << " is missing in cluster " << ClusterIdx;
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,547 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pxr/imaging/hd/renderIndex.h"
+#include "pxr/imaging/hd/changeTracker.h"
+#include "pxr/imaging/hd/tokens.h"
+#include "pxr/usdImaging/usdImaging/delegate.h"
+
+#include "EngineFactoryVk.h"
+#include "RefCntAutoPtr.hpp"
+#include "Timer.hpp"
+#include "DebugUtilities.hpp"
+
+#include "HnRenderDelegate.hpp"
+#include "HnRenderBuffer.hpp"
+#include "Tasks/HnTaskManager.hpp"
+#include "Tasks/HnBeginFrameTask.hpp"
+
+#include "SyntheticStage.hpp"
+
+using namespace Diligent;
+using namespace Diligent::USD;
+
+namespace
+{
+
+struct BenchmarkOptions
+{
+    SyntheticStageDesc Stage;
+
+    Uint32 Width        = 1280;
+    Uint32 Height       = 720;
+    Uint32 WarmupFrames = 10;
+
+    // Use software rasterizer (e.g. lavapipe) for reproducible results
+    bool SoftwareAdapter = true;
+};
+
+void PrintUsage()
+{
+    std::cout << "Usage: HydrogentBenchmark [options]\n"
+                 "  --meshes N        Number of meshes (default: 1000)\n"
+                 "  --instancing R    Fraction of instanced meshes in [0, 1] (default: 0)\n"
+                 "  --prototypes N    Number of instance prototypes (default: 16)\n"
+                 "  --materials N     Number of materials (default: 32)\n"
+                 "  --textures N      Number of textures (default: 8)\n"
+                 "  --lights N        Number of lights (default: 4)\n"
+                 "  --skinned N       Number of skinned meshes (default: 0)\n"
+                 "  --joints N        Number of joints per skeleton (default: 16)\n"
+                 "  --tessellation N  Mesh tessellation (default: 16)\n"
+                 "  --primvars LIST   Mesh primvars: any combination of n (normals), t (texcoords),\n"
+                 "                    c (display color), or 'none' (default: ntc)\n"
+                 "  --frames N        Number of measured frames (default: 300)\n"
+                 "  --warmup N        Number of unmeasured warm-up frames (default: 10)\n"
+                 "  --width N         Render target width (default: 1280)\n"
+                 "  --height N        Render target height (default: 720)\n"
+                 "  --seed N          Random seed (default: 0)\n"
+                 "  --adapter TYPE    'software' or 'hardware' (default: software)\n";
+}
+
+bool ParseOptions(int argc, char** argv, BenchmarkOptions& Options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* Arg = argv[i];
+        if (std::strcmp(Arg, "--help") == 0 || std::strcmp(Arg, "-h") == 0)
+        {
+            PrintUsage();
+            return false;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option " << Arg << "\n";
+            return false;
+        }
+        const char* Value = argv[++i];
+
+        auto ToUint = [Value]() {
+            return static_cast<Uint32>(std::strtoul(Value, nullptr, 10));
+        };
+
+        SyntheticStageDesc& Stage = Options.Stage;
+        if (std::strcmp(Arg, "--meshes") == 0)
+            Stage.MeshCount = ToUint();
+        else if (std::strcmp(Arg, "--instancing") == 0)
+            Stage.InstancingRatio = static_cast<float>(std::atof(Value));
+        else if (std::strcmp(Arg, "--prototypes") == 0)
+            Stage.PrototypeCount = ToUint();
+        else if (std::strcmp(Arg, "--materials") == 0)
+            Stage.MaterialCount = ToUint();
+        else if (std::strcmp(Arg, "--textures") == 0)
+            Stage.TextureCount = ToUint();
+        else if (std::strcmp(Arg, "--lights") == 0)
+            Stage.LightCount = ToUint();
+        else if (std::strcmp(Arg, "--skinned") == 0)
+            Stage.SkinnedMeshCount = ToUint();
+        else if (std::strcmp(Arg, "--joints") == 0)
+            Stage.JointCount = ToUint();
+        else if (std::strcmp(Arg, "--tessellation") == 0)
+            Stage.MeshTessellation = ToUint();
+        else if (std::strcmp(Arg, "--frames") == 0)
+            Stage.FrameCount = std::max(ToUint(), 1u);
+        else if (std::strcmp(Arg, "--seed") == 0)
+            Stage.Seed = ToUint();
+        else if (std::strcmp(Arg, "--warmup") == 0)
+            Options.WarmupFrames = ToUint();
+        else if (std::strcmp(Arg, "--width") == 0)
+            Options.Width = std::max(ToUint(), 1u);
+        else if (std::strcmp(Arg, "--height") == 0)
+            Options.Height = std::max(ToUint(), 1u);
+        else if (std::strcmp(Arg, "--adapter") == 0)
+            Options.SoftwareAdapter = std::strcmp(Value, "hardware") != 0;
+        else if (std::strcmp(Arg, "--primvars") == 0)
+        {
+            Stage.PrimvarFlags = SYNTHETIC_PRIMVAR_FLAG_NONE;
+            if (std::strcmp(Value, "none") != 0)
+            {
+                for (const char* c = Value; *c != '\0'; ++c)
+                {
+                    switch (*c)
+                    {
+                        case 'n': Stage.PrimvarFlags |= SYNTHETIC_PRIMVAR_FLAG_NORMALS; break;
+                        case 't': Stage.PrimvarFlags |= SYNTHETIC_PRIMVAR_FLAG_TEXCOORDS; break;
+                        case 'c': Stage.PrimvarFlags |= SYNTHETIC_PRIMVAR_FLAG_DISPLAY_COLOR; break;
+                        default:
+                            std::cerr << "Unknown primvar '" << *c << "'\n";
+                            return false;
+                    }
+                }
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown option " << Arg << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CreateDevice(bool SoftwareAdapter, RefCntAutoPtr<IRenderDevice>& pDevice, RefCntAutoPtr<IDeviceContext>& pContext)
+{
+#if EXPLICITLY_LOAD_ENGINE_VK_DLL
+    GetEngineFactoryVkType GetEngineFactoryVk = LoadGraphicsEngineVk();
+    if (GetEngineFactoryVk == nullptr)
+    {
+        std::cerr << "Failed to load Vulkan engine\n";
+        return false;
+    }
+#endif
+
+    IEngineFactoryVk* pFactoryVk = GetEngineFactoryVk();
+
+    EngineVkCreateInfo EngineCI;
+    EngineCI.Features = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+
+    Uint32 NumAdapters = 0;
+    pFactoryVk->EnumerateAdapters(EngineCI.GraphicsAPIVersion, NumAdapters, nullptr);
+    std::vector<GraphicsAdapterInfo> Adapters(NumAdapters);
+    if (NumAdapters > 0)
+        pFactoryVk->EnumerateAdapters(EngineCI.GraphicsAPIVersion, NumAdapters, Adapters.data());
+
+    EngineCI.AdapterId = DEFAULT_ADAPTER_ID;
+    for (Uint32 i = 0; i < NumAdapters; ++i)
+    {
+        if ((Adapters[i].Type == ADAPTER_TYPE_SOFTWARE) == SoftwareAdapter)
+        {
+            EngineCI.AdapterId = i;
+            break;
+        }
+    }
+    if (EngineCI.AdapterId == DEFAULT_ADAPTER_ID)
+    {
+        std::cerr << "No " << (SoftwareAdapter ? "software" : "hardware") << " Vulkan adapter found\n";
+        return false;
+    }
+    std::cout << "Adapter: " << Adapters[EngineCI.AdapterId].Description << "\n";
+
+    pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &pDevice, &pContext);
+    return pDevice && pContext;
+}
+
+struct TimingStats
+{
+    double Mean   = 0;
+    double Min    = 0;
+    double Median = 0;
+    double P95    = 0;
+    double Max    = 0;
+
+    explicit TimingStats(std::vector<double> Samples)
+    {
+        if (Samples.empty())
+            return;
+
+        std::sort(Samples.begin(), Samples.end());
+        for (double Sample : Samples)
+            Mean += Sample;
+        Mean /= static_cast<double>(Samples.size());
+        Min    = Samples.front();
+        Median = Samples[Samples.size() / 2];
+        P95    = Samples[std::min(Samples.size() * 95 / 100, Samples.size() - 1)];
+        Max    = Samples.back();
+    }
+};
+
+void PrintTimingHeader()
+{
+    std::cout << std::left << std::setw(28) << "" << std::right
+              << std::setw(10) << "mean" << std::setw(10) << "min" << std::setw(10) << "median"
+              << std::setw(10) << "p95" << std::setw(10) << "max" << "\n";
+}
+
+void PrintTiming(const char* Name, const std::vector<double>& Samples)
+{
+    const TimingStats Stats{Samples};
+    std::cout << std::left << std::setw(28) << Name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << Stats.Mean << std::setw(10) << Stats.Min << std::setw(10) << Stats.Median
+              << std::setw(10) << Stats.P95 << std::setw(10) << Stats.Max << "\n";
+}
+
+// Emulates pxr::HdEngine::Execute, but measures every phase separately
+class HydraFrameDriver
+{
+public:
+    struct FrameTimings
+    {
+        double Sync    = 0;
+        double Prepare = 0;
+        double Commit  = 0;
+        double Execute = 0;
+
+        double Total() const { return Sync + Prepare + Commit + Execute; }
+    };
+
+    HydraFrameDriver(pxr::HdRenderIndex& RenderIndex, HnTaskManager& TaskManager) :
+        m_RenderIndex{RenderIndex},
+        m_TaskManager{TaskManager}
+    {}
+
+    FrameTimings Execute()
+    {
+        pxr::HdTaskSharedPtrVector Tasks = m_TaskManager.GetTasks();
+
+        FrameTimings Timings;
+
+        double StartTime = m_Timer.GetElapsedTime();
+        auto   GetTime   = [&]() {
+            const double CurrTime = m_Timer.GetElapsedTime();
+            const double Elapsed  = (CurrTime - StartTime) * 1000.0;
+            StartTime             = CurrTime;
+            return Elapsed;
+        };
+
+        m_RenderIndex.SyncAll(&Tasks, &m_TaskCtx);
+        Timings.Sync = GetTime();
+
+        for (pxr::HdTaskSharedPtr& Task : Tasks)
+            Task->Prepare(&m_TaskCtx, &m_RenderIndex);
+        Timings.Prepare = GetTime();
+
+        m_RenderIndex.GetRenderDelegate()->CommitResources(&m_RenderIndex.GetChangeTracker());
+        Timings.Commit = GetTime();
+
+        for (pxr::HdTaskSharedPtr& Task : Tasks)
+            Task->Execute(&m_TaskCtx);
+        Timings.Execute = GetTime();
+
+        return Timings;
+    }
+
+private:
+    pxr::HdRenderIndex& m_RenderIndex;
+    HnTaskManager&      m_TaskManager;
+    pxr::HdTaskContext  m_TaskCtx;
+    Timer               m_Timer;
+};
+
+int RunBenchmark(const BenchmarkOptions& Options)
+{
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    if (!CreateDevice(Options.SoftwareAdapter, pDevice, pContext))
+    {
+        std::cerr << "Failed to create render device\n";
+        return EXIT_FAILURE;
+    }
+
+    Timer LoadTimer;
+    auto  GetLoadTime = [&LoadTimer]() {
+        const double Time = LoadTimer.GetElapsedTime() * 1000.0;
+        LoadTimer.Restart();
+        return Time;
+    };
+
+    SyntheticStageDesc StageDesc = Options.Stage;
+    {
+        const std::filesystem::path TextureDir = std::filesystem::temp_directory_path() / "HydrogentBenchmark";
+        std::filesystem::create_directories(TextureDir);
+        StageDesc.TextureDirectory = TextureDir.generic_string();
+    }
+
+    SyntheticStagePaths       StagePaths;
+    const pxr::UsdStageRefPtr Stage = CreateSyntheticStage(StageDesc, StagePaths);
+    if (!Stage)
+        return EXIT_FAILURE;
+    const double StageGenerationTime = GetLoadTime();
+
+    HnRenderDelegate::CreateInfo DelegateCI;
+    DelegateCI.pDevice       = pDevice;
+    DelegateCI.pContext      = pContext;
+    DelegateCI.UseVertexPool = true;
+    DelegateCI.UseIndexPool  = true;
+    DelegateCI.EnableShadows = StageDesc.LightCount > 0;
+    // Synchronous compilation makes every measured frame render the final PSOs
+    DelegateCI.AsyncShaderCompilation = false;
+
+    std::unique_ptr<HnRenderDelegate>    RenderDelegate = HnRenderDelegate::Create(DelegateCI);
+    std::unique_ptr<pxr::HdRenderIndex>  RenderIndex{pxr::HdRenderIndex::New(RenderDelegate.get(), {})};
+    const pxr::SdfPath                   SceneDelegateId = pxr::SdfPath::AbsoluteRootPath();
+    std::unique_ptr<pxr::UsdImagingDelegate> ImagingDelegate = std::make_unique<pxr::UsdImagingDelegate>(RenderIndex.get(), SceneDelegateId);
+    ImagingDelegate->Populate(Stage->GetPseudoRoot());
+    const double PopulateTime = GetLoadTime();
+
+    const pxr::SdfPath TaskManagerId = SceneDelegateId.AppendChild(pxr::TfToken{"_HnTaskManager_"});
+    std::unique_ptr<HnTaskManager> TaskManager = std::make_unique<HnTaskManager>(*RenderIndex, TaskManagerId);
+
+    // Offscreen final color target
+    RefCntAutoPtr<ITexture> pFinalColor;
+    {
+        TextureDesc Desc;
+        Desc.Name      = "Benchmark final color";
+        Desc.Type      = RESOURCE_DIM_TEX_2D;
+        Desc.Width     = Options.Width;
+        Desc.Height    = Options.Height;
+        Desc.Format    = TEX_FORMAT_RGBA8_UNORM_SRGB;
+        Desc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+        pDevice->CreateTexture(Desc, nullptr, &pFinalColor);
+        if (!pFinalColor)
+        {
+            std::cerr << "Failed to create final color target\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const pxr::SdfPath FinalColorTargetId = SceneDelegateId.AppendChild(pxr::TfToken{"_HnFinalColorTarget_"});
+    RenderIndex->InsertBprim(pxr::HdPrimTypeTokens->renderBuffer, ImagingDelegate.get(), FinalColorTargetId);
+    static_cast<HnRenderBuffer*>(RenderIndex->GetBprim(pxr::HdPrimTypeTokens->renderBuffer, FinalColorTargetId))->SetTarget(pFinalColor->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET));
+
+    {
+        HnBeginFrameTaskParams FrameParams;
+        FrameParams.FinalColorTargetId = FinalColorTargetId;
+        FrameParams.CameraId           = ImagingDelegate->ConvertCachePathToIndexPath(StagePaths.Camera);
+        TaskManager->SetFrameParams(FrameParams);
+    }
+
+    HydraFrameDriver FrameDriver{*RenderIndex, *TaskManager};
+
+    auto FinishFrame = [&]() {
+        pContext->Flush();
+        pContext->FinishFrame();
+        // Wait for the GPU so that frames do not overlap and the results are deterministic
+        pContext->WaitForIdle();
+        pDevice->ReleaseStaleResources();
+    };
+
+    // The first frame performs the initial sync of all prims
+    ImagingDelegate->SetTime(pxr::UsdTimeCode{0});
+    const HydraFrameDriver::FrameTimings FirstFrame = FrameDriver.Execute();
+    FinishFrame();
+
+    // Warm-up frames are excluded from all statistics
+    auto RunWarmupFrames = [&]() {
+        ImagingDelegate->SetTime(pxr::UsdTimeCode{0});
+        for (Uint32 i = 0; i < Options.WarmupFrames; ++i)
+        {
+            FrameDriver.Execute();
+            FinishFrame();
+        }
+    };
+    RunWarmupFrames();
+
+    // Measure the time to re-sync all prims of every type
+    struct ResyncTiming
+    {
+        std::string Type;
+        size_t      Count = 0;
+        double      Sync  = 0;
+
+        double Commit = 0;
+    };
+    std::vector<ResyncTiming> ResyncTimings;
+    {
+        pxr::HdChangeTracker& ChangeTracker = RenderIndex->GetChangeTracker();
+
+        const pxr::SdfPathVector& RPrimIds = RenderIndex->GetRprimIds();
+        if (!RPrimIds.empty())
+        {
+            for (const pxr::SdfPath& Id : RPrimIds)
+                ChangeTracker.MarkRprimDirty(Id, pxr::HdChangeTracker::AllDirty);
+            const HydraFrameDriver::FrameTimings Timings = FrameDriver.Execute();
+            FinishFrame();
+            ResyncTimings.push_back({"mesh", RPrimIds.size(), Timings.Sync, Timings.Commit});
+        }
+
+        for (const pxr::TfToken& SPrimType : RenderDelegate->GetSupportedSprimTypes())
+        {
+            const pxr::SdfPathVector SPrimIds = RenderIndex->GetSprimSubtree(SPrimType, pxr::SdfPath::AbsoluteRootPath());
+            if (SPrimIds.empty())
+                continue;
+
+            for (const pxr::SdfPath& Id : SPrimIds)
+                ChangeTracker.MarkSprimDirty(Id, pxr::HdChangeTracker::AllDirty);
+            const HydraFrameDriver::FrameTimings Timings = FrameDriver.Execute();
+            FinishFrame();
+            ResyncTimings.push_back({SPrimType.GetString(), SPrimIds.size(), Timings.Sync, Timings.Commit});
+        }
+    }
+
+    // The re-sync recreates GPU resources, so warm up again before the measured frames
+    RunWarmupFrames();
+
+    // Measured frames follow the camera path. The CPU statistics and the task profiler
+    // cover the same StageDesc.FrameCount frames.
+    TaskManager->EnableProfiling(true, StageDesc.FrameCount);
+
+    std::vector<double> SyncTimes, PrepareTimes, CommitTimes, ExecuteTimes, FrameTimes;
+    for (Uint32 frame = 1; frame <= StageDesc.FrameCount; ++frame)
+    {
+        ImagingDelegate->SetTime(pxr::UsdTimeCode{static_cast<double>(frame)});
+        const HydraFrameDriver::FrameTimings Timings = FrameDriver.Execute();
+        FinishFrame();
+
+        SyncTimes.push_back(Timings.Sync);
+        PrepareTimes.push_back(Timings.Prepare);
+        CommitTimes.push_back(Timings.Commit);
+        ExecuteTimes.push_back(Timings.Execute);
+        FrameTimes.push_back(Timings.Total());
+    }
+    // Let the profiler publish the results of the last frame
+    FrameDriver.Execute();
+    FinishFrame();
+
+    // Report
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nStage: " << StageDesc.MeshCount << " meshes (" << StageDesc.InstancingRatio * 100.f << "% instanced), "
+              << StageDesc.MaterialCount << " materials, " << StageDesc.TextureCount << " textures, "
+              << StageDesc.LightCount << " lights, " << StageDesc.SkinnedMeshCount << " skinned meshes\n\n";
+
+    std::cout << "Stage load (ms):\n"
+              << "  Stage generation        " << std::setw(12) << StageGenerationTime << "\n"
+              << "  Populate                " << std::setw(12) << PopulateTime << "\n"
+              << "  Initial sync            " << std::setw(12) << FirstFrame.Sync << "\n"
+              << "  Initial CommitResources " << std::setw(12) << FirstFrame.Commit << "\n"
+              << "  First frame total       " << std::setw(12) << FirstFrame.Total() << "\n\n";
+
+    std::cout << "Full re-sync per prim type (ms):\n";
+    for (const ResyncTiming& Resync : ResyncTimings)
+    {
+        std::cout << "  " << std::left << std::setw(16) << Resync.Type << std::right << std::setw(8) << Resync.Count << " prims"
+                  << "  Sync " << std::setw(10) << Resync.Sync << "  CommitResources " << std::setw(10) << Resync.Commit << "\n";
+    }
+
+    std::cout << "\nPer-frame CPU time (ms), " << FrameTimes.size() << " frames:\n";
+    PrintTimingHeader();
+    PrintTiming("  Sync", SyncTimes);
+    PrintTiming("  Prepare", PrepareTimes);
+    PrintTiming("  CommitResources", CommitTimes);
+    PrintTiming("  Execute", ExecuteTimes);
+    PrintTiming("  Total", FrameTimes);
+
+    std::cout << "\nPer-task average (ms):\n"
+              << std::left << std::setw(48) << "  Task" << std::right
+              << std::setw(10) << "Prepare" << std::setw(10) << "Execute" << std::setw(10) << "GPU"
+              << std::setw(8) << "Draws" << std::setw(8) << "PSOs" << std::setw(8) << "SRBs" << std::setw(12) << "Bytes" << "\n";
+    for (const HnTaskProfile& Profile : TaskManager->GetTaskProfile())
+    {
+        std::cout << "  " << std::left << std::setw(46) << Profile.TaskId.GetName() << std::right
+                  << std::setw(10) << Profile.PrepareCPUTime << std::setw(10) << Profile.ExecuteCPUTime << std::setw(10) << Profile.ExecuteGPUTime
+                  << std::setw(8) << Profile.RenderPassStats.NumDrawCalls << std::setw(8) << Profile.RenderPassStats.NumPSOChanges
+                  << std::setw(8) << Profile.RenderPassStats.NumSRBCommits << std::setw(12) << Profile.RenderPassStats.NumBytesMapped << "\n";
+    }
+
+    const HnRenderDelegateMemoryStats MemStats = RenderDelegate->GetMemoryStats();
+    std::cout << "\nMemory:\n"
+              << "  Index pool:    " << MemStats.IndexPool.UsedSize << " / " << MemStats.IndexPool.CommittedSize << " bytes, "
+              << MemStats.IndexPool.AllocationCount << " allocations\n"
+              << "  Vertex pool:   " << MemStats.VertexPool.UsedSize << " / " << MemStats.VertexPool.CommittedSize << " bytes, "
+              << MemStats.VertexPool.AllocationCount << " allocations, " << MemStats.VertexPool.AllocatedVertexCount << " vertices\n"
+              << "  Texture atlas: " << MemStats.Atlas.AllocatedTexels << " / " << MemStats.Atlas.TotalTexels << " texels, "
+              << MemStats.Atlas.CommittedSize << " bytes, " << MemStats.Atlas.AllocationCount << " allocations\n";
+
+    // Release Hydra objects in the reverse order of creation
+    TaskManager.reset();
+    ImagingDelegate.reset();
+    RenderIndex.reset();
+    RenderDelegate.reset();
+
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions Options;
+    if (!ParseOptions(argc, argv, Options))
+        return EXIT_FAILURE;
+
+    return RunBenchmark(Options);
+}
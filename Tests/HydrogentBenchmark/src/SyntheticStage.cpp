@@ -0,0 +1,513 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "SyntheticStage.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/rotation.h"
+#include "pxr/base/gf/vec3h.h"
+#include "pxr/usd/sdf/types.h"
+#include "pxr/usd/usdGeom/camera.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/metrics.h"
+#include "pxr/usd/usdGeom/primvarsAPI.h"
+#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdLux/distantLight.h"
+#include "pxr/usd/usdLux/shadowAPI.h"
+#include "pxr/usd/usdLux/sphereLight.h"
+#include "pxr/usd/usdShade/material.h"
+#include "pxr/usd/usdShade/materialBindingAPI.h"
+#include "pxr/usd/usdShade/shader.h"
+#include "pxr/usd/usdSkel/animation.h"
+#include "pxr/usd/usdSkel/bindingAPI.h"
+#include "pxr/usd/usdSkel/root.h"
+#include "pxr/usd/usdSkel/skeleton.h"
+
+#include "Image.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "BasicMath.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace USD
+{
+
+namespace
+{
+
+// std::uniform_*_distribution are implementation-defined, so we use
+// a simple generator that produces the same sequence on all platforms.
+class Random
+{
+public:
+    explicit Random(Uint32 Seed) :
+        m_State{Seed * 747796405u + 2891336453u}
+    {}
+
+    Uint32 NextUint()
+    {
+        // PCG hash
+        m_State           = m_State * 747796405u + 2891336453u;
+        const Uint32 Word = ((m_State >> ((m_State >> 28u) + 4u)) ^ m_State) * 277803737u;
+        return (Word >> 22u) ^ Word;
+    }
+
+    // Returns a value in [0, 1)
+    float NextFloat()
+    {
+        return static_cast<float>(NextUint() >> 8u) * (1.f / 16777216.f);
+    }
+
+    float NextFloat(float Min, float Max)
+    {
+        return Min + (Max - Min) * NextFloat();
+    }
+
+private:
+    Uint32 m_State;
+};
+
+struct MeshGeometry
+{
+    pxr::VtVec3fArray Points;
+    pxr::VtVec3fArray Normals;
+    pxr::VtVec2fArray TexCoords;
+    pxr::VtIntArray   FaceVertexCounts;
+    pxr::VtIntArray   FaceVertexIndices;
+};
+
+// Generates a UV sphere with the given radius and height scale
+MeshGeometry CreateSphereGeometry(Uint32 Tessellation, float Radius, float HeightScale)
+{
+    const Uint32 NumRings    = std::max(Tessellation, 3u);
+    const Uint32 NumSegments = std::max(Tessellation * 2, 3u);
+
+    MeshGeometry Geometry;
+    Geometry.Points.reserve((NumRings + 1) * (NumSegments + 1));
+    for (Uint32 ring = 0; ring <= NumRings; ++ring)
+    {
+        const float Theta = PI_F * static_cast<float>(ring) / static_cast<float>(NumRings);
+        for (Uint32 seg = 0; seg <= NumSegments; ++seg)
+        {
+            const float Phi = 2.f * PI_F * static_cast<float>(seg) / static_cast<float>(NumSegments);
+
+            const pxr::GfVec3f Normal{std::sin(Theta) * std::cos(Phi), std::cos(Theta), std::sin(Theta) * std::sin(Phi)};
+            Geometry.Points.push_back({Normal[0] * Radius, Normal[1] * Radius * HeightScale, Normal[2] * Radius});
+            Geometry.Normals.push_back(Normal);
+            Geometry.TexCoords.push_back({static_cast<float>(seg) / static_cast<float>(NumSegments), 1.f - static_cast<float>(ring) / static_cast<float>(NumRings)});
+        }
+    }
+
+    for (Uint32 ring = 0; ring < NumRings; ++ring)
+    {
+        for (Uint32 seg = 0; seg < NumSegments; ++seg)
+        {
+            const int v0 = static_cast<int>(ring * (NumSegments + 1) + seg);
+            const int v1 = v0 + 1;
+            const int v2 = v0 + static_cast<int>(NumSegments + 1);
+            const int v3 = v2 + 1;
+            Geometry.FaceVertexCounts.push_back(4);
+            Geometry.FaceVertexIndices.push_back(v0);
+            Geometry.FaceVertexIndices.push_back(v1);
+            Geometry.FaceVertexIndices.push_back(v3);
+            Geometry.FaceVertexIndices.push_back(v2);
+        }
+    }
+
+    return Geometry;
+}
+
+pxr::UsdGeomMesh DefineMesh(pxr::UsdStageRefPtr& Stage, const pxr::SdfPath& Path, const MeshGeometry& Geometry, SYNTHETIC_PRIMVAR_FLAGS PrimvarFlags, const pxr::GfVec3f& Color)
+{
+    pxr::UsdGeomMesh Mesh = pxr::UsdGeomMesh::Define(Stage, Path);
+    Mesh.CreatePointsAttr().Set(Geometry.Points);
+    Mesh.CreateFaceVertexCountsAttr().Set(Geometry.FaceVertexCounts);
+    Mesh.CreateFaceVertexIndicesAttr().Set(Geometry.FaceVertexIndices);
+    Mesh.CreateSubdivisionSchemeAttr().Set(pxr::UsdGeomTokens->none);
+
+    pxr::GfRange3f Extent;
+    for (const pxr::GfVec3f& Point : Geometry.Points)
+        Extent.UnionWith(Point);
+    Mesh.CreateExtentAttr().Set(pxr::VtVec3fArray{Extent.GetMin(), Extent.GetMax()});
+
+    if (PrimvarFlags & SYNTHETIC_PRIMVAR_FLAG_NORMALS)
+    {
+        Mesh.CreateNormalsAttr().Set(Geometry.Normals);
+        Mesh.SetNormalsInterpolation(pxr::UsdGeomTokens->vertex);
+    }
+
+    pxr::UsdGeomPrimvarsAPI PrimvarsAPI{Mesh.GetPrim()};
+    if (PrimvarFlags & SYNTHETIC_PRIMVAR_FLAG_TEXCOORDS)
+    {
+        PrimvarsAPI.CreatePrimvar(pxr::TfToken{"st"}, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->vertex).Set(Geometry.TexCoords);
+    }
+
+    if (PrimvarFlags & SYNTHETIC_PRIMVAR_FLAG_DISPLAY_COLOR)
+    {
+        Mesh.CreateDisplayColorPrimvar(pxr::UsdGeomTokens->constant).Set(pxr::VtVec3fArray{Color});
+    }
+
+    return Mesh;
+}
+
+std::string WriteTexture(const std::string& Directory, Uint32 Index, Uint32 Size, Random& Rnd)
+{
+    const Uint32 CheckerSize = std::max(Size / 8u, 1u);
+    const Uint8  Color0[]    = {static_cast<Uint8>(Rnd.NextUint() & 0xFFu), static_cast<Uint8>(Rnd.NextUint() & 0xFFu), static_cast<Uint8>(Rnd.NextUint() & 0xFFu)};
+    const Uint8  Color1[]    = {static_cast<Uint8>(255u - Color0[0]), static_cast<Uint8>(255u - Color0[1]), static_cast<Uint8>(255u - Color0[2])};
+
+    std::vector<Uint8> Pixels(size_t{Size} * Size * 4);
+    for (Uint32 y = 0; y < Size; ++y)
+    {
+        for (Uint32 x = 0; x < Size; ++x)
+        {
+            const Uint8* Color = (((x / CheckerSize) + (y / CheckerSize)) & 0x01u) ? Color1 : Color0;
+            Uint8*       Dst   = &Pixels[(size_t{y} * Size + x) * 4];
+            Dst[0]             = Color[0];
+            Dst[1]             = Color[1];
+            Dst[2]             = Color[2];
+            Dst[3]             = 255;
+        }
+    }
+
+    Image::EncodeInfo EncodeInfo;
+    EncodeInfo.Width      = Size;
+    EncodeInfo.Height     = Size;
+    EncodeInfo.TexFormat  = TEX_FORMAT_RGBA8_UNORM;
+    EncodeInfo.pData      = Pixels.data();
+    EncodeInfo.Stride     = Size * 4;
+    EncodeInfo.FileFormat = IMAGE_FILE_FORMAT_PNG;
+
+    RefCntAutoPtr<IDataBlob> pEncodedData;
+    Image::Encode(EncodeInfo, &pEncodedData);
+    if (!pEncodedData)
+    {
+        LOG_ERROR_MESSAGE("Failed to encode texture ", Index);
+        return {};
+    }
+
+    const std::string Path = Directory + "/SyntheticTexture" + std::to_string(Index) + ".png";
+
+    std::ofstream File{Path, std::ios::binary};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open file ", Path);
+        return {};
+    }
+    File.write(static_cast<const char*>(pEncodedData->GetConstDataPtr()), static_cast<std::streamsize>(pEncodedData->GetSize()));
+
+    return Path;
+}
+
+pxr::UsdShadeMaterial DefineMaterial(pxr::UsdStageRefPtr& Stage, const pxr::SdfPath& Path, const std::string& TexturePath, Random& Rnd)
+{
+    pxr::UsdShadeMaterial Material = pxr::UsdShadeMaterial::Define(Stage, Path);
+
+    pxr::UsdShadeShader Surface = pxr::UsdShadeShader::Define(Stage, Path.AppendChild(pxr::TfToken{"PreviewSurface"}));
+    Surface.CreateIdAttr().Set(pxr::TfToken{"UsdPreviewSurface"});
+    Surface.CreateInput(pxr::TfToken{"roughness"}, pxr::SdfValueTypeNames->Float).Set(Rnd.NextFloat(0.1f, 1.f));
+    Surface.CreateInput(pxr::TfToken{"metallic"}, pxr::SdfValueTypeNames->Float).Set(Rnd.NextFloat() < 0.5f ? 0.f : 1.f);
+
+    pxr::UsdShadeInput DiffuseColor = Surface.CreateInput(pxr::TfToken{"diffuseColor"}, pxr::SdfValueTypeNames->Color3f);
+    if (!TexturePath.empty())
+    {
+        pxr::UsdShadeShader StReader = pxr::UsdShadeShader::Define(Stage, Path.AppendChild(pxr::TfToken{"StReader"}));
+        StReader.CreateIdAttr().Set(pxr::TfToken{"UsdPrimvarReader_float2"});
+        StReader.CreateInput(pxr::TfToken{"varname"}, pxr::SdfValueTypeNames->Token).Set(pxr::TfToken{"st"});
+
+        pxr::UsdShadeShader Texture = pxr::UsdShadeShader::Define(Stage, Path.AppendChild(pxr::TfToken{"DiffuseTexture"}));
+        Texture.CreateIdAttr().Set(pxr::TfToken{"UsdUVTexture"});
+        Texture.CreateInput(pxr::TfToken{"file"}, pxr::SdfValueTypeNames->Asset).Set(pxr::SdfAssetPath{TexturePath});
+        Texture.CreateInput(pxr::TfToken{"st"}, pxr::SdfValueTypeNames->Float2).ConnectToSource(StReader.ConnectableAPI(), pxr::TfToken{"result"});
+        Texture.CreateOutput(pxr::TfToken{"rgb"}, pxr::SdfValueTypeNames->Float3);
+
+        DiffuseColor.ConnectToSource(Texture.ConnectableAPI(), pxr::TfToken{"rgb"});
+    }
+    else
+    {
+        DiffuseColor.Set(pxr::GfVec3f{Rnd.NextFloat(), Rnd.NextFloat(), Rnd.NextFloat()});
+    }
+
+    Material.CreateSurfaceOutput().ConnectToSource(Surface.ConnectableAPI(), pxr::TfToken{"surface"});
+
+    return Material;
+}
+
+void DefineSkinnedMesh(pxr::UsdStageRefPtr&      Stage,
+                       const pxr::SdfPath&       Path,
+                       const SyntheticStageDesc& Desc,
+                       const pxr::GfVec3f&       Position,
+                       Random&                   Rnd)
+{
+    pxr::UsdSkelRoot SkelRoot = pxr::UsdSkelRoot::Define(Stage, Path);
+    SkelRoot.AddTranslateOp().Set(pxr::GfVec3d{Position});
+
+    const Uint32 JointCount   = std::max(Desc.JointCount, 1u);
+    const float  Height       = 2.f;
+    const float  JointSpacing = Height / static_cast<float>(JointCount);
+
+    // A chain of joints along the Y axis
+    pxr::VtTokenArray    Joints;
+    pxr::VtMatrix4dArray BindTransforms;
+    pxr::VtMatrix4dArray RestTransforms;
+    std::string          JointPath;
+    for (Uint32 j = 0; j < JointCount; ++j)
+    {
+        JointPath += (j > 0 ? "/j" : "j") + std::to_string(j);
+        Joints.push_back(pxr::TfToken{JointPath});
+
+        pxr::GfMatrix4d BindXform{1};
+        BindXform.SetTranslate(pxr::GfVec3d{0, -Height * 0.5 + j * JointSpacing, 0});
+        BindTransforms.push_back(BindXform);
+
+        pxr::GfMatrix4d RestXform{1};
+        RestXform.SetTranslate(pxr::GfVec3d{0, j > 0 ? JointSpacing : -Height * 0.5, 0});
+        RestTransforms.push_back(RestXform);
+    }
+
+    pxr::UsdSkelSkeleton Skeleton = pxr::UsdSkelSkeleton::Define(Stage, Path.AppendChild(pxr::TfToken{"Skeleton"}));
+    Skeleton.CreateJointsAttr().Set(Joints);
+    Skeleton.CreateBindTransformsAttr().Set(BindTransforms);
+    Skeleton.CreateRestTransformsAttr().Set(RestTransforms);
+
+    pxr::UsdSkelAnimation Animation = pxr::UsdSkelAnimation::Define(Stage, Path.AppendChild(pxr::TfToken{"Animation"}));
+    Animation.CreateJointsAttr().Set(Joints);
+    {
+        pxr::VtVec3fArray Translations(JointCount);
+        pxr::VtVec3hArray Scales(JointCount, pxr::GfVec3h{1, 1, 1});
+        for (Uint32 j = 0; j < JointCount; ++j)
+        {
+            const pxr::GfVec3d T = RestTransforms[j].ExtractTranslation();
+            Translations[j]      = pxr::GfVec3f{T};
+        }
+        Animation.CreateTranslationsAttr().Set(Translations);
+        Animation.CreateScalesAttr().Set(Scales);
+
+        const float       Phase         = Rnd.NextFloat(0, 2.f * PI_F);
+        pxr::UsdAttribute RotationsAttr = Animation.CreateRotationsAttr();
+        pxr::VtQuatfArray Rotations(JointCount);
+        for (Uint32 frame = 0; frame <= Desc.FrameCount; ++frame)
+        {
+            for (Uint32 j = 0; j < JointCount; ++j)
+            {
+                const double Angle = 20.0 * std::sin(Phase + frame * 0.1 + j * 0.5);
+                Rotations[j]       = pxr::GfQuatf{pxr::GfRotation{pxr::GfVec3d{0, 0, 1}, Angle}.GetQuat()};
+            }
+            RotationsAttr.Set(Rotations, pxr::UsdTimeCode{static_cast<double>(frame)});
+        }
+    }
+    pxr::UsdSkelBindingAPI::Apply(Skeleton.GetPrim()).CreateAnimationSourceRel().SetTargets({Animation.GetPath()});
+
+    const MeshGeometry Geometry = CreateSphereGeometry(Desc.MeshTessellation, 0.5f, Height);
+    pxr::UsdGeomMesh   Mesh     = DefineMesh(Stage, Path.AppendChild(pxr::TfToken{"Mesh"}), Geometry, Desc.PrimvarFlags,
+                                             pxr::GfVec3f{Rnd.NextFloat(), Rnd.NextFloat(), Rnd.NextFloat()});
+
+    // Every vertex is influenced by the two closest joints
+    constexpr int     NumInfluences = 2;
+    pxr::VtIntArray   JointIndices(Geometry.Points.size() * NumInfluences);
+    pxr::VtFloatArray JointWeights(Geometry.Points.size() * NumInfluences);
+    for (size_t v = 0; v < Geometry.Points.size(); ++v)
+    {
+        const float JointPos = clamp((Geometry.Points[v][1] + Height * 0.5f) / JointSpacing, 0.f, static_cast<float>(JointCount - 1));
+        const int   Joint0   = static_cast<int>(JointPos);
+        const int   Joint1   = std::min(Joint0 + 1, static_cast<int>(JointCount - 1));
+        const float Weight1  = JointPos - static_cast<float>(Joint0);
+
+        JointIndices[v * NumInfluences + 0] = Joint0;
+        JointIndices[v * NumInfluences + 1] = Joint1;
+        JointWeights[v * NumInfluences + 0] = 1.f - Weight1;
+        JointWeights[v * NumInfluences + 1] = Weight1;
+    }
+
+    pxr::UsdSkelBindingAPI MeshBinding = pxr::UsdSkelBindingAPI::Apply(Mesh.GetPrim());
+    MeshBinding.CreateSkeletonRel().SetTargets({Skeleton.GetPath()});
+    MeshBinding.CreateJointIndicesPrimvar(false, NumInfluences).Set(JointIndices);
+    MeshBinding.CreateJointWeightsPrimvar(false, NumInfluences).Set(JointWeights);
+    MeshBinding.CreateGeomBindTransformAttr().Set(pxr::GfMatrix4d{1});
+}
+
+} // namespace
+
+pxr::UsdStageRefPtr CreateSyntheticStage(const SyntheticStageDesc& Desc, SyntheticStagePaths& Paths)
+{
+    pxr::UsdStageRefPtr Stage = pxr::UsdStage::CreateInMemory();
+    if (!Stage)
+    {
+        LOG_ERROR_MESSAGE("Failed to create in-memory USD stage");
+        return {};
+    }
+
+    Stage->SetStartTimeCode(0);
+    Stage->SetEndTimeCode(Desc.FrameCount);
+    pxr::UsdGeomSetStageUpAxis(Stage, pxr::UsdGeomTokens->y);
+
+    Random Rnd{Desc.Seed};
+
+    // Textures
+    std::vector<std::string> TexturePaths;
+    if ((Desc.PrimvarFlags & SYNTHETIC_PRIMVAR_FLAG_TEXCOORDS) != 0 && !Desc.TextureDirectory.empty())
+    {
+        for (Uint32 i = 0; i < Desc.TextureCount; ++i)
+        {
+            std::string Path = WriteTexture(Desc.TextureDirectory, i, Desc.TextureSize, Rnd);
+            if (!Path.empty())
+                TexturePaths.emplace_back(std::move(Path));
+        }
+    }
+
+    // Materials
+    std::vector<pxr::UsdShadeMaterial> Materials;
+    Materials.reserve(Desc.MaterialCount);
+    for (Uint32 i = 0; i < Desc.MaterialCount; ++i)
+    {
+        const std::string& TexturePath = !TexturePaths.empty() ? TexturePaths[i % TexturePaths.size()] : std::string{};
+        Materials.emplace_back(DefineMaterial(Stage, pxr::SdfPath{"/Materials/Material" + std::to_string(i)}, TexturePath, Rnd));
+    }
+
+    auto BindMaterial = [&](const pxr::UsdPrim& Prim, Uint32 Index) {
+        if (!Materials.empty())
+            pxr::UsdShadeMaterialBindingAPI::Apply(Prim).Bind(Materials[Index % Materials.size()]);
+    };
+
+    // Meshes are placed on a regular grid
+    const Uint32    TotalMeshCount = Desc.MeshCount + Desc.SkinnedMeshCount;
+    const Uint32    GridSize       = std::max(static_cast<Uint32>(std::ceil(std::cbrt(static_cast<double>(TotalMeshCount)))), 1u);
+    constexpr float CellSize       = 3.f;
+
+    auto GetGridPosition = [&](Uint32 Index) {
+        const float Offset = -static_cast<float>(GridSize - 1) * CellSize * 0.5f;
+        return pxr::GfVec3f{
+            Offset + static_cast<float>(Index % GridSize) * CellSize,
+            Offset + static_cast<float>((Index / GridSize) % GridSize) * CellSize,
+            Offset + static_cast<float>(Index / (GridSize * GridSize)) * CellSize,
+        };
+    };
+
+    const Uint32 InstanceCount  = Desc.PrototypeCount > 0 ? static_cast<Uint32>(static_cast<float>(Desc.MeshCount) * clamp(Desc.InstancingRatio, 0.f, 1.f)) : 0;
+    const Uint32 PrototypeCount = InstanceCount > 0 ? std::min(Desc.PrototypeCount, InstanceCount) : 0;
+
+    // Prototypes are defined as class prims so that they are not rendered
+    for (Uint32 i = 0; i < PrototypeCount; ++i)
+    {
+        const pxr::SdfPath ProtoPath{"/Prototypes/Prototype" + std::to_string(i)};
+        Stage->CreateClassPrim(ProtoPath);
+
+        const MeshGeometry Geometry = CreateSphereGeometry(Desc.MeshTessellation, Rnd.NextFloat(0.5f, 1.f), Rnd.NextFloat(0.5f, 1.5f));
+        pxr::UsdGeomMesh   Mesh     = DefineMesh(Stage, ProtoPath.AppendChild(pxr::TfToken{"Mesh"}), Geometry, Desc.PrimvarFlags,
+                                                 pxr::GfVec3f{Rnd.NextFloat(), Rnd.NextFloat(), Rnd.NextFloat()});
+        BindMaterial(Mesh.GetPrim(), i);
+    }
+
+    for (Uint32 i = 0; i < Desc.MeshCount; ++i)
+    {
+        const pxr::SdfPath    Path{"/Meshes/Mesh" + std::to_string(i)};
+        const pxr::GfVec3f    Position = GetGridPosition(i);
+        pxr::UsdGeomXformable Xformable;
+        if (i < InstanceCount)
+        {
+            pxr::UsdGeomXform Xform = pxr::UsdGeomXform::Define(Stage, Path);
+            Xform.GetPrim().GetReferences().AddInternalReference(pxr::SdfPath{"/Prototypes/Prototype" + std::to_string(i % PrototypeCount)});
+            Xform.GetPrim().SetInstanceable(true);
+            Xformable = Xform;
+        }
+        else
+        {
+            const MeshGeometry Geometry = CreateSphereGeometry(Desc.MeshTessellation, Rnd.NextFloat(0.5f, 1.f), Rnd.NextFloat(0.5f, 1.5f));
+            pxr::UsdGeomMesh   Mesh     = DefineMesh(Stage, Path, Geometry, Desc.PrimvarFlags,
+                                                     pxr::GfVec3f{Rnd.NextFloat(), Rnd.NextFloat(), Rnd.NextFloat()});
+            BindMaterial(Mesh.GetPrim(), i);
+            Xformable = Mesh;
+        }
+        Xformable.AddTranslateOp().Set(pxr::GfVec3d{Position});
+        Xformable.AddRotateYOp().Set(Rnd.NextFloat(0.f, 360.f));
+    }
+
+    for (Uint32 i = 0; i < Desc.SkinnedMeshCount; ++i)
+    {
+        DefineSkinnedMesh(Stage, pxr::SdfPath{"/Skinned/SkelRoot" + std::to_string(i)}, Desc, GetGridPosition(Desc.MeshCount + i), Rnd);
+    }
+
+    const float SceneRadius = static_cast<float>(GridSize) * CellSize * 0.5f;
+
+    // Lights
+    for (Uint32 i = 0; i < Desc.LightCount; ++i)
+    {
+        if (i == 0)
+        {
+            pxr::UsdLuxDistantLight Light = pxr::UsdLuxDistantLight::Define(Stage, pxr::SdfPath{"/Lights/DistantLight"});
+            Light.CreateIntensityAttr().Set(3.f);
+            Light.AddRotateXYZOp().Set(pxr::GfVec3f{-45.f, 30.f, 0.f});
+            pxr::UsdLuxShadowAPI::Apply(Light.GetPrim()).CreateShadowEnableAttr().Set(true);
+        }
+        else
+        {
+            pxr::UsdLuxSphereLight Light = pxr::UsdLuxSphereLight::Define(Stage, pxr::SdfPath{"/Lights/SphereLight" + std::to_string(i)});
+            Light.CreateIntensityAttr().Set(Rnd.NextFloat(10.f, 50.f));
+            Light.CreateColorAttr().Set(pxr::GfVec3f{Rnd.NextFloat(0.5f, 1.f), Rnd.NextFloat(0.5f, 1.f), Rnd.NextFloat(0.5f, 1.f)});
+            Light.CreateRadiusAttr().Set(0.1f);
+            Light.AddTranslateOp().Set(pxr::GfVec3d{
+                Rnd.NextFloat(-SceneRadius, SceneRadius),
+                Rnd.NextFloat(-SceneRadius, SceneRadius),
+                Rnd.NextFloat(-SceneRadius, SceneRadius),
+            });
+        }
+    }
+
+    // Camera orbits around the scene
+    {
+        Paths.Camera = pxr::SdfPath{"/Camera"};
+
+        pxr::UsdGeomCamera Camera = pxr::UsdGeomCamera::Define(Stage, Paths.Camera);
+        Camera.CreateClippingRangeAttr().Set(pxr::GfVec2f{0.1f, SceneRadius * 8.f});
+
+        pxr::UsdGeomXformOp TransformOp = Camera.AddTransformOp();
+        for (Uint32 frame = 0; frame <= Desc.FrameCount; ++frame)
+        {
+            const double Angle = 2.0 * PI * frame / std::max(Desc.FrameCount, 1u);
+            const double Dist  = SceneRadius * 2.5;
+
+            const pxr::GfVec3d Eye{Dist * std::cos(Angle), SceneRadius * 0.5, Dist * std::sin(Angle)};
+
+            pxr::GfMatrix4d View;
+            View.SetLookAt(Eye, pxr::GfVec3d{0, 0, 0}, pxr::GfVec3d{0, 1, 0});
+            TransformOp.Set(View.GetInverse(), pxr::UsdTimeCode{static_cast<double>(frame)});
+        }
+    }
+
+    return Stage;
+}
+
+} // namespace USD
+
+} // namespace Diligent
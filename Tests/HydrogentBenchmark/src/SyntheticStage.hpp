@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <string>
+
+#include "pxr/usd/usd/stage.h"
+
+#include "BasicTypes.h"
+#include "FlagEnum.h"
+
+namespace Diligent
+{
+
+namespace USD
+{
+
+/// Primvar layout of the generated meshes.
+enum SYNTHETIC_PRIMVAR_FLAGS : Uint32
+{
+    SYNTHETIC_PRIMVAR_FLAG_NONE          = 0,
+    SYNTHETIC_PRIMVAR_FLAG_NORMALS       = 1u << 0u,
+    SYNTHETIC_PRIMVAR_FLAG_TEXCOORDS     = 1u << 1u,
+    SYNTHETIC_PRIMVAR_FLAG_DISPLAY_COLOR = 1u << 2u,
+    SYNTHETIC_PRIMVAR_FLAG_ALL           = (SYNTHETIC_PRIMVAR_FLAG_DISPLAY_COLOR << 1u) - 1u
+};
+DEFINE_FLAG_ENUM_OPERATORS(SYNTHETIC_PRIMVAR_FLAGS);
+
+/// Synthetic stage description.
+struct SyntheticStageDesc
+{
+    /// The total number of meshes, including instances.
+    Uint32 MeshCount = 1000;
+
+    /// The fraction of meshes that are instances of shared prototypes, in [0, 1].
+    float InstancingRatio = 0;
+
+    /// The number of prototypes shared by instanced meshes.
+    Uint32 PrototypeCount = 16;
+
+    /// The number of materials. If zero, meshes are not bound to any material.
+    Uint32 MaterialCount = 32;
+
+    /// The number of textures shared by materials.
+    /// Textures are only used if the meshes have texture coordinates.
+    Uint32 TextureCount = 8;
+
+    /// Texture resolution.
+    Uint32 TextureSize = 256;
+
+    /// The number of lights. The first light is a distant light that casts shadows,
+    /// all other lights are sphere lights.
+    Uint32 LightCount = 4;
+
+    /// The number of skinned meshes. Every skinned mesh has its own skeleton and animation.
+    Uint32 SkinnedMeshCount = 0;
+
+    /// The number of joints in every skeleton.
+    Uint32 JointCount = 16;
+
+    /// The number of segments along the latitude and longitude of every mesh.
+    Uint32 MeshTessellation = 16;
+
+    /// Mesh primvar layout.
+    SYNTHETIC_PRIMVAR_FLAGS PrimvarFlags = SYNTHETIC_PRIMVAR_FLAG_ALL;
+
+    /// The number of frames of the camera path and skeletal animations.
+    Uint32 FrameCount = 300;
+
+    /// Random seed.
+    Uint32 Seed = 0;
+
+    /// Directory where the generated textures are written.
+    std::string TextureDirectory;
+};
+
+/// Paths of the prims in the synthetic stage.
+struct SyntheticStagePaths
+{
+    pxr::SdfPath Camera;
+};
+
+/// Generates a synthetic USD stage in memory.
+///
+/// \remarks    The generated stage only depends on the description, so the same description
+///             always produces the same stage on all platforms.
+pxr::UsdStageRefPtr CreateSyntheticStage(const SyntheticStageDesc& Desc, SyntheticStagePaths& Paths);
+
+} // namespace USD
+
+} // namespace Diligent
@@ -0,0 +1,139 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "Texture.h"
+#include "Fence.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Returns the path of the texture cache file in the form <CacheDirectory>/<Name>_<Hash>.dds.
+std::string GetTextureCacheFilePath(const char* CacheDirectory, const char* Name, size_t Hash);
+
+/// Computes the hash of the texture description and the contents of all subresources.
+///
+/// \remarks    Row padding is excluded from the hash, so the result does not depend on the
+///             strides of the subresources.
+size_t ComputeTextureContentHash(const TextureDesc& Desc, const TextureData& Data);
+
+/// Writes the texture data to the cache file in DDS format.
+///
+/// \remarks    The cache directory is created if it does not exist.
+///             The data is first written to a temporary file that is then renamed,
+///             so that other processes never observe a partially written cache entry.
+bool WriteTextureCacheFile(const char* FilePath, const TextureDesc& Desc, const TextureData& Data);
+
+/// Loads the texture from the cache file and uploads it to the existing texture.
+///
+/// \param [in] pCtx        - Device context.
+/// \param [in] FilePath    - Path to the cache file.
+/// \param [in] pDstTexture - Destination texture.
+///
+/// \return     true if the texture was loaded, and false if the file does not exist,
+///             can't be read, or its dimensions or format do not match the destination texture.
+///
+/// \remarks    The destination texture is left in RESOURCE_STATE_COPY_DEST state.
+bool LoadTextureFromCache(IDeviceContext* pCtx, const char* FilePath, ITexture* pDstTexture);
+
+/// Reads back the texture from the GPU and writes it to the cache file.
+///
+/// \param [in] pDevice  - Render device.
+/// \param [in] pCtx     - Device context.
+/// \param [in] pTexture - Texture to store. All mip levels and array slices are stored.
+/// \param [in] FilePath - Path to the cache file.
+///
+/// \remarks    The function waits until the GPU is idle, so it should only be called
+///             outside of the frame loop, e.g. right after precomputing a look-up table
+///             at initialization. Use TextureCacheWriter to store textures inside the frame loop.
+bool StoreTextureInCache(IRenderDevice* pDevice, IDeviceContext* pCtx, ITexture* pTexture, const char* FilePath);
+
+/// Stores textures in the cache without stalling the GPU.
+///
+/// Enqueue() copies the texture into a staging texture and signals a fence. The staging texture
+/// is read back and written to the cache file by the first call to Update() after the GPU has
+/// completed the copy, which is typically a few frames later.
+class TextureCacheWriter
+{
+public:
+    explicit TextureCacheWriter(IRenderDevice* pDevice);
+    ~TextureCacheWriter();
+
+    // clang-format off
+    TextureCacheWriter           (const TextureCacheWriter&)  = delete;
+    TextureCacheWriter           (      TextureCacheWriter&&) = delete;
+    TextureCacheWriter& operator=(const TextureCacheWriter&)  = delete;
+    TextureCacheWriter& operator=(      TextureCacheWriter&&) = delete;
+    // clang-format on
+
+    /// Records the copy of the texture into a staging texture.
+    ///
+    /// \param [in] pCtx     - Immediate device context.
+    /// \param [in] pTexture - Texture to store. All mip levels and array slices are stored.
+    /// \param [in] FilePath - Path to the cache file.
+    ///
+    /// \return     true if the copy has been recorded, and false otherwise.
+    bool Enqueue(IDeviceContext* pCtx, ITexture* pTexture, const char* FilePath);
+
+    /// Writes the textures whose copies have been completed by the GPU to the cache.
+    ///
+    /// \remarks    This method never waits for the GPU and should be called once per frame
+    ///             while HasPendingWrites() returns true.
+    void Update(IDeviceContext* pCtx);
+
+    /// Waits for the GPU to complete all copies and writes all pending textures to the cache.
+    ///
+    /// \remarks    Like StoreTextureInCache(), this method should only be called outside of the frame loop.
+    void Flush(IDeviceContext* pCtx);
+
+    bool HasPendingWrites() const { return !m_PendingWrites.empty(); }
+
+private:
+    struct PendingWrite
+    {
+        RefCntAutoPtr<ITexture> pStagingTex;
+        // The description name is null while the write is pending and is set to Name when it is written
+        TextureDesc SrcDesc;
+        std::string Name;
+        std::string FilePath;
+        Uint64      FenceValue = 0;
+    };
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IFence>        m_pFence;
+    Uint64                       m_LastFenceValue = 0;
+    std::vector<PendingWrite>    m_PendingWrites;
+};
+
+} // namespace Diligent
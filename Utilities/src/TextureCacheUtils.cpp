@@ -0,0 +1,393 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "../interface/TextureCacheUtils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <random>
+
+#ifdef _WIN32
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+#include "TextureLoader.h"
+#include "GraphicsAccessories.hpp"
+#include "FileSystem.hpp"
+#include "HashUtils.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+std::string GetTextureCacheFilePath(const char* CacheDirectory, const char* Name, size_t Hash)
+{
+    VERIFY_EXPR(CacheDirectory != nullptr && Name != nullptr);
+
+    std::string Dir{CacheDirectory};
+    if (!Dir.empty() && Dir.back() != '/' && Dir.back() != '\\')
+        Dir += FileSystem::SlashSymbol;
+
+    std::stringstream ss;
+    ss << Dir << Name << '_' << std::hex << std::setfill('0') << std::setw(16) << static_cast<Uint64>(Hash) << ".dds";
+    return ss.str();
+}
+
+size_t ComputeTextureContentHash(const TextureDesc& Desc, const TextureData& Data)
+{
+    size_t Hash = ComputeHash(Desc.Type, Desc.Width, Desc.Height, Desc.ArraySizeOrDepth, Desc.Format, Desc.MipLevels);
+
+    const Uint32 NumSlices = Desc.IsArray() ? Desc.ArraySize : 1;
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+        {
+            const Uint32 SubresIdx = Slice * Desc.MipLevels + Mip;
+            if (SubresIdx >= Data.NumSubresources)
+                break;
+
+            const TextureSubResData& SubresData = Data.pSubResources[SubresIdx];
+            const MipLevelProperties MipProps   = GetMipLevelProperties(Desc, Mip);
+            if (SubresData.pData == nullptr)
+                continue;
+
+            const Uint32 NumRows = static_cast<Uint32>(MipProps.StorageHeight / GetTextureFormatAttribs(Desc.Format).BlockHeight);
+            for (Uint32 z = 0; z < MipProps.Depth; ++z)
+            {
+                for (Uint32 row = 0; row < NumRows; ++row)
+                {
+                    const Uint8* pRow = static_cast<const Uint8*>(SubresData.pData) + z * SubresData.DepthStride + row * SubresData.Stride;
+                    HashCombine(Hash, ComputeHashRaw(pRow, static_cast<size_t>(MipProps.RowSize)));
+                }
+            }
+        }
+    }
+
+    return Hash;
+}
+
+// Returns the name of the temporary file that is unique across threads and processes.
+// Thread IDs alone are not unique across processes, so the name also includes the process ID,
+// a random per-process value and a monotonic counter.
+static std::string GetTemporaryFilePath(const std::string& FilePath)
+{
+    static const Uint32        ProcessSalt = std::random_device{}();
+    static std::atomic<Uint32> Counter{0};
+
+#ifdef _WIN32
+    const int ProcessId = _getpid();
+#else
+    const int ProcessId = static_cast<int>(getpid());
+#endif
+
+    std::stringstream TmpPath;
+    TmpPath << FilePath << ".tmp" << ProcessId << '_' << std::this_thread::get_id() << '_'
+            << std::hex << ProcessSalt << '_' << Counter.fetch_add(1);
+    return TmpPath.str();
+}
+
+bool WriteTextureCacheFile(const char* FilePath, const TextureDesc& Desc, const TextureData& Data)
+{
+    const std::string CacheFilePath{FilePath};
+
+    const size_t SlashPos = CacheFilePath.find_last_of("/\\");
+    if (SlashPos != std::string::npos)
+    {
+        const std::string CacheDirectory = CacheFilePath.substr(0, SlashPos);
+        if (!FileSystem::PathExists(CacheDirectory.c_str()) && !FileSystem::CreateDirectory(CacheDirectory.c_str()))
+        {
+            LOG_WARNING_MESSAGE("Failed to create texture cache directory ", CacheDirectory);
+            return false;
+        }
+    }
+
+    // Write to a temporary file first and then rename it so that other
+    // processes never observe a partially written cache entry.
+    const std::string TmpPath = GetTemporaryFilePath(CacheFilePath);
+
+    if (!SaveTextureAsDDS(TmpPath.c_str(), Desc, Data))
+    {
+        LOG_WARNING_MESSAGE("Failed to write texture cache file ", TmpPath);
+        std::remove(TmpPath.c_str());
+        return false;
+    }
+
+    if (std::rename(TmpPath.c_str(), CacheFilePath.c_str()) != 0)
+    {
+        // Another process may have stored the same texture in the meantime.
+        std::remove(TmpPath.c_str());
+    }
+
+    return true;
+}
+
+bool LoadTextureFromCache(IDeviceContext* pCtx, const char* FilePath, ITexture* pDstTexture)
+{
+    if (pCtx == nullptr || FilePath == nullptr || pDstTexture == nullptr)
+    {
+        UNEXPECTED("Device context, file path and destination texture must not be null");
+        return false;
+    }
+
+    if (!FileSystem::FileExists(FilePath))
+        return false;
+
+    const TextureDesc& DstDesc = pDstTexture->GetDesc();
+
+    TextureLoadInfo LoadInfo;
+    LoadInfo.Name = DstDesc.Name;
+
+    RefCntAutoPtr<ITextureLoader> pLoader;
+    CreateTextureLoaderFromFile(FilePath, IMAGE_FILE_FORMAT_DDS, LoadInfo, &pLoader);
+    if (!pLoader)
+    {
+        LOG_WARNING_MESSAGE("Failed to load cached texture ", FilePath);
+        return false;
+    }
+
+    const TextureDesc& SrcDesc = pLoader->GetTextureDesc();
+    if (SrcDesc.Width != DstDesc.Width ||
+        SrcDesc.Height != DstDesc.Height ||
+        SrcDesc.ArraySizeOrDepth != DstDesc.ArraySizeOrDepth ||
+        SrcDesc.MipLevels != DstDesc.MipLevels ||
+        SrcDesc.Format != DstDesc.Format)
+    {
+        LOG_WARNING_MESSAGE("Cached texture ", FilePath, " does not match the description of texture '", DstDesc.Name, "'");
+        return false;
+    }
+
+    const TextureData SrcData = pLoader->GetTextureData();
+
+    const Uint32 NumSlices = DstDesc.IsArray() ? DstDesc.ArraySize : 1;
+    if (SrcData.NumSubresources != NumSlices * DstDesc.MipLevels)
+    {
+        LOG_WARNING_MESSAGE("Cached texture ", FilePath, " contains ", SrcData.NumSubresources, " subresources while ", NumSlices * DstDesc.MipLevels, " are expected");
+        return false;
+    }
+
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < DstDesc.MipLevels; ++Mip)
+        {
+            const MipLevelProperties MipProps = GetMipLevelProperties(DstDesc, Mip);
+
+            Box UpdateBox{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+            pCtx->UpdateTexture(pDstTexture, Mip, Slice, UpdateBox, SrcData.pSubResources[Slice * DstDesc.MipLevels + Mip],
+                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+
+    return true;
+}
+
+// Copies all subresources of the texture into a new staging texture.
+static RefCntAutoPtr<ITexture> CopyToStagingTexture(IRenderDevice* pDevice, IDeviceContext* pCtx, ITexture* pTexture)
+{
+    const TextureDesc& SrcDesc = pTexture->GetDesc();
+
+    TextureDesc StagingDesc    = SrcDesc;
+    StagingDesc.Name           = "Texture cache staging texture";
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.BindFlags      = BIND_NONE;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    StagingDesc.MiscFlags      = MISC_TEXTURE_FLAG_NONE;
+    if (StagingDesc.Type == RESOURCE_DIM_TEX_CUBE || StagingDesc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+        StagingDesc.Type = RESOURCE_DIM_TEX_2D_ARRAY;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    if (!pStagingTex)
+    {
+        LOG_WARNING_MESSAGE("Failed to create staging texture to store '", SrcDesc.Name, "' in the cache");
+        return {};
+    }
+
+    const Uint32 NumSlices = SrcDesc.IsArray() ? SrcDesc.ArraySize : 1;
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < SrcDesc.MipLevels; ++Mip)
+        {
+            CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = Mip;
+            CopyAttribs.SrcSlice    = Slice;
+            CopyAttribs.DstMipLevel = Mip;
+            CopyAttribs.DstSlice    = Slice;
+            pCtx->CopyTexture(CopyAttribs);
+        }
+    }
+
+    return pStagingTex;
+}
+
+// Reads back the staging texture whose copy has been completed by the GPU and writes it to the cache file.
+static bool WriteStagingTextureToCache(IDeviceContext* pCtx, ITexture* pStagingTex, const TextureDesc& SrcDesc, const char* FilePath)
+{
+    const Uint32 NumSlices = SrcDesc.IsArray() ? SrcDesc.ArraySize : 1;
+
+    std::vector<std::vector<Uint8>> SubresBuffers(size_t{NumSlices} * SrcDesc.MipLevels);
+    std::vector<TextureSubResData>  SubresData(SubresBuffers.size());
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < SrcDesc.MipLevels; ++Mip)
+        {
+            const MipLevelProperties MipProps = GetMipLevelProperties(SrcDesc, Mip);
+            const Uint32             NumRows  = static_cast<Uint32>(MipProps.StorageHeight / GetTextureFormatAttribs(SrcDesc.Format).BlockHeight);
+            const size_t             RowSize  = static_cast<size_t>(MipProps.RowSize);
+
+            MappedTextureSubresource MappedData;
+            pCtx->MapTextureSubresource(pStagingTex, Mip, Slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+            if (MappedData.pData == nullptr)
+            {
+                LOG_WARNING_MESSAGE("Failed to map staging texture to store '", SrcDesc.Name, "' in the cache");
+                return false;
+            }
+
+            // Tightly pack the rows
+            const size_t        SubresIdx = size_t{Slice} * SrcDesc.MipLevels + Mip;
+            std::vector<Uint8>& Buffer    = SubresBuffers[SubresIdx];
+            Buffer.resize(RowSize * NumRows * MipProps.Depth);
+            for (Uint32 z = 0; z < MipProps.Depth; ++z)
+            {
+                for (Uint32 row = 0; row < NumRows; ++row)
+                {
+                    const Uint8* pSrcRow = static_cast<const Uint8*>(MappedData.pData) + z * MappedData.DepthStride + row * MappedData.Stride;
+                    std::memcpy(&Buffer[(z * NumRows + row) * RowSize], pSrcRow, RowSize);
+                }
+            }
+            pCtx->UnmapTextureSubresource(pStagingTex, Mip, Slice);
+
+            SubresData[SubresIdx] = TextureSubResData{Buffer.data(), RowSize, RowSize * NumRows};
+        }
+    }
+
+    const TextureData TexData{SubresData.data(), static_cast<Uint32>(SubresData.size())};
+    return WriteTextureCacheFile(FilePath, SrcDesc, TexData);
+}
+
+bool StoreTextureInCache(IRenderDevice* pDevice, IDeviceContext* pCtx, ITexture* pTexture, const char* FilePath)
+{
+    if (pDevice == nullptr || pCtx == nullptr || pTexture == nullptr || FilePath == nullptr)
+    {
+        UNEXPECTED("Device, device context, texture and file path must not be null");
+        return false;
+    }
+
+    RefCntAutoPtr<ITexture> pStagingTex = CopyToStagingTexture(pDevice, pCtx, pTexture);
+    if (!pStagingTex)
+        return false;
+
+    pCtx->WaitForIdle();
+
+    return WriteStagingTextureToCache(pCtx, pStagingTex, pTexture->GetDesc(), FilePath);
+}
+
+TextureCacheWriter::TextureCacheWriter(IRenderDevice* pDevice) :
+    m_pDevice{pDevice}
+{
+    VERIFY_EXPR(m_pDevice != nullptr);
+
+    FenceDesc Desc;
+    Desc.Name = "Texture cache writer fence";
+    Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    m_pDevice->CreateFence(Desc, &m_pFence);
+    if (!m_pFence)
+    {
+        UNEXPECTED("Failed to create texture cache writer fence");
+    }
+}
+
+TextureCacheWriter::~TextureCacheWriter()
+{
+    if (!m_PendingWrites.empty())
+    {
+        LOG_INFO_MESSAGE(m_PendingWrites.size(), " texture cache entries were not written because the writer was destroyed before the GPU completed the copies");
+    }
+}
+
+bool TextureCacheWriter::Enqueue(IDeviceContext* pCtx, ITexture* pTexture, const char* FilePath)
+{
+    if (pCtx == nullptr || pTexture == nullptr || FilePath == nullptr)
+    {
+        UNEXPECTED("Device context, texture and file path must not be null");
+        return false;
+    }
+    if (!m_pFence)
+        return false;
+
+    PendingWrite Write;
+    Write.pStagingTex = CopyToStagingTexture(m_pDevice, pCtx, pTexture);
+    if (!Write.pStagingTex)
+        return false;
+
+    Write.SrcDesc      = pTexture->GetDesc();
+    Write.Name         = Write.SrcDesc.Name != nullptr ? Write.SrcDesc.Name : "";
+    Write.SrcDesc.Name = nullptr;
+    Write.FilePath     = FilePath;
+
+    pCtx->EnqueueSignal(m_pFence, ++m_LastFenceValue);
+    Write.FenceValue = m_LastFenceValue;
+
+    m_PendingWrites.emplace_back(std::move(Write));
+    return true;
+}
+
+void TextureCacheWriter::Update(IDeviceContext* pCtx)
+{
+    if (m_PendingWrites.empty())
+        return;
+
+    const Uint64 CompletedValue = m_pFence->GetCompletedValue();
+
+    // The fence values increase monotonically, so the writes complete in order
+    auto It = m_PendingWrites.begin();
+    for (; It != m_PendingWrites.end() && It->FenceValue <= CompletedValue; ++It)
+    {
+        It->SrcDesc.Name = It->Name.c_str();
+        WriteStagingTextureToCache(pCtx, It->pStagingTex, It->SrcDesc, It->FilePath.c_str());
+    }
+    m_PendingWrites.erase(m_PendingWrites.begin(), It);
+}
+
+void TextureCacheWriter::Flush(IDeviceContext* pCtx)
+{
+    if (m_PendingWrites.empty())
+        return;
+
+    pCtx->Flush();
+    m_pFence->Wait(m_LastFenceValue);
+    Update(pCtx);
+}
+
+} // namespace Diligent